@@ -30,8 +30,10 @@
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Quaternion.h"
 #include "Magnum/Math/Packing.h"
+#include "Magnum/Animation/Compression.h"
 #include "Magnum/Animation/Easing.h"
 #include "Magnum/Animation/Player.h"
+#include "Magnum/Animation/UniformTrack.h"
 
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
@@ -291,6 +293,37 @@ player.addRawCallback(track,
 #endif
 }
 
+{
+/* [Player-addBatched] */
+struct Character {
+    Animation::Track<Float, Vector3> translation;
+    Animation::Track<Float, Quaternion> rotation;
+    Vector3 animatedTranslation;
+    Quaternion animatedRotation;
+};
+std::vector<Character> characters;
+
+Animation::Player<Float> player;
+for(Character& character: characters) {
+    player.addBatched(character.translation, character.animatedTranslation)
+          .addBatched(character.rotation, character.animatedRotation);
+}
+/* [Player-addBatched] */
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+{
+Timeline timeline;
+/* [Player-advanceParallel] */
+Animation::Player<Float> characters, vehicles, props;
+// add tracks ...
+
+Animation::Player<Float>::advanceParallel(timeline.previousFrameTime(),
+    {characters, vehicles, props});
+/* [Player-advanceParallel] */
+}
+#endif
+
 {
 /* [Track-usage] */
 const Animation::Track<Float, Vector2> jump{{
@@ -361,4 +394,39 @@ static_cast<void>(position);
 static_cast<void>(rotation);
 }
 
+{
+/* [UniformTrack-usage] */
+const Animation::UniformTrack<Float, Vector2> jump{{0.0f, 6.0f}, {
+    Vector2::yAxis(0.0f),
+    Vector2::yAxis(0.5f),
+    Vector2::yAxis(0.75f),
+    Vector2::yAxis(0.875f),
+    Vector2::yAxis(0.75f),
+    Vector2::yAxis(0.5f),
+    Vector2::yAxis(0.0f)
+}, Math::lerp, Animation::Extrapolation::Constant};
+
+Vector2 position = jump.at(2.2f);               // y = 0.775
+/* [UniformTrack-usage] */
+static_cast<void>(position);
+}
+
+{
+Animation::TrackView<const Float, const Quaternion> rotationTrack;
+/* [compressQuaternions] */
+/* Allow at most 0.1° difference from the original */
+Animation::Track<Float, Vector3us, Quaternion> compressed =
+    Animation::compressQuaternions(rotationTrack, Float(Rad(0.1_degf)));
+
+Animation::TrackError error =
+    Animation::trackError(rotationTrack, Animation::TrackView<const Float,
+        const Vector3us, Quaternion>{compressed});
+Debug{} << "Max error:" << Deg(Rad(error.max));
+
+Quaternion rotation;
+Animation::Player<Float> player;
+player.add(compressed, rotation);
+/* [compressQuaternions] */
+}
+
 }
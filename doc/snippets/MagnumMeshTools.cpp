@@ -27,7 +27,9 @@
 #include <vector>
 
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Frustum.h"
 #include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/MeshTools/BoundingVolumeHierarchy.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/Concatenate.h"
 #include "Magnum/MeshTools/Duplicate.h"
@@ -69,6 +71,32 @@ CORRADE_IGNORE_DEPRECATED_POP
 }
 #endif
 
+{
+/* [BoundingVolumeHierarchy-usage] */
+Containers::ArrayView<const Range3D> boxes;
+Frustum frustum;
+
+MeshTools::BoundingVolumeHierarchy bvh{boxes};
+
+// IDs of boxes that are inside the frustum
+Containers::Array<UnsignedInt> visible = bvh.frustum(frustum);
+/* [BoundingVolumeHierarchy-usage] */
+}
+
+{
+Trade::MeshData mesh{MeshPrimitive::Triangles, 0};
+Vector3 origin, direction;
+/* [BoundingVolumeHierarchy-triangles] */
+MeshTools::BoundingVolumeHierarchy bvh{mesh};
+if(Containers::Optional<std::pair<UnsignedInt, Float>> hit =
+    bvh.closestTriangle(origin, direction))
+{
+    Vector3 point = origin + hit->second*direction;
+    // triangle hit->first was hit at point …
+}
+/* [BoundingVolumeHierarchy-triangles] */
+}
+
 {
 /* [compressIndices-offset] */
 Containers::ArrayView<const UnsignedInt> indices;
@@ -24,6 +24,7 @@
 */
 
 #include <algorithm>
+#include <Corrade/Containers/ArrayViewStl.h>
 
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Math/Intersection.h"
@@ -387,4 +388,23 @@ camera.draw(drawableTransformations);
 /* [Drawable-culling] */
 }
 
+{
+Object3D cameraObject;
+SceneGraph::Camera3D camera{cameraObject};
+SceneGraph::DrawableGroup3D drawableGroup;
+/* [Drawable-culling-builtin] */
+/* Boxes in the same order as drawables in the group, relative to the objects
+   they're attached to, so they don't need updating when the objects move */
+std::vector<Range3D> boundingBoxes;
+boundingBoxes.push_back({Vector3{-1.0f}, Vector3{1.0f}}); // a unit cube mesh
+
+// ...
+
+std::size_t visible = camera.drawCulled(drawableGroup,
+    Containers::arrayView(boundingBoxes));
+Debug{} << visible << "drawables visible," << drawableGroup.size() - visible
+    << "culled";
+/* [Drawable-culling-builtin] */
+}
+
 }
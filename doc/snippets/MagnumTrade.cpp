@@ -32,7 +32,9 @@
 #include "Magnum/ImageView.h"
 #include "Magnum/Mesh.h"
 #include "Magnum/PixelFormat.h"
+#include "Magnum/Animation/Compression.h"
 #include "Magnum/Animation/Player.h"
+#include "Magnum/Animation/UniformTrack.h"
 #include "Magnum/Math/Swizzle.h"
 #include "Magnum/MeshTools/Interleave.h"
 #include "Magnum/MeshTools/Transform.h"
@@ -184,6 +186,30 @@ Containers::Array<char> animationData = data->release(); /* Take ownership */
 /* [AnimationData-usage] */
 }
 
+{
+Trade::AnimationData data{nullptr, {}};
+UnsignedInt i{};
+/* [AnimationData-resample] */
+Animation::TrackView<const Float, const Vector3> track = data.track<Vector3>(i);
+
+/* 60 samples per second */
+Animation::UniformTrack<Float, Vector3> resampled = Animation::resample(track,
+    std::size_t(track.duration().size()*60.0f) + 1);
+/* [AnimationData-resample] */
+}
+
+{
+Trade::AnimationData data{nullptr, {}};
+UnsignedInt i{};
+/* [AnimationData-compress] */
+Animation::TrackView<const Float, const Quaternion> track =
+    data.track<Quaternion>(i);
+
+Animation::Track<Float, Vector3us, Quaternion> compressed =
+    Animation::compressQuaternions(track, Float(Rad(0.1_degf)));
+/* [AnimationData-compress] */
+}
+
 {
 Trade::AnimationData data{nullptr, {}};
 /* [AnimationData-usage-mutable] */
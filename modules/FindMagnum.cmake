@@ -131,6 +131,8 @@
 #  MAGNUM_BUILD_STATIC          - Defined if compiled as static libraries
 #  MAGNUM_BUILD_STATIC_UNIQUE_GLOBALS - Defined if static libraries keep the
 #   globals unique even across different shared libraries
+#  MAGNUM_BUILD_TRACING         - Defined if compiled with tracing zones
+#   included
 #  MAGNUM_TARGET_GL             - Defined if compiled with OpenGL interop
 #  MAGNUM_TARGET_GLES           - Defined if compiled for OpenGL ES
 #  MAGNUM_TARGET_GLES2          - Defined if compiled for OpenGL ES 2.0
@@ -259,6 +261,7 @@ set(_magnumFlags
     BUILD_DEPRECATED
     BUILD_STATIC
     BUILD_STATIC_UNIQUE_GLOBALS
+    BUILD_TRACING
     TARGET_GL
     TARGET_GLES
     TARGET_GLES2
@@ -348,6 +351,12 @@ if(NOT TARGET Magnum::Magnum)
     # Dependent libraries
     set_property(TARGET Magnum::Magnum APPEND PROPERTY INTERFACE_LINK_LIBRARIES
          Corrade::Utility)
+    # Animation::Player::advanceParallel() uses threads
+    if(NOT CORRADE_TARGET_EMSCRIPTEN)
+        find_package(Threads REQUIRED)
+        set_property(TARGET Magnum::Magnum APPEND PROPERTY
+            INTERFACE_LINK_LIBRARIES Threads::Threads)
+    endif()
 else()
     set(MAGNUM_LIBRARY Magnum::Magnum)
 endif()
@@ -861,7 +870,15 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL Primitives)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Cube.h)
 
-        # No special setup for SceneGraph library
+        # SceneGraph library
+        elseif(_component STREQUAL SceneGraph)
+            # Object::setCleanParallel() uses threads
+            if(NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
+
         # No special setup for Shaders library
 
         # Text library
@@ -877,6 +894,12 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL Trade)
             set_property(TARGET Magnum::${_component} APPEND PROPERTY
                 INTERFACE_LINK_LIBRARIES Corrade::PluginManager)
+            # AsyncImporter uses threads
+            if(NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
 
         # Vk library
         elseif(_component STREQUAL Vk)
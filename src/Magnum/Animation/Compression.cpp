@@ -0,0 +1,74 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Compression.h"
+
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum { namespace Animation {
+
+Vector3us packQuaternion(const Quaternion& quaternion) {
+    const Vector4 q{quaternion.vector(), quaternion.scalar()};
+
+    /* Find the largest component */
+    UnsignedInt largest = 0;
+    for(UnsignedInt i = 1; i != 4; ++i)
+        if(Math::abs(q[i]) > Math::abs(q[largest])) largest = i;
+
+    /* q and -q is the same rotation, negate the remaining components so the
+       dropped one can be reconstructed as positive */
+    const Float sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+
+    /* The remaining components are in [-1/sqrt(2), 1/sqrt(2)], map them to
+       [0, 1] and pack into 15 bits */
+    Vector3us out;
+    for(UnsignedInt i = 0, j = 0; i != 4; ++i) {
+        if(i == largest) continue;
+        out[j++] = Math::pack<UnsignedShort, 15>(Math::clamp(sign*q[i]*Constants::sqrtHalf() + 0.5f, 0.0f, 1.0f));
+    }
+
+    /* Store the index in the remaining two bits */
+    out[0] |= UnsignedShort((largest & 1) << 15);
+    out[1] |= UnsignedShort((largest >> 1) << 15);
+    return out;
+}
+
+Quaternion unpackQuaternion(const Vector3us& packed) {
+    const UnsignedInt largest = (packed[0] >> 15)|((packed[1] >> 15) << 1);
+
+    Vector4 q;
+    for(UnsignedInt i = 0, j = 0; i != 4; ++i) {
+        if(i == largest) continue;
+        q[i] = (Math::unpack<Float, 15>(UnsignedShort(packed[j++] & 0x7fff)) - 0.5f)*Constants::sqrt2();
+    }
+
+    /* The largest component is zero at this point so it doesn't contribute
+       to the dot product */
+    q[largest] = std::sqrt(Math::max(1.0f - q.dot(), 0.0f));
+    return Quaternion{q.xyz(), q.w()};
+}
+
+}}
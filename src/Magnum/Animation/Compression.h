@@ -0,0 +1,307 @@
+#ifndef Magnum_Animation_Compression_h
+#define Magnum_Animation_Compression_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::Animation::TrackError, function @ref Magnum::Animation::packQuaternion(), @ref Magnum::Animation::unpackQuaternion(), @ref Magnum::Animation::reduceKeyframes(), @ref Magnum::Animation::compressQuaternions(), @ref Magnum::Animation::trackError()
+ * @m_since_latest
+ */
+
+#include <cmath>
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/Animation/Track.h"
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Animation {
+
+/**
+@brief Pack a quaternion into 48 bits
+@m_since_latest
+
+Uses the *smallest three* encoding --- the component with the largest absolute
+value is dropped and the remaining three, which are all in range
+@f$ [-\frac{1}{\sqrt{2}} ; \frac{1}{\sqrt{2}}] @f$, are stored with 15-bit
+precision. The index of the dropped component is stored in the highest bits of
+the first two components. As @f$ q @f$ and @f$ -q @f$ represent the same
+rotation, the quaternion is negated if needed so the dropped component is
+always positive and can be reconstructed in @ref unpackQuaternion(). Expects
+that the quaternion is normalized, the maximal angular error of the packed
+representation is around @f$ 10^{-4} @f$ radians.
+
+Compared to a @ref Quaternion, the packed representation takes 6 instead of 16
+bytes. Use @ref compressQuaternions() to pack a whole track, or combine
+@ref unpackQuaternion() with an interpolator using @ref unpack() to evaluate
+packed values directly.
+@experimental
+*/
+MAGNUM_EXPORT Vector3us packQuaternion(const Quaternion& quaternion);
+
+/**
+@brief Unpack a quaternion from 48 bits
+@m_since_latest
+
+Inverse to @ref packQuaternion(). The result is normalized, but can be
+negated compared to the quaternion that was originally packed. Interpolate the
+unpacked values with @ref Math::slerpShortestPath() or
+@ref Math::lerpShortestPath() to not be affected by this.
+@experimental
+*/
+MAGNUM_EXPORT Quaternion unpackQuaternion(const Vector3us& packed);
+
+/**
+@brief Track error
+@m_since_latest
+
+Returned from @ref trackError().
+@experimental
+*/
+struct TrackError {
+    /** @brief Maximal error */
+    Float max;
+
+    /** @brief Average error */
+    Float average;
+};
+
+namespace Implementation {
+
+/* Scalar difference for keyframe reduction and error metrics. Vectors (and
+   thus also colors) use a distance, rotations an angle in radians. The
+   rotation angle is calculated using atan2() instead of acos() of the dot
+   product, as the latter has poor precision for small angles, which is
+   exactly what's being measured here. Unlike quaternions, complex numbers
+   have no double cover --- c and -c are rotations 180° apart --- so only the
+   quaternion scalar part is taken as absolute. */
+inline Float keyframeError(Float a, Float b) {
+    return Math::abs(a - b);
+}
+template<std::size_t size> inline Float keyframeError(const Math::Vector<size, Float>& a, const Math::Vector<size, Float>& b) {
+    return (a - b).length();
+}
+inline Float keyframeError(const Math::Complex<Float>& a, const Math::Complex<Float>& b) {
+    const Math::Complex<Float> difference = a.conjugated()*b;
+    return std::atan2(Math::abs(difference.imaginary()), difference.real());
+}
+inline Float keyframeError(const Math::Quaternion<Float>& a, const Math::Quaternion<Float>& b) {
+    const Math::Quaternion<Float> difference = a.conjugated()*b;
+    return 2.0f*std::atan2(difference.vector().length(), Math::abs(difference.scalar()));
+}
+
+/* Returns indices of keyframes to keep. Instead of comparing to the original
+   values, the reduced track is compared to the expected results, which
+   allows the interpolator to operate on a different (packed) representation
+   of the values. */
+template<class K, class V, class R> Containers::Array<std::size_t> reduceKeyframes(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, R(*const interpolator)(const V&, const V&, Float), const Containers::StridedArrayView1D<const R>& expected, const Float tolerance) {
+    Containers::Array<std::size_t> kept;
+    if(!keys.size()) return kept;
+
+    /* The first keyframe is kept always. Then, for every following keyframe,
+       check if all keyframes between the last kept one and it are within the
+       tolerance when interpolated. If not, the previous keyframe is
+       needed. */
+    arrayAppend(kept, std::size_t{0});
+    std::size_t anchor = 0;
+    for(std::size_t end = 2; end < keys.size(); ++end) {
+        const Float anchorKey = Float(keys[anchor]);
+        const Float endKey = Float(keys[end]);
+        for(std::size_t i = anchor + 1; i != end; ++i) {
+            const R value = interpolator(values[anchor], values[end], Math::lerpInverted(anchorKey, endKey, Float(keys[i])));
+            if(keyframeError(value, expected[i]) > tolerance) {
+                anchor = end - 1;
+                arrayAppend(kept, anchor);
+                break;
+            }
+        }
+    }
+
+    /* The last keyframe is kept always as well */
+    if(keys.size() > 1) arrayAppend(kept, keys.size() - 1);
+
+    return kept;
+}
+
+template<class K, class V, class R> Containers::Array<R> keyframeResults(const TrackView<const K, const V, R>& track) {
+    Containers::Array<R> out{track.size()};
+    std::size_t hint{};
+    for(std::size_t i = 0; i != track.size(); ++i)
+        out[i] = track.at(track.keys()[i], hint);
+    return out;
+}
+
+}
+
+/**
+@brief Remove keyframes that can be interpolated from their neighbors
+@param track        Track to reduce
+@param tolerance    Maximal allowed error
+@m_since_latest
+
+Removes keyframes for which the value interpolated from the remaining
+keyframes differs from the original by not more than @p tolerance. The first
+and the last keyframe are always kept. For scalar and vector types the error
+is a distance between the values, for @ref Complex and @ref Quaternion it's
+the angle between the two rotations in radians. Interpolation, interpolator
+function and extrapolation of the resulting track are the same as of
+@p track.
+
+The error is checked only at the original keyframe positions, use
+@ref trackError() to measure the error of the resulting track also in between
+them. The keyframes are removed greedily, which is @f$ \mathcal{O}(n) @f$ for
+tracks where not much can be removed and @f$ \mathcal{O}(n^2) @f$ in the
+worst case, where @f$ n @f$ is the keyframe count. Expects that @p tolerance
+is not negative.
+@see @ref compressQuaternions()
+@experimental
+*/
+template<class K, class V, class R> Track<K, V, R> reduceKeyframes(const TrackView<const K, const V, R>& track, Float tolerance);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+template<class K, class V, class R> inline Track<K, V, R> reduceKeyframes(const Track<K, V, R>& track, const Float tolerance) {
+    return reduceKeyframes(TrackView<const K, const V, R>{track}, tolerance);
+}
+
+/**
+@brief Compress a rotation track
+@param track        Track to compress
+@param tolerance    Maximal allowed error in radians
+@m_since_latest
+
+Packs the values using @ref packQuaternion() and removes keyframes in the same
+way as @ref reduceKeyframes(). The error introduced by the packing is included
+when deciding whether a keyframe can be removed. The resulting track needs
+about a third of memory for each keyframe and can be directly used in a
+@ref Player or evaluated using @ref Track::at().
+
+If @p track has @ref Interpolation::Constant, the resulting track uses a
+combination of @ref unpackQuaternion() and @ref Math::select(). Otherwise it
+uses @ref unpackQuaternion() together with @ref Math::slerpShortestPath() and
+has @ref Interpolation::Linear, custom interpolators are not preserved.
+Extrapolation is the same as of @p track. Expects that @p tolerance is not
+negative:
+
+@snippet MagnumAnimation.cpp compressQuaternions
+@experimental
+*/
+template<class K> Track<K, Vector3us, Quaternion> compressQuaternions(const TrackView<const K, const Quaternion, Quaternion>& track, Float tolerance);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+template<class K> inline Track<K, Vector3us, Quaternion> compressQuaternions(const Track<K, Quaternion, Quaternion>& track, const Float tolerance) {
+    return compressQuaternions(TrackView<const K, const Quaternion, Quaternion>{track}, tolerance);
+}
+
+/**
+@brief Error of a compressed track
+@param original     Original track
+@param compressed   Compressed track
+@m_since_latest
+
+Evaluates both tracks at each keyframe of @p original and in the middle
+between each pair of its keyframes and returns the maximal and the average
+difference. The difference is calculated the same way as in
+@ref reduceKeyframes(). If @p original is empty, both values are zero.
+@experimental
+*/
+template<class K, class V, class V2, class R> TrackError trackError(const TrackView<const K, const V, R>& original, const TrackView<const K, const V2, R>& compressed) {
+    TrackError error{};
+    if(!original.size()) return error;
+
+    std::size_t count = 0;
+    std::size_t hintOriginal{}, hintCompressed{};
+    const auto accumulate = [&](const K key) {
+        const Float difference = Implementation::keyframeError(original.at(key, hintOriginal), compressed.at(key, hintCompressed));
+        error.max = Math::max(error.max, difference);
+        error.average += difference;
+        ++count;
+    };
+
+    for(std::size_t i = 0; i != original.size(); ++i) {
+        accumulate(original.keys()[i]);
+        if(i + 1 != original.size())
+            accumulate(Math::lerp(original.keys()[i], original.keys()[i + 1], 0.5f));
+    }
+
+    error.average /= Float(count);
+    return error;
+}
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+template<class K, class V, class V2, class R> inline TrackError trackError(const Track<K, V, R>& original, const Track<K, V2, R>& compressed) {
+    return trackError(TrackView<const K, const V, R>{original}, TrackView<const K, const V2, R>{compressed});
+}
+
+template<class K, class V, class R> Track<K, V, R> reduceKeyframes(const TrackView<const K, const V, R>& track, const Float tolerance) {
+    CORRADE_ASSERT(tolerance >= 0.0f,
+        "Animation::reduceKeyframes(): expected non-negative tolerance, got" << tolerance, (Track<K, V, R>{}));
+
+    const Containers::Array<R> expected = Implementation::keyframeResults(track);
+    const Containers::Array<std::size_t> kept = Implementation::reduceKeyframes<K, V, R>(track.keys(), track.values(), track.interpolator(), Containers::arrayView(expected), tolerance);
+
+    Containers::Array<std::pair<K, V>> data{kept.size()};
+    for(std::size_t i = 0; i != kept.size(); ++i)
+        data[i] = {track.keys()[kept[i]], track.values()[kept[i]]};
+
+    return Track<K, V, R>{std::move(data), track.interpolation(), track.interpolator(), track.before(), track.after()};
+}
+
+template<class K> Track<K, Vector3us, Quaternion> compressQuaternions(const TrackView<const K, const Quaternion, Quaternion>& track, const Float tolerance) {
+    CORRADE_ASSERT(tolerance >= 0.0f,
+        "Animation::compressQuaternions(): expected non-negative tolerance, got" << tolerance, (Track<K, Vector3us, Quaternion>{}));
+
+    const Interpolation interpolation = track.interpolation() == Interpolation::Constant ? Interpolation::Constant : Interpolation::Linear;
+    Quaternion(*const interpolator)(const Vector3us&, const Vector3us&, Float) =
+        interpolation == Interpolation::Constant ?
+            unpack<Vector3us, Quaternion, Math::select, unpackQuaternion>() :
+            unpack<Vector3us, Quaternion, Math::slerpShortestPath, unpackQuaternion>();
+
+    Containers::Array<Vector3us> packed{track.size()};
+    for(std::size_t i = 0; i != track.size(); ++i)
+        packed[i] = packQuaternion(track.values()[i]);
+
+    const Containers::Array<Quaternion> expected = Implementation::keyframeResults(track);
+    const Containers::Array<std::size_t> kept = Implementation::reduceKeyframes<K, Vector3us, Quaternion>(track.keys(), Containers::arrayView(packed), interpolator, Containers::arrayView(expected), tolerance);
+
+    Containers::Array<std::pair<K, Vector3us>> data{kept.size()};
+    for(std::size_t i = 0; i != kept.size(); ++i)
+        data[i] = {track.keys()[kept[i]], packed[kept[i]]};
+
+    return Track<K, Vector3us, Quaternion>{std::move(data), interpolation, interpolator, track.before(), track.after()};
+}
+
+}}
+
+#endif
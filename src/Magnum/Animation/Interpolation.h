@@ -175,8 +175,8 @@ MAGNUM_EXPORT Debug& operator<<(Debug& debug, Extrapolation value);
 @param frame        Frame at which to interpolate
 @param hint         Hint for keyframe search
 
-Does a linear search over the keyframes until it finds last keyframe which is
-not larger than @p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
+Searches the keyframes for last keyframe which is not larger than @p frame.
+Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
 calculated interpolation factor, returning the interpolated value.
 
 -   In case the first keyframe is already larger than @p frame or @p frame is
@@ -187,9 +187,13 @@ calculated interpolation factor, returning the interpolated value.
     the interpolator.
 -   In case no keyframes are present, default-constructed value is returned.
 
-The @p hint parameter hints where to start the linear search and is updated
-with keyframe index matching @p frame. If @p frame is earlier than @p hint, the
-search is restarted from the beginning.
+The @p hint parameter hints where to start the search and is updated with
+keyframe index matching @p frame. A few keyframes following @p hint are checked
+first, which makes sequential playback fast. If @p frame is earlier than
+@p hint or further away from it, a binary search over all keyframes is done
+instead, so random seeks are @f$ \mathcal{O}(\log n) @f$ as well. For tracks
+with uniformly spaced keyframes, see @ref UniformTrack, where the lookup is
+done in constant time.
 
 Used internally from @ref Track::at() / @ref TrackView::at(), see @ref Track
 documentation for more information.
@@ -203,12 +207,11 @@ template<class K, class V, class R = ResultOf<V>> R interpolate(const Containers
 /**
 @brief Interpolate animation value with strict constraints
 
-Does a linear search over the keyframes until it finds last keyframe which is
-not larger than @p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
+Searches the keyframes for last keyframe which is not larger than @p frame.
+Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
 calculated interpolation factor, returning the interpolated value. The @p hint
-parameter hints where to start the linear search and is updated with keyframe
-index matching @p frame. If @p frame is earlier than @p hint, the search is
-restarted from the beginning.
+parameter hints where to start the search and is updated with keyframe index
+matching @p frame, see @ref interpolate() for details about the search.
 
 This is a stricter but more performant version of @ref interpolate() with
 implicit @ref Extrapolation::Extrapolated behavior. Expects that there are
@@ -260,8 +263,8 @@ expressions give the same result:
 
 @see @ref unpackEase()
 */
-template<class T, class V, ResultOf<V>(*interpolator)(const V&, const V&, Float), V(*unpacker)(const T&)> constexpr auto unpack() -> ResultOf<V>(*)(const V&, const V&, Float) {
-    return [](const V& a, const V& b, Float t) { return interpolator(unpacker(a), unpacker(b), t); };
+template<class T, class V, ResultOf<V>(*interpolator)(const V&, const V&, Float), V(*unpacker)(const T&)> constexpr auto unpack() -> ResultOf<V>(*)(const T&, const T&, Float) {
+    return [](const T& a, const T& b, Float t) { return interpolator(unpacker(a), unpacker(b), t); };
 }
 
 /**
@@ -274,8 +277,8 @@ give the same result:
 
 @snippet MagnumAnimation.cpp unpackEase
 */
-template<class T, class V, ResultOf<V>(*interpolator)(const V&, const V&, Float), V(*unpacker)(const T&), Float(*easer)(Float)> constexpr auto unpackEase() -> ResultOf<V>(*)(const V&, const V&, Float) {
-    return [](const V& a, const V& b, Float t) { return interpolator(unpacker(a), unpacker(b), easer(t)); };
+template<class T, class V, ResultOf<V>(*interpolator)(const V&, const V&, Float), V(*unpacker)(const T&), Float(*easer)(Float)> constexpr auto unpackEase() -> ResultOf<V>(*)(const T&, const T&, Float) {
+    return [](const T& a, const T& b, Float t) { return interpolator(unpacker(a), unpacker(b), easer(t)); };
 }
 
 /**
@@ -285,8 +288,8 @@ In addition to @ref unpackEase() clamps value coming to @p easer to range
 @f$ [0 ; 1] @f$. Useful when extrapolating with @ref Easing functions that have
 bad behavior outside of this range.
 */
-template<class T, class V, ResultOf<V>(*interpolator)(const V&, const V&, Float), V(*unpacker)(const T&), Float(*easer)(Float)> constexpr auto unpackEaseClamped() -> ResultOf<V>(*)(const V&, const V&, Float) {
-    return [](const V& a, const V& b, Float t) { return interpolator(unpacker(a), unpacker(b), easer(Math::clamp(t, 0.0f, 1.0f))); };
+template<class T, class V, ResultOf<V>(*interpolator)(const V&, const V&, Float), V(*unpacker)(const T&), Float(*easer)(Float)> constexpr auto unpackEaseClamped() -> ResultOf<V>(*)(const T&, const T&, Float) {
+    return [](const T& a, const T& b, Float t) { return interpolator(unpacker(a), unpacker(b), easer(Math::clamp(t, 0.0f, 1.0f))); };
 }
 
 namespace Implementation {
@@ -408,6 +411,33 @@ TypeTraits<Math::CubicHermite<T>, T> {
     Interpolator interpolator(Interpolation interpolation);
 };
 
+/* Finds the last keyframe that's not larger than frame, clamped to the
+   [0, keys.size() - 2] range. Expects at least two keys. Sequential playback
+   usually moves just a keyframe or two forward, so first a few keys after the
+   hint are checked linearly. If the frame isn't there (or it's before the
+   hint), which is the case with seeking, it falls back to a binary search
+   instead of rewinding from the beginning. */
+template<class K> void interpolateFindKey(const Containers::StridedArrayView1D<const K>& keys, const K frame, std::size_t& hint) {
+    enum: std::size_t { LinearSearchSteps = 4 };
+
+    if(hint + 1 < keys.size() && !(frame < keys[hint])) {
+        for(std::size_t i = 0; i != LinearSearchSteps; ++i) {
+            if(hint + 2 >= keys.size() || frame < keys[hint + 1]) return;
+            ++hint;
+        }
+    }
+
+    /* Find the first key that's larger than frame in the [1, size - 1)
+       range, the hint is then the one before */
+    std::size_t begin = 1, end = keys.size() - 1;
+    while(begin < end) {
+        const std::size_t middle = begin + (end - begin)/2;
+        if(frame < keys[middle]) end = middle;
+        else begin = middle + 1;
+    }
+    hint = begin - 1;
+}
+
 }
 
 /* Needs to be defined later so it can pick up the TypeTraits definitions */
@@ -430,12 +460,8 @@ template<class K, class V, class R> R interpolate(const Containers::StridedArray
         return interpolator(values[0], values[0], 0.0f);
     }
 
-    /* Rewind from the beginning if hint is too late */
-    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
-
-    /* Go through the keys until we find a pair that is around given time */
-    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
-        ++hint;
+    /* Find a pair that is around given time */
+    Implementation::interpolateFindKey(keys, frame, hint);
 
     /* Special extrapolation outside of range. Usual extrapolation is handled
        below. */
@@ -455,12 +481,8 @@ template<class K, class V, class R> R interpolateStrict(const Containers::Stride
     CORRADE_ASSERT(keys.size() >= 2, "Animation::interpolateStrict(): at least two keyframes required", {});
     CORRADE_ASSERT(keys.size() == values.size(), "Animation::interpolateStrict(): keys and values don't have the same size", {});
 
-    /* Rewind from the beginning if hint is too late */
-    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
-
-    /* Go through the keys until we find a pair that is around given time */
-    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
-        ++hint;
+    /* Find a pair that is around given time */
+    Implementation::interpolateFindKey(keys, frame, hint);
 
     return interpolator(values[hint], values[hint + 1],
         Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame)));
@@ -25,6 +25,9 @@
 
 #include "Player.hpp"
 
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Vector4.h"
+
 namespace Magnum { namespace Animation {
 
 Debug& operator<<(Debug& debug, const State value) {
@@ -43,6 +46,40 @@ Debug& operator<<(Debug& debug, const State value) {
     return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
 }
 
+namespace Implementation {
+
+namespace {
+
+/* Same as playerBatchInterpolate(), but with the interpolator inlined */
+template<class V, class R, R(*interpolator)(const V&, const V&, Float)> inline void playerBatchInterpolateInlined(const V* const a, const V* const b, const Float* const t, R* const out, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = interpolator(a[i], b[i], t[i]);
+}
+
+}
+
+void playerBatchLerp(Float(*)(const Float&, const Float&, Float), const Float* const a, const Float* const b, const Float* const t, Float* const out, const std::size_t count) {
+    playerBatchInterpolateInlined<Float, Float, Math::lerp>(a, b, t, out, count);
+}
+
+void playerBatchLerp(Vector2(*)(const Vector2&, const Vector2&, Float), const Vector2* const a, const Vector2* const b, const Float* const t, Vector2* const out, const std::size_t count) {
+    playerBatchInterpolateInlined<Vector2, Vector2, Math::lerp>(a, b, t, out, count);
+}
+
+void playerBatchLerp(Vector3(*)(const Vector3&, const Vector3&, Float), const Vector3* const a, const Vector3* const b, const Float* const t, Vector3* const out, const std::size_t count) {
+    playerBatchInterpolateInlined<Vector3, Vector3, Math::lerp>(a, b, t, out, count);
+}
+
+void playerBatchLerp(Vector4(*)(const Vector4&, const Vector4&, Float), const Vector4* const a, const Vector4* const b, const Float* const t, Vector4* const out, const std::size_t count) {
+    playerBatchInterpolateInlined<Vector4, Vector4, Math::lerp>(a, b, t, out, count);
+}
+
+void playerBatchSlerpShortestPath(Quaternion(*)(const Quaternion&, const Quaternion&, Float), const Quaternion* const a, const Quaternion* const b, const Float* const t, Quaternion* const out, const std::size_t count) {
+    playerBatchInterpolateInlined<Quaternion, Quaternion, Math::slerpShortestPath>(a, b, t, out, count);
+}
+
+}
+
 /* On non-MinGW Windows the instantiations are already marked with extern
    template. However Clang-CL doesn't propagate the export from the extern
    template, it seems. */
@@ -30,7 +30,8 @@
  */
 
 #include <chrono>
-#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Animation/Track.h"
 #include "Magnum/Math/Range.h"
@@ -72,6 +73,158 @@ MAGNUM_EXPORT Debug& operator<<(Debug& debug, State value);
 
 namespace Implementation {
     template<class, class> struct DefaultScaler;
+
+    /* Interpolates count value pairs from contiguous arrays */
+    template<class V, class R> using PlayerBatchKernel = void(*)(R(*)(const V&, const V&, Float), const V*, const V*, const Float*, R*, std::size_t);
+
+    template<class V, class R> void playerBatchInterpolate(R(*const interpolator)(const V&, const V&, Float), const V* const a, const V* const b, const Float* const t, R* const out, const std::size_t count) {
+        for(std::size_t i = 0; i != count; ++i)
+            out[i] = interpolator(a[i], b[i], t[i]);
+    }
+
+    /* Kernels with the builtin interpolators inlined, which the compiler can
+       vectorize. Compiled into the library to not require including all
+       the math headers here. */
+    MAGNUM_EXPORT void playerBatchLerp(Float(*)(const Float&, const Float&, Float), const Float* a, const Float* b, const Float* t, Float* out, std::size_t count);
+    MAGNUM_EXPORT void playerBatchLerp(Vector2(*)(const Vector2&, const Vector2&, Float), const Vector2* a, const Vector2* b, const Float* t, Vector2* out, std::size_t count);
+    MAGNUM_EXPORT void playerBatchLerp(Vector3(*)(const Vector3&, const Vector3&, Float), const Vector3* a, const Vector3* b, const Float* t, Vector3* out, std::size_t count);
+    MAGNUM_EXPORT void playerBatchLerp(Vector4(*)(const Vector4&, const Vector4&, Float), const Vector4* a, const Vector4* b, const Float* t, Vector4* out, std::size_t count);
+    MAGNUM_EXPORT void playerBatchSlerpShortestPath(Quaternion(*)(const Quaternion&, const Quaternion&, Float), const Quaternion* a, const Quaternion* b, const Float* t, Quaternion* out, std::size_t count);
+
+    /* Picks an inlined kernel if the interpolator is the one that'd be picked
+       for Interpolation::Linear, otherwise calls through the pointer. Not
+       comparing to the Math function addresses directly as those might be
+       different in the library and in user code. */
+    template<class V, class R> struct PlayerBatchKernelFor {
+        static PlayerBatchKernel<V, R> kernel(R(*)(const V&, const V&, Float)) {
+            return playerBatchInterpolate<V, R>;
+        }
+    };
+    template<class V> struct PlayerBatchKernelForLerp {
+        static PlayerBatchKernel<V, V> kernel(V(*const interpolator)(const V&, const V&, Float)) {
+            if(interpolator == interpolatorFor<V, V>(Interpolation::Linear))
+                return static_cast<PlayerBatchKernel<V, V>>(playerBatchLerp);
+            return playerBatchInterpolate<V, V>;
+        }
+    };
+    template<> struct PlayerBatchKernelFor<Float, Float>: PlayerBatchKernelForLerp<Float> {};
+    template<> struct PlayerBatchKernelFor<Vector2, Vector2>: PlayerBatchKernelForLerp<Vector2> {};
+    template<> struct PlayerBatchKernelFor<Vector3, Vector3>: PlayerBatchKernelForLerp<Vector3> {};
+    template<> struct PlayerBatchKernelFor<Vector4, Vector4>: PlayerBatchKernelForLerp<Vector4> {};
+    template<> struct PlayerBatchKernelFor<Quaternion, Quaternion> {
+        static PlayerBatchKernel<Quaternion, Quaternion> kernel(Quaternion(*const interpolator)(const Quaternion&, const Quaternion&, Float)) {
+            if(interpolator == interpolatorFor<Quaternion, Quaternion>(Interpolation::Linear))
+                return playerBatchSlerpShortestPath;
+            return playerBatchInterpolate<Quaternion, Quaternion>;
+        }
+    };
+
+    /* Used to distinguish batches of different types without RTTI */
+    template<class V, class R> void playerBatchTypeId() {}
+
+    template<class K> struct PlayerBatch {
+        explicit PlayerBatch(void(*typeId)(), void(*interpolator)()) noexcept: typeId{typeId}, interpolator{interpolator} {}
+        virtual ~PlayerBatch() = default;
+
+        virtual std::size_t size() const = 0;
+        /* Advances tracks in range [begin, end) */
+        virtual void advance(K key, std::size_t begin, std::size_t end) = 0;
+
+        void(*typeId)();
+        void(*interpolator)();
+    };
+
+    /* Tracks of the same type and interpolator, with all per-track state in
+       separate arrays. Advancing first finds the keyframe pair for each track
+       and gathers the values into contiguous scratch arrays, then
+       interpolates all of them in one go and finally scatters the results to
+       the destinations. */
+    template<class K, class V, class R> class PlayerBatchImplementation: public PlayerBatch<K> {
+        public:
+            explicit PlayerBatchImplementation(R(*interpolator)(const V&, const V&, Float)): PlayerBatch<K>{playerBatchTypeId<V, R>, reinterpret_cast<void(*)()>(interpolator)}, _interpolator{interpolator}, _kernel{PlayerBatchKernelFor<V, R>::kernel(interpolator)} {}
+
+            void add(const TrackView<const K, const V, R>& track, R& destination) {
+                arrayAppend(_keys, track.keys());
+                arrayAppend(_values, track.values());
+                arrayAppend(_extrapolations, Containers::InPlaceInit, track.before(), track.after());
+                arrayAppend(_destinations, &destination);
+                arrayAppend(_hints, std::size_t{});
+                arrayAppend(_defaultConstructed, false);
+                arrayAppend(_a, V{});
+                arrayAppend(_b, V{});
+                arrayAppend(_factors, 0.0f);
+                arrayAppend(_results, R{});
+            }
+
+            std::size_t size() const override { return _destinations.size(); }
+
+            void advance(K key, std::size_t begin, std::size_t end) override;
+
+        private:
+            R(*_interpolator)(const V&, const V&, Float);
+            PlayerBatchKernel<V, R> _kernel;
+            Containers::Array<Containers::StridedArrayView1D<const K>> _keys;
+            Containers::Array<Containers::StridedArrayView1D<const V>> _values;
+            Containers::Array<std::pair<Extrapolation, Extrapolation>> _extrapolations;
+            Containers::Array<R*> _destinations;
+            Containers::Array<std::size_t> _hints;
+            Containers::Array<bool> _defaultConstructed;
+            Containers::Array<V> _a, _b;
+            Containers::Array<Float> _factors;
+            Containers::Array<R> _results;
+    };
+
+    /* Mirrors interpolate(), except that it doesn't call the interpolator */
+    template<class K, class V, class R> void PlayerBatchImplementation<K, V, R>::advance(const K key, const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            const Containers::StridedArrayView1D<const K>& keys = _keys[i];
+            const Containers::StridedArrayView1D<const V>& values = _values[i];
+            const Extrapolation before = _extrapolations[i].first;
+            const Extrapolation after = _extrapolations[i].second;
+            std::size_t& hint = _hints[i];
+            K frame = key;
+
+            /* No data, default-constructed value */
+            _defaultConstructed[i] = true;
+            if(!keys.size()) continue;
+
+            /* Only one frame, give it verbatim (or default-constructed, if
+               desired) */
+            if(keys.size() == 1) {
+                if((frame < keys[0] && before == Extrapolation::DefaultConstructed) ||
+                   (frame > keys[0] && after == Extrapolation::DefaultConstructed))
+                    continue;
+
+                _defaultConstructed[i] = false;
+                _a[i] = _b[i] = values[0];
+                _factors[i] = 0.0f;
+                continue;
+            }
+
+            interpolateFindKey(keys, frame, hint);
+
+            if(frame < keys[hint]) {
+                if(before == Extrapolation::DefaultConstructed) continue;
+                if(before == Extrapolation::Constant) frame = keys[hint];
+            } else if(frame >= keys[hint + 1]) {
+                if(after == Extrapolation::DefaultConstructed) continue;
+                if(after == Extrapolation::Constant) frame = keys[hint + 1];
+            }
+
+            _defaultConstructed[i] = false;
+            _a[i] = values[hint];
+            _b[i] = values[hint + 1];
+            _factors[i] = Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame));
+        }
+
+        /* Values of the default-constructed entries are stale but valid, so
+           it's fine to interpolate them as well, the results are just not
+           used */
+        _kernel(_interpolator, _a.data() + begin, _b.data() + begin, _factors.data() + begin, _results.data() + begin, end - begin);
+
+        for(std::size_t i = begin; i != end; ++i)
+            *_destinations[i] = _defaultConstructed[i] ? R{} : _results[i];
+    }
 }
 
 /**
@@ -207,6 +360,56 @@ to include to get all needed template function definitions. See also
 
 @snippet MagnumAnimation-custom.cpp Player-usage-custom
 
+@section Animation-Player-batched Batched tracks
+
+With many animated objects, the per-track overhead of @ref add() --- a call
+through a function pointer, a keyframe search and writing the result through a
+type-erased pointer for every track --- starts to dominate. Tracks added with
+@ref addBatched() are instead grouped by their value and result type and the
+interpolator function. Each such batch keeps the per-track state in separate
+arrays and @ref advance() evaluates it in three tight loops --- finding the
+keyframe pairs for all tracks, interpolating all of them at once and finally
+writing the results to the destinations:
+
+@snippet MagnumAnimation.cpp Player-addBatched
+
+For @ref Magnum::Float "Float", @ref Magnum::Vector2 "Vector2",
+@ref Magnum::Vector3 "Vector3" and @ref Magnum::Vector4 "Vector4" tracks using
+@ref Math::lerp() and @ref Magnum::Quaternion "Quaternion" tracks using
+@ref Math::slerpShortestPath(), which are the default interpolators for
+@ref Interpolation::Linear, the interpolation loop has the interpolator
+inlined, allowing the compiler to vectorize it. Other types and interpolators
+are called through the function pointer. The results are the same as with
+@ref add(). Batched tracks are advanced after all tracks added with
+@ref add(), @ref addWithCallback(), @ref addWithCallbackOnChange() and
+@ref addRawCallback(), there's no callback variant as that would defeat the
+purpose.
+
+@section Animation-Player-parallel Advancing in parallel
+
+Players are independent of each other, so when there's many of them, the work
+can be spread across multiple cores using @ref advanceParallel(). The state of
+all players is updated on the calling thread first, then tracks added with
+@ref add() and @ref addBatched() are split into chunks of a few hundred tracks
+and distributed among the threads. A player with many tracks thus gets
+advanced by multiple threads as well:
+
+@snippet MagnumAnimation.cpp Player-advanceParallel
+
+Tracks added with @ref addWithCallback(), @ref addWithCallbackOnChange() and
+@ref addRawCallback() execute user code, about which the player can't know
+whether it's safe to run concurrently. These are deferred and advanced on the
+calling thread after all threads finish, in the order the players were passed
+and in the order the tracks were added. Because of that, the callbacks can
+safely access destinations of any other tracks and they see them already
+updated for the new time. Apart from that the result is the same as with
+@ref advance(T, std::initializer_list<Containers::Reference<Player<T, K>>>).
+
+The destinations of non-callback tracks are written from the worker threads,
+so no two tracks should have the same destination. The threads are created on
+every call and destroyed at the end, so it's worth using only with at least
+several thousands of tracks in total.
+
 @section Animation-Player-higher-order Higher-order players, animating time
 
 Sometimes you might want to control multiple players at the same time or
@@ -265,6 +468,33 @@ template<class T, class K
          */
         static void advance(T time, std::initializer_list<Containers::Reference<Player<T, K>>> players);
 
+        #if defined(DOXYGEN_GENERATING_OUTPUT) || !defined(CORRADE_TARGET_EMSCRIPTEN)
+        /**
+         * @brief Advance multiple players at the same time in parallel
+         * @param time          Time to advance to
+         * @param players       Players to advance
+         * @param threadCount   Count of threads to use, including the
+         *      calling thread. If @cpp 0 @ce,
+         *      @ref std::thread::hardware_concurrency() is used.
+         * @m_since_latest
+         *
+         * Produces the same result as @ref advance(T, std::initializer_list<Containers::Reference<Player<T, K>>>).
+         * See @ref Animation-Player-parallel for more information. Expects
+         * that each player is present in @p players at most once.
+         *
+         * @note This function is not available on
+         *      @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", as threads are not
+         *      generally available there.
+         */
+        static void advanceParallel(T time, Containers::ArrayView<const Containers::Reference<Player<T, K>>> players, UnsignedInt threadCount = 0);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        static void advanceParallel(T time, std::initializer_list<Containers::Reference<Player<T, K>>> players, UnsignedInt threadCount = 0);
+        #endif
+
         /** @brief Constructor */
         explicit Player();
 
@@ -633,6 +863,63 @@ template<class T, class K
         }
         #endif
 
+        /**
+         * @brief Add a track to a batch
+         * @m_since_latest
+         *
+         * Similar to @ref add(), but instead of being advanced one by one
+         * through a type-erased function, tracks that have the same value
+         * and result type and the same interpolator function are grouped
+         * into a batch that's evaluated in a single tight loop. See
+         * @ref Animation-Player-batched for more information.
+         * @see @ref batchCount(), @ref batchedTrackCount()
+         */
+        template<class V, class R> Player<T, K>& addBatched(const TrackView<const K, const V, R>& track, R& destination);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        template<class V, class R> Player<T, K>& addBatched(const TrackView<K, V, R>& track, R& destination) {
+            return addBatched(reinterpret_cast<const TrackView<const K, const V, R>&>(track), destination);
+        }
+
+        /**
+         * @overload
+         * @m_since_latest
+         *
+         * Note that track ownership is *not* transferred to the @ref Player
+         * and you have to ensure that it's kept in scope for the whole
+         * lifetime of the @ref Player instance.
+         */
+        #ifndef CORRADE_MSVC2019_COMPATIBILITY
+        template<class V, class R> Player<T, K>& addBatched(const Track<K, V, R>& track, R& destination) {
+            return addBatched(TrackView<const K, const V, R>{track}, destination);
+        }
+        #else /* see the add() function for explanation */
+        template<class Track, class R> Player<T, K>& addBatched(const Track& track, R& destination) {
+            return addBatched<typename Track::ValueType, R>(static_cast<const TrackView<const K, const typename Track::ValueType, R>&>(track), destination);
+        }
+        #endif
+
+        /**
+         * @brief Count of track batches
+         * @m_since_latest
+         *
+         * @see @ref addBatched(), @ref batchedTrackCount()
+         */
+        std::size_t batchCount() const { return _batches.size(); }
+
+        /**
+         * @brief Count of batched tracks
+         * @m_since_latest
+         *
+         * Sum of track counts in all batches. Batched tracks are not included
+         * in @ref size().
+         * @see @ref addBatched(), @ref batchCount()
+         */
+        std::size_t batchedTrackCount() const;
+
         /**
          * @brief State
          *
@@ -804,11 +1091,13 @@ template<class T, class K
     private:
         struct Track;
 
-        Player<T, K>& addInternal(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData);
+        Player<T, K>& addInternal(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData, bool callback = true);
+        void joinDuration(const Math::Range1D<K>& duration);
 
         Containers::Optional<std::pair<UnsignedInt, K>> elapsedInternal(T time, T& updatedStartTime, T& updatedPauseTime, State& updatedState) const;
 
         Containers::Array<Track> _tracks;
+        Containers::Array<Containers::Pointer<Implementation::PlayerBatch<K>>> _batches;
         Math::Range1D<K> _duration;
         UnsignedInt _playCount{1};
         State _state{State::Stopped};
@@ -820,7 +1109,28 @@ template<class T, class K> template<class V, class R> Player<T, K>& Player<T, K>
     return addInternal(track,
         [](const TrackViewStorage<const K>& track, K key, std::size_t& hint, void* destination, void(*)(), void*) {
             *static_cast<R*>(destination) = static_cast<const TrackView<const K, const V, R>&>(track).at(key, hint);
-        }, &destination, nullptr, nullptr);
+        }, &destination, nullptr, nullptr, false);
+}
+
+template<class T, class K> template<class V, class R> Player<T, K>& Player<T, K>::addBatched(const TrackView<const K, const V, R>& track, R& destination) {
+    joinDuration(track.duration());
+
+    /* Find a batch with the same type and interpolator or create a new one.
+       Expecting just a handful of batches, so a linear search is fine. */
+    const auto interpolator = track.interpolator();
+    Implementation::PlayerBatchImplementation<K, V, R>* batch = nullptr;
+    for(Containers::Pointer<Implementation::PlayerBatch<K>>& i: _batches) {
+        if(i->typeId != static_cast<void(*)()>(Implementation::playerBatchTypeId<V, R>) || i->interpolator != reinterpret_cast<void(*)()>(interpolator)) continue;
+        batch = static_cast<Implementation::PlayerBatchImplementation<K, V, R>*>(i.get());
+        break;
+    }
+    if(!batch) {
+        batch = new Implementation::PlayerBatchImplementation<K, V, R>{interpolator};
+        arrayAppend(_batches, Containers::Pointer<Implementation::PlayerBatch<K>>{batch});
+    }
+
+    batch->add(track, destination);
+    return *this;
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
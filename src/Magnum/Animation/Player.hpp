@@ -35,6 +35,12 @@
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Reference.h>
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <algorithm>
+
+#include "Magnum/Implementation/Parallel.h"
+#endif
+
 namespace Magnum { namespace Animation {
 
 namespace Implementation {
@@ -61,7 +67,7 @@ namespace Implementation {
 template<class T, class K> struct Player<T, K>::Track  {
     /* Not sure why is this still needed for emplace_back(). It's 2018,
        COME ON  ¯\_(ツ)_/¯ */
-    /*implicit*/ Track(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData, std::size_t hint) noexcept: track{track}, advancer{advancer}, destination{destination}, userCallback{userCallback}, userCallbackData{userCallbackData}, hint{hint} {}
+    /*implicit*/ Track(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData, std::size_t hint, bool callback) noexcept: track{track}, advancer{advancer}, destination{destination}, userCallback{userCallback}, userCallbackData{userCallbackData}, hint{hint}, callback{callback} {}
 
     TrackViewStorage<const K> track;
     void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*);
@@ -69,6 +75,9 @@ template<class T, class K> struct Player<T, K>::Track  {
     void(*userCallback)();
     void* userCallbackData;
     std::size_t hint;
+    /* If set, the advancer calls into user code and thus is run on the
+       calling thread in advanceParallel() */
+    bool callback;
 };
 #endif
 
@@ -87,13 +96,20 @@ template<class T, class K> Player<T, K>::Player(Scaler scaler): _scaler{scaler}
 template<class T, class K> Player<T, K>::~Player() = default;
 
 template<class T, class K> bool Player<T, K>::isEmpty() const {
-    return _tracks.empty();
+    return _tracks.empty() && _batches.empty();
 }
 
 template<class T, class K> std::size_t Player<T, K>::size() const {
     return _tracks.size();
 }
 
+template<class T, class K> std::size_t Player<T, K>::batchedTrackCount() const {
+    std::size_t count = 0;
+    for(const Containers::Pointer<Implementation::PlayerBatch<K>>& batch: _batches)
+        count += batch->size();
+    return count;
+}
+
 template<class T, class K> const TrackViewStorage<const K>& Player<T, K>::track(std::size_t i) const {
     CORRADE_ASSERT(i < _tracks.size(),
         /* Returning track 0 so we can test this w/ MSVC debug iterators */
@@ -101,12 +117,16 @@ template<class T, class K> const TrackViewStorage<const K>& Player<T, K>::track(
     return _tracks[i].track;
 }
 
-template<class T, class K> Player<T, K>& Player<T, K>::addInternal(const TrackViewStorage<const K>& track, void(*const advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* const destination, void(*const userCallback)(), void* const userCallbackData) {
-    if(_tracks.empty() && _duration == Math::Range1D<K>{})
-        _duration = track.duration();
+template<class T, class K> void Player<T, K>::joinDuration(const Math::Range1D<K>& duration) {
+    if(isEmpty() && _duration == Math::Range1D<K>{})
+        _duration = duration;
     else
-        _duration = Math::join(track.duration(), _duration);
-    arrayAppend(_tracks, Containers::InPlaceInit, track, advancer, destination, userCallback, userCallbackData, 0u);
+        _duration = Math::join(duration, _duration);
+}
+
+template<class T, class K> Player<T, K>& Player<T, K>::addInternal(const TrackViewStorage<const K>& track, void(*const advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* const destination, void(*const userCallback)(), void* const userCallbackData, const bool callback) {
+    joinDuration(track.duration());
+    arrayAppend(_tracks, Containers::InPlaceInit, track, advancer, destination, userCallback, userCallbackData, 0u, callback);
     return *this;
 }
 
@@ -295,6 +315,82 @@ template<class T, class K> std::pair<UnsignedInt, K> Player<T, K>::elapsed(const
     return {0, K{}};
 }
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+template<class T, class K> void Player<T, K>::advanceParallel(const T time, const Containers::ArrayView<const Containers::Reference<Player<T, K>>> players, UnsignedInt threadCount) {
+    threadCount = Magnum::Implementation::resolveThreadCount(threadCount);
+
+    /* The same player passed twice would have its tracks advanced by two
+       threads at once, racing on the hints and destinations. Sorting a copy
+       instead of comparing each pair to keep this cheap for many players. */
+    #ifndef CORRADE_NO_ASSERT
+    {
+        Containers::Array<const Player<T, K>*> sorted{Containers::NoInit, players.size()};
+        for(std::size_t i = 0; i != players.size(); ++i)
+            sorted[i] = &players[i].get();
+        std::sort(sorted.begin(), sorted.end());
+        CORRADE_ASSERT(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end(),
+            "Animation::Player::advanceParallel(): a player was passed more than once", );
+    }
+    #endif
+
+    /* Update state of all players on the calling thread and split their
+       tracks into chunks. A chunk with batch set to ~std::size_t{} is a range
+       of regular tracks, otherwise it's a range in given batch. */
+    enum: std::size_t { ChunkSize = 256 };
+    struct Chunk {
+        Player<T, K>* player;
+        K key;
+        std::size_t batch, begin, end;
+    };
+    Containers::Array<Chunk> chunks;
+    Containers::Array<std::pair<Player<T, K>*, K>> advanced;
+    for(Player<T, K>& player: players) {
+        Containers::Optional<std::pair<UnsignedInt, K>> elapsed = Implementation::playerElapsed(player._duration.size(), player._playCount, player._scaler, time, player._startTime, player._stopPauseTime, player._state);
+        if(!elapsed) continue;
+
+        const K key = player._duration.min() + elapsed->second;
+        arrayAppend(advanced, Containers::InPlaceInit, &player, key);
+        for(std::size_t i = 0; i < player._tracks.size(); i += ChunkSize)
+            arrayAppend(chunks, Chunk{&player, key, ~std::size_t{}, i, std::min(i + ChunkSize, player._tracks.size())});
+        for(std::size_t i = 0; i != player._batches.size(); ++i) {
+            const std::size_t size = player._batches[i]->size();
+            for(std::size_t j = 0; j < size; j += ChunkSize)
+                arrayAppend(chunks, Chunk{&player, key, i, j, std::min(j + ChunkSize, size)});
+        }
+    }
+
+    /* The chunks are roughly the same size, process them one by one on
+       whichever thread is free */
+    Magnum::Implementation::parallelFor(chunks.size(), 1, threadCount, [&chunks](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            const Chunk& chunk = chunks[i];
+            if(chunk.batch != ~std::size_t{}) {
+                chunk.player->_batches[chunk.batch]->advance(chunk.key, chunk.begin, chunk.end);
+                continue;
+            }
+
+            for(std::size_t j = chunk.begin; j != chunk.end; ++j) {
+                Track& t = chunk.player->_tracks[j];
+                if(t.callback) continue;
+                t.advancer(t.track, chunk.key, t.hint, t.destination, t.userCallback, t.userCallbackData);
+            }
+        }
+    });
+
+    /* Tracks with callbacks on the calling thread, in order */
+    for(const std::pair<Player<T, K>*, K>& player: advanced) {
+        for(Track& t: player.first->_tracks) {
+            if(!t.callback) continue;
+            t.advancer(t.track, player.second, t.hint, t.destination, t.userCallback, t.userCallbackData);
+        }
+    }
+}
+
+template<class T, class K> void Player<T, K>::advanceParallel(const T time, const std::initializer_list<Containers::Reference<Player<T, K>>> players, const UnsignedInt threadCount) {
+    advanceParallel(time, Containers::arrayView(players.begin(), players.size()), threadCount);
+}
+#endif
+
 template<class T, class K> Player<T, K>& Player<T, K>::advance(const T time) {
     /* Get the elapsed time. If we shouldn't advance anything (player already
        stopped / not yet playing, quit */
@@ -302,8 +398,13 @@ template<class T, class K> Player<T, K>& Player<T, K>::advance(const T time) {
     if(!elapsed) return *this;
 
     /* Advance all tracks. Properly handle durations that don't start at 0. */
+    const K key = _duration.min() + elapsed->second;
     for(Track& t: _tracks)
-        t.advancer(t.track, _duration.min() + elapsed->second, t.hint, t.destination, t.userCallback, t.userCallbackData);
+        t.advancer(t.track, key, t.hint, t.destination, t.userCallback, t.userCallbackData);
+
+    /* Advance all batches */
+    for(Containers::Pointer<Implementation::PlayerBatch<K>>& batch: _batches)
+        batch->advance(key, 0, batch->size());
 
     return *this;
 }
@@ -24,8 +24,12 @@
 */
 
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Animation/Compression.h"
 #include "Magnum/Animation/Player.h"
+#include "Magnum/Animation/UniformTrack.h"
 
 namespace Magnum { namespace Animation { namespace Test { namespace {
 
@@ -42,6 +46,11 @@ struct Benchmark: TestSuite::Tester {
     void atStrict();
     void atStrictInterleaved();
     void atStrictInterleavedDirectInterpolator();
+    void atSeek();
+    void atSeekUniform();
+    void atQuaternion();
+    void atQuaternionCompressed();
+    void unpackQuaternion();
 
     void playerAdvanceEmpty();
     void playerAdvanceEmptyTrack();
@@ -50,6 +59,11 @@ struct Benchmark: TestSuite::Tester {
     void playerAdvanceRawCallback();
     void playerAdvanceRawCallbackDirectInterpolator();
 
+    void playerAdvanceManyVector3();
+    void playerAdvanceManyVector3Batched();
+    void playerAdvanceManyQuaternion();
+    void playerAdvanceManyQuaternionBatched();
+
     Containers::Array<Float> _keys;
     Containers::Array<Int> _values;
     Containers::Array<std::pair<Float, Int>> _interleaved;
@@ -57,10 +71,20 @@ struct Benchmark: TestSuite::Tester {
     Containers::StridedArrayView1D<const Int> _valuesInterleaved;
     TrackView<const Float, const Int> _track;
     TrackView<const Float, const Int> _trackInterleaved;
+
+    Containers::Array<std::pair<Float, Vector3>> _vector3Data;
+    Containers::Array<std::pair<Float, Quaternion>> _quaternionData;
+
+    Track<Float, Quaternion> _rotations;
+    Track<Float, Vector3us, Quaternion> _compressedRotations;
 };
 
 namespace {
-    enum: std::size_t { DataSize = 2000 };
+    enum: std::size_t {
+        DataSize = 2000,
+        TrackCount = 1000,
+        ManyDataSize = 16
+    };
 }
 
 Benchmark::Benchmark() {
@@ -74,13 +98,23 @@ Benchmark::Benchmark() {
                    &Benchmark::atStrict,
                    &Benchmark::atStrictInterleaved,
                    &Benchmark::atStrictInterleavedDirectInterpolator,
+                   &Benchmark::atSeek,
+                   &Benchmark::atSeekUniform,
+                   &Benchmark::atQuaternion,
+                   &Benchmark::atQuaternionCompressed,
+                   &Benchmark::unpackQuaternion,
 
                    &Benchmark::playerAdvanceEmpty,
                    &Benchmark::playerAdvanceEmptyTrack,
                    &Benchmark::playerAdvance,
                    &Benchmark::playerAdvanceCallback,
                    &Benchmark::playerAdvanceRawCallback,
-                   &Benchmark::playerAdvanceRawCallbackDirectInterpolator}, 10);
+                   &Benchmark::playerAdvanceRawCallbackDirectInterpolator,
+
+                   &Benchmark::playerAdvanceManyVector3,
+                   &Benchmark::playerAdvanceManyVector3Batched,
+                   &Benchmark::playerAdvanceManyQuaternion,
+                   &Benchmark::playerAdvanceManyQuaternionBatched}, 10);
 
     _keys = Containers::Array<Float>{DataSize};
     _values = Containers::Array<Int>{Containers::DirectInit, DataSize, 1};
@@ -94,6 +128,21 @@ Benchmark::Benchmark() {
     _track = TrackView<const Float, const Int>{
         Containers::arrayView(_keys), Containers::arrayView(_values), Math::select};
     _trackInterleaved = {_keysInterleaved, _valuesInterleaved, Math::select};
+
+    _vector3Data = Containers::Array<std::pair<Float, Vector3>>{ManyDataSize};
+    _quaternionData = Containers::Array<std::pair<Float, Quaternion>>{ManyDataSize};
+    for(std::size_t i = 0; i != ManyDataSize; ++i) {
+        _vector3Data[i] = {Float(i)*0.5f, Vector3{Float(i), Float(i % 3), -Float(i)}};
+        _quaternionData[i] = {Float(i)*0.5f, Quaternion::rotation(Rad(Float(i)), Vector3::xAxis())};
+    }
+
+    /* Accelerating rotation, so with zero tolerance the compression doesn't
+       remove any keyframes and only the decoding cost is measured */
+    Containers::Array<std::pair<Float, Quaternion>> rotationData{DataSize};
+    for(std::size_t i = 0; i != DataSize; ++i)
+        rotationData[i] = {Float(i), Quaternion::rotation(Rad(Float(i*i)*0.0001f), Vector3{1.0f, 0.5f, -0.3f}.normalized())};
+    _rotations = Track<Float, Quaternion>{std::move(rotationData), Interpolation::Linear};
+    _compressedRotations = compressQuaternions(_rotations, 0.0f);
 }
 
 void Benchmark::interpolateEmpty() {
@@ -184,6 +233,65 @@ void Benchmark::atStrictInterleavedDirectInterpolator() {
     CORRADE_COMPARE(result, 125000);
 }
 
+/* Jumping back and forth over the whole track, the hint doesn't help much
+   here */
+void Benchmark::atSeek() {
+    Int result{};
+    CORRADE_BENCHMARK(250) {
+        std::size_t hint{};
+        for(std::size_t i = 0; i != 500; ++i)
+            result += _track.at(Float((i*7919) % DataSize)*3.1254f, hint);
+    }
+    CORRADE_COMPARE(result, 125000);
+}
+
+void Benchmark::atSeekUniform() {
+    UniformTrackView<Float, const Int> track{
+        {0.0f, Float(DataSize - 1)*3.1254f}, Containers::arrayView(_values), Math::select};
+
+    Int result{};
+    CORRADE_BENCHMARK(250) {
+        for(std::size_t i = 0; i != 500; ++i)
+            result += track.at(Float((i*7919) % DataSize)*3.1254f);
+    }
+    CORRADE_COMPARE(result, 125000);
+}
+
+void Benchmark::atQuaternion() {
+    Quaternion result;
+    CORRADE_BENCHMARK(250) {
+        std::size_t hint{};
+        for(Float i = 0.0f; i < 500.0f; i += 1.0f)
+            result = _rotations.at(i, hint);
+    }
+    CORRADE_COMPARE(result, _rotations.values()[499]);
+}
+
+void Benchmark::atQuaternionCompressed() {
+    CORRADE_COMPARE(_compressedRotations.size(), _rotations.size());
+
+    Quaternion result;
+    CORRADE_BENCHMARK(250) {
+        std::size_t hint{};
+        for(Float i = 0.0f; i < 500.0f; i += 1.0f)
+            result = _compressedRotations.at(i, hint);
+    }
+    CORRADE_COMPARE_AS(Implementation::keyframeError(result, _rotations.values()[499]), 2.0e-4f,
+        TestSuite::Compare::Less);
+}
+
+void Benchmark::unpackQuaternion() {
+    CORRADE_COMPARE(_compressedRotations.size(), _rotations.size());
+
+    Quaternion result;
+    CORRADE_BENCHMARK(250) {
+        for(std::size_t i = 0; i != 500; ++i)
+            result = Animation::unpackQuaternion(_compressedRotations.values()[i]);
+    }
+    CORRADE_COMPARE_AS(Implementation::keyframeError(result, _rotations.values()[499]), 2.0e-4f,
+        TestSuite::Compare::Less);
+}
+
 void Benchmark::playerAdvanceEmpty() {
     Player<Float> player;
     player.play(0.0f);
@@ -260,6 +368,62 @@ void Benchmark::playerAdvanceRawCallbackDirectInterpolator() {
     CORRADE_COMPARE(result, 125000);
 }
 
+/* The same data for all tracks, as the extra memory traffic from having
+   distinct data would hide the interpolation overhead */
+void Benchmark::playerAdvanceManyVector3() {
+    Containers::Array<Vector3> result{TrackCount};
+    Player<Float> player;
+    for(Vector3& i: result)
+        player.add(TrackView<const Float, const Vector3>{_vector3Data, Interpolation::Linear}, i);
+    player.play({});
+    CORRADE_BENCHMARK(5) {
+        for(Float i = 0.0f; i < 7.25f; i += 0.25f)
+            player.advance(i);
+    }
+    CORRADE_COMPARE(result[TrackCount - 1], _vector3Data[ManyDataSize - 2].second);
+}
+
+void Benchmark::playerAdvanceManyVector3Batched() {
+    Containers::Array<Vector3> result{TrackCount};
+    Player<Float> player;
+    for(Vector3& i: result)
+        player.addBatched(TrackView<const Float, const Vector3>{_vector3Data, Interpolation::Linear}, i);
+    player.play({});
+    CORRADE_BENCHMARK(5) {
+        for(Float i = 0.0f; i < 7.25f; i += 0.25f)
+            player.advance(i);
+    }
+    CORRADE_COMPARE(player.batchCount(), 1);
+    CORRADE_COMPARE(result[TrackCount - 1], _vector3Data[ManyDataSize - 2].second);
+}
+
+void Benchmark::playerAdvanceManyQuaternion() {
+    Containers::Array<Quaternion> result{TrackCount};
+    Player<Float> player;
+    for(Quaternion& i: result)
+        player.add(TrackView<const Float, const Quaternion>{_quaternionData, Interpolation::Linear}, i);
+    player.play({});
+    CORRADE_BENCHMARK(5) {
+        for(Float i = 0.0f; i < 7.25f; i += 0.25f)
+            player.advance(i);
+    }
+    CORRADE_COMPARE(result[TrackCount - 1], _quaternionData[ManyDataSize - 2].second);
+}
+
+void Benchmark::playerAdvanceManyQuaternionBatched() {
+    Containers::Array<Quaternion> result{TrackCount};
+    Player<Float> player;
+    for(Quaternion& i: result)
+        player.addBatched(TrackView<const Float, const Quaternion>{_quaternionData, Interpolation::Linear}, i);
+    player.play({});
+    CORRADE_BENCHMARK(5) {
+        for(Float i = 0.0f; i < 7.25f; i += 0.25f)
+            player.advance(i);
+    }
+    CORRADE_COMPARE(player.batchCount(), 1);
+    CORRADE_COMPARE(result[TrackCount - 1], _quaternionData[ManyDataSize - 2].second);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Animation::Test::Benchmark)
@@ -0,0 +1,347 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/Compression.h"
+#include "Magnum/Animation/Player.h"
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct CompressionTest: TestSuite::Tester {
+    explicit CompressionTest();
+
+    void packQuaternionIdentity();
+    void packUnpackQuaternion();
+
+    void reduceKeyframes();
+    void reduceKeyframesRotation();
+    void reduceKeyframesTooSmall();
+    void reduceKeyframesInvalid();
+
+    void compressQuaternions();
+    void compressQuaternionsConstant();
+    void compressQuaternionsPlayer();
+    void compressQuaternionsInvalid();
+
+    void trackError();
+    void trackErrorComplex();
+    void trackErrorEmpty();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    Quaternion quaternion;
+} PackUnpackQuaternionData[] {
+    {"identity", {}},
+    {"largest X", Quaternion::rotation(160.0_degf, Vector3{1.0f, 0.2f, -0.1f}.normalized())},
+    {"largest Y", Quaternion::rotation(135.0_degf, Vector3{-0.3f, 1.0f, 0.5f}.normalized())},
+    {"largest Z", Quaternion::rotation(170.0_degf, Vector3{0.1f, 0.1f, 1.0f}.normalized())},
+    {"largest W", Quaternion::rotation(35.0_degf, Vector3{0.4f, -0.7f, 0.2f}.normalized())},
+    {"largest W negative", -Quaternion::rotation(35.0_degf, Vector3{0.4f, -0.7f, 0.2f}.normalized())},
+    {"largest Y negative", -Quaternion::rotation(135.0_degf, Vector3{-0.3f, 1.0f, 0.5f}.normalized())},
+    {"two equal components", Quaternion::rotation(90.0_degf, Vector3::xAxis())}
+};
+
+const struct {
+    const char* name;
+    Float tolerance;
+    std::size_t keyCount;
+    Float keys[5];
+} ReduceKeyframesData[] {
+    {"zero tolerance", 0.0f, 5, {0.0f, 3.0f, 4.0f, 5.0f, 6.0f}},
+    {"small tolerance", 0.01f, 5, {0.0f, 3.0f, 4.0f, 5.0f, 6.0f}},
+    {"large tolerance", 0.6f, 4, {0.0f, 3.0f, 4.0f, 6.0f}},
+    {"huge tolerance", 100.0f, 2, {0.0f, 6.0f}}
+};
+
+CompressionTest::CompressionTest() {
+    addTests({&CompressionTest::packQuaternionIdentity});
+
+    addInstancedTests({&CompressionTest::packUnpackQuaternion},
+        Containers::arraySize(PackUnpackQuaternionData));
+
+    addInstancedTests({&CompressionTest::reduceKeyframes},
+        Containers::arraySize(ReduceKeyframesData));
+
+    addTests({&CompressionTest::reduceKeyframesRotation,
+              &CompressionTest::reduceKeyframesTooSmall,
+              &CompressionTest::reduceKeyframesInvalid,
+
+              &CompressionTest::compressQuaternions,
+              &CompressionTest::compressQuaternionsConstant,
+              &CompressionTest::compressQuaternionsPlayer,
+              &CompressionTest::compressQuaternionsInvalid,
+
+              &CompressionTest::trackError,
+              &CompressionTest::trackErrorComplex,
+              &CompressionTest::trackErrorEmpty});
+}
+
+void CompressionTest::packQuaternionIdentity() {
+    /* W is the largest, so index 3 in the top bits, the remaining components
+       are zero, which is in the middle of the 15-bit range */
+    CORRADE_COMPARE(packQuaternion({}), (Vector3us{0xc000, 0xc000, 0x4000}));
+}
+
+void CompressionTest::packUnpackQuaternion() {
+    auto&& data = PackUnpackQuaternionData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    CORRADE_VERIFY(data.quaternion.isNormalized());
+
+    const Quaternion unpacked = unpackQuaternion(packQuaternion(data.quaternion));
+    CORRADE_VERIFY(unpacked.isNormalized());
+
+    /* The unpacked quaternion can be negated and the precision is lower than
+       what fuzzy compare expects, compare the angle between the rotations */
+    CORRADE_COMPARE_AS(Implementation::keyframeError(unpacked, data.quaternion), 2.0e-4f,
+        TestSuite::Compare::Less);
+}
+
+void CompressionTest::reduceKeyframes() {
+    auto&& data = ReduceKeyframesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Track<Float, Vector3> track{{
+        {0.0f, {0.0f, 0.0f, 0.0f}},
+        {1.0f, {1.0f, 0.0f, 0.0f}},
+        {2.0f, {2.0f, 0.0f, 0.0f}},
+        {3.0f, {3.0f, 0.0f, 0.0f}},
+        {4.0f, {4.0f, 1.0f, 0.0f}},
+        {5.0f, {5.0f, 0.0f, 0.0f}},
+        {6.0f, {6.0f, 0.0f, 0.0f}}
+    }, Interpolation::Linear, Math::lerp, Extrapolation::Extrapolated, Extrapolation::DefaultConstructed};
+
+    const Track<Float, Vector3> reduced = Animation::reduceKeyframes(track, data.tolerance);
+    CORRADE_COMPARE(reduced.interpolation(), Interpolation::Linear);
+    CORRADE_VERIFY(reduced.interpolator() == static_cast<Vector3(*)(const Vector3&, const Vector3&, Float)>(Math::lerp));
+    CORRADE_COMPARE(reduced.before(), Extrapolation::Extrapolated);
+    CORRADE_COMPARE(reduced.after(), Extrapolation::DefaultConstructed);
+    CORRADE_COMPARE(reduced.size(), data.keyCount);
+    for(std::size_t i = 0; i != reduced.size(); ++i) {
+        CORRADE_COMPARE(reduced.keys()[i], data.keys[i]);
+        CORRADE_COMPARE(reduced.values()[i], track.at(reduced.keys()[i]));
+    }
+
+    /* Allowing for some floating-point imprecision in the interpolation */
+    CORRADE_COMPARE_AS(Animation::trackError(track, reduced).max, data.tolerance + 1.0e-6f,
+        TestSuite::Compare::LessOrEqual);
+}
+
+void CompressionTest::reduceKeyframesRotation() {
+    /* Rotation with a constant speed, slerp can reproduce it from just the
+       first and the last keyframe */
+    const Track<Float, Quaternion> track{{
+        {0.0f, Quaternion::rotation(0.0_degf, Vector3::yAxis())},
+        {1.0f, Quaternion::rotation(10.0_degf, Vector3::yAxis())},
+        {2.0f, Quaternion::rotation(20.0_degf, Vector3::yAxis())},
+        {3.0f, Quaternion::rotation(30.0_degf, Vector3::yAxis())},
+        {4.0f, Quaternion::rotation(40.0_degf, Vector3::yAxis())}
+    }, Interpolation::Linear};
+
+    const Track<Float, Quaternion> reduced = Animation::reduceKeyframes(track, 1.0e-4f);
+    CORRADE_COMPARE(reduced.size(), 2);
+    CORRADE_COMPARE(reduced.keys()[0], 0.0f);
+    CORRADE_COMPARE(reduced.keys()[1], 4.0f);
+    CORRADE_COMPARE(reduced.at(2.5f), Quaternion::rotation(25.0_degf, Vector3::yAxis()));
+}
+
+void CompressionTest::reduceKeyframesTooSmall() {
+    const Track<Float, Float> empty{nullptr, Math::lerp};
+    CORRADE_COMPARE(Animation::reduceKeyframes(empty, 1.0f).size(), 0);
+
+    const Track<Float, Float> single{{{1.0f, 3.0f}}, Math::lerp};
+    const Track<Float, Float> singleReduced = Animation::reduceKeyframes(single, 1.0f);
+    CORRADE_COMPARE(singleReduced.size(), 1);
+    CORRADE_COMPARE(singleReduced.keys()[0], 1.0f);
+    CORRADE_COMPARE(singleReduced.values()[0], 3.0f);
+
+    /* The first and the last keyframe is kept always */
+    const Track<Float, Float> two{{{1.0f, 3.0f}, {2.0f, 3.0f}}, Math::lerp};
+    CORRADE_COMPARE(Animation::reduceKeyframes(two, 1.0f).size(), 2);
+}
+
+void CompressionTest::reduceKeyframesInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Track<Float, Float> track{{
+        {1.0f, 3.0f},
+        {2.0f, 1.0f}
+    }, Math::lerp};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Animation::reduceKeyframes(track, -0.5f);
+    CORRADE_COMPARE(out.str(), "Animation::reduceKeyframes(): expected non-negative tolerance, got -0.5\n");
+}
+
+void CompressionTest::compressQuaternions() {
+    const Track<Float, Quaternion> track{{
+        {0.0f, Quaternion::rotation(0.0_degf, Vector3::yAxis())},
+        {1.0f, Quaternion::rotation(10.0_degf, Vector3::yAxis())},
+        {2.0f, Quaternion::rotation(20.0_degf, Vector3::yAxis())},
+        {3.0f, Quaternion::rotation(70.0_degf, Vector3::yAxis())},
+        {4.0f, Quaternion::rotation(120.0_degf, Vector3::yAxis())},
+        {5.0f, Quaternion::rotation(170.0_degf, Vector3::yAxis())}
+    }, Interpolation::Linear, Extrapolation::Extrapolated};
+
+    const Track<Float, Vector3us, Quaternion> compressed = Animation::compressQuaternions(track, 1.0e-3f);
+    CORRADE_COMPARE(compressed.interpolation(), Interpolation::Linear);
+    CORRADE_COMPARE(compressed.before(), Extrapolation::Extrapolated);
+    CORRADE_COMPARE(compressed.after(), Extrapolation::Extrapolated);
+
+    /* The speed changes at 2.0, the rest is linear */
+    CORRADE_COMPARE(compressed.size(), 3);
+    CORRADE_COMPARE(compressed.keys()[0], 0.0f);
+    CORRADE_COMPARE(compressed.keys()[1], 2.0f);
+    CORRADE_COMPARE(compressed.keys()[2], 5.0f);
+    CORRADE_COMPARE(compressed.values()[1], packQuaternion(track.values()[2]));
+
+    /* The largest component of the 170° rotation is different than of the
+       others, slerp should still go the short way */
+    CORRADE_COMPARE_AS(Implementation::keyframeError(compressed.at(3.5f), Quaternion::rotation(95.0_degf, Vector3::yAxis())), 2.0e-4f,
+        TestSuite::Compare::Less);
+
+    const TrackError error = Animation::trackError(track, compressed);
+    CORRADE_COMPARE_AS(error.max, 1.0e-3f,
+        TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(error.average, error.max,
+        TestSuite::Compare::LessOrEqual);
+}
+
+void CompressionTest::compressQuaternionsConstant() {
+    const Track<Float, Quaternion> track{{
+        {0.0f, Quaternion::rotation(0.0_degf, Vector3::yAxis())},
+        {1.0f, Quaternion::rotation(0.0_degf, Vector3::yAxis())},
+        {2.0f, Quaternion::rotation(30.0_degf, Vector3::yAxis())},
+        {3.0f, Quaternion::rotation(30.0_degf, Vector3::yAxis())}
+    }, Interpolation::Constant};
+
+    const Track<Float, Vector3us, Quaternion> compressed = Animation::compressQuaternions(track, 1.0e-3f);
+    CORRADE_COMPARE(compressed.interpolation(), Interpolation::Constant);
+    CORRADE_COMPARE(compressed.size(), 3);
+    CORRADE_COMPARE(compressed.keys()[0], 0.0f);
+    CORRADE_COMPARE(compressed.keys()[1], 2.0f);
+    CORRADE_COMPARE(compressed.keys()[2], 3.0f);
+    CORRADE_COMPARE_AS(Implementation::keyframeError(compressed.at(1.5f), Quaternion{}), 2.0e-4f,
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(Implementation::keyframeError(compressed.at(2.5f), Quaternion::rotation(30.0_degf, Vector3::yAxis())), 2.0e-4f,
+        TestSuite::Compare::Less);
+}
+
+void CompressionTest::compressQuaternionsPlayer() {
+    const Track<Float, Quaternion> track{{
+        {0.0f, Quaternion::rotation(0.0_degf, Vector3::xAxis())},
+        {1.0f, Quaternion::rotation(45.0_degf, Vector3::xAxis())},
+        {2.0f, Quaternion::rotation(90.0_degf, Vector3::xAxis())}
+    }, Interpolation::Linear};
+
+    const Track<Float, Vector3us, Quaternion> compressed = Animation::compressQuaternions(track, 1.0e-3f);
+    CORRADE_COMPARE(compressed.size(), 2);
+
+    Quaternion rotation;
+    Player<Float> player;
+    player.add(compressed, rotation)
+        .play(0.0f);
+
+    player.advance(1.5f);
+    CORRADE_COMPARE_AS(Implementation::keyframeError(rotation, Quaternion::rotation(67.5_degf, Vector3::xAxis())), 2.0e-4f,
+        TestSuite::Compare::Less);
+}
+
+void CompressionTest::compressQuaternionsInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Track<Float, Quaternion> track{{
+        {1.0f, {}},
+        {2.0f, {}}
+    }, Interpolation::Linear};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Animation::compressQuaternions(track, -0.5f);
+    CORRADE_COMPARE(out.str(), "Animation::compressQuaternions(): expected non-negative tolerance, got -0.5\n");
+}
+
+void CompressionTest::trackError() {
+    const Track<Float, Float> original{{
+        {0.0f, 0.0f},
+        {1.0f, 1.0f},
+        {2.0f, 0.0f}
+    }, Math::lerp};
+    const Track<Float, Float> reduced{{
+        {0.0f, 0.0f},
+        {2.0f, 0.0f}
+    }, Math::lerp};
+
+    /* Evaluated at 0, 0.5, 1, 1.5 and 2 */
+    const TrackError error = Animation::trackError(original, reduced);
+    CORRADE_COMPARE(error.max, 1.0f);
+    CORRADE_COMPARE(error.average, 0.4f);
+}
+
+void CompressionTest::trackErrorComplex() {
+    /* A difference over 90° has a negative real part, which shouldn't get
+       folded back to the complementary angle */
+    const Track<Float, Complex> original{{
+        {0.0f, Complex::rotation(0.0_degf)},
+        {1.0f, Complex::rotation(170.0_degf)},
+        {2.0f, Complex::rotation(0.0_degf)}
+    }, Math::select};
+    const Track<Float, Complex> reduced{{
+        {0.0f, Complex::rotation(0.0_degf)},
+        {2.0f, Complex::rotation(0.0_degf)}
+    }, Math::select};
+
+    /* Evaluated at 0, 0.5, 1, 1.5 and 2, with 1 and 1.5 being 170° off */
+    const TrackError error = Animation::trackError(original, reduced);
+    CORRADE_COMPARE(error.max, Float(Rad(170.0_degf)));
+    CORRADE_COMPARE(error.average, Float(Rad(68.0_degf)));
+}
+
+void CompressionTest::trackErrorEmpty() {
+    const Track<Float, Float> empty{nullptr, Math::lerp};
+    const Track<Float, Float> compressed{{{0.0f, 1.0f}}, Math::lerp};
+
+    const TrackError error = Animation::trackError(empty, compressed);
+    CORRADE_COMPARE(error.max, 0.0f);
+    CORRADE_COMPARE(error.average, 0.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::CompressionTest)
@@ -69,6 +69,9 @@ struct InterpolationTest: TestSuite::Tester {
     void interpolateHint();
     void interpolateStrictHint();
 
+    void interpolateSeek();
+    void interpolateStrictSeek();
+
     void interpolateDifferentResultType();
     void interpolateStrictDifferentResultType();
 
@@ -191,7 +194,10 @@ InterpolationTest::InterpolationTest() {
                        &InterpolationTest::interpolateStrictHint},
                        Containers::arraySize(HintData));
 
-    addTests({&InterpolationTest::interpolateDifferentResultType,
+    addTests({&InterpolationTest::interpolateSeek,
+              &InterpolationTest::interpolateStrictSeek,
+
+              &InterpolationTest::interpolateDifferentResultType,
               &InterpolationTest::interpolateStrictDifferentResultType,
 
               &InterpolationTest::interpolateError,
@@ -518,6 +524,57 @@ void InterpolationTest::interpolateStrictHint() {
     CORRADE_COMPARE(hint, 2);
 }
 
+/* Frames in an arbitrary order so the search has to go both ways and far
+   away from the hint, including exact keyframe values and both ends */
+constexpr Float SeekFrames[]{
+    0.0f, 250.0f, 249.9f, 1.0f, 980.1f, 0.35f, 1000.0f, 3.6f, 722.5f, 722.5f,
+    722.6f, -1.0f, 490.0f, 490.1f, 12.0f, 1200.0f, 0.1f, 980.0f, 40.0f};
+
+/* Counts keys not larger than the frame, which is what the linear search
+   from the beginning would do */
+std::size_t seekExpectedHint(Containers::ArrayView<const Float> keys, Float frame) {
+    std::size_t hint = 0;
+    while(hint + 2 < keys.size() && frame >= keys[hint + 1]) ++hint;
+    return hint;
+}
+
+void InterpolationTest::interpolateSeek() {
+    /* Keys spaced non-uniformly, values linear with the keys so the expected
+       value is trivial to calculate */
+    Float keys[100];
+    Float values[100];
+    for(std::size_t i = 0; i != Containers::arraySize(keys); ++i) {
+        keys[i] = Float(i*i)*0.1f;
+        values[i] = keys[i]*2.0f;
+    }
+
+    std::size_t hint{};
+    for(const Float frame: SeekFrames) {
+        Float value = Animation::interpolate<Float, Float>(keys, values,
+            Extrapolation::Extrapolated, Extrapolation::Extrapolated,
+            Math::lerp, frame, hint);
+        CORRADE_COMPARE(hint, seekExpectedHint(keys, frame));
+        CORRADE_COMPARE(value, frame*2.0f);
+    }
+}
+
+void InterpolationTest::interpolateStrictSeek() {
+    Float keys[100];
+    Float values[100];
+    for(std::size_t i = 0; i != Containers::arraySize(keys); ++i) {
+        keys[i] = Float(i*i)*0.1f;
+        values[i] = keys[i]*2.0f;
+    }
+
+    std::size_t hint{};
+    for(const Float frame: SeekFrames) {
+        Float value = Animation::interpolateStrict<Float, Float>(keys, values,
+            Math::lerp, frame, hint);
+        CORRADE_COMPARE(hint, seekExpectedHint(keys, frame));
+        CORRADE_COMPARE(value, frame*2.0f);
+    }
+}
+
 using namespace Math::Literals;
 
 const Half HalfValues[]{3.0_h, 1.0_h, 2.5_h, 0.5_h};
@@ -24,6 +24,10 @@
 */
 
 #include <sstream>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#include <vector>
+#endif
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/TestSuite/Tester.h>
@@ -31,6 +35,7 @@
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 
+#include "Magnum/Math/Quaternion.h"
 #include "Magnum/Animation/Player.h"
 
 namespace Magnum { namespace Animation { namespace Test { namespace {
@@ -86,6 +91,12 @@ struct PlayerTest: TestSuite::Tester {
     template<class T> void addWithCallbackOnChange();
     template<class T> void addWithCallbackOnChangeTemplate();
     template<class T> void addRawCallback();
+    template<class T> void addBatched();
+    void addBatchedGrouping();
+    void advanceBatched();
+
+    void advanceParallel();
+    void advanceParallelDuplicate();
 
     void runFor100YearsFloat();
     void runFor100YearsChrono();
@@ -128,6 +139,15 @@ const struct {
         true, true},
 };
 
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} AdvanceParallelData[]{
+    {"one thread", 1},
+    {"four threads", 4},
+    {"hardware thread count", 0}
+};
+
 PlayerTest::PlayerTest() {
     addTests({&PlayerTest::constructEmpty,
               &PlayerTest::construct,
@@ -181,7 +201,16 @@ PlayerTest::PlayerTest() {
               &PlayerTest::addWithCallbackOnChangeTemplate<Track<Float, Float>>,
               &PlayerTest::addWithCallbackOnChangeTemplate<TrackView<Float, Float>>,
               &PlayerTest::addRawCallback<Track<Float, Float>>,
-              &PlayerTest::addRawCallback<TrackView<Float, Float>>});
+              &PlayerTest::addRawCallback<TrackView<Float, Float>>,
+              &PlayerTest::addBatched<Track<Float, Float>>,
+              &PlayerTest::addBatched<TrackView<Float, Float>>,
+              &PlayerTest::addBatchedGrouping,
+              &PlayerTest::advanceBatched});
+
+    addInstancedTests({&PlayerTest::advanceParallel},
+        Containers::arraySize(AdvanceParallelData));
+
+    addTests({&PlayerTest::advanceParallelDuplicate});
 
     addInstancedTests({
         &PlayerTest::runFor100YearsFloat,
@@ -1330,6 +1359,201 @@ template<class T> void PlayerTest::addRawCallback() {
         TestSuite::Compare::Container);
 }
 
+template<class T> void PlayerTest::addBatched() {
+    setTestCaseTemplateName(AddTemplate<T>::name());
+
+    Float value = -1.0f;
+    Player<Float> player;
+    player.addBatched(addTemplateTrack<T>(), value)
+        .play(2.0f);
+
+    CORRADE_COMPARE(player.duration().size(), 3.0f);
+    CORRADE_COMPARE(player.state(), State::Playing);
+    CORRADE_VERIFY(!player.isEmpty());
+    CORRADE_COMPARE(player.size(), 0);
+    CORRADE_COMPARE(player.batchCount(), 1);
+    CORRADE_COMPARE(player.batchedTrackCount(), 1);
+    CORRADE_COMPARE(value, -1.0f);
+
+    /* 1.75 secs in */
+    player.advance(3.75f);
+    CORRADE_COMPARE(player.state(), State::Playing);
+    CORRADE_COMPARE(value, 4.0f);
+}
+
+void PlayerTest::addBatchedGrouping() {
+    const Animation::Track<Float, Float> selectTrack{{
+        {0.5f, 3.0f},
+        {5.0f, 1.0f}
+    }, Math::select};
+    const Animation::Track<Float, Vector3> vectorTrack{{
+        {1.0f, Vector3::xAxis()},
+        {2.0f, Vector3::yAxis()}
+    }, Interpolation::Linear};
+
+    Float a, b, c;
+    Vector3 d;
+    Player<Float> player;
+    player.addBatched(Track, a)
+        .addBatched(selectTrack, b)
+        .addBatched(Track, c)
+        .addBatched(vectorTrack, d);
+
+    /* Float lerp, Float select and Vector3 lerp */
+    CORRADE_COMPARE(player.batchCount(), 3);
+    CORRADE_COMPARE(player.batchedTrackCount(), 4);
+    CORRADE_COMPARE(player.size(), 0);
+    CORRADE_COMPARE(player.duration(), (Range1D{0.5f, 5.0f}));
+}
+
+void PlayerTest::advanceBatched() {
+    using namespace Math::Literals;
+
+    /* Float with a custom interpolator, going through the function pointer */
+    const Animation::Track<Float, Float> customTrack{{
+        {1.0f, 1.5f},
+        {2.5f, 3.0f},
+        {3.0f, 5.0f},
+        {4.0f, 2.0f}
+    }, [](const Float& a, const Float& b, Float t) { return a + b*t; },
+        Extrapolation::DefaultConstructed, Extrapolation::Extrapolated};
+    /* Vector3 with the inlined lerp */
+    const Animation::Track<Float, Vector3> vectorTrack{{
+        {0.5f, Vector3::xAxis()},
+        {2.0f, Vector3::yAxis(2.0f)},
+        {3.5f, Vector3::zAxis(-1.0f)}
+    }, Interpolation::Linear, Extrapolation::Extrapolated, Extrapolation::DefaultConstructed};
+    /* Quaternion with the inlined shortest-path slerp */
+    const Animation::Track<Float, Quaternion> quaternionTrack{{
+        {1.5f, Quaternion::rotation(15.0_degf, Vector3::xAxis())},
+        {2.5f, Quaternion::rotation(-170.0_degf, Vector3::yAxis())},
+        {4.5f, Quaternion::rotation(90.0_degf, Vector3::zAxis())}
+    }, Interpolation::Linear};
+    /* Single keyframe and no keyframes */
+    const Animation::Track<Float, Vector3> singleTrack{{
+        {2.0f, Vector3{1.0f, 2.0f, 3.0f}}
+    }, Interpolation::Linear, Extrapolation::Constant, Extrapolation::DefaultConstructed};
+    const Animation::Track<Float, Vector3> emptyTrack{Containers::Array<std::pair<Float, Vector3>>{}, Interpolation::Linear};
+
+    Float customExpected, customActual;
+    Vector3 vectorExpected, vectorActual, singleExpected, singleActual, emptyExpected, emptyActual;
+    Quaternion quaternionExpected, quaternionActual;
+
+    Player<Float> expected;
+    expected.add(customTrack, customExpected)
+        .add(vectorTrack, vectorExpected)
+        .add(quaternionTrack, quaternionExpected)
+        .add(singleTrack, singleExpected)
+        .add(emptyTrack, emptyExpected)
+        .setDuration({0.0f, 5.0f})
+        .play(0.0f);
+
+    Player<Float> actual;
+    actual.addBatched(customTrack, customActual)
+        .addBatched(vectorTrack, vectorActual)
+        .addBatched(quaternionTrack, quaternionActual)
+        .addBatched(singleTrack, singleActual)
+        .addBatched(emptyTrack, emptyActual)
+        .setDuration({0.0f, 5.0f})
+        .play(0.0f);
+
+    CORRADE_COMPARE(actual.duration(), expected.duration());
+
+    /* Going forward and then back to test the hints */
+    for(Float time: {0.0f, 0.25f, 0.75f, 1.0f, 1.75f, 2.0f, 2.6f, 3.1f, 3.75f, 4.5f, 1.25f, 4.75f}) {
+        actual.seekTo(time, time);
+        expected.seekTo(time, time);
+        actual.advance(time);
+        expected.advance(time);
+
+        CORRADE_COMPARE(customActual, customExpected);
+        CORRADE_COMPARE(vectorActual, vectorExpected);
+        CORRADE_COMPARE(quaternionActual, quaternionExpected);
+        CORRADE_COMPARE(singleActual, singleExpected);
+        CORRADE_COMPARE(emptyActual, emptyExpected);
+    }
+}
+
+void PlayerTest::advanceParallel() {
+    auto&& data = AdvanceParallelData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Threads are not available on Emscripten.");
+    #else
+    struct CallbackData {
+        std::thread::id thread;
+        std::vector<Int> order;
+    } callbackData;
+
+    /* More tracks than what fits into a single chunk */
+    const std::size_t trackCount = 1000;
+    Containers::Array<Float> aValues{Containers::DirectInit, trackCount, -1.0f};
+    Containers::Array<Float> aBatched{Containers::DirectInit, trackCount, -1.0f};
+    Containers::Array<Float> bValues{Containers::DirectInit, trackCount, -1.0f};
+    Containers::Array<Float> cValues{Containers::DirectInit, trackCount, -1.0f};
+    Float onChange = -1.0f;
+
+    Player<Float> a, b, c;
+    for(std::size_t i = 0; i != trackCount; ++i) {
+        a.add(Track, aValues[i])
+         .addBatched(Track, aBatched[i]);
+        b.add(Track, bValues[i]);
+        c.add(Track, cValues[i]);
+    }
+    a.addWithCallback(Track, [](Float, const Float&, CallbackData& data) {
+        data.thread = std::this_thread::get_id();
+        data.order.push_back(1);
+    }, callbackData)
+     .addWithCallbackOnChange(Track, [](Float, const Float&, CallbackData& data) {
+        data.order.push_back(2);
+    }, onChange, callbackData);
+    b.addWithCallback(Track, [](Float, const Float&, CallbackData& data) {
+        data.order.push_back(3);
+    }, callbackData);
+
+    /* The last one is not playing, so it shouldn't get advanced */
+    a.play(2.0f);
+    b.play(2.0f);
+
+    /* 1.75 secs in */
+    Player<Float>::advanceParallel(3.75f, {a, b, c}, data.threadCount);
+    for(std::size_t i = 0; i != trackCount; ++i) {
+        CORRADE_COMPARE(aValues[i], 4.0f);
+        CORRADE_COMPARE(aBatched[i], 4.0f);
+        CORRADE_COMPARE(bValues[i], 4.0f);
+        CORRADE_COMPARE(cValues[i], -1.0f);
+    }
+
+    /* Callbacks are run on the calling thread, in order */
+    CORRADE_COMPARE(onChange, 4.0f);
+    CORRADE_VERIFY(callbackData.thread == std::this_thread::get_id());
+    CORRADE_COMPARE_AS(callbackData.order, (std::vector<Int>{1, 2, 3}),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void PlayerTest::advanceParallelDuplicate() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Threads are not available on Emscripten.");
+    #elif defined(CORRADE_NO_ASSERT)
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #else
+    Float value = -1.0f;
+    Player<Float> a, b;
+    a.add(Track, value)
+     .play(2.0f);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Player<Float>::advanceParallel(3.75f, {a, b, a});
+    CORRADE_COMPARE(out.str(), "Animation::Player::advanceParallel(): a player was passed more than once\n");
+
+    /* Nothing got advanced */
+    CORRADE_COMPARE(value, -1.0f);
+    #endif
+}
+
 void PlayerTest::runFor100YearsFloat() {
     auto&& data = RunFor100YearsData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
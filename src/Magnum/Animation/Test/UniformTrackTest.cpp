@@ -0,0 +1,368 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/UniformTrack.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct UniformTrackTest: TestSuite::Tester {
+    explicit UniformTrackTest();
+
+    void constructEmpty();
+    void constructInterpolator();
+    void constructInterpolation();
+    void constructInterpolationInterpolator();
+    void constructView();
+    void constructCopy();
+    void constructMove();
+    void convertToView();
+    void convertToConstView();
+
+    void key();
+    void keyInvalid();
+
+    void at();
+    void atSingleValue();
+    void atNoValues();
+    void atZeroDuration();
+
+    void resample();
+    void resampleDefaultConstructed();
+    void resampleInvalid();
+};
+
+const struct {
+    const char* name;
+    Extrapolation extrapolationBefore;
+    Extrapolation extrapolationAfter;
+} AtData[] {
+    {"default-constructed",
+        Extrapolation::DefaultConstructed, Extrapolation::DefaultConstructed},
+    {"constant",
+        Extrapolation::Constant, Extrapolation::Constant},
+    {"extrapolated",
+        Extrapolation::Extrapolated, Extrapolation::Extrapolated},
+    {"mixed",
+        Extrapolation::Constant, Extrapolation::DefaultConstructed}
+};
+
+UniformTrackTest::UniformTrackTest() {
+    addTests({&UniformTrackTest::constructEmpty,
+              &UniformTrackTest::constructInterpolator,
+              &UniformTrackTest::constructInterpolation,
+              &UniformTrackTest::constructInterpolationInterpolator,
+              &UniformTrackTest::constructView,
+              &UniformTrackTest::constructCopy,
+              &UniformTrackTest::constructMove,
+              &UniformTrackTest::convertToView,
+              &UniformTrackTest::convertToConstView,
+
+              &UniformTrackTest::key,
+              &UniformTrackTest::keyInvalid});
+
+    addInstancedTests({&UniformTrackTest::at,
+                       &UniformTrackTest::atSingleValue},
+        Containers::arraySize(AtData));
+
+    addTests({&UniformTrackTest::atNoValues,
+              &UniformTrackTest::atZeroDuration,
+
+              &UniformTrackTest::resample,
+              &UniformTrackTest::resampleDefaultConstructed,
+              &UniformTrackTest::resampleInvalid});
+}
+
+void UniformTrackTest::constructEmpty() {
+    const UniformTrack<Float, Float> a;
+
+    CORRADE_COMPARE(a.duration(), Range1D{});
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_VERIFY(!a.values());
+    CORRADE_VERIFY(!a.interpolator());
+    CORRADE_COMPARE(a.at(42.0f), 0.0f);
+}
+
+void UniformTrackTest::constructInterpolator() {
+    const UniformTrack<Float, Vector3> a{{1.0f, 5.0f}, {
+        Vector3{3.0f, 1.0f, 0.1f},
+        Vector3{0.3f, 0.6f, 1.0f},
+        Vector3{0.5f, 2.0f, 3.0f}
+    }, Math::lerp, Extrapolation::Extrapolated};
+
+    CORRADE_COMPARE(a.duration(), (Range1D{1.0f, 5.0f}));
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.values()[1], (Vector3{0.3f, 0.6f, 1.0f}));
+    CORRADE_COMPARE(a.interpolation(), Interpolation::Custom);
+    CORRADE_VERIFY(a.interpolator() == static_cast<Vector3(*)(const Vector3&, const Vector3&, Float)>(Math::lerp));
+    CORRADE_COMPARE(a.before(), Extrapolation::Extrapolated);
+    CORRADE_COMPARE(a.after(), Extrapolation::Extrapolated);
+    CORRADE_COMPARE(a.at(2.0f), (Vector3{1.65f, 0.8f, 0.55f}));
+}
+
+void UniformTrackTest::constructInterpolation() {
+    const UniformTrack<Float, Vector3> a{{1.0f, 5.0f}, {
+        Vector3{3.0f, 1.0f, 0.1f},
+        Vector3{0.3f, 0.6f, 1.0f},
+        Vector3{0.5f, 2.0f, 3.0f}
+    }, Interpolation::Constant};
+
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.interpolation(), Interpolation::Constant);
+    CORRADE_VERIFY(a.interpolator() == static_cast<Vector3(*)(const Vector3&, const Vector3&, Float)>(Math::select));
+    CORRADE_COMPARE(a.before(), Extrapolation::Constant);
+    CORRADE_COMPARE(a.after(), Extrapolation::Constant);
+    CORRADE_COMPARE(a.at(2.0f), (Vector3{3.0f, 1.0f, 0.1f}));
+}
+
+void UniformTrackTest::constructInterpolationInterpolator() {
+    Containers::Array<Float> values{Containers::InPlaceInit, {3.0f, 1.0f}};
+    const UniformTrack<Float, Float> a{{1.0f, 5.0f}, std::move(values),
+        Interpolation::Linear, Math::select,
+        Extrapolation::Extrapolated, Extrapolation::DefaultConstructed};
+
+    CORRADE_COMPARE(a.size(), 2);
+    CORRADE_COMPARE(a.interpolation(), Interpolation::Linear);
+    CORRADE_VERIFY(a.interpolator() == static_cast<Float(*)(const Float&, const Float&, Float)>(Math::select));
+    CORRADE_COMPARE(a.before(), Extrapolation::Extrapolated);
+    CORRADE_COMPARE(a.after(), Extrapolation::DefaultConstructed);
+    CORRADE_COMPARE(a.at(2.0f), 3.0f);
+}
+
+void UniformTrackTest::constructView() {
+    const Float values[]{3.0f, 1.0f, 2.5f};
+    const UniformTrackView<Float, const Float> a{{1.0f, 5.0f}, values,
+        Interpolation::Linear, Extrapolation::DefaultConstructed,
+        Extrapolation::Extrapolated};
+
+    CORRADE_COMPARE(a.duration(), (Range1D{1.0f, 5.0f}));
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.values().data(), values);
+    CORRADE_COMPARE(a.interpolation(), Interpolation::Linear);
+    CORRADE_COMPARE(a.before(), Extrapolation::DefaultConstructed);
+    CORRADE_COMPARE(a.after(), Extrapolation::Extrapolated);
+    CORRADE_COMPARE(a.at(4.0f), 1.75f);
+    CORRADE_COMPARE(a.at(Math::select, 4.0f), 1.0f);
+}
+
+void UniformTrackTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<UniformTrack<Float, Float>, const UniformTrack<Float, Float>&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<UniformTrack<Float, Float>, const UniformTrack<Float, Float>&>{}));
+}
+
+void UniformTrackTest::constructMove() {
+    UniformTrack<Float, Float> a{{1.0f, 5.0f}, {3.0f, 1.0f}, Math::lerp};
+    const Float* data = a.values().data();
+
+    UniformTrack<Float, Float> b{std::move(a)};
+    CORRADE_COMPARE(b.values().data(), data);
+    CORRADE_COMPARE(b.duration(), (Range1D{1.0f, 5.0f}));
+
+    UniformTrack<Float, Float> c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.values().data(), data);
+    CORRADE_COMPARE(c.at(3.0f), 2.0f);
+}
+
+void UniformTrackTest::convertToView() {
+    UniformTrack<Float, Float> a{{1.0f, 5.0f}, {3.0f, 1.0f}, Math::lerp,
+        Extrapolation::Extrapolated};
+
+    const UniformTrackView<Float, Float> view = a;
+    CORRADE_COMPARE(view.values().data(), a.values().data());
+    CORRADE_COMPARE(view.size(), 2);
+    CORRADE_COMPARE(view.duration(), (Range1D{1.0f, 5.0f}));
+    CORRADE_COMPARE(view.before(), Extrapolation::Extrapolated);
+    CORRADE_COMPARE(view.after(), Extrapolation::Extrapolated);
+    CORRADE_COMPARE(view.at(3.0f), 2.0f);
+
+    const UniformTrack<Float, Float>& ca = a;
+    const UniformTrackView<Float, const Float> cview = ca;
+    CORRADE_COMPARE(cview.values().data(), a.values().data());
+    CORRADE_COMPARE(cview.at(3.0f), 2.0f);
+}
+
+void UniformTrackTest::convertToConstView() {
+    Float values[]{3.0f, 1.0f};
+    const UniformTrackView<Float, Float> a{{1.0f, 5.0f}, values, Math::lerp};
+    const UniformTrackView<Float, const Float> b = a;
+    CORRADE_COMPARE(b.values().data(), values);
+    CORRADE_COMPARE(b.duration(), (Range1D{1.0f, 5.0f}));
+    CORRADE_COMPARE(b.interpolation(), Interpolation::Custom);
+    CORRADE_COMPARE(b.at(3.0f), 2.0f);
+}
+
+void UniformTrackTest::key() {
+    const UniformTrack<Float, Float> a{{1.0f, 5.0f}, {3.0f, 1.0f, 2.5f, 0.5f, 4.0f}, Math::lerp};
+    CORRADE_COMPARE(a.key(0), 1.0f);
+    CORRADE_COMPARE(a.key(1), 2.0f);
+    CORRADE_COMPARE(a.key(3), 4.0f);
+    CORRADE_COMPARE(a.key(4), 5.0f);
+
+    const UniformTrackView<Float, const Float> view = a;
+    CORRADE_COMPARE(view.key(2), 3.0f);
+
+    const UniformTrack<Float, Float> single{{1.0f, 5.0f}, {3.0f}, Math::lerp};
+    CORRADE_COMPARE(single.key(0), 1.0f);
+}
+
+void UniformTrackTest::keyInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UniformTrack<Float, Float> a{{1.0f, 5.0f}, {3.0f, 1.0f}, Math::lerp};
+    const UniformTrackView<Float, const Float> view = a;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.key(2);
+    view.key(2);
+    CORRADE_COMPARE(out.str(),
+        "Animation::UniformTrack::key(): index 2 out of range for 2 values\n"
+        "Animation::UniformTrackView::key(): index 2 out of range for 2 values\n");
+}
+
+void UniformTrackTest::at() {
+    auto&& data = AtData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Should behave exactly like a track with uniformly spaced keys */
+    const Track<Float, Float> expected{{
+        {1.0f, 3.0f},
+        {3.0f, 1.0f},
+        {5.0f, 2.5f},
+        {7.0f, 0.5f}
+    }, Math::lerp, data.extrapolationBefore, data.extrapolationAfter};
+    const UniformTrack<Float, Float> track{{1.0f, 7.0f}, {
+        3.0f, 1.0f, 2.5f, 0.5f
+    }, Math::lerp, data.extrapolationBefore, data.extrapolationAfter};
+
+    for(Float time: {-3.0f, 0.5f, 1.0f, 1.5f, 3.0f, 4.25f, 5.0f, 6.999f, 7.0f, 8.5f, 100.0f})
+        CORRADE_COMPARE(track.at(time), expected.at(time));
+}
+
+void UniformTrackTest::atSingleValue() {
+    auto&& data = AtData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Track<Float, Float> expected{{
+        {2.0f, 3.0f}
+    }, Math::lerp, data.extrapolationBefore, data.extrapolationAfter};
+    const UniformTrack<Float, Float> track{{2.0f, 2.0f}, {3.0f}, Math::lerp,
+        data.extrapolationBefore, data.extrapolationAfter};
+
+    for(Float time: {-3.0f, 2.0f, 2.5f})
+        CORRADE_COMPARE(track.at(time), expected.at(time));
+}
+
+void UniformTrackTest::atNoValues() {
+    const UniformTrack<Float, Float> track{{1.0f, 2.0f}, nullptr, Math::lerp};
+    CORRADE_COMPARE(track.at(-1.0f), 0.0f);
+    CORRADE_COMPARE(track.at(1.5f), 0.0f);
+}
+
+void UniformTrackTest::atZeroDuration() {
+    /* Behaves as with constant extrapolation instead of producing NaNs */
+    const UniformTrack<Float, Float> track{{1.0f, 1.0f}, {3.0f, 1.0f, 2.5f},
+        Math::lerp, Extrapolation::Extrapolated};
+    CORRADE_COMPARE(track.at(0.5f), 3.0f);
+    CORRADE_COMPARE(track.at(1.0f), 2.5f);
+    CORRADE_COMPARE(track.at(1.5f), 2.5f);
+}
+
+void UniformTrackTest::resample() {
+    /* Non-uniform keys */
+    const Track<Float, Vector3> track{{
+        {1.0f, Vector3{3.0f, 1.0f, 0.1f}},
+        {1.5f, Vector3{0.3f, 0.6f, 1.0f}},
+        {4.0f, Vector3{0.5f, 2.0f, 3.0f}},
+        {5.0f, Vector3{1.0f, 0.0f, -1.0f}}
+    }, Interpolation::Linear, Extrapolation::Extrapolated, Extrapolation::Constant};
+
+    const UniformTrack<Float, Vector3> resampled = Animation::resample(track, 9);
+    CORRADE_COMPARE(resampled.size(), 9);
+    CORRADE_COMPARE(resampled.duration(), (Range1D{1.0f, 5.0f}));
+    CORRADE_COMPARE(resampled.interpolation(), Interpolation::Linear);
+    CORRADE_COMPARE(resampled.before(), Extrapolation::Extrapolated);
+    CORRADE_COMPARE(resampled.after(), Extrapolation::Constant);
+
+    /* The samples should match the original track */
+    for(std::size_t i = 0; i != resampled.size(); ++i) {
+        CORRADE_COMPARE(resampled.key(i), 1.0f + Float(i)*0.5f);
+        CORRADE_COMPARE(resampled.values()[i], track.at(resampled.key(i)));
+    }
+
+    /* In between too, as all keys of the original are at the sample points */
+    for(Float time: {1.25f, 2.75f, 4.6f, 6.0f})
+        CORRADE_COMPARE(resampled.at(time), track.at(time));
+}
+
+void UniformTrackTest::resampleDefaultConstructed() {
+    const Track<Float, Float> track{{
+        {1.0f, 3.0f},
+        {2.0f, 1.0f},
+        {5.0f, 4.0f}
+    }, Math::lerp, Extrapolation::DefaultConstructed};
+
+    /* The last sample shouldn't be default-constructed even though evaluating
+       the track exactly at the last key gives a default-constructed value */
+    const UniformTrack<Float, Float> resampled = Animation::resample(TrackView<const Float, const Float>{track}, 5, Interpolation::Constant);
+    CORRADE_COMPARE(resampled.size(), 5);
+    CORRADE_COMPARE(resampled.interpolation(), Interpolation::Constant);
+    CORRADE_COMPARE(resampled.before(), Extrapolation::DefaultConstructed);
+    CORRADE_COMPARE(resampled.after(), Extrapolation::DefaultConstructed);
+    CORRADE_COMPARE(resampled.values()[0], 3.0f);
+    CORRADE_COMPARE(resampled.values()[1], 1.0f);
+    CORRADE_COMPARE(resampled.values()[2], 2.0f);
+    CORRADE_COMPARE(resampled.values()[3], 3.0f);
+    CORRADE_COMPARE(resampled.values()[4], 4.0f);
+    CORRADE_COMPARE(resampled.at(0.5f), 0.0f);
+    CORRADE_COMPARE(resampled.at(5.0f), 0.0f);
+}
+
+void UniformTrackTest::resampleInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Track<Float, Float> track{{
+        {1.0f, 3.0f},
+        {2.0f, 1.0f}
+    }, Math::lerp};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Animation::resample(track, 1);
+    CORRADE_COMPARE(out.str(), "Animation::resample(): expected at least two samples, got 1\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::UniformTrackTest)
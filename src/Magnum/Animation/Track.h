@@ -76,12 +76,32 @@ performance. You have the following options:
 @subsection Animation-Track-performance-hint Keyframe hinting
 
 The @ref Track and @ref TrackView classes are fully stateless and the
-@ref at(K) const function performs a linear search for matching keyframe from
-the beginning every time. You can use @ref at(K, std::size_t&) const to
-remember last used keyframe index and pass it in the next iteration as a hint:
+@ref at(K) const function searches for matching keyframe from the beginning
+every time, which is a binary search for all but the shortest tracks. You can
+use @ref at(K, std::size_t&) const to remember last used keyframe index and
+pass it in the next iteration as a hint. The keyframe is then usually found
+after checking just one or two keyframes following the hint, and if it's not,
+the binary search is used as a fallback:
 
 @snippet MagnumAnimation.cpp Track-performance-hint
 
+@subsection Animation-Track-performance-uniform Uniformly spaced keyframes
+
+If the keyframes are spaced uniformly, the keyframe index can be calculated
+directly from the frame without any search. Such tracks are represented by the
+@ref UniformTrack and @ref UniformTrackView classes, and a @ref Track or a
+@ref TrackView with arbitrary keyframes can be converted to them using
+@ref resample().
+
+@subsection Animation-Track-performance-compression Reducing memory use
+
+Keyframes that can be interpolated from their neighbors within a given
+tolerance can be removed using @ref reduceKeyframes(). For rotation tracks,
+@ref compressQuaternions() additionally packs the values into 48 bits, and the
+resulting track can be used in a @ref Player the same way as an uncompressed
+one. Use @ref trackError() to check how much the result differs from the
+original.
+
 @subsection Animation-Track-performance-strict Strict interpolation
 
 While it's possible to have different @ref Extrapolation modes for frames
@@ -348,8 +368,9 @@ template<class K, class V, class R
          * @brief Animated value at a given time
          *
          * Calls @ref interpolate(), see its documentation for more
-         * information. Note that this function performs a linear search every
-         * time, use @ref at(K, std::size_t&) const to supply a search hint.
+         * information. Note that this function searches from the beginning
+         * every time, use @ref at(K, std::size_t&) const to supply a search
+         * hint.
          * @see @ref atStrict(K, std::size_t&) const,
          *      @ref at(Interpolator, K) const
          */
@@ -725,8 +746,9 @@ template<class K, class V, class R
          * @brief Animated value at a given time
          *
          * Calls @ref interpolate(), see its documentation for more
-         * information. Note that this function performs a linear search every
-         * time, use @ref at(K, std::size_t&) const to supply a search hint.
+         * information. Note that this function searches from the beginning
+         * every time, use @ref at(K, std::size_t&) const to supply a search
+         * hint.
          * @see @ref atStrict(K, std::size_t&) const,
          *      @ref at(Interpolator, K) const
          */
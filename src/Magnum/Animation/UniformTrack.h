@@ -0,0 +1,505 @@
+#ifndef Magnum_Animation_UniformTrack_h
+#define Magnum_Animation_UniformTrack_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Animation::UniformTrack, @ref Magnum::Animation::UniformTrackView, function @ref Magnum::Animation::interpolateUniform(), @ref Magnum::Animation::resample()
+ * @m_since_latest
+ */
+
+#include "Magnum/Animation/Track.h"
+
+namespace Magnum { namespace Animation {
+
+/**
+@brief Interpolate a uniformly sampled animation value
+@tparam K           Key type
+@tparam V           Value type
+@tparam R           Result type
+@param duration     Key of the first and the last value
+@param values       Values
+@param before       Extrapolation mode before the first value
+@param after        Extrapolation mode after the last value
+@param interpolator Interpolator function
+@param frame        Frame at which to interpolate
+@m_since_latest
+
+Similar to @ref interpolate(), but with the values spaced uniformly over
+@p duration. The pair of values around @p frame is thus calculated directly
+from @p frame in constant time, without any keyframe search. Extrapolation, as
+well as handling of a single and no values, is the same as in
+@ref interpolate(). If @p duration is empty and there's more than one value,
+the first or the last value is returned as if @ref Extrapolation::Constant
+was used.
+
+Used internally from @ref UniformTrack::at() / @ref UniformTrackView::at(),
+see @ref UniformTrack documentation for more information.
+@experimental
+*/
+template<class K, class V, class R = ResultOf<V>> R interpolateUniform(const Math::Range1D<K>& duration, const Containers::StridedArrayView1D<const V>& values, Extrapolation before, Extrapolation after, R(*interpolator)(const V&, const V&, Float), K frame);
+
+/**
+@brief Uniformly sampled animation track view
+@tparam K       Key type
+@tparam V       Value type
+@tparam R       Result type
+@m_since_latest
+
+Non-owning view onto a @ref UniformTrack. Unlike with @ref TrackView, the keys
+are not stored, so only the value type @p V can be @cpp const @ce. See the
+@ref UniformTrack documentation for more information.
+@experimental
+*/
+template<class K, class V, class R
+    #ifdef DOXYGEN_GENERATING_OUTPUT
+    = ResultOf<V>
+    #endif
+> class UniformTrackView {
+    static_assert(!std::is_const<K>::value && !std::is_const<R>::value,
+        "K and R shouldn't be const");
+
+    public:
+        /** @brief Key type */
+        typedef K KeyType;
+
+        /** @brief Value type */
+        typedef V ValueType;
+
+        /** @brief Animation result type */
+        typedef R ResultType;
+
+        /** @brief Interpolation function */
+        typedef ResultType(*Interpolator)(const ValueType&, const ValueType&, Float);
+
+        /**
+         * @brief Construct an empty track view
+         *
+         * The @ref values() and @ref interpolator() functions return
+         * @cpp nullptr @ce, @ref at() always returns a default-constructed
+         * value.
+         */
+        explicit UniformTrackView() noexcept: _duration{}, _values{}, _interpolator{}, _interpolation{}, _before{}, _after{} {}
+
+        /**
+         * @brief Construct with both generic and custom interpolator
+         * @param duration      Key of the first and the last value
+         * @param values        Uniformly spaced values
+         * @param interpolation Interpolation behavior
+         * @param interpolator  Interpolator function
+         * @param before        Extrapolation behavior
+         * @param after         Extrapolation behavior after
+         *
+         * @p interpolation acts as a behavior hint to users that might want to
+         * supply their own interpolator function to @ref at().
+         */
+        /*implicit*/ UniformTrackView(const Math::Range1D<K>& duration, const Containers::StridedArrayView1D<V>& values, Interpolation interpolation, Interpolator interpolator, Extrapolation before, Extrapolation after) noexcept: _duration{duration}, _values{values}, _interpolator{interpolator}, _interpolation{interpolation}, _before{before}, _after{after} {}
+
+        /** @overload
+         * Equivalent to calling @ref UniformTrackView(const Math::Range1D<K>&, const Containers::StridedArrayView1D<V>&, Interpolation, Interpolator, Extrapolation, Extrapolation)
+         * with both @p before and @p after set to @p extrapolation.
+         */
+        /*implicit*/ UniformTrackView(const Math::Range1D<K>& duration, const Containers::StridedArrayView1D<V>& values, Interpolation interpolation, Interpolator interpolator, Extrapolation extrapolation = Extrapolation::Constant) noexcept: UniformTrackView<K, V, R>{duration, values, interpolation, interpolator, extrapolation, extrapolation} {}
+
+        /**
+         * @brief Construct with custom interpolator
+         *
+         * The @ref interpolation() field is set to
+         * @ref Interpolation::Custom.
+         */
+        /*implicit*/ UniformTrackView(const Math::Range1D<K>& duration, const Containers::StridedArrayView1D<V>& values, Interpolator interpolator, Extrapolation before, Extrapolation after) noexcept: UniformTrackView<K, V, R>{duration, values, Interpolation::Custom, interpolator, before, after} {}
+
+        /** @overload */
+        /*implicit*/ UniformTrackView(const Math::Range1D<K>& duration, const Containers::StridedArrayView1D<V>& values, Interpolator interpolator, Extrapolation extrapolation = Extrapolation::Constant) noexcept: UniformTrackView<K, V, R>{duration, values, Interpolation::Custom, interpolator, extrapolation, extrapolation} {}
+
+        /**
+         * @brief Construct with generic interpolation behavior
+         *
+         * The @ref interpolator() function is autodetected from
+         * @p interpolation using @ref interpolatorFor(). See its documentation
+         * for more information.
+         */
+        /*implicit*/ UniformTrackView(const Math::Range1D<K>& duration, const Containers::StridedArrayView1D<V>& values, Interpolation interpolation, Extrapolation before, Extrapolation after) noexcept: UniformTrackView<K, V, R>{duration, values, interpolation, interpolatorFor<V, R>(interpolation), before, after} {}
+
+        /** @overload */
+        /*implicit*/ UniformTrackView(const Math::Range1D<K>& duration, const Containers::StridedArrayView1D<V>& values, Interpolation interpolation, Extrapolation extrapolation = Extrapolation::Constant) noexcept: UniformTrackView<K, V, R>{duration, values, interpolation, interpolatorFor<V, R>(interpolation), extrapolation, extrapolation} {}
+
+        /** @brief Convert a mutable view to a const one */
+        template<class V2, class = typename std::enable_if<std::is_same<const V2, V>::value && !std::is_same<V2, V>::value>::type> /*implicit*/ UniformTrackView(const UniformTrackView<K, V2, R>& other) noexcept: UniformTrackView<K, V, R>{other.duration(), other.values(), other.interpolation(), other.interpolator(), other.before(), other.after()} {}
+
+        /** @brief Interpolation behavior */
+        Interpolation interpolation() const { return _interpolation; }
+
+        /** @brief Interpolation function */
+        Interpolator interpolator() const { return _interpolator; }
+
+        /** @brief Extrapolation behavior before first value */
+        Extrapolation before() const { return _before; }
+
+        /** @brief Extrapolation behavior after last value */
+        Extrapolation after() const { return _after; }
+
+        /**
+         * @brief Duration of the track
+         *
+         * Key of the first and the last value.
+         */
+        Math::Range1D<K> duration() const { return _duration; }
+
+        /** @brief Value count */
+        std::size_t size() const { return _values.size(); }
+
+        /** @brief Values */
+        Containers::StridedArrayView1D<V> values() const { return _values; }
+
+        /**
+         * @brief Key of given value
+         *
+         * Expects that @p i is less than @ref size().
+         */
+        K key(std::size_t i) const {
+            CORRADE_ASSERT(i < _values.size(),
+                "Animation::UniformTrackView::key(): index" << i << "out of range for" << _values.size() << "values", {});
+            if(_values.size() == 1) return _duration.min();
+            return Math::lerp(_duration.min(), _duration.max(), Float(i)/Float(_values.size() - 1));
+        }
+
+        /**
+         * @brief Animated value at a given time
+         *
+         * Calls @ref interpolateUniform(), see its documentation for more
+         * information.
+         * @see @ref at(Interpolator, K) const
+         */
+        R at(K frame) const {
+            return interpolateUniform<K, V, R>(_duration, _values, _before, _after, _interpolator, frame);
+        }
+
+        /**
+         * @brief Animated value at a given time
+         *
+         * Unlike @ref at(K) const calls @ref interpolateUniform() with
+         * @p interpolator, overriding the interpolator function set in
+         * constructor.
+         */
+        R at(Interpolator interpolator, K frame) const {
+            return interpolateUniform<K, V, R>(_duration, _values, _before, _after, interpolator, frame);
+        }
+
+    private:
+        Math::Range1D<K> _duration;
+        Containers::StridedArrayView1D<V> _values;
+        Interpolator _interpolator;
+        Interpolation _interpolation;
+        Extrapolation _before, _after;
+};
+
+/**
+@brief Uniformly sampled animation track
+@tparam K       Key type
+@tparam V       Value type
+@tparam R       Result type
+@m_since_latest
+
+Unlike @ref Track, which stores a key for every value, the values here are
+spaced uniformly over @ref duration(). This saves memory and, more importantly,
+finding the pair of values to interpolate for a particular frame is a simple
+calculation instead of a keyframe search, so the lookup is equally fast for
+sequential playback and arbitrary seeking. Apart from that, interpolation and
+extrapolation behaves the same as with @ref Track:
+
+@snippet MagnumAnimation.cpp UniformTrack-usage
+
+@section Animation-UniformTrack-resample Resampling existing tracks
+
+A @ref Track or a @ref TrackView with arbitrarily spaced keyframes can be
+converted to a uniform track using @ref resample(). As
+@ref Trade::AnimationData::track() returns a @ref TrackView, imported
+animations can be converted this way as well:
+
+@snippet MagnumTrade.cpp AnimationData-resample
+
+The resampled track only approximates the original --- sharp changes between
+the samples get smoothed out, so pick a sample count that's high enough for
+the animation in question.
+@experimental
+*/
+template<class K, class V, class R
+    #ifdef DOXYGEN_GENERATING_OUTPUT
+    = ResultOf<V>
+    #endif
+> class UniformTrack {
+    public:
+        /** @brief Key type */
+        typedef K KeyType;
+
+        /** @brief Value type */
+        typedef V ValueType;
+
+        /** @brief Animation result type */
+        typedef R ResultType;
+
+        /** @brief Interpolation function */
+        typedef ResultType(*Interpolator)(const ValueType&, const ValueType&, Float);
+
+        /**
+         * @brief Construct an empty track
+         *
+         * The @ref values() and @ref interpolator() functions return
+         * @cpp nullptr @ce, @ref at() always returns a default-constructed
+         * value.
+         */
+        explicit UniformTrack() noexcept: _duration{}, _values{}, _interpolator{}, _interpolation{}, _before{}, _after{} {}
+
+        /**
+         * @brief Construct with both generic and custom interpolator
+         * @param duration      Key of the first and the last value
+         * @param values        Uniformly spaced values
+         * @param interpolation Interpolation behavior
+         * @param interpolator  Interpolator function
+         * @param before        Extrapolation behavior
+         * @param after         Extrapolation behavior after
+         *
+         * @p interpolation acts as a behavior hint to users that might want to
+         * supply their own interpolator function to @ref at().
+         */
+        explicit UniformTrack(const Math::Range1D<K>& duration, Containers::Array<V>&& values, Interpolation interpolation, Interpolator interpolator, Extrapolation before, Extrapolation after) noexcept: _duration{duration}, _values{std::move(values)}, _interpolator{interpolator}, _interpolation{interpolation}, _before{before}, _after{after} {}
+
+        /** @overload
+         * Equivalent to calling @ref UniformTrack(const Math::Range1D<K>&, Containers::Array<V>&&, Interpolation, Interpolator, Extrapolation, Extrapolation)
+         * with both @p before and @p after set to @p extrapolation.
+         */
+        explicit UniformTrack(const Math::Range1D<K>& duration, Containers::Array<V>&& values, Interpolation interpolation, Interpolator interpolator, Extrapolation extrapolation = Extrapolation::Constant) noexcept: UniformTrack<K, V, R>{duration, std::move(values), interpolation, interpolator, extrapolation, extrapolation} {}
+
+        /**
+         * @brief Construct with custom interpolator
+         *
+         * The @ref interpolation() field is set to
+         * @ref Interpolation::Custom.
+         */
+        explicit UniformTrack(const Math::Range1D<K>& duration, Containers::Array<V>&& values, Interpolator interpolator, Extrapolation before, Extrapolation after) noexcept: UniformTrack<K, V, R>{duration, std::move(values), Interpolation::Custom, interpolator, before, after} {}
+
+        /** @overload */
+        explicit UniformTrack(const Math::Range1D<K>& duration, Containers::Array<V>&& values, Interpolator interpolator, Extrapolation extrapolation = Extrapolation::Constant) noexcept: UniformTrack<K, V, R>{duration, std::move(values), Interpolation::Custom, interpolator, extrapolation, extrapolation} {}
+
+        /** @overload */
+        explicit UniformTrack(const Math::Range1D<K>& duration, std::initializer_list<V> values, Interpolator interpolator, Extrapolation extrapolation = Extrapolation::Constant): UniformTrack<K, V, R>{duration, Containers::Array<V>{Containers::InPlaceInit, values}, Interpolation::Custom, interpolator, extrapolation, extrapolation} {}
+
+        /**
+         * @brief Construct with generic interpolation behavior
+         *
+         * The @ref interpolator() function is autodetected from
+         * @p interpolation using @ref interpolatorFor(). See its documentation
+         * for more information.
+         */
+        explicit UniformTrack(const Math::Range1D<K>& duration, Containers::Array<V>&& values, Interpolation interpolation, Extrapolation before, Extrapolation after) noexcept: UniformTrack<K, V, R>{duration, std::move(values), interpolation, interpolatorFor<V, R>(interpolation), before, after} {}
+
+        /** @overload */
+        explicit UniformTrack(const Math::Range1D<K>& duration, Containers::Array<V>&& values, Interpolation interpolation, Extrapolation extrapolation = Extrapolation::Constant) noexcept: UniformTrack<K, V, R>{duration, std::move(values), interpolation, interpolatorFor<V, R>(interpolation), extrapolation, extrapolation} {}
+
+        /** @overload */
+        explicit UniformTrack(const Math::Range1D<K>& duration, std::initializer_list<V> values, Interpolation interpolation, Extrapolation extrapolation = Extrapolation::Constant): UniformTrack<K, V, R>{duration, Containers::Array<V>{Containers::InPlaceInit, values}, interpolation, interpolatorFor<V, R>(interpolation), extrapolation, extrapolation} {}
+
+        /** @brief Copying is not allowed */
+        UniformTrack(const UniformTrack<K, V, R>&) = delete;
+
+        /** @brief Move constructor */
+        UniformTrack(UniformTrack<K, V, R>&&) = default;
+
+        /** @brief Copying is not allowed */
+        UniformTrack<K, V, R>& operator=(const UniformTrack<K, V, R>&) = delete;
+
+        /** @brief Move constructor */
+        UniformTrack<K, V, R>& operator=(UniformTrack<K, V, R>&&) = default;
+
+        /** @brief Conversion to a view */
+        operator UniformTrackView<K, const V, R>() const noexcept {
+            return UniformTrackView<K, const V, R>{_duration, Containers::arrayView(_values), _interpolation, _interpolator, _before, _after};
+        }
+
+        /** @overload */
+        operator UniformTrackView<K, V, R>() noexcept {
+            return UniformTrackView<K, V, R>{_duration, Containers::arrayView(_values), _interpolation, _interpolator, _before, _after};
+        }
+
+        /** @brief Interpolation behavior */
+        Interpolation interpolation() const { return _interpolation; }
+
+        /** @brief Interpolation function */
+        Interpolator interpolator() const { return _interpolator; }
+
+        /** @brief Extrapolation behavior before first value */
+        Extrapolation before() const { return _before; }
+
+        /** @brief Extrapolation behavior after last value */
+        Extrapolation after() const { return _after; }
+
+        /**
+         * @brief Duration of the track
+         *
+         * Key of the first and the last value.
+         */
+        Math::Range1D<K> duration() const { return _duration; }
+
+        /** @brief Value count */
+        std::size_t size() const { return _values.size(); }
+
+        /** @brief Values */
+        Containers::ArrayView<V> values() { return _values; }
+        Containers::ArrayView<const V> values() const { return _values; } /**< @overload */
+
+        /**
+         * @brief Key of given value
+         *
+         * Expects that @p i is less than @ref size().
+         */
+        K key(std::size_t i) const {
+            CORRADE_ASSERT(i < _values.size(),
+                "Animation::UniformTrack::key(): index" << i << "out of range for" << _values.size() << "values", {});
+            if(_values.size() == 1) return _duration.min();
+            return Math::lerp(_duration.min(), _duration.max(), Float(i)/Float(_values.size() - 1));
+        }
+
+        /**
+         * @brief Animated value at a given time
+         *
+         * Calls @ref interpolateUniform(), see its documentation for more
+         * information.
+         * @see @ref at(Interpolator, K) const
+         */
+        R at(K frame) const {
+            return interpolateUniform<K, V, R>(_duration, Containers::arrayView(_values), _before, _after, _interpolator, frame);
+        }
+
+        /**
+         * @brief Animated value at a given time
+         *
+         * Unlike @ref at(K) const calls @ref interpolateUniform() with
+         * @p interpolator, overriding the interpolator function set in
+         * constructor.
+         */
+        R at(Interpolator interpolator, K frame) const {
+            return interpolateUniform<K, V, R>(_duration, Containers::arrayView(_values), _before, _after, interpolator, frame);
+        }
+
+    private:
+        Math::Range1D<K> _duration;
+        Containers::Array<V> _values;
+        Interpolator _interpolator;
+        Interpolation _interpolation;
+        Extrapolation _before, _after;
+};
+
+/**
+@brief Resample a track into a uniformly sampled one
+@param track            Track to resample
+@param sampleCount      Count of values in the resulting track
+@param interpolation    Interpolation behavior of the resulting track
+@m_since_latest
+
+Evaluates @p track at @p sampleCount uniformly spaced keys between the first
+and the last keyframe. Extrapolation behavior of the resulting track is the
+same as of @p track, the interpolator function is autodetected from
+@p interpolation using @ref interpolatorFor(). As the track is evaluated
+sequentially, the operation is @f$ \mathcal{O}(n + m) @f$, where @f$ n @f$ is
+the keyframe count and @f$ m @f$ is @p sampleCount. Expects that
+@p sampleCount is at least @cpp 2 @ce. See
+@ref Animation-UniformTrack-resample for an example.
+@experimental
+*/
+template<class K, class V, class R> UniformTrack<K, R> resample(const TrackView<const K, const V, R>& track, std::size_t sampleCount, Interpolation interpolation = Interpolation::Linear);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+template<class K, class V, class R> inline UniformTrack<K, R> resample(const Track<K, V, R>& track, std::size_t sampleCount, Interpolation interpolation = Interpolation::Linear) {
+    return resample(TrackView<const K, const V, R>{track}, sampleCount, interpolation);
+}
+
+template<class K, class V, class R> R interpolateUniform(const Math::Range1D<K>& duration, const Containers::StridedArrayView1D<const V>& values, const Extrapolation before, const Extrapolation after, R(*const interpolator)(const V&, const V&, Float), const K frame) {
+    /* No data, return default-constructed value */
+    if(!values.size()) return {};
+
+    /* Only one value, return it verbatim (or default-constructed, if
+       desired) */
+    if(values.size() == 1) {
+        if((frame < duration.min() && before == Extrapolation::DefaultConstructed) ||
+           (frame > duration.min() && after == Extrapolation::DefaultConstructed))
+            return {};
+
+        return interpolator(values[0], values[0], 0.0f);
+    }
+
+    /* Special extrapolation outside of range, same as in interpolate().
+       Usual extrapolation is handled below. */
+    const std::size_t last = values.size() - 1;
+    if(frame < duration.min()) {
+        if(before == Extrapolation::DefaultConstructed) return {};
+        if(before == Extrapolation::Constant)
+            return interpolator(values[0], values[1], 0.0f);
+    } else if(frame >= duration.max()) {
+        if(after == Extrapolation::DefaultConstructed) return {};
+        if(after == Extrapolation::Constant)
+            return interpolator(values[last - 1], values[last], 1.0f);
+    }
+
+    /* With zero duration there's nothing to interpolate between, behave like
+       with constant extrapolation */
+    if(!(duration.min() < duration.max()))
+        return frame < duration.min() ?
+            interpolator(values[0], values[1], 0.0f) :
+            interpolator(values[last - 1], values[last], 1.0f);
+
+    /* Calculate the value index directly */
+    const Float position = Math::lerpInverted(Float(duration.min()), Float(duration.max()), Float(frame))*Float(last);
+    std::size_t i;
+    if(position < 1.0f) i = 0;
+    else if(position >= Float(last - 1)) i = last - 1;
+    else i = std::size_t(position);
+
+    return interpolator(values[i], values[i + 1], position - Float(i));
+}
+
+template<class K, class V, class R> UniformTrack<K, R> resample(const TrackView<const K, const V, R>& track, const std::size_t sampleCount, const Interpolation interpolation) {
+    CORRADE_ASSERT(sampleCount >= 2,
+        "Animation::resample(): expected at least two samples, got" << sampleCount, (UniformTrack<K, R>{}));
+
+    /* Sampling with constant extrapolation, as with
+       Extrapolation::DefaultConstructed the last sample would be lost */
+    const Math::Range1D<K> duration = track.duration();
+    Containers::Array<R> values{sampleCount};
+    std::size_t hint{};
+    for(std::size_t i = 0; i != sampleCount; ++i) {
+        const K key = Math::lerp(duration.min(), duration.max(), Float(i)/Float(sampleCount - 1));
+        values[i] = interpolate(track.keys(), track.values(), Extrapolation::Constant, Extrapolation::Constant, track.interpolator(), key, hint);
+    }
+
+    return UniformTrack<K, R>{duration, std::move(values), interpolation, track.before(), track.after()};
+}
+
+}}
+
+#endif
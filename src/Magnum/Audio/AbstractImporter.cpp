@@ -25,8 +25,10 @@
 
 #include "AbstractImporter.h"
 
+#include <algorithm>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
@@ -38,7 +40,7 @@
 namespace Magnum { namespace Audio {
 
 std::string AbstractImporter::pluginInterface() {
-    return "cz.mosra.magnum.Audio.AbstractImporter/0.1";
+    return "cz.mosra.magnum.Audio.AbstractImporter/0.2";
 }
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
@@ -105,6 +107,9 @@ void AbstractImporter::close() {
         doClose();
         CORRADE_INTERNAL_ASSERT(!isOpened());
     }
+
+    _fallbackData = Containers::NullOpt;
+    _position = 0;
 }
 
 BufferFormat AbstractImporter::format() const {
@@ -125,6 +130,54 @@ Containers::Array<char> AbstractImporter::data() {
     return out;
 }
 
+std::size_t AbstractImporter::frameCount() {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::frameCount(): no file opened", {});
+    return doFrameCount();
+}
+
+std::size_t AbstractImporter::doFrameCount() {
+    return fallbackData().size()/bufferFormatFrameSize(doFormat());
+}
+
+std::size_t AbstractImporter::position() const {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::position(): no file opened", {});
+    return _position;
+}
+
+void AbstractImporter::seek(const std::size_t frame) {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::seek(): no file opened", );
+    #ifndef CORRADE_NO_ASSERT
+    const std::size_t count = doFrameCount();
+    #endif
+    CORRADE_ASSERT(frame <= count, "Audio::AbstractImporter::seek(): frame" << frame << "out of range for" << count << "frames", );
+    _position = frame;
+}
+
+std::size_t AbstractImporter::readFrames(const Containers::ArrayView<char> destination) {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::readFrames(): no file opened", {});
+
+    const std::size_t frameSize = bufferFormatFrameSize(doFormat());
+    const std::size_t available = doFrameCount() - _position;
+    const std::size_t count = std::min(destination.size()/frameSize, available);
+    if(!count) return 0;
+
+    const std::size_t read = doReadFrames(_position, destination.prefix(count*frameSize));
+    CORRADE_ASSERT(read <= count, "Audio::AbstractImporter::readFrames(): implementation reported" << read << "frames read but expected at most" << count, {});
+    _position += read;
+    return read;
+}
+
+std::size_t AbstractImporter::doReadFrames(const std::size_t offset, const Containers::ArrayView<char> destination) {
+    const std::size_t frameSize = bufferFormatFrameSize(doFormat());
+    Utility::copy(fallbackData().slice(offset*frameSize, offset*frameSize + destination.size()), destination);
+    return destination.size()/frameSize;
+}
+
+Containers::ArrayView<const char> AbstractImporter::fallbackData() {
+    if(!_fallbackData) _fallbackData.emplace(data());
+    return *_fallbackData;
+}
+
 Debug& operator<<(Debug& debug, const ImporterFeature value) {
     debug << "Audio::ImporterFeature" << Debug::nospace;
 
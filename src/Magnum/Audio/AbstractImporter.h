@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Audio::AbstractImporter, enum @ref Magnum::Audio::ImporterFeature, enum set @ref Magnum::Audio::ImporterFeatures
  */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 
 #include "Magnum/Magnum.h"
@@ -79,11 +81,57 @@ around in order to have the returned data valid. Moreover, all returned
 deleters --- this is to avoid potential dangling function pointer calls when
 destructing such instances after the plugin module has been unloaded.
 
+@section Audio-AbstractImporter-streaming Streaming
+
+Besides importing the whole decoded stream at once with @ref data(), it's
+possible to read the data incrementally in sample frames using
+@ref readFrames() and @ref seek(), which is useful for long music or ambience
+tracks that would take a lot of memory in their decoded form. Combined with
+@ref Source::queueBuffers() and @ref Source::unqueueBuffers(), a pair of small
+buffers can be continuously refilled while the source plays, keeping the
+memory use constant regardless of the track length:
+
+@code{.cpp}
+Containers::Pointer<Audio::AbstractImporter> importer =
+    manager.instantiate("WavAudioImporter");
+importer->openFile("music.wav");
+const Audio::BufferFormat format = importer->format();
+const std::size_t frameSize = Audio::bufferFormatFrameSize(format);
+
+/* Fill both buffers and start playing */
+Containers::Array<char> chunk{Containers::NoInit, frameSize*16384};
+Audio::Buffer buffers[2];
+Containers::Reference<Audio::Buffer> queue[]{buffers[0], buffers[1]};
+for(Audio::Buffer& buffer: buffers) {
+    const std::size_t frames = importer->readFrames(chunk);
+    buffer.setData(format, chunk.prefix(frames*frameSize), importer->frequency());
+}
+Audio::Source source;
+source.queueBuffers(queue)
+    .play();
+
+/* Periodically, refill the buffers that finished playing */
+const std::size_t processed = source.unqueueBuffers(queue);
+for(std::size_t i = 0; i != processed; ++i) {
+    const std::size_t frames = importer->readFrames(chunk);
+    if(!frames) break;
+    queue[i]->setData(format, chunk.prefix(frames*frameSize), importer->frequency());
+    source.queueBuffers({queue + i, 1});
+}
+@endcode
+
+Importers that don't implement streaming directly fall back to importing the
+whole stream with @ref doData() on first use and reading from it, which has
+the same memory use as calling @ref data(). See documentation of particular
+importer plugins for more information.
+
 @section Audio-AbstractImporter-subclassing Subclassing
 
 Plugin implements function @ref doFeatures(), @ref doIsOpened(), one of or both
 @ref doOpenData() and @ref doOpenFile() functions, function @ref doClose() and
 data access functions @ref doFormat(), @ref doFrequency() and @ref doData().
+Streaming access can be optionally provided by implementing
+@ref doFrameCount() and @ref doReadFrames().
 
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
@@ -95,6 +143,8 @@ checked by the implementation:
     is supported.
 -   All `do*()` implementations working on opened file are called only if
     there is any file opened.
+-   Function @ref doReadFrames() is called only with a frame range that is
+    in bounds, with the destination size being a multiple of the frame size.
 
 @m_class{m-block m-warning}
 
@@ -124,7 +174,7 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          * @brief Plugin interface
          *
          * @code{.cpp}
-         * "cz.mosra.magnum.Audio.AbstractImporter/0.1"
+         * "cz.mosra.magnum.Audio.AbstractImporter/0.2"
          * @endcode
          */
         static std::string pluginInterface();
@@ -194,6 +244,50 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Sample data */
         Containers::Array<char> data();
 
+        /**
+         * @brief Count of sample frames
+         * @m_since_latest
+         *
+         * A sample frame contains one sample for each channel, its size is
+         * given by @ref bufferFormatFrameSize() for @ref format().
+         * @see @ref readFrames(), @ref seek()
+         */
+        std::size_t frameCount();
+
+        /**
+         * @brief Current frame position
+         * @m_since_latest
+         *
+         * Position from which the next @ref readFrames() call reads. Set to
+         * @cpp 0 @ce when a file is opened.
+         * @see @ref seek()
+         */
+        std::size_t position() const;
+
+        /**
+         * @brief Seek to given frame
+         * @m_since_latest
+         *
+         * Expects that @p frame is not larger than @ref frameCount(). Seeking
+         * to @ref frameCount() is allowed, subsequent @ref readFrames() will
+         * then read nothing.
+         */
+        void seek(std::size_t frame);
+
+        /**
+         * @brief Read sample frames
+         * @m_since_latest
+         *
+         * Reads as many frames as fits into @p destination, starting at
+         * @ref position(), and advances the position by the count of frames
+         * read. Returns the count of frames read, which is less than what
+         * would fit into @p destination only if the end of the stream is
+         * reached or if the implementation failed. The data are in the same
+         * layout as the corresponding part of @ref data().
+         * @see @ref bufferFormatFrameSize(), @ref seek()
+         */
+        std::size_t readFrames(Containers::ArrayView<char> destination);
+
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
         /**
@@ -230,6 +324,36 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
 
         /** @brief Implementation for @ref data() */
         virtual Containers::Array<char> doData() = 0;
+
+        /**
+         * @brief Implementation for @ref frameCount()
+         * @m_since_latest
+         *
+         * Default implementation imports the whole stream using
+         * @ref doData(), keeps it until the file is closed and returns its
+         * size divided by the frame size.
+         */
+        virtual std::size_t doFrameCount();
+
+        /**
+         * @brief Implementation for @ref readFrames()
+         * @param offset        Offset of the first frame to read
+         * @param destination   Destination, sized to exactly the frames to
+         *      read
+         * @return Count of frames read
+         * @m_since_latest
+         *
+         * The frame range is guaranteed to be in bounds of
+         * @ref doFrameCount(). Default implementation copies the frames from
+         * data imported using @ref doData(), see @ref doFrameCount() for
+         * details.
+         */
+        virtual std::size_t doReadFrames(std::size_t offset, Containers::ArrayView<char> destination);
+
+        MAGNUM_AUDIO_LOCAL Containers::ArrayView<const char> fallbackData();
+
+        Containers::Optional<Containers::Array<char>> _fallbackData;
+        std::size_t _position{};
 };
 
 }}
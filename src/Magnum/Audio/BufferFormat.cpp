@@ -25,6 +25,7 @@
 
 #include "BufferFormat.h"
 
+#include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 
 namespace Magnum { namespace Audio {
@@ -78,4 +79,50 @@ Debug& operator<<(Debug& debug, const BufferFormat value) {
     return debug << "(" << Debug::nospace << reinterpret_cast<void*>(ALenum(value)) << Debug::nospace << ")";
 }
 
+UnsignedInt bufferFormatFrameSize(const BufferFormat format) {
+    switch(format) {
+        case BufferFormat::Mono8:
+        case BufferFormat::MonoALaw:
+        case BufferFormat::MonoMuLaw:
+            return 1;
+        case BufferFormat::Mono16:
+        case BufferFormat::Stereo8:
+        case BufferFormat::StereoALaw:
+        case BufferFormat::StereoMuLaw:
+        case BufferFormat::Rear8:
+            return 2;
+        case BufferFormat::Stereo16:
+        case BufferFormat::MonoFloat:
+        case BufferFormat::Quad8:
+        case BufferFormat::Rear16:
+            return 4;
+        case BufferFormat::Surround51Channel8:
+            return 6;
+        case BufferFormat::Surround61Channel8:
+            return 7;
+        case BufferFormat::StereoFloat:
+        case BufferFormat::MonoDouble:
+        case BufferFormat::Quad16:
+        case BufferFormat::Rear32:
+        case BufferFormat::Surround71Channel8:
+            return 8;
+        case BufferFormat::Surround51Channel16:
+            return 12;
+        case BufferFormat::Surround61Channel16:
+            return 14;
+        case BufferFormat::StereoDouble:
+        case BufferFormat::Quad32:
+        case BufferFormat::Surround71Channel16:
+            return 16;
+        case BufferFormat::Surround51Channel32:
+            return 24;
+        case BufferFormat::Surround61Channel32:
+            return 28;
+        case BufferFormat::Surround71Channel32:
+            return 32;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE("Audio::bufferFormatFrameSize(): invalid format" << format, {});
+}
+
 }}
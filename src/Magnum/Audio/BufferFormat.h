@@ -193,6 +193,16 @@ enum class BufferFormat: ALenum {
 /** @debugoperatorenum{BufferFormat} */
 MAGNUM_AUDIO_EXPORT Debug& operator<<(Debug& debug, BufferFormat value);
 
+/**
+@brief Size of a sample frame in given buffer format
+@m_since_latest
+
+Size of a single sample for all channels, in bytes. Audio data in given format
+are always a multiple of this size.
+@see @ref AbstractImporter::readFrames()
+*/
+MAGNUM_AUDIO_EXPORT UnsignedInt bufferFormatFrameSize(BufferFormat format);
+
 }}
 
 #endif
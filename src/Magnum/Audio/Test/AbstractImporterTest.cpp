@@ -63,6 +63,13 @@ struct AbstractImporterTest: TestSuite::Tester {
     void dataNoFile();
     void dataCustomDeleter();
 
+    void readFrames();
+    void readFramesFallback();
+    void readFramesNoFile();
+    void readFramesImplementationTooMany();
+    void seek();
+    void seekOutOfRange();
+
     void debugFeature();
     void debugFeatures();
 };
@@ -88,6 +95,13 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::dataNoFile,
               &AbstractImporterTest::dataCustomDeleter,
 
+              &AbstractImporterTest::readFrames,
+              &AbstractImporterTest::readFramesFallback,
+              &AbstractImporterTest::readFramesNoFile,
+              &AbstractImporterTest::readFramesImplementationTooMany,
+              &AbstractImporterTest::seek,
+              &AbstractImporterTest::seekOutOfRange,
+
               &AbstractImporterTest::debugFeature,
               &AbstractImporterTest::debugFeatures});
 }
@@ -389,6 +403,206 @@ void AbstractImporterTest::dataCustomDeleter() {
     CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::data(): implementation is not allowed to use a custom Array deleter\n");
 }
 
+void AbstractImporterTest::readFrames() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Stereo8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        /* Not used as both streaming functions are implemented */
+        Containers::Array<char> doData() override { return nullptr; }
+
+        std::size_t doFrameCount() override { return 5; }
+        std::size_t doReadFrames(std::size_t offset, Containers::ArrayView<char> destination) override {
+            /* Each frame is its index twice */
+            for(std::size_t i = 0; i != destination.size(); ++i)
+                destination[i] = char(offset + i/2);
+            return destination.size()/2;
+        }
+    } importer;
+
+    CORRADE_COMPARE(importer.frameCount(), 5);
+    CORRADE_COMPARE(importer.position(), 0);
+
+    /* The last byte doesn't fit a whole frame, so it's not touched */
+    char data[5]{'\xff', '\xff', '\xff', '\xff', '\xff'};
+    CORRADE_COMPARE(importer.readFrames(data), 2);
+    CORRADE_COMPARE(importer.position(), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView<char>({0, 0, 1, 1, '\xff'}),
+        TestSuite::Compare::Container);
+
+    /* Reading past the end gets clamped */
+    CORRADE_COMPARE(importer.readFrames(data), 2);
+    CORRADE_COMPARE(importer.position(), 4);
+    CORRADE_COMPARE(importer.readFrames(data), 1);
+    CORRADE_COMPARE(importer.position(), 5);
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView<char>({4, 4, 3, 3, '\xff'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer.readFrames(data), 0);
+    CORRADE_COMPARE(importer.position(), 5);
+}
+
+void AbstractImporterTest::readFramesFallback() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return opened; }
+        void doClose() override { opened = false; }
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono16; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override {
+            ++called;
+            /* The last byte isn't a whole frame */
+            return Containers::Array<char>{Containers::InPlaceInit, {1, 2, 3, 4, 5, 6, 7}};
+        }
+
+        bool opened = true;
+        Int called = 0;
+    } importer;
+
+    CORRADE_COMPARE(importer.frameCount(), 3);
+
+    char data[4];
+    CORRADE_COMPARE(importer.readFrames(data), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView<char>({1, 2, 3, 4}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(importer.readFrames(data), 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(2),
+        Containers::arrayView<char>({5, 6}),
+        TestSuite::Compare::Container);
+
+    /* The data should be imported just once */
+    CORRADE_COMPARE(importer.called, 1);
+
+    /* Closing discards the data, next read imports them again */
+    importer.close();
+    importer.opened = true;
+    CORRADE_COMPARE(importer.position(), 0);
+    CORRADE_COMPARE(importer.readFrames(data), 2);
+    CORRADE_COMPARE(importer.called, 2);
+}
+
+void AbstractImporterTest::readFramesNoFile() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.frameCount();
+    importer.position();
+    importer.seek(0);
+    importer.readFrames(data);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::frameCount(): no file opened\n"
+        "Audio::AbstractImporter::position(): no file opened\n"
+        "Audio::AbstractImporter::seek(): no file opened\n"
+        "Audio::AbstractImporter::readFrames(): no file opened\n");
+}
+
+void AbstractImporterTest::readFramesImplementationTooMany() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        std::size_t doFrameCount() override { return 5; }
+        std::size_t doReadFrames(std::size_t, Containers::ArrayView<char>) override {
+            return 4;
+        }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[3];
+    importer.readFrames(data);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::readFrames(): implementation reported 4 frames read but expected at most 3\n");
+}
+
+void AbstractImporterTest::seek() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override {
+            return Containers::Array<char>{Containers::InPlaceInit, {1, 2, 3, 4, 5}};
+        }
+    } importer;
+
+    importer.seek(3);
+    CORRADE_COMPARE(importer.position(), 3);
+
+    char data[4];
+    CORRADE_COMPARE(importer.readFrames(data), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(2),
+        Containers::arrayView<char>({4, 5}),
+        TestSuite::Compare::Container);
+
+    /* Seeking to the end is allowed */
+    importer.seek(5);
+    CORRADE_COMPARE(importer.readFrames(data), 0);
+
+    importer.seek(1);
+    CORRADE_COMPARE(importer.readFrames(data), 4);
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView<char>({2, 3, 4, 5}),
+        TestSuite::Compare::Container);
+}
+
+void AbstractImporterTest::seekOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        std::size_t doFrameCount() override { return 5; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.seek(6);
+    CORRADE_COMPARE(importer.position(), 0);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::seek(): frame 6 out of range for 5 frames\n");
+}
+
 void AbstractImporterTest::debugFeature() {
     std::ostringstream out;
 
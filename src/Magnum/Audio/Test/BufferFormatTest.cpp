@@ -34,11 +34,37 @@ namespace Magnum { namespace Audio { namespace Test { namespace {
 struct BufferFormatTest: TestSuite::Tester {
     explicit BufferFormatTest();
 
+    void frameSize();
+    void frameSizeInvalid();
+
     void debugFormat();
 };
 
 BufferFormatTest::BufferFormatTest() {
-    addTests({&BufferFormatTest::debugFormat});
+    addTests({&BufferFormatTest::frameSize,
+              &BufferFormatTest::frameSizeInvalid,
+
+              &BufferFormatTest::debugFormat});
+}
+
+void BufferFormatTest::frameSize() {
+    CORRADE_COMPARE(bufferFormatFrameSize(BufferFormat::Mono8), 1);
+    CORRADE_COMPARE(bufferFormatFrameSize(BufferFormat::StereoMuLaw), 2);
+    CORRADE_COMPARE(bufferFormatFrameSize(BufferFormat::Stereo16), 4);
+    CORRADE_COMPARE(bufferFormatFrameSize(BufferFormat::StereoDouble), 16);
+    CORRADE_COMPARE(bufferFormatFrameSize(BufferFormat::Surround61Channel16), 14);
+    CORRADE_COMPARE(bufferFormatFrameSize(BufferFormat::Surround71Channel32), 32);
+}
+
+void BufferFormatTest::frameSizeInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    bufferFormatFrameSize(BufferFormat(0xdead));
+    CORRADE_COMPARE(out.str(), "Audio::bufferFormatFrameSize(): invalid format Audio::BufferFormat(0xdead)\n");
 }
 
 void BufferFormatTest::debugFormat() {
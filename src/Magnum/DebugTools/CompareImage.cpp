@@ -25,8 +25,10 @@
 
 #include "CompareImage.h"
 
-#include <map>
+#include <algorithm>
+#include <atomic>
 #include <sstream>
+#include <vector>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/Optional.h>
@@ -36,6 +38,7 @@
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/ImageView.h"
+#include "Magnum/Implementation/Parallel.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Color.h"
@@ -44,60 +47,255 @@
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
 
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
 namespace {
 
-template<std::size_t size, class T> Float calculateImageDelta(const Containers::StridedArrayView2D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView2D<const Math::Vector<size, T>>& expected, const Containers::StridedArrayView2D<Float>& output) {
-    CORRADE_INTERNAL_ASSERT(actual.size() == output.size());
-    CORRADE_INTERNAL_ASSERT(output.size() == expected.size());
+/* Calculates delta of a single pixel, returns the value contributing to the
+   max delta. Integer pixels can't be NaN or infinity, so the special handling
+   is done only for floating-point types. */
+template<std::size_t size, class T> inline Float calculatePixelDelta(const Math::Vector<size, T>& actual, const Math::Vector<size, T>& expected, Float& output, std::false_type) {
+    /* Explicitly convert from T to Float */
+    auto actualPixel = Math::Vector<size, Float>(actual);
+    auto expectedPixel = Math::Vector<size, Float>(expected);
 
-    /* Calculate deltas and maximal value of them */
-    Float max{};
-    for(std::size_t i = 0, iMax = expected.size()[0]; i != iMax; ++i) {
-        Containers::StridedArrayView1D<const Math::Vector<size, T>> actualRow = actual[i];
-        Containers::StridedArrayView1D<const Math::Vector<size, T>> expectedRow = expected[i];
-        Containers::StridedArrayView1D<Float> outputRow = output[i];
-
-        for(std::size_t j = 0, jMax = expectedRow.size(); j != jMax; ++j) {
-            /* Explicitly convert from T to Float */
-            auto actualPixel = Math::Vector<size, Float>(actualRow[j]);
-            auto expectedPixel = Math::Vector<size, Float>(expectedRow[j]);
-
-            /* First calculate a classic difference */
-            Math::Vector<size, Float> diff = Math::abs(actualPixel - expectedPixel);
-
-            /* Mark pixels that are NaN in both actual and expected pixels as
-               having no difference */
-            diff = Math::lerp(diff, {}, Math::isNan(actualPixel) & Math::isNan(expectedPixel));
-
-            /* Then also mark pixels that are the same sign of infnity in both
-               actual and expected pixel as having no difference */
-            diff = Math::lerp(diff, {}, Math::isInf(actualPixel) & Math::isInf(expectedPixel) & Math::equal(actualPixel, expectedPixel));
-
-            /* Calculate the difference and save it to the output image even
-               with NaN and ±Inf (as the user should know) */
-            outputRow[j] = diff.sum()/size;
-
-            /* On the other hand, infs and NaNs should not contribute to the
-               max delta -- because all other differences would be zero
-               compared to them */
-            max = Math::max(max, Math::lerp(diff, {}, Math::isNan(diff)|Math::isInf(diff)).sum()/size);
+    /* First calculate a classic difference */
+    Math::Vector<size, Float> diff = Math::abs(actualPixel - expectedPixel);
+
+    /* Mark pixels that are NaN in both actual and expected pixels as having no
+       difference */
+    diff = Math::lerp(diff, {}, Math::isNan(actualPixel) & Math::isNan(expectedPixel));
+
+    /* Then also mark pixels that are the same sign of infnity in both actual
+       and expected pixel as having no difference */
+    diff = Math::lerp(diff, {}, Math::isInf(actualPixel) & Math::isInf(expectedPixel) & Math::equal(actualPixel, expectedPixel));
+
+    /* Calculate the difference and save it to the output image even with NaN
+       and ±Inf (as the user should know) */
+    output = diff.sum()/size;
+
+    /* On the other hand, infs and NaNs should not contribute to the max delta
+       -- because all other differences would be zero compared to them */
+    return Math::lerp(diff, {}, Math::isNan(diff)|Math::isInf(diff)).sum()/size;
+}
+
+template<std::size_t size, class T> inline Float calculatePixelDelta(const Math::Vector<size, T>& actual, const Math::Vector<size, T>& expected, Float& output, std::true_type) {
+    output = Math::abs(Math::Vector<size, Float>(actual) - Math::Vector<size, Float>(expected)).sum()/size;
+    return output;
+}
+
+#ifdef CORRADE_TARGET_SSE2
+/* SSE2 kernels for contiguous rows. Each processes as many pixels as fits
+   into whole 16-byte blocks and returns their count, the rest is done by the
+   scalar code above. The operations and their order match the scalar code so
+   the results are bit-exact in all cases -- channel differences of 8-bit
+   formats are small integers that are summed exactly, the division by channel
+   count is a multiplication by a power of two and float channels are summed
+   in the same order after a transpose. */
+inline void storeDelta(Float* const output, const __m128 delta, const __m128 maxDelta, __m128& max) {
+    _mm_storeu_ps(output, delta);
+    max = _mm_max_ps(max, maxDelta);
+}
+
+/* For signed types the values are flipped to an unsigned range first, which
+   preserves the differences */
+template<std::size_t size> std::size_t calculateByteRowDeltaSse2(const char* actual, const char* expected, Float* output, const std::size_t count, const bool isSigned, __m128& max) {
+    constexpr std::size_t pixelsPerBlock = 16/size;
+    const __m128i flip = _mm_set1_epi8(isSigned ? char(0x80) : 0);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    const __m128 scale = _mm_set1_ps(1.0f/size);
+
+    std::size_t i = 0;
+    for(; i + pixelsPerBlock <= count; i += pixelsPerBlock, actual += 16, expected += 16, output += pixelsPerBlock) {
+        const __m128i a = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(actual)), flip);
+        const __m128i e = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(expected)), flip);
+        const __m128i diff = _mm_or_si128(_mm_subs_epu8(a, e), _mm_subs_epu8(e, a));
+        const __m128i lo = _mm_unpacklo_epi8(diff, zero);
+        const __m128i hi = _mm_unpackhi_epi8(diff, zero);
+
+        if(size == 1) {
+            const __m128 d0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero));
+            const __m128 d1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero));
+            const __m128 d2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero));
+            const __m128 d3 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero));
+            storeDelta(output + 0, d0, d0, max);
+            storeDelta(output + 4, d1, d1, max);
+            storeDelta(output + 8, d2, d2, max);
+            storeDelta(output + 12, d3, d3, max);
+        } else if(size == 2) {
+            /* Adds the two channels of each pixel together */
+            const __m128 d0 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_madd_epi16(lo, ones)), scale);
+            const __m128 d1 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_madd_epi16(hi, ones)), scale);
+            storeDelta(output + 0, d0, d0, max);
+            storeDelta(output + 4, d1, d1, max);
+        } else if(size == 4) {
+            /* Adds RG and BA of each pixel together, then the two halves */
+            const __m128 rgba01 = _mm_cvtepi32_ps(_mm_madd_epi16(lo, ones));
+            const __m128 rgba23 = _mm_cvtepi32_ps(_mm_madd_epi16(hi, ones));
+            const __m128 d = _mm_mul_ps(_mm_add_ps(
+                _mm_shuffle_ps(rgba01, rgba23, _MM_SHUFFLE(2, 0, 2, 0)),
+                _mm_shuffle_ps(rgba01, rgba23, _MM_SHUFFLE(3, 1, 3, 1))), scale);
+            storeDelta(output, d, d, max);
         }
     }
 
-    return max;
+    return i;
 }
 
+/* Calculates channel differences of four float values, zeroing out the ones
+   that are NaN in both or the same infinity in both. The second output has
+   all specials zeroed out for the max calculation. */
+inline void calculateDeltaSse2(const __m128 a, const __m128 e, __m128& diff, __m128& maxDiff) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 inf = _mm_set1_ps(Constants::inf());
+
+    const __m128 bothNan = _mm_and_ps(_mm_cmpunord_ps(a, a), _mm_cmpunord_ps(e, e));
+    const __m128 sameInf = _mm_and_ps(_mm_cmpeq_ps(_mm_and_ps(a, absMask), inf), _mm_cmpeq_ps(a, e));
+    diff = _mm_andnot_ps(_mm_or_ps(bothNan, sameInf), _mm_and_ps(_mm_sub_ps(a, e), absMask));
+    maxDiff = _mm_andnot_ps(_mm_or_ps(_mm_cmpunord_ps(diff, diff), _mm_cmpeq_ps(diff, inf)), diff);
 }
 
-std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected) {
-    /* Calculate a delta image */
-    Containers::Array<Float> deltaData{Containers::NoInit,
-        std::size_t(expected.size().product())};
-    Containers::StridedArrayView2D<Float> delta{deltaData,
-        {std::size_t(expected.size().y()), std::size_t(expected.size().x())}};
+template<std::size_t size> std::size_t calculateFloatRowDeltaSse2(const Float* actual, const Float* expected, Float* output, const std::size_t count, __m128& max) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4, actual += 4*size, expected += 4*size, output += 4) {
+        if(size == 1) {
+            __m128 diff, maxDiff;
+            calculateDeltaSse2(_mm_loadu_ps(actual), _mm_loadu_ps(expected), diff, maxDiff);
+            storeDelta(output, diff, maxDiff, max);
+        } else if(size == 4) {
+            __m128 diff[4], maxDiff[4];
+            for(std::size_t j = 0; j != 4; ++j)
+                calculateDeltaSse2(_mm_loadu_ps(actual + j*4), _mm_loadu_ps(expected + j*4), diff[j], maxDiff[j]);
+
+            /* Transpose so each register contains one channel of all four
+               pixels, then sum the channels in the same order as
+               Math::Vector::sum() does */
+            _MM_TRANSPOSE4_PS(diff[0], diff[1], diff[2], diff[3]);
+            _MM_TRANSPOSE4_PS(maxDiff[0], maxDiff[1], maxDiff[2], maxDiff[3]);
+            const __m128 scale = _mm_set1_ps(0.25f);
+            storeDelta(output,
+                _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(diff[0], diff[1]), diff[2]), diff[3]), scale),
+                _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(maxDiff[0], maxDiff[1]), maxDiff[2]), maxDiff[3]), scale), max);
+        }
+    }
+
+    return i;
+}
+
+/* Dispatch for the formats that have a SSE2 kernel, the others are done
+   fully in scalar code */
+template<std::size_t size, class T> std::size_t calculateRowDeltaSse2(const void*, const void*, Float*, std::size_t, __m128&) { return 0; }
+#define _c(size, T, ...)                                                    \
+    template<> std::size_t calculateRowDeltaSse2<size, T>(const void* actual, const void* expected, Float* output, const std::size_t count, __m128& max) { \
+        return calculateByteRowDeltaSse2<size>(static_cast<const char*>(actual), static_cast<const char*>(expected), output, count, __VA_ARGS__, max); \
+    }
+_c(1, UnsignedByte, false)
+_c(2, UnsignedByte, false)
+_c(4, UnsignedByte, false)
+_c(1, Byte, true)
+_c(2, Byte, true)
+_c(4, Byte, true)
+#undef _c
+#define _c(size)                                                            \
+    template<> std::size_t calculateRowDeltaSse2<size, Float>(const void* actual, const void* expected, Float* output, const std::size_t count, __m128& max) { \
+        return calculateFloatRowDeltaSse2<size>(static_cast<const Float*>(actual), static_cast<const Float*>(expected), output, count, max); \
+    }
+_c(1)
+_c(4)
+#undef _c
+#endif
+
+template<std::size_t size, class T> Float calculateRowDelta(const Containers::StridedArrayView1D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView1D<const Math::Vector<size, T>>& expected, const Containers::StridedArrayView1D<Float>& output) {
+    Float max{};
+    std::size_t j = 0;
+
+    /* Vectorized code path if the row is contiguous in all three views */
+    #ifdef CORRADE_TARGET_SSE2
+    if(actual.stride() == std::ptrdiff_t(sizeof(Math::Vector<size, T>)) &&
+       expected.stride() == std::ptrdiff_t(sizeof(Math::Vector<size, T>)) &&
+       output.stride() == std::ptrdiff_t(sizeof(Float)))
+    {
+        __m128 maxSse = _mm_setzero_ps();
+        j = calculateRowDeltaSse2<size, T>(actual.data(), expected.data(), static_cast<Float*>(output.data()), output.size(), maxSse);
+        Float maxes[4];
+        _mm_storeu_ps(maxes, maxSse);
+        max = Math::max(Math::max(maxes[0], maxes[1]), Math::max(maxes[2], maxes[3]));
+    }
+    #endif
+
+    for(std::size_t jMax = output.size(); j != jMax; ++j)
+        max = Math::max(max, calculatePixelDelta(actual[j], expected[j], output[j], std::is_integral<T>{}));
+
+    return max;
+}
+
+/* Returns max and mean delta. If outputData is empty, the delta image is
+   calculated row by row into a temporary buffer and discarded. If the max
+   delta gets above maxThreshold, the calculation stops early and the
+   returned mean is unspecified. */
+template<std::size_t size, class T> std::pair<Float, Float> calculateImageDelta(const Containers::StridedArrayView2D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView2D<const Math::Vector<size, T>>& expected, const Containers::ArrayView<Float> outputData, const Float maxThreshold) {
+    CORRADE_INTERNAL_ASSERT(actual.size() == expected.size());
+
+    /* Rows are split into chunks of roughly 64k pixels. The split depends only
+       on the image size and not on the thread count so the mean is always
+       summed the same way. */
+    const std::size_t width = expected.size()[1];
+    const std::size_t height = expected.size()[0];
+    CORRADE_INTERNAL_ASSERT(outputData.empty() || outputData.size() == width*height);
+    const std::size_t rowsPerChunk = Math::max(std::size_t{1}, 65536/Math::max(width, std::size_t{1}));
+    const std::size_t chunkCount = (height + rowsPerChunk - 1)/rowsPerChunk;
+
+    /* Each chunk calculates its own max and sum */
+    Containers::Array<Vector2> chunkResults{Containers::ValueInit, chunkCount};
+    std::atomic<bool> aboveMaxThreshold{false};
+
+    Magnum::Implementation::parallelFor(height, rowsPerChunk, Magnum::Implementation::resolveThreadCount(0), [&](const std::size_t begin, const std::size_t end) {
+        Containers::Array<Float> rowData;
+        if(outputData.empty()) rowData = Containers::Array<Float>{Containers::NoInit, width};
+
+        /* Calculate also the sum for the mean delta. Do it the special way so
+           we don't lose precision -- that would result in having false
+           negatives! This *deliberately* leaves specials in. The `max` has
+           them already filtered out so if this would filter them out as well,
+           there would be nothing left that could cause the comparison to
+           fail. Summing row after row with the compensation carried over
+           gives the same result as summing the whole chunk at once. */
+        Float max{}, sum{}, compensation{};
+        for(std::size_t i = begin; i != end; ++i) {
+            /* Some other chunk already got above the threshold, no need to
+               continue */
+            if(aboveMaxThreshold) break;
+
+            const Containers::ArrayView<Float> row = outputData.empty() ?
+                Containers::arrayView(rowData) : outputData.slice(i*width, (i + 1)*width);
+            max = Math::max(max, calculateRowDelta(actual[i], expected[i], Containers::StridedArrayView1D<Float>{row}));
+            sum = Math::Algorithms::kahanSum(row.begin(), row.end(), sum, &compensation);
+
+            if(max > maxThreshold) {
+                aboveMaxThreshold = true;
+                break;
+            }
+        }
+
+        chunkResults[begin/rowsPerChunk] = {max, sum};
+    });
+
+    Float max{};
+    Float sum{}, compensation{};
+    for(const Vector2& result: chunkResults) {
+        max = Math::max(max, result[0]);
+        sum = Math::Algorithms::kahanSum(&result[1], &result[1] + 1, sum, &compensation);
+    }
+
+    return {max, sum/(width*height)};
+}
 
+std::pair<Float, Float> calculateImageDeltaInto(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected, const Containers::ArrayView<Float> output, const Float maxThreshold) {
     CORRADE_INTERNAL_ASSERT(actualFormat == expected.format());
     #ifdef CORRADE_NO_ASSERT
     static_cast<void>(actualFormat);
@@ -109,28 +307,28 @@ std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const Pix
     #pragma GCC diagnostic push
     #pragma GCC diagnostic error "-Wswitch"
     #endif
-    Float max{Constants::nan()};
+    std::pair<Float, Float> maxMean{Constants::nan(), Constants::nan()};
     switch(expected.format()) {
         #define _c(format, size, T)                                         \
             case PixelFormat::format:                                       \
-                max = calculateImageDelta<size, T>(                         \
+                maxMean = calculateImageDelta<size, T>(                     \
                     Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                    expected.pixels<Math::Vector<size, T>>(), output, maxThreshold); \
                 break;
         #define _d(first, second, size, T)                                  \
             case PixelFormat::first:                                        \
             case PixelFormat::second:                                       \
-                max = calculateImageDelta<size, T>(                         \
+                maxMean = calculateImageDelta<size, T>(                     \
                     Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                    expected.pixels<Math::Vector<size, T>>(), output, maxThreshold); \
                 break;
         #define _e(first, second, third, size, T)                           \
             case PixelFormat::first:                                        \
             case PixelFormat::second:                                       \
             case PixelFormat::third:                                        \
-                max = calculateImageDelta<size, T>(                         \
+                maxMean = calculateImageDelta<size, T>(                     \
                     Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                    expected.pixels<Math::Vector<size, T>>(), output, maxThreshold); \
                 break;
         /* LCOV_EXCL_START */
         _e(R8Unorm, R8Srgb, R8UI, 1, UnsignedByte)
@@ -176,17 +374,23 @@ std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const Pix
     #pragma GCC diagnostic pop
     #endif
 
-    CORRADE_ASSERT(max == max,
+    CORRADE_ASSERT(maxMean.first == maxMean.first,
         "DebugTools::CompareImage: unknown format" << expected.format(), {});
 
-    /* Calculate mean delta. Do it the special way so we don't lose
-       precision -- that would result in having false negatives! This
-       *deliberately* leaves specials in. The `max` has them already filtered
-       out so if this would filter them out as well, there would be nothing
-       left that could cause the comparison to fail. */
-    const Float mean = Math::Algorithms::kahanSum(deltaData.begin(), deltaData.end())/deltaData.size();
+    return maxMean;
+}
+
+}
+
+std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected) {
+    Containers::Array<Float> delta{Containers::NoInit,
+        std::size_t(expected.size().product())};
+    const std::pair<Float, Float> maxMean = calculateImageDeltaInto(actualFormat, actualPixels, expected, delta, Constants::inf());
+    return std::make_tuple(std::move(delta), maxMean.first, maxMean.second);
+}
 
-    return std::make_tuple(std::move(deltaData), max, mean);
+std::pair<Float, Float> calculateImageMaxMeanDelta(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected, const Float maxThreshold) {
+    return calculateImageDeltaInto(actualFormat, actualPixels, expected, nullptr, maxThreshold);
 }
 
 namespace {
@@ -324,34 +528,51 @@ void printPixelAt(Debug& out, const Containers::StridedArrayView3D<const char>&
 }
 
 void printPixelDeltas(Debug& out, Containers::ArrayView<const Float> delta, PixelFormat format, const Containers::StridedArrayView3D<const char>& actualPixels, const Containers::StridedArrayView3D<const char>& expectedPixels, const Float maxThreshold, const Float meanThreshold, std::size_t maxCount) {
-    /* Find first maxCount values above mean threshold and put them into a
-       sorted map. Need to reverse the condition in order to catch NaNs. */
-    std::multimap<Float, std::size_t> large;
-    for(std::size_t i = 0; i != delta.size(); ++i)
-        if(!(delta[i] <= meanThreshold)) large.emplace(delta[i], i);
+    /* Pick maxCount largest values above mean threshold using a bounded heap,
+       where the front is the smallest of the values picked so far. NaNs are
+       ranked the same as infinities, values that are the same are ordered
+       from the last pixel. Need to reverse the threshold condition in order
+       to catch NaNs. */
+    auto ranksAbove = [](const std::pair<Float, std::size_t>& a, const std::pair<Float, std::size_t>& b) {
+        const Float aValue = Math::isNan(a.first) ? Constants::inf() : a.first;
+        const Float bValue = Math::isNan(b.first) ? Constants::inf() : b.first;
+        return aValue > bValue || (aValue == bValue && a.second > b.second);
+    };
+    std::vector<std::pair<Float, std::size_t>> large;
+    std::size_t largeCount = 0;
+    for(std::size_t i = 0; i != delta.size(); ++i) {
+        if(delta[i] <= meanThreshold) continue;
+
+        ++largeCount;
+        if(large.size() < maxCount) {
+            large.emplace_back(delta[i], i);
+            std::push_heap(large.begin(), large.end(), ranksAbove);
+        } else if(maxCount && ranksAbove({delta[i], i}, large.front())) {
+            std::pop_heap(large.begin(), large.end(), ranksAbove);
+            large.back() = {delta[i], i};
+            std::push_heap(large.begin(), large.end(), ranksAbove);
+        }
+    }
 
     /* If there's no outliers, don't print anything. This can happen only when
        --verbose is used. */
-    if(large.empty()) return;
+    if(!largeCount) return;
 
     /* If there are outliers, adding a newline to separate itself from the
        delta image -- calling code wouldn't know if we produce output or not,
        so it can't do that on its own. */
     out << Debug::newline;
 
-    if(large.size() > maxCount)
-        out << "        Top" << maxCount << "out of" << large.size() << "pixels above max/mean threshold:";
+    if(largeCount > maxCount)
+        out << "        Top" << maxCount << "out of" << largeCount << "pixels above max/mean threshold:";
     else
         out << "        Pixels above max/mean threshold:";
 
-    /* Print the values from largest to smallest. Branching on the done in the
-       inner loop but that doesn't matter as we always print just ~10 values. */
-    std::size_t count = 0;
-    for(auto it = large.crbegin(); it != large.crend(); ++it) {
-        if(++count > maxCount) break;
-
+    /* Print the values from largest to smallest */
+    std::sort_heap(large.begin(), large.end(), ranksAbove);
+    for(const std::pair<Float, std::size_t>& it: large) {
         Vector2i pos;
-        std::tie(pos.y(), pos.x()) = Math::div(Int(it->second), Int(expectedPixels.size()[1]));
+        std::tie(pos.y(), pos.x()) = Math::div(Int(it.second), Int(expectedPixels.size()[1]));
         out << Debug::newline << "          [" << Debug::nospace << pos.x()
             << Debug::nospace << "," << Debug::nospace << pos.y()
             << Debug::nospace << "]";
@@ -362,8 +583,8 @@ void printPixelDeltas(Debug& out, Containers::ArrayView<const Float> delta, Pixe
 
         printPixelAt(out, expectedPixels, pos, format);
 
-        out << "(Δ =" << Debug::boldColor(delta[it->second] > maxThreshold ?
-            Debug::Color::Red : Debug::Color::Yellow) << delta[it->second]
+        out << "(Δ =" << Debug::boldColor(it.first > maxThreshold ?
+            Debug::Color::Red : Debug::Color::Yellow) << it.first
             << Debug::nospace << Debug::resetColor << ")";
     }
 }
@@ -417,7 +638,6 @@ class ImageComparatorBase::State {
         Float maxThreshold, meanThreshold;
         Result result{};
         Float max{}, mean{};
-        Containers::Array<Float> delta;
 };
 
 ImageComparatorBase::ImageComparatorBase(PluginManager::Manager<Trade::AbstractImporter>* importerManager, PluginManager::Manager<Trade::AbstractImageConverter>* converterManager, Float maxThreshold, Float meanThreshold): _state{Containers::InPlaceInit, importerManager, converterManager, maxThreshold, meanThreshold} {
@@ -450,8 +670,18 @@ TestSuite::ComparisonStatusFlags ImageComparatorBase::compare(const PixelFormat
         return TestSuite::ComparisonStatusFlag::Failed;
     }
 
-    Containers::Array<Float> delta;
-    std::tie(delta, _state->max, _state->mean) = DebugTools::Implementation::calculateImageDelta(actualFormat, actualPixels, expected);
+    /* Calculate just the max and mean delta first, the delta image is needed
+       only for printing the message. This stops early once the max delta is
+       above threshold, as the comparison fails no matter what the rest of
+       the image is. */
+    std::tie(_state->max, _state->mean) = DebugTools::Implementation::calculateImageMaxMeanDelta(actualFormat, actualPixels, expected, _state->maxThreshold);
+
+    /* The mean is not known in this case, the result gets refined once the
+       delta image is calculated in printMessage() */
+    if(_state->max > _state->maxThreshold) {
+        _state->result = Result::AboveMaxThreshold;
+        return TestSuite::ComparisonStatusFlag::Failed;
+    }
 
     /* Verify the max/mean is never below zero so we didn't mess up when
        calculating specials. Note the inverted condition to catch NaNs in
@@ -460,25 +690,19 @@ TestSuite::ComparisonStatusFlags ImageComparatorBase::compare(const PixelFormat
     CORRADE_INTERNAL_ASSERT(!(_state->mean < 0.0f));
     CORRADE_INTERNAL_ASSERT(_state->max >= 0.0f && !Math::isInf(_state->max) && !Math::isNan(_state->max));
 
-    /* If both values are not above threshold, success. If the values are
-       above, save the delta. If the values are below thresholds but nonzero,
-       we can provide optional message -- save the delta in that case too. */
-    TestSuite::ComparisonStatusFlags flags = TestSuite::ComparisonStatusFlag::Failed;
-    if(_state->max > _state->maxThreshold && !(_state->mean <= _state->meanThreshold))
-        _state->result = Result::AboveThresholds;
-    else if(_state->max > _state->maxThreshold)
-        _state->result = Result::AboveMaxThreshold;
-    /* Comparing this way in order to propely catch NaNs in mean values */
-    else if(!(_state->mean <= _state->meanThreshold))
+    /* Comparing this way in order to propely catch NaNs in mean values. If
+       the values are below thresholds but nonzero, we can provide optional
+       message. */
+    if(!(_state->mean <= _state->meanThreshold)) {
         _state->result = Result::AboveMeanThreshold;
-    else if(_state->max > 0.0f || _state->mean > 0.0f) {
+        return TestSuite::ComparisonStatusFlag::Failed;
+    }
+    if(_state->max > 0.0f || _state->mean > 0.0f) {
         _state->result = Result::VerboseMessage;
-        flags = TestSuite::ComparisonStatusFlag::Verbose;
-    } else return TestSuite::ComparisonStatusFlags{};
+        return TestSuite::ComparisonStatusFlag::Verbose;
+    }
 
-    /* Otherwise save the deltas and fail */
-    _state->delta = std::move(delta);
-    return flags;
+    return {};
 }
 
 TestSuite::ComparisonStatusFlags ImageComparatorBase::operator()(const ImageView2D& actual, const ImageView2D& expected) {
@@ -621,7 +845,7 @@ TestSuite::ComparisonStatusFlags ImageComparatorBase::operator()(const std::stri
     return compare(_state->actualFormat, _state->actualPixels, expected);
 }
 
-void ImageComparatorBase::printMessage(const TestSuite::ComparisonStatusFlags flags, Debug& out, const std::string& actual, const std::string& expected) const {
+void ImageComparatorBase::printMessage(const TestSuite::ComparisonStatusFlags flags, Debug& out, const std::string& actual, const std::string& expected) {
     if(_state->result == Result::PluginLoadFailed) {
         out << "AnyImageImporter plugin could not be loaded.";
         return;
@@ -652,6 +876,14 @@ void ImageComparatorBase::printMessage(const TestSuite::ComparisonStatusFlags fl
         out << "different format, actual" << _state->actualFormat
             << "but" << _state->expectedImage->format() << "expected.";
     else {
+        /* The comparison calculated just the max and mean delta, calculate
+           the full delta image now. If the comparison stopped early, it
+           didn't know the mean, so check if it's above threshold too. */
+        Containers::Array<Float> delta;
+        std::tie(delta, _state->max, _state->mean) = DebugTools::Implementation::calculateImageDelta(_state->actualFormat, _state->actualPixels, *_state->expectedImage);
+        if(_state->result == Result::AboveMaxThreshold && !(_state->mean <= _state->meanThreshold))
+            _state->result = Result::AboveThresholds;
+
         if(_state->result == Result::AboveThresholds)
             out << "both max and mean delta above threshold, actual"
                 << _state->max << Debug::nospace << "/" << Debug::nospace << _state->mean
@@ -679,9 +911,9 @@ void ImageComparatorBase::printMessage(const TestSuite::ComparisonStatusFlags fl
         } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 
         out << "Delta image:" << Debug::newline;
-        DebugTools::Implementation::printDeltaImage(out, _state->delta, _state->expectedImage->size(), _state->max, _state->maxThreshold, _state->meanThreshold);
+        DebugTools::Implementation::printDeltaImage(out, delta, _state->expectedImage->size(), _state->max, _state->maxThreshold, _state->meanThreshold);
         CORRADE_INTERNAL_ASSERT(_state->actualFormat == _state->expectedImage->format());
-        DebugTools::Implementation::printPixelDeltas(out, _state->delta, _state->actualFormat, _state->actualPixels, _state->expectedImage->pixels(), _state->maxThreshold, _state->meanThreshold, 10);
+        DebugTools::Implementation::printPixelDeltas(out, delta, _state->actualFormat, _state->actualPixels, _state->expectedImage->pixels(), _state->maxThreshold, _state->meanThreshold, 10);
     }
 }
 
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::DebugTools::CompareImage
  */
 
+#include <utility>
 #include <Corrade/Containers/Pointer.h>
 #include <Corrade/PluginManager/PluginManager.h>
 #include <Corrade/TestSuite/TestSuite.h>
@@ -46,6 +47,11 @@ namespace Magnum { namespace DebugTools {
 namespace Implementation {
     MAGNUM_DEBUGTOOLS_EXPORT std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected);
 
+    /* Calculates just the max and mean delta without keeping the delta image.
+       Stops early if the max delta gets above maxThreshold, the mean is
+       unspecified in that case. */
+    MAGNUM_DEBUGTOOLS_EXPORT std::pair<Float, Float> calculateImageMaxMeanDelta(PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected, Float maxThreshold);
+
     MAGNUM_DEBUGTOOLS_EXPORT void printDeltaImage(Debug& out, Containers::ArrayView<const Float> delta, const Vector2i& size, Float max, Float maxThreshold, Float meanThreshold);
 
     MAGNUM_DEBUGTOOLS_EXPORT void printPixelDeltas(Debug& out, Containers::ArrayView<const Float> delta, PixelFormat format, const Containers::StridedArrayView3D<const char>& actualPixels, const Containers::StridedArrayView3D<const char>& expectedPixels, Float maxThreshold, Float meanThreshold, std::size_t maxCount);
@@ -82,7 +88,9 @@ class MAGNUM_DEBUGTOOLS_EXPORT ImageComparatorBase {
         /* Used in templated CompareImageToFile::operator() */
         TestSuite::ComparisonStatusFlags compare(PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const std::string& expected);
 
-        void printMessage(TestSuite::ComparisonStatusFlags flags, Debug& out, const std::string& actual, const std::string& expected) const;
+        /* Not const because the delta image is calculated only here, if
+           needed */
+        void printMessage(TestSuite::ComparisonStatusFlags flags, Debug& out, const std::string& actual, const std::string& expected);
 
         void saveDiagnostic(TestSuite::ComparisonStatusFlags flags, Utility::Debug& out, const std::string& path);
 
@@ -0,0 +1,171 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CpuScopeRecorder.h"
+
+#include <atomic>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Implementation/ThreadBuffers.h"
+
+namespace Magnum { namespace DebugTools {
+
+namespace {
+
+struct Record {
+    UnsignedInt scope;
+    UnsignedLong nanoseconds;
+};
+
+}
+
+/* Single-producer single-consumer ring. The head is written only by the
+   owning thread, the tail only by collect(). Both indices grow monotonically
+   and are masked only when accessing the records. */
+struct CpuScopeRecorder::ThreadBuffer {
+    explicit ThreadBuffer(UnsignedInt capacity): records{Containers::NoInit, capacity} {}
+
+    Containers::Array<Record> records;
+    std::atomic<std::size_t> head{0}, tail{0};
+};
+
+struct CpuScopeRecorder::State {
+    struct Scope {
+        State* state;
+        UnsignedInt id;
+    };
+
+    explicit State(UnsignedInt scopeCount, UnsignedInt capacityPerThread);
+
+    void collect();
+
+    UnsignedInt capacity;
+    Containers::Array<Scope> scopes;
+    /* Written only by collect() and the measurement callbacks */
+    Containers::Array<UnsignedLong> totals;
+    std::atomic<UnsignedLong> droppedCount{0};
+    Magnum::Implementation::ThreadBuffers<ThreadBuffer> buffers;
+};
+
+CpuScopeRecorder::State::State(const UnsignedInt scopeCount, const UnsignedInt capacityPerThread): capacity{1}, scopes{Containers::NoInit, scopeCount}, totals{Containers::ValueInit, scopeCount} {
+    /* Round up to a power of two so the ring indices can be masked. Anything
+       larger than the largest 32-bit power of two would loop forever. */
+    CORRADE_ASSERT(capacityPerThread <= 1u << 31,
+        "DebugTools::CpuScopeRecorder: expected capacity per thread to be at most" << (1u << 31) << "but got" << capacityPerThread, );
+    while(capacity < capacityPerThread) capacity <<= 1;
+
+    for(UnsignedInt i = 0; i != scopeCount; ++i)
+        scopes[i] = Scope{this, i};
+}
+
+void CpuScopeRecorder::State::collect() {
+    buffers.forEach([this](ThreadBuffer& buffer, std::size_t) {
+        std::size_t tail = buffer.tail.load(std::memory_order_relaxed);
+        const std::size_t head = buffer.head.load(std::memory_order_acquire);
+        for(; tail != head; ++tail) {
+            const Record& record = buffer.records[tail & (buffer.records.size() - 1)];
+            totals[record.scope] += record.nanoseconds;
+        }
+        buffer.tail.store(tail, std::memory_order_release);
+    });
+}
+
+CpuScopeRecorder::CpuScopeRecorder(const UnsignedInt scopeCount, const UnsignedInt capacityPerThread): _state{Containers::InPlaceInit, scopeCount, capacityPerThread} {
+    CORRADE_ASSERT(scopeCount,
+        "DebugTools::CpuScopeRecorder: expected non-zero scope count", );
+    CORRADE_ASSERT(capacityPerThread,
+        "DebugTools::CpuScopeRecorder: expected non-zero capacity per thread", );
+}
+
+CpuScopeRecorder::~CpuScopeRecorder() = default;
+
+UnsignedInt CpuScopeRecorder::scopeCount() const {
+    return _state->scopes.size();
+}
+
+UnsignedInt CpuScopeRecorder::capacityPerThread() const {
+    return _state->capacity;
+}
+
+UnsignedInt CpuScopeRecorder::threadCount() const {
+    return _state->buffers.size();
+}
+
+UnsignedLong CpuScopeRecorder::droppedCount() const {
+    return _state->droppedCount.load(std::memory_order_relaxed);
+}
+
+CpuScopeRecorder::ThreadBuffer& CpuScopeRecorder::threadBuffer() {
+    return _state->buffers.get("DebugTools::CpuScopeRecorder::record():", _state->capacity);
+}
+
+void CpuScopeRecorder::record(const UnsignedInt scope, const UnsignedLong nanoseconds) {
+    CORRADE_ASSERT(scope < _state->scopes.size(),
+        "DebugTools::CpuScopeRecorder::record(): index" << scope << "out of range for" << _state->scopes.size() << "scopes", );
+
+    ThreadBuffer& buffer = threadBuffer();
+    const std::size_t head = buffer.head.load(std::memory_order_relaxed);
+    const std::size_t tail = buffer.tail.load(std::memory_order_acquire);
+    if(head - tail == buffer.records.size()) {
+        _state->droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.records[head & (buffer.records.size() - 1)] = Record{scope, nanoseconds};
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void CpuScopeRecorder::collect() {
+    _state->collect();
+}
+
+FrameProfiler::Measurement CpuScopeRecorder::measurement(const std::string& name, const UnsignedInt scope) {
+    CORRADE_ASSERT(scope < _state->scopes.size(),
+        "DebugTools::CpuScopeRecorder::measurement(): index" << scope << "out of range for" << _state->scopes.size() << "scopes",
+        (FrameProfiler::Measurement{name, FrameProfiler::Units::Nanoseconds, [](void*) {}, [](void*) { return UnsignedLong{}; }, nullptr}));
+
+    return FrameProfiler::Measurement{name,
+        FrameProfiler::Units::Nanoseconds,
+        [](void*) {},
+        [](void* state) {
+            /* Collects records of all scopes, not just this one. Those that
+               arrive after given scope was already reported are kept for the
+               next frame. */
+            State::Scope& scope = *static_cast<State::Scope*>(state);
+            scope.state->collect();
+            const UnsignedLong total = scope.state->totals[scope.id];
+            scope.state->totals[scope.id] = 0;
+            return total;
+        }, &_state->scopes[scope]};
+}
+
+CpuScopeRecorder::Scope::Scope(CpuScopeRecorder& recorder, const UnsignedInt scope): _recorder(recorder), _scope{scope}, _begin{std::chrono::steady_clock::now()} {}
+
+CpuScopeRecorder::Scope::~Scope() {
+    _recorder.record(_scope, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _begin).count());
+}
+
+}}
@@ -0,0 +1,241 @@
+#ifndef Magnum_DebugTools_CpuScopeRecorder_h
+#define Magnum_DebugTools_CpuScopeRecorder_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DebugTools::CpuScopeRecorder
+ * @m_since_latest
+ */
+
+#include <chrono>
+#include <string>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/DebugTools/FrameProfiler.h"
+
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Per-thread CPU scope recorder
+@m_since_latest
+
+Collects durations of CPU scopes executed on arbitrary threads and exposes
+their per-frame sums as @ref FrameProfiler measurements. Each thread that
+records a scope gets its own fixed-size ring buffer, so threads never contend
+with each other --- the only synchronization is a pair of atomic indices
+shared with the thread that calls @ref FrameProfiler::endFrame(). A thread
+finds its buffer through a thread-local cache of the four recorders it
+recorded into most recently, so a lock is taken only when a thread records
+into a recorder for the first time or into a recorder that dropped out of
+the cache because the thread recorded into four others since.
+
+@experimental
+
+@section DebugTools-CpuScopeRecorder-usage Usage
+
+Create the recorder with a count of distinct scopes, register a measurement
+for each scope with the profiler and then wrap the code to be measured with a
+@ref Scope instance:
+
+@code{.cpp}
+DebugTools::CpuScopeRecorder recorder{2};
+
+DebugTools::FrameProfiler profiler{{
+    recorder.measurement("Physics", 0),
+    recorder.measurement("Animation", 1)
+}, 50};
+
+// On any thread, for example in a job system worker
+{
+    DebugTools::CpuScopeRecorder::Scope scope{recorder, 0};
+    // ... physics update ...
+}
+@endcode
+
+At the end of each frame, all recorded durations are collected into the
+measurements, which then get a sum of durations of given scope recorded on
+all threads since the previous frame. Besides the mean, it's then possible to
+query @ref FrameProfiler::measurementPercentile(),
+@ref FrameProfiler::measurementMax() or
+@ref FrameProfiler::measurementHistogram() for them as with any other
+measurement.
+
+Per-thread buffers are created on first record from given thread and are kept
+until the recorder is destroyed. If a thread records more scopes than fit into
+its buffer before the frame ends, the extra records are dropped and counted
+in @ref droppedCount(). The measurements reference the recorder, so it's
+expected to outlive the profiler and all threads recording into it.
+
+@note Recording from multiple threads requires Corrade to be built with
+    @ref CORRADE_BUILD_MULTITHREADED enabled, which is the default. Without
+    it, the per-thread buffer lookup isn't thread-local and recording from
+    a second thread asserts.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT CpuScopeRecorder {
+    public:
+        class Scope;
+
+        /**
+         * @brief Constructor
+         * @param scopeCount        Count of distinct scopes
+         * @param capacityPerThread Record capacity of each per-thread
+         *      buffer. Rounded up to the nearest power of two.
+         *
+         * Expects that both @p scopeCount and @p capacityPerThread are
+         * non-zero and that @p capacityPerThread is not larger than
+         * @cpp 1u << 31 @ce.
+         */
+        explicit CpuScopeRecorder(UnsignedInt scopeCount, UnsignedInt capacityPerThread = 1024);
+
+        /** @brief Copying is not allowed */
+        CpuScopeRecorder(const CpuScopeRecorder&) = delete;
+
+        /**
+         * @brief Moving is not allowed
+         *
+         * Measurements and per-thread buffers reference the instance.
+         */
+        CpuScopeRecorder(CpuScopeRecorder&&) = delete;
+
+        ~CpuScopeRecorder();
+
+        /** @brief Copying is not allowed */
+        CpuScopeRecorder& operator=(const CpuScopeRecorder&) = delete;
+
+        /** @brief Moving is not allowed */
+        CpuScopeRecorder& operator=(CpuScopeRecorder&&) = delete;
+
+        /** @brief Count of distinct scopes */
+        UnsignedInt scopeCount() const;
+
+        /** @brief Record capacity of each per-thread buffer */
+        UnsignedInt capacityPerThread() const;
+
+        /**
+         * @brief Count of threads that recorded at least one scope
+         *
+         * Can be called from any thread.
+         */
+        UnsignedInt threadCount() const;
+
+        /**
+         * @brief Count of dropped records
+         *
+         * Records that didn't fit into a per-thread buffer. Can be called
+         * from any thread.
+         */
+        UnsignedLong droppedCount() const;
+
+        /**
+         * @brief Record a scope duration
+         * @param scope         Scope ID
+         * @param nanoseconds   Duration in nanoseconds
+         *
+         * Can be called from any thread. Expects that @p scope is less than
+         * @ref scopeCount(). See also the @ref Scope class for a RAII
+         * alternative.
+         */
+        void record(UnsignedInt scope, UnsignedLong nanoseconds);
+
+        /**
+         * @brief Collect recorded scopes
+         *
+         * Drains all per-thread buffers and adds the durations to per-scope
+         * totals that are then returned by the measurements. Called
+         * implicitly from @ref FrameProfiler::endFrame() through the
+         * measurements, so there's usually no need to call it directly. Not
+         * meant to be called from more than one thread at a time.
+         */
+        void collect();
+
+        /**
+         * @brief Create a measurement for given scope
+         * @param name      Measurement name
+         * @param scope     Scope ID
+         *
+         * Returns an immediate measurement in
+         * @ref FrameProfiler::Units::Nanoseconds that, at the end of each
+         * frame, reports a sum of all durations recorded for @p scope since
+         * the previous frame. Expects that @p scope is less than
+         * @ref scopeCount().
+         */
+        FrameProfiler::Measurement measurement(const std::string& name, UnsignedInt scope);
+
+    private:
+        struct ThreadBuffer;
+        struct State;
+
+        MAGNUM_DEBUGTOOLS_LOCAL ThreadBuffer& threadBuffer();
+
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Scoped CPU duration recording
+@m_since_latest
+
+Records time elapsed between construction and destruction using
+@ref std::chrono::steady_clock into a @ref CpuScopeRecorder.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT CpuScopeRecorder::Scope {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The @p scope is expected to be less than
+         * @ref CpuScopeRecorder::scopeCount(), which is checked in
+         * @ref CpuScopeRecorder::record() on destruction.
+         */
+        explicit Scope(CpuScopeRecorder& recorder, UnsignedInt scope);
+
+        /** @brief Copying is not allowed */
+        Scope(const Scope&) = delete;
+
+        /** @brief Moving is not allowed */
+        Scope(Scope&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref CpuScopeRecorder::record() with the elapsed time.
+         */
+        ~Scope();
+
+        /** @brief Copying is not allowed */
+        Scope& operator=(const Scope&) = delete;
+
+        /** @brief Moving is not allowed */
+        Scope& operator=(Scope&&) = delete;
+
+    private:
+        CpuScopeRecorder& _recorder;
+        UnsignedInt _scope;
+        std::chrono::steady_clock::time_point _begin;
+};
+
+}}
+
+#endif
@@ -25,7 +25,9 @@
 
 #include "FrameProfiler.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <sstream>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/GrowableArray.h>
@@ -273,9 +275,12 @@ UnsignedLong FrameProfiler::measurementData(const UnsignedInt id, const Unsigned
     return _data[((_measuredFrameCount - Math::min(_maxFrameCount + Math::max(_measurements[id]._delay, 1u) - 1, _measuredFrameCount) + frame) % _maxFrameCount)*_measurements.size() + id];
 }
 
+UnsignedInt FrameProfiler::measurementFrameCountInternal(const Measurement& measurement) const {
+    return Math::min(_measuredFrameCount - Math::max(measurement._delay, 1u) + 1, _maxFrameCount);
+}
+
 Double FrameProfiler::measurementMeanInternal(const Measurement& measurement) const {
-    return Double(measurement._movingSum)/
-        Math::min(_measuredFrameCount - Math::max(measurement._delay, 1u) + 1, _maxFrameCount);
+    return Double(measurement._movingSum)/measurementFrameCountInternal(measurement);
 }
 
 Double FrameProfiler::measurementMean(const UnsignedInt id) const {
@@ -286,6 +291,63 @@ Double FrameProfiler::measurementMean(const UnsignedInt id) const {
     return measurementMeanInternal(_measurements[id]);
 }
 
+UnsignedLong FrameProfiler::measurementPercentile(const UnsignedInt id, const Double percentile) const {
+    CORRADE_ASSERT(id < _measurements.size(),
+        "DebugTools::FrameProfiler::measurementPercentile(): index" << id << "out of range for" << _measurements.size() << "measurements", {});
+    CORRADE_ASSERT(_measuredFrameCount >= Math::max(_measurements[id]._delay, 1u), "DebugTools::FrameProfiler::measurementPercentile(): measurement data available after" << Math::max(_measurements[id]._delay, 1u) - _measuredFrameCount << "more frames", {});
+    CORRADE_ASSERT(percentile >= 0.0 && percentile <= 100.0,
+        "DebugTools::FrameProfiler::measurementPercentile(): expected percentile to be in range [0, 100] but got" << percentile, {});
+
+    /* Until the measurement wraps around, the data are stored from the
+       beginning. After, all frames are used, so the order doesn't matter. */
+    const UnsignedInt frameCount = measurementFrameCountInternal(_measurements[id]);
+    Containers::Array<UnsignedLong> values{Containers::NoInit, frameCount};
+    for(UnsignedInt i = 0; i != frameCount; ++i)
+        values[i] = _data[i*_measurements.size() + id];
+
+    /* Nearest rank, with the zeroth percentile being the smallest value.
+       Multiplying first, as for example 14.0/100.0*50 is 7.000000000000001,
+       which would round up to a wrong rank. */
+    const std::size_t rank = std::size_t(std::ceil(percentile*frameCount/100.0));
+    const std::size_t index = rank ? rank - 1 : 0;
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+UnsignedLong FrameProfiler::measurementMax(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _measurements.size(),
+        "DebugTools::FrameProfiler::measurementMax(): index" << id << "out of range for" << _measurements.size() << "measurements", {});
+    CORRADE_ASSERT(_measuredFrameCount >= Math::max(_measurements[id]._delay, 1u), "DebugTools::FrameProfiler::measurementMax(): measurement data available after" << Math::max(_measurements[id]._delay, 1u) - _measuredFrameCount << "more frames", {});
+
+    UnsignedLong max = 0;
+    for(UnsignedInt i = 0, frameCount = measurementFrameCountInternal(_measurements[id]); i != frameCount; ++i)
+        max = Math::max(max, _data[i*_measurements.size() + id]);
+    return max;
+}
+
+Containers::Array<UnsignedInt> FrameProfiler::measurementHistogram(const UnsignedInt id, const UnsignedInt binCount, const UnsignedLong min, const UnsignedLong max) const {
+    CORRADE_ASSERT(id < _measurements.size(),
+        "DebugTools::FrameProfiler::measurementHistogram(): index" << id << "out of range for" << _measurements.size() << "measurements", {});
+    CORRADE_ASSERT(_measuredFrameCount >= Math::max(_measurements[id]._delay, 1u), "DebugTools::FrameProfiler::measurementHistogram(): measurement data available after" << Math::max(_measurements[id]._delay, 1u) - _measuredFrameCount << "more frames", {});
+    CORRADE_ASSERT(binCount, "DebugTools::FrameProfiler::measurementHistogram(): bin count can't be zero", {});
+    CORRADE_ASSERT(min < max,
+        "DebugTools::FrameProfiler::measurementHistogram(): expected min to be less than max but got" << min << "and" << max, {});
+
+    Containers::Array<UnsignedInt> bins{Containers::ValueInit, binCount};
+    const Double binSize = Double(max - min)/binCount;
+    for(UnsignedInt i = 0, frameCount = measurementFrameCountInternal(_measurements[id]); i != frameCount; ++i) {
+        const UnsignedLong value = _data[i*_measurements.size() + id];
+        UnsignedInt bin;
+        if(value < min) bin = 0;
+        else if(value >= max) bin = binCount - 1;
+        /* Clamp in case the division rounds up to binCount */
+        else bin = Math::min(UnsignedInt((value - min)/binSize), binCount - 1);
+        ++bins[bin];
+    }
+
+    return bins;
+}
+
 namespace {
 
 /* Based on Corrade/TestSuite/Implementation/BenchmarkStats.h */
@@ -613,6 +675,24 @@ Double GLFrameProfiler::gpuDurationMean() const {
     return measurementMean(_state->gpuDurationIndex);
 }
 
+UnsignedLong GLFrameProfiler::frameTimePercentile(const Double percentile) const {
+    CORRADE_ASSERT(_state->frameTimeIndex < measurementCount(),
+        "DebugTools::GLFrameProfiler::frameTimePercentile(): not enabled", {});
+    return measurementPercentile(_state->frameTimeIndex, percentile);
+}
+
+UnsignedLong GLFrameProfiler::cpuDurationPercentile(const Double percentile) const {
+    CORRADE_ASSERT(_state->cpuDurationIndex < measurementCount(),
+        "DebugTools::GLFrameProfiler::cpuDurationPercentile(): not enabled", {});
+    return measurementPercentile(_state->cpuDurationIndex, percentile);
+}
+
+UnsignedLong GLFrameProfiler::gpuDurationPercentile(const Double percentile) const {
+    CORRADE_ASSERT(_state->gpuDurationIndex < measurementCount(),
+        "DebugTools::GLFrameProfiler::gpuDurationPercentile(): not enabled", {});
+    return measurementPercentile(_state->gpuDurationIndex, percentile);
+}
+
 #ifndef MAGNUM_TARGET_GLES
 Double GLFrameProfiler::vertexFetchRatioMean() const {
     CORRADE_ASSERT(_state->vertexFetchRatioIndex < measurementCount(),
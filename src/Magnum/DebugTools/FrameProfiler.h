@@ -47,7 +47,8 @@ A generic implementation of a frame profiler supporting a moving average over
 a set of frames as well as delayed measurements to avoid stalls when querying
 the results. This class alone doesn't provide any pre-defined measurements, see
 for example @ref GLFrameProfiler that provides common measurements like CPU and
-GPU time.
+GPU time. For a timeline of individual nested zones instead of aggregated
+per-frame values see @ref Tracer.
 
 @experimental
 
@@ -66,7 +67,10 @@ operation using @ref enable() / @ref disable() and then
 @ref isEnabled() returns @cpp true @ce.
 
 Data for all measurements is then available through @ref measurementName(),
-@ref measurementUnits() and @ref measurementMean(). For a convenient overview
+@ref measurementUnits() and @ref measurementMean(). Because a mean hides
+occasional spikes, @ref measurementPercentile(), @ref measurementMax() and
+@ref measurementHistogram() provide a view into the distribution of the values
+over the same set of frames. For a convenient overview
 of all measured values you can call @ref statistics() and feed its output to a
 UI library or something that can render text. Alternatively, if you don't want
 to bother with text rendering, call @ref printStatistics() to have the output
@@ -351,6 +355,56 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
          */
         Double measurementMean(UnsignedInt id) const;
 
+        /**
+         * @brief Measurement percentile
+         * @m_since_latest
+         *
+         * Returns the smallest of the last @ref maxFrameCount() measured
+         * values such that at least @p percentile percent of the values are
+         * less or equal to it (the nearest-rank method). A @p percentile of
+         * @cpp 50.0 @ce gives a median, @cpp 100.0 @ce is equivalent to
+         * @ref measurementMax(). Compared to @ref measurementMean(), high
+         * percentiles aren't hiding occasional spikes in otherwise smooth
+         * data.
+         *
+         * The @p id corresponds to the index of the measurement in the list
+         * passed to @ref setup(). Expects that @p id is less than
+         * @ref measurementCount(), that the measurement is available and
+         * that @p percentile is in the @f$ [0, 100] @f$ range.
+         * @see @ref isMeasurementAvailable(), @ref measurementHistogram()
+         */
+        UnsignedLong measurementPercentile(UnsignedInt id, Double percentile) const;
+
+        /**
+         * @brief Measurement max
+         * @m_since_latest
+         *
+         * Returns the largest of the last @ref maxFrameCount() measured
+         * values. The @p id corresponds to the index of the measurement in
+         * the list passed to @ref setup(). Expects that @p id is less than
+         * @ref measurementCount() and that the measurement is available.
+         * @see @ref isMeasurementAvailable(), @ref measurementPercentile()
+         */
+        UnsignedLong measurementMax(UnsignedInt id) const;
+
+        /**
+         * @brief Measurement histogram
+         * @m_since_latest
+         *
+         * Distributes the last @ref maxFrameCount() measured values into
+         * @p binCount bins of equal size covering the @f$ [min, max) @f$
+         * range and returns count of values in each. Values less than @p min
+         * are counted in the first bin, values larger or equal to @p max in
+         * the last bin.
+         *
+         * The @p id corresponds to the index of the measurement in the list
+         * passed to @ref setup(). Expects that @p id is less than
+         * @ref measurementCount(), that the measurement is available,
+         * @p binCount is not zero and @p min is less than @p max.
+         * @see @ref isMeasurementAvailable(), @ref measurementPercentile()
+         */
+        Containers::Array<UnsignedInt> measurementHistogram(UnsignedInt id, UnsignedInt binCount, UnsignedLong min, UnsignedLong max) const;
+
         /**
          * @brief Overview of all measurements
          *
@@ -392,6 +446,7 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
 
     private:
         UnsignedInt delayedCurrentData(UnsignedInt delay) const;
+        UnsignedInt measurementFrameCountInternal(const Measurement& measurement) const;
         Double measurementMeanInternal(const Measurement& measurement) const;
         void printStatisticsInternal(Debug& out) const;
 
@@ -665,6 +720,39 @@ class MAGNUM_DEBUGTOOLS_EXPORT GLFrameProfiler: public FrameProfiler {
          */
         Double gpuDurationMean() const;
 
+        /**
+         * @brief Frame time percentile in nanoseconds
+         * @m_since_latest
+         *
+         * Expects that @ref Value::FrameTime was enabled, and that measurement
+         * data is available. See the flag documentation and
+         * @ref measurementPercentile() for more information.
+         * @see @ref isMeasurementAvailable()
+         */
+        UnsignedLong frameTimePercentile(Double percentile) const;
+
+        /**
+         * @brief CPU frame duration percentile in nanoseconds
+         * @m_since_latest
+         *
+         * Expects that @ref Value::CpuDuration was enabled, and that
+         * measurement data is available. See the flag documentation and
+         * @ref measurementPercentile() for more information.
+         * @see @ref isMeasurementAvailable()
+         */
+        UnsignedLong cpuDurationPercentile(Double percentile) const;
+
+        /**
+         * @brief GPU frame duration percentile in nanoseconds
+         * @m_since_latest
+         *
+         * Expects that @ref Value::GpuDuration was enabled, and that
+         * measurement data is available. See the flag documentation and
+         * @ref measurementPercentile() for more information.
+         * @see @ref isMeasurementAvailable()
+         */
+        UnsignedLong gpuDurationPercentile(Double percentile) const;
+
         #ifndef MAGNUM_TARGET_GLES
         /**
          * @brief Mean vertex fetch ratio in thousandths
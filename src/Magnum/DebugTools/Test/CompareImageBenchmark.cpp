@@ -0,0 +1,127 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Comparator.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/DebugTools/CompareImage.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+struct CompareImageBenchmark: TestSuite::Tester {
+    explicit CompareImageBenchmark();
+
+    void delta();
+    void compareMatching();
+    void pixelDeltas();
+};
+
+constexpr Vector2i Size{2048, 2048};
+
+constexpr struct {
+    const char* name;
+    PixelFormat format;
+} DeltaData[]{
+    {"R8Unorm", PixelFormat::R8Unorm},
+    {"RGB8Unorm", PixelFormat::RGB8Unorm},
+    {"RGBA8Unorm", PixelFormat::RGBA8Unorm},
+    {"RGBA8Snorm", PixelFormat::RGBA8Snorm},
+    {"RGBA16Unorm", PixelFormat::RGBA16Unorm},
+    {"R32F", PixelFormat::R32F},
+    {"RGBA32F", PixelFormat::RGBA32F}
+};
+
+CompareImageBenchmark::CompareImageBenchmark() {
+    addInstancedBenchmarks({&CompareImageBenchmark::delta}, 5,
+        Containers::arraySize(DeltaData));
+
+    addBenchmarks({&CompareImageBenchmark::compareMatching,
+                   &CompareImageBenchmark::pixelDeltas}, 5);
+}
+
+void CompareImageBenchmark::delta() {
+    auto&& data = DeltaData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Filling the bytes with a constant is enough to get a (finite) nonzero
+       difference for all formats */
+    const std::size_t dataSize = Size.product()*pixelSize(data.format);
+    Containers::Array<char> actualData{Containers::DirectInit, dataSize, '\x33'};
+    Containers::Array<char> expectedData{Containers::DirectInit, dataSize, '\x35'};
+    const ImageView2D actual{data.format, Size, actualData};
+    const ImageView2D expected{data.format, Size, expectedData};
+
+    Float max{}, mean{};
+    CORRADE_BENCHMARK(1) {
+        Containers::Array<Float> delta;
+        std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected);
+    }
+
+    CORRADE_VERIFY(max > 0.0f);
+}
+
+void CompareImageBenchmark::compareMatching() {
+    /* The common case in tests, where only the max and mean delta gets
+       calculated without allocating the delta image */
+    Containers::Array<char> actualData{Containers::DirectInit, std::size_t(Size.product()*4), '\x33'};
+    Containers::Array<char> expectedData{Containers::DirectInit, std::size_t(Size.product()*4), '\x35'};
+    const ImageView2D actual{PixelFormat::RGBA8Unorm, Size, actualData};
+    const ImageView2D expected{PixelFormat::RGBA8Unorm, Size, expectedData};
+
+    TestSuite::ComparisonStatusFlags flags;
+    CORRADE_BENCHMARK(1) {
+        TestSuite::Comparator<CompareImage> compare{4.0f, 2.0f};
+        flags = compare(actual, expected);
+    }
+
+    CORRADE_COMPARE(flags, TestSuite::ComparisonStatusFlag::Verbose);
+}
+
+void CompareImageBenchmark::pixelDeltas() {
+    /* All pixels above threshold, which is the worst case for picking the
+       top ones */
+    Containers::Array<Float> delta{Containers::NoInit, std::size_t(Size.product())};
+    for(std::size_t i = 0; i != delta.size(); ++i)
+        delta[i] = Float((i*7919) % 65536)/65536.0f + 0.5f;
+    Containers::Array<Float> pixels{Containers::ValueInit, std::size_t(Size.product())};
+    const ImageView2D image{PixelFormat::R32F, Size, pixels};
+
+    std::ostringstream out;
+    CORRADE_BENCHMARK(1) {
+        Debug d{&out, Debug::Flag::DisableColors};
+        Implementation::printPixelDeltas(d, delta, image.format(), image.pixels(), image.pixels(), 0.75f, 0.25f, 10);
+    }
+
+    CORRADE_VERIFY(!out.str().empty());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::CompareImageBenchmark)
@@ -32,6 +32,7 @@
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/File.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/FormatStl.h>
@@ -60,6 +61,10 @@ struct CompareImageTest: TestSuite::Tester {
     void calculateDeltaStorage();
     void calculateDeltaSpecials();
     void calculateDeltaSpecials3();
+    void calculateDeltaWide();
+    void calculateDeltaWideSpecials();
+    void calculateDeltaMultipleChunks();
+    void calculateMaxMeanDelta();
 
     void deltaImage();
     void deltaImageScaling();
@@ -131,6 +136,10 @@ CompareImageTest::CompareImageTest() {
               &CompareImageTest::calculateDeltaStorage,
               &CompareImageTest::calculateDeltaSpecials,
               &CompareImageTest::calculateDeltaSpecials3,
+              &CompareImageTest::calculateDeltaWide,
+              &CompareImageTest::calculateDeltaWideSpecials,
+              &CompareImageTest::calculateDeltaMultipleChunks,
+              &CompareImageTest::calculateMaxMeanDelta,
 
               &CompareImageTest::deltaImage,
               &CompareImageTest::deltaImageScaling,
@@ -386,6 +395,149 @@ void CompareImageTest::calculateDeltaSpecials3() {
     CORRADE_COMPARE(mean, -Constants::nan());
 }
 
+void CompareImageTest::calculateDeltaWide() {
+    /* Rows wide enough to go through the vectorized code path (if any) and
+       a scalar remainder, with the values covering the whole 8-bit range in
+       both directions */
+    UnsignedByte actualData[3*43*4];
+    UnsignedByte expectedData[3*43*4];
+    for(std::size_t i = 0; i != Containers::arraySize(actualData); ++i) {
+        actualData[i] = UnsignedByte(i*37);
+        expectedData[i] = UnsignedByte(i*101 + 13);
+    }
+
+    for(PixelFormat format: {PixelFormat::R8Unorm, PixelFormat::RG8Unorm, PixelFormat::RGBA8Unorm, PixelFormat::R8Snorm, PixelFormat::RGBA8Snorm}) {
+        CORRADE_ITERATION(format);
+
+        const UnsignedInt channelCount = pixelSize(format);
+        const bool isSigned = format == PixelFormat::R8Snorm || format == PixelFormat::RGBA8Snorm;
+        const Vector2i size{Int(Containers::arraySize(actualData)/channelCount/3), 3};
+        const ImageView2D actual{format, size, actualData};
+        const ImageView2D expected{format, size, expectedData};
+
+        Containers::Array<Float> expectedDelta{std::size_t(size.product())};
+        Float expectedMax{};
+        for(std::size_t i = 0; i != expectedDelta.size(); ++i) {
+            Float sum{};
+            for(std::size_t j = 0; j != channelCount; ++j) {
+                const std::size_t index = i*channelCount + j;
+                sum += isSigned ?
+                    Math::abs(Float(Byte(actualData[index])) - Float(Byte(expectedData[index]))) :
+                    Math::abs(Float(actualData[index]) - Float(expectedData[index]));
+            }
+            expectedDelta[i] = sum/channelCount;
+            expectedMax = Math::max(expectedMax, expectedDelta[i]);
+        }
+
+        Containers::Array<Float> delta;
+        Float max, mean;
+        std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected);
+        CORRADE_COMPARE_AS(delta, expectedDelta, TestSuite::Compare::Container);
+        CORRADE_COMPARE(max, expectedMax);
+        CORRADE_COMPARE(mean, std::accumulate(expectedDelta.begin(), expectedDelta.end(), 0.0f)/expectedDelta.size());
+    }
+}
+
+void CompareImageTest::calculateDeltaWideSpecials() {
+    /* Same as calculateDeltaSpecials3(), but with four-component pixels and
+       the data repeated so part of it goes through the vectorized code path
+       (if any) and part through the scalar remainder */
+    Float actualData[20];
+    Float expectedData[20];
+    for(std::size_t i = 0; i != 20; ++i) {
+        actualData[i] = ActualDataSpecials[i < 18 ? i % 9 : i - 11];
+        expectedData[i] = ExpectedDataSpecials[i < 18 ? i % 9 : i - 11];
+    }
+    const ImageView2D actual{PixelFormat::RGBA32F, {5, 1}, actualData};
+    const ImageView2D expected{PixelFormat::RGBA32F, {5, 1}, expectedData};
+
+    Containers::Array<Float> delta;
+    Float max, mean;
+    std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected);
+    CORRADE_COMPARE_AS(delta, (Containers::Array<Float>{Containers::InPlaceInit, {
+        Constants::nan(), Constants::inf(), Constants::nan(), Constants::nan(),
+        (0.35f + 3.1f + 0.35f + 3.1f)/4.0f
+    }}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(max, (0.35f + 3.1f + 0.35f + 3.1f)/4.0f);
+    CORRADE_COMPARE(mean, -Constants::nan());
+}
+
+void CompareImageTest::calculateDeltaMultipleChunks() {
+    /* The delta is calculated in chunks of 65536 pixels, this is 218 rows per
+       chunk and thus three chunks, the last one partial. All channel deltas
+       are below 128 except for one pixel in the last chunk, so the max is
+       correct only if the chunk results are combined properly. */
+    const Vector2i size{300, 500};
+    Containers::Array<UnsignedByte> actualData{std::size_t(size.product()*4)};
+    Containers::Array<UnsignedByte> expectedData{std::size_t(size.product()*4)};
+    for(std::size_t i = 0; i != actualData.size(); ++i) {
+        actualData[i] = UnsignedByte(i*37 & 0x7f);
+        expectedData[i] = UnsignedByte((i*101 + 13) & 0x7f);
+    }
+    for(std::size_t i = 0; i != 4; ++i) {
+        actualData[(470*300 + 17)*4 + i] = 200;
+        expectedData[(470*300 + 17)*4 + i] = 0;
+    }
+
+    const ImageView2D actual{PixelFormat::RGBA8Unorm, size, actualData};
+    const ImageView2D expected{PixelFormat::RGBA8Unorm, size, expectedData};
+
+    /* Scalar reference, with the mean summed in double precision */
+    Containers::Array<Float> expectedDelta{std::size_t(size.product())};
+    Float expectedMax{};
+    Double expectedSum{};
+    for(std::size_t i = 0; i != expectedDelta.size(); ++i) {
+        Float sum{};
+        for(std::size_t j = 0; j != 4; ++j)
+            sum += Math::abs(Float(actualData[i*4 + j]) - Float(expectedData[i*4 + j]));
+        expectedDelta[i] = sum/4;
+        expectedMax = Math::max(expectedMax, expectedDelta[i]);
+        expectedSum += expectedDelta[i];
+    }
+    CORRADE_COMPARE(expectedMax, 200.0f);
+
+    Containers::Array<Float> delta;
+    Float max, mean;
+    std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected);
+    CORRADE_COMPARE_AS(delta, expectedDelta, TestSuite::Compare::Container);
+    CORRADE_COMPARE(max, expectedMax);
+    CORRADE_COMPARE(mean, Float(expectedSum/expectedDelta.size()));
+
+    /* Without the delta image it should give the same result */
+    std::tie(max, mean) = Implementation::calculateImageMaxMeanDelta(actual.format(), actual.pixels(), expected, Constants::inf());
+    CORRADE_COMPARE(max, expectedMax);
+    CORRADE_COMPARE(mean, Float(expectedSum/expectedDelta.size()));
+
+    /* A NaN in the middle chunk gets propagated to the mean but not to the
+       max */
+    Containers::Array<Float> actualSpecials{Containers::ValueInit, std::size_t(size.product())};
+    Containers::Array<Float> expectedSpecials{Containers::ValueInit, std::size_t(size.product())};
+    actualSpecials[300*300 + 5] = Constants::nan();
+    actualSpecials[100*300 + 5] = 3.5f;
+    std::tie(max, mean) = Implementation::calculateImageMaxMeanDelta(PixelFormat::R32F, ImageView2D{PixelFormat::R32F, size, actualSpecials}.pixels(), ImageView2D{PixelFormat::R32F, size, expectedSpecials}, Constants::inf());
+    CORRADE_COMPARE(max, 3.5f);
+    CORRADE_COMPARE(mean, Constants::nan());
+}
+
+void CompareImageTest::calculateMaxMeanDelta() {
+    /* Without an early out it should give the same results as
+       calculateDelta() */
+    {
+        Float max, mean;
+        std::tie(max, mean) = Implementation::calculateImageMaxMeanDelta(ActualRed.format(), ActualRed.pixels(), ExpectedRed, 1.0f);
+        CORRADE_COMPARE(max, 1.0f);
+        CORRADE_COMPARE(mean, 0.208889f);
+
+    /* With an early out the max is above the threshold, but not necessarily
+       the actual max */
+    } {
+        Float max, mean;
+        std::tie(max, mean) = Implementation::calculateImageMaxMeanDelta(ActualRed.format(), ActualRed.pixels(), ExpectedRed, 0.2f);
+        CORRADE_COMPARE_AS(max, 0.2f, TestSuite::Compare::Greater);
+        CORRADE_COMPARE_AS(max, 1.0f, TestSuite::Compare::LessOrEqual);
+    }
+}
+
 void CompareImageTest::deltaImage() {
     std::ostringstream out;
     Debug d{&out, Debug::Flag::DisableColors};
@@ -0,0 +1,285 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/System.h>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <atomic>
+#include <thread>
+#include <vector>
+#endif
+
+#include "Magnum/DebugTools/CpuScopeRecorder.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+struct CpuScopeRecorderTest: TestSuite::Tester {
+    explicit CpuScopeRecorderTest();
+
+    void construct();
+    void constructInvalid();
+
+    void record();
+    void recordOverflow();
+    void recordMultipleThreads();
+    void recordMultipleRecorders();
+    void recordInvalid();
+
+    void measurement();
+    void measurementInvalid();
+
+    void scope();
+};
+
+CpuScopeRecorderTest::CpuScopeRecorderTest() {
+    addTests({&CpuScopeRecorderTest::construct,
+              &CpuScopeRecorderTest::constructInvalid,
+
+              &CpuScopeRecorderTest::record,
+              &CpuScopeRecorderTest::recordOverflow,
+              &CpuScopeRecorderTest::recordMultipleThreads,
+              &CpuScopeRecorderTest::recordMultipleRecorders,
+              &CpuScopeRecorderTest::recordInvalid,
+
+              &CpuScopeRecorderTest::measurement,
+              &CpuScopeRecorderTest::measurementInvalid,
+
+              &CpuScopeRecorderTest::scope});
+}
+
+void CpuScopeRecorderTest::construct() {
+    CpuScopeRecorder recorder{3, 100};
+    CORRADE_COMPARE(recorder.scopeCount(), 3);
+    /* Rounded up to a power of two */
+    CORRADE_COMPARE(recorder.capacityPerThread(), 128);
+    CORRADE_COMPARE(recorder.threadCount(), 0);
+    CORRADE_COMPARE(recorder.droppedCount(), 0);
+}
+
+void CpuScopeRecorderTest::constructInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CpuScopeRecorder{0};
+    CpuScopeRecorder{1, 0};
+    CpuScopeRecorder{1, (1u << 31) + 1};
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::CpuScopeRecorder: expected non-zero scope count\n"
+        "DebugTools::CpuScopeRecorder: expected non-zero capacity per thread\n"
+        "DebugTools::CpuScopeRecorder: expected capacity per thread to be at most 2147483648 but got 2147483649\n");
+}
+
+void CpuScopeRecorderTest::record() {
+    CpuScopeRecorder recorder{2};
+    FrameProfiler profiler{{
+        recorder.measurement("First", 0),
+        recorder.measurement("Second", 1)
+    }, 3};
+
+    profiler.beginFrame();
+    recorder.record(0, 15);
+    recorder.record(1, 3);
+    recorder.record(0, 27);
+    profiler.endFrame();
+    CORRADE_COMPARE(recorder.threadCount(), 1);
+    CORRADE_COMPARE(profiler.measurementData(0, 0), 42);
+    CORRADE_COMPARE(profiler.measurementData(1, 0), 3);
+
+    /* Nothing recorded in this frame */
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.measurementData(0, 1), 0);
+    CORRADE_COMPARE(profiler.measurementData(1, 1), 0);
+
+    profiler.beginFrame();
+    recorder.record(1, 6);
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.measurementData(0, 2), 0);
+    CORRADE_COMPARE(profiler.measurementData(1, 2), 6);
+    CORRADE_COMPARE(profiler.measurementMean(0), 14.0);
+    CORRADE_COMPARE(profiler.measurementMax(1), 6);
+
+    /* Still the same thread */
+    CORRADE_COMPARE(recorder.threadCount(), 1);
+    CORRADE_COMPARE(recorder.droppedCount(), 0);
+}
+
+void CpuScopeRecorderTest::recordOverflow() {
+    CpuScopeRecorder recorder{1, 4};
+
+    for(UnsignedLong i = 1; i != 7; ++i) recorder.record(0, i);
+    CORRADE_COMPARE(recorder.droppedCount(), 2);
+
+    /* Only the first four got recorded */
+    FrameProfiler profiler{{
+        recorder.measurement("", 0)
+    }, 3};
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.measurementData(0, 0), 1 + 2 + 3 + 4);
+
+    /* After collecting there's space again */
+    profiler.beginFrame();
+    for(UnsignedLong i = 1; i != 5; ++i) recorder.record(0, 10);
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.measurementData(0, 1), 40);
+    CORRADE_COMPARE(recorder.droppedCount(), 2);
+}
+
+void CpuScopeRecorderTest::recordMultipleThreads() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Threads are not available on Emscripten.");
+    #else
+    CpuScopeRecorder recorder{2, 256};
+    FrameProfiler profiler{{
+        recorder.measurement("First", 0),
+        recorder.measurement("Second", 1)
+    }, 1};
+
+    /* Each thread records alternately into both scopes while the main thread
+       keeps collecting, the totals should add up in the end */
+    std::atomic<UnsignedInt> finished{0};
+    std::vector<std::thread> threads;
+    for(UnsignedInt i = 0; i != 4; ++i) threads.emplace_back([&recorder, &finished]() {
+        for(UnsignedInt j = 0; j != 10000; ++j) {
+            recorder.record(j % 2, 1);
+            /* Give the collecting thread a chance to catch up */
+            if(j % 128 == 0) std::this_thread::yield();
+        }
+        ++finished;
+    });
+
+    UnsignedLong first = 0, second = 0;
+    for(bool done = false; !done; ) {
+        /* Checking before the frame so the last records get collected */
+        done = finished == 4;
+        profiler.beginFrame();
+        profiler.endFrame();
+        first += profiler.measurementData(0, 0);
+        second += profiler.measurementData(1, 0);
+    }
+
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(recorder.threadCount(), 4);
+    CORRADE_COMPARE(first + second + recorder.droppedCount(), 4*10000);
+    /* Unless anything got dropped, both scopes got the same count */
+    if(!recorder.droppedCount()) CORRADE_COMPARE(first, second);
+    #endif
+}
+
+void CpuScopeRecorderTest::recordMultipleRecorders() {
+    /* More recorders than there's entries in the thread-local cache, each
+       has to get its own buffer even when they get evicted from the cache
+       in between. Each buffer is filled exactly, so if records went into a
+       wrong buffer, some would get dropped. */
+    CpuScopeRecorder a{1, 4}, b{1, 4}, c{1, 4}, d{1, 4}, e{1, 4};
+    CpuScopeRecorder* recorders[]{&a, &b, &c, &d, &e};
+    for(UnsignedInt i = 0; i != 4; ++i)
+        for(CpuScopeRecorder* recorder: recorders)
+            recorder->record(0, 1);
+
+    for(CpuScopeRecorder* recorder: recorders) {
+        CORRADE_COMPARE(recorder->threadCount(), 1);
+        CORRADE_COMPARE(recorder->droppedCount(), 0);
+    }
+}
+
+void CpuScopeRecorderTest::recordInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    CpuScopeRecorder recorder{2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    recorder.record(2, 10);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::CpuScopeRecorder::record(): index 2 out of range for 2 scopes\n");
+}
+
+void CpuScopeRecorderTest::measurement() {
+    CpuScopeRecorder recorder{3};
+    FrameProfiler profiler{{
+        recorder.measurement("Physics", 2)
+    }, 5};
+    CORRADE_COMPARE(profiler.measurementName(0), "Physics");
+    CORRADE_COMPARE(profiler.measurementUnits(0), FrameProfiler::Units::Nanoseconds);
+    CORRADE_COMPARE(profiler.measurementDelay(0), 1);
+
+    /* Records of other scopes don't affect this one */
+    profiler.beginFrame();
+    recorder.record(0, 100);
+    recorder.record(2, 15);
+    recorder.record(1, 100);
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.measurementData(0, 0), 15);
+}
+
+void CpuScopeRecorderTest::measurementInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    CpuScopeRecorder recorder{2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    recorder.measurement("", 2);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::CpuScopeRecorder::measurement(): index 2 out of range for 2 scopes\n");
+}
+
+void CpuScopeRecorderTest::scope() {
+    CpuScopeRecorder recorder{2};
+    FrameProfiler profiler{{
+        recorder.measurement("", 1)
+    }, 5};
+
+    profiler.beginFrame();
+    {
+        CpuScopeRecorder::Scope scope{recorder, 1};
+        Utility::System::sleep(2);
+    }
+    profiler.endFrame();
+
+    /* Can't test upper bound because (especially on overloaded CIs) it all
+       takes a magnitude more than expected. Emscripten builds can have it
+       lower than expected, account for that. */
+    CORRADE_COMPARE_AS(profiler.measurementData(0, 0), UnsignedLong{1*1000*1000},
+        TestSuite::Compare::GreaterOrEqual);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::CpuScopeRecorderTest)
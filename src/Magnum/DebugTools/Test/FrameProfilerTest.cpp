@@ -26,6 +26,7 @@
 #include <sstream>
 #include <Corrade/Containers/Pointer.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
@@ -59,6 +60,11 @@ struct FrameProfilerTest: TestSuite::Tester {
     void dataNotAvailableYet();
     void meanNotAvailableYet();
 
+    void percentileMaxHistogram();
+    void percentileMaxHistogramNotAvailableYet();
+    void percentileInvalid();
+    void histogramInvalid();
+
     void statistics();
 
     #ifdef MAGNUM_TARGET_GL
@@ -133,6 +139,11 @@ FrameProfilerTest::FrameProfilerTest() {
               &FrameProfilerTest::dataNotAvailableYet,
               &FrameProfilerTest::meanNotAvailableYet,
 
+              &FrameProfilerTest::percentileMaxHistogram,
+              &FrameProfilerTest::percentileMaxHistogramNotAvailableYet,
+              &FrameProfilerTest::percentileInvalid,
+              &FrameProfilerTest::histogramInvalid,
+
               &FrameProfilerTest::statistics});
 
     #ifdef MAGNUM_TARGET_GL
@@ -855,12 +866,18 @@ void FrameProfilerTest::measurementOutOfBounds() {
     profiler.measurementDelay(2);
     profiler.measurementData(2, 0);
     profiler.measurementMean(2);
+    profiler.measurementPercentile(2, 50.0);
+    profiler.measurementMax(2);
+    profiler.measurementHistogram(2, 4, 0, 100);
     CORRADE_COMPARE(out.str(),
         "DebugTools::FrameProfiler::measurementName(): index 2 out of range for 2 measurements\n"
         "DebugTools::FrameProfiler::measurementUnits(): index 2 out of range for 2 measurements\n"
         "DebugTools::FrameProfiler::measurementDelay(): index 2 out of range for 2 measurements\n"
         "DebugTools::FrameProfiler::measurementData(): index 2 out of range for 2 measurements\n"
-        "DebugTools::FrameProfiler::measurementMean(): index 2 out of range for 2 measurements\n");
+        "DebugTools::FrameProfiler::measurementMean(): index 2 out of range for 2 measurements\n"
+        "DebugTools::FrameProfiler::measurementPercentile(): index 2 out of range for 2 measurements\n"
+        "DebugTools::FrameProfiler::measurementMax(): index 2 out of range for 2 measurements\n"
+        "DebugTools::FrameProfiler::measurementHistogram(): index 2 out of range for 2 measurements\n");
 }
 
 void FrameProfilerTest::frameOutOfBounds() {
@@ -979,6 +996,202 @@ void FrameProfilerTest::meanNotAvailableYet() {
         "DebugTools::FrameProfiler::measurementMean(): measurement data available after 2 more frames\n");
 }
 
+void FrameProfilerTest::percentileMaxHistogram() {
+    struct State {
+        UnsignedLong values[7]{30, 10, 50, 20, 40, 60, 5};
+        std::size_t current = 0;
+    } state;
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Nanoseconds,
+            [](void*) {},
+            [](void* state) {
+                State& s = *static_cast<State*>(state);
+                return s.values[s.current++];
+            }, &state}
+    }, 5};
+
+    profiler.beginFrame();
+    profiler.endFrame();
+    profiler.beginFrame();
+    profiler.endFrame();
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    /* No wraparound yet, only 30, 10 and 50 */
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 0.0), 10);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 50.0), 30);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 100.0), 50);
+    CORRADE_COMPARE(profiler.measurementMax(0), 50);
+
+    profiler.beginFrame();
+    profiler.endFrame();
+    profiler.beginFrame();
+    profiler.endFrame();
+    profiler.beginFrame();
+    profiler.endFrame();
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    /* Wrapped around, the first two values got dropped, leaving 5, 20, 40,
+       50 and 60 */
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 0.0), 5);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 20.0), 5);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 21.0), 20);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 50.0), 40);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 95.0), 60);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 99.0), 60);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 100.0), 60);
+    CORRADE_COMPARE(profiler.measurementMax(0), 60);
+
+    /* Values below and above the range go to the first and last bin */
+    const UnsignedInt expected[]{1, 1, 0, 3};
+    CORRADE_COMPARE_AS(profiler.measurementHistogram(0, 4, 10, 50),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+
+    const UnsignedInt expectedSingle[]{5};
+    CORRADE_COMPARE_AS(profiler.measurementHistogram(0, 1, 10, 50),
+        Containers::arrayView(expectedSingle),
+        TestSuite::Compare::Container);
+
+    /* Ranks that are exact integers shouldn't get rounded up due to floating
+       point imprecision, 14/100*50 is 7.000000000000001 */
+    {
+        UnsignedLong frame = 0;
+        FrameProfiler ranks{{
+            FrameProfiler::Measurement{"", FrameProfiler::Units::Count,
+                [](void*) {},
+                [](void* state) {
+                    return ++*static_cast<UnsignedLong*>(state);
+                }, &frame}
+        }, 50};
+        for(std::size_t i = 0; i != 50; ++i) {
+            ranks.beginFrame();
+            ranks.endFrame();
+        }
+
+        CORRADE_COMPARE(ranks.measurementPercentile(0, 14.0), 7);
+        CORRADE_COMPARE(ranks.measurementPercentile(0, 28.0), 14);
+        CORRADE_COMPARE(ranks.measurementPercentile(0, 56.0), 28);
+    }
+
+    /* Delayed measurements are stored from the beginning as well, but only
+       once the delay passes */
+    {
+        struct DelayedState {
+            UnsignedLong values[4]{30, 10, 50, 20};
+            std::size_t current = 0;
+        } delayedState;
+        FrameProfiler delayed{{
+            FrameProfiler::Measurement{"", FrameProfiler::Units::Count, 2,
+                [](void*, UnsignedInt) {},
+                [](void*, UnsignedInt) {},
+                [](void* state, UnsignedInt, UnsignedInt) {
+                    DelayedState& s = *static_cast<DelayedState*>(state);
+                    return s.values[s.current++];
+                }, &delayedState}
+        }, 3};
+        for(std::size_t i = 0; i != 3; ++i) {
+            delayed.beginFrame();
+            delayed.endFrame();
+        }
+
+        /* Three frames but only two values, 30 and 10 */
+        CORRADE_COMPARE(delayed.measurementPercentile(0, 0.0), 10);
+        CORRADE_COMPARE(delayed.measurementPercentile(0, 50.0), 10);
+        CORRADE_COMPARE(delayed.measurementPercentile(0, 100.0), 30);
+        CORRADE_COMPARE(delayed.measurementMax(0), 30);
+
+        delayed.beginFrame();
+        delayed.endFrame();
+        delayed.beginFrame();
+        delayed.endFrame();
+
+        /* Wrapped around, 30 got dropped, leaving 10, 20 and 50 */
+        CORRADE_COMPARE(delayed.measurementPercentile(0, 0.0), 10);
+        CORRADE_COMPARE(delayed.measurementPercentile(0, 50.0), 20);
+        CORRADE_COMPARE(delayed.measurementPercentile(0, 100.0), 50);
+        CORRADE_COMPARE(delayed.measurementMax(0), 50);
+
+        const UnsignedInt expectedDelayed[]{1, 1, 0, 1};
+        CORRADE_COMPARE_AS(delayed.measurementHistogram(0, 4, 0, 60),
+            Containers::arrayView(expectedDelayed),
+            TestSuite::Compare::Container);
+    }
+}
+
+void FrameProfilerTest::percentileMaxHistogramNotAvailableYet() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count, 3,
+            [](void*, UnsignedInt) {},
+            [](void*, UnsignedInt) {},
+            [](void*, UnsignedInt, UnsignedInt) { return UnsignedLong{}; }, nullptr},
+    }, 5};
+
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.measurementPercentile(0, 50.0);
+    profiler.measurementMax(0);
+    profiler.measurementHistogram(0, 4, 0, 100);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::FrameProfiler::measurementPercentile(): measurement data available after 2 more frames\n"
+        "DebugTools::FrameProfiler::measurementMax(): measurement data available after 2 more frames\n"
+        "DebugTools::FrameProfiler::measurementHistogram(): measurement data available after 2 more frames\n");
+}
+
+void FrameProfilerTest::percentileInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count,
+            [](void*) {},
+            [](void*) { return UnsignedLong{}; }, nullptr},
+    }, 3};
+
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.measurementPercentile(0, -0.5);
+    profiler.measurementPercentile(0, 100.5);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::FrameProfiler::measurementPercentile(): expected percentile to be in range [0, 100] but got -0.5\n"
+        "DebugTools::FrameProfiler::measurementPercentile(): expected percentile to be in range [0, 100] but got 100.5\n");
+}
+
+void FrameProfilerTest::histogramInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count,
+            [](void*) {},
+            [](void*) { return UnsignedLong{}; }, nullptr},
+    }, 3};
+
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.measurementHistogram(0, 0, 0, 100);
+    profiler.measurementHistogram(0, 4, 100, 100);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::FrameProfiler::measurementHistogram(): bin count can't be zero\n"
+        "DebugTools::FrameProfiler::measurementHistogram(): expected min to be less than max but got 100 and 100\n");
+}
+
 void FrameProfilerTest::statistics() {
     UnsignedLong time = 0;
     FrameProfiler profiler{{
@@ -1157,6 +1370,8 @@ void FrameProfilerTest::gl() {
         CORRADE_VERIFY(profiler.isMeasurementAvailable(GLFrameProfiler::Value::CpuDuration));
         CORRADE_COMPARE_AS(profiler.cpuDurationMean(), 0.50*1000*1000,
             TestSuite::Compare::GreaterOrEqual);
+        CORRADE_COMPARE_AS(Double(profiler.cpuDurationPercentile(100.0)), profiler.cpuDurationMean(),
+            TestSuite::Compare::GreaterOrEqual);
     }
 
     /* 3/4 frames took 1 ms, and one 10 ms, the ideal average is 3.25 ms. Can't
@@ -1166,6 +1381,10 @@ void FrameProfilerTest::gl() {
         CORRADE_VERIFY(profiler.isMeasurementAvailable(GLFrameProfiler::Value::FrameTime));
         CORRADE_COMPARE_AS(profiler.frameTimeMean(), 3.20*1000*1000,
             TestSuite::Compare::GreaterOrEqual);
+        /* The 10 ms frame is the slowest one, again accounting for
+           Emscripten */
+        CORRADE_COMPARE_AS(Double(profiler.frameTimePercentile(100.0)), 5.0*1000*1000,
+            TestSuite::Compare::GreaterOrEqual);
     }
 
     /* GPU time tested separately */
@@ -1184,11 +1403,17 @@ void FrameProfilerTest::glNotEnabled() {
     profiler.frameTimeMean();
     profiler.cpuDurationMean();
     profiler.gpuDurationMean();
+    profiler.frameTimePercentile(50.0);
+    profiler.cpuDurationPercentile(50.0);
+    profiler.gpuDurationPercentile(50.0);
     CORRADE_COMPARE(out.str(),
         "DebugTools::GLFrameProfiler::isMeasurementAvailable(): DebugTools::GLFrameProfiler::Value::CpuDuration not enabled\n"
         "DebugTools::GLFrameProfiler::frameTimeMean(): not enabled\n"
         "DebugTools::GLFrameProfiler::cpuDurationMean(): not enabled\n"
-        "DebugTools::GLFrameProfiler::gpuDurationMean(): not enabled\n");
+        "DebugTools::GLFrameProfiler::gpuDurationMean(): not enabled\n"
+        "DebugTools::GLFrameProfiler::frameTimePercentile(): not enabled\n"
+        "DebugTools::GLFrameProfiler::cpuDurationPercentile(): not enabled\n"
+        "DebugTools::GLFrameProfiler::gpuDurationPercentile(): not enabled\n");
 }
 #endif
 
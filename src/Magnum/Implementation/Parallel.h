@@ -0,0 +1,90 @@
+#ifndef Magnum_Implementation_Parallel_h
+#define Magnum_Implementation_Parallel_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <Corrade/configure.h>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <atomic>
+#include <thread>
+#include <vector>
+#endif
+
+#include "Magnum/Magnum.h"
+
+namespace Magnum { namespace Implementation {
+
+/* Zero means as many threads as there are cores. Threads are not generally
+   available on Emscripten, so everything is done on the calling thread
+   there. */
+inline UnsignedInt resolveThreadCount(UnsignedInt threadCount) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    /* hardware_concurrency() is allowed to return 0 if it can't tell */
+    if(!threadCount) threadCount = 1;
+    return threadCount;
+    #else
+    static_cast<void>(threadCount);
+    return 1;
+    #endif
+}
+
+/* Calls work(begin, end) for consecutive ranges of [0, count), each
+   chunkSize items except for the last one. The ranges are distributed among
+   up to threadCount threads, the calling thread being one of them. The split
+   doesn't depend on the thread count, so the same ranges are processed even
+   if it's all done on the calling thread. */
+template<class F> void parallelFor(const std::size_t count, const std::size_t chunkSize, UnsignedInt threadCount, const F& work) {
+    const std::size_t chunkCount = (count + chunkSize - 1)/chunkSize;
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* The ranges are all the same size, so simply handing out the next one to
+       whichever thread asks is enough */
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for(std::size_t i; (i = next++) < chunkCount; )
+            work(i*chunkSize, i + 1 == chunkCount ? count : (i + 1)*chunkSize);
+    };
+
+    /* No need to spawn more threads than there are chunks */
+    if(std::size_t(threadCount) > chunkCount) threadCount = UnsignedInt(chunkCount);
+    std::vector<std::thread> threads;
+    if(threadCount > 1) threads.reserve(threadCount - 1);
+    for(UnsignedInt i = 1; i < threadCount; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for(std::thread& thread: threads) thread.join();
+    #else
+    static_cast<void>(threadCount);
+    for(std::size_t i = 0; i != chunkCount; ++i)
+        work(i*chunkSize, i + 1 == chunkCount ? count : (i + 1)*chunkSize);
+    #endif
+}
+
+}}
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef Magnum_Implementation_ThreadBuffers_h
+#define Magnum_Implementation_ThreadBuffers_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Macros.h>
+
+#include "Magnum/Magnum.h"
+
+namespace Magnum { namespace Implementation {
+
+/* Per-thread buffers used by Tracer and DebugTools::CpuScopeRecorder. Each
+   thread gets its own buffer on first use. A thread then finds it through a
+   thread-local cache of the four instances it used most recently, so the lock
+   is taken only when a thread uses given instance for the first time or when
+   it got evicted from the cache because the thread used four others since.
+   The buffer list only grows, buffers are destroyed with the instance. */
+template<class T> class ThreadBuffers {
+    public:
+        explicit ThreadBuffers(): _id{++counter()} {}
+
+        /* Buffer of the calling thread, constructed from args if the thread
+           doesn't have one yet. The prefix is used in assertion messages. */
+        template<class ...Args> T& get(const char* prefix, Args&&... args);
+
+        std::size_t size() const {
+            std::lock_guard<std::mutex> lock{_mutex};
+            return _buffers.size();
+        }
+
+        /* Calls f(buffer, index) on all buffers with the lock held. The index
+           is the order in which the threads got their buffers. */
+        template<class F> void forEach(F&& f) {
+            std::lock_guard<std::mutex> lock{_mutex};
+            for(std::size_t i = 0; i != _buffers.size(); ++i)
+                f(*_buffers[i].buffer, i);
+        }
+        template<class F> void forEach(F&& f) const {
+            std::lock_guard<std::mutex> lock{_mutex};
+            for(std::size_t i = 0; i != _buffers.size(); ++i)
+                f(*_buffers[i].buffer, i);
+        }
+
+    private:
+        struct Entry {
+            std::thread::id thread;
+            Containers::Pointer<T> buffer;
+        };
+
+        /* Used to tell instances apart in the thread-local cache. Not using
+           the instance pointer as a new instance could get allocated at the
+           same address as a previously destroyed one. IDs are never reused,
+           so cache entries of destroyed instances never match. */
+        static std::atomic<std::size_t>& counter() {
+            static std::atomic<std::size_t> counter{0};
+            return counter;
+        }
+
+        std::size_t _id;
+        /* Guards the buffer list. The buffers themselves are never accessed
+           under the lock from the recording side. */
+        mutable std::mutex _mutex;
+        std::vector<Entry> _buffers;
+};
+
+template<class T> template<class ...Args> T& ThreadBuffers<T>::get(const char* const prefix, Args&&... args) {
+    struct CacheEntry {
+        std::size_t id;
+        T* buffer;
+    };
+    struct Cache {
+        CacheEntry entries[4];
+        std::size_t next;
+        #ifndef CORRADE_BUILD_MULTITHREADED
+        std::thread::id thread;
+        #endif
+    };
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    CORRADE_THREAD_LOCAL
+    #endif
+    static Cache cache{};
+    static_cast<void>(prefix);
+
+    /* Without thread-local storage the cache is shared by all threads, which
+       would make them write into each other's single-producer buffers. The
+       first entry is always filled once the thread is set, return that to
+       have something to return in case of graceful asserts. */
+    #ifndef CORRADE_BUILD_MULTITHREADED
+    const std::thread::id thread = std::this_thread::get_id();
+    CORRADE_ASSERT(cache.thread == std::thread::id{} || cache.thread == thread,
+        prefix << "recording from multiple threads requires Corrade built with CORRADE_BUILD_MULTITHREADED", *cache.entries[0].buffer);
+    #endif
+
+    for(const CacheEntry& entry: cache.entries)
+        if(entry.id == _id) return *entry.buffer;
+
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    const std::thread::id thread = std::this_thread::get_id();
+    #endif
+
+    /* Otherwise find a buffer this thread used before or create a new one */
+    T* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        for(Entry& i: _buffers) {
+            if(i.thread != thread) continue;
+            buffer = i.buffer.get();
+            break;
+        }
+        if(!buffer) {
+            _buffers.push_back(Entry{thread, Containers::Pointer<T>{Containers::InPlaceInit, std::forward<Args>(args)...}});
+            buffer = _buffers.back().buffer.get();
+        }
+    }
+
+    /* Replace the oldest entry */
+    cache.entries[cache.next] = CacheEntry{_id, buffer};
+    cache.next = (cache.next + 1) % Containers::arraySize(cache.entries);
+    #ifndef CORRADE_BUILD_MULTITHREADED
+    cache.thread = thread;
+    #endif
+    return *buffer;
+}
+
+}}
+
+#endif
@@ -76,6 +76,18 @@ Enabled by default in a static build.
 #define MAGNUM_BUILD_STATIC_UNIQUE_GLOBALS
 #undef MAGNUM_BUILD_STATIC_UNIQUE_GLOBALS
 
+/**
+@brief Build with tracing zones included
+@m_since_latest
+
+Defined if the library is built with @ref MAGNUM_TRACE_ZONE() expanding to
+@ref Tracer::Zone instances. If not defined, the macro compiles to nothing.
+Disabled by default.
+@see @ref building, @ref cmake
+*/
+#define MAGNUM_BUILD_TRACING
+#undef MAGNUM_BUILD_TRACING
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /** @brief Multi-threaded build
  * @m_deprecated_since{2019,10} Use @ref CORRADE_BUILD_MULTITHREADED instead.
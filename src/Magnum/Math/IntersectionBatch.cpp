@@ -0,0 +1,276 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "IntersectionBatch.h"
+
+#include <algorithm>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+
+/* CORRADE_TARGET_SSE2 is provided by Corrade, there's no equivalent for AVX
+   so checking the compiler macro directly */
+#ifdef __AVX__
+#include <immintrin.h>
+#elif defined(CORRADE_TARGET_SSE2)
+#include <xmmintrin.h>
+#endif
+
+namespace Magnum { namespace Math { namespace Intersection {
+
+namespace {
+
+/* Eight boxes in a SoA layout. For ranges, the center and extent is doubled
+   to avoid a division, same as in rangeFrustum(). */
+struct Boxes {
+    Float centerX[8], centerY[8], centerZ[8];
+    Float extentX[8], extentY[8], extentZ[8];
+};
+
+/* Eight spheres in a SoA layout */
+struct Spheres {
+    Float centerX[8], centerY[8], centerZ[8];
+    Float radiusSq[8];
+};
+
+/* The kernels below return a bit set for each item that's not completely
+   outside of any plane. The operations and their order match the
+   single-object functions so the results are the same in all cases, in
+   particular the comparison is done as "not less than" so NaNs result in the
+   item being treated as visible, same as there. */
+
+#ifdef __AVX__
+UnsignedByte boxesFrustum(const Boxes& boxes, const Frustum<Float>& frustum, const Float wScale) {
+    const __m256 centerX = _mm256_loadu_ps(boxes.centerX);
+    const __m256 centerY = _mm256_loadu_ps(boxes.centerY);
+    const __m256 centerZ = _mm256_loadu_ps(boxes.centerZ);
+    const __m256 extentX = _mm256_loadu_ps(boxes.extentX);
+    const __m256 extentY = _mm256_loadu_ps(boxes.extentY);
+    const __m256 extentZ = _mm256_loadu_ps(boxes.extentZ);
+
+    __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for(const Vector4<Float>& plane: frustum) {
+        const Vector3<Float> absNormal = Math::abs(plane.xyz());
+        const __m256 d = _mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(centerX, _mm256_set1_ps(plane.x())),
+            _mm256_mul_ps(centerY, _mm256_set1_ps(plane.y()))),
+            _mm256_mul_ps(centerZ, _mm256_set1_ps(plane.z())));
+        const __m256 r = _mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(extentX, _mm256_set1_ps(absNormal.x())),
+            _mm256_mul_ps(extentY, _mm256_set1_ps(absNormal.y()))),
+            _mm256_mul_ps(extentZ, _mm256_set1_ps(absNormal.z())));
+        visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(d, r),
+            _mm256_set1_ps(-wScale*plane.w()), _CMP_NLT_UQ));
+    }
+
+    return UnsignedByte(_mm256_movemask_ps(visible));
+}
+
+UnsignedByte spheresFrustum(const Spheres& spheres, const Frustum<Float>& frustum) {
+    const __m256 centerX = _mm256_loadu_ps(spheres.centerX);
+    const __m256 centerY = _mm256_loadu_ps(spheres.centerY);
+    const __m256 centerZ = _mm256_loadu_ps(spheres.centerZ);
+    const __m256 minusRadiusSq = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(spheres.radiusSq));
+
+    __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for(const Vector4<Float>& plane: frustum) {
+        const __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(centerX, _mm256_set1_ps(plane.x())),
+            _mm256_mul_ps(centerY, _mm256_set1_ps(plane.y()))),
+            _mm256_mul_ps(centerZ, _mm256_set1_ps(plane.z()))),
+            _mm256_set1_ps(plane.w()));
+        visible = _mm256_and_ps(visible, _mm256_cmp_ps(d, minusRadiusSq, _CMP_NLT_UQ));
+    }
+
+    return UnsignedByte(_mm256_movemask_ps(visible));
+}
+#elif defined(CORRADE_TARGET_SSE2)
+/* Processes four items starting at given offset, called twice for a whole
+   block */
+UnsignedByte boxesFrustum4(const Boxes& boxes, const std::size_t offset, const Frustum<Float>& frustum, const Float wScale) {
+    const __m128 centerX = _mm_loadu_ps(boxes.centerX + offset);
+    const __m128 centerY = _mm_loadu_ps(boxes.centerY + offset);
+    const __m128 centerZ = _mm_loadu_ps(boxes.centerZ + offset);
+    const __m128 extentX = _mm_loadu_ps(boxes.extentX + offset);
+    const __m128 extentY = _mm_loadu_ps(boxes.extentY + offset);
+    const __m128 extentZ = _mm_loadu_ps(boxes.extentZ + offset);
+
+    __m128 visible = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+    for(const Vector4<Float>& plane: frustum) {
+        const Vector3<Float> absNormal = Math::abs(plane.xyz());
+        const __m128 d = _mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(centerX, _mm_set1_ps(plane.x())),
+            _mm_mul_ps(centerY, _mm_set1_ps(plane.y()))),
+            _mm_mul_ps(centerZ, _mm_set1_ps(plane.z())));
+        const __m128 r = _mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(extentX, _mm_set1_ps(absNormal.x())),
+            _mm_mul_ps(extentY, _mm_set1_ps(absNormal.y()))),
+            _mm_mul_ps(extentZ, _mm_set1_ps(absNormal.z())));
+        visible = _mm_and_ps(visible, _mm_cmpnlt_ps(_mm_add_ps(d, r),
+            _mm_set1_ps(-wScale*plane.w())));
+    }
+
+    return UnsignedByte(_mm_movemask_ps(visible));
+}
+
+UnsignedByte boxesFrustum(const Boxes& boxes, const Frustum<Float>& frustum, const Float wScale) {
+    return UnsignedByte(boxesFrustum4(boxes, 0, frustum, wScale)|
+                        boxesFrustum4(boxes, 4, frustum, wScale) << 4);
+}
+
+UnsignedByte spheresFrustum4(const Spheres& spheres, const std::size_t offset, const Frustum<Float>& frustum) {
+    const __m128 centerX = _mm_loadu_ps(spheres.centerX + offset);
+    const __m128 centerY = _mm_loadu_ps(spheres.centerY + offset);
+    const __m128 centerZ = _mm_loadu_ps(spheres.centerZ + offset);
+    const __m128 minusRadiusSq = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(spheres.radiusSq + offset));
+
+    __m128 visible = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+    for(const Vector4<Float>& plane: frustum) {
+        const __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(centerX, _mm_set1_ps(plane.x())),
+            _mm_mul_ps(centerY, _mm_set1_ps(plane.y()))),
+            _mm_mul_ps(centerZ, _mm_set1_ps(plane.z()))),
+            _mm_set1_ps(plane.w()));
+        visible = _mm_and_ps(visible, _mm_cmpnlt_ps(d, minusRadiusSq));
+    }
+
+    return UnsignedByte(_mm_movemask_ps(visible));
+}
+
+UnsignedByte spheresFrustum(const Spheres& spheres, const Frustum<Float>& frustum) {
+    return UnsignedByte(spheresFrustum4(spheres, 0, frustum)|
+                        spheresFrustum4(spheres, 4, frustum) << 4);
+}
+#else
+UnsignedByte boxesFrustum(const Boxes& boxes, const Frustum<Float>& frustum, const Float wScale) {
+    UnsignedByte visible = 0xff;
+    for(const Vector4<Float>& plane: frustum) {
+        const Vector3<Float> absNormal = Math::abs(plane.xyz());
+        const Float minusW = -wScale*plane.w();
+        for(std::size_t i = 0; i != 8; ++i) {
+            const Float d = boxes.centerX[i]*plane.x() + boxes.centerY[i]*plane.y() + boxes.centerZ[i]*plane.z();
+            const Float r = boxes.extentX[i]*absNormal.x() + boxes.extentY[i]*absNormal.y() + boxes.extentZ[i]*absNormal.z();
+            if(d + r < minusW) visible &= ~(1 << i);
+        }
+    }
+
+    return visible;
+}
+
+UnsignedByte spheresFrustum(const Spheres& spheres, const Frustum<Float>& frustum) {
+    UnsignedByte visible = 0xff;
+    for(const Vector4<Float>& plane: frustum) {
+        for(std::size_t i = 0; i != 8; ++i) {
+            const Float d = spheres.centerX[i]*plane.x() + spheres.centerY[i]*plane.y() + spheres.centerZ[i]*plane.z() + plane.w();
+            if(d < -spheres.radiusSq[i]) visible &= ~(1 << i);
+        }
+    }
+
+    return visible;
+}
+#endif
+
+/* Mask for the last, possibly incomplete block */
+inline UnsignedByte blockMask(const std::size_t count) {
+    return UnsignedByte((1u << count) - 1);
+}
+
+}
+
+void rangeFrustumInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedByte>& visibility) {
+    CORRADE_ASSERT(visibility.size() == (ranges.size() + 7)/8,
+        "Math::Intersection::rangeFrustumInto(): expected" << (ranges.size() + 7)/8 << "bytes for" << ranges.size() << "ranges but got" << visibility.size(), );
+
+    /* In the last block, items past the end keep values from the previous
+       block (or zeros), the bits corresponding to them are masked away */
+    Boxes boxes{};
+    for(std::size_t i = 0; i < ranges.size(); i += 8) {
+        const std::size_t count = std::min(ranges.size() - i, std::size_t{8});
+        for(std::size_t j = 0; j != count; ++j) {
+            const Range3D<Float>& range = ranges[i + j];
+            const Vector3<Float> center = range.min() + range.max();
+            const Vector3<Float> extent = range.max() - range.min();
+            boxes.centerX[j] = center.x();
+            boxes.centerY[j] = center.y();
+            boxes.centerZ[j] = center.z();
+            boxes.extentX[j] = extent.x();
+            boxes.extentY[j] = extent.y();
+            boxes.extentZ[j] = extent.z();
+        }
+
+        visibility[i/8] = boxesFrustum(boxes, frustum, 2.0f) & blockMask(count);
+    }
+}
+
+void aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedByte>& visibility) {
+    CORRADE_ASSERT(aabbExtents.size() == aabbCenters.size(),
+        "Math::Intersection::aabbFrustumInto(): expected" << aabbCenters.size() << "extents but got" << aabbExtents.size(), );
+    CORRADE_ASSERT(visibility.size() == (aabbCenters.size() + 7)/8,
+        "Math::Intersection::aabbFrustumInto(): expected" << (aabbCenters.size() + 7)/8 << "bytes for" << aabbCenters.size() << "boxes but got" << visibility.size(), );
+
+    Boxes boxes{};
+    for(std::size_t i = 0; i < aabbCenters.size(); i += 8) {
+        const std::size_t count = std::min(aabbCenters.size() - i, std::size_t{8});
+        for(std::size_t j = 0; j != count; ++j) {
+            const Vector3<Float>& center = aabbCenters[i + j];
+            const Vector3<Float>& extent = aabbExtents[i + j];
+            boxes.centerX[j] = center.x();
+            boxes.centerY[j] = center.y();
+            boxes.centerZ[j] = center.z();
+            boxes.extentX[j] = extent.x();
+            boxes.extentY[j] = extent.y();
+            boxes.extentZ[j] = extent.z();
+        }
+
+        visibility[i/8] = boxesFrustum(boxes, frustum, 1.0f) & blockMask(count);
+    }
+}
+
+void sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedByte>& visibility) {
+    CORRADE_ASSERT(sphereRadii.size() == sphereCenters.size(),
+        "Math::Intersection::sphereFrustumInto(): expected" << sphereCenters.size() << "radii but got" << sphereRadii.size(), );
+    CORRADE_ASSERT(visibility.size() == (sphereCenters.size() + 7)/8,
+        "Math::Intersection::sphereFrustumInto(): expected" << (sphereCenters.size() + 7)/8 << "bytes for" << sphereCenters.size() << "spheres but got" << visibility.size(), );
+
+    Spheres spheres{};
+    for(std::size_t i = 0; i < sphereCenters.size(); i += 8) {
+        const std::size_t count = std::min(sphereCenters.size() - i, std::size_t{8});
+        for(std::size_t j = 0; j != count; ++j) {
+            const Vector3<Float>& center = sphereCenters[i + j];
+            spheres.centerX[j] = center.x();
+            spheres.centerY[j] = center.y();
+            spheres.centerZ[j] = center.z();
+            spheres.radiusSq[j] = sphereRadii[i + j]*sphereRadii[i + j];
+        }
+
+        visibility[i/8] = spheresFrustum(spheres, frustum) & blockMask(count);
+    }
+}
+
+}}}
@@ -0,0 +1,109 @@
+#ifndef Magnum_Math_IntersectionBatch_h
+#define Magnum_Math_IntersectionBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Intersection::rangeFrustumInto(), @ref Magnum::Math::Intersection::aabbFrustumInto(), @ref Magnum::Math::Intersection::sphereFrustumInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Math.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math { namespace Intersection {
+
+/**
+@{ @name Batch intersection functions
+
+These functions test an unbounded range of objects against a single frustum,
+as opposed to the single-object functions in @ref Magnum/Math/Intersection.h.
+The results are written into a bitmask, with bit @cpp i%8 @ce of byte
+@cpp i/8 @ce set if the @cpp i @ce-th object intersects the frustum, which is
+the same layout as used by @ref BoolVector. Bits in the last byte that don't
+correspond to any object are set to @cpp 0 @ce.
+
+The input is gathered into blocks of eight objects and then tested against
+each plane all at once. If the library is compiled with AVX enabled, a whole
+block is tested with a single instruction per operation, on SSE2 the block is
+processed in two halves and on other platforms a plain loop is used. The
+result is the same as with calling the single-object variant on each item.
+*/
+
+/**
+@brief Intersection of ranges and a frustum
+@param[in]  ranges      Ranges
+@param[in]  frustum     Frustum planes with normals pointing outwards
+@param[out] visibility  Bitmask with bits set for ranges that intersect the
+    frustum
+@m_since_latest
+
+Batch variant of @ref rangeFrustum(). Expects that @p visibility has
+@cpp (ranges.size() + 7)/8 @ce bytes.
+*/
+MAGNUM_EXPORT void rangeFrustumInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedByte>& visibility);
+
+/**
+@brief Intersection of axis-aligned boxes and a frustum
+@param[in]  aabbCenters Centers of the AABBs
+@param[in]  aabbExtents (Half-)extents of the AABBs
+@param[in]  frustum     Frustum planes with normals pointing outwards
+@param[out] visibility  Bitmask with bits set for boxes that intersect the
+    frustum
+@m_since_latest
+
+Batch variant of @ref aabbFrustum(). Expects that @p aabbCenters and
+@p aabbExtents have the same size and that @p visibility has
+@cpp (aabbCenters.size() + 7)/8 @ce bytes.
+*/
+MAGNUM_EXPORT void aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedByte>& visibility);
+
+/**
+@brief Intersection of spheres and a frustum
+@param[in]  sphereCenters   Sphere centers
+@param[in]  sphereRadii     Sphere radii
+@param[in]  frustum         Frustum planes with normals pointing outwards
+@param[out] visibility      Bitmask with bits set for spheres that intersect
+    the frustum
+@m_since_latest
+
+Batch variant of @ref sphereFrustum(). Expects that @p sphereCenters and
+@p sphereRadii have the same size and that @p visibility has
+@cpp (sphereCenters.size() + 7)/8 @ce bytes.
+*/
+MAGNUM_EXPORT void sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedByte>& visibility);
+
+/* Since 1.8.17, the original short-hand group closing doesn't work anymore.
+   FFS. */
+/**
+ * @}
+ */
+
+}}}
+
+#endif
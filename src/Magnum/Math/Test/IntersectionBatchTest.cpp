@@ -0,0 +1,330 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct IntersectionBatchTest: Corrade::TestSuite::Tester {
+    explicit IntersectionBatchTest();
+
+    void rangeFrustum();
+    void aabbFrustum();
+    void sphereFrustum();
+
+    void rangeFrustumRandom();
+    void aabbFrustumRandom();
+    void sphereFrustumRandom();
+
+    void rangeFrustumWrongSize();
+    void aabbFrustumWrongSize();
+    void sphereFrustumWrongSize();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Frustum<Float> Frustum;
+typedef Math::Range3D<Float> Range3D;
+typedef Math::Deg<Float> Deg;
+
+const struct {
+    const char* name;
+    std::size_t count;
+} RandomData[]{
+    {"empty", 0},
+    {"one", 1},
+    {"incomplete block", 7},
+    {"one block", 8},
+    {"one block and one item", 9},
+    {"many blocks", 1003}
+};
+
+IntersectionBatchTest::IntersectionBatchTest() {
+    addTests({&IntersectionBatchTest::rangeFrustum,
+              &IntersectionBatchTest::aabbFrustum,
+              &IntersectionBatchTest::sphereFrustum});
+
+    addInstancedTests({&IntersectionBatchTest::rangeFrustumRandom,
+                       &IntersectionBatchTest::aabbFrustumRandom,
+                       &IntersectionBatchTest::sphereFrustumRandom},
+        Corrade::Containers::arraySize(RandomData));
+
+    addTests({&IntersectionBatchTest::rangeFrustumWrongSize,
+              &IntersectionBatchTest::aabbFrustumWrongSize,
+              &IntersectionBatchTest::sphereFrustumWrongSize});
+}
+
+/* Same as in IntersectionTest */
+const Frustum BoxFrustum{
+    {1.0f, 0.0f, 0.0f, 0.0f},
+    {-1.0f, 0.0f, 0.0f, 5.0f},
+    {0.0f, 1.0f, 0.0f, 0.0f},
+    {0.0f, -1.0f, 0.0f, 1.0f},
+    {0.0f, 0.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, -1.0f, 10.0f}};
+
+void IntersectionBatchTest::rangeFrustum() {
+    /* Interleaved with other data to test strided input */
+    struct Item {
+        Range3D range;
+        Int other;
+    } items[]{
+        {{Vector3{1.0f}, Vector3{2.0f}}, 0},
+        {{Vector3{-10.0f}, Vector3{-5.0f}}, 0},
+        {Range3D::fromSize({2.4f, -0.1f, 4.9f}, Vector3{0.2f}), 0},
+        {Range3D::fromSize({2.4f, 0.9f, 4.9f}, Vector3{0.2f}), 0},
+        {Range3D::fromSize({-0.1f, 0.4f, 4.9f}, Vector3{0.2f}), 0},
+        {Range3D::fromSize({-1.1f, 0.4f, 4.9f}, Vector3{0.2f}), 0},
+        {Range3D::fromSize({4.9f, 0.4f, 4.9f}, Vector3{0.2f}), 0},
+        {Range3D::fromSize({2.4f, 0.4f, -0.1f}, Vector3{0.2f}), 0},
+        {Range3D::fromSize({2.4f, 0.4f, 9.9f}, Vector3{0.2f}), 0},
+        {{Vector3{-100.0f}, Vector3{100.0f}}, 0},
+        {Range3D::fromSize({2.4f, 0.4f, 10.9f}, Vector3{0.2f}), 0}
+    };
+
+    UnsignedByte visibility[2]{0xff, 0xff};
+    Intersection::rangeFrustumInto(
+        Corrade::Containers::StridedArrayView1D<const Range3D>{items,
+            &items[0].range, Corrade::Containers::arraySize(items),
+            sizeof(Item)},
+        BoxFrustum, visibility);
+    /* Items 1, 5 and 10 are outside, the unused bits are zero */
+    CORRADE_COMPARE(Int(visibility[0]), 0xdd);
+    CORRADE_COMPARE(Int(visibility[1]), 0x03);
+}
+
+void IntersectionBatchTest::aabbFrustum() {
+    const Vector3 centers[]{
+        Vector3{0.0f},
+        {2.5f, 0.0f, 5.0f},
+        {2.5f, -1.0f, 5.0f},
+        {0.0f, 0.5f, 5.0f},
+        {5.0f, 0.5f, 5.0f},
+        {2.5f, 0.5f, 0.0f},
+        {2.5f, 0.5f, -1.0f},
+        {2.5f, 0.5f, 10.0f},
+        Vector3{0.0f},
+        Vector3{-7.5f}
+    };
+    const Vector3 extents[]{
+        Vector3{1.0f},
+        Vector3{0.1f},
+        Vector3{0.1f},
+        Vector3{0.1f},
+        Vector3{0.1f},
+        Vector3{0.1f},
+        Vector3{0.1f},
+        Vector3{0.1f},
+        Vector3{100.0f},
+        Vector3{2.5f}
+    };
+
+    UnsignedByte visibility[2];
+    Intersection::aabbFrustumInto(centers, extents, BoxFrustum, visibility);
+    /* Items 2, 6 and 9 are outside */
+    CORRADE_COMPARE(Int(visibility[0]), 0xbb);
+    CORRADE_COMPARE(Int(visibility[1]), 0x01);
+}
+
+void IntersectionBatchTest::sphereFrustum() {
+    const Vector3 centers[]{
+        {1.0f, 0.5f, 5.0f},
+        {-2.0f, 0.5f, 5.0f},
+        {-1.0f, 0.5f, 5.0f},
+        {2.5f, 0.5f, 20.0f}
+    };
+    const Float radii[]{0.5f, 1.0f, 1.5f, 100.0f};
+
+    UnsignedByte visibility[1];
+    Intersection::sphereFrustumInto(centers, radii, BoxFrustum, visibility);
+    /* Item 1 is outside */
+    CORRADE_COMPARE(Int(visibility[0]), 0x0d);
+}
+
+/* The batch results should be exactly the same as with the single-object
+   functions, including the values around plane boundaries, so testing on a
+   larger amount of random data that's partially inside and partially
+   outside */
+struct RandomBoxes {
+    std::vector<Range3D> ranges;
+    std::vector<Vector3> centers, extents;
+    std::vector<Float> radii;
+    Frustum frustum;
+};
+
+RandomBoxes randomBoxes(std::size_t count) {
+    RandomBoxes out;
+    std::mt19937 g{17};
+    std::uniform_real_distribution<Float> pd{-10.0f, 10.0f};
+    std::uniform_real_distribution<Float> sd{0.0f, 3.0f};
+
+    out.frustum = Frustum::fromMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 8.0f)*Matrix4::translation({0.5f, -1.0f, -4.0f}));
+    for(std::size_t i = 0; i != count; ++i) {
+        const Vector3 center{pd(g), pd(g), pd(g)};
+        const Vector3 extent{sd(g), sd(g), sd(g)};
+        out.ranges.emplace_back(center - extent, center + extent);
+        out.centers.push_back(center);
+        out.extents.push_back(extent);
+        out.radii.push_back(extent.x());
+    }
+
+    return out;
+}
+
+std::vector<UnsignedByte> expectedBits(const std::vector<bool>& visible) {
+    std::vector<UnsignedByte> out((visible.size() + 7)/8);
+    for(std::size_t i = 0; i != visible.size(); ++i)
+        if(visible[i]) out[i/8] |= 1 << (i%8);
+    return out;
+}
+
+void IntersectionBatchTest::rangeFrustumRandom() {
+    auto&& data = RandomData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    RandomBoxes boxes = randomBoxes(data.count);
+    std::vector<bool> expected;
+    for(const Range3D& range: boxes.ranges)
+        expected.push_back(Intersection::rangeFrustum(range, boxes.frustum));
+
+    std::vector<UnsignedByte> visibility((data.count + 7)/8);
+    Intersection::rangeFrustumInto(
+        Corrade::Containers::arrayView(boxes.ranges.data(), boxes.ranges.size()),
+        boxes.frustum,
+        Corrade::Containers::arrayView(visibility.data(), visibility.size()));
+    CORRADE_COMPARE_AS(visibility, expectedBits(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void IntersectionBatchTest::aabbFrustumRandom() {
+    auto&& data = RandomData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    RandomBoxes boxes = randomBoxes(data.count);
+    std::vector<bool> expected;
+    for(std::size_t i = 0; i != data.count; ++i)
+        expected.push_back(Intersection::aabbFrustum(boxes.centers[i], boxes.extents[i], boxes.frustum));
+
+    std::vector<UnsignedByte> visibility((data.count + 7)/8);
+    Intersection::aabbFrustumInto(
+        Corrade::Containers::arrayView(boxes.centers.data(), boxes.centers.size()),
+        Corrade::Containers::arrayView(boxes.extents.data(), boxes.extents.size()),
+        boxes.frustum,
+        Corrade::Containers::arrayView(visibility.data(), visibility.size()));
+    CORRADE_COMPARE_AS(visibility, expectedBits(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void IntersectionBatchTest::sphereFrustumRandom() {
+    auto&& data = RandomData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    RandomBoxes boxes = randomBoxes(data.count);
+    std::vector<bool> expected;
+    for(std::size_t i = 0; i != data.count; ++i)
+        expected.push_back(Intersection::sphereFrustum(boxes.centers[i], boxes.radii[i], boxes.frustum));
+
+    std::vector<UnsignedByte> visibility((data.count + 7)/8);
+    Intersection::sphereFrustumInto(
+        Corrade::Containers::arrayView(boxes.centers.data(), boxes.centers.size()),
+        Corrade::Containers::arrayView(boxes.radii.data(), boxes.radii.size()),
+        boxes.frustum,
+        Corrade::Containers::arrayView(visibility.data(), visibility.size()));
+    CORRADE_COMPARE_AS(visibility, expectedBits(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void IntersectionBatchTest::rangeFrustumWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Range3D ranges[9];
+    UnsignedByte visibility[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Intersection::rangeFrustumInto(ranges, BoxFrustum,
+        Corrade::Containers::arrayView(visibility).prefix(1));
+    Intersection::rangeFrustumInto(ranges, BoxFrustum, visibility);
+    CORRADE_COMPARE(out.str(),
+        "Math::Intersection::rangeFrustumInto(): expected 2 bytes for 9 ranges but got 1\n"
+        "Math::Intersection::rangeFrustumInto(): expected 2 bytes for 9 ranges but got 3\n");
+}
+
+void IntersectionBatchTest::aabbFrustumWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vector3 centers[9];
+    Vector3 extents[8];
+    UnsignedByte visibility[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Intersection::aabbFrustumInto(centers, extents, BoxFrustum, visibility);
+    Intersection::aabbFrustumInto(
+        Corrade::Containers::arrayView(centers).prefix(8), extents,
+        BoxFrustum, visibility);
+    CORRADE_COMPARE(out.str(),
+        "Math::Intersection::aabbFrustumInto(): expected 9 extents but got 8\n"
+        "Math::Intersection::aabbFrustumInto(): expected 1 bytes for 8 boxes but got 2\n");
+}
+
+void IntersectionBatchTest::sphereFrustumWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vector3 centers[9];
+    Float radii[8];
+    UnsignedByte visibility[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Intersection::sphereFrustumInto(centers, radii, BoxFrustum, visibility);
+    Intersection::sphereFrustumInto(
+        Corrade::Containers::arrayView(centers).prefix(8), radii,
+        BoxFrustum, Corrade::Containers::arrayView(visibility).prefix(0));
+    CORRADE_COMPARE(out.str(),
+        "Math::Intersection::sphereFrustumInto(): expected 9 radii but got 8\n"
+        "Math::Intersection::sphereFrustumInto(): expected 1 bytes for 8 spheres but got 0\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::IntersectionBatchTest)
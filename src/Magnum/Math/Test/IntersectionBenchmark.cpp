@@ -26,10 +26,13 @@
 
 #include <random>
 #include <utility>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Angle.h"
 #include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -111,6 +114,13 @@ struct IntersectionBenchmark: Corrade::TestSuite::Tester {
     void sphereCone();
     void sphereConeView();
 
+    void rangeFrustumMillion();
+    void rangeFrustumIntoMillion();
+    void aabbFrustumMillion();
+    void aabbFrustumIntoMillion();
+    void sphereFrustumMillion();
+    void sphereFrustumIntoMillion();
+
     Frustum _frustum;
     struct {
         Vector3 origin;
@@ -121,8 +131,18 @@ struct IntersectionBenchmark: Corrade::TestSuite::Tester {
 
     std::vector<Range3D> _boxes;
     std::vector<Vector4> _spheres;
+
+    /* For the batch benchmarks, boxes and spheres are stored in separate
+       arrays as that's what the batch APIs take */
+    std::vector<Range3D> _manyBoxes;
+    std::vector<Vector3> _manyCenters;
+    std::vector<Vector3> _manyExtents;
+    std::vector<Float> _manyRadii;
+    std::vector<UnsignedByte> _visibility;
 };
 
+enum: std::size_t { ManyCount = 1000000 };
+
 IntersectionBenchmark::IntersectionBenchmark() {
     addBenchmarks({&IntersectionBenchmark::rangeFrustumNaive,
                    &IntersectionBenchmark::rangeFrustum,
@@ -135,6 +155,13 @@ IntersectionBenchmark::IntersectionBenchmark() {
                    &IntersectionBenchmark::sphereCone,
                    &IntersectionBenchmark::sphereConeView}, 10);
 
+    addBenchmarks({&IntersectionBenchmark::rangeFrustumMillion,
+                   &IntersectionBenchmark::rangeFrustumIntoMillion,
+                   &IntersectionBenchmark::aabbFrustumMillion,
+                   &IntersectionBenchmark::aabbFrustumIntoMillion,
+                   &IntersectionBenchmark::sphereFrustumMillion,
+                   &IntersectionBenchmark::sphereFrustumIntoMillion}, 5);
+
     /* Generate random data for the benchmarks */
     std::random_device rnd;
     std::mt19937 g(rnd());
@@ -157,6 +184,24 @@ IntersectionBenchmark::IntersectionBenchmark() {
         _boxes.emplace_back(center - extents, center + extents);
         _spheres.emplace_back(center, extents.length());
     }
+
+    /* Larger spread so most of the objects are outside of the frustum, which
+       is the common case in large scenes */
+    std::uniform_real_distribution<float> mpd(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> med(0.1f, 5.0f);
+    _manyBoxes.reserve(ManyCount);
+    _manyCenters.reserve(ManyCount);
+    _manyExtents.reserve(ManyCount);
+    _manyRadii.reserve(ManyCount);
+    for(std::size_t i = 0; i != ManyCount; ++i) {
+        Vector3 center{mpd(g), mpd(g), mpd(g)};
+        Vector3 extents{med(g), med(g), med(g)};
+        _manyBoxes.emplace_back(center - extents, center + extents);
+        _manyCenters.push_back(center);
+        _manyExtents.push_back(extents);
+        _manyRadii.push_back(extents.length());
+    }
+    _visibility.resize((ManyCount + 7)/8);
 }
 
 void IntersectionBenchmark::rangeFrustumNaive() {
@@ -221,6 +266,56 @@ void IntersectionBenchmark::sphereConeView() {
     }
 }
 
+void IntersectionBenchmark::rangeFrustumMillion() {
+    volatile bool b = false;
+    CORRADE_BENCHMARK(1) for(auto& box: _manyBoxes) {
+        b = b ^ Intersection::rangeFrustum(box, _frustum);
+    }
+}
+
+void IntersectionBenchmark::rangeFrustumIntoMillion() {
+    CORRADE_BENCHMARK(1) {
+        Intersection::rangeFrustumInto(
+            Corrade::Containers::arrayView(_manyBoxes.data(), _manyBoxes.size()),
+            _frustum,
+            Corrade::Containers::arrayView(_visibility.data(), _visibility.size()));
+    }
+}
+
+void IntersectionBenchmark::aabbFrustumMillion() {
+    volatile bool b = false;
+    CORRADE_BENCHMARK(1) for(std::size_t i = 0; i != ManyCount; ++i) {
+        b = b ^ Intersection::aabbFrustum(_manyCenters[i], _manyExtents[i], _frustum);
+    }
+}
+
+void IntersectionBenchmark::aabbFrustumIntoMillion() {
+    CORRADE_BENCHMARK(1) {
+        Intersection::aabbFrustumInto(
+            Corrade::Containers::arrayView(_manyCenters.data(), _manyCenters.size()),
+            Corrade::Containers::arrayView(_manyExtents.data(), _manyExtents.size()),
+            _frustum,
+            Corrade::Containers::arrayView(_visibility.data(), _visibility.size()));
+    }
+}
+
+void IntersectionBenchmark::sphereFrustumMillion() {
+    volatile bool b = false;
+    CORRADE_BENCHMARK(1) for(std::size_t i = 0; i != ManyCount; ++i) {
+        b = b ^ Intersection::sphereFrustum(_manyCenters[i], _manyRadii[i], _frustum);
+    }
+}
+
+void IntersectionBenchmark::sphereFrustumIntoMillion() {
+    CORRADE_BENCHMARK(1) {
+        Intersection::sphereFrustumInto(
+            Corrade::Containers::arrayView(_manyCenters.data(), _manyCenters.size()),
+            Corrade::Containers::arrayView(_manyRadii.data(), _manyRadii.size()),
+            _frustum,
+            Corrade::Containers::arrayView(_visibility.data(), _visibility.size()));
+    }
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::IntersectionBenchmark)
@@ -0,0 +1,447 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Count of SAH bins. Going higher doesn't improve the tree quality much but
+   makes the build slower. */
+constexpr UnsignedInt BinCount = 16;
+
+/* Inverted infinite range that's an identity for joinBounds(). Not using
+   Math::join() because it skips zero-sized ranges, which are perfectly
+   valid primitive bounds. */
+inline Range3D emptyBounds() {
+    return {Vector3{Constants::inf()}, Vector3{-Constants::inf()}};
+}
+
+inline Range3D joinBounds(const Range3D& a, const Range3D& b) {
+    return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+}
+
+/* Half of the surface area, which is all SAH needs. Zero for empty bounds. */
+inline Float halfArea(const Range3D& bounds) {
+    const Vector3 size = Math::max(bounds.size(), Vector3{});
+    return size.x()*size.y() + size.y()*size.z() + size.z()*size.x();
+}
+
+inline UnsignedInt binIndex(const Float centroid, const Float min, const Float binScale) {
+    return std::min(UnsignedInt((centroid - min)*binScale), BinCount - 1);
+}
+
+/* Slab test, returns the entry distance or a negative value if there's no
+   intersection */
+inline Float rayBounds(const Vector3& origin, const Vector3& inverseDirection, const Float maxDistance, const Range3D& bounds) {
+    const Vector3 t0 = (bounds.min() - origin)*inverseDirection;
+    const Vector3 t1 = (bounds.max() - origin)*inverseDirection;
+    const Float nearDistance = Math::max(Math::min(t0, t1).max(), 0.0f);
+    const Float farDistance = Math::min(Math::max(t0, t1).min(), maxDistance);
+    return nearDistance <= farDistance ? nearDistance : -1.0f;
+}
+
+inline bool sphereBounds(const Vector3& center, const Float radiusSquared, const Range3D& bounds) {
+    return (center - Math::clamp(center, bounds.min(), bounds.max())).dot() <= radiusSquared;
+}
+
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const Containers::StridedArrayView1D<const Range3D>& primitives, const UnsignedInt maxLeafSize) {
+    CORRADE_ASSERT(maxLeafSize,
+        "MeshTools::BoundingVolumeHierarchy: max leaf size can't be zero", );
+
+    _primitives = Containers::Array<Range3D>{Containers::NoInit, primitives.size()};
+    Utility::copy(primitives, Containers::StridedArrayView1D<Range3D>{_primitives});
+    build(maxLeafSize);
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const Trade::MeshData& mesh, const UnsignedInt maxLeafSize) {
+    CORRADE_ASSERT(maxLeafSize,
+        "MeshTools::BoundingVolumeHierarchy: max leaf size can't be zero", );
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::BoundingVolumeHierarchy: expected a triangle mesh, got" << mesh.primitive(), );
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::BoundingVolumeHierarchy: the mesh has no positions", );
+
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    const std::size_t vertexCount = mesh.isIndexed() ? mesh.indexCount() : mesh.vertexCount();
+    CORRADE_ASSERT(vertexCount % 3 == 0,
+        "MeshTools::BoundingVolumeHierarchy: vertex count not divisible by 3", );
+
+    /* Unpack the triangles so the closest hit test doesn't need to go through
+       the index buffer */
+    _triangles = Containers::Array<Vector3>{Containers::NoInit, vertexCount};
+    if(mesh.isIndexed()) {
+        const Containers::Array<UnsignedInt> indices = mesh.indicesAsArray();
+        for(std::size_t i = 0; i != indices.size(); ++i) {
+            CORRADE_ASSERT(indices[i] < positions.size(),
+                "MeshTools::BoundingVolumeHierarchy: index" << indices[i] << "out of bounds for" << positions.size() << "elements", );
+            _triangles[i] = positions[indices[i]];
+        }
+    } else Utility::copy(Containers::arrayView(positions), Containers::arrayView(_triangles));
+
+    _primitives = Containers::Array<Range3D>{Containers::NoInit, vertexCount/3};
+    for(std::size_t i = 0; i != _primitives.size(); ++i) {
+        const Vector3* const triangle = _triangles.data() + i*3;
+        _primitives[i] = {Math::min(triangle[0], Math::min(triangle[1], triangle[2])),
+                          Math::max(triangle[0], Math::max(triangle[1], triangle[2]))};
+    }
+
+    build(maxLeafSize);
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(BoundingVolumeHierarchy&&) noexcept = default;
+
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy() = default;
+
+BoundingVolumeHierarchy& BoundingVolumeHierarchy::operator=(BoundingVolumeHierarchy&&) noexcept = default;
+
+void BoundingVolumeHierarchy::build(const UnsignedInt maxLeafSize) {
+    const UnsignedInt primitiveCount = _primitives.size();
+    _primitiveIds = Containers::Array<UnsignedInt>{Containers::NoInit, primitiveCount};
+    for(UnsignedInt i = 0; i != primitiveCount; ++i) _primitiveIds[i] = i;
+    if(!primitiveCount) return;
+
+    /* A binary tree with N leaves has at most 2N - 1 nodes, allocate for the
+       worst case and shrink at the end. Each node is first created covering
+       a range of primitives and subsequently either kept as a leaf or split
+       into two new nodes, which thus always have a higher index than their
+       parent. */
+    Containers::Array<Node> nodes{Containers::NoInit, 2*std::size_t(primitiveCount) - 1};
+    nodes[0].offset = 0;
+    nodes[0].count = primitiveCount;
+    UnsignedInt nodeCount = 1;
+
+    Containers::Array<UnsignedInt> stack;
+    arrayAppend(stack, 0u);
+    while(!stack.empty()) {
+        Node& node = nodes[stack.back()];
+        arrayRemoveSuffix(stack, 1);
+
+        const Containers::ArrayView<UnsignedInt> ids = _primitiveIds.slice(node.offset, node.offset + node.count);
+        Range3D centroidBounds = emptyBounds();
+        node.bounds = emptyBounds();
+        for(const UnsignedInt id: ids) {
+            const Vector3 centroid = _primitives[id].center();
+            node.bounds = joinBounds(node.bounds, _primitives[id]);
+            centroidBounds = {Math::min(centroidBounds.min(), centroid),
+                              Math::max(centroidBounds.max(), centroid)};
+        }
+
+        if(node.count <= maxLeafSize) continue;
+
+        /* Split along the axis in which the centroids are spread the most */
+        const Vector3 centroidSize = centroidBounds.size();
+        std::size_t axis = 0;
+        for(std::size_t i = 1; i != 3; ++i)
+            if(centroidSize[i] > centroidSize[axis]) axis = i;
+
+        UnsignedInt leftCount = 0;
+        if(centroidSize[axis] > 0.0f) {
+            /* Put the primitives into bins based on their centroids */
+            UnsignedInt binCounts[BinCount]{};
+            Range3D binBounds[BinCount];
+            for(Range3D& i: binBounds) i = emptyBounds();
+            const Float min = centroidBounds.min()[axis];
+            const Float binScale = BinCount/centroidSize[axis];
+            for(const UnsignedInt id: ids) {
+                const UnsignedInt bin = binIndex(_primitives[id].center()[axis], min, binScale);
+                ++binCounts[bin];
+                binBounds[bin] = joinBounds(binBounds[bin], _primitives[id]);
+            }
+
+            /* Sweep from the right to get area of everything right of each
+               split, then from the left to calculate the split cost. A split
+               after bin i puts bins [0, i] to the left. */
+            Float rightAreas[BinCount - 1];
+            UnsignedInt rightCounts[BinCount - 1];
+            {
+                Range3D bounds = emptyBounds();
+                UnsignedInt count = 0;
+                for(UnsignedInt i = BinCount - 1; i != 0; --i) {
+                    bounds = joinBounds(bounds, binBounds[i]);
+                    count += binCounts[i];
+                    rightAreas[i - 1] = halfArea(bounds);
+                    rightCounts[i - 1] = count;
+                }
+            }
+
+            Float bestCost = Constants::inf();
+            UnsignedInt bestSplit = BinCount;
+            Range3D bounds = emptyBounds();
+            UnsignedInt count = 0;
+            for(UnsignedInt i = 0; i != BinCount - 1; ++i) {
+                bounds = joinBounds(bounds, binBounds[i]);
+                count += binCounts[i];
+                if(!count || !rightCounts[i]) continue;
+
+                const Float cost = count*halfArea(bounds) + rightCounts[i]*rightAreas[i];
+                if(cost < bestCost) {
+                    bestCost = cost;
+                    bestSplit = i;
+                }
+            }
+
+            /* The centroids with the min and max coordinate are always in
+               the first and last bin, so there's always a valid split, but
+               better be safe in case of NaNs and such */
+            if(bestSplit != BinCount) {
+                leftCount = std::partition(ids.begin(), ids.end(), [&](const UnsignedInt id) {
+                    return binIndex(_primitives[id].center()[axis], min, binScale) <= bestSplit;
+                }) - ids.begin();
+            }
+        }
+
+        /* All centroids are at the same position or the binning failed,
+           split in half */
+        if(!leftCount || leftCount == node.count) {
+            leftCount = node.count/2;
+            std::nth_element(ids.begin(), ids.begin() + leftCount, ids.end(), [&](const UnsignedInt a, const UnsignedInt b) {
+                return _primitives[a].center()[axis] < _primitives[b].center()[axis];
+            });
+        }
+
+        Node& left = nodes[nodeCount];
+        left.offset = node.offset;
+        left.count = leftCount;
+        Node& right = nodes[nodeCount + 1];
+        right.offset = node.offset + leftCount;
+        right.count = node.count - leftCount;
+
+        node.offset = nodeCount;
+        node.count = 0;
+        arrayAppend(stack, nodeCount + 1);
+        arrayAppend(stack, nodeCount);
+        nodeCount += 2;
+    }
+
+    _nodes = Containers::Array<Node>{Containers::NoInit, nodeCount};
+    Utility::copy(Containers::arrayView<const Node>(nodes).prefix(nodeCount), Containers::arrayView(_nodes));
+}
+
+UnsignedInt BoundingVolumeHierarchy::depth() const {
+    if(_nodes.empty()) return 0;
+
+    /* Children are always after their parent, so a single pass is enough */
+    Containers::Array<UnsignedInt> depths{Containers::NoInit, _nodes.size()};
+    depths[0] = 1;
+    UnsignedInt depth = 1;
+    for(std::size_t i = 0; i != _nodes.size(); ++i) {
+        if(_nodes[i].count) continue;
+        depths[_nodes[i].offset] = depths[_nodes[i].offset + 1] = depths[i] + 1;
+        depth = Math::max(depth, depths[i] + 1);
+    }
+
+    return depth;
+}
+
+Range3D BoundingVolumeHierarchy::bounds() const {
+    return _nodes.empty() ? Range3D{} : _nodes[0].bounds;
+}
+
+Range3D BoundingVolumeHierarchy::primitive(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _primitives.size(),
+        "MeshTools::BoundingVolumeHierarchy::primitive(): index" << id << "out of range for" << _primitives.size() << "primitives", {});
+    return _primitives[id];
+}
+
+void BoundingVolumeHierarchy::refit(const Containers::StridedArrayView1D<const Range3D>& primitives) {
+    CORRADE_ASSERT(_triangles.empty(),
+        "MeshTools::BoundingVolumeHierarchy::refit(): can't refit a hierarchy built from a mesh", );
+    CORRADE_ASSERT(primitives.size() == _primitives.size(),
+        "MeshTools::BoundingVolumeHierarchy::refit(): expected" << _primitives.size() << "primitives but got" << primitives.size(), );
+
+    Utility::copy(primitives, Containers::StridedArrayView1D<Range3D>{_primitives});
+
+    /* Children are always after their parent, so going backwards updates
+       them before they're used */
+    for(std::size_t i = _nodes.size(); i != 0; --i) {
+        Node& node = _nodes[i - 1];
+        if(node.count) {
+            node.bounds = emptyBounds();
+            for(const UnsignedInt id: _primitiveIds.slice(node.offset, node.offset + node.count))
+                node.bounds = joinBounds(node.bounds, _primitives[id]);
+        } else node.bounds = joinBounds(_nodes[node.offset].bounds, _nodes[node.offset + 1].bounds);
+    }
+}
+
+Containers::Array<UnsignedInt> BoundingVolumeHierarchy::ray(const Vector3& origin, const Vector3& direction, const Float maxDistance) const {
+    Containers::Array<UnsignedInt> out;
+    if(_nodes.empty()) return out;
+
+    const Vector3 inverseDirection = 1.0f/direction;
+    Containers::Array<UnsignedInt> stack;
+    arrayAppend(stack, 0u);
+    while(!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        arrayRemoveSuffix(stack, 1);
+        if(rayBounds(origin, inverseDirection, maxDistance, node.bounds) < 0.0f)
+            continue;
+
+        if(node.count) {
+            for(const UnsignedInt id: _primitiveIds.slice(node.offset, node.offset + node.count))
+                if(rayBounds(origin, inverseDirection, maxDistance, _primitives[id]) >= 0.0f)
+                    arrayAppend(out, id);
+        } else {
+            arrayAppend(stack, node.offset + 1);
+            arrayAppend(stack, node.offset);
+        }
+    }
+
+    return out;
+}
+
+Containers::Array<UnsignedInt> BoundingVolumeHierarchy::frustum(const Frustum& frustum) const {
+    Containers::Array<UnsignedInt> out;
+    if(_nodes.empty()) return out;
+
+    Containers::Array<UnsignedInt> stack;
+    arrayAppend(stack, 0u);
+    while(!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        arrayRemoveSuffix(stack, 1);
+        if(!Math::Intersection::rangeFrustum(node.bounds, frustum))
+            continue;
+
+        if(node.count) {
+            for(const UnsignedInt id: _primitiveIds.slice(node.offset, node.offset + node.count))
+                if(Math::Intersection::rangeFrustum(_primitives[id], frustum))
+                    arrayAppend(out, id);
+        } else {
+            arrayAppend(stack, node.offset + 1);
+            arrayAppend(stack, node.offset);
+        }
+    }
+
+    return out;
+}
+
+Containers::Array<UnsignedInt> BoundingVolumeHierarchy::sphere(const Vector3& center, const Float radius) const {
+    Containers::Array<UnsignedInt> out;
+    if(_nodes.empty()) return out;
+
+    const Float radiusSquared = radius*radius;
+    Containers::Array<UnsignedInt> stack;
+    arrayAppend(stack, 0u);
+    while(!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        arrayRemoveSuffix(stack, 1);
+        if(!sphereBounds(center, radiusSquared, node.bounds))
+            continue;
+
+        if(node.count) {
+            for(const UnsignedInt id: _primitiveIds.slice(node.offset, node.offset + node.count))
+                if(sphereBounds(center, radiusSquared, _primitives[id]))
+                    arrayAppend(out, id);
+        } else {
+            arrayAppend(stack, node.offset + 1);
+            arrayAppend(stack, node.offset);
+        }
+    }
+
+    return out;
+}
+
+Containers::Optional<std::pair<UnsignedInt, Float>> BoundingVolumeHierarchy::closestTriangle(const Vector3& origin, const Vector3& direction, const Float maxDistance) const {
+    CORRADE_ASSERT(!_triangles.empty() || _primitives.empty(),
+        "MeshTools::BoundingVolumeHierarchy::closestTriangle(): the hierarchy wasn't built from a mesh", {});
+    if(_nodes.empty()) return {};
+
+    const Vector3 inverseDirection = 1.0f/direction;
+    UnsignedInt closestId = ~UnsignedInt{};
+    Float closest = maxDistance;
+
+    /* Node index and its entry distance. The nearer child is pushed last so
+       it's visited first, and nodes that are further than the closest hit
+       found meanwhile are skipped. */
+    Containers::Array<std::pair<UnsignedInt, Float>> stack;
+    {
+        const Float distance = rayBounds(origin, inverseDirection, closest, _nodes[0].bounds);
+        if(distance >= 0.0f) arrayAppend(stack, Containers::InPlaceInit, 0u, distance);
+    }
+    while(!stack.empty()) {
+        const std::pair<UnsignedInt, Float> top = stack.back();
+        arrayRemoveSuffix(stack, 1);
+        if(top.second > closest) continue;
+
+        const Node& node = _nodes[top.first];
+        if(node.count) {
+            /* Möller-Trumbore, both sides */
+            for(const UnsignedInt id: _primitiveIds.slice(node.offset, node.offset + node.count)) {
+                const Vector3* const triangle = _triangles.data() + id*3;
+                const Vector3 e1 = triangle[1] - triangle[0];
+                const Vector3 e2 = triangle[2] - triangle[0];
+                const Vector3 p = Math::cross(direction, e2);
+                const Float determinant = Math::dot(e1, p);
+                if(determinant == 0.0f) continue;
+
+                const Float inverseDeterminant = 1.0f/determinant;
+                const Vector3 s = origin - triangle[0];
+                const Float u = Math::dot(s, p)*inverseDeterminant;
+                if(u < 0.0f || u > 1.0f) continue;
+
+                const Vector3 q = Math::cross(s, e1);
+                const Float v = Math::dot(direction, q)*inverseDeterminant;
+                if(v < 0.0f || u + v > 1.0f) continue;
+
+                const Float t = Math::dot(e2, q)*inverseDeterminant;
+                if(t < 0.0f || t > closest) continue;
+
+                /* Prefer the lower ID on ties to make the result independent
+                   of the traversal order */
+                if(t == closest && id > closestId) continue;
+                closest = t;
+                closestId = id;
+            }
+        } else {
+            const Float distanceA = rayBounds(origin, inverseDirection, closest, _nodes[node.offset].bounds);
+            const Float distanceB = rayBounds(origin, inverseDirection, closest, _nodes[node.offset + 1].bounds);
+            const bool aFirst = distanceB < 0.0f || (distanceA >= 0.0f && distanceA <= distanceB);
+            const UnsignedInt first = aFirst ? node.offset : node.offset + 1;
+            const UnsignedInt second = aFirst ? node.offset + 1 : node.offset;
+            const Float distanceFirst = aFirst ? distanceA : distanceB;
+            const Float distanceSecond = aFirst ? distanceB : distanceA;
+            if(distanceSecond >= 0.0f) arrayAppend(stack, Containers::InPlaceInit, second, distanceSecond);
+            if(distanceFirst >= 0.0f) arrayAppend(stack, Containers::InPlaceInit, first, distanceFirst);
+        }
+    }
+
+    if(closestId == ~UnsignedInt{}) return {};
+    return std::make_pair(closestId, closest);
+}
+
+}}
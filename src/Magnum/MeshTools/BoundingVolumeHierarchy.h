@@ -0,0 +1,245 @@
+#ifndef Magnum_MeshTools_BoundingVolumeHierarchy_h
+#define Magnum_MeshTools_BoundingVolumeHierarchy_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::BoundingVolumeHierarchy
+ * @m_since_latest
+ */
+
+#include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Bounding volume hierarchy
+@m_since_latest
+
+A binary tree of axis-aligned bounding boxes for accelerating spatial queries
+over a large amount of primitives, such as picking with a ray or culling with
+a frustum. Each primitive is described by its bounding box, passed to the
+constructor:
+
+@snippet MagnumMeshTools.cpp BoundingVolumeHierarchy-usage
+
+The hierarchy is built top-down using binned surface area heuristic (SAH) ---
+at each level, primitive centroids are sorted into a fixed number of bins
+along the longest axis of their bounds and the split with the smallest sum
+of child box areas weighted by their primitive counts is chosen. Nodes with
+at most the count of primitives passed to the constructor become leaves.
+
+@section MeshTools-BoundingVolumeHierarchy-refit Moving primitives
+
+If the primitives move, but their count stays the same, @ref refit() updates
+all node bounding boxes in a single linear pass without changing the tree
+topology. That's significantly faster than building the hierarchy again, but
+the query performance slowly degrades as the primitives move further away
+from their original positions, so it's advised to rebuild the hierarchy
+from time to time.
+
+@section MeshTools-BoundingVolumeHierarchy-triangles Triangle meshes
+
+When constructed from a @ref Trade::MeshData, the primitives are triangles of
+the mesh and their positions are kept in the hierarchy, which then allows
+finding the closest triangle hit by a ray with @ref closestTriangle(),
+useful for mesh-level picking:
+
+@snippet MagnumMeshTools.cpp BoundingVolumeHierarchy-triangles
+*/
+class MAGNUM_MESHTOOLS_EXPORT BoundingVolumeHierarchy {
+    public:
+        /**
+         * @brief Construct from primitive bounding boxes
+         * @param primitives    Bounding boxes of the primitives
+         * @param maxLeafSize   Max count of primitives in a leaf node
+         *
+         * Expects that @p maxLeafSize is not zero. The @p primitives are
+         * copied into the hierarchy and their indices are what the queries
+         * return.
+         */
+        explicit BoundingVolumeHierarchy(const Containers::StridedArrayView1D<const Range3D>& primitives, UnsignedInt maxLeafSize = 4);
+
+        /**
+         * @brief Construct from triangles of a mesh
+         * @param mesh          Mesh
+         * @param maxLeafSize   Max count of primitives in a leaf node
+         *
+         * Expects that @p mesh is a @ref MeshPrimitive::Triangles with a
+         * @ref Trade::MeshAttribute::Position attribute and that
+         * @p maxLeafSize is not zero. If the mesh is indexed, the index
+         * buffer is used to assemble the triangles. Primitive IDs returned by
+         * the queries are triangle IDs. Use @ref closestTriangle() to test
+         * for ray intersection with the actual triangles instead of just
+         * their bounding boxes.
+         */
+        explicit BoundingVolumeHierarchy(const Trade::MeshData& mesh, UnsignedInt maxLeafSize = 4);
+
+        /** @brief Copying is not allowed */
+        BoundingVolumeHierarchy(const BoundingVolumeHierarchy&) = delete;
+
+        /** @brief Move constructor */
+        BoundingVolumeHierarchy(BoundingVolumeHierarchy&&) noexcept;
+
+        ~BoundingVolumeHierarchy();
+
+        /** @brief Copying is not allowed */
+        BoundingVolumeHierarchy& operator=(const BoundingVolumeHierarchy&) = delete;
+
+        /** @brief Move assignment */
+        BoundingVolumeHierarchy& operator=(BoundingVolumeHierarchy&&) noexcept;
+
+        /** @brief Count of primitives */
+        UnsignedInt primitiveCount() const { return _primitives.size(); }
+
+        /**
+         * @brief Count of nodes
+         *
+         * Zero if there are no primitives, otherwise at most
+         * @cpp 2*primitiveCount() - 1 @ce.
+         */
+        UnsignedInt nodeCount() const { return _nodes.size(); }
+
+        /**
+         * @brief Tree depth
+         *
+         * Count of nodes on the longest path from the root to a leaf. Zero if
+         * there are no primitives.
+         */
+        UnsignedInt depth() const;
+
+        /**
+         * @brief Bounds of all primitives
+         *
+         * Returns a default-constructed range if there are no primitives.
+         */
+        Range3D bounds() const;
+
+        /**
+         * @brief Bounding box of given primitive
+         *
+         * Expects that @p id is less than @ref primitiveCount().
+         */
+        Range3D primitive(UnsignedInt id) const;
+
+        /**
+         * @brief Whether the hierarchy contains triangle positions
+         *
+         * @cpp true @ce if the hierarchy was constructed from a
+         * @ref Trade::MeshData, @cpp false @ce otherwise.
+         * @see @ref closestTriangle()
+         */
+        bool hasTriangles() const { return !_triangles.empty(); }
+
+        /**
+         * @brief Update bounding boxes of the primitives
+         *
+         * Expects that @p primitives have the same size as the original
+         * primitive list and that the hierarchy wasn't constructed from a
+         * mesh. The tree topology is kept, only the node bounds are updated.
+         * See @ref MeshTools-BoundingVolumeHierarchy-refit for more
+         * information.
+         */
+        void refit(const Containers::StridedArrayView1D<const Range3D>& primitives);
+
+        /**
+         * @brief Primitives intersecting a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction, doesn't need to be normalized
+         * @param maxDistance   Max distance along the ray, in multiples of
+         *      @p direction
+         *
+         * Returns IDs of primitives whose bounding box intersects the ray
+         * between @p origin and @cpp origin + maxDistance*direction @ce, in
+         * an unspecified order.
+         */
+        Containers::Array<UnsignedInt> ray(const Vector3& origin, const Vector3& direction, Float maxDistance = Constants::inf()) const;
+
+        /**
+         * @brief Primitives intersecting a frustum
+         *
+         * Returns IDs of primitives whose bounding box intersects the
+         * frustum, in an unspecified order. Uses
+         * @ref Math::Intersection::rangeFrustum() for both the nodes and
+         * primitives, see its documentation for details.
+         */
+        Containers::Array<UnsignedInt> frustum(const Frustum& frustum) const;
+
+        /**
+         * @brief Primitives intersecting a sphere
+         *
+         * Returns IDs of primitives whose bounding box intersects the sphere,
+         * in an unspecified order.
+         */
+        Containers::Array<UnsignedInt> sphere(const Vector3& center, Float radius) const;
+
+        /**
+         * @brief Closest triangle hit by a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction, doesn't need to be normalized
+         * @param maxDistance   Max distance along the ray, in multiples of
+         *      @p direction
+         * @return Triangle ID and distance along the ray in multiples of
+         *      @p direction, or @ref Containers::NullOpt if no triangle is
+         *      hit
+         *
+         * Expects that the hierarchy was constructed from a mesh. Nodes are
+         * visited front-to-back and subtrees further than the closest hit
+         * found so far are skipped. Both sides of the triangles are
+         * considered.
+         * @see @ref hasTriangles()
+         */
+        Containers::Optional<std::pair<UnsignedInt, Float>> closestTriangle(const Vector3& origin, const Vector3& direction, Float maxDistance = Constants::inf()) const;
+
+    private:
+        struct Node {
+            Range3D bounds;
+            /* For leaf nodes offset into _primitiveIds, for inner nodes index
+               of the first child, the second child is right after it */
+            UnsignedInt offset;
+            /* Zero for inner nodes */
+            UnsignedInt count;
+        };
+
+        MAGNUM_MESHTOOLS_LOCAL void build(UnsignedInt maxLeafSize);
+
+        Containers::Array<Node> _nodes;
+        Containers::Array<UnsignedInt> _primitiveIds;
+        Containers::Array<Range3D> _primitives;
+        /* Three vertices for each primitive if constructed from a mesh */
+        Containers::Array<Vector3> _triangles;
+};
+
+}}
+
+#endif
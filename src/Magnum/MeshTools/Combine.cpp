@@ -34,6 +34,7 @@
 #include "Magnum/MeshTools/Interleave.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/Tracer.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace MeshTools {
@@ -41,6 +42,8 @@ namespace Magnum { namespace MeshTools {
 namespace {
 
 Trade::MeshData combineIndexedImplementation(const MeshPrimitive primitive, Containers::Array<char>& combinedIndices, const UnsignedInt indexCount, const UnsignedInt indexStride, const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> data) {
+    MAGNUM_TRACE_ZONE("MeshTools::combineIndexedAttributes()");
+
     /* Calculate attribute count and vertex stride */
     UnsignedInt attributeCount = 0;
     UnsignedInt vertexStride = 0;
@@ -31,6 +31,7 @@
 #include <Corrade/Utility/Algorithms.h>
 
 #include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Tracer.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace MeshTools {
@@ -50,6 +51,8 @@ template<class T, class U> inline Containers::Array<char> compress(const Contain
 }
 
 template<class T> std::pair<Containers::Array<char>, MeshIndexType> compressIndicesImplementation(const Containers::StridedArrayView1D<const T>& indices, const MeshIndexType atLeast, const Long offset) {
+    MAGNUM_TRACE_ZONE("MeshTools::compressIndices()");
+
     const UnsignedInt max = Math::max(indices) - offset;
     Containers::Array<char> out;
     MeshIndexType type;
@@ -118,6 +121,8 @@ std::pair<Containers::Array<char>, MeshIndexType> compressIndices(const Containe
 }
 
 Trade::MeshData compressIndices(Trade::MeshData&& data, MeshIndexType atLeast) {
+    MAGNUM_TRACE_ZONE("MeshTools::compressIndices()");
+
     CORRADE_ASSERT(data.isIndexed(), "MeshTools::compressIndices(): mesh data not indexed", (Trade::MeshData{MeshPrimitive::Triangles, 0}));
 
     /* Transfer vertex data as-is, as those don't need any changes. Release if
@@ -29,6 +29,8 @@
 #include <unordered_map>
 #include <Corrade/Utility/Algorithms.h>
 
+#include "Magnum/Tracer.h"
+
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
@@ -63,6 +65,8 @@ struct MeshAttributeHash: std::hash<typename std::underlying_type<Trade::MeshAtt
 };
 
 Trade::MeshData concatenate(Containers::Array<char>&& indexData, const UnsignedInt vertexCount, Containers::Array<char>&& vertexData, Containers::Array<Trade::MeshAttributeData>&& attributeData, const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, const char* const assertPrefix) {
+    MAGNUM_TRACE_ZONE("MeshTools::concatenate()");
+
     #ifdef CORRADE_NO_ASSERT
     static_cast<void>(assertPrefix);
     #endif
@@ -30,6 +30,7 @@
 
 #include "Magnum/Math/Functions.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/Tracer.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace MeshTools {
@@ -79,6 +80,8 @@ void duplicateInto(const Containers::StridedArrayView2D<const char>& indices, co
 }
 
 Trade::MeshData duplicate(const Trade::MeshData& data, const Containers::ArrayView<const Trade::MeshAttributeData> extra) {
+    MAGNUM_TRACE_ZONE("MeshTools::duplicate()");
+
     CORRADE_ASSERT(data.isIndexed(), "MeshTools::duplicate(): mesh data not indexed", (Trade::MeshData{MeshPrimitive::Triangles, 0}));
 
     /* Calculate the layout */
@@ -29,6 +29,7 @@
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
 
+#include "Magnum/Tracer.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace MeshTools {
@@ -169,6 +170,8 @@ Containers::Array<UnsignedInt> generateTriangleFanIndices(const UnsignedInt vert
 }
 
 Trade::MeshData generateIndices(Trade::MeshData&& data) {
+    MAGNUM_TRACE_ZONE("MeshTools::generateIndices()");
+
     CORRADE_ASSERT(!data.isIndexed(),
         "MeshTools::generateIndices(): mesh data already indexed",
         (Trade::MeshData{MeshPrimitive::Triangles, 0}));
@@ -30,6 +30,7 @@
 
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Vector3.h"
+#include "Magnum/Tracer.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 #include <vector>
@@ -41,6 +42,8 @@
 namespace Magnum { namespace MeshTools {
 
 void generateFlatNormalsInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals) {
+    MAGNUM_TRACE_ZONE("MeshTools::generateFlatNormalsInto()");
+
     CORRADE_ASSERT(positions.size() % 3 == 0,
         "MeshTools::generateFlatNormalsInto(): position count not divisible by 3", );
     CORRADE_ASSERT(normals.size() == positions.size(),
@@ -99,6 +102,8 @@ using namespace Math::Literals;
 #endif
 
 template<class T> inline void generateSmoothNormalsIntoImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals) {
+    MAGNUM_TRACE_ZONE("MeshTools::generateSmoothNormalsInto()");
+
     CORRADE_ASSERT(indices.size() % 3 == 0,
         "MeshTools::generateSmoothNormalsInto(): index count not divisible by 3", );
     CORRADE_ASSERT(normals.size() == positions.size(),
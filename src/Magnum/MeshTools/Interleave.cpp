@@ -29,6 +29,7 @@
 #include <Corrade/Utility/Algorithms.h>
 
 #include "Magnum/Math/Functions.h"
+#include "Magnum/Tracer.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace MeshTools {
@@ -249,6 +250,8 @@ Trade::MeshData interleavedLayout(const Trade::MeshData& data, const UnsignedInt
 }
 
 Trade::MeshData interleave(Trade::MeshData&& data, const Containers::ArrayView<const Trade::MeshAttributeData> extra) {
+    MAGNUM_TRACE_ZONE("MeshTools::interleave()");
+
     /* Transfer the indices unchanged, in case the mesh is indexed */
     Containers::Array<char> indexData;
     Trade::MeshIndexData indices;
@@ -39,6 +39,7 @@
 #include "Magnum/MeshTools/Reference.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/Tracer.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace MeshTools {
@@ -64,6 +65,8 @@ struct ArrayHash {
 };
 
 std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    MAGNUM_TRACE_ZONE("MeshTools::removeDuplicatesInto()");
+
     /* Assuming the second dimension is contiguous so we can calculate the
        hashes easily */
     CORRADE_ASSERT(data.empty()[0] || data.isContiguous<1>(),
@@ -104,6 +107,8 @@ std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Co
 }
 
 std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    MAGNUM_TRACE_ZONE("MeshTools::removeDuplicatesInPlaceInto()");
+
     /* Assuming the second dimension is contiguous so we can calculate the
        hashes easily */
     CORRADE_ASSERT(data.empty()[0] || data.isContiguous<1>(),
@@ -208,6 +213,8 @@ std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView2D<
 namespace {
 
 template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPlaceImplementation(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<T>& data, T epsilon) {
+    MAGNUM_TRACE_ZONE("MeshTools::removeDuplicatesFuzzyIndexedInPlace()");
+
     /* Compared to the discrete version, we don't require the second dimension
        to be contiguous, as we calculate the hash from a discretized contiguous
        copy */
@@ -335,6 +342,8 @@ std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayVi
 namespace {
 
 template<class T> std::size_t removeDuplicatesFuzzyInPlaceIntoImplementation(const Containers::StridedArrayView2D<T>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const T epsilon) {
+    MAGNUM_TRACE_ZONE("MeshTools::removeDuplicatesFuzzyInPlaceInto()");
+
     CORRADE_ASSERT(indices.size() == data.size()[0],
         "MeshTools::removeDuplicatesFuzzyInPlaceInto(): output index array has" << indices.size() << "elements but expected" << data.size()[0], {});
 
@@ -404,6 +413,8 @@ Trade::MeshData removeDuplicates(const Trade::MeshData& data) {
 }
 
 Trade::MeshData removeDuplicates(Trade::MeshData&& data) {
+    MAGNUM_TRACE_ZONE("MeshTools::removeDuplicates()");
+
     CORRADE_ASSERT(data.attributeCount(),
         "MeshTools::removeDuplicates(): can't remove duplicates in an attributeless mesh",
         (Trade::MeshData{MeshPrimitive::Points, 0}));
@@ -458,6 +469,8 @@ Trade::MeshData removeDuplicates(Trade::MeshData&& data) {
 }
 
 Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float floatEpsilon, const Double doubleEpsilon) {
+    MAGNUM_TRACE_ZONE("MeshTools::removeDuplicatesFuzzy()");
+
     CORRADE_ASSERT(data.attributeCount(),
         "MeshTools::removeDuplicatesFuzzy(): can't remove duplicates in an attributeless mesh",
         (Trade::MeshData{MeshPrimitive::Points, 0}));
@@ -0,0 +1,192 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/BoundingVolumeHierarchy.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct BoundingVolumeHierarchyBenchmark: TestSuite::Tester {
+    explicit BoundingVolumeHierarchyBenchmark();
+
+    void build();
+    void buildMesh();
+    void refit();
+
+    void rayNaive();
+    void ray();
+    void frustumNaive();
+    void frustum();
+    void closestTriangle();
+
+    std::vector<Range3D> _boxes;
+    std::vector<std::pair<Vector3, Vector3>> _rays;
+    Frustum _frustum;
+};
+
+enum: std::size_t {
+    BoxCount = 100000,
+    RayCount = 100
+};
+
+BoundingVolumeHierarchyBenchmark::BoundingVolumeHierarchyBenchmark() {
+    addBenchmarks({&BoundingVolumeHierarchyBenchmark::build,
+                   &BoundingVolumeHierarchyBenchmark::buildMesh,
+                   &BoundingVolumeHierarchyBenchmark::refit,
+
+                   &BoundingVolumeHierarchyBenchmark::rayNaive,
+                   &BoundingVolumeHierarchyBenchmark::ray,
+                   &BoundingVolumeHierarchyBenchmark::frustumNaive,
+                   &BoundingVolumeHierarchyBenchmark::frustum,
+                   &BoundingVolumeHierarchyBenchmark::closestTriangle}, 5);
+
+    std::mt19937 g;
+    std::uniform_real_distribution<Float> position{-100.0f, 100.0f};
+    std::uniform_real_distribution<Float> size{0.1f, 1.0f};
+    _boxes.reserve(BoxCount);
+    for(std::size_t i = 0; i != BoxCount; ++i)
+        _boxes.push_back(Range3D::fromCenter(
+            {position(g), position(g), position(g)},
+            {size(g), size(g), size(g)}));
+
+    _rays.reserve(RayCount);
+    for(std::size_t i = 0; i != RayCount; ++i)
+        _rays.emplace_back(Vector3{position(g), position(g), -150.0f},
+            Vector3{position(g), position(g), 300.0f}.normalized());
+
+    _frustum = Frustum::fromMatrix(
+        Matrix4::perspectiveProjection(35.0_degf, 1.0f, 0.1f, 100.0f)*
+        Matrix4::lookAt({0.0f, 0.0f, 150.0f}, {}, Vector3::yAxis()).inverted());
+}
+
+void BoundingVolumeHierarchyBenchmark::build() {
+    UnsignedInt nodeCount = 0;
+    CORRADE_BENCHMARK(1) {
+        BoundingVolumeHierarchy bvh{Containers::arrayView(_boxes)};
+        nodeCount += bvh.nodeCount();
+    }
+
+    CORRADE_VERIFY(nodeCount);
+}
+
+void BoundingVolumeHierarchyBenchmark::buildMesh() {
+    const Trade::MeshData sphere = Primitives::icosphereSolid(6);
+
+    UnsignedInt nodeCount = 0;
+    CORRADE_BENCHMARK(1) {
+        BoundingVolumeHierarchy bvh{sphere};
+        nodeCount += bvh.nodeCount();
+    }
+
+    CORRADE_VERIFY(nodeCount);
+}
+
+void BoundingVolumeHierarchyBenchmark::refit() {
+    BoundingVolumeHierarchy bvh{Containers::arrayView(_boxes)};
+
+    CORRADE_BENCHMARK(1)
+        bvh.refit(Containers::arrayView(_boxes));
+
+    CORRADE_COMPARE(bvh.primitiveCount(), std::size_t(BoxCount));
+}
+
+void BoundingVolumeHierarchyBenchmark::rayNaive() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const std::pair<Vector3, Vector3>& ray: _rays) {
+            const Vector3 inverseDirection = 1.0f/ray.second;
+            for(const Range3D& box: _boxes) {
+                const Vector3 t0 = (box.min() - ray.first)*inverseDirection;
+                const Vector3 t1 = (box.max() - ray.first)*inverseDirection;
+                if(Math::max(Math::min(t0, t1).max(), 0.0f) <= Math::max(t0, t1).min())
+                    ++count;
+            }
+        }
+    }
+
+    CORRADE_VERIFY(count);
+}
+
+void BoundingVolumeHierarchyBenchmark::ray() {
+    BoundingVolumeHierarchy bvh{Containers::arrayView(_boxes)};
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const std::pair<Vector3, Vector3>& ray: _rays)
+            count += bvh.ray(ray.first, ray.second).size();
+    }
+
+    CORRADE_VERIFY(count);
+}
+
+void BoundingVolumeHierarchyBenchmark::frustumNaive() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10) {
+        for(const Range3D& box: _boxes)
+            if(Math::Intersection::rangeFrustum(box, _frustum)) ++count;
+    }
+
+    CORRADE_VERIFY(count);
+}
+
+void BoundingVolumeHierarchyBenchmark::frustum() {
+    BoundingVolumeHierarchy bvh{Containers::arrayView(_boxes)};
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += bvh.frustum(_frustum).size();
+
+    CORRADE_VERIFY(count);
+}
+
+void BoundingVolumeHierarchyBenchmark::closestTriangle() {
+    /* 81920 triangles */
+    BoundingVolumeHierarchy bvh{Primitives::icosphereSolid(6)};
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const std::pair<Vector3, Vector3>& ray: _rays)
+            if(bvh.closestTriangle(ray.first*0.01f, ray.second)) ++count;
+    }
+
+    CORRADE_VERIFY(count);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BoundingVolumeHierarchyBenchmark)
@@ -0,0 +1,552 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/BoundingVolumeHierarchy.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/Primitives/Cube.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct BoundingVolumeHierarchyTest: TestSuite::Tester {
+    explicit BoundingVolumeHierarchyTest();
+
+    void construct();
+    void constructEmpty();
+    void constructSinglePrimitive();
+    void constructCoincidentPrimitives();
+    void constructZeroLeafSize();
+    void constructMove();
+
+    void constructMesh();
+    void constructMeshNotTriangles();
+    void constructMeshNoPositions();
+
+    void primitiveOutOfRange();
+
+    void ray();
+    void frustum();
+    void sphere();
+
+    void refit();
+    void refitWrongCount();
+    void refitMesh();
+
+    void closestTriangle();
+    void closestTriangleMiss();
+    void closestTriangleMaxDistance();
+    void closestTriangleNotMesh();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt maxLeafSize;
+} LeafSizeData[]{
+    {"one primitive per leaf", 1},
+    {"four primitives per leaf", 4},
+    {"sixteen primitives per leaf", 16}
+};
+
+const struct {
+    const char* name;
+    bool indexed;
+} MeshIndexedData[]{
+    {"indexed", true},
+    {"non-indexed", false}
+};
+
+BoundingVolumeHierarchyTest::BoundingVolumeHierarchyTest() {
+    addInstancedTests({&BoundingVolumeHierarchyTest::construct},
+        Containers::arraySize(LeafSizeData));
+
+    addTests({&BoundingVolumeHierarchyTest::constructEmpty,
+              &BoundingVolumeHierarchyTest::constructSinglePrimitive,
+              &BoundingVolumeHierarchyTest::constructCoincidentPrimitives,
+              &BoundingVolumeHierarchyTest::constructZeroLeafSize,
+              &BoundingVolumeHierarchyTest::constructMove});
+
+    addInstancedTests({&BoundingVolumeHierarchyTest::constructMesh},
+        Containers::arraySize(MeshIndexedData));
+
+    addTests({&BoundingVolumeHierarchyTest::constructMeshNotTriangles,
+              &BoundingVolumeHierarchyTest::constructMeshNoPositions,
+
+              &BoundingVolumeHierarchyTest::primitiveOutOfRange});
+
+    addInstancedTests({&BoundingVolumeHierarchyTest::ray,
+                       &BoundingVolumeHierarchyTest::frustum,
+                       &BoundingVolumeHierarchyTest::sphere,
+
+                       &BoundingVolumeHierarchyTest::refit},
+        Containers::arraySize(LeafSizeData));
+
+    addTests({&BoundingVolumeHierarchyTest::refitWrongCount,
+              &BoundingVolumeHierarchyTest::refitMesh});
+
+    addInstancedTests({&BoundingVolumeHierarchyTest::closestTriangle},
+        Containers::arraySize(LeafSizeData));
+
+    addTests({&BoundingVolumeHierarchyTest::closestTriangleMiss,
+              &BoundingVolumeHierarchyTest::closestTriangleMaxDistance,
+              &BoundingVolumeHierarchyTest::closestTriangleNotMesh});
+}
+
+/* Deterministic pseudo-random boxes in a [-10, 10] cube */
+std::vector<Range3D> randomBoxes(std::size_t count, UnsignedInt seed = 1) {
+    auto random = [&seed]() {
+        seed = seed*1664525u + 1013904223u;
+        return Float(seed >> 8)/Float(1 << 24);
+    };
+
+    std::vector<Range3D> out;
+    out.reserve(count);
+    for(std::size_t i = 0; i != count; ++i) {
+        const Vector3 center{random()*20.0f - 10.0f, random()*20.0f - 10.0f, random()*20.0f - 10.0f};
+        const Vector3 halfSize{random()*0.5f, random()*0.5f, random()*0.5f};
+        out.push_back(Range3D::fromCenter(center, halfSize));
+    }
+    return out;
+}
+
+/* Brute-force reference implementations, using the same primitive tests as
+   the hierarchy */
+bool rayBox(const Vector3& origin, const Vector3& direction, Float maxDistance, const Range3D& box) {
+    const Vector3 inverseDirection = 1.0f/direction;
+    const Vector3 t0 = (box.min() - origin)*inverseDirection;
+    const Vector3 t1 = (box.max() - origin)*inverseDirection;
+    return Math::max(Math::min(t0, t1).max(), 0.0f) <= Math::min(Math::max(t0, t1).min(), maxDistance);
+}
+
+bool sphereBox(const Vector3& center, Float radius, const Range3D& box) {
+    return (center - Math::clamp(center, box.min(), box.max())).dot() <= radius*radius;
+}
+
+std::vector<UnsignedInt> sorted(const Containers::Array<UnsignedInt>& ids) {
+    std::vector<UnsignedInt> out{ids.begin(), ids.end()};
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+void BoundingVolumeHierarchyTest::construct() {
+    auto&& data = LeafSizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::vector<Range3D> boxes = randomBoxes(1000);
+    BoundingVolumeHierarchy bvh{Containers::arrayView(boxes), data.maxLeafSize};
+
+    CORRADE_COMPARE(bvh.primitiveCount(), 1000);
+    CORRADE_VERIFY(bvh.nodeCount() >= 2*1000/data.maxLeafSize - 1);
+    CORRADE_VERIFY(bvh.nodeCount() <= 2*1000 - 1);
+    /* Should be reasonably balanced */
+    CORRADE_VERIFY(bvh.depth() > 1);
+    CORRADE_VERIFY(bvh.depth() < 40);
+    CORRADE_COMPARE(bvh.primitive(137), boxes[137]);
+    CORRADE_VERIFY(!bvh.hasTriangles());
+
+    Range3D bounds = boxes[0];
+    for(const Range3D& box: boxes)
+        bounds = {Math::min(bounds.min(), box.min()), Math::max(bounds.max(), box.max())};
+    CORRADE_COMPARE(bvh.bounds(), bounds);
+}
+
+void BoundingVolumeHierarchyTest::constructEmpty() {
+    BoundingVolumeHierarchy bvh{Containers::StridedArrayView1D<const Range3D>{}};
+
+    CORRADE_COMPARE(bvh.primitiveCount(), 0);
+    CORRADE_COMPARE(bvh.nodeCount(), 0);
+    CORRADE_COMPARE(bvh.depth(), 0);
+    CORRADE_COMPARE(bvh.bounds(), Range3D{});
+    CORRADE_VERIFY(bvh.ray({}, Vector3::zAxis()).empty());
+    CORRADE_VERIFY(bvh.sphere({}, 100.0f).empty());
+    CORRADE_VERIFY(!bvh.closestTriangle({}, Vector3::zAxis()));
+}
+
+void BoundingVolumeHierarchyTest::constructSinglePrimitive() {
+    const Range3D box{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}};
+    BoundingVolumeHierarchy bvh{Containers::arrayView(&box, 1)};
+
+    CORRADE_COMPARE(bvh.primitiveCount(), 1);
+    CORRADE_COMPARE(bvh.nodeCount(), 1);
+    CORRADE_COMPARE(bvh.depth(), 1);
+    CORRADE_COMPARE(bvh.bounds(), box);
+    CORRADE_COMPARE_AS(bvh.ray({2.0f, 3.0f, -10.0f}, Vector3::zAxis()),
+        Containers::arrayView<UnsignedInt>({0}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(bvh.ray({0.0f, 3.0f, -10.0f}, Vector3::zAxis()).empty());
+}
+
+void BoundingVolumeHierarchyTest::constructCoincidentPrimitives() {
+    /* All centroids are the same, so the binning can't split anything and it
+       has to fall back to splitting in half */
+    std::vector<Range3D> boxes;
+    for(std::size_t i = 0; i != 100; ++i)
+        boxes.push_back(Range3D::fromCenter({}, Vector3{1.0f + i*0.01f}));
+
+    BoundingVolumeHierarchy bvh{Containers::arrayView(boxes), 4};
+    CORRADE_COMPARE(bvh.primitiveCount(), 100);
+    CORRADE_VERIFY(bvh.depth() <= 7);
+    CORRADE_COMPARE(bvh.bounds(), Range3D::fromCenter({}, Vector3{1.99f}));
+    CORRADE_COMPARE(bvh.sphere({}, 0.1f).size(), 100);
+}
+
+void BoundingVolumeHierarchyTest::constructZeroLeafSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Range3D box;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BoundingVolumeHierarchy{Containers::arrayView(&box, 1), 0};
+    BoundingVolumeHierarchy{Primitives::cubeSolid(), 0};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy: max leaf size can't be zero\n"
+        "MeshTools::BoundingVolumeHierarchy: max leaf size can't be zero\n");
+}
+
+void BoundingVolumeHierarchyTest::constructMove() {
+    const std::vector<Range3D> boxes = randomBoxes(100);
+    BoundingVolumeHierarchy a{Containers::arrayView(boxes)};
+    const UnsignedInt nodeCount = a.nodeCount();
+
+    BoundingVolumeHierarchy b{std::move(a)};
+    CORRADE_COMPARE(a.primitiveCount(), 0);
+    CORRADE_COMPARE(b.primitiveCount(), 100);
+    CORRADE_COMPARE(b.nodeCount(), nodeCount);
+
+    BoundingVolumeHierarchy c{Containers::arrayView(boxes).prefix(3)};
+    c = std::move(b);
+    CORRADE_COMPARE(b.primitiveCount(), 3);
+    CORRADE_COMPARE(c.primitiveCount(), 100);
+    CORRADE_COMPARE(c.nodeCount(), nodeCount);
+
+    CORRADE_VERIFY(!std::is_copy_constructible<BoundingVolumeHierarchy>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<BoundingVolumeHierarchy>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<BoundingVolumeHierarchy>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<BoundingVolumeHierarchy>::value);
+}
+
+void BoundingVolumeHierarchyTest::constructMesh() {
+    auto&& data = MeshIndexedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData sphere = Primitives::icosphereSolid(2);
+    if(!data.indexed) sphere = MeshTools::duplicate(sphere);
+
+    BoundingVolumeHierarchy bvh{sphere};
+    CORRADE_VERIFY(bvh.hasTriangles());
+    CORRADE_COMPARE(bvh.primitiveCount(), 320);
+
+    const Containers::Array<Vector3> positions = sphere.positions3DAsArray();
+    Range3D bounds{positions[0], positions[0]};
+    for(const Vector3& i: positions)
+        bounds = {Math::min(bounds.min(), i), Math::max(bounds.max(), i)};
+    CORRADE_COMPARE(bvh.bounds(), bounds);
+
+    /* The first triangle bounds should match */
+    Vector3 a, b, c;
+    if(data.indexed) {
+        const Containers::Array<UnsignedInt> indices = sphere.indicesAsArray();
+        a = positions[indices[0]];
+        b = positions[indices[1]];
+        c = positions[indices[2]];
+    } else {
+        a = positions[0];
+        b = positions[1];
+        c = positions[2];
+    }
+    CORRADE_COMPARE(bvh.primitive(0), (Range3D{Math::min(a, Math::min(b, c)), Math::max(a, Math::max(b, c))}));
+}
+
+void BoundingVolumeHierarchyTest::constructMeshNotTriangles() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BoundingVolumeHierarchy{Primitives::cubeSolidStrip()};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy: expected a triangle mesh, got MeshPrimitive::TriangleStrip\n");
+}
+
+void BoundingVolumeHierarchyTest::constructMeshNoPositions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BoundingVolumeHierarchy{Trade::MeshData{MeshPrimitive::Triangles, 3}};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy: the mesh has no positions\n");
+}
+
+void BoundingVolumeHierarchyTest::primitiveOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const std::vector<Range3D> boxes = randomBoxes(10);
+    BoundingVolumeHierarchy bvh{Containers::arrayView(boxes)};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    bvh.primitive(10);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy::primitive(): index 10 out of range for 10 primitives\n");
+}
+
+void BoundingVolumeHierarchyTest::ray() {
+    auto&& data = LeafSizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::vector<Range3D> boxes = randomBoxes(1000);
+    BoundingVolumeHierarchy bvh{Containers::arrayView(boxes), data.maxLeafSize};
+
+    const struct {
+        Vector3 origin, direction;
+        Float maxDistance;
+    } rays[]{
+        {{-15.0f, 0.3f, 0.2f}, Vector3::xAxis(), Constants::inf()},
+        {{-15.0f, 0.3f, 0.2f}, Vector3::xAxis(), 12.0f},
+        {{12.0f, 12.0f, 12.0f}, Vector3{-1.0f, -0.9f, -1.1f}, Constants::inf()},
+        {{0.0f, 0.0f, 0.0f}, Vector3::yAxis(-3.0f), 2.0f},
+        {{0.0f, 20.0f, 0.0f}, Vector3::yAxis(), Constants::inf()}
+    };
+
+    for(const auto& r: rays) {
+        std::vector<UnsignedInt> expected;
+        for(UnsignedInt i = 0; i != boxes.size(); ++i)
+            if(rayBox(r.origin, r.direction, r.maxDistance, boxes[i]))
+                expected.push_back(i);
+
+        CORRADE_COMPARE_AS(sorted(bvh.ray(r.origin, r.direction, r.maxDistance)),
+            expected,
+            TestSuite::Compare::Container);
+    }
+}
+
+void BoundingVolumeHierarchyTest::frustum() {
+    auto&& data = LeafSizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::vector<Range3D> boxes = randomBoxes(1000);
+    BoundingVolumeHierarchy bvh{Containers::arrayView(boxes), data.maxLeafSize};
+
+    const Frustum frustum = Frustum::fromMatrix(
+        Matrix4::perspectiveProjection(35.0_degf, 1.0f, 0.1f, 15.0f)*
+        Matrix4::lookAt({0.0f, 0.0f, 20.0f}, {}, Vector3::yAxis()).inverted());
+
+    std::vector<UnsignedInt> expected;
+    for(UnsignedInt i = 0; i != boxes.size(); ++i)
+        if(Math::Intersection::rangeFrustum(boxes[i], frustum))
+            expected.push_back(i);
+
+    /* Verify it's not testing a degenerate case */
+    CORRADE_VERIFY(!expected.empty());
+    CORRADE_VERIFY(expected.size() < boxes.size());
+
+    CORRADE_COMPARE_AS(sorted(bvh.frustum(frustum)),
+        expected,
+        TestSuite::Compare::Container);
+}
+
+void BoundingVolumeHierarchyTest::sphere() {
+    auto&& data = LeafSizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::vector<Range3D> boxes = randomBoxes(1000);
+    BoundingVolumeHierarchy bvh{Containers::arrayView(boxes), data.maxLeafSize};
+
+    for(const Vector3& center: {Vector3{}, Vector3{5.0f, -3.0f, 9.0f}, Vector3{30.0f}}) {
+        std::vector<UnsignedInt> expected;
+        for(UnsignedInt i = 0; i != boxes.size(); ++i)
+            if(sphereBox(center, 4.0f, boxes[i]))
+                expected.push_back(i);
+
+        CORRADE_COMPARE_AS(sorted(bvh.sphere(center, 4.0f)),
+            expected,
+            TestSuite::Compare::Container);
+    }
+}
+
+void BoundingVolumeHierarchyTest::refit() {
+    auto&& data = LeafSizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::vector<Range3D> boxes = randomBoxes(1000);
+    BoundingVolumeHierarchy bvh{Containers::arrayView(boxes), data.maxLeafSize};
+    const UnsignedInt nodeCount = bvh.nodeCount();
+
+    /* Move every other box somewhere else */
+    const std::vector<Range3D> other = randomBoxes(1000, 7);
+    for(std::size_t i = 0; i < boxes.size(); i += 2)
+        boxes[i] = other[i];
+    bvh.refit(Containers::arrayView(boxes));
+
+    /* The topology stays the same */
+    CORRADE_COMPARE(bvh.nodeCount(), nodeCount);
+    CORRADE_COMPARE(bvh.primitive(136), other[136]);
+
+    std::vector<UnsignedInt> expected;
+    for(UnsignedInt i = 0; i != boxes.size(); ++i)
+        if(sphereBox({1.0f, 2.0f, -3.0f}, 5.0f, boxes[i]))
+            expected.push_back(i);
+
+    CORRADE_COMPARE_AS(sorted(bvh.sphere({1.0f, 2.0f, -3.0f}, 5.0f)),
+        expected,
+        TestSuite::Compare::Container);
+}
+
+void BoundingVolumeHierarchyTest::refitWrongCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const std::vector<Range3D> boxes = randomBoxes(10);
+    BoundingVolumeHierarchy bvh{Containers::arrayView(boxes)};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    bvh.refit(Containers::arrayView(boxes).prefix(9));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy::refit(): expected 10 primitives but got 9\n");
+}
+
+void BoundingVolumeHierarchyTest::refitMesh() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    BoundingVolumeHierarchy bvh{Primitives::cubeSolid()};
+    const std::vector<Range3D> boxes = randomBoxes(12);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    bvh.refit(Containers::arrayView(boxes));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy::refit(): can't refit a hierarchy built from a mesh\n");
+}
+
+void BoundingVolumeHierarchyTest::closestTriangle() {
+    auto&& data = LeafSizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Trade::MeshData sphere = MeshTools::duplicate(Primitives::icosphereSolid(3));
+    BoundingVolumeHierarchy bvh{sphere, data.maxLeafSize};
+    const Containers::Array<Vector3> positions = sphere.positions3DAsArray();
+
+    /* Rays from various directions towards the center, should hit the near
+       side of the sphere at distance of roughly 4 */
+    for(const Vector3& origin: {Vector3::zAxis(5.0f), Vector3::xAxis(-5.0f), Vector3{3.0f, 2.5f, -2.9f}.normalized()*5.0f}) {
+        const Vector3 direction = -origin.normalized();
+
+        /* Brute force, nearest hit with the lowest ID */
+        UnsignedInt expectedId = ~UnsignedInt{};
+        Float expectedDistance = Constants::inf();
+        for(UnsignedInt i = 0; i != positions.size()/3; ++i) {
+            const Vector3 e1 = positions[i*3 + 1] - positions[i*3];
+            const Vector3 e2 = positions[i*3 + 2] - positions[i*3];
+            const Vector3 p = Math::cross(direction, e2);
+            const Float determinant = Math::dot(e1, p);
+            if(determinant == 0.0f) continue;
+            const Float inverseDeterminant = 1.0f/determinant;
+            const Vector3 s = origin - positions[i*3];
+            const Float u = Math::dot(s, p)*inverseDeterminant;
+            const Vector3 q = Math::cross(s, e1);
+            const Float v = Math::dot(direction, q)*inverseDeterminant;
+            if(u < 0.0f || v < 0.0f || u + v > 1.0f) continue;
+            const Float t = Math::dot(e2, q)*inverseDeterminant;
+            if(t >= 0.0f && t < expectedDistance) {
+                expectedDistance = t;
+                expectedId = i;
+            }
+        }
+
+        Containers::Optional<std::pair<UnsignedInt, Float>> hit = bvh.closestTriangle(origin, direction);
+        CORRADE_VERIFY(hit);
+        CORRADE_COMPARE(hit->first, expectedId);
+        CORRADE_COMPARE(hit->second, expectedDistance);
+        CORRADE_COMPARE_WITH(hit->second, 4.0f, TestSuite::Compare::around(0.05f));
+    }
+}
+
+void BoundingVolumeHierarchyTest::closestTriangleMiss() {
+    BoundingVolumeHierarchy bvh{Primitives::icosphereSolid(1)};
+
+    /* Pointing away */
+    CORRADE_VERIFY(!bvh.closestTriangle(Vector3::zAxis(5.0f), Vector3::zAxis()));
+    /* Passing by */
+    CORRADE_VERIFY(!bvh.closestTriangle({1.5f, 0.0f, 5.0f}, -Vector3::zAxis()));
+}
+
+void BoundingVolumeHierarchyTest::closestTriangleMaxDistance() {
+    BoundingVolumeHierarchy bvh{Primitives::cubeSolid()};
+
+    /* The cube front face is at distance 4 with direction of length 2 */
+    CORRADE_VERIFY(!bvh.closestTriangle(Vector3::zAxis(9.0f), Vector3::zAxis(-2.0f), 3.9f));
+    Containers::Optional<std::pair<UnsignedInt, Float>> hit = bvh.closestTriangle(Vector3::zAxis(9.0f), Vector3::zAxis(-2.0f), 4.1f);
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->second, 4.0f);
+}
+
+void BoundingVolumeHierarchyTest::closestTriangleNotMesh() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const std::vector<Range3D> boxes = randomBoxes(10);
+    BoundingVolumeHierarchy bvh{Containers::arrayView(boxes)};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    bvh.closestTriangle({}, Vector3::zAxis());
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy::closestTriangle(): the hierarchy wasn't built from a mesh\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BoundingVolumeHierarchyTest)
@@ -35,10 +35,13 @@
 #include <Corrade/Utility/String.h>
 
 #include "Magnum/PixelFormat.h"
+#include "Magnum/Tracer.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/MeshTools/Reference.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImporterCache.h"
 #include "Magnum/Trade/MeshData.h"
 #include "Magnum/Trade/MeshObjectData3D.h"
 #include "Magnum/Trade/AbstractSceneConverter.h"
@@ -76,7 +79,7 @@ magnum-sceneconverter [-h|--help] [--importer IMPORTER]
     [-i|--importer-options key=val,key2=val2,…]
     [-c|--converter-options key=val,key2=val2,…]... [--mesh MESH]
     [--level LEVEL] [--info] [--bounds] [-v|--verbose] [--profile]
-    [--] input output
+    [--profile-trace FILE] [--cache DIR] [--] input output
 @endcode
 
 Arguments:
@@ -105,6 +108,10 @@ Arguments:
 -   `--bounds` --- show bounds of known attributes in `--info` output
 -   `-v`, `--verbose` --- verbose output from importer and converter plugins
 -   `--profile` --- measure import and conversion time
+-   `--profile-trace FILE` --- save a timeline of the import and conversion
+    to a Chrome trace_event JSON file using @ref Tracer
+-   `--cache DIR` --- cache imported and processed meshes in given directory
+    using @ref Trade::ImporterCache
 
 If `--info` is given, the utility will print information about all meshes
 and images present in the file.
@@ -126,6 +133,22 @@ doesn't support conversion to a file,
 if no `--converter` is specified, @ref Trade::AnySceneConverter "AnySceneConverter"
 is used.
 
+If `--cache` is given, the imported mesh, including the effect of
+`--only-attributes`, `--remove-duplicates` and `--remove-duplicates-fuzzy`,
+is stored in the cache directory. Subsequent runs on the same input file with
+the same importer, importer options and processing options then take the mesh
+from the cache, skipping both the import and the processing. The cache is not
+used for `--info`.
+
+If `--profile-trace` is given, the import, processing and conversion steps are
+recorded as zones of a timeline that's saved to a JSON file on exit, which can
+be then opened in `chrome://tracing` or other compatible viewers. If Magnum is
+built with the `BUILD_TRACING` CMake option enabled, the timeline includes also
+zones from inside @ref MeshTools and @ref Trade::AbstractImporter, see
+@ref MAGNUM_BUILD_TRACING for more information. The timeline is saved also if
+the conversion fails. If it can't be saved, the utility exits with a non-zero
+code.
+
 @section magnum-sceneconverter-example Example usage
 
 Printing info about all meshes in a glTF file:
@@ -161,8 +184,9 @@ using namespace Magnum;
 
 namespace {
 
+/* Also records a zone for --profile-trace, if there's an active tracer */
 struct Duration {
-    explicit Duration(std::chrono::high_resolution_clock::duration& output): _output(output), _t{std::chrono::high_resolution_clock::now()} {}
+    explicit Duration(std::chrono::high_resolution_clock::duration& output, const char* name): _output(output), _zone{name}, _t{std::chrono::high_resolution_clock::now()} {}
 
     ~Duration() {
         _output += std::chrono::high_resolution_clock::now() - _t;
@@ -170,6 +194,7 @@ struct Duration {
 
     private:
         std::chrono::high_resolution_clock::duration& _output;
+        Tracer::Zone _zone;
         std::chrono::high_resolution_clock::time_point _t;
 };
 
@@ -190,52 +215,73 @@ UnsignedInt namedAttributeId(const Trade::MeshData& mesh, UnsignedInt id) {
     CORRADE_INTERNAL_ASSERT_UNREACHABLE();
 }
 
-}
+/* Post-import processing, passed to Trade::ImporterCache as well */
+struct Processing {
+    const Utility::Arguments& args;
+    std::chrono::high_resolution_clock::duration& conversionTime;
+};
 
-int main(int argc, char** argv) {
-    Utility::Arguments args;
-    args.addArgument("input").setHelp("input", "input file")
-        .addArgument("output").setHelp("output", "output file")
-        .addOption("importer", "AnySceneImporter").setHelp("importer", "scene importer plugin")
-        .addArrayOption("converter").setHelp("converter", "scene converter plugin(s)")
-        .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
-        .addOption("only-attributes").setHelp("only-attributes", "include only attributes of given IDs in the output", "\"i j …\"")
-        .addBooleanOption("remove-duplicates").setHelp("remove-duplicates", "remove duplicate vertices in the mesh after import")
-        .addOption("remove-duplicates-fuzzy").setHelp("remove-duplicates-fuzzy", "remove duplicate vertices with fuzzy comparison in the mesh after import", "EPSILON")
-        .addOption('i', "importer-options").setHelp("importer-options", "configuration options to pass to the importer", "key=val,key2=val2,…")
-        .addArrayOption('c', "converter-options").setHelp("converter-options", "configuration options to pass to the converter(s)", "key=val,key2=val2,…")
-        .addOption("mesh", "0").setHelp("mesh", "mesh to import")
-        .addOption("level", "0").setHelp("level", "mesh level to import")
-        .addBooleanOption("info").setHelp("info", "print info about the input file and exit")
-        .addBooleanOption("bounds").setHelp("bounds", "show bounds of known attributes in --info output")
-        .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from importer and converter plugins")
-        .addBooleanOption("profile").setHelp("profile", "measure import and conversion time")
-        .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
-            /* If --info is passed, we don't need the output argument */
-            if(error == Utility::Arguments::ParseError::MissingArgument &&
-                key == "output" && args.isSet("info")) return true;
+Containers::Optional<Trade::MeshData> processMesh(Trade::MeshData&& imported, void* state) {
+    const Utility::Arguments& args = static_cast<Processing*>(state)->args;
+    std::chrono::high_resolution_clock::duration& conversionTime = static_cast<Processing*>(state)->conversionTime;
+    Containers::Optional<Trade::MeshData> mesh{std::move(imported)};
 
-            /* Handle all other errors as usual */
-            return false;
-        })
-        .setGlobalHelp(R"(Converts scenes of different formats.
+    /* Filter attributes, if requested */
+    if(!args.value("only-attributes").empty()) {
+        std::set<UnsignedInt> only;
+        for(const std::string& i: Utility::String::split(args.value("only-attributes"), ' '))
+            only.insert(std::stoi(i));
 
-If --info is given, the utility will print information about all meshes and
-images present in the file.
+        Containers::Array<Trade::MeshAttributeData> attributes;
+        for(UnsignedInt i = 0; i != mesh->attributeCount(); ++i) {
+            if(only.find(i) != only.end())
+                arrayAppend(attributes, mesh->attributeData(i));
+        }
 
-The -i / --importer-options and -c / --converter-options arguments accept a
-comma-separated list of key/value pairs to set in the importer / converter
-plugin configuration. If the = character is omitted, it's equivalent to saying
-key=true; configuration subgroups are delimited with /.
+        const Trade::MeshIndexData indices{mesh->indices()};
+        const UnsignedInt vertexCount = mesh->vertexCount();
+        mesh = Trade::MeshData{mesh->primitive(),
+            mesh->releaseIndexData(), indices,
+            mesh->releaseVertexData(), std::move(attributes),
+            vertexCount};
+    }
 
-It's possible to specify the --converter option (and correspondingly also
--c / --converter-options) multiple times in order to chain more converters
-together. All converters in the chain have to support the ConvertMesh feature,
-the last converter either ConvertMesh or ConvertMeshToFile. If the last
-converter doesn't support conversion to a file, AnySceneConverter is used to
-save its output; if no --converter is specified, AnySceneConverter is used.)")
-        .parse(argc, argv);
+    /* Remove duplicates, if requested */
+    if(args.isSet("remove-duplicates")) {
+        const UnsignedInt beforeVertexCount = mesh->vertexCount();
+        {
+            Duration d{conversionTime, "Removing duplicates"};
+            mesh = MeshTools::removeDuplicates(*std::move(mesh));
+        }
+        if(args.isSet("verbose"))
+            Debug{} << "Duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
+    }
+
+    /* Remove duplicates with fuzzy comparison, if requested */
+    /** @todo accept two values for float and double fuzzy comparison */
+    if(!args.value("remove-duplicates-fuzzy").empty()) {
+        const UnsignedInt beforeVertexCount = mesh->vertexCount();
+        {
+            Duration d{conversionTime, "Removing duplicates with fuzzy comparison"};
+            mesh = MeshTools::removeDuplicatesFuzzy(*std::move(mesh), args.value<Float>("remove-duplicates-fuzzy"));
+        }
+        if(args.isSet("verbose"))
+            Debug{} << "Fuzzy duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
+    }
+
+    return mesh;
+}
 
+/* Name of the post-import processing, used as a part of the cache key */
+std::string processingName(const Utility::Arguments& args) {
+    return Utility::formatString("only-attributes={};remove-duplicates={};remove-duplicates-fuzzy={}",
+        args.value("only-attributes"),
+        args.isSet("remove-duplicates") ? "true" : "false",
+        args.value("remove-duplicates-fuzzy"));
+}
+
+/* Everything after argument parsing, returns the exit code */
+int convert(const Utility::Arguments& args) {
     PluginManager::Manager<Trade::AbstractImporter> importerManager{
         args.value("plugin-dir").empty() ? std::string{} :
         Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths()[0])};
@@ -252,9 +298,10 @@ save its output; if no --converter is specified, AnySceneConverter is used.)")
 
     std::chrono::high_resolution_clock::duration importTime;
 
-    /* Open the file */
-    {
-        Duration d{importTime};
+    /* Open the file. If the cache is used, the importer gets opened lazily
+       only if the mesh isn't cached yet. */
+    if(args.value("cache").empty() || args.isSet("info")) {
+        Duration d{importTime, "Opening the file"};
         if(!importer->openFile(args.value("input"))) {
             Error() << "Cannot open file" << args.value("input");
             return 3;
@@ -306,7 +353,7 @@ save its output; if no --converter is specified, AnySceneConverter is used.)")
             for(UnsignedInt j = 0; j != importer->meshLevelCount(i); ++j) {
                 Containers::Optional<Trade::MeshData> mesh;
                 {
-                    Duration d{importTime};
+                    Duration d{importTime, "Importing a mesh"};
                     if(!(mesh = importer->mesh(i, j))) {
                         error = true;
                         continue;
@@ -449,58 +496,48 @@ save its output; if no --converter is specified, AnySceneConverter is used.)")
         return error ? 1 : 0;
     }
 
-    Containers::Optional<Trade::MeshData> mesh;
-    {
-        Duration d{importTime};
-        if(!importer->meshCount() || !(mesh = importer->mesh(args.value<UnsignedInt>("mesh"), args.value<UnsignedInt>("level")))) {
-            Error{} << "Cannot import the mesh";
-            return 4;
-        }
-    }
-
     std::chrono::high_resolution_clock::duration conversionTime;
+    Processing processing{args, conversionTime};
 
-    /* Filter attributes, if requested */
-    if(!args.value("only-attributes").empty()) {
-        std::set<UnsignedInt> only;
-        for(const std::string& i: Utility::String::split(args.value("only-attributes"), ' '))
-            only.insert(std::stoi(i));
-
-        Containers::Array<Trade::MeshAttributeData> attributes;
-        for(UnsignedInt i = 0; i != mesh->attributeCount(); ++i) {
-            if(only.find(i) != only.end())
-                arrayAppend(attributes, mesh->attributeData(i));
-        }
-
-        const Trade::MeshIndexData indices{mesh->indices()};
-        const UnsignedInt vertexCount = mesh->vertexCount();
-        mesh = Trade::MeshData{mesh->primitive(),
-            mesh->releaseIndexData(), indices,
-            mesh->releaseVertexData(), std::move(attributes),
-            vertexCount};
-    }
-
-    /* Remove duplicates, if requested */
-    if(args.isSet("remove-duplicates")) {
-        const UnsignedInt beforeVertexCount = mesh->vertexCount();
+    /* Import and process the mesh. If a cache directory is specified, the
+       result is taken from there if present, skipping both the import and
+       processing steps. */
+    Containers::Optional<Trade::MeshData> mesh;
+    if(!args.value("cache").empty()) {
+        Trade::ImporterCache cache{*importer, args.value("cache")};
+        cache.setMeshProcessor(processMesh, processingName(args), &processing);
+
+        /* On a cache miss the processing is done inside cache.mesh() and
+           measured into conversionTime, subtract it from the import time so
+           it's not counted twice */
+        const std::chrono::high_resolution_clock::duration conversionTimeBefore = conversionTime;
         {
-            Duration d{conversionTime};
-            mesh = MeshTools::removeDuplicates(*std::move(mesh));
+            Duration d{importTime, "Importing the mesh through the cache"};
+            if(!cache.openFile(args.value("input")) || !(mesh = cache.mesh(args.value<UnsignedInt>("mesh"), args.value<UnsignedInt>("level")))) {
+                Error{} << "Cannot import the mesh";
+                return 4;
+            }
         }
+        importTime -= conversionTime - conversionTimeBefore;
+
         if(args.isSet("verbose"))
-            Debug{} << "Duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
-    }
+            Debug{} << "Cache" << (cache.hitCount() ? "hit" : "miss") << "for" << cache.key();
 
-    /* Remove duplicates with fuzzy comparison, if requested */
-    /** @todo accept two values for float and double fuzzy comparison */
-    if(!args.value("remove-duplicates-fuzzy").empty()) {
-        const UnsignedInt beforeVertexCount = mesh->vertexCount();
+        /* The data may reference memory owned by the cache, make a copy
+           before the cache goes out of scope */
+        if(!(mesh->indexDataFlags() & Trade::DataFlag::Owned) || !(mesh->vertexDataFlags() & Trade::DataFlag::Owned))
+            mesh = MeshTools::owned(*std::move(mesh));
+
+    } else {
         {
-            Duration d{conversionTime};
-            mesh = MeshTools::removeDuplicatesFuzzy(*std::move(mesh), args.value<Float>("remove-duplicates-fuzzy"));
+            Duration d{importTime, "Importing the mesh"};
+            if(!importer->meshCount() || !(mesh = importer->mesh(args.value<UnsignedInt>("mesh"), args.value<UnsignedInt>("level")))) {
+                Error{} << "Cannot import the mesh";
+                return 4;
+            }
         }
-        if(args.isSet("verbose"))
-            Debug{} << "Fuzzy duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
+
+        if(!(mesh = processMesh(*std::move(mesh), &processing))) return 4;
     }
 
     /* Load converter plugin */
@@ -533,7 +570,7 @@ save its output; if no --converter is specified, AnySceneConverter is used.)")
             if(converterCount > 1 && args.isSet("verbose"))
                 Debug{} << "Saving output with" << converterName << Debug::nospace << "...";
 
-            Duration d{conversionTime};
+            Duration d{conversionTime, "Saving the output"};
             if(!converter->convertToFile(args.value("output"), *mesh)) {
                 Error{} << "Cannot save file" << args.value("output");
                 return 5;
@@ -553,7 +590,7 @@ save its output; if no --converter is specified, AnySceneConverter is used.)")
                 return 6;
             }
 
-            Duration d{conversionTime};
+            Duration d{conversionTime, "Converting the mesh"};
             if(!(mesh = converter->convert(*mesh))) {
                 Error{} << converterName << "cannot convert the mesh";
                 return 7;
@@ -565,4 +602,69 @@ save its output; if no --converter is specified, AnySceneConverter is used.)")
         Debug{} << "Import took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(importTime).count())/1.0e3f << "seconds, conversion"
             << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(conversionTime).count())/1.0e3f << "seconds";
     }
+
+    return 0;
+}
+
+}
+
+int main(int argc, char** argv) {
+    Utility::Arguments args;
+    args.addArgument("input").setHelp("input", "input file")
+        .addArgument("output").setHelp("output", "output file")
+        .addOption("importer", "AnySceneImporter").setHelp("importer", "scene importer plugin")
+        .addArrayOption("converter").setHelp("converter", "scene converter plugin(s)")
+        .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
+        .addOption("only-attributes").setHelp("only-attributes", "include only attributes of given IDs in the output", "\"i j …\"")
+        .addBooleanOption("remove-duplicates").setHelp("remove-duplicates", "remove duplicate vertices in the mesh after import")
+        .addOption("remove-duplicates-fuzzy").setHelp("remove-duplicates-fuzzy", "remove duplicate vertices with fuzzy comparison in the mesh after import", "EPSILON")
+        .addOption('i', "importer-options").setHelp("importer-options", "configuration options to pass to the importer", "key=val,key2=val2,…")
+        .addArrayOption('c', "converter-options").setHelp("converter-options", "configuration options to pass to the converter(s)", "key=val,key2=val2,…")
+        .addOption("mesh", "0").setHelp("mesh", "mesh to import")
+        .addOption("level", "0").setHelp("level", "mesh level to import")
+        .addBooleanOption("info").setHelp("info", "print info about the input file and exit")
+        .addBooleanOption("bounds").setHelp("bounds", "show bounds of known attributes in --info output")
+        .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from importer and converter plugins")
+        .addBooleanOption("profile").setHelp("profile", "measure import and conversion time")
+        .addOption("profile-trace").setHelp("profile-trace", "save a timeline of the import and conversion to a Chrome trace_event JSON file", "FILE")
+        .addOption("cache").setHelp("cache", "cache imported and processed meshes in given directory", "DIR")
+        .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
+            /* If --info is passed, we don't need the output argument */
+            if(error == Utility::Arguments::ParseError::MissingArgument &&
+                key == "output" && args.isSet("info")) return true;
+
+            /* Handle all other errors as usual */
+            return false;
+        })
+        .setGlobalHelp(R"(Converts scenes of different formats.
+
+If --info is given, the utility will print information about all meshes and
+images present in the file.
+
+The -i / --importer-options and -c / --converter-options arguments accept a
+comma-separated list of key/value pairs to set in the importer / converter
+plugin configuration. If the = character is omitted, it's equivalent to saying
+key=true; configuration subgroups are delimited with /.
+
+It's possible to specify the --converter option (and correspondingly also
+-c / --converter-options) multiple times in order to chain more converters
+together. All converters in the chain have to support the ConvertMesh feature,
+the last converter either ConvertMesh or ConvertMeshToFile. If the last
+converter doesn't support conversion to a file, AnySceneConverter is used to
+save its output; if no --converter is specified, AnySceneConverter is used.)")
+        .parse(argc, argv);
+
+    /* Record the timeline from the very beginning, so it includes also the
+       plugin loading */
+    Containers::Pointer<Tracer> tracer;
+    if(!args.value("profile-trace").empty())
+        tracer = Containers::Pointer<Tracer>{Containers::InPlaceInit};
+
+    /* Doing the actual work in a separate function so the trace is saved on
+       all exit paths, including failures */
+    const int result = convert(args);
+    if(tracer && !tracer->exportChromeTrace(args.value("profile-trace")))
+        return result ? result : 8;
+
+    return result;
 }
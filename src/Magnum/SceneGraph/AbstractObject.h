@@ -31,6 +31,7 @@
 
 #include <functional>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/LinkedList.h>
 
 #include "Magnum/DimensionTraits.h"
@@ -181,6 +182,23 @@ template<UnsignedInt dimensions, class T> class AbstractObject
             return doTransformationMatrices(objects, finalTransformationMatrix);
         }
 
+        /**
+         * @brief Calculate transformation matrices of given set of objects relative to this object into a preallocated array
+         * @m_since_latest
+         *
+         * Same as @ref transformationMatrices(), but puts the result into
+         * @p out, which is expected to have the same size as @p objects.
+         * Temporary data needed for the calculation are kept in the
+         * @ref Scene, so once they grow large enough, repeated calls with the
+         * same or a smaller amount of objects don't allocate.
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe @ref Object::transformationMatricesInto()
+         *      when possible.
+         */
+        void transformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& finalTransformationMatrix, const Containers::ArrayView<MatrixType>& out) const {
+            doTransformationMatricesInto(objects, finalTransformationMatrix, out);
+        }
+
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
         /**
@@ -266,6 +284,7 @@ template<UnsignedInt dimensions, class T> class AbstractObject
         virtual MatrixType doTransformationMatrix() const = 0;
         virtual MatrixType doAbsoluteTransformationMatrix() const = 0;
         virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& finalTransformationMatrix) const = 0;
+        virtual void doTransformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& finalTransformationMatrix, const Containers::ArrayView<MatrixType>& out) const = 0;
 
         virtual bool doIsDirty() const = 0;
         virtual void doSetDirty() = 0;
@@ -29,8 +29,11 @@
  * @brief Class @ref Magnum::SceneGraph::Camera, enum @ref Magnum::SceneGraph::AspectRatioPolicy, alias @ref Magnum::SceneGraph::BasicCamera2D, @ref Magnum::SceneGraph::BasicCamera3D, typedef @ref Magnum::SceneGraph::Camera2D, @ref Magnum::SceneGraph::Camera3D
  */
 
+#include <Corrade/Containers/StridedArrayView.h>
+
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/AbstractFeature.h"
 #include "Magnum/SceneGraph/visibility.h"
 
@@ -81,6 +84,19 @@ errors. See also @ref compilation-speedup-hpp for more information.
 -   @ref Camera2D
 -   @ref Camera3D
 
+@section SceneGraph-Camera-allocations Memory allocations
+
+Each @ref DrawableGroup keeps a list of objects its drawables are attached to
+and the camera keeps an array of camera-relative transformations, which are
+calculated with @ref AbstractObject::transformationMatricesInto() using
+temporary storage kept in the @ref Scene. All of these get reused across
+frames, so once they grow large enough, @ref draw(DrawableGroup<dimensions, T>&)
+doesn't do any heap allocations. Because of that, the function however
+shouldn't be called recursively from within @ref Drawable::draw() on the
+same camera. The same holds for @ref drawCulled(), which additionally keeps
+arrays of camera-space bounding boxes and their visibility that are reused in
+the same way.
+
 @see @ref scenegraph, @ref BasicCamera2D, @ref BasicCamera3D, @ref Camera2D,
     @ref Camera3D, @ref Drawable, @ref DrawableGroup
 */
@@ -199,11 +215,38 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         /**
          * @brief Draw
          *
-         * Draws given group of drawables.
+         * Draws given group of drawables. See
+         * @ref SceneGraph-Camera-allocations for information about memory
+         * allocations.
          * @see @ref draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>&)
          */
         void draw(DrawableGroup<dimensions, T>& group);
 
+        /**
+         * @brief Draw with culling
+         * @param group         Group of drawables to draw
+         * @param boundingBoxes Bounding boxes of the drawables, relative to
+         *      the objects they're attached to
+         * @return Count of drawables that were drawn
+         * @m_since_latest
+         *
+         * Like @ref draw(DrawableGroup<dimensions, T>&), but skips drawables
+         * with a box in @p boundingBoxes that lies completely outside of the
+         * volume defined by @ref projectionMatrix(). Expects that
+         * @p boundingBoxes has the same size as @p group, with the boxes in
+         * the same order as the drawables. The boxes are transformed to camera
+         * space together with the drawable transformations and then tested
+         * against the projection volume with
+         * @ref Math::Intersection::aabbFrustumInto() all at once. The count of
+         * culled drawables is @ref DrawableGroup::size() minus the returned
+         * value.
+         *
+         * The test is conservative --- a box that's outside of the volume but
+         * intersects more than one of its planes may still get drawn. See
+         * @ref SceneGraph-Drawable-draw-order-builtin-culling for an example.
+         */
+        std::size_t drawCulled(DrawableGroup<dimensions, T>& group, const Containers::StridedArrayView1D<const Math::Range<dimensions, T>>& boundingBoxes);
+
         /**
          * @brief Draw given drawables with transformations
          *
@@ -228,6 +271,13 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         MatrixTypeFor<dimensions, T> _cameraMatrix;
 
         Vector2i _viewport;
+
+        /* Reused by draw() and drawCulled() */
+        std::vector<MatrixTypeFor<dimensions, T>> _drawTransformations;
+        /* Reused by drawCulled(), camera-space box centers followed by
+           half-extents and a visibility bitmask */
+        std::vector<Math::Vector3<T>> _cullingBounds;
+        std::vector<UnsignedByte> _cullingVisibility;
 };
 
 /**
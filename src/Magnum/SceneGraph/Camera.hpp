@@ -29,7 +29,10 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Camera.h
  */
 
+#include "Magnum/Math/Frustum.h"
 #include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
 
@@ -53,6 +56,36 @@ template<UnsignedInt dimensions, class T> MatrixTypeFor<dimensions, T> aspectRat
         Math::Vector2<T>(T(1), relativeAspectRatio.x()/relativeAspectRatio.y()), T(1)));
 }
 
+/* The culling is done with a 3D frustum, a 2D projection is extended to 3D
+   with an identity Z, where the near and far planes are then at -1 and +1 and
+   the boxes, being at Z = 0 with zero extent, are always between them */
+template<class T> Math::Frustum<T> cullingFrustum(const Math::Matrix4<T>& projectionMatrix) {
+    return Math::Frustum<T>::fromMatrix(projectionMatrix);
+}
+
+template<class T> Math::Frustum<T> cullingFrustum(const Math::Matrix3<T>& projectionMatrix) {
+    const Math::Vector3<T> x = projectionMatrix.row(0);
+    const Math::Vector3<T> y = projectionMatrix.row(1);
+    const Math::Vector3<T> w = projectionMatrix.row(2);
+    return Math::Frustum<T>::fromMatrix(Math::Matrix4<T>{
+        {x[0], y[0], T(0), w[0]},
+        {x[1], y[1], T(0), w[1]},
+        {T(0), T(0), T(1), T(0)},
+        {x[2], y[2], T(0), w[2]}});
+}
+
+/* The batch function is for floats only, doubles are tested one by one */
+inline void cullBoxes(const Containers::StridedArrayView1D<const Vector3>& centers, const Containers::StridedArrayView1D<const Vector3>& extents, const Frustum& frustum, const Containers::ArrayView<UnsignedByte>& visibility) {
+    Math::Intersection::aabbFrustumInto(centers, extents, frustum, visibility);
+}
+
+template<class T> void cullBoxes(const Containers::StridedArrayView1D<const Math::Vector3<T>>& centers, const Containers::StridedArrayView1D<const Math::Vector3<T>>& extents, const Math::Frustum<T>& frustum, const Containers::ArrayView<UnsignedByte>& visibility) {
+    for(UnsignedByte& i: visibility) i = 0;
+    for(std::size_t i = 0; i != centers.size(); ++i)
+        if(Math::Intersection::aabbFrustum(centers[i], extents[i], frustum))
+            visibility[i/8] |= 1 << i%8;
+}
+
 }
 
 template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved) {
@@ -90,12 +123,8 @@ template<UnsignedInt dimensions, class T> std::vector<std::pair<std::reference_w
     AbstractFeature<dimensions, T>::object().setClean();
 
     /* Compute transformations of all objects in the group relative to the camera */
-    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
-    objects.reserve(group.size());
-    for(std::size_t i = 0; i != group.size(); ++i)
-        objects.push_back(group[i].object());
     std::vector<MatrixTypeFor<dimensions, T>> transformations =
-        scene->transformationMatrices(objects, _cameraMatrix);
+        scene->transformationMatrices(group._objects, _cameraMatrix);
 
     /* Combine drawable references and transformation matrices */
     std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>> combined;
@@ -113,17 +142,71 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(Drawa
     /* Compute camera matrix */
     AbstractFeature<dimensions, T>::object().setClean();
 
-    /* Compute transformations of all objects in the group relative to the camera */
-    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
-    objects.reserve(group.size());
-    for(std::size_t i = 0; i != group.size(); ++i)
-        objects.push_back(group[i].object());
-    std::vector<MatrixTypeFor<dimensions, T>> transformations =
-        scene->transformationMatrices(objects, _cameraMatrix);
+    /* Compute transformations of all objects in the group relative to the
+       camera. Both the object list and the output are reused between calls,
+       so this doesn't allocate in the steady state. */
+    _drawTransformations.resize(group.size());
+    scene->transformationMatricesInto(group._objects, _cameraMatrix,
+        Containers::arrayView(_drawTransformations.data(), _drawTransformations.size()));
 
     /* Perform the drawing */
-    for(std::size_t i = 0; i != transformations.size(); ++i)
-        group[i].draw(transformations[i], *this);
+    for(std::size_t i = 0; i != group.size(); ++i)
+        group[i].draw(_drawTransformations[i], *this);
+}
+
+template<UnsignedInt dimensions, class T> std::size_t Camera<dimensions, T>::drawCulled(DrawableGroup<dimensions, T>& group, const Containers::StridedArrayView1D<const Math::Range<dimensions, T>>& boundingBoxes) {
+    AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::Camera::drawCulled(): cannot draw when camera is not part of any scene", {});
+    CORRADE_ASSERT(boundingBoxes.size() == group.size(),
+        "SceneGraph::Camera::drawCulled(): expected" << group.size() << "bounding boxes but got" << boundingBoxes.size(), {});
+
+    /* Compute camera matrix */
+    AbstractFeature<dimensions, T>::object().setClean();
+
+    /* Compute transformations of all objects in the group relative to the
+       camera, the same as in draw() */
+    const std::size_t count = group.size();
+    _drawTransformations.resize(count);
+    scene->transformationMatricesInto(group._objects, _cameraMatrix,
+        Containers::arrayView(_drawTransformations.data(), _drawTransformations.size()));
+
+    /* Transform the bounding boxes to camera space. The transformed box is
+       the smallest axis-aligned box enclosing the original one, with extents
+       calculated using absolute values of the rotation/scaling part. 2D boxes
+       are put at Z = 0 with zero extent in Z. */
+    _cullingBounds.resize(2*count);
+    const Containers::ArrayView<Math::Vector3<T>> centers = Containers::arrayView(_cullingBounds.data(), count);
+    const Containers::ArrayView<Math::Vector3<T>> extents = Containers::arrayView(_cullingBounds.data() + count, count);
+    for(std::size_t i = 0; i != count; ++i) {
+        const Math::Range<dimensions, T>& box = boundingBoxes[i];
+        const MatrixTypeFor<dimensions, T>& transformation = _drawTransformations[i];
+        const Math::Vector<dimensions, T> halfSize = box.size()/T(2);
+        Math::Vector<dimensions, T> extent;
+        for(UnsignedInt j = 0; j != dimensions; ++j)
+            for(UnsignedInt k = 0; k != dimensions; ++k)
+                extent[j] += Math::abs(transformation[k][j])*halfSize[k];
+        centers[i] = Math::Vector3<T>::pad(transformation.transformPoint(box.center()));
+        extents[i] = Math::Vector3<T>::pad(extent);
+    }
+
+    /* Test all boxes against the projection volume, which is in camera space
+       already */
+    _cullingVisibility.resize((count + 7)/8);
+    Implementation::cullBoxes(
+        Containers::StridedArrayView1D<const Math::Vector3<T>>{centers},
+        Containers::StridedArrayView1D<const Math::Vector3<T>>{extents},
+        Implementation::cullingFrustum(_projectionMatrix),
+        Containers::arrayView(_cullingVisibility.data(), _cullingVisibility.size()));
+
+    /* Draw the visible ones */
+    std::size_t visibleCount = 0;
+    for(std::size_t i = 0; i != count; ++i) {
+        if(!(_cullingVisibility[i/8] & (1 << i%8))) continue;
+        group[i].draw(_drawTransformations[i], *this);
+        ++visibleCount;
+    }
+
+    return visibleCount;
 }
 
 template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>& drawableTransformations) {
@@ -133,6 +133,17 @@ get used in any way except being passed to the draw function:
 
 @snippet MagnumSceneGraph.cpp Drawable-culling
 
+@subsection SceneGraph-Drawable-draw-order-builtin-culling Builtin culling
+
+Alternatively, if there's a bounding box for each drawable, relative to the
+object it's attached to, the camera can do the culling on its own with
+@ref Camera::drawCulled(). The boxes are passed in the same order as the
+drawables are in the group, get transformed to camera space together with the
+drawable transformations and drawables with boxes outside of the camera
+projection volume are skipped.
+
+@snippet MagnumSceneGraph.cpp Drawable-culling-builtin
+
 @section SceneGraph-Drawable-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
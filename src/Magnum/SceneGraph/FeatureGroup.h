@@ -60,6 +60,7 @@ template<UnsignedInt dimensions, class T> class AbstractFeatureGroup {
 
     private:
         template<UnsignedInt, class, class> friend class FeatureGroup;
+        template<UnsignedInt, class> friend class Camera;
 
         explicit AbstractFeatureGroup();
         virtual ~AbstractFeatureGroup();
@@ -68,6 +69,9 @@ template<UnsignedInt dimensions, class T> class AbstractFeatureGroup {
         void remove(AbstractFeature<dimensions, T>& feature);
 
         std::vector<std::reference_wrapper<AbstractFeature<dimensions, T>>> _features;
+        /* Objects of all features, in the same order. Cached so
+           Camera::draw() doesn't need to assemble the list every time. */
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> _objects;
 };
 
 /**
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 
+#include "Magnum/SceneGraph/AbstractFeature.h"
 #include "Magnum/SceneGraph/FeatureGroup.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -40,11 +41,14 @@ template<UnsignedInt dimensions, class T> AbstractFeatureGroup<dimensions, T>::~
 
 template<UnsignedInt dimensions, class T> void AbstractFeatureGroup<dimensions, T>::add(AbstractFeature<dimensions, T>& feature) {
     _features.push_back(feature);
+    _objects.push_back(feature.object());
 }
 
 template<UnsignedInt dimensions, class T> void AbstractFeatureGroup<dimensions, T>::remove(AbstractFeature<dimensions, T>& feature) {
-    _features.erase(std::find_if(_features.begin(), _features.end(),
-        [&feature](AbstractFeature<dimensions, T>& f) { return &f == &feature; }));
+    const std::size_t index = std::find_if(_features.begin(), _features.end(),
+        [&feature](AbstractFeature<dimensions, T>& f) { return &f == &feature; }) - _features.begin();
+    _features.erase(_features.begin() + index);
+    _objects.erase(_objects.begin() + index);
 }
 
 }}
@@ -0,0 +1,265 @@
+#ifndef Magnum_SceneGraph_FlatTransformationHierarchy_h
+#define Magnum_SceneGraph_FlatTransformationHierarchy_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::FlatTransformationHierarchy, alias @ref Magnum::SceneGraph::BasicFlatTransformationHierarchy2D, @ref Magnum::SceneGraph::BasicFlatTransformationHierarchy3D, typedef @ref Magnum::SceneGraph::FlatTransformationHierarchy2D, @ref Magnum::SceneGraph::FlatTransformationHierarchy3D
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Flat transformation hierarchy
+@m_since_latest
+
+A data-oriented alternative to a tree of @ref Object instances for cases
+where the hierarchy consists of a large amount of objects that only need to
+have their absolute transformations calculated. Instead of intrusive linked
+lists the hierarchy is described by a contiguous array of parent indices, with
+relative and absolute transformation matrices stored in two contiguous arrays
+next to it.
+
+@section SceneGraph-FlatTransformationHierarchy-usage Usage
+
+The hierarchy is created from a list of parent indices, with @cpp -1 @ce
+denoting top-level objects. The list is expected to be ordered so a parent is
+always listed before all its children --- for a scene imported from a file
+such list can be created with @ref Trade::SceneData::hierarchy3D(). All
+relative transformations are initially set to identity.
+
+@code{.cpp}
+// 0
+// |-- 1
+// |   \-- 2
+// \-- 3
+// 4
+SceneGraph::FlatTransformationHierarchy3D hierarchy{-1, 0, 1, 0, -1};
+hierarchy
+    .setTransformation(1, Matrix4::translation(Vector3::xAxis(3.0f)))
+    .setTransformation(2, Matrix4::rotationZ(35.0_degf));
+
+hierarchy.setClean();
+Matrix4 absolute = hierarchy.absoluteTransformation(2);
+@endcode
+
+@section SceneGraph-FlatTransformationHierarchy-dirty Dirty range tracking
+
+Updating a relative transformation using @ref setTransformation() or
+@ref setTransformations() doesn't recalculate anything, it only extends a
+single range of objects that need to be recalculated, available through
+@ref dirtyRange(). Because children are always after their parent, the range
+starts at the first updated object. Its end is the end of the furthest
+updated subtree, which is precalculated for every object during construction.
+
+The @ref setClean() function then goes linearly over the dirty range,
+multiplying each relative transformation with an already calculated absolute
+transformation of its parent. Compared to @ref Object::setClean(), there are
+no allocations, no linked list traversal and no per-object flags involved.
+Objects that are in the dirty range but weren't affected by the change get
+recalculated as well, which is generally still faster than tracking them
+individually. To get the most out of the range tracking, keep objects that
+are updated frequently together, ideally at the end.
+
+@see @ref scenegraph, @ref BasicFlatTransformationHierarchy2D,
+    @ref BasicFlatTransformationHierarchy3D,
+    @ref FlatTransformationHierarchy2D, @ref FlatTransformationHierarchy3D
+*/
+template<UnsignedInt dimensions, class T> class FlatTransformationHierarchy {
+    public:
+        /** @brief Transformation matrix type */
+        typedef MatrixTypeFor<dimensions, T> MatrixType;
+
+        /**
+         * @brief Constructor
+         * @param parents   Index of a parent for each object or @cpp -1 @ce
+         *      for top-level objects
+         *
+         * Expects that each parent index is less than index of the object
+         * itself. All relative transformations are set to identity and the
+         * whole hierarchy is marked as dirty.
+         */
+        explicit FlatTransformationHierarchy(const Containers::StridedArrayView1D<const Int>& parents);
+
+        /** @overload */
+        explicit FlatTransformationHierarchy(std::initializer_list<Int> parents);
+
+        /** @brief Object count */
+        std::size_t size() const { return _parents.size(); }
+
+        /** @brief Parent indices */
+        Containers::ArrayView<const Int> parents() const { return _parents; }
+
+        /**
+         * @brief Index after the last descendant of an object
+         *
+         * All descendants of object @p id are contained in the range
+         * @cpp [id + 1, subtreeEnd(id)) @ce. If the parent indices are in a
+         * depth-first order, the range contains only the descendants.
+         * Expects that @p id is less than @ref size().
+         */
+        UnsignedInt subtreeEnd(UnsignedInt id) const;
+
+        /** @brief Relative transformations */
+        Containers::ArrayView<const MatrixType> transformations() const {
+            return _transformations;
+        }
+
+        /**
+         * @brief Relative transformation of an object
+         *
+         * Expects that @p id is less than @ref size().
+         */
+        MatrixType transformation(UnsignedInt id) const;
+
+        /**
+         * @brief Set relative transformation of an object
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p id is less than @ref size(). Extends the
+         * @ref dirtyRange() with the subtree of @p id.
+         */
+        FlatTransformationHierarchy<dimensions, T>& setTransformation(UnsignedInt id, const MatrixType& transformation);
+
+        /**
+         * @brief Set relative transformations of a range of objects
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref setTransformation() for all objects
+         * in the range @cpp [offset, offset + transformations.size()) @ce,
+         * expects that the range is in bounds.
+         */
+        FlatTransformationHierarchy<dimensions, T>& setTransformations(UnsignedInt offset, const Containers::StridedArrayView1D<const MatrixType>& transformations);
+
+        /**
+         * @brief Whether the hierarchy is dirty
+         *
+         * Equivalent to @ref dirtyRange() being non-empty.
+         */
+        bool isDirty() const { return _dirtyBegin != _dirtyEnd; }
+
+        /**
+         * @brief Range of objects with out-of-date absolute transformations
+         *
+         * Begin and end index. If the hierarchy is clean, both are
+         * @cpp 0 @ce.
+         */
+        std::pair<UnsignedInt, UnsignedInt> dirtyRange() const {
+            return {_dirtyBegin, _dirtyEnd};
+        }
+
+        /**
+         * @brief Calculate absolute transformations
+         *
+         * Recalculates absolute transformations of all objects in the
+         * @ref dirtyRange() in a single linear pass and resets the range. If
+         * the hierarchy is clean, the function is a no-op.
+         */
+        void setClean();
+
+        /**
+         * @brief Absolute transformations
+         *
+         * Expects that the hierarchy is not dirty.
+         * @see @ref setClean()
+         */
+        Containers::ArrayView<const MatrixType> absoluteTransformations() const;
+
+        /**
+         * @brief Absolute transformation of an object
+         *
+         * Expects that @p id is less than @ref size() and the hierarchy is
+         * not dirty.
+         * @see @ref setClean()
+         */
+        MatrixType absoluteTransformation(UnsignedInt id) const;
+
+    private:
+        Containers::Array<Int> _parents;
+        Containers::Array<UnsignedInt> _subtreeEnds;
+        Containers::Array<MatrixType> _transformations, _absoluteTransformations;
+        UnsignedInt _dirtyBegin, _dirtyEnd;
+};
+
+/**
+@brief Flat transformation hierarchy for two-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp FlatTransformationHierarchy<2, T> @ce. See
+@ref FlatTransformationHierarchy for more information.
+@see @ref FlatTransformationHierarchy2D, @ref BasicFlatTransformationHierarchy3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicFlatTransformationHierarchy2D = FlatTransformationHierarchy<2, T>;
+#endif
+
+/**
+@brief Flat transformation hierarchy for two-dimensional float scenes
+@m_since_latest
+
+@see @ref FlatTransformationHierarchy3D
+*/
+typedef BasicFlatTransformationHierarchy2D<Float> FlatTransformationHierarchy2D;
+
+/**
+@brief Flat transformation hierarchy for three-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp FlatTransformationHierarchy<3, T> @ce. See
+@ref FlatTransformationHierarchy for more information.
+@see @ref FlatTransformationHierarchy3D, @ref BasicFlatTransformationHierarchy2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicFlatTransformationHierarchy3D = FlatTransformationHierarchy<3, T>;
+#endif
+
+/**
+@brief Flat transformation hierarchy for three-dimensional float scenes
+@m_since_latest
+
+@see @ref FlatTransformationHierarchy2D
+*/
+typedef BasicFlatTransformationHierarchy3D<Float> FlatTransformationHierarchy3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
+extern template class MAGNUM_SCENEGRAPH_EXPORT FlatTransformationHierarchy<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT FlatTransformationHierarchy<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref FlatTransformationHierarchy.h
+ * @m_since_latest
+ */
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/FlatTransformationHierarchy.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> FlatTransformationHierarchy<dimensions, T>::FlatTransformationHierarchy(const Containers::StridedArrayView1D<const Int>& parents): _parents{Containers::NoInit, parents.size()}, _subtreeEnds{Containers::NoInit, parents.size()}, _transformations{Containers::DirectInit, parents.size()}, _absoluteTransformations{Containers::DirectInit, parents.size()}, _dirtyBegin{0}, _dirtyEnd{UnsignedInt(parents.size())} {
+    for(std::size_t i = 0; i != parents.size(); ++i) {
+        CORRADE_ASSERT(parents[i] >= -1 && parents[i] < Int(i),
+            "SceneGraph::FlatTransformationHierarchy: expected parent of object" << i << "to be -1 or less than" << i << "but got" << parents[i], );
+        _parents[i] = parents[i];
+        _subtreeEnds[i] = i + 1;
+    }
+
+    /* Propagate the subtree ends up to the parents. Going backwards, so each
+       object has its subtree end final before it's propagated further. */
+    for(std::size_t i = _parents.size(); i != 0; --i) {
+        const Int parent = _parents[i - 1];
+        if(parent != -1)
+            _subtreeEnds[parent] = std::max(_subtreeEnds[parent], _subtreeEnds[i - 1]);
+    }
+}
+
+template<UnsignedInt dimensions, class T> FlatTransformationHierarchy<dimensions, T>::FlatTransformationHierarchy(std::initializer_list<Int> parents): FlatTransformationHierarchy{Containers::arrayView(parents)} {}
+
+template<UnsignedInt dimensions, class T> UnsignedInt FlatTransformationHierarchy<dimensions, T>::subtreeEnd(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _parents.size(),
+        "SceneGraph::FlatTransformationHierarchy::subtreeEnd(): index" << id << "out of range for" << _parents.size() << "objects", {});
+    return _subtreeEnds[id];
+}
+
+template<UnsignedInt dimensions, class T> auto FlatTransformationHierarchy<dimensions, T>::transformation(const UnsignedInt id) const -> MatrixType {
+    CORRADE_ASSERT(id < _parents.size(),
+        "SceneGraph::FlatTransformationHierarchy::transformation(): index" << id << "out of range for" << _parents.size() << "objects", {});
+    return _transformations[id];
+}
+
+template<UnsignedInt dimensions, class T> FlatTransformationHierarchy<dimensions, T>& FlatTransformationHierarchy<dimensions, T>::setTransformation(const UnsignedInt id, const MatrixType& transformation) {
+    CORRADE_ASSERT(id < _parents.size(),
+        "SceneGraph::FlatTransformationHierarchy::setTransformation(): index" << id << "out of range for" << _parents.size() << "objects", *this);
+
+    _transformations[id] = transformation;
+    if(_dirtyBegin == _dirtyEnd) {
+        _dirtyBegin = id;
+        _dirtyEnd = _subtreeEnds[id];
+    } else {
+        _dirtyBegin = std::min(_dirtyBegin, id);
+        _dirtyEnd = std::max(_dirtyEnd, _subtreeEnds[id]);
+    }
+
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> FlatTransformationHierarchy<dimensions, T>& FlatTransformationHierarchy<dimensions, T>::setTransformations(const UnsignedInt offset, const Containers::StridedArrayView1D<const MatrixType>& transformations) {
+    CORRADE_ASSERT(offset + transformations.size() <= _parents.size(),
+        "SceneGraph::FlatTransformationHierarchy::setTransformations(): range [" << Debug::nospace << offset << Debug::nospace << "," << offset + transformations.size() << Debug::nospace << ") out of range for" << _parents.size() << "objects", *this);
+
+    if(transformations.empty()) return *this;
+
+    /* Subtree end of the last object in the range isn't necessarily the
+       largest, have to go through all of them */
+    UnsignedInt end = _dirtyBegin == _dirtyEnd ? 0 : _dirtyEnd;
+    for(std::size_t i = 0; i != transformations.size(); ++i) {
+        _transformations[offset + i] = transformations[i];
+        end = std::max(end, _subtreeEnds[offset + i]);
+    }
+
+    _dirtyBegin = _dirtyBegin == _dirtyEnd ? offset : std::min(_dirtyBegin, offset);
+    _dirtyEnd = end;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void FlatTransformationHierarchy<dimensions, T>::setClean() {
+    /* Parents before the dirty range are clean, as any dirty object is in a
+       subtree of an object that's in the range */
+    for(std::size_t i = _dirtyBegin; i != _dirtyEnd; ++i) {
+        const Int parent = _parents[i];
+        _absoluteTransformations[i] = parent == -1 ? _transformations[i] :
+            _absoluteTransformations[parent]*_transformations[i];
+    }
+
+    _dirtyBegin = _dirtyEnd = 0;
+}
+
+template<UnsignedInt dimensions, class T> auto FlatTransformationHierarchy<dimensions, T>::absoluteTransformations() const -> Containers::ArrayView<const MatrixType> {
+    CORRADE_ASSERT(_dirtyBegin == _dirtyEnd,
+        "SceneGraph::FlatTransformationHierarchy::absoluteTransformations(): the hierarchy is dirty", {});
+    return _absoluteTransformations;
+}
+
+template<UnsignedInt dimensions, class T> auto FlatTransformationHierarchy<dimensions, T>::absoluteTransformation(const UnsignedInt id) const -> MatrixType {
+    CORRADE_ASSERT(id < _parents.size(),
+        "SceneGraph::FlatTransformationHierarchy::absoluteTransformation(): index" << id << "out of range for" << _parents.size() << "objects", {});
+    CORRADE_ASSERT(_dirtyBegin == _dirtyEnd,
+        "SceneGraph::FlatTransformationHierarchy::absoluteTransformation(): the hierarchy is dirty", {});
+    return _absoluteTransformations[id];
+}
+
+}}
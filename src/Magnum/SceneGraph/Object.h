@@ -47,6 +47,10 @@ namespace Implementation {
     typedef Containers::EnumSet<ObjectFlag> ObjectFlags;
 
     CORRADE_ENUMSET_OPERATORS(ObjectFlags)
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    template<class> struct ObjectParallelClean;
+    #endif
 }
 
 /**
@@ -267,6 +271,18 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
          */
         std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& finalTransformationMatrix = MatrixType()) const;
 
+        /**
+         * @brief Calculate transformation matrices of given set of objects relative to this object into a preallocated array
+         * @m_since_latest
+         *
+         * Same as @ref transformationMatrices(), but puts the result into
+         * @p out, which is expected to have the same size as @p objects.
+         * Temporary data needed for the calculation are kept in the
+         * @ref Scene, so once they grow large enough, repeated calls with the
+         * same or a smaller amount of objects don't allocate.
+         */
+        void transformationMatricesInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& finalTransformationMatrix, const Containers::ArrayView<MatrixType>& out) const;
+
         /**
          * @brief Transformations of given group of objects relative to this object
          *
@@ -330,6 +346,54 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /* note: doc verbatim copied from AbstractObject::setClean() */
         void setClean();
 
+        #if defined(DOXYGEN_GENERATING_OUTPUT) || !defined(CORRADE_TARGET_EMSCRIPTEN)
+        /**
+         * @brief Clean absolute transformations of the whole subtree in parallel
+         * @param threadCount   Count of threads to use, including the
+         *      calling thread. If @cpp 0 @ce,
+         *      @ref std::thread::hardware_concurrency() is used.
+         * @param minObjectCount Minimal count of objects in the subtree for
+         *      which additional threads get used
+         * @m_since_latest
+         *
+         * Cleans this object, all its dirty parents and all its
+         * descendants, equivalently to calling @ref setClean() on each of
+         * them. The top levels of the
+         * subtree are split into independent tasks, each processing a subtree
+         * of its own, which are then distributed among the threads. Each
+         * thread takes tasks from its own queue first and steals from queues
+         * of other threads only when it runs out of work, which keeps the
+         * threads busy also when the subtrees differ in size.
+         *
+         * The result is deterministic and exactly the same as with
+         * @ref setClean(), as the absolute transformation of each object is
+         * always calculated from the absolute transformation of its parent in
+         * the same order, regardless of the thread it's calculated on. On the
+         * other hand, @ref AbstractFeature::clean() and
+         * @ref AbstractFeature::cleanInverted() of features attached to the
+         * objects get called from the worker threads, so they shouldn't
+         * access any state shared with other objects. The hierarchy itself
+         * shouldn't be modified during the call.
+         *
+         * Only objects that are dirty get their absolute transformation
+         * calculated. For clean objects it's calculated only if they have
+         * dirty children, which can happen if @ref setDirty() was called on
+         * a child but not on its parent.
+         *
+         * The threads are created on every call and destroyed at the end,
+         * which is worth it only for hierarchies with at least several
+         * thousands of objects. If the subtree has less than
+         * @p minObjectCount objects, it's cleaned on the calling thread
+         * without creating any threads. Threads that run out of work sleep
+         * until there's more work or all work is done.
+         *
+         * @note This function is not available on
+         *      @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", as threads are not
+         *      generally available there.
+         */
+        void setCleanParallel(UnsignedInt threadCount = 0, std::size_t minObjectCount = 4096);
+        #endif
+
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
         /**
@@ -354,6 +418,9 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
         friend Containers::LinkedList<Object<Transformation>>;
         friend Containers::LinkedListItem<Object<Transformation>, Object<Transformation>>;
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        friend Implementation::ObjectParallelClean<Transformation>;
+        #endif
         #endif
 
         Object<Transformation>* doScene() override final;
@@ -370,7 +437,11 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         }
 
         std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& finalTransformationMatrix) const override final;
+        void doTransformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& finalTransformationMatrix, const Containers::ArrayView<MatrixType>& out) const override final;
 
+        /* Returns false if an assertion failed (only in graceful assert
+           builds), the result is in Scene::_jointTransformations otherwise */
+        template<class U> bool MAGNUM_SCENEGRAPH_LOCAL computeJointTransformations(const std::vector<std::reference_wrapper<U>>& objects, const typename Transformation::DataType& finalTransformation) const;
         typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& finalTransformation) const;
 
         bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
@@ -31,7 +31,18 @@
 
 #include <algorithm>
 #include <stack>
+#include <Corrade/Containers/Array.h>
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include "Magnum/Implementation/Parallel.h"
+#endif
 #include "Magnum/SceneGraph/AbstractTransformation.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/Scene.h"
@@ -171,21 +182,45 @@ template<class Transformation> void Object<Transformation>::setClean() {
 }
 
 template<class Transformation> auto Object<Transformation>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& finalTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
-    castObjects.reserve(objects.size());
+    std::vector<MatrixType> transformationMatrices(objects.size());
+    doTransformationMatricesInto(objects, finalTransformationMatrix, Containers::arrayView(transformationMatrices.data(), transformationMatrices.size()));
+    return transformationMatrices;
+}
+
+template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& finalTransformationMatrix) const -> std::vector<MatrixType> {
+    std::vector<MatrixType> transformationMatrices(objects.size());
+    transformationMatricesInto(objects, finalTransformationMatrix, Containers::arrayView(transformationMatrices.data(), transformationMatrices.size()));
+    return transformationMatrices;
+}
+
+template<class Transformation> void Object<Transformation>::doTransformationMatricesInto(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& finalTransformationMatrix, const Containers::ArrayView<MatrixType>& out) const {
+    CORRADE_ASSERT(out.size() == objects.size(),
+        "SceneGraph::Object::transformationMatricesInto(): expected" << objects.size() << "destination matrices but got" << out.size(), );
+
     /** @todo Ensure this doesn't crash, somehow */
-    for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
+    if(!computeJointTransformations(objects, Implementation::Transformation<Transformation>::fromMatrix(finalTransformationMatrix))) return;
 
-    return transformationMatrices(std::move(castObjects), finalTransformationMatrix);
+    const std::vector<typename Transformation::DataType>& jointTransformations = static_cast<const Scene<Transformation>&>(*this)._jointTransformations;
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        out[i] = Implementation::Transformation<Transformation>::toMatrix(jointTransformations[i]);
 }
 
-template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& finalTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::Transformation<Transformation>::fromMatrix(finalTransformationMatrix));
-    std::vector<MatrixType> transformationMatrices(transformations.size());
+template<class Transformation> void Object<Transformation>::transformationMatricesInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& finalTransformationMatrix, const Containers::ArrayView<MatrixType>& out) const {
+    CORRADE_ASSERT(out.size() == objects.size(),
+        "SceneGraph::Object::transformationMatricesInto(): expected" << objects.size() << "destination matrices but got" << out.size(), );
+
+    if(!computeJointTransformations(objects, Implementation::Transformation<Transformation>::fromMatrix(finalTransformationMatrix))) return;
+
+    const std::vector<typename Transformation::DataType>& jointTransformations = static_cast<const Scene<Transformation>&>(*this)._jointTransformations;
     for(std::size_t i = 0; i != objects.size(); ++i)
-        transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+        out[i] = Implementation::Transformation<Transformation>::toMatrix(jointTransformations[i]);
+}
 
-    return transformationMatrices;
+template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& finalTransformation) const {
+    if(!computeJointTransformations(objects, finalTransformation)) return {};
+
+    const std::vector<typename Transformation::DataType>& jointTransformations = static_cast<const Scene<Transformation>&>(*this)._jointTransformations;
+    return std::vector<typename Transformation::DataType>(jointTransformations.begin(), jointTransformations.begin() + objects.size());
 }
 
 /*
@@ -200,85 +235,86 @@ divided into two groups:
 
 Then for all joints their transformation (relative to parent joint) is
 computed and recursively concatenated together. Resulting transformations for
-joints which were originally in `object` list is then returned.
+joints which were originally in `object` list are then in the first
+`objects.size()` items of the joint transformation list.
+
+The joint object and transformation lists are stored in the scene and reused
+between calls, so the calculation doesn't allocate once they grow large enough.
 */
-template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& finalTransformation) const {
-    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
+template<class Transformation> template<class U> bool Object<Transformation>::computeJointTransformations(const std::vector<std::reference_wrapper<U>>& objects, const typename Transformation::DataType& finalTransformation) const {
+    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", false);
+
+    /* Nearest common ancestor not yet implemented - assert this is done on scene */
+    CORRADE_ASSERT(isScene(), "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", false);
 
-    /* Remember object count for later */
-    std::size_t objectCount = objects.size();
+    const Scene<Transformation>& scene = static_cast<const Scene<Transformation>&>(*this);
+    std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects = scene._jointObjects;
+    std::vector<typename Transformation::DataType>& jointTransformations = scene._jointTransformations;
 
     /* Mark all original objects as joints and create initial list of joints
        from them */
+    jointObjects.clear();
     for(std::size_t i = 0; i != objects.size(); ++i) {
+        Object<Transformation>& o = static_cast<Object<Transformation>&>(objects[i].get());
+        jointObjects.push_back(o);
+
         /* Multiple occurences of one object in the array, don't overwrite it
            with different counter */
-        if(objects[i].get().counter != 0xFFFFu) continue;
+        if(o.counter != 0xFFFFu) continue;
 
-        objects[i].get().counter = UnsignedShort(i);
-        objects[i].get().flags |= Flag::Joint;
+        o.counter = UnsignedShort(i);
+        o.flags |= Flag::Joint;
     }
-    std::vector<std::reference_wrapper<Object<Transformation>>> jointObjects(objects);
-
-    #ifndef CORRADE_NO_ASSERT
-    /* Scene object */
-    const Scene<Transformation>* scene = this->scene();
-    #endif
 
-    /* Nearest common ancestor not yet implemented - assert this is done on scene */
-    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", {});
-
-    /* Mark all objects up the hierarchy as visited */
-    auto it = objects.begin();
-    while(!objects.empty()) {
-        /* Already visited, remove and continue to next (duplicate occurence) */
-        if(it->get().flags & Flag::Visited) {
-            it = objects.erase(it);
-            continue;
-        }
+    /* Mark all objects up the hierarchy as visited. For each object go up
+       until reaching the root or an object that was already visited or is a
+       joint. */
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        Object<Transformation>* o = &static_cast<Object<Transformation>&>(objects[i].get());
+        for(;;) {
+            /* Already visited (duplicate occurence), continue to the next */
+            if(o->flags & Flag::Visited) break;
 
-        /* Mark the object as visited */
-        it->get().flags |= Flag::Visited;
+            /* Mark the object as visited */
+            o->flags |= Flag::Visited;
 
-        Object<Transformation>* parent = it->get().parent();
+            Object<Transformation>* parent = o->parent();
 
-        /* If this is root object, remove from list */
-        if(!parent) {
-            CORRADE_ASSERT(&it->get() == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
-            it = objects.erase(it);
-
-        /* Parent is an joint or already visited - remove current from list */
-        } else if(parent->flags & (Flag::Visited|Flag::Joint)) {
-            it = objects.erase(it);
-
-            /* If not already marked as joint, mark it as such and add it to
-               list of joint objects */
-            if(!(parent->flags & Flag::Joint)) {
-                CORRADE_ASSERT(jointObjects.size() < 0xFFFFu,
-                               "SceneGraph::Object::transformations(): too large scene", {});
-                CORRADE_INTERNAL_ASSERT(parent->counter == 0xFFFFu);
-                parent->counter = UnsignedShort(jointObjects.size());
-                parent->flags |= Flag::Joint;
-                jointObjects.push_back(*parent);
+            /* If this is root object, continue to the next */
+            if(!parent) {
+                CORRADE_ASSERT(o == this, "SceneGraph::Object::transformations(): the objects are not part of the same tree", false);
+                break;
             }
 
-        /* Else go up the hierarchy */
-        } else *it = *parent;
+            /* Parent is an joint or already visited - continue to the next */
+            if(parent->flags & (Flag::Visited|Flag::Joint)) {
+                /* If not already marked as joint, mark it as such and add it
+                   to list of joint objects */
+                if(!(parent->flags & Flag::Joint)) {
+                    CORRADE_ASSERT(jointObjects.size() < 0xFFFFu,
+                                   "SceneGraph::Object::transformations(): too large scene", false);
+                    CORRADE_INTERNAL_ASSERT(parent->counter == 0xFFFFu);
+                    parent->counter = UnsignedShort(jointObjects.size());
+                    parent->flags |= Flag::Joint;
+                    jointObjects.push_back(*parent);
+                }
+
+                break;
+            }
 
-        /* Cycle if reached end */
-        if(it == objects.end()) it = objects.begin();
+            /* Else go up the hierarchy */
+            o = parent;
+        }
     }
 
-    /* Array of absolute transformations in joints */
-    std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
-
     /* Compute transformations for all joints */
+    jointTransformations.resize(jointObjects.size());
     for(std::size_t i = 0; i != jointTransformations.size(); ++i)
         computeJointTransformation(jointObjects, jointTransformations, i, finalTransformation);
 
     /* Copy transformation for second or next occurences from first occurence
        of duplicate object */
-    for(std::size_t i = 0; i != objectCount; ++i) {
+    for(std::size_t i = 0; i != objects.size(); ++i) {
         if(jointObjects[i].get().counter != i)
             jointTransformations[i] = jointTransformations[jointObjects[i].get().counter];
     }
@@ -292,9 +328,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
         i.get().counter = 0xFFFFu;
     }
 
-    /* Shrink the array to contain only transformations of requested objects and return */
-    jointTransformations.resize(objectCount);
-    return jointTransformations;
+    return true;
 }
 
 template<class Transformation> typename Transformation::DataType Object<Transformation>::computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& finalTransformation) const {
@@ -417,6 +451,211 @@ template<class Transformation> void Object<Transformation>::setCleanInternal(con
     flags &= ~Flag::Dirty;
 }
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+namespace Implementation {
+
+/*
+Cleaning a subtree in parallel
+
+A task is an object together with absolute transformation of its parent. When
+processing a task, children of objects that are less than SplitDepth levels
+below the root are pushed as new tasks to the queue of the current thread,
+deeper objects are processed directly by the task that reached them. Each
+thread takes the most recently pushed task from its own queue, which keeps the
+processing depth-first and the queue short. Idle threads steal the least
+recently pushed tasks from queues of other threads, as those are the closest
+to the root and thus likely the largest.
+
+Threads that find all queues empty sleep on a condition variable until a task
+is pushed or all work is done. The `pending` counter is incremented when a task
+is pushed and decremented only after it's processed, so it can't reach zero
+while there's any task that could still push more. The `queued` counter is
+incremented before the task is put into a queue and decremented after it's
+taken out, so it never underflows.
+*/
+template<class Transformation> struct ObjectParallelClean {
+    enum: UnsignedInt { SplitDepth = 2 };
+
+    struct Task {
+        Object<Transformation>* object;
+        typename Transformation::DataType parentTransformation;
+        UnsignedInt depth;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> queue;
+        /* Reused for processing subtrees below SplitDepth */
+        std::vector<Task> stack;
+    };
+
+    explicit ObjectParallelClean(UnsignedInt threadCount): workers{Containers::ValueInit, threadCount} {}
+
+    /* Whether the subtree has at least given count of objects. Stops as soon
+       as the count is reached, so it's cheap also for huge hierarchies. */
+    static bool hasAtLeast(Object<Transformation>& root, const std::size_t count) {
+        std::vector<Object<Transformation>*> stack{&root};
+        std::size_t found = 0;
+        while(!stack.empty()) {
+            Object<Transformation>& object = *stack.back();
+            stack.pop_back();
+            if(++found >= count) return true;
+            for(Object<Transformation>& child: object.children())
+                stack.push_back(&child);
+        }
+        return false;
+    }
+
+    void push(UnsignedInt id, Task&& task) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            ++pending;
+            ++queued;
+        }
+        {
+            std::lock_guard<std::mutex> lock{workers[id].mutex};
+            workers[id].queue.push_back(std::move(task));
+        }
+        taskAvailable.notify_one();
+    }
+
+    bool popInternal(UnsignedInt id, Task& task) {
+        /* Newest task from own queue */
+        {
+            Worker& worker = workers[id];
+            std::lock_guard<std::mutex> lock{worker.mutex};
+            if(!worker.queue.empty()) {
+                task = std::move(worker.queue.back());
+                worker.queue.pop_back();
+                return true;
+            }
+        }
+
+        /* Oldest task from the others, starting with the next one so all
+           threads don't try to steal from the same victim */
+        for(std::size_t i = 1; i != workers.size(); ++i) {
+            Worker& victim = workers[(id + i) % workers.size()];
+            std::lock_guard<std::mutex> lock{victim.mutex};
+            if(!victim.queue.empty()) {
+                task = std::move(victim.queue.front());
+                victim.queue.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool pop(UnsignedInt id, Task& task) {
+        if(!popInternal(id, task)) return false;
+        std::lock_guard<std::mutex> lock{mutex};
+        --queued;
+        return true;
+    }
+
+    void work(UnsignedInt id) {
+        Task task;
+        for(;;) {
+            if(pop(id, task)) {
+                process(id, task);
+
+                bool finished;
+                {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    finished = !--pending;
+                }
+                if(finished) taskAvailable.notify_all();
+                continue;
+            }
+
+            /* Nothing to take, sleep until there's a new task or everything
+               is done */
+            std::unique_lock<std::mutex> lock{mutex};
+            taskAvailable.wait(lock, [this] { return !pending || queued; });
+            if(!pending) return;
+        }
+    }
+
+    void process(UnsignedInt id, const Task& task) {
+        std::vector<Task>& stack = workers[id].stack;
+        stack.push_back(task);
+        while(!stack.empty()) {
+            const Task current = std::move(stack.back());
+            stack.pop_back();
+            Object<Transformation>& object = *current.object;
+
+            /* Children of a dirty object are all dirty as well, calculate the
+               transformation for them */
+            typename Transformation::DataType absoluteTransformation;
+            if(object.isDirty()) {
+                absoluteTransformation = Implementation::Transformation<Transformation>::compose(current.parentTransformation, object.transformation());
+                object.setCleanInternal(absoluteTransformation);
+
+            /* A clean object can still have dirty children, for which its
+               absolute transformation is needed. Calculate it only if there
+               are any, otherwise the transformation isn't needed for anything
+               in the subtree. As all parents of a clean object are clean as
+               well, it can be calculated from the parents directly. */
+            } else {
+                bool hasDirtyChildren = false;
+                for(Object<Transformation>& child: object.children()) {
+                    if(child.isDirty()) {
+                        hasDirtyChildren = true;
+                        break;
+                    }
+                }
+                if(hasDirtyChildren)
+                    absoluteTransformation = object.absoluteTransformation();
+            }
+
+            for(Object<Transformation>& child: object.children()) {
+                if(current.depth < SplitDepth)
+                    push(id, Task{&child, absoluteTransformation, current.depth + 1});
+                else
+                    stack.push_back(Task{&child, absoluteTransformation, current.depth + 1});
+            }
+        }
+    }
+
+    Containers::Array<Worker> workers;
+
+    /* Everything below is guarded by the mutex */
+    std::mutex mutex;
+    /* Signalled when a task is pushed or all tasks are processed */
+    std::condition_variable taskAvailable;
+    std::size_t pending{}, queued{};
+};
+
+}
+
+template<class Transformation> void Object<Transformation>::setCleanParallel(UnsignedInt threadCount, const std::size_t minObjectCount) {
+    threadCount = Magnum::Implementation::resolveThreadCount(threadCount);
+
+    /* Spawning the threads costs more than cleaning a small subtree, do it
+       all on the calling thread in that case */
+    if(threadCount > 1 && !Implementation::ObjectParallelClean<Transformation>::hasAtLeast(*this, minObjectCount))
+        threadCount = 1;
+
+    /* Clean the parents first, same as setClean() does */
+    typename Transformation::DataType parentTransformation;
+    if(parent()) {
+        parent()->setClean();
+        parentTransformation = parent()->absoluteTransformation();
+    }
+
+    Implementation::ObjectParallelClean<Transformation> state{threadCount};
+    state.push(0, {this, parentTransformation, 0});
+
+    /* The calling thread is the first worker */
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for(UnsignedInt i = 1; i < threadCount; ++i)
+        threads.emplace_back(&Implementation::ObjectParallelClean<Transformation>::work, &state, i);
+    state.work(0);
+    for(std::thread& thread: threads) thread.join();
+}
+#endif
+
 }}
 
 #endif
@@ -52,7 +52,14 @@ template<class Transformation> class Scene: public Object<Transformation> {
         explicit Scene() = default;
 
     private:
+        friend Object<Transformation>;
+
         bool isScene() const override final { return true; }
+
+        /* Scratch memory for Object::transformations() and friends, kept
+           around to avoid allocating on every call */
+        mutable std::vector<std::reference_wrapper<Object<Transformation>>> _jointObjects;
+        mutable std::vector<typename Transformation::DataType> _jointTransformations;
 };
 
 }}
@@ -117,6 +117,12 @@ template<class Feature, class T> using BasicFeatureGroup3D = FeatureGroup<3, Fea
 template<class Feature> using FeatureGroup2D = BasicFeatureGroup2D<Feature, Float>;
 template<class Feature> using FeatureGroup3D = BasicFeatureGroup3D<Feature, Float>;
 
+template<UnsignedInt, class> class FlatTransformationHierarchy;
+template<class T> using BasicFlatTransformationHierarchy2D = FlatTransformationHierarchy<2, T>;
+template<class T> using BasicFlatTransformationHierarchy3D = FlatTransformationHierarchy<3, T>;
+typedef BasicFlatTransformationHierarchy2D<Float> FlatTransformationHierarchy2D;
+typedef BasicFlatTransformationHierarchy3D<Float> FlatTransformationHierarchy3D;
+
 template<UnsignedInt dimensions, class T> using DrawableGroup = FeatureGroup<dimensions, Drawable<dimensions, T>, T>;
 template<class T> using BasicDrawableGroup2D = DrawableGroup<2, T>;
 template<class T> using BasicDrawableGroup3D = DrawableGroup<3, T>;
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/SceneGraph/Camera.hpp" /* only for aspectRatioFix(), so it doesn't have to be exported */
 #include "Magnum/SceneGraph/Camera.h"
@@ -49,11 +50,16 @@ struct CameraTest: TestSuite::Tester {
     void projectionSizeViewport();
 
     void draw();
+    void drawRepeated();
+    void drawCulled3D();
+    void drawCulled3DDouble();
+    void drawCulled2D();
     void drawOrdered();
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
 
 CameraTest::CameraTest() {
@@ -67,6 +73,10 @@ CameraTest::CameraTest() {
               &CameraTest::projectionSizeViewport,
 
               &CameraTest::draw,
+              &CameraTest::drawRepeated,
+              &CameraTest::drawCulled3D,
+              &CameraTest::drawCulled3DDouble,
+              &CameraTest::drawCulled2D,
               &CameraTest::drawOrdered});
 }
 
@@ -216,6 +226,222 @@ void CameraTest::draw() {
     CORRADE_COMPARE(thirdTransformation, Matrix4());
 }
 
+void CameraTest::drawRepeated() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, std::vector<std::pair<Int, Matrix4>>& result, Int id): SceneGraph::Drawable3D(object, group), _result(result), _id{id} {}
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+                _result.emplace_back(_id, transformationMatrix);
+            }
+
+        private:
+            std::vector<std::pair<Int, Matrix4>>& _result;
+            Int _id;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    std::vector<std::pair<Int, Matrix4>> transformations;
+
+    Object3D first(&scene);
+    first.translate(Vector3::xAxis(1.0f));
+    new Drawable{first, &group, transformations, 0};
+
+    Object3D second(&scene);
+    second.translate(Vector3::xAxis(2.0f));
+    auto* secondDrawable = new Drawable{second, &group, transformations, 1};
+
+    Object3D third(&second);
+    third.translate(Vector3::xAxis(3.0f));
+    new Drawable{third, &group, transformations, 2};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    camera.draw(group);
+    CORRADE_COMPARE_AS(transformations, (std::vector<std::pair<Int, Matrix4>>{
+        {0, Matrix4::translation(Vector3::xAxis(1.0f))},
+        {1, Matrix4::translation(Vector3::xAxis(2.0f))},
+        {2, Matrix4::translation(Vector3::xAxis(5.0f))}
+    }), TestSuite::Compare::Container);
+
+    /* The cached object list and the transformation storage should be
+       updated for changes in the group and the hierarchy */
+    transformations.clear();
+    group.remove(*secondDrawable);
+    second.translate(Vector3::xAxis(2.0f));
+    Object3D fourth(&first);
+    fourth.translate(Vector3::xAxis(4.0f));
+    new Drawable{fourth, &group, transformations, 3};
+    camera.draw(group);
+    CORRADE_COMPARE_AS(transformations, (std::vector<std::pair<Int, Matrix4>>{
+        {0, Matrix4::translation(Vector3::xAxis(1.0f))},
+        {2, Matrix4::translation(Vector3::xAxis(7.0f))},
+        {3, Matrix4::translation(Vector3::xAxis(5.0f))}
+    }), TestSuite::Compare::Container);
+
+    /* Drawing again gives the same result */
+    transformations.clear();
+    camera.draw(group);
+    CORRADE_COMPARE_AS(transformations, (std::vector<std::pair<Int, Matrix4>>{
+        {0, Matrix4::translation(Vector3::xAxis(1.0f))},
+        {2, Matrix4::translation(Vector3::xAxis(7.0f))},
+        {3, Matrix4::translation(Vector3::xAxis(5.0f))}
+    }), TestSuite::Compare::Container);
+}
+
+void CameraTest::drawCulled3D() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, std::vector<Int>& result, Int id): SceneGraph::Drawable3D(object, group), _result(result), _id{id} {}
+
+        protected:
+            void draw(const Matrix4&, Camera3D&) override {
+                _result.push_back(_id);
+            }
+
+        private:
+            std::vector<Int>& _result;
+            Int _id;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Int> drawn;
+
+    /* At z = -5 the visible area is [-5, 5] in both X and Y */
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f));
+
+    const Range3D box{Vector3{-1.0f}, Vector3{1.0f}};
+
+    /* In front of the camera */
+    Object3D inFront{&scene};
+    inFront.translate({0.0f, 0.0f, -5.0f});
+    new Drawable{inFront, &group, drawn, 0};
+
+    /* Behind the camera */
+    Object3D behind{&scene};
+    behind.translate({0.0f, 0.0f, 5.0f});
+    new Drawable{behind, &group, drawn, 1};
+
+    /* Too far to the right */
+    Object3D right{&scene};
+    right.translate({8.0f, 0.0f, -5.0f});
+    new Drawable{right, &group, drawn, 2};
+
+    /* Too far to the right, but scaled, so the box reaches into the view */
+    Object3D rightScaled{&scene};
+    rightScaled.scale(Vector3{4.0f})
+        .translate({8.0f, 0.0f, -5.0f});
+    new Drawable{rightScaled, &group, drawn, 3};
+
+    /* Too far to the bottom, but rotated, so the box reaches into the view */
+    Object3D bottomRotated{&scene};
+    bottomRotated.rotateZ(Deg(45.0f))
+        .translate({0.0f, -7.2f, -5.0f});
+    new Drawable{bottomRotated, &group, drawn, 4};
+
+    /* Beyond the far plane */
+    Object3D beyondFar{&scene};
+    beyondFar.translate({0.0f, 0.0f, -200.0f});
+    new Drawable{beyondFar, &group, drawn, 5};
+
+    /* Behind the camera, but with a box large enough to reach into the
+       view */
+    Object3D large{&scene};
+    large.translate({0.0f, 0.0f, 5.0f});
+    new Drawable{large, &group, drawn, 6};
+
+    const Range3D boxes[]{box, box, box, box, box, box,
+        {Vector3{-10.0f}, Vector3{10.0f}}};
+
+    CORRADE_COMPARE(camera.drawCulled(group, boxes), 4);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{0, 3, 4, 6}),
+        TestSuite::Compare::Container);
+
+    /* Moving the camera changes what's visible, the box being relative to the
+       object doesn't need to be updated when the object moves */
+    drawn.clear();
+    cameraObject.translate({8.0f, 0.0f, 0.0f});
+    inFront.translate({8.0f, 0.0f, 0.0f});
+    CORRADE_COMPARE(camera.drawCulled(group, boxes), 4);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{0, 2, 3, 6}),
+        TestSuite::Compare::Container);
+}
+
+void CameraTest::drawCulled3DDouble() {
+    /* Only float cameras are instantiated in the library, so testing the
+       per-box double fallback used instead of the batch function directly */
+    const Frustumd frustum = Implementation::cullingFrustum(Matrix4d::perspectiveProjection(Degd(90.0), 1.0, 0.1, 100.0));
+    const Vector3d centers[]{
+        {0.0, 0.0, -5.0},   /* in front */
+        {0.0, 0.0, 5.0},    /* behind */
+        {8.0, 0.0, -5.0},   /* too far to the right */
+        {8.0, 0.0, -5.0}    /* too far to the right, but large */
+    };
+    const Vector3d extents[]{
+        Vector3d{1.0}, Vector3d{1.0}, Vector3d{1.0}, Vector3d{4.0}
+    };
+    UnsignedByte visibility[1]{0xff};
+    Implementation::cullBoxes<Double>(centers, extents, frustum, visibility);
+    CORRADE_COMPARE(visibility[0], 0x9);
+}
+
+void CameraTest::drawCulled2D() {
+    class Drawable: public SceneGraph::Drawable2D {
+        public:
+            Drawable(AbstractObject2D& object, DrawableGroup2D* group, std::vector<Int>& result, Int id): SceneGraph::Drawable2D(object, group), _result(result), _id{id} {}
+
+        protected:
+            void draw(const Matrix3&, Camera2D&) override {
+                _result.push_back(_id);
+            }
+
+        private:
+            std::vector<Int>& _result;
+            Int _id;
+    };
+
+    DrawableGroup2D group;
+    Scene2D scene;
+    std::vector<Int> drawn;
+
+    /* Visible area is [-2, 2] in both X and Y */
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix3::projection({4.0f, 4.0f}));
+
+    const Range2D box{Vector2{-1.0f}, Vector2{1.0f}};
+
+    Object2D inside{&scene};
+    inside.translate({1.0f, 0.0f});
+    new Drawable{inside, &group, drawn, 0};
+
+    Object2D outside{&scene};
+    outside.translate({3.2f, 0.0f});
+    new Drawable{outside, &group, drawn, 1};
+
+    /* Rotated by 45 degrees, the box reaches to 3.2 - sqrt(2) */
+    Object2D outsideRotated{&scene};
+    outsideRotated.rotate(Deg(45.0f))
+        .translate({3.2f, 0.0f});
+    new Drawable{outsideRotated, &group, drawn, 2};
+
+    Object2D above{&scene};
+    above.translate({0.0f, 5.0f});
+    new Drawable{above, &group, drawn, 3};
+
+    const Range2D boxes[]{box, box, box, box};
+    CORRADE_COMPARE(camera.drawCulled(group, boxes), 2);
+    CORRADE_COMPARE_AS(drawn, (std::vector<Int>{0, 2}),
+        TestSuite::Compare::Container);
+}
+
 void CameraTest::drawOrdered() {
     class Drawable: public SceneGraph::Drawable3D {
         public:
@@ -0,0 +1,142 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/FlatTransformationHierarchy.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+/* A four-ary tree in a breadth-first order */
+constexpr std::size_t ObjectCount = 50000;
+Int parentOf(std::size_t i) { return i ? Int((i - 1)/4) : -1; }
+
+struct FlatTransformationHierarchyBenchmark: TestSuite::Tester {
+    explicit FlatTransformationHierarchyBenchmark();
+
+    void objectTransformations();
+    void objectSetClean();
+    void flatSetClean();
+
+    void objectSetCleanLeaves();
+    void flatSetCleanLeaves();
+
+    private:
+        Scene3D _scene;
+        std::vector<std::reference_wrapper<Object3D>> _objects;
+        FlatTransformationHierarchy3D _flat;
+};
+
+Containers::Array<Int> parents() {
+    Containers::Array<Int> out{Containers::NoInit, ObjectCount};
+    for(std::size_t i = 0; i != ObjectCount; ++i) out[i] = parentOf(i);
+    return out;
+}
+
+FlatTransformationHierarchyBenchmark::FlatTransformationHierarchyBenchmark(): _flat{Containers::arrayView(parents())} {
+    addBenchmarks({&FlatTransformationHierarchyBenchmark::objectTransformations,
+                   &FlatTransformationHierarchyBenchmark::objectSetClean,
+                   &FlatTransformationHierarchyBenchmark::flatSetClean,
+
+                   &FlatTransformationHierarchyBenchmark::objectSetCleanLeaves,
+                   &FlatTransformationHierarchyBenchmark::flatSetCleanLeaves}, 10);
+
+    _objects.reserve(ObjectCount);
+    for(std::size_t i = 0; i != ObjectCount; ++i) {
+        const Int parent = parentOf(i);
+        Object3D* object = new Object3D{parent == -1 ? &_scene : &_objects[parent].get()};
+        const Matrix4 transformation = Matrix4::translation(Vector3::xAxis(Float(i%7)))*Matrix4::rotationZ(Deg(Float(i%13)));
+        object->setTransformation(transformation);
+        _flat.setTransformation(i, transformation);
+        _objects.push_back(*object);
+    }
+}
+
+void FlatTransformationHierarchyBenchmark::objectTransformations() {
+    /* What SceneGraph::Camera::draw() does */
+    std::vector<Matrix4> transformations;
+    CORRADE_BENCHMARK(1)
+        transformations = _scene.transformationMatrices(_objects);
+
+    CORRADE_COMPARE(transformations.size(), ObjectCount);
+}
+
+void FlatTransformationHierarchyBenchmark::objectSetClean() {
+    CORRADE_BENCHMARK(1) {
+        _objects[0].get().setTransformation(Matrix4::translation(Vector3::yAxis(1.0f)));
+        Object3D::setClean(_objects);
+    }
+
+    CORRADE_VERIFY(!_objects.back().get().isDirty());
+}
+
+void FlatTransformationHierarchyBenchmark::flatSetClean() {
+    CORRADE_BENCHMARK(1) {
+        _flat.setTransformation(0, Matrix4::translation(Vector3::yAxis(1.0f)));
+        _flat.setClean();
+    }
+
+    CORRADE_VERIFY(!_flat.isDirty());
+}
+
+void FlatTransformationHierarchyBenchmark::objectSetCleanLeaves() {
+    /* Leaves are the last three quarters of the objects, update a tenth of
+       them that's at the end */
+    const std::size_t begin = ObjectCount - ObjectCount/10;
+    std::vector<std::reference_wrapper<Object3D>> leaves{_objects.begin() + begin, _objects.end()};
+    Object3D::setClean(_objects);
+
+    CORRADE_BENCHMARK(1) {
+        for(Object3D& object: leaves)
+            object.setTransformation(Matrix4::translation(Vector3::yAxis(1.0f)));
+        Object3D::setClean(leaves);
+    }
+
+    CORRADE_VERIFY(!leaves.back().get().isDirty());
+}
+
+void FlatTransformationHierarchyBenchmark::flatSetCleanLeaves() {
+    const std::size_t begin = ObjectCount - ObjectCount/10;
+    _flat.setClean();
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = begin; i != ObjectCount; ++i)
+            _flat.setTransformation(i, Matrix4::translation(Vector3::yAxis(1.0f)));
+        _flat.setClean();
+    }
+
+    CORRADE_VERIFY(!_flat.isDirty());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlatTransformationHierarchyBenchmark)
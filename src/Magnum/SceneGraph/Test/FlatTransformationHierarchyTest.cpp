@@ -0,0 +1,353 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/FlatTransformationHierarchy.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct FlatTransformationHierarchyTest: TestSuite::Tester {
+    explicit FlatTransformationHierarchyTest();
+
+    void construct();
+    void constructInvalidParent();
+    void constructNonDepthFirst();
+
+    void setTransformation();
+    void setTransformationOutOfRange();
+    void setTransformations();
+    void setTransformationsOutOfRange();
+
+    void setClean();
+    void setCleanPartial();
+    void setCleanConsistentWithObject();
+    void setClean2D();
+
+    void absoluteTransformationOutOfRange();
+    void absoluteTransformationDirty();
+};
+
+using namespace Math::Literals;
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+FlatTransformationHierarchyTest::FlatTransformationHierarchyTest() {
+    addTests({&FlatTransformationHierarchyTest::construct,
+              &FlatTransformationHierarchyTest::constructInvalidParent,
+              &FlatTransformationHierarchyTest::constructNonDepthFirst,
+
+              &FlatTransformationHierarchyTest::setTransformation,
+              &FlatTransformationHierarchyTest::setTransformationOutOfRange,
+              &FlatTransformationHierarchyTest::setTransformations,
+              &FlatTransformationHierarchyTest::setTransformationsOutOfRange,
+
+              &FlatTransformationHierarchyTest::setClean,
+              &FlatTransformationHierarchyTest::setCleanPartial,
+              &FlatTransformationHierarchyTest::setCleanConsistentWithObject,
+              &FlatTransformationHierarchyTest::setClean2D,
+
+              &FlatTransformationHierarchyTest::absoluteTransformationOutOfRange,
+              &FlatTransformationHierarchyTest::absoluteTransformationDirty});
+}
+
+/*
+    0
+    |-- 1
+    |   |-- 2
+    |   \-- 3
+    |       \-- 4
+    \-- 5
+    6
+    \-- 7
+*/
+constexpr Int Parents[]{-1, 0, 1, 1, 3, 0, -1, 6};
+
+void FlatTransformationHierarchyTest::construct() {
+    FlatTransformationHierarchy3D hierarchy{Parents};
+    CORRADE_COMPARE(hierarchy.size(), 8);
+    CORRADE_COMPARE_AS(hierarchy.parents(),
+        Containers::arrayView(Parents),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(hierarchy.subtreeEnd(0), 6);
+    CORRADE_COMPARE(hierarchy.subtreeEnd(1), 5);
+    CORRADE_COMPARE(hierarchy.subtreeEnd(2), 3);
+    CORRADE_COMPARE(hierarchy.subtreeEnd(3), 5);
+    CORRADE_COMPARE(hierarchy.subtreeEnd(4), 5);
+    CORRADE_COMPARE(hierarchy.subtreeEnd(5), 6);
+    CORRADE_COMPARE(hierarchy.subtreeEnd(6), 8);
+    CORRADE_COMPARE(hierarchy.subtreeEnd(7), 8);
+
+    /* Everything is identity and dirty initially */
+    for(std::size_t i = 0; i != hierarchy.size(); ++i)
+        CORRADE_COMPARE(hierarchy.transformation(i), Matrix4{});
+    CORRADE_VERIFY(hierarchy.isDirty());
+    CORRADE_COMPARE(hierarchy.dirtyRange(), (std::pair<UnsignedInt, UnsignedInt>{0, 8}));
+}
+
+void FlatTransformationHierarchyTest::constructInvalidParent() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FlatTransformationHierarchy3D{-1, 0, 2};
+    FlatTransformationHierarchy3D{-1, -2};
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatTransformationHierarchy: expected parent of object 2 to be -1 or less than 2 but got 2\n"
+        "SceneGraph::FlatTransformationHierarchy: expected parent of object 1 to be -1 or less than 1 but got -2\n");
+}
+
+void FlatTransformationHierarchyTest::constructNonDepthFirst() {
+    /* Breadth-first order, subtree ranges contain unrelated objects as well
+       but all descendants are still included:
+
+        0
+        |-- 1
+        |   \-- 3
+        \-- 2
+            \-- 4
+    */
+    FlatTransformationHierarchy3D hierarchy{-1, 0, 0, 1, 2};
+    CORRADE_COMPARE(hierarchy.subtreeEnd(0), 5);
+    CORRADE_COMPARE(hierarchy.subtreeEnd(1), 4);
+    CORRADE_COMPARE(hierarchy.subtreeEnd(2), 5);
+    CORRADE_COMPARE(hierarchy.subtreeEnd(3), 4);
+    CORRADE_COMPARE(hierarchy.subtreeEnd(4), 5);
+
+    hierarchy.setClean();
+    hierarchy.setTransformation(1, Matrix4::translation({1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(hierarchy.dirtyRange(), (std::pair<UnsignedInt, UnsignedInt>{1, 4}));
+
+    hierarchy.setClean();
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(3), Matrix4::translation({1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(4), Matrix4{});
+}
+
+void FlatTransformationHierarchyTest::setTransformation() {
+    FlatTransformationHierarchy3D hierarchy{Parents};
+    hierarchy.setClean();
+    CORRADE_VERIFY(!hierarchy.isDirty());
+    CORRADE_COMPARE(hierarchy.dirtyRange(), (std::pair<UnsignedInt, UnsignedInt>{0, 0}));
+
+    /* Leaf, only itself is dirty */
+    hierarchy.setTransformation(4, Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(hierarchy.transformation(4), Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_VERIFY(hierarchy.isDirty());
+    CORRADE_COMPARE(hierarchy.dirtyRange(), (std::pair<UnsignedInt, UnsignedInt>{4, 5}));
+
+    /* Subtree after, extends to the end of it */
+    hierarchy.setTransformation(6, Matrix4::rotationX(35.0_degf));
+    CORRADE_COMPARE(hierarchy.dirtyRange(), (std::pair<UnsignedInt, UnsignedInt>{4, 8}));
+
+    /* Subtree before, extends the begin but the end stays */
+    hierarchy.setTransformation(1, Matrix4::rotationY(35.0_degf));
+    CORRADE_COMPARE(hierarchy.dirtyRange(), (std::pair<UnsignedInt, UnsignedInt>{1, 8}));
+}
+
+void FlatTransformationHierarchyTest::setTransformationOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FlatTransformationHierarchy3D hierarchy{Parents};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    hierarchy.transformation(8);
+    hierarchy.setTransformation(8, {});
+    hierarchy.subtreeEnd(8);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatTransformationHierarchy::transformation(): index 8 out of range for 8 objects\n"
+        "SceneGraph::FlatTransformationHierarchy::setTransformation(): index 8 out of range for 8 objects\n"
+        "SceneGraph::FlatTransformationHierarchy::subtreeEnd(): index 8 out of range for 8 objects\n");
+}
+
+void FlatTransformationHierarchyTest::setTransformations() {
+    FlatTransformationHierarchy3D hierarchy{Parents};
+    hierarchy.setClean();
+
+    const Matrix4 transformations[]{
+        Matrix4::translation(Vector3::xAxis(1.0f)),
+        Matrix4::translation(Vector3::yAxis(2.0f)),
+        Matrix4::translation(Vector3::zAxis(3.0f))
+    };
+    hierarchy.setTransformations(2, transformations);
+    CORRADE_COMPARE(hierarchy.transformation(1), Matrix4{});
+    CORRADE_COMPARE_AS(hierarchy.transformations().slice(2, 5),
+        Containers::arrayView(transformations),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(hierarchy.transformation(5), Matrix4{});
+
+    /* The range is given by the largest subtree end, not the last one */
+    CORRADE_COMPARE(hierarchy.dirtyRange(), (std::pair<UnsignedInt, UnsignedInt>{2, 5}));
+
+    /* Empty range doesn't make anything dirty */
+    hierarchy.setClean();
+    hierarchy.setTransformations(8, nullptr);
+    CORRADE_VERIFY(!hierarchy.isDirty());
+}
+
+void FlatTransformationHierarchyTest::setTransformationsOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FlatTransformationHierarchy3D hierarchy{Parents};
+    const Matrix4 transformations[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    hierarchy.setTransformations(6, transformations);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatTransformationHierarchy::setTransformations(): range [6, 9) out of range for 8 objects\n");
+}
+
+void FlatTransformationHierarchyTest::setClean() {
+    FlatTransformationHierarchy3D hierarchy{Parents};
+    const Matrix4 a = Matrix4::translation({1.0f, 2.0f, 3.0f});
+    const Matrix4 b = Matrix4::rotationZ(35.0_degf);
+    const Matrix4 c = Matrix4::scaling({2.0f, 0.5f, 1.0f});
+    const Matrix4 d = Matrix4::rotationX(-15.0_degf);
+    hierarchy
+        .setTransformation(0, a)
+        .setTransformation(1, b)
+        .setTransformation(3, c)
+        .setTransformation(7, d);
+
+    hierarchy.setClean();
+    CORRADE_VERIFY(!hierarchy.isDirty());
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(0), a);
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(1), a*b);
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(2), a*b);
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(3), a*b*c);
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(4), a*b*c);
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(5), a);
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(6), Matrix4{});
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(7), d);
+    CORRADE_COMPARE(hierarchy.absoluteTransformations().size(), 8);
+    CORRADE_COMPARE(hierarchy.absoluteTransformations()[3], a*b*c);
+}
+
+void FlatTransformationHierarchyTest::setCleanPartial() {
+    FlatTransformationHierarchy3D hierarchy{Parents};
+    const Matrix4 a = Matrix4::translation({1.0f, 2.0f, 3.0f});
+    const Matrix4 b = Matrix4::rotationZ(35.0_degf);
+    hierarchy.setTransformation(0, a);
+    hierarchy.setClean();
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(4), a);
+
+    /* Only the subtree of 3 gets recalculated, 0 stays as it was */
+    hierarchy.setTransformation(3, b);
+    CORRADE_COMPARE(hierarchy.dirtyRange(), (std::pair<UnsignedInt, UnsignedInt>{3, 5}));
+    hierarchy.setClean();
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(0), a);
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(2), a);
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(3), a*b);
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(4), a*b);
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(5), a);
+
+    /* Calling it again is a no-op */
+    hierarchy.setClean();
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(4), a*b);
+}
+
+void FlatTransformationHierarchyTest::setCleanConsistentWithObject() {
+    Scene3D scene;
+    Object3D* objects[8];
+    for(std::size_t i = 0; i != Containers::arraySize(Parents); ++i)
+        objects[i] = new Object3D{Parents[i] == -1 ? &scene : objects[Parents[i]]};
+
+    FlatTransformationHierarchy3D hierarchy{Parents};
+    for(std::size_t i = 0; i != Containers::arraySize(Parents); ++i) {
+        const Matrix4 transformation =
+            Matrix4::translation({Float(i), 1.0f, -Float(i)})*
+            Matrix4::rotation(Deg(15.0f*i), Vector3{1.0f, 1.0f, 0.0f}.normalized());
+        objects[i]->setTransformation(transformation);
+        hierarchy.setTransformation(i, transformation);
+    }
+
+    hierarchy.setClean();
+    for(std::size_t i = 0; i != Containers::arraySize(Parents); ++i)
+        CORRADE_COMPARE(hierarchy.absoluteTransformation(i), objects[i]->absoluteTransformationMatrix());
+}
+
+void FlatTransformationHierarchyTest::setClean2D() {
+    FlatTransformationHierarchy2D hierarchy{-1, 0, 1};
+    const Matrix3 a = Matrix3::translation({1.0f, 2.0f});
+    const Matrix3 b = Matrix3::rotation(35.0_degf);
+    hierarchy
+        .setTransformation(0, a)
+        .setTransformation(2, b);
+
+    hierarchy.setClean();
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(0), a);
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(1), a);
+    CORRADE_COMPARE(hierarchy.absoluteTransformation(2), a*b);
+}
+
+void FlatTransformationHierarchyTest::absoluteTransformationOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FlatTransformationHierarchy3D hierarchy{Parents};
+    hierarchy.setClean();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    hierarchy.absoluteTransformation(8);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatTransformationHierarchy::absoluteTransformation(): index 8 out of range for 8 objects\n");
+}
+
+void FlatTransformationHierarchyTest::absoluteTransformationDirty() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FlatTransformationHierarchy3D hierarchy{Parents};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    hierarchy.absoluteTransformation(3);
+    hierarchy.absoluteTransformations();
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatTransformationHierarchy::absoluteTransformation(): the hierarchy is dirty\n"
+        "SceneGraph::FlatTransformationHierarchy::absoluteTransformations(): the hierarchy is dirty\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlatTransformationHierarchyTest)
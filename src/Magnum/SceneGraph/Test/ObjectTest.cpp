@@ -28,7 +28,9 @@
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 
+#include "Magnum/SceneGraph/DualQuaternionTransformation.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/RigidMatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph { namespace Test { namespace {
@@ -48,9 +50,16 @@ struct ObjectTest: TestSuite::Tester {
     void transformationsRelative();
     void transformationsOrphan();
     void transformationsDuplicate();
+    void transformationMatricesInto();
+    void transformationMatricesIntoAbstract();
+    void transformationMatricesIntoWrongSize();
     void setClean();
     void setCleanListHierarchy();
     void setCleanListBulk();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    template<class T> void setCleanParallel();
+    void setCleanParallelSubtree();
+    #endif
 
     void rangeBasedForChildren();
     void rangeBasedForFeatures();
@@ -73,6 +82,59 @@ class CachingObject: public Object3D, AbstractFeature3D {
         }
 };
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+constexpr struct {
+    const char* name;
+    UnsignedInt threadCount;
+} SetCleanParallelData[]{
+    {"single thread", 1},
+    {"two threads", 2},
+    {"seven threads", 7},
+    {"hardware concurrency", 0}
+};
+
+template<class> struct TransformationName;
+template<> struct TransformationName<MatrixTransformation3D> {
+    static const char* name() { return "MatrixTransformation3D"; }
+};
+template<> struct TransformationName<RigidMatrixTransformation3D> {
+    static const char* name() { return "RigidMatrixTransformation3D"; }
+};
+template<> struct TransformationName<DualQuaternionTransformation> {
+    static const char* name() { return "DualQuaternionTransformation"; }
+};
+
+class ParallelCachingFeature: public AbstractFeature3D {
+    public:
+        explicit ParallelCachingFeature(AbstractObject3D& object): AbstractFeature3D{object} {
+            setCachedTransformations(CachedTransformation::Absolute);
+        }
+
+        Matrix4 cleanedAbsoluteTransformation{Math::ZeroInit};
+        Int cleanCount{};
+
+    protected:
+        void clean(const Matrix4& absoluteTransformation) override {
+            cleanedAbsoluteTransformation = absoluteTransformation;
+            ++cleanCount;
+        }
+};
+
+/* Subtrees of different sizes and depths, so the work gets unevenly
+   distributed and has to be stolen */
+template<class T> void populateParallelHierarchy(Object<T>& parent, std::vector<Object<T>*>& objects, std::vector<ParallelCachingFeature*>& features, UnsignedInt depth) {
+    const UnsignedInt childCount = depth < 2 ? 7 - depth*3 : (objects.size() % 3);
+    for(UnsignedInt i = 0; i != childCount && depth != 6; ++i) {
+        Object<T>* object = new Object<T>{&parent};
+        object->rotateY(Deg(15.0f + objects.size()))
+            .translate({Float(i), 0.5f*depth, -1.0f});
+        objects.push_back(object);
+        features.push_back(new ParallelCachingFeature{*object});
+        populateParallelHierarchy(*object, objects, features, depth + 1);
+    }
+}
+#endif
+
 ObjectTest::ObjectTest() {
     addTests({&ObjectTest::addFeature,
 
@@ -86,11 +148,24 @@ ObjectTest::ObjectTest() {
               &ObjectTest::transformationsRelative,
               &ObjectTest::transformationsOrphan,
               &ObjectTest::transformationsDuplicate,
+              &ObjectTest::transformationMatricesInto,
+              &ObjectTest::transformationMatricesIntoAbstract,
+              &ObjectTest::transformationMatricesIntoWrongSize,
               &ObjectTest::setClean,
               &ObjectTest::setCleanListHierarchy,
-              &ObjectTest::setCleanListBulk,
+              &ObjectTest::setCleanListBulk});
 
-              &ObjectTest::rangeBasedForChildren,
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    addInstancedTests<ObjectTest>({
+        &ObjectTest::setCleanParallel<MatrixTransformation3D>,
+        &ObjectTest::setCleanParallel<RigidMatrixTransformation3D>,
+        &ObjectTest::setCleanParallel<DualQuaternionTransformation>},
+        Containers::arraySize(SetCleanParallelData));
+
+    addTests({&ObjectTest::setCleanParallelSubtree});
+    #endif
+
+    addTests({&ObjectTest::rangeBasedForChildren,
               &ObjectTest::rangeBasedForFeatures});
 }
 
@@ -326,6 +401,62 @@ void ObjectTest::transformationsDuplicate() {
     }));
 }
 
+void ObjectTest::transformationMatricesInto() {
+    Scene3D s;
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.scale(Vector3(0.5f));
+    Object3D third(&first);
+    third.translate(Vector3::xAxis(5.0f));
+
+    Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+    Matrix4 firstExpected = initial*Matrix4::rotationZ(Deg(30.0f));
+    Matrix4 secondExpected = firstExpected*Matrix4::scaling(Vector3(0.5f));
+    Matrix4 thirdExpected = firstExpected*Matrix4::translation(Vector3::xAxis(5.0f));
+
+    Matrix4 out[4];
+    s.transformationMatricesInto({second, third, first, second}, initial, out);
+    CORRADE_COMPARE(out[0], secondExpected);
+    CORRADE_COMPARE(out[1], thirdExpected);
+    CORRADE_COMPARE(out[2], firstExpected);
+    CORRADE_COMPARE(out[3], secondExpected);
+
+    /* Calling again with a subset reuses the scratch memory, which shouldn't
+       leak any state from the previous call */
+    third.translate(Vector3::yAxis(1.0f));
+    s.transformationMatricesInto({third}, initial, Containers::arrayView(out).prefix(1));
+    CORRADE_COMPARE(out[0], firstExpected*Matrix4::translation({5.0f, 1.0f, 0.0f}));
+}
+
+void ObjectTest::transformationMatricesIntoAbstract() {
+    Scene3D s;
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.scale(Vector3(0.5f));
+
+    Matrix4 out[2];
+    static_cast<AbstractObject3D&>(s).transformationMatricesInto({second, first}, {}, out);
+    CORRADE_COMPARE(out[0], Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)));
+    CORRADE_COMPARE(out[1], Matrix4::rotationZ(Deg(30.0f)));
+}
+
+void ObjectTest::transformationMatricesIntoWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Scene3D s;
+    Object3D first(&s);
+    Matrix4 out[2];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    s.transformationMatricesInto({first}, {}, out);
+    CORRADE_COMPARE(o.str(), "SceneGraph::Object::transformationMatricesInto(): expected 1 destination matrices but got 2\n");
+}
+
 void ObjectTest::setClean() {
     Scene3D scene;
 
@@ -506,6 +637,93 @@ void ObjectTest::setCleanListBulk() {
     CORRADE_COMPARE(d.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::scaling(Vector3(-2.0f)));
 }
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+template<class T> void ObjectTest::setCleanParallel() {
+    auto&& data = SetCleanParallelData[testCaseInstanceId()];
+    setTestCaseTemplateName(TransformationName<T>::name());
+    setTestCaseDescription(data.name);
+
+    Scene<T> scene;
+    scene.translate({0.0f, 1.0f, 0.0f});
+    std::vector<Object<T>*> objects;
+    std::vector<ParallelCachingFeature*> features;
+    populateParallelHierarchy(scene, objects, features, 0);
+    CORRADE_VERIFY(objects.size() > 100);
+
+    /* The hierarchy is small, so the object count threshold is disabled to
+       have the threads used */
+    scene.setCleanParallel(data.threadCount, 0);
+    CORRADE_VERIFY(!scene.isDirty());
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        CORRADE_VERIFY(!objects[i]->isDirty());
+        CORRADE_COMPARE(features[i]->cleanCount, 1);
+        /* The parent transformations are composed in the same order as in
+           the serial case, so the result should be bit-exact */
+        CORRADE_COMPARE(features[i]->cleanedAbsoluteTransformation, objects[i]->absoluteTransformationMatrix());
+    }
+
+    /* Cleaning again does nothing, as everything is already clean */
+    scene.setCleanParallel(data.threadCount, 0);
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        CORRADE_COMPARE(features[i]->cleanCount, 1);
+    }
+
+    /* Modifying a single object cleans only the object and its children */
+    objects[1]->translate({0.0f, 0.0f, 3.0f});
+    scene.setCleanParallel(data.threadCount, 0);
+    CORRADE_COMPARE(features[0]->cleanCount, 1);
+    CORRADE_COMPARE(features[1]->cleanCount, 2);
+    CORRADE_COMPARE(features[1]->cleanedAbsoluteTransformation, objects[1]->absoluteTransformationMatrix());
+    for(Object<T>& child: objects[1]->children()) {
+        ParallelCachingFeature& feature = static_cast<ParallelCachingFeature&>(*child.features().first());
+        CORRADE_COMPARE(feature.cleanCount, 2);
+        CORRADE_COMPARE(feature.cleanedAbsoluteTransformation, child.absoluteTransformationMatrix());
+    }
+
+    /* Modifying a leaf object keeps its parents clean, its absolute
+       transformation has to be calculated from them */
+    Object<T>& leaf = *objects.back();
+    CORRADE_VERIFY(leaf.children().isEmpty());
+    CORRADE_VERIFY(leaf.parent() != &scene);
+    ParallelCachingFeature& leafParentFeature = static_cast<ParallelCachingFeature&>(*leaf.parent()->features().first());
+    const Int leafParentCleanCount = leafParentFeature.cleanCount;
+    leaf.rotateX(Deg(35.0f));
+    CORRADE_VERIFY(!leaf.parent()->isDirty());
+    scene.setCleanParallel(data.threadCount, 0);
+    CORRADE_VERIFY(!leaf.isDirty());
+    CORRADE_COMPARE(features.back()->cleanCount, 2);
+    CORRADE_COMPARE(features.back()->cleanedAbsoluteTransformation, leaf.absoluteTransformationMatrix());
+    CORRADE_COMPARE(leafParentFeature.cleanCount, leafParentCleanCount);
+}
+
+void ObjectTest::setCleanParallelSubtree() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(2.0f));
+    Object3D b{&a};
+    b.rotateY(Deg(90.0f));
+    Object3D c{&b};
+    c.scale(Vector3{3.0f});
+    Object3D d{&scene};
+    ParallelCachingFeature featureA{a}, featureC{c}, featureD{d};
+
+    /* Cleaning a subtree cleans also its dirty parents, same as setClean()
+       does, but not other subtrees. The subtree is below the object count
+       threshold, so it's done without creating any threads. */
+    b.setCleanParallel(2);
+    CORRADE_VERIFY(!scene.isDirty());
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_VERIFY(d.isDirty());
+    CORRADE_COMPARE(featureA.cleanCount, 1);
+    CORRADE_COMPARE(featureC.cleanCount, 1);
+    CORRADE_COMPARE(featureD.cleanCount, 0);
+    CORRADE_COMPARE(featureA.cleanedAbsoluteTransformation, a.absoluteTransformationMatrix());
+    CORRADE_COMPARE(featureC.cleanedAbsoluteTransformation, c.absoluteTransformationMatrix());
+}
+#endif
+
 void ObjectTest::rangeBasedForChildren() {
     Scene3D scene;
     Object3D a(&scene);
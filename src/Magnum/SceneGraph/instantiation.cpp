@@ -30,6 +30,7 @@
 #include "Magnum/SceneGraph/DualComplexTransformation.h"
 #include "Magnum/SceneGraph/DualQuaternionTransformation.h"
 #include "Magnum/SceneGraph/FeatureGroup.hpp"
+#include "Magnum/SceneGraph/FlatTransformationHierarchy.hpp"
 #include "Magnum/SceneGraph/MatrixTransformation2D.hpp"
 #include "Magnum/SceneGraph/MatrixTransformation3D.hpp"
 #include "Magnum/SceneGraph/Object.hpp"
@@ -72,6 +73,9 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Camera<3, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Drawable<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Drawable<3, Float>;
 
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatTransformationHierarchy<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP FlatTransformationHierarchy<3, Float>;
+
 /* These have rotation(const Complex&) and rotation(const Quaternion&) defined
    in a hpp to avoid dragging in Complex / Quaternion for every user */
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicMatrixTransformation2D<Float>;
@@ -0,0 +1,235 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/String.h>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#include <vector>
+#endif
+
+#include "Magnum/Tracer.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct TracerTest: TestSuite::Tester {
+    explicit TracerTest();
+
+    void construct();
+    void constructZeroCapacity();
+    void constructAnotherActive();
+
+    void zoneNoTracer();
+    void zoneNested();
+    void zoneOverflow();
+    void zoneMultipleThreads();
+    void zoneMacro();
+
+    void chromeTraceEmpty();
+    void chromeTraceEscape();
+};
+
+TracerTest::TracerTest() {
+    addTests({&TracerTest::construct,
+              &TracerTest::constructZeroCapacity,
+              &TracerTest::constructAnotherActive,
+
+              &TracerTest::zoneNoTracer,
+              &TracerTest::zoneNested,
+              &TracerTest::zoneOverflow,
+              &TracerTest::zoneMultipleThreads,
+              &TracerTest::zoneMacro,
+
+              &TracerTest::chromeTraceEmpty,
+              &TracerTest::chromeTraceEscape});
+}
+
+void TracerTest::construct() {
+    CORRADE_VERIFY(!Tracer::current());
+
+    {
+        Tracer tracer{128};
+        CORRADE_COMPARE(Tracer::current(), &tracer);
+        CORRADE_COMPARE(tracer.capacityPerThread(), 128);
+        CORRADE_COMPARE(tracer.threadCount(), 0);
+        CORRADE_COMPARE(tracer.zoneCount(), 0);
+        CORRADE_COMPARE(tracer.droppedCount(), 0);
+    }
+
+    CORRADE_VERIFY(!Tracer::current());
+}
+
+void TracerTest::constructZeroCapacity() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Tracer tracer{0};
+    CORRADE_COMPARE(out.str(), "Tracer: expected non-zero capacity per thread\n");
+}
+
+void TracerTest::constructAnotherActive() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Tracer tracer;
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        Tracer another;
+    }
+    CORRADE_COMPARE(out.str(), "Tracer: another instance is already active\n");
+
+    /* Destroying the other instance didn't reset the current one */
+    CORRADE_COMPARE(Tracer::current(), &tracer);
+}
+
+void TracerTest::zoneNoTracer() {
+    {
+        Tracer::Zone zone{"Nothing"};
+    }
+
+    /* The zone isn't retroactively recorded */
+    Tracer tracer;
+    CORRADE_COMPARE(tracer.zoneCount(), 0);
+    CORRADE_COMPARE(tracer.threadCount(), 0);
+}
+
+void TracerTest::zoneNested() {
+    Tracer tracer;
+
+    {
+        Tracer::Zone outer{"Outer"};
+        {
+            Tracer::Zone inner{"Inner"};
+        }
+        {
+            Tracer::Zone second{"Second inner"};
+        }
+    }
+
+    CORRADE_COMPARE(tracer.threadCount(), 1);
+    CORRADE_COMPARE(tracer.zoneCount(), 3);
+    CORRADE_COMPARE(tracer.droppedCount(), 0);
+
+    /* The zones got recorded inner first, but are exported sorted by begin
+       time with the enclosing zone first */
+    const std::string trace = tracer.chromeTrace();
+    CORRADE_VERIFY(Utility::String::beginsWith(trace, "{\"traceEvents\":[\n"));
+    CORRADE_VERIFY(Utility::String::endsWith(trace, "\n],\"displayTimeUnit\":\"ms\"}\n"));
+    const std::size_t outer = trace.find("{\"name\":\"Outer\",\"cat\":\"magnum\",\"ph\":\"X\",\"ts\":");
+    const std::size_t inner = trace.find("{\"name\":\"Inner\",\"cat\":\"magnum\",\"ph\":\"X\",\"ts\":");
+    const std::size_t second = trace.find("{\"name\":\"Second inner\",\"cat\":\"magnum\",\"ph\":\"X\",\"ts\":");
+    CORRADE_VERIFY(outer != std::string::npos);
+    CORRADE_VERIFY(inner != std::string::npos);
+    CORRADE_VERIFY(second != std::string::npos);
+    CORRADE_VERIFY(outer < inner);
+    CORRADE_VERIFY(inner < second);
+    CORRADE_VERIFY(trace.find("\"pid\":1,\"tid\":0}") != std::string::npos);
+}
+
+void TracerTest::zoneOverflow() {
+    Tracer tracer{2};
+
+    for(std::size_t i = 0; i != 5; ++i) {
+        Tracer::Zone zone{"Zone"};
+    }
+
+    CORRADE_COMPARE(tracer.zoneCount(), 2);
+    CORRADE_COMPARE(tracer.droppedCount(), 3);
+}
+
+void TracerTest::zoneMultipleThreads() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Threads are not available on Emscripten.");
+    #else
+    Tracer tracer{1024};
+
+    {
+        Tracer::Zone zone{"Main"};
+
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i != 4; ++i) threads.emplace_back([]() {
+            for(std::size_t j = 0; j != 100; ++j) {
+                Tracer::Zone zone{"Worker"};
+            }
+        });
+        for(std::thread& thread: threads) thread.join();
+    }
+
+    CORRADE_COMPARE(tracer.threadCount(), 5);
+    CORRADE_COMPARE(tracer.zoneCount(), 401);
+    CORRADE_COMPARE(tracer.droppedCount(), 0);
+
+    /* Each thread has its own ID */
+    const std::string trace = tracer.chromeTrace();
+    for(const char* tid: {"\"tid\":0}", "\"tid\":1}", "\"tid\":2}", "\"tid\":3}", "\"tid\":4}"}) {
+        CORRADE_ITERATION(tid);
+        CORRADE_VERIFY(trace.find(tid) != std::string::npos);
+    }
+    #endif
+}
+
+void TracerTest::zoneMacro() {
+    Tracer tracer;
+
+    {
+        MAGNUM_TRACE_ZONE("Macro");
+        MAGNUM_TRACE_ZONE("Another in the same scope");
+    }
+
+    #ifdef MAGNUM_BUILD_TRACING
+    CORRADE_COMPARE(tracer.zoneCount(), 2);
+    #else
+    CORRADE_COMPARE(tracer.zoneCount(), 0);
+    #endif
+}
+
+void TracerTest::chromeTraceEmpty() {
+    Tracer tracer;
+    CORRADE_COMPARE(tracer.chromeTrace(),
+        "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+void TracerTest::chromeTraceEscape() {
+    Tracer tracer;
+
+    {
+        Tracer::Zone zone{"A \"quoted\"\\path\n"};
+    }
+
+    CORRADE_VERIFY(tracer.chromeTrace().find("{\"name\":\"A \\\"quoted\\\"\\\\path \",") != std::string::npos);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::TracerTest)
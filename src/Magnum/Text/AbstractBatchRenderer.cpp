@@ -0,0 +1,396 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AbstractBatchRenderer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Text/Render.h"
+
+namespace Magnum { namespace Text {
+
+namespace {
+
+/* Same as in Renderer.cpp */
+struct Vertex {
+    Vector2 position, textureCoordinates;
+};
+
+struct TextData {
+    std::string text;
+    Vector2 position;
+    Range2D rectangle;
+    /* Reserved glyph range in the arena */
+    UnsignedInt offset, capacity;
+    Alignment alignment;
+    bool used, dirty;
+};
+
+}
+
+struct AbstractBatchRenderer::State {
+    explicit State(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const UnsignedInt capacity): font(font), cache(cache), size{size}, capacity{capacity}, vertices{Containers::ValueInit, std::size_t(capacity)*4} {
+        if(capacity) freeRanges.emplace_back(0, capacity);
+    }
+
+    AbstractFont& font;
+    const AbstractGlyphCache& cache;
+    Float size;
+    UnsignedInt capacity;
+    Containers::Array<Vertex> vertices;
+
+    std::vector<TextData> texts;
+    std::vector<UnsignedInt> freeIds;
+    std::size_t textCount{};
+
+    /* Offset and size of free glyph ranges, sorted by offset with adjacent
+       ranges always merged together */
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> freeRanges;
+    /* Where the next allocation starts looking for a free range */
+    UnsignedInt cursor{};
+    UnsignedInt reserved{};
+
+    /* Offset and size of glyph ranges to upload in the next update(), in no
+       particular order and possibly overlapping */
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> dirtyRanges;
+    bool dirtyTexts{};
+
+    UnsignedInt drawGlyphCount() const;
+    void zero(UnsignedInt offset, UnsignedInt count);
+    UnsignedInt allocateFromFreeRanges(UnsignedInt count);
+    void compact();
+    UnsignedInt allocate(UnsignedInt count);
+    void free(UnsignedInt offset, UnsignedInt count);
+};
+
+UnsignedInt AbstractBatchRenderer::State::drawGlyphCount() const {
+    if(!freeRanges.empty() && freeRanges.back().first + freeRanges.back().second == capacity)
+        return freeRanges.back().first;
+    return capacity;
+}
+
+void AbstractBatchRenderer::State::zero(const UnsignedInt offset, const UnsignedInt count) {
+    std::fill(vertices.begin() + std::size_t(offset)*4, vertices.begin() + std::size_t(offset + count)*4, Vertex{});
+}
+
+/* Next-fit allocation, returns ~UnsignedInt{} if no free range is large
+   enough */
+UnsignedInt AbstractBatchRenderer::State::allocateFromFreeRanges(const UnsignedInt count) {
+    /* First look only at the space after the cursor, then everywhere */
+    for(const bool afterCursor: {true, false}) {
+        for(std::size_t i = 0; i != freeRanges.size(); ++i) {
+            std::pair<UnsignedInt, UnsignedInt>& range = freeRanges[i];
+            const UnsignedInt end = range.first + range.second;
+            const UnsignedInt start = afterCursor ? Math::max(range.first, cursor) : range.first;
+            if(start >= end || end - start < count) continue;
+
+            /* Cut the allocation from the beginning of the range */
+            if(start == range.first) {
+                range.first += count;
+                range.second -= count;
+                if(!range.second) freeRanges.erase(freeRanges.begin() + i);
+
+            /* Cut it from the middle or the end */
+            } else {
+                range.second = start - range.first;
+                if(start + count != end)
+                    freeRanges.emplace(freeRanges.begin() + i + 1, start + count, end - start - count);
+            }
+
+            cursor = start + count;
+            return start;
+        }
+    }
+
+    return ~UnsignedInt{};
+}
+
+/* Moves all reserved ranges to the beginning of the arena, leaving a single
+   free range at the end */
+void AbstractBatchRenderer::State::compact() {
+    /* Everything up to the end of the last reserved range or the last range
+       waiting for an upload may change */
+    UnsignedInt dirtyEnd = drawGlyphCount();
+    for(const std::pair<UnsignedInt, UnsignedInt>& range: dirtyRanges)
+        dirtyEnd = Math::max(dirtyEnd, range.first + range.second);
+
+    /* Move the ranges in the order they are in the arena, so a move never
+       overwrites data that weren't moved yet */
+    std::vector<TextData*> sorted;
+    sorted.reserve(textCount);
+    for(TextData& text: texts)
+        if(text.used && text.capacity) sorted.push_back(&text);
+    std::sort(sorted.begin(), sorted.end(), [](const TextData* a, const TextData* b) {
+        return a->offset < b->offset;
+    });
+
+    UnsignedInt offset = 0;
+    for(TextData* text: sorted) {
+        if(text->offset != offset)
+            std::memmove(vertices.data() + std::size_t(offset)*4, vertices.data() + std::size_t(text->offset)*4, std::size_t(text->capacity)*4*sizeof(Vertex));
+        text->offset = offset;
+        offset += text->capacity;
+    }
+    zero(offset, dirtyEnd - Math::min(offset, dirtyEnd));
+
+    freeRanges.clear();
+    if(offset != capacity)
+        freeRanges.emplace_back(offset, capacity - offset);
+    cursor = offset;
+    dirtyRanges.clear();
+    if(dirtyEnd) dirtyRanges.emplace_back(0, dirtyEnd);
+}
+
+UnsignedInt AbstractBatchRenderer::State::allocate(const UnsignedInt count) {
+    reserved += count;
+    if(!count) return 0;
+
+    UnsignedInt offset = allocateFromFreeRanges(count);
+    if(offset == ~UnsignedInt{}) {
+        compact();
+        offset = allocateFromFreeRanges(count);
+        CORRADE_INTERNAL_ASSERT(offset != ~UnsignedInt{});
+    }
+
+    return offset;
+}
+
+void AbstractBatchRenderer::State::free(const UnsignedInt offset, const UnsignedInt count) {
+    reserved -= count;
+    if(!count) return;
+
+    /* The range gets uploaded as degenerate triangles in the next update() */
+    zero(offset, count);
+    dirtyRanges.emplace_back(offset, count);
+
+    /* Insert into the free ranges, merging with the neighbors */
+    auto next = std::lower_bound(freeRanges.begin(), freeRanges.end(), std::make_pair(offset, count));
+    if(next != freeRanges.begin() && (next - 1)->first + (next - 1)->second == offset) {
+        auto prev = next - 1;
+        prev->second += count;
+        if(next != freeRanges.end() && offset + count == next->first) {
+            prev->second += next->second;
+            freeRanges.erase(next);
+        }
+    } else if(next != freeRanges.end() && offset + count == next->first) {
+        next->first = offset;
+        next->second += count;
+    } else freeRanges.emplace(next, offset, count);
+}
+
+
+AbstractBatchRenderer::AbstractBatchRenderer(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const UnsignedInt glyphCapacity): _state{Containers::InPlaceInit, font, cache, size, glyphCapacity} {}
+
+AbstractBatchRenderer::~AbstractBatchRenderer() = default;
+
+UnsignedInt AbstractBatchRenderer::glyphCapacity() const {
+    return _state->capacity;
+}
+
+UnsignedInt AbstractBatchRenderer::reservedGlyphCount() const {
+    return _state->reserved;
+}
+
+UnsignedInt AbstractBatchRenderer::drawGlyphCount() const {
+    return _state->drawGlyphCount();
+}
+
+std::size_t AbstractBatchRenderer::textCount() const {
+    return _state->textCount;
+}
+
+UnsignedInt AbstractBatchRenderer::add(const std::string& text, const Vector2& position, const Alignment alignment) {
+    State& state = *_state;
+    CORRADE_ASSERT(text.size() <= state.capacity - state.reserved,
+        "Text::AbstractBatchRenderer::add(): can't fit" << text.size() << "glyphs into" << state.capacity - state.reserved << "remaining", {});
+
+    /* Allocate before the text is added, as the allocation may move the
+       other texts around */
+    const UnsignedInt offset = state.allocate(text.size());
+
+    UnsignedInt id;
+    if(state.freeIds.empty()) {
+        id = state.texts.size();
+        state.texts.emplace_back();
+    } else {
+        id = state.freeIds.back();
+        state.freeIds.pop_back();
+    }
+
+    TextData& data = state.texts[id];
+    data.text = text;
+    data.position = position;
+    data.rectangle = {};
+    data.offset = offset;
+    data.capacity = text.size();
+    data.alignment = alignment;
+    data.used = true;
+    data.dirty = true;
+    ++state.textCount;
+    state.dirtyTexts = true;
+    return id;
+}
+
+void AbstractBatchRenderer::set(const UnsignedInt id, const std::string& text) {
+    State& state = *_state;
+    CORRADE_ASSERT(id < state.texts.size() && state.texts[id].used,
+        "Text::AbstractBatchRenderer::set(): invalid ID" << id, );
+
+    TextData& data = state.texts[id];
+    if(text.size() > data.capacity) {
+        CORRADE_ASSERT(text.size() - data.capacity <= state.capacity - state.reserved,
+            "Text::AbstractBatchRenderer::set(): can't fit" << text.size() << "glyphs into" << state.capacity - state.reserved + data.capacity << "remaining", );
+
+        /* Free the original range first so it can be reused by the
+           compaction if there's no other space */
+        state.free(data.offset, data.capacity);
+        data.capacity = 0;
+        data.offset = state.allocate(text.size());
+        data.capacity = text.size();
+    }
+
+    data.text = text;
+    data.dirty = true;
+    state.dirtyTexts = true;
+}
+
+void AbstractBatchRenderer::setPosition(const UnsignedInt id, const Vector2& position) {
+    State& state = *_state;
+    CORRADE_ASSERT(id < state.texts.size() && state.texts[id].used,
+        "Text::AbstractBatchRenderer::setPosition(): invalid ID" << id, );
+
+    TextData& data = state.texts[id];
+    data.position = position;
+    data.dirty = true;
+    state.dirtyTexts = true;
+}
+
+void AbstractBatchRenderer::remove(const UnsignedInt id) {
+    State& state = *_state;
+    CORRADE_ASSERT(id < state.texts.size() && state.texts[id].used,
+        "Text::AbstractBatchRenderer::remove(): invalid ID" << id, );
+
+    TextData& data = state.texts[id];
+    state.free(data.offset, data.capacity);
+    /* Clearing keeps the string capacity for when the ID gets reused */
+    data.text.clear();
+    data.capacity = 0;
+    data.used = false;
+    data.dirty = false;
+    state.freeIds.push_back(id);
+    --state.textCount;
+}
+
+const std::string& AbstractBatchRenderer::text(const UnsignedInt id) const {
+    #ifndef CORRADE_NO_ASSERT
+    /* Returned on an invalid ID, there might be no text at all */
+    static const std::string empty;
+    #endif
+    CORRADE_ASSERT(id < _state->texts.size() && _state->texts[id].used,
+        "Text::AbstractBatchRenderer::text(): invalid ID" << id, empty);
+    return _state->texts[id].text;
+}
+
+Range2D AbstractBatchRenderer::rectangle(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _state->texts.size() && _state->texts[id].used,
+        "Text::AbstractBatchRenderer::rectangle(): invalid ID" << id, {});
+    return _state->texts[id].rectangle;
+}
+
+bool AbstractBatchRenderer::isDirty() const {
+    return _state->dirtyTexts || !_state->dirtyRanges.empty();
+}
+
+void AbstractBatchRenderer::update() {
+    State& state = *_state;
+
+    /* Layout all dirty texts */
+    if(state.dirtyTexts) for(TextData& data: state.texts) {
+        if(!data.used || !data.dirty) continue;
+
+        const Containers::ArrayView<Vertex> vertices = state.vertices.slice(std::size_t(data.offset)*4, std::size_t(data.offset + data.capacity)*4);
+        Containers::StridedArrayView1D<Vector2> positions, textureCoordinates;
+        if(!vertices.empty()) {
+            positions = {vertices, &vertices[0].position, vertices.size(), sizeof(Vertex)};
+            textureCoordinates = {vertices, &vertices[0].textureCoordinates, vertices.size(), sizeof(Vertex)};
+        }
+
+        const std::pair<UnsignedInt, Range2D> rendered = renderInto(state.font, state.cache, state.size, {data.text.data(), data.text.size()}, positions, textureCoordinates, data.alignment);
+        for(std::size_t i = 0, iMax = std::size_t(rendered.first)*4; i != iMax; ++i)
+            positions[i] += data.position;
+        data.rectangle = rendered.second.translated(data.position);
+
+        /* Make the unused rest of the range degenerate */
+        state.zero(data.offset + rendered.first, data.capacity - rendered.first);
+
+        if(data.capacity) state.dirtyRanges.emplace_back(data.offset, data.capacity);
+        data.dirty = false;
+    }
+    state.dirtyTexts = false;
+
+    if(state.dirtyRanges.empty()) return;
+
+    /* Merge overlapping and adjacent ranges and upload them */
+    std::sort(state.dirtyRanges.begin(), state.dirtyRanges.end());
+    const Containers::ArrayView<const char> data = vertexData();
+    std::pair<UnsignedInt, UnsignedInt> current{state.dirtyRanges[0].first, state.dirtyRanges[0].first + state.dirtyRanges[0].second};
+    for(std::size_t i = 1; i <= state.dirtyRanges.size(); ++i) {
+        if(i != state.dirtyRanges.size() && state.dirtyRanges[i].first <= current.second) {
+            current.second = Math::max(current.second, state.dirtyRanges[i].first + state.dirtyRanges[i].second);
+            continue;
+        }
+
+        doUpload(current.first, data.slice(std::size_t(current.first)*4*sizeof(Vertex), std::size_t(current.second)*4*sizeof(Vertex)));
+
+        if(i != state.dirtyRanges.size())
+            current = {state.dirtyRanges[i].first, state.dirtyRanges[i].first + state.dirtyRanges[i].second};
+    }
+    state.dirtyRanges.clear();
+}
+
+Containers::ArrayView<const char> AbstractBatchRenderer::vertexData() const {
+    return {reinterpret_cast<const char*>(_state->vertices.data()), _state->vertices.size()*sizeof(Vertex)};
+}
+
+Containers::StridedArrayView1D<const Vector2> AbstractBatchRenderer::positions() const {
+    const Containers::ArrayView<const Vertex> vertices = _state->vertices;
+    if(vertices.empty()) return {};
+    return {vertices, &vertices[0].position, vertices.size(), sizeof(Vertex)};
+}
+
+Containers::StridedArrayView1D<const Vector2> AbstractBatchRenderer::textureCoordinates() const {
+    const Containers::ArrayView<const Vertex> vertices = _state->vertices;
+    if(vertices.empty()) return {};
+    return {vertices, &vertices[0].textureCoordinates, vertices.size(), sizeof(Vertex)};
+}
+
+}}
@@ -0,0 +1,241 @@
+#ifndef Magnum_Text_AbstractBatchRenderer_h
+#define Magnum_Text_AbstractBatchRenderer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::AbstractBatchRenderer
+ * @m_since_latest
+ */
+
+#include <string>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/Alignment.h"
+#include "Magnum/Text/visibility.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Base for batched text renderers
+@m_since_latest
+
+An API-agnostic base for rendering many independent texts with a single draw
+call. See @ref BatchRenderer for a concrete GL implementation.
+
+@section Text-AbstractBatchRenderer-arena Vertex arena
+
+All texts share a single vertex arena with room for @ref glyphCapacity()
+glyphs, four vertices each, and a single index buffer with six indices for
+each glyph that never changes. Each text added with @ref add() reserves a
+contiguous range of glyphs in the arena, as large as the byte size of the
+text. Unused glyphs in a range, as well as ranges not reserved by any text,
+are filled with zeros, which makes them degenerate triangles that don't
+produce any fragments. Thus the whole arena up to @ref drawGlyphCount() can
+be drawn at once.
+
+The ranges are allocated in a ring --- a new range is placed after the
+previously allocated one if possible and the allocation wraps around to the
+beginning of the arena only once the end is reached. That keeps freshly
+changed texts close together, which keeps the partial uploads small. If a
+text doesn't fit into any free range, the arena is compacted first, so a
+text can be added as long as the total reserved size doesn't exceed the
+capacity.
+
+@section Text-AbstractBatchRenderer-updates Partial updates
+
+Functions that change a text only mark it as dirty, the actual layout and
+upload is done for all dirty texts at once in @ref update(). A text that
+changes to one that's not larger than the range it reserved is laid out in
+place, otherwise its range is freed and a new one allocated. After the
+layout, the dirty glyph ranges are merged and @ref doUpload() is called once
+for each of them with just the changed part of the arena.
+
+@section Text-AbstractBatchRenderer-subclassing Subclassing
+
+The subclass needs to implement @ref doUpload() that copies given part of
+@ref vertexData() to the GPU. Vertex data are interleaved, each vertex
+being a two-component position followed by two-component texture
+coordinates, glyph vertices ordered the same way as in
+@ref renderInto(). Each glyph @f$ i @f$ is meant to be drawn with indices
+@f$ \{ 4i, 4i + 1, 4i + 2, 4i + 1, 4i + 3, 4i + 2 \} @f$.
+*/
+class MAGNUM_TEXT_EXPORT AbstractBatchRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font to layout the texts with
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param glyphCapacity Capacity of the vertex arena in glyphs
+         *
+         * The @p font and @p cache are expected to be kept in scope for the
+         * whole lifetime of the instance. The arena is allocated upfront and
+         * filled with zeros.
+         */
+        explicit AbstractBatchRenderer(AbstractFont& font, const AbstractGlyphCache& cache, Float size, UnsignedInt glyphCapacity);
+
+        /** @brief Copying is not allowed */
+        AbstractBatchRenderer(const AbstractBatchRenderer&) = delete;
+
+        /** @brief Moving is not allowed */
+        AbstractBatchRenderer(AbstractBatchRenderer&&) = delete;
+
+        virtual ~AbstractBatchRenderer();
+
+        /** @brief Copying is not allowed */
+        AbstractBatchRenderer& operator=(const AbstractBatchRenderer&) = delete;
+
+        /** @brief Moving is not allowed */
+        AbstractBatchRenderer& operator=(AbstractBatchRenderer&&) = delete;
+
+        /** @brief Capacity of the vertex arena in glyphs */
+        UnsignedInt glyphCapacity() const;
+
+        /**
+         * @brief Count of reserved glyphs
+         *
+         * Sum of glyph ranges reserved by all texts.
+         */
+        UnsignedInt reservedGlyphCount() const;
+
+        /**
+         * @brief Count of glyphs to draw
+         *
+         * End of the last reserved range in the arena, including degenerate
+         * glyphs in unused space before it. Multiply by four to get the
+         * vertex count and by six to get the index count.
+         */
+        UnsignedInt drawGlyphCount() const;
+
+        /** @brief Count of texts */
+        std::size_t textCount() const;
+
+        /**
+         * @brief Add a text
+         * @param text      Text to render, UTF-8
+         * @param position  Position of the text origin
+         * @param alignment Text alignment relative to @p position
+         * @return Text ID
+         *
+         * Reserves a range for as many glyphs as is the byte size of the text
+         * and marks it as dirty. IDs of removed texts are reused. Expects
+         * that there's enough free space in the arena.
+         * @see @ref set(), @ref remove(), @ref update()
+         */
+        UnsignedInt add(const std::string& text, const Vector2& position = {}, Alignment alignment = Alignment::LineLeft);
+
+        /**
+         * @brief Change a text
+         *
+         * Marks the text as dirty. If the text is larger than the range it
+         * currently has reserved, the range is freed and a new one
+         * allocated, expecting that there's enough free space in the arena.
+         * Expects that @p id is a valid text ID.
+         */
+        void set(UnsignedInt id, const std::string& text);
+
+        /**
+         * @brief Change a text position
+         *
+         * Marks the text as dirty. Expects that @p id is a valid text ID.
+         */
+        void setPosition(UnsignedInt id, const Vector2& position);
+
+        /**
+         * @brief Remove a text
+         *
+         * Frees the range reserved by the text, it's filled with zeros in
+         * the next @ref update(). Expects that @p id is a valid text ID.
+         */
+        void remove(UnsignedInt id);
+
+        /**
+         * @brief Text contents
+         *
+         * Expects that @p id is a valid text ID.
+         */
+        const std::string& text(UnsignedInt id) const;
+
+        /**
+         * @brief Rectangle spanning given text
+         *
+         * Updated during @ref update(). Expects that @p id is a valid text
+         * ID.
+         */
+        Range2D rectangle(UnsignedInt id) const;
+
+        /** @brief Whether there are any changes not processed by @ref update() */
+        bool isDirty() const;
+
+        /**
+         * @brief Layout dirty texts and upload the changes
+         *
+         * Lays out all dirty texts into their ranges using
+         * @ref renderInto(), fills the unused rest of their ranges and freed
+         * ranges with zeros and then calls @ref doUpload() for each
+         * contiguous changed glyph range. Does nothing if there are no
+         * changes.
+         */
+        void update();
+
+        /**
+         * @brief Vertex data
+         *
+         * Interleaved positions and texture coordinates of the whole arena.
+         * See @ref Text-AbstractBatchRenderer-subclassing for details about
+         * the layout.
+         */
+        Containers::ArrayView<const char> vertexData() const;
+
+        /** @brief Vertex positions of the whole arena */
+        Containers::StridedArrayView1D<const Vector2> positions() const;
+
+        /** @brief Vertex texture coordinates of the whole arena */
+        Containers::StridedArrayView1D<const Vector2> textureCoordinates() const;
+
+    private:
+        /**
+         * @brief Upload a part of the vertex data
+         * @param glyphOffset   Offset of the first changed glyph
+         * @param data          Vertex data of the changed glyphs
+         *
+         * Called from @ref update() after all dirty texts are laid out, so
+         * @ref drawGlyphCount() already has the final value. The @p data
+         * are a slice of @ref vertexData() starting at
+         * @cpp glyphOffset*4 @ce vertices.
+         */
+        virtual void doUpload(UnsignedInt glyphOffset, Containers::ArrayView<const char> data) = 0;
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
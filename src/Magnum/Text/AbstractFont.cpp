@@ -28,6 +28,7 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Unicode.h>
@@ -43,7 +44,7 @@
 namespace Magnum { namespace Text {
 
 std::string AbstractFont::pluginInterface() {
-    return "cz.mosra.magnum.Text.AbstractFont/0.3";
+    return "cz.mosra.magnum.Text.AbstractFont/0.3.1";
 }
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
@@ -72,6 +73,8 @@ AbstractFont::AbstractFont() = default;
 
 AbstractFont::AbstractFont(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractPlugin{manager, plugin} {}
 
+AbstractFont::~AbstractFont() = default;
+
 void AbstractFont::setFileCallback(Containers::Optional<Containers::ArrayView<const char>>(*callback)(const std::string&, InputFileCallbackPolicy, void*), void* const userData) {
     CORRADE_ASSERT(!isOpened(), "Text::AbstractFont::setFileCallback(): can't be set while a font is opened", );
     CORRADE_ASSERT(features() & (FontFeature::FileCallback|FontFeature::OpenData), "Text::AbstractFont::setFileCallback(): font plugin supports neither loading from data nor via callbacks, callbacks can't be used", );
@@ -194,6 +197,8 @@ auto AbstractFont::doOpenFile(const std::string& filename, const Float size) ->
 
 void AbstractFont::close() {
     if(isOpened()) {
+        /* The layouter may reference plugin data, destroy it first */
+        _layouter = nullptr;
         doClose();
         _size = 0.0f;
         _lineHeight = 0.0f;
@@ -265,6 +270,44 @@ Containers::Pointer<AbstractLayouter> AbstractFont::layout(const AbstractGlyphCa
     return doLayout(cache, size, text);
 }
 
+UnsignedInt AbstractFont::layoutInto(const AbstractGlyphCache& cache, const Float size, const Containers::ArrayView<const char> text, Vector2& cursorPosition, Range2D& rectangle, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates) {
+    CORRADE_ASSERT(isOpened(), "Text::AbstractFont::layoutInto(): no font opened", {});
+    CORRADE_ASSERT(positions.size() == textureCoordinates.size(),
+        "Text::AbstractFont::layoutInto(): expected position and texture coordinate views to have the same size, got" << positions.size() << "and" << textureCoordinates.size(), {});
+
+    AbstractLayouter& layouter = doLayoutInto(cache, size, text);
+    const UnsignedInt glyphCount = layouter.glyphCount();
+    CORRADE_ASSERT(std::size_t(glyphCount)*4 <= positions.size(),
+        "Text::AbstractFont::layoutInto(): expected at least" << glyphCount*4 << "vertices for" << glyphCount << "glyphs but got" << positions.size(), {});
+
+    for(UnsignedInt i = 0; i != glyphCount; ++i) {
+        Range2D quadPosition, quadTextureCoordinates;
+        std::tie(quadPosition, quadTextureCoordinates) = layouter.renderGlyph(i, cursorPosition, rectangle);
+
+        /* 0---2
+           |   |
+           |   |
+           |   |
+           1---3 */
+        const std::size_t vertex = std::size_t(i)*4;
+        positions[vertex + 0] = quadPosition.topLeft();
+        positions[vertex + 1] = quadPosition.bottomLeft();
+        positions[vertex + 2] = quadPosition.topRight();
+        positions[vertex + 3] = quadPosition.bottomRight();
+        textureCoordinates[vertex + 0] = quadTextureCoordinates.topLeft();
+        textureCoordinates[vertex + 1] = quadTextureCoordinates.bottomLeft();
+        textureCoordinates[vertex + 2] = quadTextureCoordinates.topRight();
+        textureCoordinates[vertex + 3] = quadTextureCoordinates.bottomRight();
+    }
+
+    return glyphCount;
+}
+
+AbstractLayouter& AbstractFont::doLayoutInto(const AbstractGlyphCache& cache, const Float size, const Containers::ArrayView<const char> text) {
+    _layouter = doLayout(cache, size, std::string{text.data(), text.size()});
+    return *_layouter;
+}
+
 Debug& operator<<(Debug& debug, const FontFeature value) {
     debug << "Text::FontFeature" << Debug::nospace;
 
@@ -32,6 +32,7 @@
 #include <string>
 #include <vector>
 #include <tuple>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/PluginManager/AbstractPlugin.h>
 
 #include "Magnum/Magnum.h"
@@ -185,7 +186,7 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          * @brief Plugin interface
          *
          * @code{.cpp}
-         * "cz.mosra.magnum.Text.AbstractFont/0.3"
+         * "cz.mosra.magnum.Text.AbstractFont/0.3.1"
          * @endcode
          */
         static std::string pluginInterface();
@@ -213,6 +214,15 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
         /** @brief Plugin manager constructor */
         explicit AbstractFont(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        /**
+         * @brief Destructor
+         * @m_since_latest
+         *
+         * Destroys the layouter kept by the default @ref doLayoutInto()
+         * implementation, if any.
+         */
+        ~AbstractFont();
+
         /** @brief Features supported by this font */
         FontFeatures features() const { return doFeatures(); }
 
@@ -440,6 +450,35 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          */
         Containers::Pointer<AbstractLayouter> layout(const AbstractGlyphCache& cache, Float size, const std::string& text);
 
+        /**
+         * @brief Layout the text into glyph quads
+         * @param[in] cache     Glyph cache
+         * @param[in] size      Font size
+         * @param[in] text      Text to layout
+         * @param[in,out] cursorPosition Cursor position
+         * @param[in,out] rectangle Bounding rectangle
+         * @param[out] positions Where to put glyph quad positions
+         * @param[out] textureCoordinates Where to put glyph quad texture
+         *      coordinates
+         * @return Count of laid out glyphs
+         * @m_since_latest
+         *
+         * Like @ref layout(), but instead of returning a layouter instance
+         * writes four vertices for each glyph directly into @p positions and
+         * @p textureCoordinates, in the same order as
+         * @ref AbstractRenderer::render(AbstractFont&, const GlyphCache&, Float, const std::string&, Alignment)
+         * does. The @p cursorPosition is advanced and @p rectangle extended
+         * the same way as with @ref AbstractLayouter::renderGlyph().
+         *
+         * The layouter is owned by the font and reused across calls, so if
+         * the plugin implements @ref doLayoutInto(), a repeated layout of a
+         * text that's not longer than any text laid out before doesn't
+         * allocate. Expects that a font is opened, that @p positions and
+         * @p textureCoordinates have the same size and that they're large
+         * enough to fit four vertices for each glyph.
+         */
+        UnsignedInt layoutInto(const AbstractGlyphCache& cache, Float size, Containers::ArrayView<const char> text, Vector2& cursorPosition, Range2D& rectangle, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates);
+
     protected:
         /**
          * @brief Font metrics
@@ -546,6 +585,20 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
         /** @brief Implementation for @ref layout() */
         virtual Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache& cache, Float size, const std::string& text) = 0;
 
+        /**
+         * @brief Implementation for @ref layoutInto()
+         * @m_since_latest
+         *
+         * Returns a layouter for given text that's owned by the font and is
+         * valid until the next call to this function or until the font is
+         * closed. Default implementation calls @ref doLayout() and keeps the
+         * returned instance, which means an allocation on every call. An
+         * implementation that avoids it can reuse a single layouter instance
+         * and update its glyph count using
+         * @ref AbstractLayouter::setGlyphCount().
+         */
+        virtual AbstractLayouter& doLayoutInto(const AbstractGlyphCache& cache, Float size, Containers::ArrayView<const char> text);
+
         Containers::Optional<Containers::ArrayView<const char>>(*_fileCallback)(const std::string&, InputFileCallbackPolicy, void*){};
         void* _fileCallbackUserData{};
 
@@ -557,6 +610,9 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
         } _fileCallbackTemplate{nullptr, nullptr};
 
         Float _size{}, _ascent{}, _descent{}, _lineHeight{};
+
+        /* Used by the default doLayoutInto() implementation */
+        Containers::Pointer<AbstractLayouter> _layouter;
 };
 
 /**
@@ -608,6 +664,15 @@ class MAGNUM_TEXT_EXPORT AbstractLayouter {
          */
         explicit AbstractLayouter(UnsignedInt glyphCount);
 
+        /**
+         * @brief Set count of glyphs in laid out text
+         * @m_since_latest
+         *
+         * Meant to be used by layouters that are reused for different texts
+         * in @ref AbstractFont::doLayoutInto().
+         */
+        void setGlyphCount(UnsignedInt glyphCount) { _glyphCount = glyphCount; }
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
@@ -25,36 +25,137 @@
 
 #include "AbstractGlyphCache.h"
 
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/TextureTools/Atlas.h"
 
 namespace Magnum { namespace Text {
 
-AbstractGlyphCache::AbstractGlyphCache(const Vector2i& size, const Vector2i& padding): _size{size}, _padding{padding} {
-    /* Default "Not Found" glyph. Can't do just `.insert({0, {}})` because
-       that's ambiguous in C++17, due to a new insert(node_type&&) overload. */
-    glyphs.insert({0, std::pair<Vector2i, Range2Di>{}});
+namespace {
+    /* Initial lookup table size, has to be a power of two */
+    constexpr UnsignedInt InitialLookupSizeLog2 = 4;
+}
+
+AbstractGlyphCache::AbstractGlyphCache(const Vector2i& size, const Vector2i& padding): _size{size}, _padding{padding}, _packer{size, padding}, _lookup(1 << InitialLookupSizeLog2, {0, ~UnsignedInt{}}), _lookupShift{32 - InitialLookupSizeLog2} {
+    /* Default "Not Found" glyph */
+    _glyphs.emplace_back(0, std::pair<Vector2i, Range2Di>{});
+    _lookup[0] = {0, 0};
 }
 
 AbstractGlyphCache::~AbstractGlyphCache() = default;
 
 std::vector<Range2Di> AbstractGlyphCache::reserve(const std::vector<Vector2i>& sizes) {
-    CORRADE_ASSERT((glyphs.size() == 1 && glyphs.at(0) == std::pair<Vector2i, Range2Di>()),
-        "Text::AbstractGlyphCache::reserve(): reserving space in non-empty cache is not yet implemented", {});
-    glyphs.reserve(glyphs.size() + sizes.size());
-    return TextureTools::atlas(_size, sizes, _padding);
+    std::vector<Range2Di> out = doReserve(sizes);
+    if(out.empty()) return out;
+
+    _glyphs.reserve(_glyphs.size() + sizes.size());
+    reserveLookup(_glyphs.size() + sizes.size());
+    return out;
+}
+
+std::vector<Range2Di> AbstractGlyphCache::doReserve(const std::vector<Vector2i>& sizes) {
+    Containers::Array<Vector3i> offsets{Containers::NoInit, sizes.size()};
+    if(!_packer.add(sizes, offsets)) {
+        Error{} << "Text::AbstractGlyphCache::reserve(): can't fit" << sizes.size() << "glyphs into remaining space of a" << _size << "cache";
+        return {};
+    }
+
+    std::vector<Range2Di> out;
+    out.reserve(sizes.size());
+    for(std::size_t i = 0; i != sizes.size(); ++i)
+        out.push_back(Range2Di::fromSize(offsets[i].xy(), sizes[i]));
+    return out;
+}
+
+void AbstractGlyphCache::reserveLookup(const std::size_t glyphCount) {
+    /* Keep the table at most half full */
+    if(glyphCount*2 <= _lookup.size()) return;
+
+    std::size_t size = _lookup.size();
+    UnsignedInt shift = _lookupShift;
+    while(glyphCount*2 > size) {
+        size *= 2;
+        --shift;
+    }
+
+    _lookup.resize(size);
+    _lookupShift = shift;
+    rebuildLookup();
+}
+
+void AbstractGlyphCache::rebuildLookup() {
+    /* Reinsert everything. Going through the dense storage instead of the
+       old table, as that's a linear scan. */
+    std::fill(_lookup.begin(), _lookup.end(), std::pair<UnsignedInt, UnsignedInt>{0, ~UnsignedInt{}});
+    const std::size_t mask = _lookup.size() - 1;
+    for(std::size_t i = 0; i != _glyphs.size(); ++i) {
+        std::size_t j = (_glyphs[i].first*2654435769u) >> _lookupShift;
+        while(_lookup[j].second != ~UnsignedInt{}) j = (j + 1) & mask;
+        _lookup[j] = {_glyphs[i].first, UnsignedInt(i)};
+    }
 }
 
 void AbstractGlyphCache::insert(const UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle) {
     const std::pair<Vector2i, Range2Di> glyphData = {position-_padding, rectangle.padded(_padding)};
 
     /* Overwriting "Not Found" glyph */
-    if(glyph == 0) glyphs[0] = glyphData;
+    if(glyph == 0) {
+        _glyphs[0].second = glyphData;
+        return;
+    }
+
+    CORRADE_ASSERT(!glyphIndex(glyph),
+        "Text::AbstractGlyphCache::insert(): glyph" << glyph << "is already in the cache", );
+
+    /* Inserting new glyph. Grow the table first so the probe below finds a
+       free slot in the final table. */
+    reserveLookup(_glyphs.size() + 1);
+    const std::size_t mask = _lookup.size() - 1;
+    std::size_t i = (glyph*2654435769u) >> _lookupShift;
+    while(_lookup[i].second != ~UnsignedInt{}) i = (i + 1) & mask;
+    _lookup[i] = {glyph, UnsignedInt(_glyphs.size())};
+    _glyphs.emplace_back(glyph, glyphData);
+}
 
-    /* Inserting new glyph */
-    else CORRADE_INTERNAL_ASSERT_OUTPUT(glyphs.insert({glyph, glyphData}).second);
+void AbstractGlyphCache::remove(const UnsignedInt glyph) {
+    CORRADE_ASSERT(glyph,
+        "Text::AbstractGlyphCache::remove(): can't remove glyph 0", );
+    const UnsignedInt index = glyphIndex(glyph);
+    CORRADE_ASSERT(index,
+        "Text::AbstractGlyphCache::remove(): glyph" << glyph << "is not in the cache", );
+
+    /* Remove the table entry. With linear probing the entries following it
+       in the same probe run have to be shifted back to the hole if it's
+       between their home slot and where they are now, otherwise lookups
+       would stop at the hole. */
+    const std::size_t mask = _lookup.size() - 1;
+    std::size_t hole = (glyph*2654435769u) >> _lookupShift;
+    while(_lookup[hole].first != glyph) hole = (hole + 1) & mask;
+    for(std::size_t i = (hole + 1) & mask; _lookup[i].second != ~UnsignedInt{}; i = (i + 1) & mask) {
+        const std::size_t home = (_lookup[i].first*2654435769u) >> _lookupShift;
+        if(((i - home) & mask) >= ((i - hole) & mask)) {
+            _lookup[hole] = _lookup[i];
+            hole = i;
+        }
+    }
+    _lookup[hole] = {0, ~UnsignedInt{}};
+
+    /* Move the last glyph to the place of the removed one and patch its
+       index in the table. Glyph 0 is never the last one here, as the
+       removed glyph is after it. */
+    const UnsignedInt last = UnsignedInt(_glyphs.size() - 1);
+    if(index != last) {
+        _glyphs[index] = _glyphs[last];
+        std::size_t i = (_glyphs[index].first*2654435769u) >> _lookupShift;
+        while(_lookup[i].first != _glyphs[index].first) i = (i + 1) & mask;
+        _lookup[i].second = index;
+    }
+    _glyphs.pop_back();
 }
 
 void AbstractGlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
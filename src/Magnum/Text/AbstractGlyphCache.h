@@ -31,11 +31,11 @@
  */
 
 #include <vector>
-#include <unordered_map>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Text/visibility.h"
+#include "Magnum/TextureTools/Atlas.h"
 
 namespace Magnum { namespace Text {
 
@@ -70,7 +70,20 @@ CORRADE_ENUMSET_OPERATORS(GlyphCacheFeatures)
 @m_since{2019,10}
 
 An API-agnostic base for glyph caches. See @ref GlyphCache and
-@ref DistanceFieldGlyphCache for concrete implementations.
+@ref DistanceFieldGlyphCache for concrete implementations and
+@ref DynamicGlyphCache for a cache that's filled on demand and evicts glyphs
+that weren't used recently.
+
+@section Text-AbstractGlyphCache-storage Glyph storage
+
+Glyph properties are stored in a contiguous array in the order they were
+inserted, with the "Not Found" glyph @cpp 0 @ce always being the first. Glyph
+IDs are mapped to positions in this array using an open-addressing hash table
+of ID and index pairs, so @ref operator[]() usually touches just a single
+cache line of the table and a single element of the array, independently of
+how many glyphs are in the cache. The @ref begin() / @ref end() iteration goes
+through the array in the insertion order, except for glyphs moved to a place
+of a removed glyph in @ref remove().
 
 @section Text-AbstractGlyphCache-subclassing Subclassing
 
@@ -78,6 +91,11 @@ The subclass needs to implement the @ref doSetImage() function and manage the
 glyph cache image. The public @ref setImage() function already does checking
 for rectangle bounds so it's not needed to do it again on the implementation
 side.
+
+By default, space for the glyphs is allocated with a
+@ref TextureTools::AtlasPacker, which doesn't support freeing. A subclass
+that needs to reuse space of glyphs it removed with @ref remove() can
+implement its own allocation in @ref doReserve().
 */
 class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
     public:
@@ -100,7 +118,7 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
         Vector2i padding() const { return _padding; }
 
         /** @brief Count of glyphs in the cache */
-        std::size_t glyphCount() const { return glyphs.size(); }
+        std::size_t glyphCount() const { return _glyphs.size(); }
 
         /**
          * @brief Parameters of given glyph
@@ -117,32 +135,38 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          * @see @ref padding()
          */
         std::pair<Vector2i, Range2Di> operator[](UnsignedInt glyph) const {
-            auto it = glyphs.find(glyph);
-            return it == glyphs.end() ? glyphs.at(0) : it->second;
+            return _glyphs[glyphIndex(glyph)].second;
         }
 
-        /** @brief Iterator access to cache data */
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>>::const_iterator begin() const {
-            return glyphs.begin();
+        /**
+         * @brief Iterator access to cache data
+         *
+         * Glyphs are iterated in the order they were inserted, except for
+         * glyphs moved by @ref remove(). Glyph @cpp 0 @ce is always the
+         * first.
+         */
+        std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>>::const_iterator begin() const {
+            return _glyphs.begin();
         }
 
         /** @brief Iterator access to cache data */
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>>::const_iterator end() const {
-            return glyphs.end();
+        std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>>::const_iterator end() const {
+            return _glyphs.end();
         }
 
         /**
          * @brief Layout glyphs with given sizes to the cache
          *
-         * Returns non-overlapping regions in cache texture to store glyphs.
-         * The reserved space is reused on next call to @ref reserve() if no
-         * glyph was stored there, use @ref insert() to store actual glyph on
-         * given position and @ref setImage() to upload glyph image.
+         * Returns non-overlapping regions in cache texture to store glyphs,
+         * use @ref insert() to store actual glyph on given position and
+         * @ref setImage() to upload glyph image. The space is allocated
+         * using @ref TextureTools::AtlasPacker, which means the cache can be
+         * filled incrementally --- regions returned from subsequent calls
+         * don't overlap any regions returned previously. If the glyphs don't
+         * fit into the remaining space, a message is printed to
+         * @ref Error and an empty vector is returned.
          *
          * Glyph @p sizes are expected to be without padding.
-         *
-         * @attention Cache size must be large enough to contain all rendered
-         *      glyphs.
          * @see @ref padding()
          */
         std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes);
@@ -154,8 +178,8 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          * @param rectangle     Region in texture atlas
          *
          * You can obtain unused non-overlapping regions with @ref reserve().
-         * You can't overwrite already inserted glyph, however you can reset
-         * glyph @cpp 0 @ce to some meaningful value.
+         * Expects that the glyph isn't already in the cache, however you can
+         * reset glyph @cpp 0 @ce to some meaningful value.
          *
          * Glyph parameters are expected to be without padding.
          *
@@ -183,6 +207,40 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          */
         Image2D image();
 
+    protected:
+        /**
+         * @brief Remove a glyph from the cache
+         * @m_since_latest
+         *
+         * Expects that the glyph is in the cache and is not glyph
+         * @cpp 0 @ce. The last glyph in @ref begin() / @ref end() is moved
+         * to the place of the removed one, so the removal is done in
+         * constant time. Space occupied by the glyph isn't freed, it's up to
+         * the subclass to make it available again in its @ref doReserve()
+         * implementation.
+         */
+        void remove(UnsignedInt glyph);
+
+        /**
+         * @brief Position of given glyph in @ref begin() / @ref end()
+         * @m_since_latest
+         *
+         * If the glyph is not in the cache, returns @cpp 0 @ce, which is
+         * the position of glyph @cpp 0 @ce.
+         */
+        UnsignedInt glyphIndex(UnsignedInt glyph) const {
+            /* Linear probing from a Fibonacci hash of the ID, the table is
+               always at most half full so the probe sequence is short and
+               always terminates at an empty slot, which has the index set to
+               ~UnsignedInt{} */
+            const std::size_t mask = _lookup.size() - 1;
+            for(std::size_t i = (glyph*2654435769u) >> _lookupShift; ; i = (i + 1) & mask) {
+                const std::pair<UnsignedInt, UnsignedInt>& entry = _lookup[i];
+                if(entry.second == ~UnsignedInt{}) return 0;
+                if(entry.first == glyph) return entry.second;
+            }
+        }
+
     private:
         /** @brief Implementation for @ref features() */
         virtual GlyphCacheFeatures doFeatures() const = 0;
@@ -198,8 +256,28 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
         /** @brief Implementation for @ref image() */
         virtual Image2D doImage();
 
+        /**
+         * @brief Implementation for @ref reserve()
+         * @m_since_latest
+         *
+         * Default implementation packs the glyphs using a
+         * @ref TextureTools::AtlasPacker. On failure the implementation is
+         * expected to print a message to @ref Error and return an empty
+         * vector. The returned regions are expected to be without padding,
+         * with the padding around them being unused as well.
+         */
+        virtual std::vector<Range2Di> doReserve(const std::vector<Vector2i>& sizes);
+
+        /* Grows the lookup table to have room for given glyph count */
+        MAGNUM_TEXT_LOCAL void reserveLookup(std::size_t glyphCount);
+        /* Fills the lookup table from scratch */
+        MAGNUM_TEXT_LOCAL void rebuildLookup();
+
         Vector2i _size, _padding;
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>> glyphs;
+        TextureTools::AtlasPacker _packer;
+        std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>> _glyphs;
+        std::vector<std::pair<UnsignedInt, UnsignedInt>> _lookup;
+        UnsignedInt _lookupShift;
 };
 
 }}
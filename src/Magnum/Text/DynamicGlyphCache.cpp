@@ -0,0 +1,410 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DynamicGlyphCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Unicode.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Text/AbstractFont.h"
+
+namespace Magnum { namespace Text {
+
+namespace {
+
+/* Node of the least recently used list, parallel to the glyph array in
+   AbstractGlyphCache */
+struct LruNode {
+    UnsignedInt prev, next;
+    /* Frame in which the glyph was last used */
+    UnsignedInt frame;
+};
+
+struct Shelf {
+    Int y, height;
+    /* Offset and width of free spans, sorted by offset with adjacent spans
+       always merged together */
+    std::vector<std::pair<Int, Int>> free;
+};
+
+}
+
+struct DynamicGlyphCache::State {
+    explicit State(const Vector2i& size): size{size}, image{Containers::ValueInit, std::size_t(size.product())} {}
+
+    bool isEmpty(const Shelf& shelf) const {
+        return shelf.free.size() == 1 && shelf.free[0].second == size.x();
+    }
+
+    void unlink(UnsignedInt i) {
+        lru[lru[i].prev].next = lru[i].next;
+        lru[lru[i].next].prev = lru[i].prev;
+    }
+
+    void link(UnsignedInt i) {
+        lru[i].prev = 0;
+        lru[i].next = lru[0].next;
+        lru[lru[0].next].prev = i;
+        lru[0].next = i;
+    }
+
+    void touch(UnsignedInt i) {
+        unlink(i);
+        link(i);
+        lru[i].frame = frame;
+    }
+
+    void track(std::size_t glyphCount);
+
+    Containers::Optional<Vector2i> allocate(const Vector2i& glyphSize);
+    void free(const Range2Di& rectangle);
+    void zero(const Range2Di& rectangle);
+
+    Vector2i size;
+    Containers::Array<char> image;
+    /* Sorted by Y, always covering a contiguous range from the top */
+    std::vector<Shelf> shelves;
+
+    /* Circular doubly linked list of glyphs, most recently used first,
+       linked through indices into an array that has the same order as the
+       glyph array in AbstractGlyphCache. Glyph 0, which is always first and
+       never evicted, is the list head. */
+    std::vector<LruNode> lru{LruNode{0, 0, 0}};
+    UnsignedInt frame{};
+    std::size_t evictionCount{};
+    /* Glyphs added to the list during the current fill() */
+    std::size_t trackedCount{};
+
+    /* Regions reserved during the current fill(), only these get copied
+       from images passed to setImage() */
+    std::vector<Range2Di> pending;
+    bool filling{};
+    std::vector<Range2Di> dirty;
+};
+
+void DynamicGlyphCache::State::track(const std::size_t glyphCount) {
+    /* Glyphs are always inserted at the end, so the ones that aren't in the
+       list yet are those after it */
+    while(lru.size() < glyphCount) {
+        lru.push_back(LruNode{0, 0, frame});
+        link(UnsignedInt(lru.size() - 1));
+        ++trackedCount;
+    }
+}
+
+Containers::Optional<Vector2i> DynamicGlyphCache::State::allocate(const Vector2i& glyphSize) {
+    /* Empty glyphs such as spaces don't need any space */
+    if(!glyphSize.product()) return Vector2i{};
+    if((glyphSize > size).any()) return {};
+
+    /* Pick a shelf with the least vertical waste. An empty shelf gets split
+       to exactly the needed height, so it has no waste. */
+    std::size_t best = ~std::size_t{};
+    std::size_t bestSpan{};
+    Int bestHeight{};
+    for(std::size_t i = 0; i != shelves.size(); ++i) {
+        const Shelf& shelf = shelves[i];
+        if(shelf.height < glyphSize.y()) continue;
+
+        const Int height = isEmpty(shelf) ? glyphSize.y() : shelf.height;
+        if(best != ~std::size_t{} && height >= bestHeight) continue;
+
+        for(std::size_t j = 0; j != shelf.free.size(); ++j) {
+            if(shelf.free[j].second < glyphSize.x()) continue;
+            best = i;
+            bestSpan = j;
+            bestHeight = height;
+            break;
+        }
+    }
+
+    /* Open a new shelf at the top if there's no suitable one or the best one
+       would waste too much space */
+    const Int top = shelves.empty() ? 0 : shelves.back().y + shelves.back().height;
+    if((best == ~std::size_t{} || bestHeight >= glyphSize.y() + glyphSize.y()/2) && top + glyphSize.y() <= size.y()) {
+        shelves.push_back(Shelf{top, glyphSize.y(), {{0, size.x()}}});
+        best = shelves.size() - 1;
+        bestSpan = 0;
+    }
+
+    if(best == ~std::size_t{}) return {};
+
+    /* Split an empty shelf, the rest stays empty */
+    if(isEmpty(shelves[best]) && shelves[best].height > glyphSize.y()) {
+        const Shelf rest{shelves[best].y + glyphSize.y(), shelves[best].height - glyphSize.y(), {{0, size.x()}}};
+        shelves[best].height = glyphSize.y();
+        shelves.insert(shelves.begin() + best + 1, rest);
+    }
+
+    Shelf& shelf = shelves[best];
+    std::pair<Int, Int>& span = shelf.free[bestSpan];
+    const Vector2i offset{span.first, shelf.y};
+    span.first += glyphSize.x();
+    span.second -= glyphSize.x();
+    if(!span.second) shelf.free.erase(shelf.free.begin() + bestSpan);
+    return offset;
+}
+
+void DynamicGlyphCache::State::free(const Range2Di& rectangle) {
+    if(!rectangle.size().product()) return;
+
+    /* Glyphs are always at the shelf Y offset */
+    auto found = std::lower_bound(shelves.begin(), shelves.end(), rectangle.min().y(), [](const Shelf& shelf, Int y) {
+        return shelf.y < y;
+    });
+    CORRADE_INTERNAL_ASSERT(found != shelves.end() && found->y == rectangle.min().y());
+    std::size_t i = found - shelves.begin();
+
+    /* Insert the span, merging with the neighbors */
+    std::vector<std::pair<Int, Int>>& spans = shelves[i].free;
+    const Int x = rectangle.min().x(), width = rectangle.sizeX();
+    auto next = std::lower_bound(spans.begin(), spans.end(), std::make_pair(x, width));
+    if(next != spans.begin() && (next - 1)->first + (next - 1)->second == x) {
+        auto prev = next - 1;
+        prev->second += width;
+        if(next != spans.end() && x + width == next->first) {
+            prev->second += next->second;
+            spans.erase(next);
+        }
+    } else if(next != spans.end() && x + width == next->first) {
+        next->first = x;
+        next->second += width;
+    } else spans.emplace(next, x, width);
+
+    if(!isEmpty(shelves[i])) return;
+
+    /* Merge an empty shelf with empty neighbors and drop it if it's at the
+       top, so the space can be used for glyphs of any height */
+    if(i + 1 != shelves.size() && isEmpty(shelves[i + 1])) {
+        shelves[i].height += shelves[i + 1].height;
+        shelves.erase(shelves.begin() + i + 1);
+    }
+    if(i != 0 && isEmpty(shelves[i - 1])) {
+        shelves[i - 1].height += shelves[i].height;
+        shelves.erase(shelves.begin() + i);
+        --i;
+    }
+    if(i + 1 == shelves.size()) shelves.pop_back();
+}
+
+void DynamicGlyphCache::State::zero(const Range2Di& rectangle) {
+    for(Int y = rectangle.min().y(); y != rectangle.max().y(); ++y)
+        std::memset(image + std::size_t(y)*size.x() + rectangle.min().x(), 0, rectangle.sizeX());
+}
+
+DynamicGlyphCache::DynamicGlyphCache(const Vector2i& size, const Vector2i& padding): AbstractGlyphCache{size, padding}, _state{Containers::InPlaceInit, size} {}
+
+DynamicGlyphCache::~DynamicGlyphCache() = default;
+
+GlyphCacheFeatures DynamicGlyphCache::doFeatures() const {
+    return GlyphCacheFeature::ImageDownload;
+}
+
+bool DynamicGlyphCache::fill(AbstractFont& font, const std::string& text) {
+    State& state = *_state;
+
+    /* Mark glyphs that are already there as used, collect characters for
+       the rest */
+    std::string missing;
+    std::vector<UnsignedInt> missingGlyphs;
+    for(std::size_t i = 0; i < text.size(); ) {
+        const std::size_t begin = i;
+        const std::pair<char32_t, std::size_t> next = Utility::Unicode::nextChar({text.data(), text.size()}, i);
+        i = next.second;
+
+        const UnsignedInt glyph = font.glyphId(next.first);
+        if(!glyph) continue;
+
+        if(const UnsignedInt index = glyphIndex(glyph)) {
+            state.touch(index);
+            continue;
+        }
+
+        if(std::find(missingGlyphs.begin(), missingGlyphs.end(), glyph) != missingGlyphs.end())
+            continue;
+        missingGlyphs.push_back(glyph);
+        missing.append(text, begin, i - begin);
+    }
+
+    if(missingGlyphs.empty()) return true;
+
+    /* The glyphs get inserted at the end. If the font reserves space more
+       than once, doReserve() adds the glyphs inserted so far to the list
+       before evicting anything, the rest is added here. */
+    const Range2Di notFoundBefore = (*this)[0].second;
+    state.pending.clear();
+    state.trackedCount = 0;
+    state.filling = true;
+    font.fillGlyphCache(*this, missing);
+    state.filling = false;
+    state.track(glyphCount());
+
+    /* Some fonts rasterize the "Not Found" glyph on every fill, reclaim the
+       space of the previous one */
+    const Range2Di notFound = (*this)[0].second;
+    if(notFound != notFoundBefore) state.free(notFoundBefore);
+
+    return state.trackedCount == missingGlyphs.size();
+}
+
+void DynamicGlyphCache::nextFrame() {
+    ++_state->frame;
+}
+
+std::size_t DynamicGlyphCache::evictionCount() const {
+    return _state->evictionCount;
+}
+
+ImageView2D DynamicGlyphCache::imageView() const {
+    return ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, _state->size, Containers::arrayView(_state->image)};
+}
+
+const std::vector<Range2Di>& DynamicGlyphCache::dirtyRectangles() const {
+    return _state->dirty;
+}
+
+void DynamicGlyphCache::clearDirtyRectangles() {
+    _state->dirty.clear();
+}
+
+bool DynamicGlyphCache::evict() {
+    State& state = *_state;
+    const UnsignedInt index = state.lru[0].prev;
+    if(!index || state.lru[index].frame == state.frame)
+        return false;
+
+    /* The rectangle includes padding, which is what was allocated */
+    const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph = begin()[index];
+    state.free(glyph.second.second);
+    state.unlink(index);
+    remove(glyph.first);
+
+    /* remove() moved the last glyph to the place of the evicted one, do the
+       same with its list node */
+    const UnsignedInt last = UnsignedInt(state.lru.size() - 1);
+    if(index != last) {
+        state.lru[index] = state.lru[last];
+        state.lru[state.lru[index].prev].next = index;
+        state.lru[state.lru[index].next].prev = index;
+    }
+    state.lru.pop_back();
+    ++state.evictionCount;
+    return true;
+}
+
+std::vector<Range2Di> DynamicGlyphCache::doReserve(const std::vector<Vector2i>& sizes) {
+    State& state = *_state;
+
+    /* Glyphs inserted since the last reserve() have to be in the list before
+       anything gets evicted, otherwise the list would get out of sync with
+       the glyph array */
+    state.track(glyphCount());
+    state.lru.reserve(glyphCount() + sizes.size());
+
+    /* Allocate in the order of decreasing height, which makes the shelves
+       better filled */
+    std::vector<std::size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) {
+        return sizes[a].y() > sizes[b].y();
+    });
+
+    std::vector<Range2Di> out(sizes.size());
+    for(std::size_t i = 0; i != order.size(); ++i) {
+        const Vector2i paddedSize = sizes[order[i]] + 2*padding();
+
+        Containers::Optional<Vector2i> offset;
+        while(!(offset = state.allocate(paddedSize)) && evict());
+
+        if(!offset) {
+            /* Put back everything allocated so far */
+            for(std::size_t j = 0; j != i; ++j)
+                state.free(out[order[j]].padded(padding()));
+            Error{} << "Text::DynamicGlyphCache::reserve(): can't fit" << sizes.size() << "glyphs into a" << textureSize() << "cache even after evicting all glyphs not used in current frame";
+            return {};
+        }
+
+        out[order[i]] = Range2Di::fromSize(*offset + padding(), sizes[order[i]]);
+    }
+
+    /* Clear the regions so nothing from the evicted glyphs stays in the
+       padding */
+    for(const Range2Di& rectangle: out) {
+        const Range2Di padded = rectangle.padded(padding());
+        if(!padded.size().product()) continue;
+        state.zero(padded);
+        state.pending.push_back(padded);
+        state.dirty.push_back(padded);
+    }
+
+    return out;
+}
+
+void DynamicGlyphCache::doSetImage(const Vector2i& offset, const ImageView2D& image) {
+    State& state = *_state;
+    CORRADE_ASSERT(image.format() == PixelFormat::R8Unorm,
+        "Text::DynamicGlyphCache::setImage(): expected" << PixelFormat::R8Unorm << "but got" << image.format(), );
+
+    /* Outside of fill() the whole image is copied. During fill(), the font
+       may upload the whole cache texture at once, so only the regions
+       reserved by it are copied to not overwrite the other glyphs. */
+    const Range2Di imageRectangle = Range2Di::fromSize(offset, image.size());
+    const Containers::StridedArrayView2D<const UnsignedByte> pixels = image.pixels<UnsignedByte>();
+    const auto copy = [&](const Range2Di& rectangle) {
+        for(Int y = rectangle.min().y(); y != rectangle.max().y(); ++y)
+            for(Int x = rectangle.min().x(); x != rectangle.max().x(); ++x)
+                state.image[std::size_t(y)*state.size.x() + x] = pixels[y - offset.y()][x - offset.x()];
+    };
+
+    if(!state.filling) {
+        copy(imageRectangle);
+        state.dirty.push_back(imageRectangle);
+        return;
+    }
+
+    for(const Range2Di& pending: state.pending) {
+        const Range2Di rectangle = Math::intersect(pending, imageRectangle);
+        if(!rectangle.size().product()) continue;
+        copy(rectangle);
+    }
+}
+
+Image2D DynamicGlyphCache::doImage() {
+    Containers::Array<char> data{Containers::NoInit, _state->image.size()};
+    std::copy(_state->image.begin(), _state->image.end(), data.begin());
+    return Image2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, _state->size, std::move(data)};
+}
+
+}}
@@ -0,0 +1,174 @@
+#ifndef Magnum_Text_DynamicGlyphCache_h
+#define Magnum_Text_DynamicGlyphCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::DynamicGlyphCache
+ * @m_since_latest
+ */
+
+#include <string>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Text/AbstractGlyphCache.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Glyph cache filled on demand
+@m_since_latest
+
+Unlike with @ref AbstractFont::fillGlyphCache(), which is meant to be called
+once with all characters that will ever be needed, glyphs are added to this
+cache incrementally, rasterized by the font plugin only when a text actually
+needs them. Once the cache is full, glyphs that weren't used for the longest
+time are evicted to make space for new ones. The cache image is kept on the
+CPU and the regions that changed are exposed via @ref dirtyRectangles(), so
+only those need to be uploaded to the GPU.
+
+@section Text-DynamicGlyphCache-usage Usage
+
+Each frame, call @ref fill() for every text that's going to be rendered
+before laying it out, upload the changed regions and then advance to the
+next frame with @ref nextFrame():
+
+@code{.cpp}
+Text::DynamicGlyphCache cache{{512, 512}, {1, 1}};
+GL::Texture2D texture;
+texture.setStorage(1, GL::TextureFormat::R8, cache.textureSize());
+
+// each frame
+cache.fill(*font, title);
+cache.fill(*font, chatMessage);
+for(const Range2Di& rectangle: cache.dirtyRectangles())
+    texture.setSubImage(0, rectangle.min(),
+        ImageView2D{cache.imageView().storage()
+            .setRowLength(cache.textureSize().x())
+            .setSkip({rectangle.min(), 0}),
+            PixelFormat::R8Unorm, rectangle.size(), cache.imageView().data()});
+cache.clearDirtyRectangles();
+
+// ... layout and draw the texts ...
+
+cache.nextFrame();
+@endcode
+
+Glyphs used in the current frame are never evicted. If a text doesn't fit
+even after evicting all other glyphs, @ref fill() prints a message to
+@ref Error and returns @cpp false @ce. The cache is expected to be filled
+only through @ref fill().
+
+@section Text-DynamicGlyphCache-eviction Allocation and eviction
+
+Space in the cache is allocated in horizontal shelves, each shelf holding
+glyphs of a similar height. Space of evicted glyphs is returned to the shelf
+it was in, and shelves that become empty are merged together and can be
+reused for glyphs of any height. Glyphs are evicted in a least recently used
+order, a glyph being used every time it's a part of text passed to
+@ref fill().
+
+Eviction changes glyph positions in the cache. If @ref evictionCount()
+changed since a text was laid out, the text may reference glyphs that are no
+longer there and it should be laid out again.
+*/
+class MAGNUM_TEXT_EXPORT DynamicGlyphCache: public AbstractGlyphCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param size              Glyph cache texture size
+         * @param padding           Padding around every glyph
+         *
+         * The cache image is single-channel,
+         * @ref PixelFormat::R8Unorm, and initially filled with zeros.
+         */
+        explicit DynamicGlyphCache(const Vector2i& size, const Vector2i& padding = {});
+
+        ~DynamicGlyphCache();
+
+        /**
+         * @brief Make sure glyphs of given text are in the cache
+         * @return Whether all glyphs are in the cache
+         *
+         * Marks glyphs of @p text that are already in the cache as used in
+         * the current frame and rasterizes the rest using
+         * @ref AbstractFont::fillGlyphCache(), evicting least recently used
+         * glyphs if there's not enough space. Characters that the font
+         * doesn't have a glyph for are skipped. Expects that the font is
+         * opened and supports glyph cache filling.
+         */
+        bool fill(AbstractFont& font, const std::string& text);
+
+        /**
+         * @brief Advance to the next frame
+         *
+         * Glyphs used in the previous frame can be evicted from now on.
+         */
+        void nextFrame();
+
+        /**
+         * @brief Total count of evicted glyphs
+         *
+         * See @ref Text-DynamicGlyphCache-eviction for more information.
+         */
+        std::size_t evictionCount() const;
+
+        /**
+         * @brief Cache image
+         *
+         * Unlike @ref image() doesn't make a copy.
+         */
+        ImageView2D imageView() const;
+
+        /**
+         * @brief Changed regions of the cache image
+         *
+         * Regions that were allocated for new glyphs since the last call to
+         * @ref clearDirtyRectangles(), including the padding. The regions
+         * don't overlap.
+         */
+        const std::vector<Range2Di>& dirtyRectangles() const;
+
+        /** @brief Clear the list of changed regions */
+        void clearDirtyRectangles();
+
+    private:
+        struct State;
+
+        MAGNUM_TEXT_LOCAL GlyphCacheFeatures doFeatures() const override;
+        MAGNUM_TEXT_LOCAL std::vector<Range2Di> doReserve(const std::vector<Vector2i>& sizes) override;
+        MAGNUM_TEXT_LOCAL void doSetImage(const Vector2i& offset, const ImageView2D& image) override;
+        MAGNUM_TEXT_LOCAL Image2D doImage() override;
+
+        /* Evicts the least recently used glyph, returns false if there's none
+           that could be evicted */
+        MAGNUM_TEXT_LOCAL bool evict();
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
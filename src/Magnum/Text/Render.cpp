@@ -0,0 +1,111 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Render.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Text/AbstractFont.h"
+
+namespace Magnum { namespace Text {
+
+std::pair<UnsignedInt, Range2D> renderInto(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Containers::ArrayView<const char> text, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Alignment alignment) {
+    CORRADE_ASSERT(positions.size() == textureCoordinates.size(),
+        "Text::renderInto(): expected position and texture coordinate views to have the same size, got" << positions.size() << "and" << textureCoordinates.size(), {});
+
+    /* Total rendered bounds, initial line position, line increment, vertices
+       written so far */
+    Range2D rectangle;
+    Vector2 linePosition;
+    const Vector2 lineAdvance = Vector2::yAxis(font.lineHeight()*size/font.size());
+    std::size_t vertexCount = 0;
+
+    /* Render each line separately and align it horizontally */
+    for(std::size_t prevPos = 0; ; ) {
+        std::size_t pos = prevPos;
+        while(pos != text.size() && text[pos] != '\n') ++pos;
+
+        /* Empty line, nothing to do except for advancing to the next line */
+        if(pos != prevPos) {
+            const Containers::StridedArrayView1D<Vector2> linePositions = positions.suffix(vertexCount);
+
+            /* Layout the line directly into the output */
+            Range2D lineRectangle;
+            Vector2 cursorPosition = linePosition;
+            const std::size_t lineVertexCount = font.layoutInto(cache, size, text.slice(prevPos, pos), cursorPosition, lineRectangle, linePositions, textureCoordinates.suffix(vertexCount))*4;
+
+            /* Horizontally align the rendered line */
+            Float alignmentOffsetX = 0.0f;
+            if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentCenter)
+                alignmentOffsetX = -lineRectangle.centerX();
+            else if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentRight)
+                alignmentOffsetX = -lineRectangle.right();
+
+            /* Integer alignment */
+            if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
+                alignmentOffsetX = Math::round(alignmentOffsetX);
+
+            /* Align positions and bounds on current line */
+            lineRectangle = lineRectangle.translated(Vector2::xAxis(alignmentOffsetX));
+            for(std::size_t i = 0; i != lineVertexCount; ++i)
+                linePositions[i].x() += alignmentOffsetX;
+
+            /* Add final line bounds to total bounds, similarly to
+               AbstractLayouter::renderGlyph() */
+            if(!rectangle.size().isZero()) {
+                rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
+                rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
+            } else rectangle = lineRectangle;
+
+            vertexCount += lineVertexCount;
+        }
+
+        /* Move to next line, if there's any */
+        if(pos == text.size()) break;
+        prevPos = pos + 1;
+        linePosition -= lineAdvance;
+    }
+
+    /* Vertically align the rendered text */
+    Float alignmentOffsetY = 0.0f;
+    if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentMiddle)
+        alignmentOffsetY = -rectangle.centerY();
+    else if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentTop)
+        alignmentOffsetY = -rectangle.top();
+
+    /* Integer alignment */
+    if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
+        alignmentOffsetY = Math::round(alignmentOffsetY);
+
+    /* Align positions and bounds */
+    rectangle = rectangle.translated(Vector2::yAxis(alignmentOffsetY));
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        positions[i].y() += alignmentOffsetY;
+
+    return {UnsignedInt(vertexCount/4), rectangle};
+}
+
+}}
@@ -0,0 +1,77 @@
+#ifndef Magnum_Text_Render_h
+#define Magnum_Text_Render_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Text::renderInto()
+ * @m_since_latest
+ */
+
+#include <utility>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/Alignment.h"
+#include "Magnum/Text/visibility.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Render text into glyph quads
+@param[in] font         Font to layout the text with
+@param[in] cache        Glyph cache
+@param[in] size         Font size
+@param[in] text         Text to render, UTF-8
+@param[out] positions   Where to put glyph quad positions
+@param[out] textureCoordinates Where to put glyph quad texture coordinates
+@param[in] alignment    Text alignment
+@return Count of rendered glyphs and rectangle spanning the rendered text
+@m_since_latest
+
+A graphics-API-agnostic equivalent of
+@ref AbstractRenderer::render(AbstractFont&, const GlyphCache&, Float, const std::string&, Alignment)
+that writes four vertices for each glyph directly into caller-provided views
+instead of returning newly allocated arrays. The text is split on
+@cpp '\n' @ce characters, each line laid out using
+@ref AbstractFont::layoutInto() and aligned in place. The quads are meant to
+be drawn as two triangles each, with indices for glyph @f$ i @f$ being
+@f$ \{ 4i, 4i + 1, 4i + 2, 4i + 1, 4i + 3, 4i + 2 \} @f$.
+
+The text is referenced as a view, lines are not copied anywhere and the
+layouter is reused across lines and calls, so if the font plugin implements
+@ref AbstractFont::doLayoutInto() in an allocation-free way, rendering text
+into the same buffers every frame doesn't allocate at all. Expects that
+@p positions and @p textureCoordinates have the same size and that they're
+large enough to fit four vertices for each glyph. For fonts that map each
+character to exactly one glyph, @cpp text.size()*4 @ce vertices is always
+enough.
+*/
+MAGNUM_TEXT_EXPORT std::pair<UnsignedInt, Range2D> renderInto(AbstractFont& font, const AbstractGlyphCache& cache, Float size, Containers::ArrayView<const char> text, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, Alignment alignment = Alignment::LineLeft);
+
+}}
+
+#endif
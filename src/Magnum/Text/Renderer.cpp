@@ -27,6 +27,7 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
 
 #include "Magnum/Mesh.h"
 #include "Magnum/GL/Context.h"
@@ -36,6 +37,7 @@
 #include "Magnum/Shaders/AbstractVector.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/Render.h"
 
 namespace Magnum { namespace Text {
 
@@ -65,115 +67,27 @@ struct Vertex {
     Vector2 position, textureCoordinates;
 };
 
+/* Views on positions and texture coordinates in interleaved vertex data */
+std::pair<Containers::StridedArrayView1D<Vector2>, Containers::StridedArrayView1D<Vector2>> vertexViews(const Containers::ArrayView<Vertex> vertices) {
+    if(vertices.empty()) return {};
+    return {
+        Containers::StridedArrayView1D<Vector2>{vertices, &vertices[0].position, vertices.size(), sizeof(Vertex)},
+        Containers::StridedArrayView1D<Vector2>{vertices, &vertices[0].textureCoordinates, vertices.size(), sizeof(Vertex)}
+    };
+}
+
 std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment) {
     /* Output data, reserve memory as when the text would be ASCII-only. In
        reality the actual vertex count will be smaller, but allocating more at
        once is better than reallocating many times later. */
-    std::vector<Vertex> vertices;
-    vertices.reserve(text.size()*4);
+    std::vector<Vertex> vertices(text.size()*4);
 
-    /* Total rendered bounds, intial line position, line increment, last+1
-       vertex on previous line */
-    Range2D rectangle;
-    Vector2 linePosition;
-    const Vector2 lineAdvance = Vector2::yAxis(font.lineHeight()*size/font.size());
-    std::size_t lastLineLastVertex = 0;
-
-    /* Temp buffer so we don't allocate for each new line */
-    /**
-     * @todo C++1z: use std::string_view to avoid the one allocation and all
-     *      the copying altogether
-     */
-    std::string line;
-    line.reserve(text.size());
-
-    /* Render each line separately and align it horizontally */
-    std::size_t pos, prevPos = 0;
-    do {
-        /* Empty line, nothing to do (the rest is done below in while expression) */
-        if((pos = text.find('\n', prevPos)) == prevPos) continue;
-
-        /* Copy the line into the temp buffer */
-        line.assign(text, prevPos, pos-prevPos);
-
-        /* Layout the line */
-        Containers::Pointer<AbstractLayouter> layouter = font.layout(cache, size, line);
-
-        /* Verify that we don't reallocate anything. The only problem might
-           arise when the layouter decides to compose one character from more
-           than one glyph (i.e. accents). Will remove the assert when this
-           issue arises. */
-        CORRADE_INTERNAL_ASSERT(vertices.size() + layouter->glyphCount()*4 <= vertices.capacity());
-
-        /* Bounds of rendered line */
-        Range2D lineRectangle;
-
-        /* Render all glyphs */
-        Vector2 cursorPosition(linePosition);
-        for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i) {
-            Range2D quadPosition, textureCoordinates;
-            std::tie(quadPosition, textureCoordinates) = layouter->renderGlyph(i, cursorPosition, lineRectangle);
-
-            /* 0---2
-               |   |
-               |   |
-               |   |
-               1---3 */
-
-            vertices.insert(vertices.end(), {
-                {quadPosition.topLeft(), textureCoordinates.topLeft()},
-                {quadPosition.bottomLeft(), textureCoordinates.bottomLeft()},
-                {quadPosition.topRight(), textureCoordinates.topRight()},
-                {quadPosition.bottomRight(), textureCoordinates.bottomRight()}
-            });
-        }
-
-        /** @todo What about top-down text? */
-
-        /* Horizontally align the rendered line */
-        Float alignmentOffsetX = 0.0f;
-        if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentCenter)
-            alignmentOffsetX = -lineRectangle.centerX();
-        else if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentRight)
-            alignmentOffsetX = -lineRectangle.right();
-
-        /* Integer alignment */
-        if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
-            alignmentOffsetX = Math::round(alignmentOffsetX);
-
-        /* Align positions and bounds on current line */
-        lineRectangle = lineRectangle.translated(Vector2::xAxis(alignmentOffsetX));
-        for(auto it = vertices.begin()+lastLineLastVertex; it != vertices.end(); ++it)
-            it->position.x() += alignmentOffsetX;
-
-        /* Add final line bounds to total bounds, similarly to AbstractFont::renderGlyph() */
-        if(!rectangle.size().isZero()) {
-            rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
-            rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
-        } else rectangle = lineRectangle;
-
-    /* Move to next line */
-    } while(prevPos = pos+1,
-            linePosition -= lineAdvance,
-            lastLineLastVertex = vertices.size(),
-            pos != std::string::npos);
-
-    /* Vertically align the rendered text */
-    Float alignmentOffsetY = 0.0f;
-    if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentMiddle)
-        alignmentOffsetY = -rectangle.centerY();
-    else if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentTop)
-        alignmentOffsetY = -rectangle.top();
-
-    /* Integer alignment */
-    if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
-        alignmentOffsetY = Math::round(alignmentOffsetY);
-
-    /* Align positions and bounds */
-    rectangle = rectangle.translated(Vector2::yAxis(alignmentOffsetY));
-    for(auto& v: vertices) v.position.y() += alignmentOffsetY;
-
-    return std::make_tuple(std::move(vertices), rectangle);
+    Containers::StridedArrayView1D<Vector2> positions, textureCoordinates;
+    std::tie(positions, textureCoordinates) = vertexViews(vertices);
+    const std::pair<UnsignedInt, Range2D> rendered = renderInto(font, cache, size, {text.data(), text.size()}, positions, textureCoordinates, alignment);
+    vertices.resize(rendered.first*4);
+
+    return std::make_tuple(std::move(vertices), rendered.second);
 }
 
 std::pair<Containers::Array<char>, MeshIndexType> renderIndicesInternal(const UnsignedInt glyphCount) {
@@ -358,32 +272,64 @@ void AbstractRenderer::reserve(const uint32_t glyphCount, const GL::BufferUsage
 }
 
 void AbstractRenderer::render(const std::string& text) {
-    /* Render vertex data */
-    std::vector<Vertex> vertexData;
-    _rectangle = {};
-    std::tie(vertexData, _rectangle) = renderVerticesInternal(font, cache, size, text, _alignment);
+    /* Render the vertex data into a scratch buffer that's kept across calls,
+       sized as when the text would be ASCII-only. The text isn't copied
+       anywhere and the font reuses its layouter, so once the scratch buffer
+       is large enough and if the font supports it, this doesn't allocate. */
+    if(_vertexData.size() < text.size()*4*sizeof(Vertex))
+        _vertexData = Containers::Array<char>{Containers::NoInit, text.size()*4*sizeof(Vertex)};
+    const Containers::ArrayView<Vertex> vertexData = Containers::arrayCast<Vertex>(_vertexData);
+    Containers::StridedArrayView1D<Vector2> positions, textureCoordinates;
+    std::tie(positions, textureCoordinates) = vertexViews(vertexData);
+    UnsignedInt glyphCount;
+    std::tie(glyphCount, _rectangle) = renderInto(font, cache, size, {text.data(), text.size()}, positions, textureCoordinates, _alignment);
 
-    const UnsignedInt glyphCount = vertexData.size()/4;
     const UnsignedInt vertexCount = glyphCount*4;
     const UnsignedInt indexCount = glyphCount*6;
 
     CORRADE_ASSERT(glyphCount <= _capacity,
         "Text::Renderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
 
-    /* Interleave the data into mapped buffer*/
+    /* Copy the data into the mapped buffer */
     Containers::ArrayView<Vertex> vertices(static_cast<Vertex*>(bufferMapImplementation(_vertexBuffer,
         vertexCount*sizeof(Vertex))), vertexCount);
-    CORRADE_INTERNAL_ASSERT_OUTPUT(vertices);
-    std::copy(vertexData.begin(), vertexData.end(), vertices.begin());
+    CORRADE_INTERNAL_ASSERT(vertices || !vertexCount);
+    std::copy(vertexData.begin(), vertexData.begin() + vertexCount, vertices.begin());
     bufferUnmapImplementation(_vertexBuffer);
 
     /* Update index count */
     _mesh.setCount(indexCount);
 }
 
+template<UnsignedInt dimensions> BatchRenderer<dimensions>::BatchRenderer(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const UnsignedInt glyphCapacity, const GL::BufferUsage usage): AbstractBatchRenderer{font, cache, size, glyphCapacity}, _vertexBuffer{GL::Buffer::TargetHint::Array}, _indexBuffer{GL::Buffer::TargetHint::ElementArray} {
+    /* The arena is all zeros initially, upload it whole so the degenerate
+       glyphs are there from the start */
+    _vertexBuffer.setData(vertexData(), usage);
+
+    /* The indices never change */
+    Containers::Array<char> indexData;
+    MeshIndexType indexType;
+    std::tie(indexData, indexType) = renderIndicesInternal(glyphCapacity);
+    _indexBuffer.setData(indexData, GL::BufferUsage::StaticDraw);
+
+    _mesh.setPrimitive(MeshPrimitive::Triangles)
+        .setCount(0)
+        .setIndexBuffer(_indexBuffer, 0, indexType, 0, glyphCapacity*4)
+        .addVertexBuffer(_vertexBuffer, 0,
+            typename Shaders::AbstractVector<dimensions>::Position(Shaders::AbstractVector<dimensions>::Position::Components::Two),
+            typename Shaders::AbstractVector<dimensions>::TextureCoordinates());
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::doUpload(const UnsignedInt glyphOffset, const Containers::ArrayView<const char> data) {
+    _vertexBuffer.setSubData(glyphOffset*4*sizeof(Vertex), data);
+    _mesh.setCount(drawGlyphCount()*6);
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_TEXT_EXPORT Renderer<2>;
 template class MAGNUM_TEXT_EXPORT Renderer<3>;
+template class MAGNUM_TEXT_EXPORT BatchRenderer<2>;
+template class MAGNUM_TEXT_EXPORT BatchRenderer<3>;
 #endif
 
 }}
@@ -26,7 +26,7 @@
 */
 
 /** @file Text/Renderer.h
- * @brief Class @ref Magnum::Text::AbstractRenderer, @ref Magnum::Text::Renderer, typedef @ref Magnum::Text::Renderer2D, @ref Magnum::Text::Renderer3D
+ * @brief Class @ref Magnum::Text::AbstractRenderer, @ref Magnum::Text::Renderer, @ref Magnum::Text::BatchRenderer, typedef @ref Magnum::Text::Renderer2D, @ref Magnum::Text::Renderer3D, @ref Magnum::Text::BatchRenderer2D, @ref Magnum::Text::BatchRenderer3D
  */
 
 #include "Magnum/configure.h"
@@ -35,19 +35,17 @@
 #include <string>
 #include <tuple>
 #include <vector>
+#include <Corrade/Containers/Array.h>
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/Text/AbstractBatchRenderer.h"
 #include "Magnum/Text/Text.h"
 #include "Magnum/Text/Alignment.h"
 #include "Magnum/Text/visibility.h"
 
-#ifdef CORRADE_TARGET_EMSCRIPTEN
-#include <Corrade/Containers/Array.h>
-#endif
-
 namespace Magnum { namespace Text {
 
 /**
@@ -109,7 +107,12 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          *
          * Renders the text to vertex buffer, reusing index buffer already
          * filled with @ref reserve(). Rectangle spanning the rendered text is
-         * available through @ref rectangle().
+         * available through @ref rectangle(). The vertex data are rendered
+         * using @ref renderInto() into a scratch array that's kept across
+         * calls and then copied into the mapped buffer. Once the scratch
+         * array is large enough for the text and if the font implements
+         * @ref AbstractFont::doLayoutInto() in an allocation-free way, this
+         * function doesn't allocate.
          *
          * Initially no text is rendered.
          * @attention The capacity must be large enough to contain all glyphs,
@@ -139,6 +142,8 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         Alignment _alignment;
         UnsignedInt _capacity;
         Range2D _rectangle;
+        /* Scratch vertex data reused across render() calls */
+        Containers::Array<char> _vertexData;
 
         #if defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
         typedef void*(*BufferMapImplementation)(GL::Buffer&, GLsizeiptr);
@@ -243,6 +248,78 @@ typedef Renderer<2> Renderer2D;
 /** @brief Three-dimensional text renderer */
 typedef Renderer<3> Renderer3D;
 
+/**
+@brief Batched text renderer
+@m_since_latest
+
+OpenGL implementation of @ref AbstractBatchRenderer, rendering many
+independent texts with a single draw call. The vertex buffer is allocated for
+the whole arena upfront and the index buffer is filled just once in the
+constructor, @ref update() then uploads only the changed glyph ranges with
+@ref GL::Buffer::setSubData() and updates the index count of @ref mesh().
+@code{.cpp}
+Text::BatchRenderer2D renderer{font, cache, 32.0f, 1024};
+UnsignedInt fps = renderer.add("FPS: 60", {-1.0f, 1.0f}, Text::Alignment::TopLeft);
+UnsignedInt title = renderer.add("Hello World!", {}, Text::Alignment::MiddleCenter);
+
+// each frame
+renderer.set(fps, Utility::formatString("FPS: {}", currentFps));
+renderer.update();
+shader.draw(renderer.mesh());
+@endcode
+
+The mesh is meant to be drawn with @ref Shaders::Vector or
+@ref Shaders::DistanceFieldVector, same as with @ref Renderer. Unlike
+@ref Renderer, any @ref AbstractGlyphCache can be used, including a
+@ref DynamicGlyphCache, with the glyph texture managed by the application.
+@see @ref BatchRenderer2D, @ref BatchRenderer3D
+*/
+template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT BatchRenderer: public AbstractBatchRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param glyphCapacity Capacity of the vertex arena in glyphs
+         * @param usage         Vertex buffer usage
+         */
+        explicit BatchRenderer(AbstractFont& font, const AbstractGlyphCache& cache, Float size, UnsignedInt glyphCapacity, GL::BufferUsage usage = GL::BufferUsage::DynamicDraw);
+        BatchRenderer(AbstractFont&, AbstractGlyphCache&&, Float, UnsignedInt, GL::BufferUsage = GL::BufferUsage::DynamicDraw) = delete; /**< @overload */
+
+        /** @brief Vertex buffer */
+        GL::Buffer& vertexBuffer() { return _vertexBuffer; }
+
+        /** @brief Index buffer */
+        GL::Buffer& indexBuffer() { return _indexBuffer; }
+
+        /**
+         * @brief Mesh
+         *
+         * Draws all glyphs up to @ref drawGlyphCount() as of the last
+         * @ref update().
+         */
+        GL::Mesh& mesh() { return _mesh; }
+
+    private:
+        void doUpload(UnsignedInt glyphOffset, Containers::ArrayView<const char> data) override;
+
+        GL::Buffer _vertexBuffer, _indexBuffer;
+        GL::Mesh _mesh;
+};
+
+/**
+@brief Two-dimensional batched text renderer
+@m_since_latest
+*/
+typedef BatchRenderer<2> BatchRenderer2D;
+
+/**
+@brief Three-dimensional batched text renderer
+@m_since_latest
+*/
+typedef BatchRenderer<3> BatchRenderer3D;
+
 }}
 #else
 #error this header is available only in the OpenGL build
@@ -0,0 +1,496 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/AbstractBatchRenderer.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct AbstractBatchRendererTest: TestSuite::Tester {
+    explicit AbstractBatchRendererTest();
+
+    void construct();
+    void constructCopy();
+
+    void add();
+    void addEmpty();
+    void addTooLarge();
+    void setInPlace();
+    void setRelocate();
+    void setTooLarge();
+    void setPosition();
+    void remove();
+    void ringAllocation();
+    void compaction();
+    void invalidId();
+};
+
+AbstractBatchRendererTest::AbstractBatchRendererTest() {
+    addTests({&AbstractBatchRendererTest::construct,
+              &AbstractBatchRendererTest::constructCopy,
+
+              &AbstractBatchRendererTest::add,
+              &AbstractBatchRendererTest::addEmpty,
+              &AbstractBatchRendererTest::addTooLarge,
+              &AbstractBatchRendererTest::setInPlace,
+              &AbstractBatchRendererTest::setRelocate,
+              &AbstractBatchRendererTest::setTooLarge,
+              &AbstractBatchRendererTest::setPosition,
+              &AbstractBatchRendererTest::remove,
+              &AbstractBatchRendererTest::ringAllocation,
+              &AbstractBatchRendererTest::compaction,
+              &AbstractBatchRendererTest::invalidId});
+}
+
+struct DummyGlyphCache: AbstractGlyphCache {
+    using AbstractGlyphCache::AbstractGlyphCache;
+
+    GlyphCacheFeatures doFeatures() const override { return {}; }
+    void doSetImage(const Vector2i&, const ImageView2D&) override {}
+};
+
+/* One glyph per byte, each a 1x2 quad with advance of 1.5 */
+struct TestFont: AbstractFont {
+    struct Layouter: AbstractLayouter {
+        explicit Layouter(): AbstractLayouter{0} {}
+
+        using AbstractLayouter::setGlyphCount;
+
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(Range2D{{}, {1.0f, 2.0f}},
+                Range2D{{i*0.25f, 0.0f}, {i*0.25f + 0.25f, 1.0f}},
+                Vector2::xAxis(1.5f));
+        }
+    };
+
+    FontFeatures doFeatures() const override { return FontFeature::OpenData; }
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override {}
+
+    Metrics doOpenData(const Containers::ArrayView<const char>, Float size) override {
+        _opened = true;
+        return {size, 1.0f, 2.0f, 3.0f};
+    }
+
+    UnsignedInt doGlyphId(char32_t) override { return {}; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+    Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override {
+        return nullptr;
+    }
+    AbstractLayouter& doLayoutInto(const AbstractGlyphCache&, Float, Containers::ArrayView<const char> text) override {
+        layouter.setGlyphCount(UnsignedInt(text.size()));
+        return layouter;
+    }
+
+    bool _opened = false;
+    Layouter layouter;
+};
+
+/* Records the uploaded ranges as glyph offset and glyph count */
+struct BatchRenderer: AbstractBatchRenderer {
+    using AbstractBatchRenderer::AbstractBatchRenderer;
+
+    void doUpload(UnsignedInt glyphOffset, Containers::ArrayView<const char> data) override {
+        CORRADE_INTERNAL_ASSERT(data.data() == vertexData().data() + glyphOffset*4*16);
+        uploads.emplace_back(glyphOffset, data.size()/(4*16));
+    }
+
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> uploads;
+};
+
+/* Whether all four vertices of given glyph are zero */
+bool isDegenerate(const AbstractBatchRenderer& renderer, const UnsignedInt glyph) {
+    for(UnsignedInt i = glyph*4; i != glyph*4 + 4; ++i)
+        if(renderer.positions()[i] != Vector2{} || renderer.textureCoordinates()[i] != Vector2{}) return false;
+    return true;
+}
+
+void AbstractBatchRendererTest::construct() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer renderer{font, cache, 1.0f, 16};
+    CORRADE_COMPARE(renderer.glyphCapacity(), 16);
+    CORRADE_COMPARE(renderer.reservedGlyphCount(), 0);
+    CORRADE_COMPARE(renderer.drawGlyphCount(), 0);
+    CORRADE_COMPARE(renderer.textCount(), 0);
+    CORRADE_VERIFY(!renderer.isDirty());
+    CORRADE_COMPARE(renderer.vertexData().size(), 16*4*16);
+    CORRADE_COMPARE(renderer.positions().size(), 16*4);
+    CORRADE_COMPARE(renderer.textureCoordinates().size(), 16*4);
+    for(UnsignedInt i = 0; i != 16; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(isDegenerate(renderer, i));
+    }
+
+    /* Nothing to upload */
+    renderer.update();
+    CORRADE_VERIFY(renderer.uploads.empty());
+}
+
+void AbstractBatchRendererTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<AbstractBatchRenderer, const AbstractBatchRenderer&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<AbstractBatchRenderer, const AbstractBatchRenderer&>{}));
+}
+
+void AbstractBatchRendererTest::add() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer renderer{font, cache, 1.0f, 16};
+    CORRADE_COMPARE(renderer.add("ab", {10.0f, 20.0f}), 0);
+    CORRADE_COMPARE(renderer.add("c"), 1);
+    CORRADE_COMPARE(renderer.textCount(), 2);
+    CORRADE_COMPARE(renderer.reservedGlyphCount(), 3);
+    CORRADE_COMPARE(renderer.drawGlyphCount(), 3);
+    CORRADE_COMPARE(renderer.text(0), "ab");
+    CORRADE_COMPARE(renderer.text(1), "c");
+    CORRADE_VERIFY(renderer.isDirty());
+
+    /* The layout is done only in update(), both texts are uploaded at once */
+    CORRADE_VERIFY(isDegenerate(renderer, 0));
+    renderer.update();
+    CORRADE_VERIFY(!renderer.isDirty());
+    CORRADE_COMPARE_AS(renderer.uploads, (std::vector<std::pair<UnsignedInt, UnsignedInt>>{
+        {0, 3}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(renderer.rectangle(0), (Range2D{{10.0f, 20.0f}, {12.5f, 22.0f}}));
+    CORRADE_COMPARE(renderer.rectangle(1), (Range2D{{0.0f, 0.0f}, {1.0f, 2.0f}}));
+    CORRADE_COMPARE_AS(renderer.positions().prefix(12), Containers::arrayView<Vector2>({
+        {10.0f, 22.0f}, {10.0f, 20.0f}, {11.0f, 22.0f}, {11.0f, 20.0f},
+        {11.5f, 22.0f}, {11.5f, 20.0f}, {12.5f, 22.0f}, {12.5f, 20.0f},
+        {0.0f, 2.0f}, {0.0f, 0.0f}, {1.0f, 2.0f}, {1.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(renderer.textureCoordinates().prefix(12), Containers::arrayView<Vector2>({
+        {0.0f, 1.0f}, {0.0f, 0.0f}, {0.25f, 1.0f}, {0.25f, 0.0f},
+        {0.25f, 1.0f}, {0.25f, 0.0f}, {0.5f, 1.0f}, {0.5f, 0.0f},
+        {0.0f, 1.0f}, {0.0f, 0.0f}, {0.25f, 1.0f}, {0.25f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(isDegenerate(renderer, 3));
+
+    /* Nothing changed, nothing uploaded */
+    renderer.uploads.clear();
+    renderer.update();
+    CORRADE_VERIFY(renderer.uploads.empty());
+}
+
+void AbstractBatchRendererTest::addEmpty() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer renderer{font, cache, 1.0f, 16};
+    CORRADE_COMPARE(renderer.add("", {3.0f, 4.0f}), 0);
+    CORRADE_COMPARE(renderer.textCount(), 1);
+    CORRADE_COMPARE(renderer.reservedGlyphCount(), 0);
+    CORRADE_COMPARE(renderer.drawGlyphCount(), 0);
+
+    /* Doesn't reserve anything, so there's nothing to upload */
+    renderer.update();
+    CORRADE_VERIFY(!renderer.isDirty());
+    CORRADE_VERIFY(renderer.uploads.empty());
+    CORRADE_COMPARE(renderer.rectangle(0), (Range2D{{3.0f, 4.0f}, {3.0f, 4.0f}}));
+}
+
+void AbstractBatchRendererTest::addTooLarge() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer renderer{font, cache, 1.0f, 4};
+    renderer.add("abc");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    renderer.add("de");
+    CORRADE_COMPARE(out.str(), "Text::AbstractBatchRenderer::add(): can't fit 2 glyphs into 1 remaining\n");
+}
+
+void AbstractBatchRendererTest::setInPlace() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer renderer{font, cache, 1.0f, 16};
+    renderer.add("abc");
+    renderer.add("de", {0.0f, 10.0f});
+    renderer.update();
+    renderer.uploads.clear();
+
+    /* A shorter text is laid out in place, the rest of the range becomes
+       degenerate and only the range of the changed text gets uploaded */
+    renderer.set(0, "x");
+    CORRADE_VERIFY(renderer.isDirty());
+    CORRADE_COMPARE(renderer.text(0), "x");
+    CORRADE_COMPARE(renderer.reservedGlyphCount(), 5);
+    renderer.update();
+    CORRADE_COMPARE_AS(renderer.uploads, (std::vector<std::pair<UnsignedInt, UnsignedInt>>{
+        {0, 3}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(renderer.rectangle(0), (Range2D{{0.0f, 0.0f}, {1.0f, 2.0f}}));
+    CORRADE_VERIFY(!isDegenerate(renderer, 0));
+    CORRADE_VERIFY(isDegenerate(renderer, 1));
+    CORRADE_VERIFY(isDegenerate(renderer, 2));
+    CORRADE_COMPARE(renderer.positions()[12], (Vector2{0.0f, 12.0f}));
+    CORRADE_COMPARE(renderer.drawGlyphCount(), 5);
+
+    /* Growing back to the original size is still in place */
+    renderer.uploads.clear();
+    renderer.set(0, "xyz");
+    renderer.update();
+    CORRADE_COMPARE_AS(renderer.uploads, (std::vector<std::pair<UnsignedInt, UnsignedInt>>{
+        {0, 3}
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(!isDegenerate(renderer, 2));
+}
+
+void AbstractBatchRendererTest::setRelocate() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer renderer{font, cache, 1.0f, 10};
+    renderer.add("ab");
+    renderer.add("cd", {0.0f, 10.0f});
+    renderer.update();
+    renderer.uploads.clear();
+
+    /* A longer text gets a new range after the last allocated one, the
+       original range becomes degenerate */
+    renderer.set(0, "efgh");
+    CORRADE_COMPARE(renderer.reservedGlyphCount(), 6);
+    CORRADE_COMPARE(renderer.drawGlyphCount(), 8);
+    renderer.update();
+    CORRADE_COMPARE_AS(renderer.uploads, (std::vector<std::pair<UnsignedInt, UnsignedInt>>{
+        {0, 2},
+        {4, 4}
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(isDegenerate(renderer, 0));
+    CORRADE_VERIFY(isDegenerate(renderer, 1));
+    CORRADE_COMPARE(renderer.positions()[8], (Vector2{0.0f, 12.0f}));
+    CORRADE_COMPARE(renderer.positions()[16], (Vector2{0.0f, 2.0f}));
+    CORRADE_COMPARE(renderer.positions()[28], (Vector2{4.5f, 2.0f}));
+    CORRADE_COMPARE(renderer.rectangle(0), (Range2D{{0.0f, 0.0f}, {5.5f, 2.0f}}));
+}
+
+void AbstractBatchRendererTest::setTooLarge() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer renderer{font, cache, 1.0f, 4};
+    renderer.add("abc");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    renderer.set(0, "abcdef");
+    CORRADE_COMPARE(out.str(), "Text::AbstractBatchRenderer::set(): can't fit 6 glyphs into 4 remaining\n");
+}
+
+void AbstractBatchRendererTest::setPosition() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer renderer{font, cache, 1.0f, 16};
+    renderer.add("a");
+    renderer.add("bc");
+    renderer.update();
+    renderer.uploads.clear();
+
+    renderer.setPosition(1, {-5.0f, 1.0f});
+    CORRADE_VERIFY(renderer.isDirty());
+    renderer.update();
+    CORRADE_COMPARE_AS(renderer.uploads, (std::vector<std::pair<UnsignedInt, UnsignedInt>>{
+        {1, 2}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(renderer.positions()[4], (Vector2{-5.0f, 3.0f}));
+    CORRADE_COMPARE(renderer.rectangle(1), (Range2D{{-5.0f, 1.0f}, {-2.5f, 3.0f}}));
+}
+
+void AbstractBatchRendererTest::remove() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer renderer{font, cache, 1.0f, 16};
+    renderer.add("ab");
+    renderer.add("cd");
+    renderer.update();
+    renderer.uploads.clear();
+
+    /* The range is zeroed right away, but uploaded only in update() */
+    renderer.remove(0);
+    CORRADE_COMPARE(renderer.textCount(), 1);
+    CORRADE_COMPARE(renderer.reservedGlyphCount(), 2);
+    CORRADE_COMPARE(renderer.drawGlyphCount(), 4);
+    CORRADE_VERIFY(isDegenerate(renderer, 0));
+    CORRADE_VERIFY(isDegenerate(renderer, 1));
+    CORRADE_VERIFY(renderer.isDirty());
+    renderer.update();
+    CORRADE_COMPARE_AS(renderer.uploads, (std::vector<std::pair<UnsignedInt, UnsignedInt>>{
+        {0, 2}
+    }), TestSuite::Compare::Container);
+
+    /* Removing the last range shrinks the drawn range */
+    renderer.remove(1);
+    CORRADE_COMPARE(renderer.textCount(), 0);
+    CORRADE_COMPARE(renderer.reservedGlyphCount(), 0);
+    CORRADE_COMPARE(renderer.drawGlyphCount(), 0);
+
+    /* The IDs get reused */
+    CORRADE_COMPARE(renderer.add("e"), 1);
+    CORRADE_COMPARE(renderer.add("f"), 0);
+    CORRADE_COMPARE(renderer.add("g"), 2);
+}
+
+void AbstractBatchRendererTest::ringAllocation() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer renderer{font, cache, 1.0f, 6};
+    renderer.add("ab", {0.0f, 10.0f});
+    renderer.add("cd", {0.0f, 20.0f});
+    renderer.remove(0);
+
+    /* The free range at the beginning is skipped, the allocation continues
+       after the last allocated range */
+    renderer.add("e", {0.0f, 30.0f});
+    CORRADE_COMPARE(renderer.drawGlyphCount(), 5);
+
+    /* Once there's no space left after, it wraps around */
+    renderer.add("fg", {0.0f, 40.0f});
+    CORRADE_COMPARE(renderer.drawGlyphCount(), 5);
+
+    renderer.update();
+    CORRADE_COMPARE(renderer.positions()[0], (Vector2{0.0f, 42.0f}));
+    CORRADE_COMPARE(renderer.positions()[4], (Vector2{1.5f, 42.0f}));
+    CORRADE_COMPARE(renderer.positions()[8], (Vector2{0.0f, 22.0f}));
+    CORRADE_COMPARE(renderer.positions()[16], (Vector2{0.0f, 32.0f}));
+    CORRADE_VERIFY(isDegenerate(renderer, 5));
+}
+
+void AbstractBatchRendererTest::compaction() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer renderer{font, cache, 1.0f, 6};
+    renderer.add("ab");
+    renderer.add("cd", {100.0f, 0.0f});
+    renderer.add("ef");
+    renderer.update();
+    renderer.uploads.clear();
+
+    /* Two free ranges of two glyphs, neither is enough for three glyphs */
+    renderer.remove(0);
+    renderer.remove(2);
+    CORRADE_COMPARE(renderer.drawGlyphCount(), 4);
+    CORRADE_COMPARE(renderer.add("ghi"), 2);
+    CORRADE_COMPARE(renderer.reservedGlyphCount(), 5);
+    CORRADE_COMPARE(renderer.drawGlyphCount(), 5);
+
+    /* The remaining text got moved to the front without being laid out
+       again and everything that changed is uploaded at once */
+    renderer.update();
+    CORRADE_COMPARE_AS(renderer.uploads, (std::vector<std::pair<UnsignedInt, UnsignedInt>>{
+        {0, 6}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(renderer.positions()[0], (Vector2{100.0f, 2.0f}));
+    CORRADE_COMPARE(renderer.positions()[4], (Vector2{101.5f, 2.0f}));
+    CORRADE_COMPARE(renderer.positions()[8], (Vector2{0.0f, 2.0f}));
+    CORRADE_COMPARE(renderer.positions()[16], (Vector2{3.0f, 2.0f}));
+    CORRADE_VERIFY(isDegenerate(renderer, 5));
+    CORRADE_COMPARE(renderer.rectangle(1), (Range2D{{100.0f, 0.0f}, {102.5f, 2.0f}}));
+
+    /* Changing the moved text updates its new location */
+    renderer.uploads.clear();
+    renderer.set(1, "x");
+    renderer.update();
+    CORRADE_COMPARE_AS(renderer.uploads, (std::vector<std::pair<UnsignedInt, UnsignedInt>>{
+        {0, 2}
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(isDegenerate(renderer, 1));
+    CORRADE_COMPARE(renderer.positions()[8], (Vector2{0.0f, 2.0f}));
+}
+
+void AbstractBatchRendererTest::invalidId() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer renderer{font, cache, 1.0f, 16};
+    renderer.add("a");
+    renderer.add("b");
+    renderer.remove(1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    renderer.set(1, "c");
+    renderer.setPosition(2, {});
+    renderer.remove(1);
+    renderer.text(2);
+    renderer.rectangle(1);
+
+    /* There's no text to fall back to in an empty renderer */
+    BatchRenderer empty{font, cache, 1.0f, 16};
+    CORRADE_COMPARE(empty.text(0), "");
+
+    CORRADE_COMPARE(out.str(),
+        "Text::AbstractBatchRenderer::set(): invalid ID 1\n"
+        "Text::AbstractBatchRenderer::setPosition(): invalid ID 2\n"
+        "Text::AbstractBatchRenderer::remove(): invalid ID 1\n"
+        "Text::AbstractBatchRenderer::text(): invalid ID 2\n"
+        "Text::AbstractBatchRenderer::rectangle(): invalid ID 1\n"
+        "Text::AbstractBatchRenderer::text(): invalid ID 0\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::AbstractBatchRendererTest)
@@ -26,7 +26,9 @@
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 
@@ -81,6 +83,11 @@ struct AbstractFontTest: TestSuite::Tester {
 
     void layout();
     void layoutNoFont();
+    void layoutInto();
+    void layoutIntoCustom();
+    void layoutIntoNoFont();
+    void layoutIntoSizeMismatch();
+    void layoutIntoTooSmall();
 
     void fillGlyphCache();
     void fillGlyphCacheNotSupported();
@@ -136,6 +143,11 @@ AbstractFontTest::AbstractFontTest() {
 
               &AbstractFontTest::layout,
               &AbstractFontTest::layoutNoFont,
+              &AbstractFontTest::layoutInto,
+              &AbstractFontTest::layoutIntoCustom,
+              &AbstractFontTest::layoutIntoNoFont,
+              &AbstractFontTest::layoutIntoSizeMismatch,
+              &AbstractFontTest::layoutIntoTooSmall,
 
               &AbstractFontTest::fillGlyphCache,
               &AbstractFontTest::fillGlyphCacheNotSupported,
@@ -990,6 +1002,176 @@ void AbstractFontTest::layoutNoFont() {
     CORRADE_COMPARE(out.str(), "Text::AbstractFont::layout(): no font opened\n");
 }
 
+/* Each glyph is a 1x2 quad with advance of 1.5, texture coordinates depend
+   on the glyph index */
+struct QuadLayouter: AbstractLayouter {
+    explicit QuadLayouter(UnsignedInt count): AbstractLayouter{count} {}
+
+    using AbstractLayouter::setGlyphCount;
+
+    std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+        return std::make_tuple(Range2D{{}, {1.0f, 2.0f}},
+            Range2D{{i*0.25f, 0.0f}, {i*0.25f + 0.25f, 1.0f}},
+            Vector2::xAxis(1.5f));
+    }
+};
+
+void AbstractFontTest::layoutInto() {
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string& str) override {
+            ++layoutCalls;
+            return Containers::pointer<QuadLayouter>(UnsignedInt(str.size()));
+        }
+
+        Int layoutCalls = 0;
+    } font;
+
+    DummyGlyphCache cache{{100, 200}};
+    Vector2 positions[12];
+    Vector2 textureCoordinates[12];
+    Vector2 cursorPosition{1.0f, 0.0f};
+    Range2D rectangle;
+    CORRADE_COMPARE(font.layoutInto(cache, 0.25f, Containers::arrayView("hi", 2), cursorPosition, rectangle, positions, textureCoordinates), 2);
+
+    /* The default implementation goes through doLayout() */
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(cursorPosition, (Vector2{4.0f, 0.0f}));
+    CORRADE_COMPARE(rectangle, (Range2D{{1.0f, 0.0f}, {3.5f, 2.0f}}));
+    CORRADE_COMPARE_AS(Containers::arrayView(positions).prefix(8), Containers::arrayView<Vector2>({
+        {1.0f, 2.0f}, {1.0f, 0.0f}, {2.0f, 2.0f}, {2.0f, 0.0f},
+        {2.5f, 2.0f}, {2.5f, 0.0f}, {3.5f, 2.0f}, {3.5f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(textureCoordinates).prefix(8), Containers::arrayView<Vector2>({
+        {0.0f, 1.0f}, {0.0f, 0.0f}, {0.25f, 1.0f}, {0.25f, 0.0f},
+        {0.25f, 1.0f}, {0.25f, 0.0f}, {0.5f, 1.0f}, {0.5f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void AbstractFontTest::layoutIntoCustom() {
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override {
+            ++layoutCalls;
+            return nullptr;
+        }
+        AbstractLayouter& doLayoutInto(const AbstractGlyphCache&, Float, Containers::ArrayView<const char> text) override {
+            layouter.setGlyphCount(UnsignedInt(text.size()));
+            return layouter;
+        }
+
+        QuadLayouter layouter{0};
+        Int layoutCalls = 0;
+    } font;
+
+    DummyGlyphCache cache{{100, 200}};
+    Vector2 positions[12];
+    Vector2 textureCoordinates[12];
+    Vector2 cursorPosition;
+    Range2D rectangle;
+    CORRADE_COMPARE(font.layoutInto(cache, 0.25f, Containers::arrayView("abc", 3), cursorPosition, rectangle, positions, textureCoordinates), 3);
+    CORRADE_COMPARE(cursorPosition, (Vector2{4.5f, 0.0f}));
+    CORRADE_COMPARE(positions[11], (Vector2{4.0f, 0.0f}));
+
+    /* Reusing the layouter for a shorter text */
+    cursorPosition = {};
+    rectangle = {};
+    CORRADE_COMPARE(font.layoutInto(cache, 0.25f, Containers::arrayView("x", 1), cursorPosition, rectangle, positions, textureCoordinates), 1);
+    CORRADE_COMPARE(cursorPosition, (Vector2{1.5f, 0.0f}));
+    CORRADE_COMPARE(rectangle, (Range2D{{}, {1.0f, 2.0f}}));
+
+    /* doLayout() wasn't used at all */
+    CORRADE_COMPARE(font.layoutCalls, 0);
+}
+
+void AbstractFontTest::layoutIntoNoFont() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+    } font;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DummyGlyphCache cache{{100, 200}};
+    Vector2 cursorPosition;
+    Range2D rectangle;
+    font.layoutInto(cache, 0.25f, Containers::arrayView("hello", 5), cursorPosition, rectangle, nullptr, nullptr);
+    CORRADE_COMPARE(out.str(), "Text::AbstractFont::layoutInto(): no font opened\n");
+}
+
+void AbstractFontTest::layoutIntoSizeMismatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+    } font;
+
+    Vector2 positions[8];
+    Vector2 textureCoordinates[7];
+    std::ostringstream out;
+    Error redirectError{&out};
+    DummyGlyphCache cache{{100, 200}};
+    Vector2 cursorPosition;
+    Range2D rectangle;
+    font.layoutInto(cache, 0.25f, Containers::arrayView("hi", 2), cursorPosition, rectangle, positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(), "Text::AbstractFont::layoutInto(): expected position and texture coordinate views to have the same size, got 8 and 7\n");
+}
+
+void AbstractFontTest::layoutIntoTooSmall() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string& str) override {
+            return Containers::pointer<QuadLayouter>(UnsignedInt(str.size()));
+        }
+    } font;
+
+    Vector2 positions[7];
+    Vector2 textureCoordinates[7];
+    std::ostringstream out;
+    Error redirectError{&out};
+    DummyGlyphCache cache{{100, 200}};
+    Vector2 cursorPosition;
+    Range2D rectangle;
+    font.layoutInto(cache, 0.25f, Containers::arrayView("hi", 2), cursorPosition, rectangle, positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(), "Text::AbstractFont::layoutInto(): expected at least 8 vertices for 2 glyphs but got 7\n");
+}
+
 void AbstractFontTest::fillGlyphCache() {
     struct MyFont: AbstractFont {
         FontFeatures doFeatures() const override { return {}; }
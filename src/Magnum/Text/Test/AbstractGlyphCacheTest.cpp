@@ -40,7 +40,16 @@ struct AbstractGlyphCacheTest: TestSuite::Tester {
 
     void initialize();
     void access();
+    void accessMany();
+    void insertDuplicate();
+    void iterate();
     void reserve();
+    void reserveIncremental();
+    void reserveTooLarge();
+    void reserveCustom();
+
+    void remove();
+    void removeInvalid();
 
     void setImage();
     void setImageOutOfBounds();
@@ -53,7 +62,16 @@ struct AbstractGlyphCacheTest: TestSuite::Tester {
 AbstractGlyphCacheTest::AbstractGlyphCacheTest() {
     addTests({&AbstractGlyphCacheTest::initialize,
               &AbstractGlyphCacheTest::access,
+              &AbstractGlyphCacheTest::accessMany,
+              &AbstractGlyphCacheTest::insertDuplicate,
+              &AbstractGlyphCacheTest::iterate,
               &AbstractGlyphCacheTest::reserve,
+              &AbstractGlyphCacheTest::reserveIncremental,
+              &AbstractGlyphCacheTest::reserveTooLarge,
+              &AbstractGlyphCacheTest::reserveCustom,
+
+              &AbstractGlyphCacheTest::remove,
+              &AbstractGlyphCacheTest::removeInvalid,
 
               &AbstractGlyphCacheTest::setImage,
               &AbstractGlyphCacheTest::setImageOutOfBounds,
@@ -68,6 +86,9 @@ struct DummyGlyphCache: AbstractGlyphCache {
 
     GlyphCacheFeatures doFeatures() const override { return {}; }
     void doSetImage(const Vector2i&, const ImageView2D&) override {}
+
+    using AbstractGlyphCache::remove;
+    using AbstractGlyphCache::glyphIndex;
 };
 
 void AbstractGlyphCacheTest::initialize() {
@@ -107,6 +128,67 @@ void AbstractGlyphCacheTest::access() {
     CORRADE_COMPARE(rectangle, Range2Di({10, 10}, {23, 45}));
 }
 
+void AbstractGlyphCacheTest::accessMany() {
+    DummyGlyphCache cache{Vector2i{4096}};
+
+    /* Insert enough glyphs to make the lookup table grow several times, with
+       both dense and sparse IDs to cause some collisions */
+    for(UnsignedInt i = 1; i != 5000; ++i)
+        cache.insert(i, {Int(i), 0}, Range2Di::fromSize({}, {Int(i), 1}));
+    for(UnsignedInt i = 1; i != 100; ++i)
+        cache.insert(i << 20, {0, Int(i)}, Range2Di::fromSize({}, {1, Int(i)}));
+    cache.insert(0xffffffffu, {7, 7}, {});
+    CORRADE_COMPARE(cache.glyphCount(), 5000 + 99 + 1);
+
+    for(UnsignedInt i = 1; i != 5000; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(cache[i].first, (Vector2i{Int(i), 0}));
+        CORRADE_COMPARE(cache[i].second, Range2Di::fromSize({}, {Int(i), 1}));
+    }
+    for(UnsignedInt i = 1; i != 100; ++i) {
+        CORRADE_ITERATION(i << 20);
+        CORRADE_COMPARE(cache[i << 20].first, (Vector2i{0, Int(i)}));
+        CORRADE_COMPARE(cache[i << 20].second, Range2Di::fromSize({}, {1, Int(i)}));
+    }
+    CORRADE_COMPARE(cache[0xffffffffu].first, (Vector2i{7, 7}));
+
+    /* Not found falls back to glyph 0 */
+    CORRADE_COMPARE(cache[5000].first, Vector2i{});
+    CORRADE_COMPARE(cache[100 << 20].first, Vector2i{});
+    CORRADE_COMPARE(cache[0xfffffffeu].first, Vector2i{});
+}
+
+void AbstractGlyphCacheTest::insertDuplicate() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DummyGlyphCache cache{Vector2i{236}};
+    cache.insert(25, {}, {});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.insert(25, {}, {});
+    CORRADE_COMPARE(out.str(), "Text::AbstractGlyphCache::insert(): glyph 25 is already in the cache\n");
+}
+
+void AbstractGlyphCacheTest::iterate() {
+    DummyGlyphCache cache{Vector2i{236}};
+    cache.insert(25, {3, 4}, {{15, 30}, {45, 35}});
+    cache.insert(7, {1, 2}, {{5, 6}, {7, 8}});
+    cache.insert(0, {3, 5}, {{10, 10}, {23, 45}});
+
+    /* Insertion order, "Not Found" glyph always first */
+    std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>> glyphs{cache.begin(), cache.end()};
+    CORRADE_COMPARE(glyphs.size(), 3);
+    CORRADE_COMPARE(glyphs[0].first, 0);
+    CORRADE_COMPARE(glyphs[0].second.first, (Vector2i{3, 5}));
+    CORRADE_COMPARE(glyphs[1].first, 25);
+    CORRADE_COMPARE(glyphs[1].second.second, (Range2Di{{15, 30}, {45, 35}}));
+    CORRADE_COMPARE(glyphs[2].first, 7);
+    CORRADE_COMPARE(glyphs[2].second.first, (Vector2i{1, 2}));
+}
+
 void AbstractGlyphCacheTest::reserve() {
     DummyGlyphCache cache(Vector2i(236));
 
@@ -114,6 +196,112 @@ void AbstractGlyphCacheTest::reserve() {
     CORRADE_VERIFY(!cache.reserve({{5, 3}}).empty());
 }
 
+void AbstractGlyphCacheTest::reserveIncremental() {
+    DummyGlyphCache cache{{64, 64}, {1, 1}};
+
+    std::vector<Range2Di> first = cache.reserve({{10, 20}, {30, 10}});
+    CORRADE_COMPARE(first, (std::vector<Range2Di>{
+        Range2Di::fromSize({1, 1}, {10, 20}),
+        Range2Di::fromSize({13, 1}, {30, 10})}));
+    cache.insert(1, {}, first[0]);
+    cache.insert(2, {}, first[1]);
+
+    /* Reserving again in a non-empty cache doesn't overlap the previous
+       regions */
+    std::vector<Range2Di> second = cache.reserve({{20, 10}});
+    CORRADE_COMPARE(second, (std::vector<Range2Di>{
+        Range2Di::fromSize({13, 13}, {20, 10})}));
+}
+
+void AbstractGlyphCacheTest::reserveTooLarge() {
+    DummyGlyphCache cache{{64, 64}};
+    CORRADE_COMPARE(cache.reserve({{64, 60}}).size(), 1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(cache.reserve({{10, 2}, {10, 10}}).empty());
+    CORRADE_COMPARE(out.str(), "Text::AbstractGlyphCache::reserve(): can't fit 2 glyphs into remaining space of a Vector(64, 64) cache\n");
+
+    /* The smaller one still fits */
+    CORRADE_COMPARE(cache.reserve({{10, 2}}).size(), 1);
+}
+
+void AbstractGlyphCacheTest::reserveCustom() {
+    struct MyGlyphCache: AbstractGlyphCache {
+        using AbstractGlyphCache::AbstractGlyphCache;
+
+        GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+
+        std::vector<Range2Di> doReserve(const std::vector<Vector2i>& sizes) override {
+            std::vector<Range2Di> out;
+            for(const Vector2i& size: sizes)
+                out.push_back(Range2Di::fromSize({7, 3}, size));
+            return out;
+        }
+    } cache{{64, 64}};
+
+    CORRADE_COMPARE(cache.reserve({{10, 20}, {5, 6}}), (std::vector<Range2Di>{
+        Range2Di::fromSize({7, 3}, {10, 20}),
+        Range2Di::fromSize({7, 3}, {5, 6})}));
+}
+
+void AbstractGlyphCacheTest::remove() {
+    DummyGlyphCache cache{Vector2i{4096}};
+    for(UnsignedInt i = 1; i != 100; ++i)
+        cache.insert(i*7, {Int(i), 0}, {});
+
+    cache.remove(7*50);
+    cache.remove(7);
+    cache.remove(7*99);
+    CORRADE_COMPARE(cache.glyphCount(), 1 + 99 - 3);
+
+    /* Removed glyphs fall back to glyph 0, the rest is still found */
+    CORRADE_COMPARE(cache[7*50].first, Vector2i{});
+    CORRADE_COMPARE(cache[7].first, Vector2i{});
+    CORRADE_COMPARE(cache[7*99].first, Vector2i{});
+    for(UnsignedInt i = 2; i != 99; ++i) {
+        if(i == 50) continue;
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(cache[i*7].first, (Vector2i{Int(i), 0}));
+    }
+
+    /* The last glyph is always moved to the place of the removed one */
+    CORRADE_COMPARE(cache.begin()[0].first, 0);
+    CORRADE_COMPARE(cache.begin()[1].first, 7*98);
+    CORRADE_COMPARE(cache.begin()[2].first, 7*2);
+    CORRADE_COMPARE(cache.begin()[49].first, 7*49);
+    CORRADE_COMPARE(cache.begin()[50].first, 7*97);
+    CORRADE_COMPARE(cache.begin()[51].first, 7*51);
+    CORRADE_COMPARE((cache.end() - 1)->first, 7*96);
+    for(UnsignedInt i = 0; i != cache.glyphCount(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(cache.glyphIndex(cache.begin()[i].first), i);
+    }
+
+    /* A removed glyph can be inserted again */
+    cache.insert(7*50, {3, 3}, {});
+    CORRADE_COMPARE(cache[7*50].first, (Vector2i{3, 3}));
+    CORRADE_COMPARE((cache.end() - 1)->first, 7*50);
+}
+
+void AbstractGlyphCacheTest::removeInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DummyGlyphCache cache{Vector2i{236}};
+    cache.insert(25, {}, {});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.remove(0);
+    cache.remove(26);
+    CORRADE_COMPARE(out.str(),
+        "Text::AbstractGlyphCache::remove(): can't remove glyph 0\n"
+        "Text::AbstractGlyphCache::remove(): glyph 26 is not in the cache\n");
+}
+
 void AbstractGlyphCacheTest::setImage() {
     struct MyGlyphCache: AbstractGlyphCache {
         using AbstractGlyphCache::AbstractGlyphCache;
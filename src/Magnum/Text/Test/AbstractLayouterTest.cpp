@@ -27,6 +27,7 @@
 
 #include "Magnum/Math/Range.h"
 #include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
 
 namespace Magnum { namespace Text { namespace Test { namespace {
 
@@ -34,10 +35,14 @@ struct AbstractLayouterTest: TestSuite::Tester {
     explicit AbstractLayouterTest();
 
     void renderGlyph();
+
+    void layoutBenchmark();
 };
 
 AbstractLayouterTest::AbstractLayouterTest() {
     addTests({&AbstractLayouterTest::renderGlyph});
+
+    addBenchmarks({&AbstractLayouterTest::layoutBenchmark}, 10);
 }
 
 void AbstractLayouterTest::renderGlyph() {
@@ -80,6 +85,56 @@ void AbstractLayouterTest::renderGlyph() {
     CORRADE_COMPARE(rectangle, Range2D({2.0f, 0.5f}, {6.1f, 3.0f}));
 }
 
+void AbstractLayouterTest::layoutBenchmark() {
+    struct GlyphCache: AbstractGlyphCache {
+        using AbstractGlyphCache::AbstractGlyphCache;
+
+        GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    };
+
+    /* Same as what MagnumFont does -- look up each glyph in the cache and
+       calculate the quad and texture coordinates from it */
+    struct Layouter: AbstractLayouter {
+        explicit Layouter(const AbstractGlyphCache& cache, const std::vector<UnsignedInt>& glyphs): AbstractLayouter(UnsignedInt(glyphs.size())), cache(cache), glyphs(glyphs) {}
+
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(const UnsignedInt i) override {
+            Vector2i position;
+            Range2Di rectangle;
+            std::tie(position, rectangle) = cache[glyphs[i]];
+            return std::make_tuple(
+                Range2D(Range2Di::fromSize(position, rectangle.size())),
+                Range2D(rectangle).scaled(1.0f/Vector2(cache.textureSize())),
+                Vector2::xAxis(Float(rectangle.sizeX())));
+        }
+
+        const AbstractGlyphCache& cache;
+        const std::vector<UnsignedInt>& glyphs;
+    };
+
+    /* A cache with as many glyphs as a CJK font could have, and a text that
+       picks them in a random-ish order */
+    GlyphCache cache{Vector2i{4096}};
+    for(UnsignedInt i = 1; i != 30000; ++i)
+        cache.insert(i, {}, Range2Di::fromSize({Int(i % 256)*16, Int(i/256)*16}, {15, 15}));
+    std::vector<UnsignedInt> glyphs(10000);
+    for(std::size_t i = 0; i != glyphs.size(); ++i)
+        glyphs[i] = (i*7919) % 30000;
+
+    Layouter layouter{cache, glyphs};
+    Vector2 cursorPosition;
+    Range2D rectangle;
+    Float sum{};
+    CORRADE_BENCHMARK(10) {
+        cursorPosition = {};
+        rectangle = {};
+        for(UnsignedInt i = 0; i != layouter.glyphCount(); ++i)
+            sum += layouter.renderGlyph(i, cursorPosition, rectangle).second.sizeX();
+    }
+
+    CORRADE_VERIFY(sum > 0.0f);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::AbstractLayouterTest)
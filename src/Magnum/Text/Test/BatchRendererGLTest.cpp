@@ -0,0 +1,219 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/Text/Renderer.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct BatchRendererGLTest: GL::OpenGLTester {
+    explicit BatchRendererGLTest();
+
+    void construct();
+    void addUpdateRemove();
+};
+
+BatchRendererGLTest::BatchRendererGLTest() {
+    addTests({&BatchRendererGLTest::construct,
+              &BatchRendererGLTest::addUpdateRemove});
+}
+
+struct DummyGlyphCache: AbstractGlyphCache {
+    using AbstractGlyphCache::AbstractGlyphCache;
+
+    GlyphCacheFeatures doFeatures() const override { return {}; }
+    void doSetImage(const Vector2i&, const ImageView2D&) override {}
+};
+
+/* One glyph per byte, each a 1x2 quad with advance of 1.5 */
+struct TestFont: AbstractFont {
+    struct Layouter: AbstractLayouter {
+        explicit Layouter(): AbstractLayouter{0} {}
+
+        using AbstractLayouter::setGlyphCount;
+
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(Range2D{{}, {1.0f, 2.0f}},
+                Range2D{{i*0.25f, 0.0f}, {i*0.25f + 0.25f, 1.0f}},
+                Vector2::xAxis(1.5f));
+        }
+    };
+
+    FontFeatures doFeatures() const override { return FontFeature::OpenData; }
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override {}
+
+    Metrics doOpenData(const Containers::ArrayView<const char>, Float size) override {
+        _opened = true;
+        return {size, 1.0f, 2.0f, 3.0f};
+    }
+
+    UnsignedInt doGlyphId(char32_t) override { return {}; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+    Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override {
+        return nullptr;
+    }
+    AbstractLayouter& doLayoutInto(const AbstractGlyphCache&, Float, Containers::ArrayView<const char> text) override {
+        layouter.setGlyphCount(UnsignedInt(text.size()));
+        return layouter;
+    }
+
+    bool _opened = false;
+    Layouter layouter;
+};
+
+void BatchRendererGLTest::construct() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer2D renderer{font, cache, 1.0f, 16};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), 0);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    /* The whole arena is uploaded upfront, the index buffer just once. Four
+       vertices per glyph, each vertex has 2D position and 2D texture
+       coordinates, each float is four bytes; six indices per glyph, 64
+       vertices fit into 8-bit indices. */
+    CORRADE_COMPARE(renderer.vertexBuffer().size(), 16*4*(2 + 2)*4);
+    Containers::Array<char> indices = renderer.indexBuffer().data();
+    CORRADE_COMPARE(indices.size(), 16*6);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(indices).prefix(18),
+        (Containers::Array<UnsignedByte>{Containers::InPlaceInit, {
+            0,  1,  2,  1,  3,  2,
+            4,  5,  6,  5,  7,  6,
+            8,  9, 10,  9, 11, 10
+        }}), TestSuite::Compare::Container);
+    #endif
+}
+
+void BatchRendererGLTest::addUpdateRemove() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DummyGlyphCache cache{{100, 100}};
+
+    BatchRenderer2D renderer{font, cache, 1.0f, 16};
+    renderer.add("ab", {10.0f, 20.0f});
+    renderer.add("c");
+
+    /* Nothing is uploaded until update() */
+    CORRADE_COMPARE(renderer.mesh().count(), 0);
+    renderer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), 3*6);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    {
+        Containers::Array<char> vertices = renderer.vertexBuffer().data();
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).prefix(4*4*4),
+            (Containers::Array<Float>{Containers::InPlaceInit, {
+                10.0f, 22.0f, 0.0f,  1.0f,
+                10.0f, 20.0f, 0.0f,  0.0f,
+                11.0f, 22.0f, 0.25f, 1.0f,
+                11.0f, 20.0f, 0.25f, 0.0f,
+
+                11.5f, 22.0f, 0.25f, 1.0f,
+                11.5f, 20.0f, 0.25f, 0.0f,
+                12.5f, 22.0f, 0.5f,  1.0f,
+                12.5f, 20.0f, 0.5f,  0.0f,
+
+                0.0f, 2.0f, 0.0f,  1.0f,
+                0.0f, 0.0f, 0.0f,  0.0f,
+                1.0f, 2.0f, 0.25f, 1.0f,
+                1.0f, 0.0f, 0.25f, 0.0f,
+
+                /* Unused glyph after the last range stays degenerate */
+                0.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 0.0f, 0.0f
+            }}), TestSuite::Compare::Container);
+    }
+    #endif
+
+    /* A shorter text is laid out in place, the rest of its range becomes
+       degenerate and the index count stays the same */
+    renderer.set(0, "x");
+    renderer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), 3*6);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    {
+        Containers::Array<char> vertices = renderer.vertexBuffer().data();
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).prefix(3*4*4),
+            (Containers::Array<Float>{Containers::InPlaceInit, {
+                10.0f, 22.0f, 0.0f,  1.0f,
+                10.0f, 20.0f, 0.0f,  0.0f,
+                11.0f, 22.0f, 0.25f, 1.0f,
+                11.0f, 20.0f, 0.25f, 0.0f,
+
+                0.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 0.0f, 0.0f,
+
+                0.0f, 2.0f, 0.0f,  1.0f,
+                0.0f, 0.0f, 0.0f,  0.0f,
+                1.0f, 2.0f, 0.25f, 1.0f,
+                1.0f, 0.0f, 0.25f, 0.0f
+            }}), TestSuite::Compare::Container);
+    }
+    #endif
+
+    /* Removing the last text makes its range degenerate and shrinks the
+       index count */
+    renderer.remove(1);
+    renderer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), 2*6);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    {
+        Containers::Array<char> vertices = renderer.vertexBuffer().data();
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).slice(2*4*4, 3*4*4),
+            (Containers::Array<Float>{Containers::InPlaceInit, {
+                0.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 0.0f, 0.0f
+            }}), TestSuite::Compare::Container);
+    }
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::BatchRendererGLTest)
@@ -0,0 +1,441 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/DynamicGlyphCache.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct DynamicGlyphCacheTest: TestSuite::Tester {
+    explicit DynamicGlyphCacheTest();
+
+    void construct();
+
+    void fill();
+    void fillAlreadyThere();
+    void fillNotInFont();
+    void fillPadding();
+    void fillWholeImageUpload();
+    void fillNotFoundGlyphReplaced();
+
+    void evict();
+    void evictMultiple();
+    void evictShelfMerge();
+    void evictCurrentFrame();
+
+    void setImage();
+    void setImageInvalidFormat();
+    void image();
+};
+
+DynamicGlyphCacheTest::DynamicGlyphCacheTest() {
+    addTests({&DynamicGlyphCacheTest::construct,
+
+              &DynamicGlyphCacheTest::fill,
+              &DynamicGlyphCacheTest::fillAlreadyThere,
+              &DynamicGlyphCacheTest::fillNotInFont,
+              &DynamicGlyphCacheTest::fillPadding,
+              &DynamicGlyphCacheTest::fillWholeImageUpload,
+              &DynamicGlyphCacheTest::fillNotFoundGlyphReplaced,
+
+              &DynamicGlyphCacheTest::evict,
+              &DynamicGlyphCacheTest::evictMultiple,
+              &DynamicGlyphCacheTest::evictShelfMerge,
+              &DynamicGlyphCacheTest::evictCurrentFrame,
+
+              &DynamicGlyphCacheTest::setImage,
+              &DynamicGlyphCacheTest::setImageInvalidFormat,
+              &DynamicGlyphCacheTest::image});
+}
+
+/* Glyph ID is the character code, '?' is not in the font. Lowercase glyphs
+   are 4x4, uppercase 4x8, pixels of each glyph are filled with the character
+   code. */
+struct TestFont: AbstractFont {
+    FontFeatures doFeatures() const override { return FontFeature::OpenData; }
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override {}
+
+    Metrics doOpenData(const Containers::ArrayView<const char>, Float size) override {
+        _opened = true;
+        return {size, 1.0f, 2.0f, 3.0f};
+    }
+
+    UnsignedInt doGlyphId(char32_t character) override {
+        return character == '?' ? 0 : character;
+    }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+    Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override {
+        return nullptr;
+    }
+
+    void doFillGlyphCache(AbstractGlyphCache& cache, const std::u32string& characters) override {
+        ++fillCount;
+        for(char32_t c: characters) filled += char(c);
+
+        /* Like FreeType, rasterize the "Not Found" glyph every time */
+        std::u32string glyphs = characters;
+        if(withNotFoundGlyph) glyphs.insert(glyphs.begin(), U'\0');
+
+        std::vector<Vector2i> sizes;
+        for(char32_t c: glyphs) sizes.push_back(c == U'\0' ? Vector2i{2, 2} : c >= 'A' && c <= 'Z' ? Vector2i{4, 8} : Vector2i{4, 4});
+        const std::vector<Range2Di> rectangles = cache.reserve(sizes);
+        if(rectangles.empty()) return;
+
+        /* Like FreeType, upload the whole cache texture at once */
+        Image2D image{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, cache.textureSize(), Containers::Array<char>{Containers::ValueInit, std::size_t(cache.textureSize().product())}};
+        for(std::size_t i = 0; i != glyphs.size(); ++i) {
+            cache.insert(glyphs[i], {}, rectangles[i]);
+            if(wholeImage) {
+                for(Int y = rectangles[i].min().y(); y != rectangles[i].max().y(); ++y)
+                    for(Int x = rectangles[i].min().x(); x != rectangles[i].max().x(); ++x)
+                        image.pixels<UnsignedByte>()[y][x] = glyphs[i];
+            } else {
+                Image2D glyph{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, rectangles[i].size(), Containers::Array<char>{Containers::DirectInit, std::size_t(rectangles[i].size().product()), char(glyphs[i])}};
+                cache.setImage(rectangles[i].min(), glyph);
+            }
+        }
+        if(wholeImage) cache.setImage({}, image);
+    }
+
+    bool _opened = false;
+    bool wholeImage = false;
+    bool withNotFoundGlyph = false;
+    Int fillCount = 0;
+    std::string filled;
+};
+
+UnsignedByte pixel(const DynamicGlyphCache& cache, const Vector2i& position) {
+    return cache.imageView().pixels<UnsignedByte>()[position.y()][position.x()];
+}
+
+void DynamicGlyphCacheTest::construct() {
+    DynamicGlyphCache cache{{16, 8}, {1, 2}};
+    CORRADE_COMPARE(cache.textureSize(), (Vector2i{16, 8}));
+    CORRADE_COMPARE(cache.padding(), (Vector2i{1, 2}));
+    CORRADE_COMPARE(cache.features(), GlyphCacheFeature::ImageDownload);
+    CORRADE_COMPARE(cache.glyphCount(), 1);
+    CORRADE_COMPARE(cache.evictionCount(), 0);
+    CORRADE_VERIFY(cache.dirtyRectangles().empty());
+
+    ImageView2D image = cache.imageView();
+    CORRADE_COMPARE(image.format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image.size(), (Vector2i{16, 8}));
+    for(Int y = 0; y != 8; ++y) for(Int x = 0; x != 16; ++x) {
+        CORRADE_ITERATION(Vector2i(x, y));
+        CORRADE_COMPARE(pixel(cache, {x, y}), 0);
+    }
+}
+
+void DynamicGlyphCacheTest::fill() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DynamicGlyphCache cache{{16, 16}};
+
+    CORRADE_VERIFY(cache.fill(font, "abA"));
+    CORRADE_COMPARE(font.fillCount, 1);
+    CORRADE_COMPARE(font.filled, "abA");
+    CORRADE_COMPARE(cache.glyphCount(), 4);
+
+    /* The tall glyph is allocated first, the short glyphs would waste too
+       much space next to it so they get a new shelf */
+    CORRADE_COMPARE(cache['A'].second, (Range2Di{{0, 0}, {4, 8}}));
+    CORRADE_COMPARE(cache['a'].second, (Range2Di{{0, 8}, {4, 12}}));
+    CORRADE_COMPARE(cache['b'].second, (Range2Di{{4, 8}, {8, 12}}));
+    CORRADE_COMPARE_AS(cache.dirtyRectangles(), (std::vector<Range2Di>{
+        {{0, 8}, {4, 12}},
+        {{4, 8}, {8, 12}},
+        {{0, 0}, {4, 8}}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(pixel(cache, {0, 7}), 'A');
+    CORRADE_COMPARE(pixel(cache, {1, 9}), 'a');
+    CORRADE_COMPARE(pixel(cache, {7, 11}), 'b');
+    CORRADE_COMPARE(pixel(cache, {8, 8}), 0);
+    CORRADE_COMPARE(pixel(cache, {4, 0}), 0);
+
+    cache.clearDirtyRectangles();
+    CORRADE_VERIFY(cache.dirtyRectangles().empty());
+}
+
+void DynamicGlyphCacheTest::fillAlreadyThere() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DynamicGlyphCache cache{{16, 16}};
+
+    CORRADE_VERIFY(cache.fill(font, "ab"));
+    cache.clearDirtyRectangles();
+
+    /* Only the missing glyph gets rasterized, duplicates only once */
+    CORRADE_VERIFY(cache.fill(font, "bccba"));
+    CORRADE_COMPARE(font.fillCount, 2);
+    CORRADE_COMPARE(font.filled, "abc");
+    CORRADE_COMPARE(cache.glyphCount(), 4);
+    CORRADE_COMPARE_AS(cache.dirtyRectangles(), (std::vector<Range2Di>{
+        {{8, 0}, {12, 4}}
+    }), TestSuite::Compare::Container);
+
+    /* Nothing missing, the font isn't called at all */
+    CORRADE_VERIFY(cache.fill(font, "cab"));
+    CORRADE_COMPARE(font.fillCount, 2);
+}
+
+void DynamicGlyphCacheTest::fillNotInFont() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DynamicGlyphCache cache{{16, 16}};
+
+    CORRADE_VERIFY(cache.fill(font, "??"));
+    CORRADE_COMPARE(font.fillCount, 0);
+    CORRADE_COMPARE(cache.glyphCount(), 1);
+}
+
+void DynamicGlyphCacheTest::fillPadding() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DynamicGlyphCache cache{{16, 16}, {1, 1}};
+
+    CORRADE_VERIFY(cache.fill(font, "ab"));
+
+    /* The glyph rectangles include the padding, which stays zero */
+    CORRADE_COMPARE(cache['a'].second, (Range2Di{{0, 0}, {6, 6}}));
+    CORRADE_COMPARE(cache['b'].second, (Range2Di{{6, 0}, {12, 6}}));
+    CORRADE_COMPARE_AS(cache.dirtyRectangles(), (std::vector<Range2Di>{
+        {{0, 0}, {6, 6}},
+        {{6, 0}, {12, 6}}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(pixel(cache, {0, 0}), 0);
+    CORRADE_COMPARE(pixel(cache, {1, 1}), 'a');
+    CORRADE_COMPARE(pixel(cache, {4, 4}), 'a');
+    CORRADE_COMPARE(pixel(cache, {5, 5}), 0);
+    CORRADE_COMPARE(pixel(cache, {7, 1}), 'b');
+}
+
+void DynamicGlyphCacheTest::fillWholeImageUpload() {
+    TestFont font;
+    font.wholeImage = true;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DynamicGlyphCache cache{{16, 16}};
+
+    CORRADE_VERIFY(cache.fill(font, "ab"));
+    CORRADE_VERIFY(cache.fill(font, "c"));
+
+    /* The second upload contains zeros where the first glyphs are, but only
+       the newly reserved region is taken from it */
+    CORRADE_COMPARE(pixel(cache, {0, 0}), 'a');
+    CORRADE_COMPARE(pixel(cache, {4, 0}), 'b');
+    CORRADE_COMPARE(pixel(cache, {8, 0}), 'c');
+}
+
+void DynamicGlyphCacheTest::fillNotFoundGlyphReplaced() {
+    TestFont font;
+    font.withNotFoundGlyph = true;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DynamicGlyphCache cache{{10, 4}};
+
+    CORRADE_VERIFY(cache.fill(font, "a"));
+    CORRADE_COMPARE(cache[0].second, (Range2Di{{4, 0}, {6, 2}}));
+    CORRADE_COMPARE(cache['a'].second, (Range2Di{{0, 0}, {4, 4}}));
+
+    /* There's space only for the new glyph, the new "Not Found" glyph needs
+       the space of the previous one */
+    cache.nextFrame();
+    CORRADE_VERIFY(cache.fill(font, "b"));
+    CORRADE_COMPARE(cache.evictionCount(), 1);
+    CORRADE_COMPARE(cache['b'].second, (Range2Di{{6, 0}, {10, 4}}));
+    CORRADE_COMPARE(cache[0].second, (Range2Di{{0, 0}, {2, 2}}));
+
+    /* The previous "Not Found" glyph space got reclaimed and together with
+       the rest of the evicted glyph there's enough space without evicting
+       anything */
+    cache.nextFrame();
+    CORRADE_VERIFY(cache.fill(font, "c"));
+    CORRADE_COMPARE(cache.evictionCount(), 1);
+    CORRADE_COMPARE(cache['c'].second, (Range2Di{{2, 0}, {6, 4}}));
+}
+
+void DynamicGlyphCacheTest::evict() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DynamicGlyphCache cache{{8, 8}};
+
+    CORRADE_VERIFY(cache.fill(font, "ab"));
+    cache.nextFrame();
+    CORRADE_VERIFY(cache.fill(font, "cd"));
+    CORRADE_COMPARE(cache.evictionCount(), 0);
+    cache.nextFrame();
+    cache.clearDirtyRectangles();
+
+    /* The cache is full, using "b" makes "a" the least recently used */
+    CORRADE_VERIFY(cache.fill(font, "b"));
+    CORRADE_VERIFY(cache.fill(font, "e"));
+    CORRADE_COMPARE(cache.evictionCount(), 1);
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+    CORRADE_COMPARE(cache['a'].second, Range2Di{});
+    CORRADE_COMPARE(cache['e'].second, (Range2Di{{0, 0}, {4, 4}}));
+    CORRADE_COMPARE(cache['b'].second, (Range2Di{{4, 0}, {8, 4}}));
+    CORRADE_COMPARE_AS(cache.dirtyRectangles(), (std::vector<Range2Di>{
+        {{0, 0}, {4, 4}}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(pixel(cache, {0, 0}), 'e');
+
+    /* The evicted glyph gets rasterized again when needed */
+    cache.nextFrame();
+    CORRADE_VERIFY(cache.fill(font, "a"));
+    CORRADE_COMPARE(font.filled, "abcdea");
+    CORRADE_COMPARE(cache.evictionCount(), 2);
+    CORRADE_COMPARE(cache['c'].second, Range2Di{});
+    CORRADE_COMPARE(cache['a'].second, (Range2Di{{0, 4}, {4, 8}}));
+}
+
+void DynamicGlyphCacheTest::evictMultiple() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DynamicGlyphCache cache{{8, 8}};
+
+    CORRADE_VERIFY(cache.fill(font, "abcd"));
+    cache.nextFrame();
+
+    /* Evicting "b" moves "d", which was inserted last, to its place. The
+       least recently used order has to stay the same after that. */
+    CORRADE_VERIFY(cache.fill(font, "a"));
+    CORRADE_VERIFY(cache.fill(font, "ef"));
+    CORRADE_COMPARE(cache.evictionCount(), 2);
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+    CORRADE_COMPARE(cache['b'].second, Range2Di{});
+    CORRADE_COMPARE(cache['c'].second, Range2Di{});
+
+    /* Now "a", "e" and "f" were used after "d", so touching it makes "a"
+       and "e" the least recently used */
+    cache.nextFrame();
+    CORRADE_VERIFY(cache.fill(font, "d"));
+    CORRADE_VERIFY(cache.fill(font, "gh"));
+    CORRADE_COMPARE(cache.evictionCount(), 4);
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+    CORRADE_COMPARE(cache['a'].second, Range2Di{});
+    CORRADE_COMPARE(cache['e'].second, Range2Di{});
+    CORRADE_VERIFY(cache['d'].second.size().product());
+    CORRADE_VERIFY(cache['f'].second.size().product());
+    CORRADE_VERIFY(cache['g'].second.size().product());
+    CORRADE_VERIFY(cache['h'].second.size().product());
+}
+
+void DynamicGlyphCacheTest::evictShelfMerge() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DynamicGlyphCache cache{{8, 8}};
+
+    /* Two shelves of 4x4 glyphs */
+    CORRADE_VERIFY(cache.fill(font, "abcd"));
+    cache.nextFrame();
+
+    /* A tall glyph needs both shelves to be emptied */
+    CORRADE_VERIFY(cache.fill(font, "A"));
+    CORRADE_COMPARE(cache.evictionCount(), 4);
+    CORRADE_COMPARE(cache.glyphCount(), 2);
+    CORRADE_COMPARE(cache['A'].second, (Range2Di{{0, 0}, {4, 8}}));
+
+    /* Next to it there's a space for another tall glyph */
+    cache.nextFrame();
+    CORRADE_VERIFY(cache.fill(font, "A"));
+    CORRADE_VERIFY(cache.fill(font, "B"));
+    CORRADE_COMPARE(cache.evictionCount(), 4);
+    CORRADE_COMPARE(cache['B'].second, (Range2Di{{4, 0}, {8, 8}}));
+}
+
+void DynamicGlyphCacheTest::evictCurrentFrame() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DynamicGlyphCache cache{{8, 8}};
+
+    CORRADE_VERIFY(cache.fill(font, "ab"));
+    CORRADE_VERIFY(cache.fill(font, "cd"));
+
+    /* All glyphs were used in this frame, nothing can be evicted */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!cache.fill(font, "ef"));
+    CORRADE_COMPARE(out.str(), "Text::DynamicGlyphCache::reserve(): can't fit 2 glyphs into a Vector(8, 8) cache even after evicting all glyphs not used in current frame\n");
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+    CORRADE_COMPARE(cache.evictionCount(), 0);
+
+    /* In the next frame it's fine */
+    cache.nextFrame();
+    CORRADE_VERIFY(cache.fill(font, "ef"));
+    CORRADE_COMPARE(cache.evictionCount(), 2);
+}
+
+void DynamicGlyphCacheTest::setImage() {
+    DynamicGlyphCache cache{{8, 8}};
+
+    /* Outside of fill() the whole image is copied */
+    const char data[]{7, 7, 7, 7};
+    cache.setImage({2, 4}, ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {2, 2}, data});
+    CORRADE_COMPARE(pixel(cache, {2, 4}), 7);
+    CORRADE_COMPARE(pixel(cache, {3, 5}), 7);
+    CORRADE_COMPARE(pixel(cache, {4, 5}), 0);
+    CORRADE_COMPARE_AS(cache.dirtyRectangles(), (std::vector<Range2Di>{
+        {{2, 4}, {4, 6}}
+    }), TestSuite::Compare::Container);
+}
+
+void DynamicGlyphCacheTest::setImageInvalidFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DynamicGlyphCache cache{{8, 8}};
+
+    const char data[4]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.setImage({}, ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data});
+    CORRADE_COMPARE(out.str(), "Text::DynamicGlyphCache::setImage(): expected PixelFormat::R8Unorm but got PixelFormat::RGBA8Unorm\n");
+}
+
+void DynamicGlyphCacheTest::image() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 1.0f));
+    DynamicGlyphCache cache{{6, 4}};
+    CORRADE_VERIFY(cache.fill(font, "a"));
+
+    Image2D image = cache.image();
+    CORRADE_COMPARE(image.format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image.size(), (Vector2i{6, 4}));
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[3][3], 'a');
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[3][4], 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::DynamicGlyphCacheTest)
@@ -0,0 +1,182 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/Text/Render.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct RenderTest: TestSuite::Tester {
+    explicit RenderTest();
+
+    void renderInto();
+    void renderIntoEmpty();
+    void renderIntoAlignment();
+    void renderIntoSizeMismatch();
+};
+
+RenderTest::RenderTest() {
+    addTests({&RenderTest::renderInto,
+              &RenderTest::renderIntoEmpty,
+              &RenderTest::renderIntoAlignment,
+              &RenderTest::renderIntoSizeMismatch});
+}
+
+struct DummyGlyphCache: AbstractGlyphCache {
+    using AbstractGlyphCache::AbstractGlyphCache;
+
+    GlyphCacheFeatures doFeatures() const override { return {}; }
+    void doSetImage(const Vector2i&, const ImageView2D&) override {}
+};
+
+/* One glyph per byte, each a 1x2 quad with advance of 1.5 (scaled by text
+   size relative to font size) */
+struct TestFont: AbstractFont {
+    struct Layouter: AbstractLayouter {
+        explicit Layouter(): AbstractLayouter{0} {}
+
+        using AbstractLayouter::setGlyphCount;
+
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(Range2D{{}, Vector2{1.0f, 2.0f}*scale},
+                Range2D{{i*0.25f, 0.0f}, {i*0.25f + 0.25f, 1.0f}},
+                Vector2::xAxis(1.5f*scale));
+        }
+
+        Float scale;
+    };
+
+    FontFeatures doFeatures() const override { return FontFeature::OpenData; }
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override {}
+
+    Metrics doOpenData(const Containers::ArrayView<const char>, Float size) override {
+        _opened = true;
+        return {size, 1.0f, 2.0f, 3.0f};
+    }
+
+    UnsignedInt doGlyphId(char32_t) override { return {}; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+    Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override {
+        return nullptr;
+    }
+    AbstractLayouter& doLayoutInto(const AbstractGlyphCache&, Float size, Containers::ArrayView<const char> text) override {
+        layouter.setGlyphCount(UnsignedInt(text.size()));
+        layouter.scale = size/this->size();
+        return layouter;
+    }
+
+    bool _opened = false;
+    Layouter layouter;
+};
+
+void RenderTest::renderInto() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 0.5f));
+    DummyGlyphCache cache{{100, 100}};
+
+    Vector2 positions[16];
+    Vector2 textureCoordinates[16];
+    const char text[] = "ab\n\nc";
+    const std::pair<UnsignedInt, Range2D> out = Text::renderInto(font, cache, 0.5f, {text, sizeof(text) - 1}, positions, textureCoordinates);
+
+    /* The empty line is skipped, but still advances the line position by
+       the line height */
+    CORRADE_COMPARE(out.first, 3);
+    CORRADE_COMPARE(out.second, (Range2D{{0.0f, -6.0f}, {2.5f, 2.0f}}));
+    CORRADE_COMPARE_AS(Containers::arrayView(positions).prefix(12), Containers::arrayView<Vector2>({
+        {0.0f, 2.0f}, {0.0f, 0.0f}, {1.0f, 2.0f}, {1.0f, 0.0f},
+        {1.5f, 2.0f}, {1.5f, 0.0f}, {2.5f, 2.0f}, {2.5f, 0.0f},
+        {0.0f, -4.0f}, {0.0f, -6.0f}, {1.0f, -4.0f}, {1.0f, -6.0f}
+    }), TestSuite::Compare::Container);
+    /* Texture coordinates come from the layouter, which restarts for each
+       line */
+    CORRADE_COMPARE_AS(Containers::arrayView(textureCoordinates).prefix(12), Containers::arrayView<Vector2>({
+        {0.0f, 1.0f}, {0.0f, 0.0f}, {0.25f, 1.0f}, {0.25f, 0.0f},
+        {0.25f, 1.0f}, {0.25f, 0.0f}, {0.5f, 1.0f}, {0.5f, 0.0f},
+        {0.0f, 1.0f}, {0.0f, 0.0f}, {0.25f, 1.0f}, {0.25f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void RenderTest::renderIntoEmpty() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 0.5f));
+    DummyGlyphCache cache{{100, 100}};
+
+    const std::pair<UnsignedInt, Range2D> out = Text::renderInto(font, cache, 0.5f, nullptr, nullptr, nullptr);
+    CORRADE_COMPARE(out.first, 0);
+    CORRADE_COMPARE(out.second, Range2D{});
+}
+
+void RenderTest::renderIntoAlignment() {
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 0.5f));
+    DummyGlyphCache cache{{100, 100}};
+
+    /* Rendering at twice the font size doubles everything including the
+       line advance */
+    Vector2 positions[12];
+    Vector2 textureCoordinates[12];
+    const char text[] = "ab\nc";
+    const std::pair<UnsignedInt, Range2D> out = Text::renderInto(font, cache, 1.0f, {text, sizeof(text) - 1}, positions, textureCoordinates, Alignment::MiddleCenter);
+
+    /* First line spans {0, 0} to {5, 4}, second line {0, -6} to {2, -2};
+       each is centered horizontally and then everything vertically */
+    CORRADE_COMPARE(out.first, 3);
+    CORRADE_COMPARE(out.second, (Range2D{{-2.5f, -5.0f}, {2.5f, 5.0f}}));
+    CORRADE_COMPARE(positions[0], (Vector2{-2.5f, 5.0f}));
+    CORRADE_COMPARE(positions[7], (Vector2{2.5f, 1.0f}));
+    CORRADE_COMPARE(positions[8], (Vector2{-1.0f, -1.0f}));
+    CORRADE_COMPARE(positions[11], (Vector2{1.0f, -5.0f}));
+}
+
+void RenderTest::renderIntoSizeMismatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    TestFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 0.5f));
+    DummyGlyphCache cache{{100, 100}};
+
+    Vector2 positions[8];
+    Vector2 textureCoordinates[4];
+    std::ostringstream out;
+    Error redirectError{&out};
+    Text::renderInto(font, cache, 1.0f, {"ab", 2}, positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(), "Text::renderInto(): expected position and texture coordinate views to have the same size, got 8 and 4\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::RenderTest)
@@ -35,12 +35,14 @@
 namespace Magnum { namespace Text {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
+class AbstractBatchRenderer;
 class AbstractFont;
 class AbstractFontConverter;
 class AbstractGlyphCache;
 class AbstractLayouter;
 
 enum class Alignment: UnsignedByte;
+class DynamicGlyphCache;
 
 class AbstractGlyphCache;
 #ifdef MAGNUM_TARGET_GL
@@ -50,6 +52,9 @@ class AbstractRenderer;
 template<UnsignedInt> class Renderer;
 typedef Renderer<2> Renderer2D;
 typedef Renderer<3> Renderer3D;
+template<UnsignedInt> class BatchRenderer;
+typedef BatchRenderer<2> BatchRenderer2D;
+typedef BatchRenderer<3> BatchRenderer3D;
 #endif
 #endif
 
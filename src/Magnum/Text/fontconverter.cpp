@@ -23,17 +23,28 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Math/ConfigurationValue.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/AbstractFontConverter.h"
-#include "Magnum/Text/DistanceFieldGlyphCache.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/TextureTools/DistanceTransform.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/Context.h"
+#include "Magnum/Text/DistanceFieldGlyphCache.h"
+
 #ifdef MAGNUM_TARGET_HEADLESS
 #include "Magnum/Platform/WindowlessEglApplication.h"
 #elif defined(CORRADE_TARGET_IOS)
@@ -55,6 +66,7 @@
 #else
 #error no windowless application available on this platform
 #endif
+#endif
 
 namespace Magnum {
 
@@ -84,7 +96,7 @@ See @ref building, @ref cmake and the @ref Text namespace for more information.
 magnum-fontconverter [--magnum-...] [-h|--help] --font FONT
     --converter CONVERTER [--plugin-dir DIR] [--characters CHARACTERS]
     [--font-size N] [--atlas-size "X Y"] [--output-size "X Y"] [--radius N]
-    [--] input output
+    [--cpu] [--threads N] [--] input output
 @endcode
 
 Arguments:
@@ -102,9 +114,23 @@ Arguments:
 -   `--output-size "X Y"` --- output atlas size. If set to zero size, distance
     field computation will not be used. (default: `"256 256"`)
 -   `--radius N` --- distance field computation radius (default: `24`)
+-   `--cpu` --- populate the glyph cache on the CPU even if a GL context is
+    available
+-   `--threads N` --- count of threads to use for the CPU distance field
+    computation. If @cpp 0 @ce, all available hardware threads are used.
+    (default: `0`)
 -   `--magnum-...` --- engine-specific options (see
     @ref GL-Context-command-line for details)
 
+By default, the glyph cache is populated on the GPU using
+@ref Text::DistanceFieldGlyphCache or @ref Text::GlyphCache. If a GL context
+can't be created, for example on a headless machine without a GPU, or if
+`--cpu` is specified, the glyph cache is kept in memory and the distance field
+is calculated using @ref TextureTools::distanceFieldInto() instead, which
+produces the same output. If Magnum is built with @ref MAGNUM_TARGET_GL
+disabled, the CPU implementation is always used and the `--magnum-...`
+options are not available.
+
 The resulting font files can be then used as specified in the documentation of
 `converter` plugin.
 
@@ -123,24 +149,89 @@ documentation, this will generate files `myfont.conf` and `myfont.tga` in
 current directory. You can then load and use them via the
 @ref Text::MagnumFont "MagnumFont" plugin.
 
-@note This executable is available only if Magnum is compiled with
-    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
-    for more information.
 */
 
 namespace Text {
 
-class FontConverter: public Platform::WindowlessApplication {
+namespace {
+
+/* Glyph cache keeping the image in memory, used if there's no GL context. If
+   radius is non-zero, converts the glyphs to a distance field the same way as
+   DistanceFieldGlyphCache does. */
+class ImageGlyphCache: public AbstractGlyphCache {
+    public:
+        explicit ImageGlyphCache(const Vector2i& originalSize, const Vector2i& size, UnsignedInt radius, UnsignedInt threadCount):
+            AbstractGlyphCache{originalSize, Vector2i(radius)},
+            _image{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, size, Containers::Array<char>{Containers::ValueInit, std::size_t(size.product())}},
+            _scale{Vector2(size)/Vector2(originalSize)},
+            _radius{radius}, _threadCount{threadCount} {}
+
+    private:
+        GlyphCacheFeatures doFeatures() const override {
+            return GlyphCacheFeature::ImageDownload;
+        }
+
+        void doSetImage(const Vector2i& offset, const ImageView2D& image) override {
+            const Range2Di rectangle = _radius ?
+                Range2Di::fromSize(offset*_scale, image.size()*_scale) :
+                Range2Di::fromSize(offset, image.size());
+            MutableImageView2D output{
+                PixelStorage{}
+                    .setAlignment(1)
+                    .setRowLength(_image.size().x())
+                    .setSkip({rectangle.min(), 0}),
+                PixelFormat::R8Unorm, rectangle.size(), _image.data()};
+
+            if(_radius)
+                TextureTools::distanceFieldInto(image, output, _radius, _threadCount);
+            else
+                Utility::copy(image.pixels(), output.pixels());
+        }
+
+        Image2D doImage() override {
+            Containers::Array<char> data{Containers::NoInit, _image.data().size()};
+            Utility::copy(Containers::ArrayView<const char>{_image.data()}, data);
+            return Image2D{_image.storage(), _image.format(), _image.size(), std::move(data)};
+        }
+
+        Image2D _image;
+        Vector2 _scale;
+        UnsignedInt _radius, _threadCount;
+};
+
+}
+
+class FontConverter
+    #ifdef MAGNUM_TARGET_GL
+    : public Platform::WindowlessApplication
+    #endif
+{
     public:
+        #ifndef MAGNUM_TARGET_GL
+        /* Subset of what the application classes have */
+        struct Arguments {
+            int argc;
+            char** argv;
+        };
+        #endif
+
         explicit FontConverter(const Arguments& arguments);
 
-        int exec() override;
+        int exec()
+            #ifdef MAGNUM_TARGET_GL
+            override
+            #endif
+            ;
 
     private:
         Utility::Arguments args;
 };
 
-FontConverter::FontConverter(const Arguments& arguments): Platform::WindowlessApplication{arguments, NoCreate} {
+FontConverter::FontConverter(const Arguments& arguments)
+    #ifdef MAGNUM_TARGET_GL
+    : Platform::WindowlessApplication{arguments, NoCreate}
+    #endif
+{
     args.addArgument("input").setHelp("input", "input font")
         .addArgument("output").setHelp("output", "output filename prefix")
         .addNamedArgument("font").setHelp("font", "font plugin")
@@ -153,11 +244,19 @@ FontConverter::FontConverter(const Arguments& arguments): Platform::WindowlessAp
         .addOption("atlas-size", "2048 2048").setHelp("atlas-size", "glyph atlas size", "\"X Y\"")
         .addOption("output-size", "256 256").setHelp("output-size", "output atlas size. If set to zero size, distance field computation will not be used.", "\"X Y\"")
         .addOption("radius", "24").setHelp("radius", "distance field computation radius", "N")
+        .addBooleanOption("cpu").setHelp("cpu", "populate the glyph cache on the CPU even if a GL context is available")
+        .addOption("threads", "0").setHelp("threads", "count of threads to use for the CPU distance field computation, 0 for all available", "N")
+        #ifdef MAGNUM_TARGET_GL
         .addSkippedPrefix("magnum", "engine-specific options")
+        #endif
         .setGlobalHelp("Converts font to raster one of given atlas size.")
         .parse(arguments.argc, arguments.argv);
 
-    createContext();
+    #ifdef MAGNUM_TARGET_GL
+    /* If there's no GPU, the glyph cache is populated on the CPU instead */
+    if(!args.isSet("cpu") && !tryCreateContext({}))
+        Warning{} << "Cannot create a GL context, falling back to the CPU implementation";
+    #endif
 }
 
 int FontConverter::exec() {
@@ -187,20 +286,42 @@ int FontConverter::exec() {
     }
 
     /* Create distance field glyph cache if radius is specified */
-    Containers::Pointer<Text::GlyphCache> cache;
+    Containers::Pointer<Text::AbstractGlyphCache> cache;
     if(!args.value<Vector2i>("output-size").isZero()) {
-        Debug() << "Populating distance field glyph cache...";
-
-        cache.reset(new Text::DistanceFieldGlyphCache(
-            args.value<Vector2i>("atlas-size"),
-            args.value<Vector2i>("output-size"),
-            args.value<Int>("radius")));
+        #ifdef MAGNUM_TARGET_GL
+        if(GL::Context::hasCurrent()) {
+            Debug() << "Populating distance field glyph cache...";
+
+            cache.reset(new Text::DistanceFieldGlyphCache(
+                args.value<Vector2i>("atlas-size"),
+                args.value<Vector2i>("output-size"),
+                args.value<Int>("radius")));
+        } else
+        #endif
+        {
+            Debug() << "Populating distance field glyph cache on the CPU...";
+
+            cache.reset(new ImageGlyphCache(
+                args.value<Vector2i>("atlas-size"),
+                args.value<Vector2i>("output-size"),
+                args.value<UnsignedInt>("radius"),
+                args.value<UnsignedInt>("threads")));
+        }
 
     /* Otherwise use normal cache */
     } else {
         Debug() << "Zero-size distance field output specified, populating normal glyph cache...";
 
-        cache.reset(new Text::GlyphCache(args.value<Vector2i>("atlas-size")));
+        #ifdef MAGNUM_TARGET_GL
+        if(GL::Context::hasCurrent())
+            cache.reset(new Text::GlyphCache(args.value<Vector2i>("atlas-size")));
+        else
+        #endif
+        {
+            cache.reset(new ImageGlyphCache(
+                args.value<Vector2i>("atlas-size"),
+                args.value<Vector2i>("atlas-size"), 0, 0));
+        }
     }
 
     /* Fill the cache */
@@ -223,4 +344,10 @@ int FontConverter::exec() {
 
 }
 
+#ifdef MAGNUM_TARGET_GL
 MAGNUM_WINDOWLESSAPPLICATION_MAIN(Magnum::Text::FontConverter)
+#else
+int main(int argc, char** argv) {
+    return Magnum::Text::FontConverter{{argc, argv}}.exec();
+}
+#endif
@@ -25,36 +25,191 @@
 
 #include "Atlas.h"
 
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Range.h"
 
 namespace Magnum { namespace TextureTools {
 
-std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding) {
-    if(sizes.empty()) return {};
+namespace {
 
-    /* Size of largest texture */
-    Vector2i maxSize;
-    for(const Vector2i& size: sizes)
-        maxSize = Math::max(maxSize, size);
+/* A horizontal segment of the skyline. Segments of a page are sorted by X,
+   cover the whole page width and neighboring segments have a different Y. */
+struct Segment {
+    Int x, y, width;
+};
 
-    std::vector<Range2Di> atlas;
+}
+
+struct AtlasPacker::State {
+    Vector3i size;
+    Vector2i padding;
+    /* Pages are created lazily as they're needed */
+    std::vector<std::vector<Segment>> pages;
+    std::size_t count{};
+    /* Not a float so adding many small rectangles doesn't lose precision */
+    UnsignedLong area{};
+};
+
+AtlasPacker::AtlasPacker(const Vector2i& size, const Vector2i& padding): AtlasPacker{Vector3i{size, 1}, padding} {}
+
+AtlasPacker::AtlasPacker(const Vector3i& size, const Vector2i& padding): _state{Containers::InPlaceInit} {
+    _state->size = size;
+    _state->padding = padding;
+}
+
+AtlasPacker::AtlasPacker(AtlasPacker&&) noexcept = default;
+
+AtlasPacker::~AtlasPacker() = default;
+
+AtlasPacker& AtlasPacker::operator=(AtlasPacker&&) noexcept = default;
+
+Vector3i AtlasPacker::size() const { return _state->size; }
+
+Vector2i AtlasPacker::padding() const { return _state->padding; }
+
+Int AtlasPacker::pageCount() const { return _state->pages.size(); }
+
+std::size_t AtlasPacker::count() const { return _state->count; }
+
+Float AtlasPacker::fillRatio() const {
+    if(_state->pages.empty()) return 0.0f;
+    return Float(Double(_state->area)/(Double(_state->size.xy().product())*_state->pages.size()));
+}
+
+Containers::Optional<Vector3i> AtlasPacker::add(const Vector2i& size) {
+    State& state = *_state;
+    const Vector2i paddedSize = size + 2*state.padding;
+
+    for(Int page = 0; page != state.size.z(); ++page) {
+        /* Open a new page if all previous were full */
+        if(std::size_t(page) == state.pages.size()) {
+            /* If the rectangle doesn't fit into an empty page, it won't fit
+               anywhere. Checking here to avoid opening an empty page. */
+            if((paddedSize > state.size.xy()).any()) return {};
+            state.pages.push_back({Segment{0, 0, state.size.x()}});
+        }
+
+        std::vector<Segment>& skyline = state.pages[page];
+
+        /* Find the segment where the top edge of the rectangle ends up the
+           lowest. In case of a tie the leftmost one is picked. */
+        std::size_t bestIndex = ~std::size_t{};
+        Vector2i bestPosition;
+        Int bestTop = state.size.y() + 1;
+        for(std::size_t i = 0; i != skyline.size(); ++i) {
+            const Int x = skyline[i].x;
+            if(x + paddedSize.x() > state.size.x()) break;
+
+            /* The rectangle rests on the highest of the segments it spans.
+               As the segments cover the whole page width, this won't go
+               past the end. */
+            Int y = skyline[i].y;
+            Int width = skyline[i].width;
+            for(std::size_t j = i + 1; width < paddedSize.x(); ++j) {
+                y = Math::max(y, skyline[j].y);
+                width += skyline[j].width;
+            }
+
+            const Int top = y + paddedSize.y();
+            if(top <= state.size.y() && top < bestTop) {
+                bestIndex = i;
+                bestPosition = {x, y};
+                bestTop = top;
+            }
+        }
 
-    /* Columns and rows */
-    const Vector2i paddedSize = maxSize+2*padding;
-    const Vector2i gridSize = atlasSize/paddedSize;
-    if(std::size_t(gridSize.product()) < sizes.size()) {
+        if(bestIndex == ~std::size_t{}) continue;
+
+        /* Zero-area rectangles don't change the skyline */
+        if(paddedSize.x() && paddedSize.y()) {
+            /* Insert a new segment for the top edge and cut the segments
+               that are now covered by it */
+            skyline.insert(skyline.begin() + bestIndex, Segment{bestPosition.x(), bestTop, paddedSize.x()});
+            const Int right = bestPosition.x() + paddedSize.x();
+            for(std::size_t i = bestIndex + 1; i < skyline.size(); ) {
+                if(skyline[i].x >= right) break;
+
+                const Int overlap = right - skyline[i].x;
+                skyline[i].x += overlap;
+                skyline[i].width -= overlap;
+                if(skyline[i].width > 0) break;
+                skyline.erase(skyline.begin() + i);
+            }
+
+            /* Merge neighboring segments of the same height */
+            for(std::size_t i = 0; i + 1 < skyline.size(); ) {
+                if(skyline[i].y == skyline[i + 1].y) {
+                    skyline[i].width += skyline[i + 1].width;
+                    skyline.erase(skyline.begin() + i + 1);
+                } else ++i;
+            }
+        }
+
+        ++state.count;
+        state.area += UnsignedLong(size.product());
+        return Vector3i{bestPosition + state.padding, page};
+    }
+
+    return {};
+}
+
+bool AtlasPacker::add(const Containers::ArrayView<const Vector2i> sizes, const Containers::ArrayView<Vector3i> offsets) {
+    CORRADE_ASSERT(sizes.size() == offsets.size(),
+        "TextureTools::AtlasPacker::add(): expected" << sizes.size() << "offsets but got" << offsets.size(), {});
+
+    /* Adding the tallest rectangles first results in far less wasted space
+       below the skyline. Stable sort so the result is deterministic across
+       standard library implementations. */
+    Containers::Array<std::size_t> order{Containers::NoInit, sizes.size()};
+    for(std::size_t i = 0; i != order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) {
+        return sizes[a].y() > sizes[b].y() ||
+            (sizes[a].y() == sizes[b].y() && sizes[a].x() > sizes[b].x());
+    });
+
+    /* Save the state so it can be restored if some rectangle doesn't fit */
+    State previous = *_state;
+
+    for(const std::size_t i: order) {
+        Containers::Optional<Vector3i> offset = add(sizes[i]);
+        if(!offset) {
+            *_state = std::move(previous);
+            return false;
+        }
+
+        offsets[i] = *offset;
+    }
+
+    return true;
+}
+
+void AtlasPacker::clear() {
+    _state->pages.clear();
+    _state->count = 0;
+    _state->area = 0;
+}
+
+std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding) {
+    if(sizes.empty()) return {};
+
+    AtlasPacker packer{atlasSize, padding};
+    Containers::Array<Vector3i> offsets{Containers::NoInit, sizes.size()};
+    if(!packer.add(sizes, offsets)) {
         Error() << "TextureTools::atlas(): requested atlas size" << atlasSize
-                << "is too small to fit" << sizes.size() << paddedSize
+                << "is too small to fit" << sizes.size()
                 << "textures. Generated atlas will be empty.";
-        return atlas;
+        return {};
     }
 
-    /** @todo actual magic implementation, not this joke */
-
+    std::vector<Range2Di> atlas;
     atlas.reserve(sizes.size());
     for(std::size_t i = 0; i != sizes.size(); ++i)
-        atlas.push_back(Range2Di::fromSize(Vector2i(i%gridSize.x(), i/gridSize.x())*paddedSize+padding, sizes[i]));
+        atlas.push_back(Range2Di::fromSize(offsets[i].xy(), sizes[i]));
 
     return atlas;
 }
@@ -26,25 +26,178 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::TextureTools::atlas()
+ * @brief Class @ref Magnum::TextureTools::AtlasPacker, function @ref Magnum::TextureTools::atlas()
  */
 
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Magnum.h"
-#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/TextureTools/visibility.h"
 
 namespace Magnum { namespace TextureTools {
 
+/**
+@brief Incremental texture atlas packer
+@m_since_latest
+
+Packs rectangles of arbitrary sizes into a texture atlas using a *skyline*
+algorithm --- the packer keeps track of the top edge of the already placed
+rectangles and puts each new rectangle at the position where its top edge ends
+up the lowest, preferring the leftmost position in case of a tie. Compared to
+a uniform grid, this wastes very little space with rectangles of varying
+sizes, such as font glyphs or sprites.
+
+@section TextureTools-AtlasPacker-usage Usage
+
+Rectangles can be added either one by one using @ref add(const Vector2i&), or
+in batches using @ref add(Containers::ArrayView<const Vector2i>, Containers::ArrayView<Vector3i>).
+The batch variant adds the rectangles in order of decreasing height, which
+results in a significantly better packing than adding them in arbitrary
+order. In both cases, already placed rectangles are never moved, so the atlas
+can be filled incrementally, for example as new glyphs are needed:
+
+@code{.cpp}
+TextureTools::AtlasPacker packer{{1024, 1024}, {1, 1}};
+
+/* Initial batch */
+std::vector<Vector2i> sizes{{12, 18}, {32, 15}, {23, 25}};
+std::vector<Vector3i> offsets(sizes.size());
+if(!packer.add(sizes, offsets)) Fatal{} << "Can't fit the initial batch";
+
+/* Later, adding more */
+Containers::Optional<Vector3i> offset = packer.add({16, 23});
+if(!offset) Error{} << "Atlas is full, fill ratio" << packer.fillRatio();
+@endcode
+
+The returned offsets are three-dimensional, with the Z coordinate being the
+page the rectangle was put to. If constructed with a
+@ref AtlasPacker(const Vector3i&, const Vector2i&) constructor, the packer
+opens a new page every time a rectangle doesn't fit into any of the previous
+pages, which is useful for filling texture arrays. With
+@ref AtlasPacker(const Vector2i&, const Vector2i&), there's just a single
+page and the Z coordinate is always @cpp 0 @ce.
+
+The @ref fillRatio() function reports how much of the used pages is covered
+by the rectangles.
+
+@section TextureTools-AtlasPacker-padding Padding
+
+Padding is added twice to each size and the atlas is laid out so the padding
+doesn't overlap. Returned offsets point to the rectangles without the padding,
+i.e. the padding is in between the offset and the previous rectangle or atlas
+edge.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT AtlasPacker {
+    public:
+        /**
+         * @brief Construct a single-page packer
+         * @param size      Atlas size
+         * @param padding   Padding around each rectangle
+         */
+        explicit AtlasPacker(const Vector2i& size, const Vector2i& padding = {});
+
+        /**
+         * @brief Construct a multi-page packer
+         * @param size      Atlas page size and maximal page count in the Z
+         *      coordinate
+         * @param padding   Padding around each rectangle
+         */
+        explicit AtlasPacker(const Vector3i& size, const Vector2i& padding = {});
+
+        /** @brief Copying is not allowed */
+        AtlasPacker(const AtlasPacker&) = delete;
+
+        /** @brief Move constructor */
+        AtlasPacker(AtlasPacker&&) noexcept;
+
+        ~AtlasPacker();
+
+        /** @brief Copying is not allowed */
+        AtlasPacker& operator=(const AtlasPacker&) = delete;
+
+        /** @brief Move assignment */
+        AtlasPacker& operator=(AtlasPacker&&) noexcept;
+
+        /**
+         * @brief Atlas size
+         *
+         * Page size in the XY coordinates, maximal page count in Z.
+         */
+        Vector3i size() const;
+
+        /** @brief Padding around each rectangle */
+        Vector2i padding() const;
+
+        /**
+         * @brief Count of used pages
+         *
+         * Count of pages that contain at least one rectangle.
+         */
+        Int pageCount() const;
+
+        /** @brief Count of added rectangles */
+        std::size_t count() const;
+
+        /**
+         * @brief Fill ratio
+         *
+         * Area of all added rectangles, excluding padding, divided by the
+         * total area of all used pages. Returns @cpp 0.0f @ce if nothing
+         * was added yet.
+         */
+        Float fillRatio() const;
+
+        /**
+         * @brief Add a rectangle
+         * @return Offset of the rectangle without padding, with the page in
+         *      the Z coordinate, or @ref Containers::NullOpt if the
+         *      rectangle doesn't fit
+         *
+         * If the rectangle doesn't fit, the packer state is not modified.
+         */
+        Containers::Optional<Vector3i> add(const Vector2i& size);
+
+        /**
+         * @brief Add a batch of rectangles
+         * @param[in] sizes     Rectangle sizes
+         * @param[out] offsets  Where to put offsets of the rectangles without
+         *      padding, with the page in the Z coordinate
+         * @return Whether all rectangles fit
+         *
+         * The rectangles are added in the order of decreasing height. Expects
+         * that @p sizes and @p offsets have the same size. If any of the
+         * rectangles doesn't fit, the packer state is not modified, the
+         * contents of @p offsets are unspecified and the function returns
+         * @cpp false @ce.
+         */
+        bool add(Containers::ArrayView<const Vector2i> sizes, Containers::ArrayView<Vector3i> offsets);
+
+        /**
+         * @brief Clear the atlas
+         *
+         * Removes all rectangles, size and padding stays the same.
+         */
+        void clear();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
 /**
 @brief Pack textures into texture atlas
 @param atlasSize    Size of resulting atlas
 @param sizes        Sizes of all textures in the atlas
 @param padding      Padding around each texture
 
-Packs many small textures into one larger. If the textures cannot be packed
-into required size, empty vector is returned.
+Packs many small textures into one larger using @ref AtlasPacker. If the
+textures cannot be packed into required size, empty vector is returned. Use
+@ref AtlasPacker directly to get the @ref AtlasPacker::fillRatio() "fill ratio"
+or to pack incrementally or into multiple pages.
 
 Padding is added twice to each size and the atlas is laid out so the padding
 don't overlap. Returned sizes are the same as original sizes, i.e. without the
@@ -0,0 +1,166 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DistanceTransform.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Implementation/Parallel.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+
+namespace Magnum { namespace TextureTools {
+
+void distanceFieldInto(const ImageView2D& input, const MutableImageView2D& output, const UnsignedInt radius, UnsignedInt threadCount) {
+    CORRADE_ASSERT(input.format() == PixelFormat::R8Unorm || input.format() == PixelFormat::RGB8Unorm || input.format() == PixelFormat::RGBA8Unorm,
+        "TextureTools::distanceFieldInto(): expected input to be" << PixelFormat::R8Unorm << Debug::nospace << "," << PixelFormat::RGB8Unorm << "or" << PixelFormat::RGBA8Unorm << "but got" << input.format(), );
+    CORRADE_ASSERT(output.format() == PixelFormat::R8Unorm,
+        "TextureTools::distanceFieldInto(): expected output to be" << PixelFormat::R8Unorm << "but got" << output.format(), );
+
+    const Vector2i inputSize = input.size();
+    const Vector2i outputSize = output.size();
+    if(!outputSize.product()) return;
+    CORRADE_ASSERT(inputSize.product(),
+        "TextureTools::distanceFieldInto(): expected a non-empty input image", );
+
+    threadCount = Magnum::Implementation::resolveThreadCount(threadCount);
+
+    /* Red channel of the input, transposed so each item is a column */
+    const Containers::StridedArrayView3D<const char> pixels = input.pixels();
+    const Containers::StridedArrayView2D<const UnsignedByte> columns = Containers::arrayCast<2, const UnsignedByte>(pixels.prefix({pixels.size()[0], pixels.size()[1], 1})).transposed<0, 1>();
+    const Containers::StridedArrayView2D<UnsignedByte> outputPixels = output.pixels<UnsignedByte>();
+
+    /* Input rows and columns corresponding to output pixels */
+    Containers::Array<Int> sampledRows{Containers::NoInit, std::size_t(outputSize.y())};
+    for(std::size_t i = 0; i != sampledRows.size(); ++i)
+        sampledRows[i] = Long(i)*inputSize.y()/outputSize.y();
+    Containers::Array<Int> sampledColumns{Containers::NoInit, std::size_t(outputSize.x())};
+    for(std::size_t i = 0; i != sampledColumns.size(); ++i)
+        sampledColumns[i] = Long(i)*inputSize.x()/outputSize.x();
+
+    /* All distances get clamped to radius + 1 at the end, so anything farther
+       than that can be clamped already in the column pass. No actual distance
+       can be larger than the image size, limiting to that avoids overflows
+       with huge radii. */
+    const Int clamp = Int(Math::min(radius, UnsignedInt(inputSize.sum()))) + 1;
+
+    /* For each sampled row, distance to the nearest pixel of an opposite
+       value in the same column, positive for inside pixels and negative for
+       outside pixels. Never zero. */
+    const std::size_t width = inputSize.x();
+    Containers::Array<Int> columnDistances{Containers::NoInit, width*sampledRows.size()};
+    Magnum::Implementation::parallelFor(width, 64, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        Containers::Array<Int> distances{Containers::NoInit, std::size_t(inputSize.y())};
+        for(std::size_t x = begin; x != end; ++x) {
+            const Containers::StridedArrayView1D<const UnsignedByte> column = columns[x];
+
+            /* Nearest pixel of an opposite value above, then below */
+            Int lastInside = -clamp, lastOutside = -clamp;
+            for(Int y = 0; y != inputSize.y(); ++y) {
+                if(column[y] > 127) {
+                    lastInside = y;
+                    distances[y] = Math::min(y - lastOutside, clamp);
+                } else {
+                    lastOutside = y;
+                    distances[y] = -Math::min(y - lastInside, clamp);
+                }
+            }
+            Int nextInside = inputSize.y() - 1 + clamp, nextOutside = nextInside;
+            for(Int y = inputSize.y() - 1; y >= 0; --y) {
+                if(distances[y] > 0) {
+                    nextInside = y;
+                    distances[y] = Math::min(distances[y], nextOutside - y);
+                } else {
+                    nextOutside = y;
+                    distances[y] = Math::max(distances[y], y - nextInside);
+                }
+            }
+
+            for(std::size_t i = 0; i != sampledRows.size(); ++i)
+                columnDistances[i*width + x] = distances[sampledRows[i]];
+        }
+    });
+
+    /* For each sampled row, a lower envelope of parabolas rooted in the
+       squared column distances gives the squared distance to the nearest
+       pixel of an opposite value in the whole image. Calculated separately for
+       distances to inside pixels, used by outside pixels, and for distances to
+       outside pixels, used by inside pixels. */
+    const Float clampSquared = Float(clamp)*Float(clamp);
+    const Float radiusPlusOne = Float(radius) + 1.0f;
+    Magnum::Implementation::parallelFor(sampledRows.size(), 4, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        Containers::Array<Float> f{Containers::NoInit, width};
+        Containers::Array<Int> v{Containers::NoInit, width};
+        Containers::Array<Float> z{Containers::NoInit, width + 1};
+        for(std::size_t i = begin; i != end; ++i) {
+            const Containers::ArrayView<const Int> row = columnDistances.slice(i*width, (i + 1)*width);
+            const Containers::StridedArrayView1D<UnsignedByte> outputRow = outputPixels[i];
+
+            for(const bool toInside: {true, false}) {
+                for(std::size_t x = 0; x != width; ++x)
+                    f[x] = (row[x] > 0) == toInside ? 0.0f : Float(row[x])*Float(row[x]);
+
+                /* Build the envelope. Intersection of parabolas rooted at q
+                   and v[k] is at s, if it's left of where parabola v[k]
+                   starts being the lowest, v[k] isn't part of the envelope. */
+                std::size_t k = 0;
+                v[0] = 0;
+                z[0] = -Constants::inf();
+                z[1] = Constants::inf();
+                for(Int q = 1; q != Int(width); ++q) {
+                    Float s;
+                    while((s = ((f[q] + Float(q)*Float(q)) - (f[v[k]] + Float(v[k])*Float(v[k])))/Float(2*(q - v[k]))) <= z[k])
+                        --k;
+                    ++k;
+                    v[k] = q;
+                    z[k] = s;
+                    z[k + 1] = Constants::inf();
+                }
+
+                /* Evaluate it at sampled columns of the opposite value */
+                k = 0;
+                for(std::size_t j = 0; j != sampledColumns.size(); ++j) {
+                    const Int x = sampledColumns[j];
+                    const bool inside = row[x] > 0;
+                    if(inside == toInside) continue;
+
+                    while(z[k + 1] < Float(x)) ++k;
+                    const Float distanceSquared = Float(x - v[k])*Float(x - v[k]) + f[v[k]];
+
+                    /* Normalized from [-radius - 1, radius + 1] to [0, 1] */
+                    const Float distance = distanceSquared >= clampSquared ? 1.0f : Math::sqrt(distanceSquared)/radiusPlusOne;
+                    outputRow[j] = Math::pack<UnsignedByte>(0.5f + (inside ? 0.5f : -0.5f)*distance);
+                }
+            }
+        }
+    });
+}
+
+}}
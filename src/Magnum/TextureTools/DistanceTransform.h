@@ -0,0 +1,93 @@
+#ifndef Magnum_TextureTools_DistanceTransform_h
+#define Magnum_TextureTools_DistanceTransform_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::distanceFieldInto()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Create a signed distance field on the CPU
+@param input        Input image
+@param output       Output image
+@param radius       Max distance in the input image that is represented in
+    the output
+@param threadCount  Count of threads to use, including the calling thread. If
+    @cpp 0 @ce, @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+A CPU counterpart to @ref DistanceField, usable without a GL context and
+available also in builds with @ref MAGNUM_TARGET_GL disabled. Converts a
+binary black/white image stored in the red channel of @p input to a signed
+distance field of @p output size. Each output pixel corresponds to an input
+pixel at the same relative position, a value of @cpp 0.5 @ce is on the edge,
+values above it are inside and values below it are outside. Distances
+larger than @p radius are clamped to @cpp 1.0 @ce inside and @cpp 0.0 @ce
+outside, which makes the output identical to what @ref DistanceField produces
+for the same input.
+
+Expects that @p input is @ref PixelFormat::R8Unorm,
+@ref PixelFormat::RGB8Unorm or @ref PixelFormat::RGBA8Unorm, with pixels with
+a red channel value above @cpp 0.5 @ce being treated as inside, and that
+@p output is @ref PixelFormat::R8Unorm. Pixels outside of @p input are not
+considered. To render into a part of a larger image, pass a view with
+@ref PixelStorage::setSkip() and @ref PixelStorage::setRowLength() set
+accordingly.
+
+@section TextureTools-distanceFieldInto-algorithm The algorithm
+
+Unlike @ref DistanceField, which for each output pixel searches a square of
+@p radius around the corresponding input pixel and thus has its cost growing
+quadratically with the radius, this function calculates an exact Euclidean
+distance transform in time linear in the input size, independently of the
+radius. First, for each input column, distance to the nearest pixel of an
+opposite value in the same column is calculated in two linear scans. Then,
+for each input row that corresponds to an output row, a lower envelope of
+parabolas rooted in the column distances is built and evaluated at the
+columns that correspond to output pixels. Only the rows that are sampled by
+@p output are stored between the two passes.
+
+The columns and then the rows are split among @p threadCount threads, the
+result is the same regardless of the thread count. On
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", where threads are not generally
+available, @p threadCount is ignored and everything is done on the calling
+thread.
+
+Based on: *Pedro F. Felzenszwalb, Daniel P. Huttenlocher - Distance Transforms
+of Sampled Functions, Theory of Computing, Volume 8, 2012,
+https://doi.org/10.4086/toc.2012.v008a019*
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void distanceFieldInto(const ImageView2D& input, const MutableImageView2D& output, UnsignedInt radius, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
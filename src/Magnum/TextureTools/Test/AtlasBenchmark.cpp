@@ -0,0 +1,122 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/TextureTools/Atlas.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct AtlasBenchmark: TestSuite::Tester {
+    explicit AtlasBenchmark();
+
+    void atlas();
+    void packerAddBatch();
+    void packerAddIncremental();
+    void packerAddBatchMultiPage();
+
+    Containers::Array<Vector2i> _sizes;
+};
+
+enum: std::size_t { Count = 1000 };
+
+AtlasBenchmark::AtlasBenchmark() {
+    addBenchmarks({&AtlasBenchmark::atlas,
+                   &AtlasBenchmark::packerAddBatch,
+                   &AtlasBenchmark::packerAddIncremental,
+                   &AtlasBenchmark::packerAddBatchMultiPage}, 10);
+
+    /* Sizes roughly corresponding to glyphs of a 32px font, generated with a
+       simple LCG so the data are the same everywhere */
+    _sizes = Containers::Array<Vector2i>{Count};
+    UnsignedInt seed = 1;
+    auto random = [&seed]() {
+        seed = (seed*1103515245u + 12345u) & 0x7fffffffu;
+        return Int(seed >> 16);
+    };
+    for(Vector2i& size: _sizes) {
+        size.x() = 4 + random() % 21;
+        size.y() = 8 + random() % 25;
+    }
+}
+
+void AtlasBenchmark::atlas() {
+    const std::vector<Vector2i> sizes(_sizes.begin(), _sizes.end());
+
+    std::vector<Range2Di> atlas;
+    CORRADE_BENCHMARK(1)
+        atlas = TextureTools::atlas({1024, 1024}, sizes, {1, 1});
+
+    CORRADE_COMPARE(atlas.size(), Count);
+}
+
+void AtlasBenchmark::packerAddBatch() {
+    Containers::Array<Vector3i> offsets{Count};
+
+    Float fillRatio{};
+    CORRADE_BENCHMARK(1) {
+        AtlasPacker packer{{640, 640}};
+        CORRADE_VERIFY(packer.add(_sizes, offsets));
+        fillRatio = packer.fillRatio();
+    }
+
+    CORRADE_COMPARE_AS(fillRatio, 0.6f, TestSuite::Compare::Greater);
+}
+
+void AtlasBenchmark::packerAddIncremental() {
+    Float fillRatio{};
+    CORRADE_BENCHMARK(1) {
+        AtlasPacker packer{{640, 640}};
+        for(const Vector2i& size: _sizes)
+            CORRADE_VERIFY(packer.add(size));
+        fillRatio = packer.fillRatio();
+    }
+
+    CORRADE_COMPARE_AS(fillRatio, 0.6f, TestSuite::Compare::Greater);
+}
+
+void AtlasBenchmark::packerAddBatchMultiPage() {
+    Containers::Array<Vector3i> offsets{Count};
+
+    Int pageCount{};
+    Float fillRatio{};
+    CORRADE_BENCHMARK(1) {
+        AtlasPacker packer{Vector3i{256, 256, 16}};
+        CORRADE_VERIFY(packer.add(_sizes, offsets));
+        pageCount = packer.pageCount();
+        fillRatio = packer.fillRatio();
+    }
+
+    CORRADE_COMPARE(pageCount, 5);
+    CORRADE_COMPARE_AS(fillRatio, 0.8f, TestSuite::Compare::Greater);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::AtlasBenchmark)
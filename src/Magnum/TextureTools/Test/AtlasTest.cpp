@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 
@@ -39,13 +40,37 @@ struct AtlasTest: TestSuite::Tester {
     void createPadding();
     void createEmpty();
     void createTooSmall();
+
+    void packerConstruct();
+    void packerConstructMultiPage();
+    void packerConstructMove();
+    void packerAdd();
+    void packerAddPadding();
+    void packerAddZeroSize();
+    void packerAddBatch();
+    void packerAddBatchDoesntFit();
+    void packerAddMultiPage();
+    void packerAddMultiPageTooLarge();
+    void packerClear();
 };
 
 AtlasTest::AtlasTest() {
     addTests({&AtlasTest::create,
               &AtlasTest::createPadding,
               &AtlasTest::createEmpty,
-              &AtlasTest::createTooSmall});
+              &AtlasTest::createTooSmall,
+
+              &AtlasTest::packerConstruct,
+              &AtlasTest::packerConstructMultiPage,
+              &AtlasTest::packerConstructMove,
+              &AtlasTest::packerAdd,
+              &AtlasTest::packerAddPadding,
+              &AtlasTest::packerAddZeroSize,
+              &AtlasTest::packerAddBatch,
+              &AtlasTest::packerAddBatchDoesntFit,
+              &AtlasTest::packerAddMultiPage,
+              &AtlasTest::packerAddMultiPageTooLarge,
+              &AtlasTest::packerClear});
 }
 
 void AtlasTest::create() {
@@ -55,11 +80,12 @@ void AtlasTest::create() {
         {23, 25}
     });
 
+    /* The tallest is placed first, the rest goes next to it */
     CORRADE_COMPARE(atlas.size(), 3);
     CORRADE_COMPARE(atlas, (std::vector<Range2Di>{
-        Range2Di::fromSize({0, 0}, {12, 18}),
-        Range2Di::fromSize({32, 0}, {32, 15}),
-        Range2Di::fromSize({0, 25}, {23, 25})}));
+        Range2Di::fromSize({23, 0}, {12, 18}),
+        Range2Di::fromSize({23, 18}, {32, 15}),
+        Range2Di::fromSize({0, 0}, {23, 25})}));
 }
 
 void AtlasTest::createPadding() {
@@ -71,9 +97,9 @@ void AtlasTest::createPadding() {
 
     CORRADE_COMPARE(atlas.size(), 3);
     CORRADE_COMPARE(atlas, (std::vector<Range2Di>{
-        Range2Di::fromSize({2, 1}, {8, 16}),
-        Range2Di::fromSize({34, 1}, {28, 13}),
-        Range2Di::fromSize({2, 26}, {19, 23})}));
+        Range2Di::fromSize({25, 1}, {8, 16}),
+        Range2Di::fromSize({25, 19}, {28, 13}),
+        Range2Di::fromSize({2, 1}, {19, 23})}));
 }
 
 void AtlasTest::createEmpty() {
@@ -87,11 +113,200 @@ void AtlasTest::createTooSmall() {
 
     std::vector<Range2Di> atlas = TextureTools::atlas({64, 32}, {
         {8, 16},
-        {21, 13},
+        {41, 13},
         {19, 29}
     }, {2, 1});
     CORRADE_VERIFY(atlas.empty());
-    CORRADE_COMPARE(o.str(), "TextureTools::atlas(): requested atlas size Vector(64, 32) is too small to fit 3 Vector(25, 31) textures. Generated atlas will be empty.\n");
+    CORRADE_COMPARE(o.str(), "TextureTools::atlas(): requested atlas size Vector(64, 32) is too small to fit 3 textures. Generated atlas will be empty.\n");
+}
+
+void AtlasTest::packerConstruct() {
+    AtlasPacker packer{{64, 32}, {2, 1}};
+    CORRADE_COMPARE(packer.size(), (Vector3i{64, 32, 1}));
+    CORRADE_COMPARE(packer.padding(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(packer.pageCount(), 0);
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.fillRatio(), 0.0f);
+}
+
+void AtlasTest::packerConstructMultiPage() {
+    AtlasPacker packer{Vector3i{64, 32, 16}};
+    CORRADE_COMPARE(packer.size(), (Vector3i{64, 32, 16}));
+    CORRADE_COMPARE(packer.padding(), Vector2i{});
+    CORRADE_COMPARE(packer.pageCount(), 0);
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.fillRatio(), 0.0f);
+}
+
+void AtlasTest::packerConstructMove() {
+    AtlasPacker a{{64, 32}, {2, 1}};
+    a.add({16, 16});
+
+    AtlasPacker b{std::move(a)};
+    CORRADE_COMPARE(b.size(), (Vector3i{64, 32, 1}));
+    CORRADE_COMPARE(b.count(), 1);
+
+    AtlasPacker c{{16, 16}};
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), (Vector3i{64, 32, 1}));
+    CORRADE_COMPARE(c.count(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<AtlasPacker>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<AtlasPacker>::value);
+}
+
+void AtlasTest::packerAdd() {
+    AtlasPacker packer{{64, 64}};
+
+    Containers::Optional<Vector3i> offset1 = packer.add({32, 32});
+    CORRADE_VERIFY(offset1);
+    CORRADE_COMPARE(*offset1, (Vector3i{0, 0, 0}));
+    /* Goes to the right of the first, as that's lower */
+    Containers::Optional<Vector3i> offset2 = packer.add({32, 16});
+    CORRADE_VERIFY(offset2);
+    CORRADE_COMPARE(*offset2, (Vector3i{32, 0, 0}));
+    Containers::Optional<Vector3i> offset3 = packer.add({32, 16});
+    CORRADE_VERIFY(offset3);
+    CORRADE_COMPARE(*offset3, (Vector3i{32, 16, 0}));
+    /* The skyline is flat now, goes on top of everything */
+    Containers::Optional<Vector3i> offset4 = packer.add({64, 32});
+    CORRADE_VERIFY(offset4);
+    CORRADE_COMPARE(*offset4, (Vector3i{0, 32, 0}));
+    CORRADE_COMPARE(packer.pageCount(), 1);
+    CORRADE_COMPARE(packer.count(), 4);
+    CORRADE_COMPARE(packer.fillRatio(), 1.0f);
+
+    /* Full, doesn't open a new page */
+    CORRADE_VERIFY(!packer.add({1, 1}));
+    CORRADE_COMPARE(packer.pageCount(), 1);
+    CORRADE_COMPARE(packer.count(), 4);
+}
+
+void AtlasTest::packerAddPadding() {
+    AtlasPacker packer{{64, 64}, {2, 1}};
+
+    Containers::Optional<Vector3i> offset1 = packer.add({8, 16});
+    CORRADE_VERIFY(offset1);
+    CORRADE_COMPARE(*offset1, (Vector3i{2, 1, 0}));
+    Containers::Optional<Vector3i> offset2 = packer.add({8, 16});
+    CORRADE_VERIFY(offset2);
+    CORRADE_COMPARE(*offset2, (Vector3i{14, 1, 0}));
+    /* Fill ratio doesn't include the padding */
+    CORRADE_COMPARE(packer.fillRatio(), 256.0f/4096.0f);
+
+    /* Doesn't fit with the padding */
+    CORRADE_VERIFY(!packer.add({62, 8}));
+    CORRADE_COMPARE(packer.count(), 2);
+}
+
+void AtlasTest::packerAddZeroSize() {
+    AtlasPacker packer{{64, 64}};
+
+    Containers::Optional<Vector3i> offset1 = packer.add({});
+    CORRADE_VERIFY(offset1);
+    CORRADE_COMPARE(*offset1, (Vector3i{0, 0, 0}));
+    CORRADE_COMPARE(packer.count(), 1);
+
+    /* Doesn't take any space */
+    Containers::Optional<Vector3i> offset2 = packer.add({64, 64});
+    CORRADE_VERIFY(offset2);
+    CORRADE_COMPARE(*offset2, (Vector3i{0, 0, 0}));
+}
+
+void AtlasTest::packerAddBatch() {
+    AtlasPacker packer{{64, 64}};
+
+    const Vector2i sizes[]{
+        {12, 18},
+        {32, 15},
+        {23, 25}
+    };
+    Vector3i offsets[3];
+    CORRADE_VERIFY(packer.add(sizes, offsets));
+
+    /* Same as in create() */
+    CORRADE_COMPARE(offsets[0], (Vector3i{23, 0, 0}));
+    CORRADE_COMPARE(offsets[1], (Vector3i{23, 18, 0}));
+    CORRADE_COMPARE(offsets[2], (Vector3i{0, 0, 0}));
+    CORRADE_COMPARE(packer.count(), 3);
+    CORRADE_COMPARE(packer.fillRatio(), 1271.0f/4096.0f);
+
+    /* Adding more later doesn't overlap the previous */
+    Containers::Optional<Vector3i> offset = packer.add({29, 10});
+    CORRADE_VERIFY(offset);
+    CORRADE_COMPARE(*offset, (Vector3i{0, 33, 0}));
+}
+
+void AtlasTest::packerAddBatchDoesntFit() {
+    AtlasPacker packer{{64, 64}};
+    Containers::Optional<Vector3i> offset1 = packer.add({32, 32});
+    CORRADE_VERIFY(offset1);
+    CORRADE_COMPARE(*offset1, (Vector3i{0, 0, 0}));
+
+    /* The first one fits, the second not */
+    const Vector2i sizes[]{
+        {32, 32},
+        {40, 40}
+    };
+    Vector3i offsets[2];
+    CORRADE_VERIFY(!packer.add(sizes, offsets));
+    CORRADE_COMPARE(packer.count(), 1);
+
+    /* The state is restored to what was before */
+    Containers::Optional<Vector3i> offset2 = packer.add({32, 32});
+    CORRADE_VERIFY(offset2);
+    CORRADE_COMPARE(*offset2, (Vector3i{32, 0, 0}));
+}
+
+void AtlasTest::packerAddMultiPage() {
+    AtlasPacker packer{Vector3i{32, 32, 3}};
+
+    const Vector2i sizes[]{
+        {32, 32},
+        {32, 16},
+        {32, 32}
+    };
+    Vector3i offsets[3];
+    CORRADE_VERIFY(packer.add(sizes, offsets));
+    CORRADE_COMPARE(offsets[0], (Vector3i{0, 0, 0}));
+    CORRADE_COMPARE(offsets[1], (Vector3i{0, 0, 2}));
+    CORRADE_COMPARE(offsets[2], (Vector3i{0, 0, 1}));
+    CORRADE_COMPARE(packer.pageCount(), 3);
+    CORRADE_COMPARE(packer.fillRatio(), 2560.0f/3072.0f);
+
+    /* Goes to the last page that still has space */
+    Containers::Optional<Vector3i> offset = packer.add({16, 16});
+    CORRADE_VERIFY(offset);
+    CORRADE_COMPARE(*offset, (Vector3i{0, 16, 2}));
+
+    /* All pages full */
+    CORRADE_VERIFY(!packer.add({32, 32}));
+    CORRADE_COMPARE(packer.pageCount(), 3);
+}
+
+void AtlasTest::packerAddMultiPageTooLarge() {
+    AtlasPacker packer{Vector3i{32, 32, 3}};
+
+    /* Doesn't fit even an empty page, so no page gets opened */
+    CORRADE_VERIFY(!packer.add({33, 1}));
+    CORRADE_COMPARE(packer.pageCount(), 0);
+}
+
+void AtlasTest::packerClear() {
+    AtlasPacker packer{Vector3i{32, 32, 3}, {1, 1}};
+    packer.add({30, 30});
+    packer.add({30, 30});
+    CORRADE_COMPARE(packer.pageCount(), 2);
+
+    packer.clear();
+    CORRADE_COMPARE(packer.size(), (Vector3i{32, 32, 3}));
+    CORRADE_COMPARE(packer.padding(), (Vector2i{1, 1}));
+    CORRADE_COMPARE(packer.pageCount(), 0);
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.fillRatio(), 0.0f);
+    Containers::Optional<Vector3i> offset = packer.add({30, 30});
+    CORRADE_VERIFY(offset);
+    CORRADE_COMPARE(*offset, (Vector3i{1, 1, 0}));
 }
 
 }}}}
@@ -0,0 +1,326 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/TextureTools/DistanceTransform.h"
+
+#include "configure.h"
+
+#ifdef WITH_TRADE
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#endif
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct DistanceTransformTest: TestSuite::Tester {
+    explicit DistanceTransformTest();
+
+    void test();
+    void reference();
+    void rgbaInput();
+    void outputSubRectangle();
+    void emptyOutput();
+    #ifdef WITH_TRADE
+    void groundTruth();
+    #endif
+
+    void benchmark();
+
+    #ifdef WITH_TRADE
+    private:
+        PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
+        std::string _testDir;
+    #endif
+};
+
+const struct {
+    const char* name;
+    Vector2i inputSize, outputSize;
+    UnsignedInt radius, threadCount;
+} ReferenceData[]{
+    {"same size", {37, 23}, {37, 23}, 4, 1},
+    {"downsampled", {64, 48}, {16, 12}, 8, 1},
+    {"downsampled with a non-integer ratio", {61, 47}, {13, 11}, 8, 1},
+    {"upsampled", {10, 8}, {25, 20}, 3, 1},
+    {"zero radius", {37, 23}, {37, 23}, 0, 1},
+    {"radius larger than the image", {37, 23}, {37, 23}, 100000, 1},
+    {"multiple threads", {200, 150}, {50, 30}, 16, 4},
+    {"more threads than rows", {40, 30}, {10, 3}, 16, 8}
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} BenchmarkData[]{
+    {"single thread", 1},
+    {"all threads", 0}
+};
+
+DistanceTransformTest::DistanceTransformTest() {
+    addTests({&DistanceTransformTest::test});
+
+    addInstancedTests({&DistanceTransformTest::reference},
+        Containers::arraySize(ReferenceData));
+
+    addTests({&DistanceTransformTest::rgbaInput,
+              &DistanceTransformTest::outputSubRectangle,
+              &DistanceTransformTest::emptyOutput});
+
+    #ifdef WITH_TRADE
+    addTests({&DistanceTransformTest::groundTruth});
+    #endif
+
+    addInstancedBenchmarks({&DistanceTransformTest::benchmark}, 10,
+        Containers::arraySize(BenchmarkData));
+
+    #ifdef WITH_TRADE
+    /* Load the plugin directly from the build tree. Otherwise it's either
+       static and already loaded or not present in the build tree */
+    #ifdef TGAIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    #ifdef CORRADE_TARGET_APPLE
+    if(Utility::Directory::isSandboxed()
+        #if defined(CORRADE_TARGET_IOS) && defined(CORRADE_TESTSUITE_TARGET_XCTEST)
+        /** @todo Fix this once I persuade CMake to run XCTest tests properly */
+        && std::getenv("SIMULATOR_UDID")
+        #endif
+    ) {
+        _testDir = Utility::Directory::join(Utility::Directory::path(Utility::Directory::executableLocation()), "DistanceFieldGLTestFiles");
+    } else
+    #endif
+    {
+        _testDir = DISTANCEFIELDGLTEST_FILES_DIR;
+    }
+    #endif
+}
+
+/* Discs of varying sizes with some noise, deterministic */
+Containers::Array<UnsignedByte> generateInput(const Vector2i& size) {
+    Containers::Array<UnsignedByte> out{Containers::ValueInit, std::size_t(size.product())};
+    UnsignedInt seed = 1;
+    auto random = [&seed]() {
+        seed = seed*1103515245u + 12345u;
+        return (seed >> 16) & 0x7fff;
+    };
+
+    for(Int i = 0; i != 8; ++i) {
+        const Vector2i center{Int(random()%size.x()), Int(random()%size.y())};
+        const Int radius = 1 + Int(random()%(size.min()/4 + 1));
+        for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x)
+            if((Vector2i{x, y} - center).dot() <= radius*radius)
+                out[y*size.x() + x] = 255;
+    }
+
+    for(Int i = 0; i != size.product()/50; ++i)
+        out[random()%out.size()] ^= 0xff;
+
+    return out;
+}
+
+/* Does the same as the GL implementation -- searches the whole image for the
+   nearest pixel of an opposite value */
+Containers::Array<UnsignedByte> bruteForce(const Containers::StridedArrayView2D<const UnsignedByte>& input, const Vector2i& outputSize, const UnsignedInt radius) {
+    const Vector2i inputSize{Int(input.size()[1]), Int(input.size()[0])};
+    Containers::Array<UnsignedByte> out{Containers::NoInit, std::size_t(outputSize.product())};
+    for(Int oy = 0; oy != outputSize.y(); ++oy) {
+        for(Int ox = 0; ox != outputSize.x(); ++ox) {
+            const Vector2i position{Int(Long(ox)*inputSize.x()/outputSize.x()),
+                                    Int(Long(oy)*inputSize.y()/outputSize.y())};
+            const bool inside = input[position.y()][position.x()] > 127;
+
+            const Float radiusPlusOne = Float(radius) + 1.0f;
+            Float minDistanceSquared = radiusPlusOne*radiusPlusOne;
+            for(Int y = 0; y != inputSize.y(); ++y) for(Int x = 0; x != inputSize.x(); ++x) {
+                if((input[y][x] > 127) == inside) continue;
+                minDistanceSquared = Math::min(minDistanceSquared, Float((Vector2i{x, y} - position).dot()));
+            }
+
+            out[oy*outputSize.x() + ox] = Math::pack<UnsignedByte>(0.5f + (inside ? 0.5f : -0.5f)*(Math::sqrt(minDistanceSquared)/radiusPlusOne));
+        }
+    }
+
+    return out;
+}
+
+void DistanceTransformTest::test() {
+    const UnsignedByte input[]{
+        0, 0, 255, 255, 0, 0,
+        0, 255, 255, 255, 255, 0
+    };
+    UnsignedByte output[6*2];
+
+    PixelStorage storage;
+    storage.setAlignment(1);
+    distanceFieldInto(
+        ImageView2D{storage, PixelFormat::R8Unorm, {6, 2}, input},
+        MutableImageView2D{storage, PixelFormat::R8Unorm, {6, 2}, output}, 3);
+
+    /* Signed distances normalized from [-4, 4] to [0, 255] */
+    CORRADE_COMPARE_AS(Containers::arrayView(output), Containers::arrayView<UnsignedByte>({
+        /* -sqrt(2), -1, 1, 1, -1, -sqrt(2) */
+        82, 96, 159, 159, 96, 82,
+        /* -1, 1, sqrt(2), sqrt(2), 1, -1 */
+        96, 159, 173, 173, 159, 96
+    }), TestSuite::Compare::Container);
+}
+
+void DistanceTransformTest::reference() {
+    auto&& data = ReferenceData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<UnsignedByte> input = generateInput(data.inputSize);
+    Containers::Array<UnsignedByte> output{Containers::NoInit, std::size_t(data.outputSize.product())};
+
+    /* Alignment of 1 so the data can be compared directly */
+    PixelStorage storage;
+    storage.setAlignment(1);
+    ImageView2D inputImage{storage, PixelFormat::R8Unorm, data.inputSize, input};
+    distanceFieldInto(inputImage,
+        MutableImageView2D{storage, PixelFormat::R8Unorm, data.outputSize, output}, data.radius, data.threadCount);
+
+    CORRADE_COMPARE_AS(output,
+        bruteForce(inputImage.pixels<UnsignedByte>(), data.outputSize, data.radius),
+        TestSuite::Compare::Container);
+}
+
+void DistanceTransformTest::rgbaInput() {
+    /* Only the red channel should be taken into account */
+    const Color4ub input[]{
+        0x000000ff_rgba, 0x00ffffff_rgba, 0x00ffffff_rgba, 0x000000ff_rgba,
+        0x00ff00ff_rgba, 0xff0000ff_rgba, 0xff00ffff_rgba, 0x0000ffff_rgba,
+        0x00000000_rgba, 0x00ff0000_rgba, 0x00ffff00_rgba, 0x0000ff00_rgba
+    };
+    UnsignedByte output[4*3];
+
+    distanceFieldInto(
+        ImageView2D{PixelFormat::RGBA8Unorm, {4, 3}, input},
+        MutableImageView2D{PixelFormat::R8Unorm, {4, 3}, output}, 1);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(output), Containers::arrayView<UnsignedByte>({
+        37, 64, 64, 37,
+        64, 191, 191, 64,
+        37, 64, 64, 37
+    }), TestSuite::Compare::Container);
+}
+
+void DistanceTransformTest::outputSubRectangle() {
+    const UnsignedByte input[]{
+        0, 0, 0, 0,
+        0, 255, 255, 0,
+        0, 0, 0, 0
+    };
+    UnsignedByte output[]{
+        0xcc, 0xcc, 0xcc, 0xcc,
+        0xcc, 0xcc, 0xcc, 0xcc,
+        0xcc, 0xcc, 0xcc, 0xcc
+    };
+
+    /* Downsampled into a 2x1 rectangle at (1, 1) */
+    distanceFieldInto(
+        ImageView2D{PixelFormat::R8Unorm, {4, 3}, input},
+        MutableImageView2D{PixelStorage{}.setSkip({1, 1, 0}).setRowLength(4), PixelFormat::R8Unorm, {2, 1}, output}, 1);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(output), Containers::arrayView<UnsignedByte>({
+        0xcc, 0xcc, 0xcc, 0xcc,
+        0xcc, 37, 64, 0xcc,
+        0xcc, 0xcc, 0xcc, 0xcc
+    }), TestSuite::Compare::Container);
+}
+
+void DistanceTransformTest::emptyOutput() {
+    const UnsignedByte input[4]{};
+
+    /* Shouldn't crash or do anything */
+    distanceFieldInto(
+        ImageView2D{PixelFormat::R8Unorm, {4, 1}, input},
+        MutableImageView2D{PixelFormat::R8Unorm, {0, 3}, nullptr}, 1);
+    CORRADE_VERIFY(true);
+}
+
+#ifdef WITH_TRADE
+void DistanceTransformTest::groundTruth() {
+    /* Same input, output size and radius as in DistanceFieldGLTest::test(),
+       the result should be the same as the GL implementation output, without
+       any tolerance */
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    if(!(importer = _manager.loadAndInstantiate("TgaImporter")))
+        CORRADE_SKIP("TgaImporter plugin not found.");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(_testDir, "input.tga")));
+    Containers::Optional<Trade::ImageData2D> input = importer->image2D(0);
+    CORRADE_VERIFY(input);
+    CORRADE_COMPARE(input->format(), PixelFormat::R8Unorm);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(_testDir, "output.tga")));
+    Containers::Optional<Trade::ImageData2D> expected = importer->image2D(0);
+    CORRADE_VERIFY(expected);
+    CORRADE_COMPARE(expected->format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(expected->size(), Vector2i{64});
+
+    /* With a row length of 64 there's no padding in either image */
+    UnsignedByte output[64*64];
+    distanceFieldInto(*input,
+        MutableImageView2D{PixelFormat::R8Unorm, Vector2i{64}, output}, 32);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(output),
+        Containers::arrayCast<const UnsignedByte>(expected->data()),
+        TestSuite::Compare::Container);
+}
+#endif
+
+void DistanceTransformTest::benchmark() {
+    auto&& data = BenchmarkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Similar to what magnum-fontconverter does with default options */
+    const Vector2i inputSize{2048};
+    Containers::Array<UnsignedByte> input = generateInput(inputSize);
+    Containers::Array<UnsignedByte> output{Containers::NoInit, 256*256};
+
+    CORRADE_BENCHMARK(1)
+        distanceFieldInto(
+            ImageView2D{PixelFormat::R8Unorm, inputSize, input},
+            MutableImageView2D{PixelFormat::R8Unorm, {256, 256}, output}, 24, data.threadCount);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::DistanceTransformTest)
@@ -26,3 +26,4 @@
 #cmakedefine ANYIMAGEIMPORTER_PLUGIN_FILENAME "${ANYIMAGEIMPORTER_PLUGIN_FILENAME}"
 #cmakedefine TGAIMPORTER_PLUGIN_FILENAME "${TGAIMPORTER_PLUGIN_FILENAME}"
 #define DISTANCEFIELDGLTEST_FILES_DIR "${DISTANCEFIELDGLTEST_FILES_DIR}"
+#cmakedefine WITH_TRADE
@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -34,13 +35,17 @@
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/ConfigurationValue.h"
 #include "Magnum/Math/Range.h"
+#include "Magnum/TextureTools/DistanceTransform.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/Context.h"
 #include "Magnum/GL/Renderer.h"
 #include "Magnum/GL/Texture.h"
 #include "Magnum/GL/TextureFormat.h"
 #include "Magnum/TextureTools/DistanceField.h"
-#include "Magnum/Trade/AbstractImporter.h"
-#include "Magnum/Trade/AbstractImageConverter.h"
-#include "Magnum/Trade/ImageData.h"
 
 #ifdef MAGNUM_TARGET_HEADLESS
 #include "Magnum/Platform/WindowlessEglApplication.h"
@@ -63,6 +68,7 @@
 #else
 #error no windowless application available on this platform
 #endif
+#endif
 
 namespace Magnum {
 
@@ -92,7 +98,7 @@ information.
 @code{.sh}
 magnum-distancefieldconverter [--magnum-...] [-h|--help] [--importer IMPORTER]
     [--converter CONVERTER] [--plugin-dir DIR] --output-size "X Y" --radius N
-    [--] input output
+    [--cpu] [--threads N] [--] input output
 @endcode
 
 Arguments:
@@ -107,9 +113,21 @@ Arguments:
 -   `--plugin-dir DIR` --- override base plugin dir
 -   `--output-size "X Y"` --- size of output image
 -   `--radius N` --- distance field computation radius
+-   `--cpu` --- calculate the distance field on the CPU even if a GL context
+    is available
+-   `--threads N` --- count of threads to use for the CPU calculation. If
+    @cpp 0 @ce, all available hardware threads are used. (default: `0`)
 -   `--magnum-...` --- engine-specific options (see
     @ref GL-Context-command-line for details)
 
+By default, the distance field is calculated on the GPU using
+@ref TextureTools::DistanceField. If a GL context can't be created, for
+example on a headless machine without a GPU, or if `--cpu` is specified, the
+utility falls back to @ref TextureTools::distanceFieldInto(), which produces
+the same output. If Magnum is built with @ref MAGNUM_TARGET_GL disabled, the
+CPU implementation is always used and the `--magnum-...` options are not
+available.
+
 Images with @ref PixelFormat::R8Unorm, @ref PixelFormat::RGB8Unorm or
 @ref PixelFormat::RGBA8Unorm are accepted on input.
 
@@ -127,24 +145,41 @@ This will open monochrome `logo-src.png` image using any plugin that can open
 PNG files and converts it to 256x256 distance field `logo.png` using any plugin
 that can write PNG files.
 
-@note This executable is available only if Magnum is compiled with
-    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
-    for more information.
 */
 
 namespace TextureTools {
 
-class DistanceFieldConverter: public Platform::WindowlessApplication {
+class DistanceFieldConverter
+    #ifdef MAGNUM_TARGET_GL
+    : public Platform::WindowlessApplication
+    #endif
+{
     public:
+        #ifndef MAGNUM_TARGET_GL
+        /* Subset of what the application classes have */
+        struct Arguments {
+            int argc;
+            char** argv;
+        };
+        #endif
+
         explicit DistanceFieldConverter(const Arguments& arguments);
 
-        int exec() override;
+        int exec()
+            #ifdef MAGNUM_TARGET_GL
+            override
+            #endif
+            ;
 
     private:
         Utility::Arguments args;
 };
 
-DistanceFieldConverter::DistanceFieldConverter(const Arguments& arguments): Platform::WindowlessApplication{arguments, NoCreate} {
+DistanceFieldConverter::DistanceFieldConverter(const Arguments& arguments)
+    #ifdef MAGNUM_TARGET_GL
+    : Platform::WindowlessApplication{arguments, NoCreate}
+    #endif
+{
     args.addArgument("input").setHelp("input", "input image")
         .addArgument("output").setHelp("output", "output image")
         .addOption("importer", "AnyImageImporter").setHelp("importer", "image importer plugin")
@@ -152,11 +187,19 @@ DistanceFieldConverter::DistanceFieldConverter(const Arguments& arguments): Plat
         .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
         .addNamedArgument("output-size").setHelp("output-size", "size of output image", "\"X Y\"")
         .addNamedArgument("radius").setHelp("radius", "distance field computation radius", "N")
+        .addBooleanOption("cpu").setHelp("cpu", "calculate the distance field on the CPU even if a GL context is available")
+        .addOption("threads", "0").setHelp("threads", "count of threads to use for the CPU calculation, 0 for all available", "N")
+        #ifdef MAGNUM_TARGET_GL
         .addSkippedPrefix("magnum", "engine-specific options")
+        #endif
         .setGlobalHelp("Converts red channel of an image to distance field representation.")
         .parse(arguments.argc, arguments.argv);
 
-    createContext();
+    #ifdef MAGNUM_TARGET_GL
+    /* If there's no GPU, the CPU implementation is used instead */
+    if(!args.isSet("cpu") && !tryCreateContext({}))
+        Warning{} << "Cannot create a GL context, falling back to the CPU implementation";
+    #endif
 }
 
 int DistanceFieldConverter::exec() {
@@ -181,41 +224,62 @@ int DistanceFieldConverter::exec() {
         return 3;
     }
 
-    /* Decide about internal format */
-    GL::TextureFormat internalFormat;
-    if(image->format() == PixelFormat::R8Unorm)
-        internalFormat = GL::TextureFormat::R8;
-    else if(image->format() == PixelFormat::RGB8Unorm)
-        internalFormat = GL::TextureFormat::RGB8;
-    else if(image->format() == PixelFormat::RGBA8Unorm)
-        internalFormat = GL::TextureFormat::RGBA8;
-    else {
+    /* Check the format */
+    if(image->format() != PixelFormat::R8Unorm &&
+       image->format() != PixelFormat::RGB8Unorm &&
+       image->format() != PixelFormat::RGBA8Unorm) {
         Error() << "Unsupported image format" << image->format();
         return 4;
     }
 
-    /* Input texture */
-    GL::Texture2D input;
-    input.setMinificationFilter(SamplerFilter::Linear)
-        .setMagnificationFilter(SamplerFilter::Linear)
-        .setWrapping(SamplerWrapping::ClampToEdge)
-        .setStorage(1, internalFormat, image->size())
-        .setSubImage(0, {}, *image);
-
-    /* Output texture */
-    GL::Texture2D output;
-    output.setStorage(1, GL::TextureFormat::R8, args.value<Vector2i>("output-size"));
-
-    CORRADE_INTERNAL_ASSERT(GL::Renderer::error() == GL::Renderer::Error::NoError);
-
-    /* Do it */
-    Debug() << "Converting image of size" << image->size() << "to distance field...";
-    TextureTools::DistanceField{args.value<UnsignedInt>("radius")}(input, output, {{}, args.value<Vector2i>("output-size")}, image->size());
+    const Vector2i outputSize = args.value<Vector2i>("output-size");
+    const UnsignedInt radius = args.value<UnsignedInt>("radius");
+    Containers::Optional<Image2D> result;
+
+    /* Do it on the GPU, if there's a context */
+    #ifdef MAGNUM_TARGET_GL
+    if(GL::Context::hasCurrent()) {
+        /* Decide about internal format */
+        GL::TextureFormat internalFormat;
+        if(image->format() == PixelFormat::R8Unorm)
+            internalFormat = GL::TextureFormat::R8;
+        else if(image->format() == PixelFormat::RGB8Unorm)
+            internalFormat = GL::TextureFormat::RGB8;
+        else
+            internalFormat = GL::TextureFormat::RGBA8;
+
+        /* Input texture */
+        GL::Texture2D input;
+        input.setMinificationFilter(SamplerFilter::Linear)
+            .setMagnificationFilter(SamplerFilter::Linear)
+            .setWrapping(SamplerWrapping::ClampToEdge)
+            .setStorage(1, internalFormat, image->size())
+            .setSubImage(0, {}, *image);
+
+        /* Output texture */
+        GL::Texture2D output;
+        output.setStorage(1, GL::TextureFormat::R8, outputSize);
+
+        CORRADE_INTERNAL_ASSERT(GL::Renderer::error() == GL::Renderer::Error::NoError);
+
+        Debug() << "Converting image of size" << image->size() << "to distance field...";
+        TextureTools::DistanceField{radius}(input, output, {{}, outputSize}, image->size());
+
+        result = Image2D{PixelFormat::R8Unorm};
+        output.image(0, *result);
+    } else
+    #endif
+
+    /* Otherwise on the CPU */
+    {
+        result = Image2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, outputSize, Containers::Array<char>{Containers::NoInit, std::size_t(outputSize.product())}};
+
+        Debug() << "Converting image of size" << image->size() << "to distance field on the CPU...";
+        TextureTools::distanceFieldInto(*image, *result, radius, args.value<UnsignedInt>("threads"));
+    }
 
     /* Save image */
-    Image2D result{PixelFormat::R8Unorm};
-    output.image(0, result);
-    if(!converter->exportToFile(result, args.value("output"))) {
+    if(!converter->exportToFile(*result, args.value("output"))) {
         Error() << "Cannot save file" << args.value("output");
         return 5;
     }
@@ -225,4 +289,10 @@ int DistanceFieldConverter::exec() {
 
 }}
 
+#ifdef MAGNUM_TARGET_GL
 MAGNUM_WINDOWLESSAPPLICATION_MAIN(Magnum::TextureTools::DistanceFieldConverter)
+#else
+int main(int argc, char** argv) {
+    return Magnum::TextureTools::DistanceFieldConverter{{argc, argv}}.exec();
+}
+#endif
@@ -0,0 +1,179 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Tracer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Implementation/ThreadBuffers.h"
+
+namespace Magnum {
+
+namespace {
+
+struct Event {
+    const char* name;
+    /* Nanoseconds since the tracer construction */
+    UnsignedLong begin, end;
+};
+
+std::atomic<Tracer*> currentTracer{nullptr};
+
+void appendJsonString(std::string& out, const char* string) {
+    out += '"';
+    for(const char* c = string; *c; ++c) {
+        if(*c == '"' || *c == '\\') {
+            out += '\\';
+            out += *c;
+        } else if(UnsignedByte(*c) < 0x20) out += ' ';
+        else out += *c;
+    }
+    out += '"';
+}
+
+}
+
+/* Written only by the owning thread, the size is published with a release
+   store so the events below it can be read from any other thread */
+struct Tracer::ThreadBuffer {
+    explicit ThreadBuffer(std::size_t capacity): events{Containers::NoInit, capacity} {}
+
+    Containers::Array<Event> events;
+    std::atomic<std::size_t> size{0};
+};
+
+struct Tracer::State {
+    explicit State(std::size_t capacity): capacity{capacity}, start{std::chrono::steady_clock::now()} {}
+
+    std::size_t capacity;
+    std::chrono::steady_clock::time_point start;
+    std::atomic<std::size_t> droppedCount{0};
+    Implementation::ThreadBuffers<ThreadBuffer> buffers;
+};
+
+Tracer* Tracer::current() {
+    return currentTracer.load(std::memory_order_acquire);
+}
+
+Tracer::Tracer(const std::size_t capacityPerThread): _state{Containers::InPlaceInit, capacityPerThread} {
+    CORRADE_ASSERT(capacityPerThread,
+        "Tracer: expected non-zero capacity per thread", );
+
+    Tracer* expected = nullptr;
+    const bool madeCurrent = currentTracer.compare_exchange_strong(expected, this, std::memory_order_acq_rel);
+    CORRADE_ASSERT(madeCurrent,
+        "Tracer: another instance is already active", );
+    static_cast<void>(madeCurrent);
+}
+
+Tracer::~Tracer() {
+    Tracer* expected = this;
+    currentTracer.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+}
+
+std::size_t Tracer::capacityPerThread() const {
+    return _state->capacity;
+}
+
+UnsignedInt Tracer::threadCount() const {
+    return _state->buffers.size();
+}
+
+std::size_t Tracer::zoneCount() const {
+    std::size_t count = 0;
+    _state->buffers.forEach([&count](const ThreadBuffer& buffer, std::size_t) {
+        count += buffer.size.load(std::memory_order_acquire);
+    });
+    return count;
+}
+
+std::size_t Tracer::droppedCount() const {
+    return _state->droppedCount.load(std::memory_order_relaxed);
+}
+
+Tracer::ThreadBuffer& Tracer::threadBuffer() {
+    return _state->buffers.get("Tracer::Zone:", _state->capacity);
+}
+
+void Tracer::record(const char* const name, const std::chrono::steady_clock::time_point begin, const std::chrono::steady_clock::time_point end) {
+    ThreadBuffer& buffer = threadBuffer();
+    const std::size_t size = buffer.size.load(std::memory_order_relaxed);
+    if(size == buffer.events.size()) {
+        _state->droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[size] = Event{name,
+        UnsignedLong(std::chrono::duration_cast<std::chrono::nanoseconds>(begin - _state->start).count()),
+        UnsignedLong(std::chrono::duration_cast<std::chrono::nanoseconds>(end - _state->start).count())};
+    buffer.size.store(size + 1, std::memory_order_release);
+}
+
+std::string Tracer::chromeTrace() const {
+    std::string out = "{\"traceEvents\":[";
+
+    std::vector<Event> events;
+    bool first = true;
+    _state->buffers.forEach([&](const ThreadBuffer& buffer, const std::size_t id) {
+        /* Zones are stored when they end, so nested zones come before the
+           enclosing ones. Sort them by begin time, enclosing first, which
+           is the order the viewers expect. */
+        const std::size_t size = buffer.size.load(std::memory_order_acquire);
+        events.assign(buffer.events.begin(), buffer.events.begin() + size);
+        std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+            return a.begin < b.begin || (a.begin == b.begin && a.end > b.end);
+        });
+
+        for(const Event& event: events) {
+            if(!first) out += ',';
+            first = false;
+            out += "\n{\"name\":";
+            appendJsonString(out, event.name);
+            out += Utility::formatString(",\"cat\":\"magnum\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}}}",
+                event.begin/1000.0, (event.end - event.begin)/1000.0, id);
+        }
+    });
+
+    out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out;
+}
+
+bool Tracer::exportChromeTrace(const std::string& filename) const {
+    if(!Utility::Directory::writeString(filename, chromeTrace())) {
+        Error{} << "Tracer::exportChromeTrace(): cannot write to file" << filename;
+        return false;
+    }
+
+    return true;
+}
+
+}
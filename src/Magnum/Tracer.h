@@ -0,0 +1,257 @@
+#ifndef Magnum_Tracer_h
+#define Magnum_Tracer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Tracer, macro @ref MAGNUM_TRACE_ZONE()
+ * @m_since_latest
+ */
+
+#include <chrono>
+#include <string>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Timeline tracer
+@m_since_latest
+
+Records begin and end times of named zones on all threads and exports them
+as a [Chrome trace_event](https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/)
+JSON, which can be opened for example in `chrome://tracing`,
+[Perfetto](https://ui.perfetto.dev) or converted for use in
+[Tracy](https://github.com/wolfpld/tracy). Compared to the aggregated output
+of @ref DebugTools::FrameProfiler, the timeline shows where exactly the time
+goes, including nesting of the zones and their distribution across threads.
+
+@section Tracer-usage Usage
+
+Zones are recorded only while a tracer instance exists. Create it early on,
+execute the code to be traced and then export the recorded timeline:
+
+@code{.cpp}
+Tracer tracer;
+
+{
+    Tracer::Zone zone{"Loading"};
+    // ...
+}
+
+tracer.exportChromeTrace("trace.json");
+@endcode
+
+Code that's meant to be traced only in profiling builds should use the
+@ref MAGNUM_TRACE_ZONE() macro instead of instantiating @ref Zone directly.
+The macro compiles to nothing unless Magnum is built with the `BUILD_TRACING`
+CMake option enabled, which is also what controls the zones placed in
+@ref MeshTools and @ref Trade::AbstractImporter. See
+@ref MAGNUM_BUILD_TRACING for more information.
+
+@section Tracer-threads Threads and memory
+
+Each thread gets its own buffer preallocated to a fixed capacity on the first
+zone it records, so recording doesn't allocate and threads don't contend with
+each other. The zones are stored when they end, and once a buffer is full,
+subsequent zones from given thread are dropped and counted in
+@ref droppedCount(). The buffers are kept until the tracer is destroyed.
+
+Only one tracer can exist at a time. The tracer is expected to outlive all
+zones and it's safe to export the timeline while other threads are still
+recording --- only zones that ended before the export are included.
+
+@note Tracing from multiple threads requires Corrade to be built with
+    @ref CORRADE_BUILD_MULTITHREADED enabled, which is the default. Without
+    it, the per-thread buffer lookup isn't thread-local and recording from
+    a second thread asserts.
+*/
+class MAGNUM_EXPORT Tracer {
+    public:
+        class Zone;
+
+        /**
+         * @brief Currently active tracer
+         *
+         * Returns @cpp nullptr @ce if there's no tracer instance.
+         */
+        static Tracer* current();
+
+        /**
+         * @brief Constructor
+         * @param capacityPerThread     Zone capacity of each per-thread
+         *      buffer
+         *
+         * Makes the instance current. Expects that no other instance is
+         * current and that @p capacityPerThread is not zero.
+         */
+        explicit Tracer(std::size_t capacityPerThread = 65536);
+
+        /** @brief Copying is not allowed */
+        Tracer(const Tracer&) = delete;
+
+        /**
+         * @brief Moving is not allowed
+         *
+         * The instance is referenced from all active zones.
+         */
+        Tracer(Tracer&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Resets @ref current() back to @cpp nullptr @ce.
+         */
+        ~Tracer();
+
+        /** @brief Copying is not allowed */
+        Tracer& operator=(const Tracer&) = delete;
+
+        /** @brief Moving is not allowed */
+        Tracer& operator=(Tracer&&) = delete;
+
+        /** @brief Zone capacity of each per-thread buffer */
+        std::size_t capacityPerThread() const;
+
+        /** @brief Count of threads that recorded at least one zone */
+        UnsignedInt threadCount() const;
+
+        /** @brief Count of recorded zones on all threads */
+        std::size_t zoneCount() const;
+
+        /**
+         * @brief Count of dropped zones
+         *
+         * Zones that didn't fit into a per-thread buffer.
+         */
+        std::size_t droppedCount() const;
+
+        /**
+         * @brief Chrome trace_event JSON
+         *
+         * Each zone is a complete (@cb{.json} "ph": "X" @ce) event with
+         * time in microseconds relative to the tracer construction. Threads
+         * are numbered in order they recorded their first zone. Zones of
+         * each thread are sorted by their begin time with enclosing zones
+         * first.
+         */
+        std::string chromeTrace() const;
+
+        /**
+         * @brief Export a Chrome trace_event JSON to a file
+         *
+         * Writes output of @ref chromeTrace() to @p filename. Prints a
+         * message to @ref Error and returns @cpp false @ce if the file
+         * can't be written, @cpp true @ce otherwise.
+         */
+        bool exportChromeTrace(const std::string& filename) const;
+
+    private:
+        struct ThreadBuffer;
+        struct State;
+
+        MAGNUM_LOCAL ThreadBuffer& threadBuffer();
+        /* Not local as it's called from the inline Zone destructor */
+        void record(const char* name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end);
+
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Traced zone
+@m_since_latest
+
+Records time elapsed between construction and destruction into the
+@ref Tracer::current() tracer. If there's no current tracer at the time of
+construction, the zone does nothing. See also @ref MAGNUM_TRACE_ZONE() for
+a variant that can be removed at compile time.
+*/
+class MAGNUM_EXPORT Tracer::Zone {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The @p name is not copied, it's expected to stay in scope for
+         * the whole lifetime of the tracer. Usually it's a string literal.
+         */
+        explicit Zone(const char* name): _tracer{Tracer::current()}, _name{name} {
+            if(_tracer) _begin = std::chrono::steady_clock::now();
+        }
+
+        /** @brief Copying is not allowed */
+        Zone(const Zone&) = delete;
+
+        /** @brief Moving is not allowed */
+        Zone(Zone&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Records the zone, if there was a current tracer on construction.
+         */
+        ~Zone() {
+            if(_tracer) _tracer->record(_name, _begin, std::chrono::steady_clock::now());
+        }
+
+        /** @brief Copying is not allowed */
+        Zone& operator=(const Zone&) = delete;
+
+        /** @brief Moving is not allowed */
+        Zone& operator=(Zone&&) = delete;
+
+    private:
+        Tracer* _tracer;
+        const char* _name;
+        std::chrono::steady_clock::time_point _begin;
+};
+
+/** @hideinitializer
+@brief Trace a zone
+@m_since_latest
+
+Creates a @ref Tracer::Zone named @p name that lasts until the end of
+current scope. Compiles to nothing if @ref MAGNUM_BUILD_TRACING isn't
+defined, so it can be left in code that's shipped without any overhead.
+@see @ref Tracer
+*/
+#if defined(MAGNUM_BUILD_TRACING) || defined(DOXYGEN_GENERATING_OUTPUT)
+#define MAGNUM_TRACE_ZONE(name)                                             \
+    Magnum::Tracer::Zone MAGNUM_TRACE_ZONE_VARIABLE(__LINE__){name}
+#else
+#define MAGNUM_TRACE_ZONE(name) do {} while(false)
+#endif
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+/* Two levels to get __LINE__ expanded before the concatenation */
+#define MAGNUM_TRACE_ZONE_VARIABLE(line) MAGNUM_TRACE_ZONE_VARIABLE_IMPLEMENTATION(line)
+#define MAGNUM_TRACE_ZONE_VARIABLE_IMPLEMENTATION(line) magnumTraceZone ## line
+#endif
+
+}
+
+#endif
@@ -28,11 +28,16 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/FileCallback.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Tracer.h"
 #include "Magnum/Trade/AbstractMaterialData.h"
 #include "Magnum/Trade/AnimationData.h"
 #include "Magnum/Trade/ArrayAllocator.h"
@@ -59,7 +64,7 @@
 namespace Magnum { namespace Trade {
 
 std::string AbstractImporter::pluginInterface() {
-    return "cz.mosra.magnum.Trade.AbstractImporter/0.3.1";
+    return "cz.mosra.magnum.Trade.AbstractImporter/0.3.2";
 }
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
@@ -117,6 +122,7 @@ bool AbstractImporter::openData(Containers::ArrayView<const char> data) {
     /* We accept empty data here (instead of checking for them and failing so
        the check doesn't be done on the plugin side) because for some file
        formats it could be valid (e.g. OBJ or JSON-based formats). */
+    MAGNUM_TRACE_ZONE("Trade::AbstractImporter::openData()");
     close();
     doOpenData(data);
     return isOpened();
@@ -130,6 +136,7 @@ bool AbstractImporter::openState(const void* state, const std::string& filePath)
     CORRADE_ASSERT(features() & ImporterFeature::OpenState,
         "Trade::AbstractImporter::openState(): feature not supported", {});
 
+    MAGNUM_TRACE_ZONE("Trade::AbstractImporter::openState()");
     close();
     doOpenState(state, filePath);
     return isOpened();
@@ -140,6 +147,8 @@ void AbstractImporter::doOpenState(const void*, const std::string&) {
 }
 
 bool AbstractImporter::openFile(const std::string& filename) {
+    MAGNUM_TRACE_ZONE("Trade::AbstractImporter::openFile()");
+
     close();
 
     /* If file loading callbacks are not set or the importer supports handling
@@ -239,6 +248,7 @@ std::string AbstractImporter::doSceneName(UnsignedInt) { return {}; }
 Containers::Optional<SceneData> AbstractImporter::scene(const UnsignedInt id) {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::scene(): no file opened", {});
     CORRADE_ASSERT(id < doSceneCount(), "Trade::AbstractImporter::scene(): index" << id << "out of range for" << doSceneCount() << "entries", {});
+    MAGNUM_TRACE_ZONE("Trade::AbstractImporter::scene()");
     return doScene(id);
 }
 
@@ -281,6 +291,7 @@ std::string AbstractImporter::doAnimationName(UnsignedInt) { return {}; }
 Containers::Optional<AnimationData> AbstractImporter::animation(const UnsignedInt id) {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::animation(): no file opened", {});
     CORRADE_ASSERT(id < doAnimationCount(), "Trade::AbstractImporter::animation(): index" << id << "out of range for" << doAnimationCount() << "entries", {});
+    MAGNUM_TRACE_ZONE("Trade::AbstractImporter::animation()");
     Containers::Optional<AnimationData> animation = doAnimation(id);
     CORRADE_ASSERT(!animation ||
         ((!animation->_data.deleter() || animation->_data.deleter() == Implementation::nonOwnedArrayDeleter || animation->_data.deleter() == ArrayAllocator<char>::deleter) &&
@@ -517,6 +528,7 @@ Containers::Optional<MeshData> AbstractImporter::mesh(const UnsignedInt id, cons
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::mesh(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    MAGNUM_TRACE_ZONE("Trade::AbstractImporter::mesh()");
     Containers::Optional<MeshData> mesh = doMesh(id, level);
     CORRADE_ASSERT(!mesh || (
         (!mesh->_indexData.deleter() || mesh->_indexData.deleter() == Implementation::nonOwnedArrayDeleter || mesh->_indexData.deleter() == ArrayAllocator<char>::deleter) &&
@@ -780,6 +792,7 @@ Containers::Optional<ImageData1D> AbstractImporter::image1D(const UnsignedInt id
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image1D(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    MAGNUM_TRACE_ZONE("Trade::AbstractImporter::image1D()");
     Containers::Optional<ImageData1D> image = doImage1D(id, level);
     CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == Implementation::nonOwnedArrayDeleter || image->_data.deleter() == ArrayAllocator<char>::deleter, "Trade::AbstractImporter::image1D(): implementation is not allowed to use a custom Array deleter", {});
     return image;
@@ -847,6 +860,7 @@ Containers::Optional<ImageData2D> AbstractImporter::image2D(const UnsignedInt id
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image2D(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    MAGNUM_TRACE_ZONE("Trade::AbstractImporter::image2D()");
     Containers::Optional<ImageData2D> image = doImage2D(id, level);
     CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == Implementation::nonOwnedArrayDeleter || image->_data.deleter() == ArrayAllocator<char>::deleter, "Trade::AbstractImporter::image2D(): implementation is not allowed to use a custom Array deleter", {});
     return image;
@@ -867,6 +881,78 @@ Containers::Optional<ImageData2D> AbstractImporter::image2D(const std::string& n
     return image2D(id, level);
 }
 
+Containers::Optional<ImageView2D> AbstractImporter::image2DProperties(const UnsignedInt id, const UnsignedInt level) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image2DProperties(): no file opened", {});
+    CORRADE_ASSERT(id < doImage2DCount(), "Trade::AbstractImporter::image2DProperties(): index" << id << "out of range for" << doImage2DCount() << "entries", {});
+    #ifndef CORRADE_NO_ASSERT
+    /* See image2D() for why this is checked only for nonzero levels */
+    if(level) {
+        const UnsignedInt levelCount = doImage2DLevelCount(id);
+        CORRADE_ASSERT(levelCount, "Trade::AbstractImporter::image2DProperties(): implementation reported zero levels", {});
+        CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image2DProperties(): level" << level << "out of range for" << levelCount << "entries", {});
+    }
+    #endif
+    Containers::Optional<ImageView2D> properties = doImage2DProperties(id, level);
+    CORRADE_ASSERT(!properties || !properties->data().data(), "Trade::AbstractImporter::image2DProperties(): implementation is not allowed to return a view with data", {});
+    return properties;
+}
+
+Containers::Optional<ImageView2D> AbstractImporter::doImage2DProperties(const UnsignedInt id, const UnsignedInt level) {
+    Containers::Optional<ImageData2D> image = doImage2D(id, level);
+    if(!image) return {};
+
+    if(image->isCompressed()) {
+        Error{} << "Trade::AbstractImporter::image2DProperties(): compressed images are not supported";
+        return {};
+    }
+
+    return ImageView2D{image->storage(), image->format(), image->formatExtra(), image->pixelSize(), image->size()};
+}
+
+bool AbstractImporter::image2DInto(const UnsignedInt id, const MutableImageView2D& destination, const UnsignedInt rowOffset, const UnsignedInt level) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image2DInto(): no file opened", {});
+    CORRADE_ASSERT(id < doImage2DCount(), "Trade::AbstractImporter::image2DInto(): index" << id << "out of range for" << doImage2DCount() << "entries", {});
+    #ifndef CORRADE_NO_ASSERT
+    /* See image2D() for why this is checked only for nonzero levels */
+    if(level) {
+        const UnsignedInt levelCount = doImage2DLevelCount(id);
+        CORRADE_ASSERT(levelCount, "Trade::AbstractImporter::image2DInto(): implementation reported zero levels", {});
+        CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image2DInto(): level" << level << "out of range for" << levelCount << "entries", {});
+    }
+    #endif
+    CORRADE_ASSERT(destination.data().data(), "Trade::AbstractImporter::image2DInto(): destination has no data", {});
+    MAGNUM_TRACE_ZONE("Trade::AbstractImporter::image2DInto()");
+    return doImage2DInto(id, destination, rowOffset, level);
+}
+
+bool AbstractImporter::doImage2DInto(const UnsignedInt id, const MutableImageView2D& destination, const UnsignedInt rowOffset, const UnsignedInt level) {
+    Containers::Optional<ImageData2D> image = doImage2D(id, level);
+    if(!image) return false;
+
+    if(image->isCompressed()) {
+        Error{} << "Trade::AbstractImporter::image2DInto(): compressed images are not supported";
+        return false;
+    }
+    if(image->format() != destination.format() || image->formatExtra() != destination.formatExtra() || image->pixelSize() != destination.pixelSize()) {
+        Error{} << "Trade::AbstractImporter::image2DInto(): expected destination format" << image->format() << "but got" << destination.format();
+        return false;
+    }
+    if(image->size().x() != destination.size().x()) {
+        Error{} << "Trade::AbstractImporter::image2DInto(): expected destination width" << image->size().x() << "but got" << destination.size().x();
+        return false;
+    }
+    if(rowOffset + destination.size().y() > UnsignedInt(image->size().y())) {
+        Error{} << "Trade::AbstractImporter::image2DInto(): rows" << rowOffset << "to" << rowOffset + destination.size().y() << "out of range for" << image->size().y() << "rows";
+        return false;
+    }
+
+    Utility::copy(image->pixels().slice(
+        {rowOffset, 0, 0},
+        {rowOffset + destination.size().y(), std::size_t(image->size().x()), image->pixelSize()}),
+        destination.pixels());
+    return true;
+}
+
 UnsignedInt AbstractImporter::image3DCount() const {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image3DCount(): no file opened", {});
     return doImage3DCount();
@@ -914,6 +1000,7 @@ Containers::Optional<ImageData3D> AbstractImporter::image3D(const UnsignedInt id
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image3D(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    MAGNUM_TRACE_ZONE("Trade::AbstractImporter::image3D()");
     Containers::Optional<ImageData3D> image = doImage3D(id, level);
     CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == Implementation::nonOwnedArrayDeleter || image->_data.deleter() == ArrayAllocator<char>::deleter, "Trade::AbstractImporter::image3D(): implementation is not allowed to use a custom Array deleter", {});
     return image;
@@ -327,7 +327,7 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          * @brief Plugin interface
          *
          * @code{.cpp}
-         * "cz.mosra.magnum.Trade.AbstractImporter/0.3.1"
+         * "cz.mosra.magnum.Trade.AbstractImporter/0.3.2"
          * @endcode
          */
         static std::string pluginInterface();
@@ -1207,6 +1207,50 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         Containers::Optional<ImageData2D> image2D(const std::string& name, UnsignedInt level = 0);
 
+        /**
+         * @brief Two-dimensional image properties
+         * @param id        Image ID, from range [0, @ref image2DCount()).
+         * @param level     Mip level, from range [0, @ref image2DLevelCount())
+         * @m_since_latest
+         *
+         * Returns an @ref ImageView2D with no data, describing pixel storage,
+         * format and size of given image, or @ref Containers::NullOpt if
+         * importing failed. Useful for preparing a destination for
+         * @ref image2DInto(). Plugins that implement this function don't need
+         * to decode the whole image in order to get the properties, with the
+         * default implementation it's as expensive as calling
+         * @ref image2D(). Expects that a file is opened.
+         */
+        Containers::Optional<ImageView2D> image2DProperties(UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Import a range of two-dimensional image rows into existing memory
+         * @param id            Image ID, from range [0, @ref image2DCount()).
+         * @param destination   Destination view
+         * @param rowOffset     First image row to import
+         * @param level         Mip level, from range [0, @ref image2DLevelCount())
+         * @return Whether the import succeeded
+         * @m_since_latest
+         *
+         * Imports rows @f$ [ r, r + h ) @f$ of given image, where @f$ r @f$
+         * is @p rowOffset and @f$ h @f$ is height of @p destination, directly
+         * into @p destination. The destination is expected to have the same
+         * format and width as the image reported by @ref image2DProperties(),
+         * and @f$ r + h @f$ is expected to not be larger than image height,
+         * otherwise the function prints a message to @ref Error and returns
+         * @cpp false @ce. The destination pixel storage can be different from
+         * the one reported by the importer. Importing only a subset of the
+         * rows allows for example to upload huge images in slices without
+         * needing to have the whole decoded image in memory.
+         *
+         * Plugins that implement this function decode the data directly into
+         * the destination, with the default implementation the whole image is
+         * imported through @ref image2D() first and the requested rows are
+         * copied. Compressed images are not supported. Expects that a file is
+         * opened and that @p destination is not @cpp nullptr @ce.
+         */
+        bool image2DInto(UnsignedInt id, const MutableImageView2D& destination, UnsignedInt rowOffset = 0, UnsignedInt level = 0);
+
         /**
          * @brief Three-dimensional image count
          *
@@ -1797,6 +1841,26 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Implementation for @ref image2D() */
         virtual Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level);
 
+        /**
+         * @brief Implementation for @ref image2DProperties()
+         * @m_since_latest
+         *
+         * Default implementation calls @ref doImage2D() and returns properties
+         * of the imported image. Compressed images are not supported.
+         */
+        virtual Containers::Optional<ImageView2D> doImage2DProperties(UnsignedInt id, UnsignedInt level);
+
+        /**
+         * @brief Implementation for @ref image2DInto()
+         * @m_since_latest
+         *
+         * Default implementation calls @ref doImage2D(), checks that the
+         * image matches @p destination and copies the requested rows to it.
+         * The @p destination is guaranteed to not be @cpp nullptr @ce, all
+         * other checks are up to the implementation.
+         */
+        virtual bool doImage2DInto(UnsignedInt id, const MutableImageView2D& destination, UnsignedInt rowOffset, UnsignedInt level);
+
         /**
          * @brief Implementation for @ref image3DCount()
          *
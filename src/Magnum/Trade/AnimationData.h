@@ -292,6 +292,26 @@ It's also possible to directly update object transformations using callbacks,
 among other things. See documentation of the @ref Animation::Player class for
 more information.
 
+@section Trade-AnimationData-usage-resample Resampling to uniform tracks
+
+Imported tracks can have arbitrarily spaced keyframes, which means that
+seeking in them involves a keyframe search. If constant-time lookup is
+desired, the tracks can be converted to @ref Animation::UniformTrack using
+@ref Animation::resample():
+
+@snippet MagnumTrade.cpp AnimationData-resample
+
+@section Trade-AnimationData-usage-compress Compressing rotation tracks
+
+Imported tracks store all keyframes with full precision, even though
+neighboring keyframes can often be interpolated from each other. Rotation
+tracks can be converted using @ref Animation::compressQuaternions(), which
+packs the values into 48 bits and removes keyframes that are within given
+tolerance, with @ref Animation::trackError() reporting the error of the result.
+For other track types, @ref Animation::reduceKeyframes() can be used:
+
+@snippet MagnumTrade.cpp AnimationData-compress
+
 @section Trade-AnimationData-usage-mutable Mutable data access
 
 The interfaces implicitly provide @cpp const @ce views on the contained
@@ -0,0 +1,288 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AsyncImporter.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Implementation/Parallel.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+/* Dispatches to the right importer functions for given data type. The
+   functions are overloaded on a name variant, so member function pointers
+   would need ugly casts. */
+template<class> struct ImporterFor;
+template<> struct ImporterFor<MeshData> {
+    static const char* name() { return "mesh"; }
+    static UnsignedInt count(AbstractImporter& importer) { return importer.meshCount(); }
+    static UnsignedInt levelCount(AbstractImporter& importer, UnsignedInt id) { return importer.meshLevelCount(id); }
+    static Containers::Optional<MeshData> get(AbstractImporter& importer, UnsignedInt id, UnsignedInt level) { return importer.mesh(id, level); }
+};
+template<> struct ImporterFor<ImageData1D> {
+    static const char* name() { return "image1D"; }
+    static UnsignedInt count(AbstractImporter& importer) { return importer.image1DCount(); }
+    static UnsignedInt levelCount(AbstractImporter& importer, UnsignedInt id) { return importer.image1DLevelCount(id); }
+    static Containers::Optional<ImageData1D> get(AbstractImporter& importer, UnsignedInt id, UnsignedInt level) { return importer.image1D(id, level); }
+};
+template<> struct ImporterFor<ImageData2D> {
+    static const char* name() { return "image2D"; }
+    static UnsignedInt count(AbstractImporter& importer) { return importer.image2DCount(); }
+    static UnsignedInt levelCount(AbstractImporter& importer, UnsignedInt id) { return importer.image2DLevelCount(id); }
+    static Containers::Optional<ImageData2D> get(AbstractImporter& importer, UnsignedInt id, UnsignedInt level) { return importer.image2D(id, level); }
+};
+template<> struct ImporterFor<ImageData3D> {
+    static const char* name() { return "image3D"; }
+    static UnsignedInt count(AbstractImporter& importer) { return importer.image3DCount(); }
+    static UnsignedInt levelCount(AbstractImporter& importer, UnsignedInt id) { return importer.image3DLevelCount(id); }
+    static Containers::Optional<ImageData3D> get(AbstractImporter& importer, UnsignedInt id, UnsignedInt level) { return importer.image3D(id, level); }
+};
+
+}
+
+struct AsyncImporter::Job {
+    explicit Job(std::string&& filename, UnsignedInt id, UnsignedInt level): filename{std::move(filename)}, id{id}, level{level} {}
+    virtual ~Job() = default;
+
+    /* Called with the file already opened */
+    virtual void run(AbstractImporter& importer) = 0;
+    /* Called if opening the file failed or the job got cancelled */
+    virtual void fail() = 0;
+
+    std::string filename;
+    UnsignedInt id, level;
+};
+
+template<class T> struct AsyncImporter::JobImplementation: Job {
+    using Job::Job;
+
+    void run(AbstractImporter& importer) override {
+        /* The importer would assert on out-of-range IDs, which is not
+           something the caller can check upfront as the file is opened only
+           in the worker */
+        const UnsignedInt count = ImporterFor<T>::count(importer);
+        if(id >= count) {
+            Error{} << "Trade::AsyncImporter::" << Debug::nospace << ImporterFor<T>::name() << Debug::nospace << "(): index" << id << "out of range for" << count << "entries in" << filename;
+            return fail();
+        }
+        const UnsignedInt levelCount = ImporterFor<T>::levelCount(importer, id);
+        if(level >= levelCount) {
+            Error{} << "Trade::AsyncImporter::" << Debug::nospace << ImporterFor<T>::name() << Debug::nospace << "(): level" << level << "out of range for" << levelCount << "entries in" << filename;
+            return fail();
+        }
+
+        promise.set_value(ImporterFor<T>::get(importer, id, level));
+    }
+
+    void fail() override {
+        promise.set_value(Containers::NullOpt);
+    }
+
+    std::promise<Containers::Optional<T>> promise;
+};
+
+struct AsyncImporter::State {
+    std::vector<Containers::Pointer<AbstractImporter>> importers;
+    std::vector<std::thread> threads;
+
+    /* Everything below is guarded by the mutex */
+    mutable std::mutex mutex;
+    /* Signalled when a job is queued or the workers should exit */
+    std::condition_variable jobAvailable;
+    /* Signalled when a worker finishes a job */
+    std::condition_variable jobFinished;
+    std::deque<Containers::Pointer<Job>> queue;
+    std::size_t running{};
+    bool exiting{};
+};
+
+AsyncImporter::AsyncImporter(PluginManager::Manager<AbstractImporter>& manager, const std::string& plugin, UnsignedInt threadCount): _state{Containers::InPlaceInit} {
+    threadCount = Magnum::Implementation::resolveThreadCount(threadCount);
+
+    /* The manager isn't thread-safe, so all instances are created upfront
+       here. If the first one fails, the rest would fail as well. */
+    for(UnsignedInt i = 0; i != threadCount; ++i) {
+        Containers::Pointer<AbstractImporter> importer = manager.loadAndInstantiate(plugin);
+        if(!importer) break;
+        _state->importers.push_back(std::move(importer));
+    }
+
+    _state->threads.reserve(_state->importers.size());
+    for(UnsignedInt i = 0; i != _state->importers.size(); ++i)
+        _state->threads.emplace_back(&AsyncImporter::work, this, i);
+}
+
+AsyncImporter::~AsyncImporter() {
+    cancel();
+
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->exiting = true;
+    }
+    _state->jobAvailable.notify_all();
+
+    for(std::thread& thread: _state->threads) thread.join();
+
+    /* The importers were closed by the workers, they get destroyed on this
+       thread together with the state */
+}
+
+UnsignedInt AsyncImporter::workerCount() const {
+    return _state->importers.size();
+}
+
+AbstractImporter& AsyncImporter::importer(const UnsignedInt id) {
+    #ifndef CORRADE_NO_ASSERT
+    /* There may be no workers at all if the plugin failed to load, so the
+       graceful assert can't return any of the instances */
+    struct DummyImporter: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+    };
+    static DummyImporter dummy;
+    #endif
+    CORRADE_ASSERT(id < _state->importers.size(),
+        "Trade::AsyncImporter::importer(): index" << id << "out of range for" << _state->importers.size() << "workers", dummy);
+    return *_state->importers[id];
+}
+
+std::size_t AsyncImporter::pendingCount() const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->queue.size() + _state->running;
+}
+
+template<class T> std::future<Containers::Optional<T>> AsyncImporter::request(std::string&& filename, const UnsignedInt id, const UnsignedInt level) {
+    Containers::Pointer<JobImplementation<T>> job{Containers::InPlaceInit, std::move(filename), id, level};
+    std::future<Containers::Optional<T>> future = job->promise.get_future();
+    submit(std::move(job));
+    return future;
+}
+
+std::future<Containers::Optional<MeshData>> AsyncImporter::mesh(std::string filename, const UnsignedInt id, const UnsignedInt level) {
+    return request<MeshData>(std::move(filename), id, level);
+}
+
+std::future<Containers::Optional<ImageData1D>> AsyncImporter::image1D(std::string filename, const UnsignedInt id, const UnsignedInt level) {
+    return request<ImageData1D>(std::move(filename), id, level);
+}
+
+std::future<Containers::Optional<ImageData2D>> AsyncImporter::image2D(std::string filename, const UnsignedInt id, const UnsignedInt level) {
+    return request<ImageData2D>(std::move(filename), id, level);
+}
+
+std::future<Containers::Optional<ImageData3D>> AsyncImporter::image3D(std::string filename, const UnsignedInt id, const UnsignedInt level) {
+    return request<ImageData3D>(std::move(filename), id, level);
+}
+
+void AsyncImporter::submit(Containers::Pointer<Job>&& job) {
+    /* Nobody would pick the job up, fail it right away */
+    if(_state->threads.empty()) {
+        Error{} << "Trade::AsyncImporter: no workers available, can't import" << job->filename;
+        job->fail();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->queue.push_back(std::move(job));
+    }
+    _state->jobAvailable.notify_one();
+}
+
+std::size_t AsyncImporter::cancel() {
+    /* Take the jobs out of the queue under the lock but resolve the futures
+       outside of it, as the waiting threads would otherwise immediately block
+       on the mutex again */
+    std::deque<Containers::Pointer<Job>> cancelled;
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        cancelled.swap(_state->queue);
+    }
+    _state->jobFinished.notify_all();
+
+    for(Containers::Pointer<Job>& job: cancelled) job->fail();
+    return cancelled.size();
+}
+
+void AsyncImporter::wait() {
+    std::unique_lock<std::mutex> lock{_state->mutex};
+    _state->jobFinished.wait(lock, [this] {
+        return _state->queue.empty() && !_state->running;
+    });
+}
+
+void AsyncImporter::work(const UnsignedInt id) {
+    AbstractImporter& importer = *_state->importers[id];
+    std::string openedFilename;
+
+    for(;;) {
+        Containers::Pointer<Job> job;
+        {
+            std::unique_lock<std::mutex> lock{_state->mutex};
+            _state->jobAvailable.wait(lock, [this] {
+                return _state->exiting || !_state->queue.empty();
+            });
+            if(_state->queue.empty()) break;
+
+            job = std::move(_state->queue.front());
+            _state->queue.pop_front();
+            ++_state->running;
+        }
+
+        /* Reuse the opened file if it's the same as in the previous job, which
+           is the common case when importing a whole scene */
+        if(!importer.isOpened() || openedFilename != job->filename) {
+            openedFilename = {};
+            if(importer.openFile(job->filename))
+                openedFilename = job->filename;
+        }
+
+        if(importer.isOpened()) job->run(importer);
+        else job->fail();
+
+        {
+            std::lock_guard<std::mutex> lock{_state->mutex};
+            --_state->running;
+        }
+        _state->jobFinished.notify_all();
+    }
+
+    importer.close();
+}
+
+}}
@@ -0,0 +1,231 @@
+#ifndef Magnum_Trade_AsyncImporter_h
+#define Magnum_Trade_AsyncImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::AsyncImporter
+ * @m_since_latest
+ */
+
+#include <future>
+#include <string>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/PluginManager.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Asynchronous importer
+@m_since_latest
+
+Imports @ref MeshData and @ref ImageData on a fixed-size pool of worker
+threads, returning a @ref std::future for each request. Because importer
+plugins are not guaranteed to be thread-safe, each worker owns a dedicated
+@ref AbstractImporter instance, which is never accessed from any other thread
+while the pool is running.
+
+@section Trade-AsyncImporter-usage Usage
+
+The importer instances are created in the constructor from a plugin manager
+passed to it, since @ref Corrade::PluginManager::Manager itself isn't
+thread-safe either. Each request then names a file and a data ID, the first
+free worker opens the file (or reuses it, if it's the file it processed last)
+and imports the data:
+
+@code{.cpp}
+PluginManager::Manager<Trade::AbstractImporter> manager;
+Trade::AsyncImporter importer{manager, "AnySceneImporter", 4};
+
+std::future<Containers::Optional<Trade::MeshData>> chair =
+    importer.mesh("chair.gltf", 0);
+std::future<Containers::Optional<Trade::ImageData2D>> wood =
+    importer.image2D("wood.png", 0);
+
+// ... do other work meanwhile ...
+
+Containers::Optional<Trade::MeshData> mesh = chair.get();
+@endcode
+
+If opening the file or importing the data fails, or the ID is out of range,
+the future is resolved to @ref Corrade::Containers::NullOpt "Containers::NullOpt"
+and the reason is printed to @ref Error by the worker. Requests that weren't
+started yet can be dropped using @ref cancel(), in which case their futures
+resolve to @ref Corrade::Containers::NullOpt "Containers::NullOpt" as well.
+
+For non-blocking integration with @ref ResourceManager, where resources go
+from @ref ResourceState::Loading to @ref ResourceState::Final once the worker
+finishes, see @ref AsyncResourceLoader.
+
+@section Trade-AsyncImporter-lifetime Data lifetime
+
+Data returned by the importers are passed through as-is. Some importers may
+return data that reference memory owned by the importer instance --- such
+data are valid only until the worker that imported them opens a different
+file or until the @ref AsyncImporter instance is destroyed, so it's advised to
+check @ref MeshData::indexDataFlags(), @ref MeshData::vertexDataFlags() or
+@ref ImageData::dataFlags() for @ref DataFlag::Owned and make a copy if
+needed.
+
+@note This class is not available on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten",
+    as threads are not generally available there.
+*/
+class MAGNUM_TRADE_EXPORT AsyncImporter {
+    public:
+        /**
+         * @brief Constructor
+         * @param manager       Plugin manager to instantiate the importers
+         *      from
+         * @param plugin        Importer plugin name
+         * @param threadCount   Count of worker threads. If @cpp 0 @ce,
+         *      @ref std::thread::hardware_concurrency() is used.
+         *
+         * Loads and instantiates @p plugin once for each worker thread. If
+         * the plugin can't be loaded, no workers are created and all
+         * requests resolve to @ref Corrade::Containers::NullOpt "Containers::NullOpt".
+         * The @p manager is expected to stay in scope for the whole lifetime
+         * of the instance.
+         * @see @ref workerCount()
+         */
+        explicit AsyncImporter(PluginManager::Manager<AbstractImporter>& manager, const std::string& plugin, UnsignedInt threadCount = 0);
+
+        /** @brief Copying is not allowed */
+        AsyncImporter(const AsyncImporter&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncImporter(AsyncImporter&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref cancel(), waits for the requests that are currently
+         * being processed to finish and then stops the workers.
+         */
+        ~AsyncImporter();
+
+        /** @brief Copying is not allowed */
+        AsyncImporter& operator=(const AsyncImporter&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncImporter& operator=(AsyncImporter&&) = delete;
+
+        /**
+         * @brief Count of worker threads
+         *
+         * Zero if the plugin failed to load.
+         */
+        UnsignedInt workerCount() const;
+
+        /**
+         * @brief Importer instance used by given worker
+         *
+         * Can be used to set importer flags, callbacks or configuration
+         * options. Expects that @p id is less than @ref workerCount(). As the
+         * instance is accessed from the worker thread, it's safe to modify it
+         * only if there are no requests in progress, for example right after
+         * construction or after @ref wait().
+         */
+        AbstractImporter& importer(UnsignedInt id);
+
+        /**
+         * @brief Count of pending requests
+         *
+         * Requests that are queued or are being processed.
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Mesh
+         * @param filename  File to import the mesh from
+         * @param id        Mesh ID
+         * @param level     Mesh level
+         *
+         * Queues the import and returns immediately.
+         * @see @ref AbstractImporter::mesh(UnsignedInt, UnsignedInt)
+         */
+        std::future<Containers::Optional<MeshData>> mesh(std::string filename, UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief One-dimensional image
+         *
+         * Same as @ref image2D(), but for 1D images.
+         */
+        std::future<Containers::Optional<ImageData1D>> image1D(std::string filename, UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Two-dimensional image
+         * @param filename  File to import the image from
+         * @param id        Image ID
+         * @param level     Mip level
+         *
+         * Queues the import and returns immediately.
+         * @see @ref AbstractImporter::image2D(UnsignedInt, UnsignedInt)
+         */
+        std::future<Containers::Optional<ImageData2D>> image2D(std::string filename, UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Three-dimensional image
+         *
+         * Same as @ref image2D(), but for 3D images.
+         */
+        std::future<Containers::Optional<ImageData3D>> image3D(std::string filename, UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Cancel queued requests
+         * @return Count of cancelled requests
+         *
+         * Removes all requests that weren't picked up by any worker yet and
+         * resolves their futures to @ref Corrade::Containers::NullOpt "Containers::NullOpt".
+         * Requests that are currently being processed are not affected.
+         */
+        std::size_t cancel();
+
+        /**
+         * @brief Wait for all requests to finish
+         *
+         * Blocks until there are no queued requests and all workers are idle.
+         */
+        void wait();
+
+    private:
+        struct Job;
+        template<class> struct JobImplementation;
+        struct State;
+
+        MAGNUM_TRADE_LOCAL void submit(Containers::Pointer<Job>&& job);
+        MAGNUM_TRADE_LOCAL void work(UnsignedInt id);
+        template<class T> MAGNUM_TRADE_LOCAL std::future<Containers::Optional<T>> request(std::string&& filename, UnsignedInt id, UnsignedInt level);
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
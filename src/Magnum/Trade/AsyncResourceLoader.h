@@ -0,0 +1,197 @@
+#ifndef Magnum_Trade_AsyncResourceLoader_h
+#define Magnum_Trade_AsyncResourceLoader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::AsyncResourceLoader
+ * @m_since_latest
+ */
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+#include "Magnum/AbstractResourceLoader.h"
+#include "Magnum/ResourceManager.h"
+#include "Magnum/Trade/AsyncImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade {
+
+namespace Implementation {
+    template<class> struct AsyncResourceLoaderRequest;
+    template<> struct AsyncResourceLoaderRequest<MeshData> {
+        static std::future<Containers::Optional<MeshData>> get(AsyncImporter& importer, const std::string& filename, UnsignedInt id, UnsignedInt level) {
+            return importer.mesh(filename, id, level);
+        }
+    };
+    template<> struct AsyncResourceLoaderRequest<ImageData1D> {
+        static std::future<Containers::Optional<ImageData1D>> get(AsyncImporter& importer, const std::string& filename, UnsignedInt id, UnsignedInt level) {
+            return importer.image1D(filename, id, level);
+        }
+    };
+    template<> struct AsyncResourceLoaderRequest<ImageData2D> {
+        static std::future<Containers::Optional<ImageData2D>> get(AsyncImporter& importer, const std::string& filename, UnsignedInt id, UnsignedInt level) {
+            return importer.image2D(filename, id, level);
+        }
+    };
+    template<> struct AsyncResourceLoaderRequest<ImageData3D> {
+        static std::future<Containers::Optional<ImageData3D>> get(AsyncImporter& importer, const std::string& filename, UnsignedInt id, UnsignedInt level) {
+            return importer.image3D(filename, id, level);
+        }
+    };
+}
+
+/**
+@brief Asynchronous resource loader
+@m_since_latest
+
+Resource loader for @ref ResourceManager that imports @ref MeshData,
+@ref ImageData1D, @ref ImageData2D or @ref ImageData3D using an
+@ref AsyncImporter. Resources are first registered with @ref add(), mapping a
+resource key to a file and data ID. Requesting such resource from the
+manager then queues the import and marks the resource as
+@ref ResourceState::Loading without blocking. Finished imports are passed to
+the manager in @ref update(), which is meant to be called periodically from
+the thread that owns the manager, for example once every frame:
+
+@code{.cpp}
+PluginManager::Manager<Trade::AbstractImporter> importerManager;
+Trade::AsyncImporter importer{importerManager, "AnySceneImporter"};
+
+ResourceManager<Trade::MeshData> manager;
+Containers::Pointer<Trade::AsyncResourceLoader<Trade::MeshData>> loader{
+    Containers::InPlaceInit, importer};
+loader->add("chair", "chair.gltf", 0);
+Trade::AsyncResourceLoader<Trade::MeshData>& loaderRef = *loader;
+manager.setLoader<Trade::MeshData>(std::move(loader));
+
+// Queues the import, the resource is in ResourceState::Loading
+Resource<Trade::MeshData> chair = manager.get<Trade::MeshData>("chair");
+
+// Later, in the main loop. Once the import finishes, the resource becomes
+// ResourceState::Final, or ResourceState::NotFound if the import failed
+loaderRef.update();
+@endcode
+
+Resources that weren't registered with @ref add() are marked as
+@ref ResourceState::NotFound right away. The @ref AsyncImporter is expected to
+outlive the loader. Since the manager itself is not thread-safe, the imported
+data are never passed to it from the worker threads, only from @ref update().
+*/
+template<class T> class AsyncResourceLoader: public AbstractResourceLoader<T> {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The @p importer is expected to be kept in scope for the whole
+         * lifetime of the loader.
+         */
+        explicit AsyncResourceLoader(AsyncImporter& importer): _importer(importer) {}
+
+        /**
+         * @brief Register a resource
+         * @param name      Resource name
+         * @param filename  File to import the resource from
+         * @param id        Data ID in the file
+         * @param level     Data level
+         * @return Reference to self (for method chaining)
+         *
+         * Replaces any previous registration under the same name.
+         */
+        AsyncResourceLoader<T>& add(const std::string& name, std::string filename, UnsignedInt id, UnsignedInt level = 0) {
+            _entries[ResourceKey{name}] = Entry{name, std::move(filename), id, level};
+            return *this;
+        }
+
+        /** @brief Count of requests that weren't passed to the manager yet */
+        std::size_t pendingCount() const { return _pending.size(); }
+
+        /**
+         * @brief Pass finished imports to the manager
+         * @return Count of resources that were set to the manager
+         *
+         * Doesn't block. Resources that were imported successfully are set
+         * with @ref ResourceDataState::Final and @ref ResourcePolicy::Resident,
+         * failed imports are marked as not found.
+         */
+        std::size_t update();
+
+    private:
+        struct Entry {
+            std::string name, filename;
+            UnsignedInt id, level;
+        };
+
+        std::string doName(ResourceKey key) const override {
+            auto found = _entries.find(key);
+            return found == _entries.end() ? std::string{} : found->second.name;
+        }
+
+        void doLoad(ResourceKey key) override;
+
+        AsyncImporter& _importer;
+        std::unordered_map<ResourceKey, Entry> _entries;
+        std::vector<std::pair<ResourceKey, std::future<Containers::Optional<T>>>> _pending;
+};
+
+template<class T> void AsyncResourceLoader<T>::doLoad(const ResourceKey key) {
+    auto found = _entries.find(key);
+    if(found == _entries.end()) {
+        this->setNotFound(key);
+        return;
+    }
+
+    _pending.emplace_back(key, Implementation::AsyncResourceLoaderRequest<T>::get(_importer, found->second.filename, found->second.id, found->second.level));
+}
+
+template<class T> std::size_t AsyncResourceLoader<T>::update() {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != _pending.size(); ) {
+        std::future<Containers::Optional<T>>& future = _pending[i].second;
+        if(future.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+            ++i;
+            continue;
+        }
+
+        Containers::Optional<T> data = future.get();
+        if(data) this->set(_pending[i].first, std::move(*data));
+        else this->setNotFound(_pending[i].first);
+        ++count;
+
+        /* Order of the pending requests doesn't matter, swap with the last
+           one and remove it */
+        if(i + 1 != _pending.size()) _pending[i] = std::move(_pending.back());
+        _pending.pop_back();
+    }
+
+    return count;
+}
+
+}}
+
+#endif
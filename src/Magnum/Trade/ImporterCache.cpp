@@ -0,0 +1,570 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ImporterCache.h"
+
+#include <cstring>
+#include <sstream>
+#include <unordered_map>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Configuration.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+/* Bump every time the file layout or hashed inputs change */
+constexpr UnsignedShort Version = 1;
+
+enum class EntryType: UnsignedByte {
+    Mesh = 0,
+    Image1D = 1,
+    Image2D = 2,
+    Image3D = 3
+};
+
+enum: UnsignedByte { EntryFlagCompressed = 1 << 0 };
+
+/* Whole header is 64 bytes, so the data after are aligned enough for any
+   vertex or pixel type */
+struct Header {
+    char magic[4];
+    /* Written as 0x0102, so files created on a machine with different
+       endianness are rejected */
+    UnsignedShort endianness;
+    UnsignedShort version;
+    EntryType type;
+    UnsignedByte flags;
+    UnsignedShort padding0;
+    UnsignedInt padding1;
+    UnsignedLong size;
+    char key[40];
+};
+
+static_assert(sizeof(Header) == 64, "improper size of cache entry header");
+
+struct MeshHeader {
+    UnsignedInt primitive;
+    UnsignedInt vertexCount;
+    UnsignedInt indexCount;
+    UnsignedInt attributeCount;
+    MeshIndexType indexType;
+    UnsignedByte padding0;
+    UnsignedShort padding1;
+    UnsignedInt padding2;
+    UnsignedLong indexOffset;
+    UnsignedLong indexDataOffset;
+    UnsignedLong indexDataSize;
+    UnsignedLong vertexDataOffset;
+    UnsignedLong vertexDataSize;
+};
+
+static_assert(sizeof(MeshHeader) == 64, "improper size of cache mesh header");
+
+struct MeshAttributeRecord {
+    UnsignedLong offset;
+    UnsignedInt format;
+    MeshAttribute name;
+    Short stride;
+    UnsignedShort arraySize;
+    UnsignedShort padding0;
+    UnsignedInt padding1;
+};
+
+static_assert(sizeof(MeshAttributeRecord) == 24, "improper size of cache mesh attribute record");
+
+struct ImageHeader {
+    UnsignedInt format;
+    UnsignedInt formatExtra;
+    UnsignedInt pixelSize;
+    Int alignment;
+    Int rowLength;
+    Int imageHeight;
+    Vector3i skip;
+    Vector3i size;
+    Vector3i compressedBlockSize;
+    Int compressedBlockDataSize;
+    UnsignedLong dataOffset;
+    UnsignedLong dataSize;
+};
+
+static_assert(sizeof(ImageHeader) == 80, "improper size of cache image header");
+
+constexpr std::size_t align(std::size_t offset) {
+    return (offset + 15) & ~std::size_t{15};
+}
+
+Header header(const std::string& key, const EntryType type, const UnsignedByte flags, const std::size_t size) {
+    Header out{};
+    std::memcpy(out.magic, "MGNC", 4);
+    out.endianness = 0x0102;
+    out.version = Version;
+    out.type = type;
+    out.flags = flags;
+    out.size = size;
+    CORRADE_INTERNAL_ASSERT(key.size() == sizeof(out.key));
+    std::memcpy(out.key, key.data(), sizeof(out.key));
+    return out;
+}
+
+/* Returns a null pointer if the header doesn't match */
+const Header* validateHeader(const Containers::ArrayView<const char> data, const std::string& key, const EntryType type) {
+    if(data.size() < sizeof(Header)) return nullptr;
+    const Header& header = *reinterpret_cast<const Header*>(data.data());
+    if(std::memcmp(header.magic, "MGNC", 4) != 0 ||
+       header.endianness != 0x0102 ||
+       header.version != Version ||
+       header.type != type ||
+       header.size != data.size() ||
+       std::memcmp(header.key, key.data(), sizeof(header.key)) != 0)
+        return nullptr;
+    return &header;
+}
+
+template<UnsignedInt> struct ImageImporter;
+template<> struct ImageImporter<1> {
+    static const char* name() { return "image1d"; }
+    static UnsignedInt count(AbstractImporter& importer) { return importer.image1DCount(); }
+    static UnsignedInt levelCount(AbstractImporter& importer, UnsignedInt id) { return importer.image1DLevelCount(id); }
+    static Containers::Optional<ImageData1D> import(AbstractImporter& importer, UnsignedInt id, UnsignedInt level) {
+        return importer.image1D(id, level);
+    }
+};
+template<> struct ImageImporter<2> {
+    static const char* name() { return "image2d"; }
+    static UnsignedInt count(AbstractImporter& importer) { return importer.image2DCount(); }
+    static UnsignedInt levelCount(AbstractImporter& importer, UnsignedInt id) { return importer.image2DLevelCount(id); }
+    static Containers::Optional<ImageData2D> import(AbstractImporter& importer, UnsignedInt id, UnsignedInt level) {
+        return importer.image2D(id, level);
+    }
+};
+template<> struct ImageImporter<3> {
+    static const char* name() { return "image3d"; }
+    static UnsignedInt count(AbstractImporter& importer) { return importer.image3DCount(); }
+    static UnsignedInt levelCount(AbstractImporter& importer, UnsignedInt id) { return importer.image3DLevelCount(id); }
+    static Containers::Optional<ImageData3D> import(AbstractImporter& importer, UnsignedInt id, UnsignedInt level) {
+        return importer.image3D(id, level);
+    }
+};
+
+bool rangeInside(const UnsignedLong offset, const UnsignedLong size, const std::size_t totalSize) {
+    return offset <= totalSize && size <= totalSize - offset;
+}
+
+}
+
+struct ImporterCache::Entries {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    typedef Containers::Array<const char, Utility::Directory::MapDeleter> Data;
+    #else
+    typedef Containers::Array<char> Data;
+    #endif
+
+    /* Validated entries, referenced by the returned meshes and images and
+       thus kept until close() */
+    std::unordered_map<std::string, Data> data;
+    /* Entry that's being validated, moved to the above only if it passes */
+    Data pending;
+};
+
+ImporterCache::ImporterCache(AbstractImporter& importer, std::string directory): _importer{&importer}, _directory{std::move(directory)}, _entries{Containers::InPlaceInit} {}
+
+ImporterCache::~ImporterCache() { close(); }
+
+ImporterCache& ImporterCache::setMeshProcessor(const MeshProcessor processor, const std::string& name, void* const userData) {
+    CORRADE_ASSERT(!isOpened(),
+        "Trade::ImporterCache::setMeshProcessor(): can't be set while a file is opened", *this);
+    _meshProcessor = processor;
+    _meshProcessorName = processor ? name : std::string{};
+    _meshProcessorUserData = userData;
+    return *this;
+}
+
+bool ImporterCache::openFile(const std::string& filename) {
+    close();
+
+    if(!Utility::Directory::exists(filename)) {
+        Error{} << "Trade::ImporterCache::openFile(): cannot open file" << filename;
+        return false;
+    }
+
+    _filename = filename;
+    return openInternal(Utility::Directory::read(filename));
+}
+
+bool ImporterCache::openData(const Containers::ArrayView<const char> data) {
+    CORRADE_ASSERT(_importer->features() & ImporterFeature::OpenData,
+        "Trade::ImporterCache::openData(): the importer doesn't support opening data", {});
+
+    close();
+
+    Containers::Array<char> copy{Containers::NoInit, data.size()};
+    Utility::copy(data, copy);
+    return openInternal(std::move(copy));
+}
+
+bool ImporterCache::openInternal(Containers::Array<char>&& data) {
+    /* Save the importer configuration into a string to have it hashed
+       together with everything else */
+    std::ostringstream configuration;
+    {
+        Utility::Configuration conf;
+        conf.addGroup("configuration", new Utility::ConfigurationGroup{_importer->configuration()});
+        conf.save(configuration);
+    }
+
+    Utility::Sha1 sha1;
+    sha1 << Utility::formatString("magnum-importer-cache-{}\n", Version)
+        << _importer->plugin() << "\n"
+        << configuration.str() << "\n"
+        << _meshProcessorName << "\n"
+        << Containers::ArrayView<const char>{data};
+    _key = sha1.digest().hexString();
+
+    _data = std::move(data);
+    _hitCount = 0;
+    _missCount = 0;
+    return true;
+}
+
+void ImporterCache::close() {
+    if(_importerOpened) _importer->close();
+    _importerOpened = false;
+    _filename = {};
+    _key = {};
+    _data = nullptr;
+    _entries->data.clear();
+    _entries->pending = nullptr;
+}
+
+bool ImporterCache::openImporter() {
+    if(_importerOpened) return true;
+
+    /* Prefer opening the data we already have in memory, fall back to the
+       file in case the importer can't open data */
+    if(_importer->features() & ImporterFeature::OpenData) {
+        if(!_importer->openData(_data)) return false;
+    } else {
+        CORRADE_INTERNAL_ASSERT(!_filename.empty());
+        if(!_importer->openFile(_filename)) return false;
+    }
+
+    /* The importer has its own copy now, no need to keep ours */
+    _data = nullptr;
+    _importerOpened = true;
+    return true;
+}
+
+std::string ImporterCache::entryFilename(const char* const type, const UnsignedInt id, const UnsignedInt level) const {
+    return Utility::Directory::join({_directory, _key, Utility::formatString("{}-{}-{}.bin", type, id, level)});
+}
+
+Containers::ArrayView<const char> ImporterCache::load(const std::string& filename) {
+    /* If the entry was already loaded and validated before, reuse it instead
+       of mapping the file again */
+    const auto found = _entries->data.find(filename);
+    if(found != _entries->data.end()) return found->second;
+
+    if(!Utility::Directory::exists(filename)) return nullptr;
+
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    _entries->pending = Utility::Directory::mapRead(filename);
+    #else
+    _entries->pending = Utility::Directory::read(filename);
+    #endif
+    return _entries->pending;
+}
+
+void ImporterCache::keep(const std::string& filename) {
+    /* If the data came from an already validated entry, there's nothing
+       pending */
+    if(_entries->pending)
+        _entries->data.emplace(filename, std::move(_entries->pending));
+}
+
+void ImporterCache::store(const std::string& filename, const Containers::ArrayView<const char> data) {
+    /* Release the entry that failed validation, if any. The file can't be
+       replaced while it's still mapped on Windows. */
+    _entries->pending = nullptr;
+
+    const std::string path = Utility::Directory::path(filename);
+    const std::string temporary = filename + ".tmp";
+    if(!Utility::Directory::mkpath(path) ||
+       !Utility::Directory::write(temporary, data) ||
+       !Utility::Directory::move(temporary, filename))
+        Warning{} << "Trade::ImporterCache: cannot write" << filename;
+}
+
+Containers::Optional<MeshData> ImporterCache::mesh(const UnsignedInt id, const UnsignedInt level) {
+    CORRADE_ASSERT(isOpened(), "Trade::ImporterCache::mesh(): no file opened", {});
+
+    const std::string filename = entryFilename("mesh", id, level);
+
+    /* Try the cache first */
+    if(const Containers::ArrayView<const char> data = load(filename)) do {
+        if(!validateHeader(data, _key, EntryType::Mesh) ||
+           data.size() < sizeof(Header) + sizeof(MeshHeader)) break;
+        const MeshHeader& info = *reinterpret_cast<const MeshHeader*>(data + sizeof(Header));
+        const std::size_t attributeOffset = sizeof(Header) + sizeof(MeshHeader);
+        if(!rangeInside(attributeOffset, UnsignedLong(info.attributeCount)*sizeof(MeshAttributeRecord), data.size()) ||
+           !rangeInside(info.indexDataOffset, info.indexDataSize, data.size()) ||
+           !rangeInside(info.vertexDataOffset, info.vertexDataSize, data.size()))
+            break;
+
+        const Containers::ArrayView<const char> indexData = data.slice(info.indexDataOffset, info.indexDataOffset + info.indexDataSize);
+        const Containers::ArrayView<const char> vertexData = data.slice(info.vertexDataOffset, info.vertexDataOffset + info.vertexDataSize);
+
+        /* Validate the index view */
+        MeshIndexData indices;
+        if(info.indexType != MeshIndexType{}) {
+            if(UnsignedInt(info.indexType) > UnsignedInt(MeshIndexType::UnsignedInt)) break;
+            const std::size_t indexSize = meshIndexTypeSize(info.indexType);
+            /* The MeshData constructor treats a zero index count as a
+               non-indexed mesh and would assert on the index data */
+            if(!info.indexCount ||
+               !rangeInside(info.indexOffset, UnsignedLong(info.indexCount)*indexSize, indexData.size())) break;
+            indices = MeshIndexData{info.indexType, indexData.slice(info.indexOffset, info.indexOffset + info.indexCount*indexSize)};
+        } else if(!indexData.empty()) break;
+
+        /* Validate the attribute bounds the same way as the MeshData
+           constructor does, so it doesn't assert on corrupted files */
+        const Containers::ArrayView<const MeshAttributeRecord> records = Containers::arrayCast<const MeshAttributeRecord>(data.slice(attributeOffset, attributeOffset + info.attributeCount*sizeof(MeshAttributeRecord)));
+        Containers::Array<MeshAttributeData> attributes{records.size()};
+        bool valid = true;
+        for(std::size_t i = 0; i != records.size(); ++i) {
+            const MeshAttributeRecord& record = records[i];
+            /* Check the raw value first, vertexFormatSize() would assert on
+               values outside of the enum range */
+            const VertexFormat format = VertexFormat(record.format);
+            if(format == VertexFormat{} || record.stride < 0 ||
+               (!isVertexFormatImplementationSpecific(format) && record.format > UnsignedInt(VertexFormat::Matrix4x3sNormalizedAligned)) ||
+               (record.arraySize && !isMeshAttributeCustom(record.name))) {
+                valid = false;
+                break;
+            }
+            const UnsignedInt typeSize = isVertexFormatImplementationSpecific(format) ? 0 : vertexFormatSize(format)*Math::max(UnsignedInt(record.arraySize), 1u);
+            if(info.vertexCount && !rangeInside(record.offset, UnsignedLong(info.vertexCount - 1)*record.stride + typeSize, vertexData.size())) {
+                valid = false;
+                break;
+            }
+            attributes[i] = MeshAttributeData{record.name, format, std::size_t(record.offset), info.vertexCount, record.stride, record.arraySize};
+        }
+        if(!valid) break;
+
+        keep(filename);
+        ++_hitCount;
+        return MeshData{MeshPrimitive(info.primitive),
+            DataFlags{}, indexData, indices,
+            DataFlags{}, vertexData, std::move(attributes),
+            info.vertexCount};
+    } while(false);
+
+    /* Cache miss, import the mesh */
+    ++_missCount;
+    if(!openImporter()) return {};
+
+    /* The importer would assert on out-of-range IDs, but since the file is
+       opened only on a cache miss, the caller can't check them upfront */
+    const UnsignedInt meshCount = _importer->meshCount();
+    if(id >= meshCount) {
+        Error{} << "Trade::ImporterCache::mesh(): index" << id << "out of range for" << meshCount << "entries";
+        return {};
+    }
+    const UnsignedInt meshLevelCount = _importer->meshLevelCount(id);
+    if(level >= meshLevelCount) {
+        Error{} << "Trade::ImporterCache::mesh(): level" << level << "out of range for" << meshLevelCount << "entries";
+        return {};
+    }
+
+    Containers::Optional<MeshData> mesh = _importer->mesh(id, level);
+    if(mesh && _meshProcessor)
+        mesh = _meshProcessor(*std::move(mesh), _meshProcessorUserData);
+    if(!mesh) return {};
+
+    /* Serialize it */
+    const std::size_t attributeOffset = sizeof(Header) + sizeof(MeshHeader);
+    const std::size_t indexDataOffset = align(attributeOffset + mesh->attributeCount()*sizeof(MeshAttributeRecord));
+    const std::size_t vertexDataOffset = align(indexDataOffset + mesh->indexData().size());
+    const std::size_t size = vertexDataOffset + mesh->vertexData().size();
+    Containers::Array<char> out{Containers::ValueInit, size};
+
+    *reinterpret_cast<Header*>(out.data()) = header(_key, EntryType::Mesh, 0, size);
+
+    MeshHeader& meshHeader = *reinterpret_cast<MeshHeader*>(out + sizeof(Header));
+    meshHeader.primitive = UnsignedInt(mesh->primitive());
+    meshHeader.vertexCount = mesh->vertexCount();
+    meshHeader.attributeCount = mesh->attributeCount();
+    if(mesh->isIndexed()) {
+        meshHeader.indexType = mesh->indexType();
+        meshHeader.indexCount = mesh->indexCount();
+        meshHeader.indexOffset = mesh->indexOffset();
+    }
+    meshHeader.indexDataOffset = indexDataOffset;
+    meshHeader.indexDataSize = mesh->indexData().size();
+    meshHeader.vertexDataOffset = vertexDataOffset;
+    meshHeader.vertexDataSize = mesh->vertexData().size();
+
+    Containers::ArrayView<MeshAttributeRecord> records = Containers::arrayCast<MeshAttributeRecord>(out.slice(attributeOffset, attributeOffset + mesh->attributeCount()*sizeof(MeshAttributeRecord)));
+    for(UnsignedInt i = 0; i != mesh->attributeCount(); ++i) {
+        records[i].offset = mesh->attributeOffset(i);
+        records[i].format = UnsignedInt(mesh->attributeFormat(i));
+        records[i].name = mesh->attributeName(i);
+        records[i].stride = mesh->attributeStride(i);
+        records[i].arraySize = mesh->attributeArraySize(i);
+    }
+
+    Utility::copy(mesh->indexData(), out.slice(indexDataOffset, indexDataOffset + mesh->indexData().size()));
+    Utility::copy(mesh->vertexData(), out.suffix(vertexDataOffset));
+
+    store(filename, out);
+    return mesh;
+}
+
+template<UnsignedInt dimensions> Containers::Optional<ImageData<dimensions>> ImporterCache::image(const UnsignedInt id, const UnsignedInt level) {
+    CORRADE_ASSERT(isOpened(), "Trade::ImporterCache::image" << Debug::nospace << dimensions << Debug::nospace << "D(): no file opened", {});
+
+    const EntryType type = EntryType(dimensions);
+    const std::string filename = entryFilename(ImageImporter<dimensions>::name(), id, level);
+
+    /* Try the cache first */
+    if(const Containers::ArrayView<const char> data = load(filename)) do {
+        const Header* const header = validateHeader(data, _key, type);
+        if(!header || data.size() < sizeof(Header) + sizeof(ImageHeader)) break;
+        const ImageHeader& info = *reinterpret_cast<const ImageHeader*>(data + sizeof(Header));
+        if(!rangeInside(info.dataOffset, info.dataSize, data.size()) ||
+           (info.size < Vector3i{}).any()) break;
+        const Containers::ArrayView<const char> imageData = data.slice(info.dataOffset, info.dataOffset + info.dataSize);
+        const VectorTypeFor<dimensions, Int> size = Math::Vector<dimensions, Int>::pad(info.size);
+
+        if(header->flags & EntryFlagCompressed) {
+            CompressedPixelStorage storage;
+            storage.setRowLength(info.rowLength)
+                .setImageHeight(info.imageHeight)
+                .setSkip(info.skip)
+                .setCompressedBlockSize(info.compressedBlockSize)
+                .setCompressedBlockDataSize(info.compressedBlockDataSize);
+            keep(filename);
+            ++_hitCount;
+            return ImageData<dimensions>{storage, CompressedPixelFormat(info.format), size, DataFlags{}, imageData};
+        }
+
+        /* Check the data size the same way as the ImageData constructor
+           does, so it doesn't assert on corrupted files */
+        if(!info.pixelSize || info.pixelSize > 256 ||
+           (info.alignment != 1 && info.alignment != 2 && info.alignment != 4 && info.alignment != 8)) break;
+        PixelStorage storage;
+        storage.setAlignment(info.alignment)
+            .setRowLength(info.rowLength)
+            .setImageHeight(info.imageHeight)
+            .setSkip(info.skip);
+        if(Magnum::Implementation::imageDataSize(ImageView<dimensions, const char>{storage, PixelFormat(info.format), info.formatExtra, info.pixelSize, size}) > imageData.size())
+            break;
+
+        keep(filename);
+        ++_hitCount;
+        return ImageData<dimensions>{storage, PixelFormat(info.format), info.formatExtra, info.pixelSize, size, DataFlags{}, imageData};
+    } while(false);
+
+    /* Cache miss, import the image */
+    ++_missCount;
+    if(!openImporter()) return {};
+
+    /* Same as in mesh() */
+    const UnsignedInt imageCount = ImageImporter<dimensions>::count(*_importer);
+    if(id >= imageCount) {
+        Error{} << "Trade::ImporterCache::image" << Debug::nospace << dimensions << Debug::nospace << "D(): index" << id << "out of range for" << imageCount << "entries";
+        return {};
+    }
+    const UnsignedInt imageLevelCount = ImageImporter<dimensions>::levelCount(*_importer, id);
+    if(level >= imageLevelCount) {
+        Error{} << "Trade::ImporterCache::image" << Debug::nospace << dimensions << Debug::nospace << "D(): level" << level << "out of range for" << imageLevelCount << "entries";
+        return {};
+    }
+
+    Containers::Optional<ImageData<dimensions>> image = ImageImporter<dimensions>::import(*_importer, id, level);
+    if(!image) return {};
+
+    /* Serialize it */
+    const std::size_t dataOffset = align(sizeof(Header) + sizeof(ImageHeader));
+    const std::size_t size = dataOffset + image->data().size();
+    Containers::Array<char> out{Containers::ValueInit, size};
+
+    *reinterpret_cast<Header*>(out.data()) = header(_key, type, image->isCompressed() ? EntryFlagCompressed : 0, size);
+
+    ImageHeader& imageHeader = *reinterpret_cast<ImageHeader*>(out + sizeof(Header));
+    if(image->isCompressed()) {
+        const CompressedPixelStorage storage = image->compressedStorage();
+        imageHeader.format = UnsignedInt(image->compressedFormat());
+        imageHeader.rowLength = storage.rowLength();
+        imageHeader.imageHeight = storage.imageHeight();
+        imageHeader.skip = storage.skip();
+        imageHeader.compressedBlockSize = storage.compressedBlockSize();
+        imageHeader.compressedBlockDataSize = storage.compressedBlockDataSize();
+    } else {
+        const PixelStorage storage = image->storage();
+        imageHeader.format = UnsignedInt(image->format());
+        imageHeader.formatExtra = image->formatExtra();
+        imageHeader.pixelSize = image->pixelSize();
+        imageHeader.alignment = storage.alignment();
+        imageHeader.rowLength = storage.rowLength();
+        imageHeader.imageHeight = storage.imageHeight();
+        imageHeader.skip = storage.skip();
+    }
+    imageHeader.size = Vector3i::pad(image->size());
+    imageHeader.dataOffset = dataOffset;
+    imageHeader.dataSize = image->data().size();
+
+    Utility::copy(image->data(), out.suffix(dataOffset));
+
+    store(filename, out);
+    return image;
+}
+
+Containers::Optional<ImageData1D> ImporterCache::image1D(const UnsignedInt id, const UnsignedInt level) {
+    return image<1>(id, level);
+}
+
+Containers::Optional<ImageData2D> ImporterCache::image2D(const UnsignedInt id, const UnsignedInt level) {
+    return image<2>(id, level);
+}
+
+Containers::Optional<ImageData3D> ImporterCache::image3D(const UnsignedInt id, const UnsignedInt level) {
+    return image<3>(id, level);
+}
+
+}}
@@ -0,0 +1,299 @@
+#ifndef Magnum_Trade_ImporterCache_h
+#define Magnum_Trade_ImporterCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::ImporterCache
+ * @m_since_latest
+ */
+
+#include <string>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief On-disk cache of imported data
+@m_since_latest
+
+Wraps an @ref AbstractImporter instance and stores imported (and optionally
+post-processed) @ref MeshData and @ref ImageData in a local cache directory.
+The cache is keyed on a SHA-1 hash of the input file contents, the importer
+plugin name, its complete @ref AbstractImporter::configuration() "configuration"
+and a name of the post-processing step applied to imported meshes. A change in
+any of those results in a different key and thus a cache miss.
+
+@section Trade-ImporterCache-usage Usage
+
+Instead of calling @ref AbstractImporter::openFile() directly, pass the
+importer to the cache and open the file through it. The importer itself is
+opened lazily only when the first cache miss happens, which means that with a
+fully populated cache the (potentially expensive) parsing is skipped
+altogether:
+
+@code{.cpp}
+PluginManager::Manager<Trade::AbstractImporter> manager;
+Containers::Pointer<Trade::AbstractImporter> importer =
+    manager.loadAndInstantiate("AnySceneImporter");
+
+Trade::ImporterCache cache{*importer, "/tmp/cache"};
+if(!cache.openFile("chair.obj"))
+    Fatal{} << "Can't open chair.obj";
+
+Containers::Optional<Trade::MeshData> mesh = cache.mesh(0);
+@endcode
+
+Meshes can be additionally post-processed before being stored using
+@ref setMeshProcessor(), for example to remove duplicate vertices and
+interleave the data. The processing name passed to the function is a part of
+the cache key, so it should change every time the processing itself changes:
+
+@code{.cpp}
+cache.setMeshProcessor([](Trade::MeshData&& mesh, void*) {
+    return Containers::optional(MeshTools::removeDuplicates(std::move(mesh)));
+}, "removeDuplicates");
+@endcode
+
+@section Trade-ImporterCache-storage Storage and data lifetime
+
+Each cache entry is stored in a file inside a `<directory>/<key>/`
+subdirectory, containing a small header followed by the raw index, vertex or
+pixel data with the same layout as in the original @ref MeshData or
+@ref ImageData. Entries are written to a temporary file first and then
+renamed in order to not leave partially written files behind in case the
+process gets interrupted.
+
+On platforms that support it, cache hits are memory-mapped using
+@ref Corrade::Utility::Directory::mapRead() and validated against the expected key,
+format version and data bounds before being used. Entries that fail the
+validation are ignored and overwritten with freshly imported data. The
+returned @ref MeshData and @ref ImageData instances then reference the mapped
+memory directly and have neither @ref DataFlag::Owned nor
+@ref DataFlag::Mutable set --- in that case the data are only valid until
+@ref close() is called or until the cache instance is destroyed. On platforms
+without memory-mapping support the files are read into memory, with the same
+lifetime guarantees.
+
+Data returned on a cache miss are returned exactly as imported / processed,
+with their original data flags.
+
+@section Trade-ImporterCache-limitations Limitations
+
+Only @ref MeshData and @ref ImageData are cached, as these are usually
+responsible for the majority of the import time. The @ref MeshData::importerState()
+and @ref ImageData::importerState() pointers are not preserved in data loaded
+from the cache.
+*/
+class MAGNUM_TRADE_EXPORT ImporterCache {
+    public:
+        /**
+         * @brief Mesh processor
+         *
+         * Gets an imported mesh and user pointer passed to
+         * @ref setMeshProcessor(), returns the processed mesh or
+         * @ref Corrade::Containers::NullOpt "Containers::NullOpt" if the
+         * processing failed.
+         */
+        typedef Containers::Optional<MeshData>(*MeshProcessor)(MeshData&&, void*);
+
+        /**
+         * @brief Constructor
+         * @param importer      Importer to wrap
+         * @param directory     Cache directory. Created on first write if
+         *      it doesn't exist yet.
+         *
+         * The @p importer is expected to be kept in scope for the whole
+         * lifetime of the cache instance.
+         */
+        explicit ImporterCache(AbstractImporter& importer, std::string directory);
+
+        /** @brief Copying is not allowed */
+        ImporterCache(const ImporterCache&) = delete;
+
+        /** @brief Moving is not allowed */
+        ImporterCache(ImporterCache&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref close().
+         */
+        ~ImporterCache();
+
+        /** @brief Copying is not allowed */
+        ImporterCache& operator=(const ImporterCache&) = delete;
+
+        /** @brief Moving is not allowed */
+        ImporterCache& operator=(ImporterCache&&) = delete;
+
+        /** @brief Wrapped importer */
+        AbstractImporter& importer() { return *_importer; }
+
+        /** @brief Cache directory */
+        std::string directory() const { return _directory; }
+
+        /**
+         * @brief Set mesh processor
+         * @param processor     Processing function
+         * @param name          Processing name, used as a part of the cache
+         *      key
+         * @param userData      User data passed to @p processor
+         * @return Reference to self (for method chaining)
+         *
+         * The @p processor is called on every mesh that isn't found in the
+         * cache, before it gets stored. Expects that no file is opened.
+         * Pass @cpp nullptr @ce to reset the processor back to none.
+         */
+        ImporterCache& setMeshProcessor(MeshProcessor processor, const std::string& name, void* userData = nullptr);
+
+        /**
+         * @brief Open a file
+         *
+         * Reads the file contents and calculates the cache key. The wrapped
+         * importer is opened only once a cache miss happens. Returns
+         * @cpp false @ce and prints a message to @ref Error if the file can't
+         * be read. Closes previously opened file, if any.
+         * @see @ref openData(), @ref key()
+         */
+        bool openFile(const std::string& filename);
+
+        /**
+         * @brief Open raw data
+         *
+         * Like @ref openFile(), but takes the file contents directly. The
+         * data are copied and kept in the cache instance until the wrapped
+         * importer gets opened. Expects that the wrapped importer supports
+         * @ref ImporterFeature::OpenData.
+         */
+        bool openData(Containers::ArrayView<const char> data);
+
+        /** @brief Whether any file is opened */
+        bool isOpened() const { return !_key.empty(); }
+
+        /**
+         * @brief Close currently opened file
+         *
+         * Closes also the wrapped importer, if it was opened through the
+         * cache. All data returned from cache hits become invalid.
+         */
+        void close();
+
+        /**
+         * @brief Cache key for currently opened file
+         *
+         * Hexadecimal SHA-1 hash combining the file contents, importer plugin
+         * name, importer configuration and mesh processor name. Empty if no
+         * file is opened.
+         */
+        std::string key() const { return _key; }
+
+        /**
+         * @brief Count of cache hits since the file was opened
+         *
+         * @see @ref missCount()
+         */
+        UnsignedInt hitCount() const { return _hitCount; }
+
+        /**
+         * @brief Count of cache misses since the file was opened
+         *
+         * @see @ref hitCount()
+         */
+        UnsignedInt missCount() const { return _missCount; }
+
+        /**
+         * @brief Mesh
+         * @param id        Mesh ID, from range [0, @ref AbstractImporter::meshCount()).
+         * @param level     Mesh level, from range [0, @ref AbstractImporter::meshLevelCount())
+         *
+         * Returns the mesh from the cache, if present. Otherwise opens the
+         * wrapped importer, imports the mesh, applies the processor set with
+         * @ref setMeshProcessor() and stores the result in the cache. Returns
+         * @ref Corrade::Containers::NullOpt "Containers::NullOpt" if the
+         * import or processing fails. Because the file gets opened only on a
+         * cache miss, @p id and @p level are checked against the mesh and
+         * level count only then, printing a message to @ref Error and
+         * returning @ref Corrade::Containers::NullOpt "Containers::NullOpt"
+         * if they're out of range. Expects that a file is opened.
+         */
+        Containers::Optional<MeshData> mesh(UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief One-dimensional image
+         *
+         * Same as @ref image2D(), but for 1D images.
+         */
+        Containers::Optional<ImageData1D> image1D(UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Two-dimensional image
+         * @param id        Image ID, from range [0, @ref AbstractImporter::image2DCount()).
+         * @param level     Mip level, from range [0, @ref AbstractImporter::image2DLevelCount())
+         *
+         * Returns the image from the cache, if present. Otherwise opens the
+         * wrapped importer, imports the image and stores it in the cache.
+         * Returns @ref Corrade::Containers::NullOpt "Containers::NullOpt" if
+         * the import fails or if @p id or @p level is out of range, same as
+         * in @ref mesh(). Expects that a file is opened.
+         */
+        Containers::Optional<ImageData2D> image2D(UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Three-dimensional image
+         *
+         * Same as @ref image2D(), but for 3D images.
+         */
+        Containers::Optional<ImageData3D> image3D(UnsignedInt id, UnsignedInt level = 0);
+
+    private:
+        struct Entries;
+
+        MAGNUM_TRADE_LOCAL bool openInternal(Containers::Array<char>&& data);
+        MAGNUM_TRADE_LOCAL bool openImporter();
+        MAGNUM_TRADE_LOCAL std::string entryFilename(const char* type, UnsignedInt id, UnsignedInt level) const;
+        MAGNUM_TRADE_LOCAL Containers::ArrayView<const char> load(const std::string& filename);
+        MAGNUM_TRADE_LOCAL void keep(const std::string& filename);
+        MAGNUM_TRADE_LOCAL void store(const std::string& filename, Containers::ArrayView<const char> data);
+        template<UnsignedInt dimensions> MAGNUM_TRADE_LOCAL Containers::Optional<ImageData<dimensions>> image(UnsignedInt id, UnsignedInt level);
+
+        AbstractImporter* _importer;
+        std::string _directory, _filename, _key, _meshProcessorName;
+        MeshProcessor _meshProcessor{};
+        void* _meshProcessorUserData{};
+        Containers::Array<char> _data;
+        Containers::Pointer<Entries> _entries;
+        bool _importerOpened{};
+        UnsignedInt _hitCount{}, _missCount{};
+};
+
+}}
+
+#endif
@@ -25,6 +25,14 @@
 
 #include "SceneData.h"
 
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Trade/ObjectData3D.h"
+
 namespace Magnum { namespace Trade {
 
 SceneData::SceneData(std::vector<UnsignedInt> children2D, std::vector<UnsignedInt> children3D, const void* const importerState): _children2D{std::move(children2D)}, _children3D{std::move(children3D)}, _importerState{importerState} {}
@@ -41,4 +49,45 @@ SceneData& SceneData::operator=(SceneData&&)
     #endif
     = default;
 
+Containers::Optional<Containers::Array<std::pair<UnsignedInt, Int>>> SceneData::hierarchy3D(const Containers::ArrayView<const Containers::Pointer<ObjectData3D>> objects) const {
+    std::vector<std::pair<UnsignedInt, Int>> out;
+    Containers::Array<bool> visited{Containers::ValueInit, objects.size()};
+
+    /* Pairs of object ID and index of its parent in the output. Pushed in
+       reverse so the objects are popped in the order they're listed in. */
+    std::vector<std::pair<UnsignedInt, Int>> stack;
+    for(auto it = _children3D.rbegin(); it != _children3D.rend(); ++it)
+        stack.emplace_back(*it, -1);
+
+    while(!stack.empty()) {
+        const std::pair<UnsignedInt, Int> top = stack.back();
+        stack.pop_back();
+
+        if(top.first >= objects.size()) {
+            Error{} << "Trade::SceneData::hierarchy3D(): object" << top.first << "out of bounds for" << objects.size() << "objects";
+            return {};
+        }
+        if(!objects[top.first]) {
+            Error{} << "Trade::SceneData::hierarchy3D(): object" << top.first << "is null";
+            return {};
+        }
+        if(visited[top.first]) {
+            Error{} << "Trade::SceneData::hierarchy3D(): object" << top.first << "is referenced more than once";
+            return {};
+        }
+        visited[top.first] = true;
+
+        const Int index = out.size();
+        out.push_back(top);
+
+        const std::vector<UnsignedInt>& children = objects[top.first]->children();
+        for(auto it = children.rbegin(); it != children.rend(); ++it)
+            stack.emplace_back(*it, index);
+    }
+
+    Containers::Array<std::pair<UnsignedInt, Int>> array{Containers::ValueInit, out.size()};
+    std::copy(out.begin(), out.end(), array.begin());
+    return Containers::optional(std::move(array));
+}
+
 }}
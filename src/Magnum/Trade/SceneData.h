@@ -30,9 +30,12 @@
  */
 
 #include <string>
+#include <utility>
 #include <vector>
+#include <Corrade/Containers/Containers.h>
 
 #include "Magnum/Types.h"
+#include "Magnum/Trade/Trade.h"
 #include "Magnum/Trade/visibility.h"
 
 namespace Magnum { namespace Trade {
@@ -84,6 +87,44 @@ class MAGNUM_TRADE_EXPORT SceneData {
         /** @brief Three-dimensional child objects */
         const std::vector<UnsignedInt>& children3D() const { return _children3D; }
 
+        /**
+         * @brief Flattened three-dimensional object hierarchy
+         * @param objects   Three-dimensional objects, indexed by their IDs,
+         *      for example imported with @ref AbstractImporter::object3D()
+         * @m_since_latest
+         *
+         * Returns all objects reachable from @ref children3D() in a
+         * depth-first order, each as a pair of object ID and index of its
+         * parent in the returned array, or @cpp -1 @ce for top-level
+         * objects. A parent is thus always listed before its children and
+         * each subtree occupies a contiguous range of the array, which makes
+         * the output directly usable with
+         * @ref SceneGraph::FlatTransformationHierarchy:
+         *
+         * @code{.cpp}
+         * Containers::Array<Containers::Pointer<Trade::ObjectData3D>> objects{
+         *      importer->object3DCount()};
+         * for(UnsignedInt i = 0; i != objects.size(); ++i)
+         *     objects[i] = importer->object3D(i);
+         *
+         * Containers::Optional<Containers::Array<std::pair<UnsignedInt, Int>>>
+         *      hierarchy = scene->hierarchy3D(objects);
+         * SceneGraph::FlatTransformationHierarchy3D flat{
+         *     Containers::StridedArrayView1D<const Int>{*hierarchy,
+         *         &(*hierarchy)[0].second, hierarchy->size(),
+         *         sizeof(std::pair<UnsignedInt, Int>)}};
+         * for(std::size_t i = 0; i != hierarchy->size(); ++i)
+         *     flat.setTransformation(i,
+         *         objects[(*hierarchy)[i].first]->transformation());
+         * @endcode
+         *
+         * If any object is out of bounds for @p objects, is
+         * @cpp nullptr @ce or is referenced more than once, a message is
+         * printed to @ref Error and @ref Corrade::Containers::NullOpt "Containers::NullOpt"
+         * is returned.
+         */
+        Containers::Optional<Containers::Array<std::pair<UnsignedInt, Int>>> hierarchy3D(Containers::ArrayView<const Containers::Pointer<ObjectData3D>> objects) const;
+
         /**
          * @brief Importer-specific state
          *
@@ -23,13 +23,16 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/FileCallback.h"
 #include "Magnum/Trade/AbstractImporter.h"
@@ -225,6 +228,14 @@ struct AbstractImporterTest: TestSuite::Tester {
     void image2DNonOwningDeleter();
     void image2DGrowableDeleter();
     void image2DCustomDeleter();
+    void image2DProperties();
+    void image2DPropertiesCompressed();
+    void image2DPropertiesOutOfRange();
+    void image2DInto();
+    void image2DIntoCompressed();
+    void image2DIntoWrongDestination();
+    void image2DIntoOutOfRange();
+    void image2DIntoNoData();
 
     void image3D();
     void image3DLevelCountNotImplemented();
@@ -427,6 +438,14 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::image2DNonOwningDeleter,
               &AbstractImporterTest::image2DGrowableDeleter,
               &AbstractImporterTest::image2DCustomDeleter,
+              &AbstractImporterTest::image2DProperties,
+              &AbstractImporterTest::image2DPropertiesCompressed,
+              &AbstractImporterTest::image2DPropertiesOutOfRange,
+              &AbstractImporterTest::image2DInto,
+              &AbstractImporterTest::image2DIntoCompressed,
+              &AbstractImporterTest::image2DIntoWrongDestination,
+              &AbstractImporterTest::image2DIntoOutOfRange,
+              &AbstractImporterTest::image2DIntoNoData,
 
               &AbstractImporterTest::image3D,
               &AbstractImporterTest::image3DLevelCountNotImplemented,
@@ -1294,6 +1313,9 @@ void AbstractImporterTest::thingNoFile() {
     importer.image1D("foo");
     importer.image2D(42);
     importer.image2D("foo");
+    importer.image2DProperties(42);
+    char data[4];
+    importer.image2DInto(42, MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data});
     importer.image3D(42);
     importer.image3D("foo");
 
@@ -1326,6 +1348,8 @@ void AbstractImporterTest::thingNoFile() {
         "Trade::AbstractImporter::image1D(): no file opened\n"
         "Trade::AbstractImporter::image2D(): no file opened\n"
         "Trade::AbstractImporter::image2D(): no file opened\n"
+        "Trade::AbstractImporter::image2DProperties(): no file opened\n"
+        "Trade::AbstractImporter::image2DInto(): no file opened\n"
         "Trade::AbstractImporter::image3D(): no file opened\n"
         "Trade::AbstractImporter::image3D(): no file opened\n"
 
@@ -3715,6 +3739,188 @@ void AbstractImporterTest::image2DCustomDeleter() {
         "Trade::AbstractImporter::image2D(): implementation is not allowed to use a custom Array deleter\n");
 }
 
+void AbstractImporterTest::image2DProperties() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 8; }
+        UnsignedInt doImage2DLevelCount(UnsignedInt) override { return 3; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level) override {
+            if(id == 7 && level == 2) return ImageData2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {1, 3}, Containers::Array<char>{9}};
+            else return {};
+        }
+    } importer;
+
+    /* The default implementation goes through doImage2D() */
+    Containers::Optional<ImageView2D> properties = importer.image2DProperties(7, 2);
+    CORRADE_VERIFY(properties);
+    CORRADE_COMPARE(properties->storage().alignment(), 1);
+    CORRADE_COMPARE(properties->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(properties->pixelSize(), 3);
+    CORRADE_COMPARE(properties->size(), (Vector2i{1, 3}));
+    CORRADE_VERIFY(!properties->data().data());
+
+    /* Import failure is propagated */
+    CORRADE_VERIFY(!importer.image2DProperties(7, 1));
+}
+
+void AbstractImporterTest::image2DPropertiesCompressed() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt, UnsignedInt) override {
+            return ImageData2D{CompressedPixelFormat::Bc1RGBAUnorm, {4, 4}, Containers::Array<char>{8}};
+        }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.image2DProperties(0));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::image2DProperties(): compressed images are not supported\n");
+}
+
+void AbstractImporterTest::image2DPropertiesOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 8; }
+        UnsignedInt doImage2DLevelCount(UnsignedInt) override { return 3; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.image2DProperties(8);
+    importer.image2DProperties(7, 3);
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImporter::image2DProperties(): index 8 out of range for 8 entries\n"
+        "Trade::AbstractImporter::image2DProperties(): level 3 out of range for 3 entries\n");
+}
+
+void AbstractImporterTest::image2DInto() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt, UnsignedInt) override {
+            Containers::Array<char> data{Containers::InPlaceInit, {
+                1, 2, 3, 4, 5, 6,
+                7, 8, 9, 10, 11, 12,
+                13, 14, 15, 16, 17, 18
+            }};
+            return ImageData2D{PixelStorage{}.setAlignment(1), PixelFormat::RG8Unorm, {3, 3}, std::move(data)};
+        }
+    } importer;
+
+    /* The destination has different alignment, which should be handled
+       properly */
+    char data[16];
+    std::fill_n(data, 16, '\xff');
+    CORRADE_VERIFY(importer.image2DInto(0, MutableImageView2D{PixelFormat::RG8Unorm, {3, 2}, data}, 1));
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<char>({
+        7, 8, 9, 10, 11, 12, '\xff', '\xff',
+        13, 14, 15, 16, 17, 18, '\xff', '\xff'
+    }), TestSuite::Compare::Container);
+}
+
+void AbstractImporterTest::image2DIntoCompressed() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt, UnsignedInt) override {
+            return ImageData2D{CompressedPixelFormat::Bc1RGBAUnorm, {4, 4}, Containers::Array<char>{8}};
+        }
+    } importer;
+
+    char data[64];
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.image2DInto(0, MutableImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, data}));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::image2DInto(): compressed images are not supported\n");
+}
+
+void AbstractImporterTest::image2DIntoWrongDestination() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt, UnsignedInt) override {
+            return ImageData2D{PixelFormat::RG8Unorm, {2, 3}, Containers::Array<char>{16}};
+        }
+    } importer;
+
+    char data[64];
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.image2DInto(0, MutableImageView2D{PixelFormat::RGBA8Unorm, {2, 3}, data}));
+    CORRADE_VERIFY(!importer.image2DInto(0, MutableImageView2D{PixelFormat::RG8Unorm, {3, 3}, data}));
+    CORRADE_VERIFY(!importer.image2DInto(0, MutableImageView2D{PixelFormat::RG8Unorm, {2, 2}, data}, 2));
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImporter::image2DInto(): expected destination format PixelFormat::RG8Unorm but got PixelFormat::RGBA8Unorm\n"
+        "Trade::AbstractImporter::image2DInto(): expected destination width 2 but got 3\n"
+        "Trade::AbstractImporter::image2DInto(): rows 2 to 4 out of range for 3 rows\n");
+}
+
+void AbstractImporterTest::image2DIntoOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 8; }
+        UnsignedInt doImage2DLevelCount(UnsignedInt) override { return 3; }
+    } importer;
+
+    char data[4];
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.image2DInto(8, MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data});
+    importer.image2DInto(7, MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data}, 0, 3);
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImporter::image2DInto(): index 8 out of range for 8 entries\n"
+        "Trade::AbstractImporter::image2DInto(): level 3 out of range for 3 entries\n");
+}
+
+void AbstractImporterTest::image2DIntoNoData() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.image2DInto(0, MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::image2DInto(): destination has no data\n");
+}
+
 void AbstractImporterTest::image3D() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override { return {}; }
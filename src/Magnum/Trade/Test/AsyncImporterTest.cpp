@@ -0,0 +1,389 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/ResourceManager.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AsyncImporter.h"
+#include "Magnum/Trade/AsyncResourceLoader.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct AsyncImporterTest: TestSuite::Tester {
+    explicit AsyncImporterTest();
+
+    void construct();
+    void constructPluginNotFound();
+    void importer();
+    void importerOutOfRange();
+    void importerNoWorkers();
+
+    void mesh();
+    void image2D();
+    void fileNotFound();
+    void idOutOfRange();
+    void levelOutOfRange();
+
+    void cancel();
+    void destructWithPendingRequests();
+
+    void resourceLoader();
+    void resourceLoaderNotRegistered();
+    void resourceLoaderFailed();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+    std::string _objFilename, _tgaFilename;
+};
+
+constexpr const char ObjData[] =
+    "o PointMesh\n"
+    "v 0.5 2 3\n"
+    "v 0 1.5 1\n"
+    "p 1\n"
+    "p 2\n"
+    "o TriangleMesh\n"
+    "v 0.5 2 3\n"
+    "v 0 1.5 1\n"
+    "v 2 3 5.5\n"
+    "f 3 4 5\n";
+
+/* 2x1 uncompressed BGR image */
+constexpr const char TgaData[] = {
+    0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 1, 0, 24, 0,
+    1, 2, 3, 4, 5, 6
+};
+
+AsyncImporterTest::AsyncImporterTest() {
+    addTests({&AsyncImporterTest::construct,
+              &AsyncImporterTest::constructPluginNotFound,
+              &AsyncImporterTest::importer,
+              &AsyncImporterTest::importerOutOfRange,
+              &AsyncImporterTest::importerNoWorkers,
+
+              &AsyncImporterTest::mesh,
+              &AsyncImporterTest::image2D,
+              &AsyncImporterTest::fileNotFound,
+              &AsyncImporterTest::idOutOfRange,
+              &AsyncImporterTest::levelOutOfRange,
+
+              &AsyncImporterTest::cancel,
+              &AsyncImporterTest::destructWithPendingRequests,
+
+              &AsyncImporterTest::resourceLoader,
+              &AsyncImporterTest::resourceLoaderNotRegistered,
+              &AsyncImporterTest::resourceLoaderFailed});
+
+    /* Load the plugins directly from the build tree. Otherwise they're either
+       static and already loaded or not present in the build tree */
+    #ifdef OBJIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    #ifdef TGAIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Create the input files */
+    const std::string directory = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "AsyncImporterTestFiles");
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(directory));
+    _objFilename = Utility::Directory::join(directory, "scene.obj");
+    _tgaFilename = Utility::Directory::join(directory, "image.tga");
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::write(_objFilename, Containers::arrayView(ObjData, sizeof(ObjData) - 1)));
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::write(_tgaFilename, Containers::arrayView(TgaData)));
+}
+
+void AsyncImporterTest::construct() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    AsyncImporter importer{_manager, "ObjImporter", 3};
+    CORRADE_COMPARE(importer.workerCount(), 3);
+    CORRADE_COMPARE(importer.pendingCount(), 0);
+
+    /* Waiting on nothing shouldn't block */
+    importer.wait();
+    CORRADE_COMPARE(importer.cancel(), 0);
+}
+
+void AsyncImporterTest::constructPluginNotFound() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* All requests fail right away, the error is printed on this thread */
+    AsyncImporter importer{_manager, "NonexistentImporter", 2};
+    Containers::Optional<MeshData> mesh = importer.mesh(_objFilename, 0).get();
+    CORRADE_COMPARE(importer.workerCount(), 0);
+    CORRADE_VERIFY(!mesh);
+    CORRADE_COMPARE(importer.pendingCount(), 0);
+    CORRADE_VERIFY(out.str().find("Trade::AsyncImporter: no workers available, can't import " + _objFilename + "\n") != std::string::npos);
+}
+
+void AsyncImporterTest::importer() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    AsyncImporter importer{_manager, "ObjImporter", 2};
+    CORRADE_VERIFY(&importer.importer(0) != &importer.importer(1));
+    CORRADE_COMPARE(importer.importer(1).plugin(), "ObjImporter");
+    CORRADE_VERIFY(!importer.importer(1).isOpened());
+}
+
+void AsyncImporterTest::importerOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    AsyncImporter importer{_manager, "ObjImporter", 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.importer(2);
+    CORRADE_COMPARE(out.str(), "Trade::AsyncImporter::importer(): index 2 out of range for 2 workers\n");
+}
+
+void AsyncImporterTest::importerNoWorkers() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    AsyncImporter importer{_manager, "NonexistentImporter", 2};
+    CORRADE_COMPARE(importer.workerCount(), 0);
+
+    /* Should not crash even though there's no instance to return */
+    out.str({});
+    importer.importer(0);
+    CORRADE_COMPARE(out.str(), "Trade::AsyncImporter::importer(): index 0 out of range for 0 workers\n");
+}
+
+void AsyncImporterTest::mesh() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    AsyncImporter importer{_manager, "ObjImporter", 2};
+
+    /* Queue more requests than there are workers */
+    std::vector<std::future<Containers::Optional<MeshData>>> futures;
+    for(std::size_t i = 0; i != 8; ++i)
+        futures.push_back(importer.mesh(_objFilename, i % 2));
+
+    for(std::size_t i = 0; i != futures.size(); ++i) {
+        CORRADE_ITERATION(i);
+        Containers::Optional<MeshData> mesh = futures[i].get();
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->primitive(), i % 2 ? MeshPrimitive::Triangles : MeshPrimitive::Points);
+    }
+
+    importer.wait();
+    CORRADE_COMPARE(importer.pendingCount(), 0);
+}
+
+void AsyncImporterTest::image2D() {
+    if(!(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not found, cannot test");
+
+    AsyncImporter importer{_manager, "TgaImporter", 2};
+
+    Containers::Optional<ImageData2D> image = importer.image2D(_tgaFilename, 0).get();
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image->size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(image->pixels<Color3ub>()[0][0], (Color3ub{3, 2, 1}));
+    CORRADE_COMPARE(image->pixels<Color3ub>()[0][1], (Color3ub{6, 5, 4}));
+}
+
+void AsyncImporterTest::fileNotFound() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    AsyncImporter importer{_manager, "ObjImporter", 1};
+
+    /* Error output is redirected only for this thread, so the messages
+       printed by the worker can't be checked here */
+    CORRADE_VERIFY(!importer.mesh("nonexistent.obj", 0).get());
+
+    /* A failure shouldn't affect subsequent requests */
+    CORRADE_VERIFY(importer.mesh(_objFilename, 0).get());
+}
+
+void AsyncImporterTest::idOutOfRange() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    AsyncImporter importer{_manager, "ObjImporter", 1};
+
+    /* Would assert in the importer if not checked by the worker */
+    CORRADE_VERIFY(!importer.mesh(_objFilename, 2).get());
+    CORRADE_VERIFY(importer.mesh(_objFilename, 1).get());
+}
+
+void AsyncImporterTest::levelOutOfRange() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    AsyncImporter importer{_manager, "ObjImporter", 1};
+
+    CORRADE_VERIFY(!importer.mesh(_objFilename, 0, 1).get());
+    CORRADE_VERIFY(importer.mesh(_objFilename, 0, 0).get());
+}
+
+void AsyncImporterTest::cancel() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    AsyncImporter importer{_manager, "ObjImporter", 1};
+
+    std::vector<std::future<Containers::Optional<MeshData>>> futures;
+    for(std::size_t i = 0; i != 64; ++i)
+        futures.push_back(importer.mesh(_objFilename, 1));
+
+    /* Some requests may be already processed or in progress, which is
+       timing-dependent. The rest should be cancelled. */
+    const std::size_t cancelled = importer.cancel();
+    CORRADE_COMPARE_AS(cancelled, 64, TestSuite::Compare::LessOrEqual);
+
+    std::size_t failed = 0;
+    for(std::future<Containers::Optional<MeshData>>& future: futures)
+        if(!future.get()) ++failed;
+    CORRADE_COMPARE(failed, cancelled);
+
+    importer.wait();
+    CORRADE_COMPARE(importer.pendingCount(), 0);
+}
+
+void AsyncImporterTest::destructWithPendingRequests() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    std::vector<std::future<Containers::Optional<MeshData>>> futures;
+    {
+        AsyncImporter importer{_manager, "ObjImporter", 2};
+        for(std::size_t i = 0; i != 64; ++i)
+            futures.push_back(importer.mesh(_objFilename, 0));
+    }
+
+    /* All futures should be resolved after the destruction, either with the
+       data or cancelled */
+    for(std::future<Containers::Optional<MeshData>>& future: futures)
+        CORRADE_VERIFY(future.wait_for(std::chrono::seconds{0}) == std::future_status::ready);
+}
+
+void AsyncImporterTest::resourceLoader() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    AsyncImporter importer{_manager, "ObjImporter", 2};
+
+    ResourceManager<MeshData> manager;
+    Containers::Pointer<AsyncResourceLoader<MeshData>> loaderPtr{Containers::InPlaceInit, importer};
+    AsyncResourceLoader<MeshData>& loader = *loaderPtr;
+    loader.add("points", _objFilename, 0)
+          .add("triangles", _objFilename, 1);
+    manager.setLoader<MeshData>(std::move(loaderPtr));
+
+    Resource<MeshData> points = manager.get<MeshData>("points");
+    Resource<MeshData> triangles = manager.get<MeshData>("triangles");
+    CORRADE_COMPARE(points.state(), ResourceState::Loading);
+    CORRADE_COMPARE(triangles.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader.requestedCount(), 2);
+    CORRADE_COMPARE(loader.pendingCount(), 2);
+    CORRADE_COMPARE(loader.name("points"), "points");
+
+    importer.wait();
+    CORRADE_COMPARE(loader.update(), 2);
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(loader.loadedCount(), 2);
+
+    CORRADE_COMPARE(points.state(), ResourceState::Final);
+    CORRADE_COMPARE(triangles.state(), ResourceState::Final);
+    CORRADE_COMPARE(points->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(triangles->primitive(), MeshPrimitive::Triangles);
+
+    /* Nothing more to do */
+    CORRADE_COMPARE(loader.update(), 0);
+}
+
+void AsyncImporterTest::resourceLoaderNotRegistered() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    AsyncImporter importer{_manager, "ObjImporter", 1};
+
+    ResourceManager<MeshData> manager;
+    Containers::Pointer<AsyncResourceLoader<MeshData>> loaderPtr{Containers::InPlaceInit, importer};
+    AsyncResourceLoader<MeshData>& loader = *loaderPtr;
+    manager.setLoader<MeshData>(std::move(loaderPtr));
+
+    /* Marked as not found right away, without anything being queued */
+    Resource<MeshData> mesh = manager.get<MeshData>("unknown");
+    CORRADE_COMPARE(mesh.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(loader.notFoundCount(), 1);
+    CORRADE_COMPARE(importer.pendingCount(), 0);
+}
+
+void AsyncImporterTest::resourceLoaderFailed() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not found, cannot test");
+
+    AsyncImporter importer{_manager, "ObjImporter", 1};
+
+    ResourceManager<MeshData> manager;
+    Containers::Pointer<AsyncResourceLoader<MeshData>> loaderPtr{Containers::InPlaceInit, importer};
+    AsyncResourceLoader<MeshData>& loader = *loaderPtr;
+    loader.add("mesh", _objFilename, 17);
+    manager.setLoader<MeshData>(std::move(loaderPtr));
+
+    Resource<MeshData> mesh = manager.get<MeshData>("mesh");
+    CORRADE_COMPARE(mesh.state(), ResourceState::Loading);
+
+    importer.wait();
+    CORRADE_COMPARE(loader.update(), 1);
+    CORRADE_COMPARE(mesh.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader.notFoundCount(), 1);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::AsyncImporterTest)
@@ -0,0 +1,614 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/ImporterCache.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ImporterCacheTest: TestSuite::Tester {
+    explicit ImporterCacheTest();
+
+    void openFile();
+    void openFileNotFound();
+    void openData();
+
+    void key();
+
+    void mesh();
+    void meshNotIndexed();
+    void meshProcessor();
+    void meshCorrupted();
+    void meshCorruptedVertexFormat();
+    void meshCorruptedIndexCount();
+    void meshImportFailed();
+    void meshOutOfRange();
+
+    void image2D();
+    void image2DCompressed();
+    void image2DOutOfRange();
+
+    void setMeshProcessorFileOpened();
+    void meshNoFile();
+
+    void setupCache();
+};
+
+const UnsignedShort Indices[]{0, 1, 2, 2, 1, 0};
+
+const struct Vertex {
+    Vector3 position;
+    UnsignedInt objectId;
+} Vertices[]{
+    {{1.0f, 2.0f, 3.0f}, 15},
+    {{4.0f, 5.0f, 6.0f}, 16},
+    {{7.0f, 8.0f, 9.0f}, 17}
+};
+
+const char Pixels[]{
+    1, 2, 3, 0,
+    4, 5, 6, 0,
+    7, 8, 9, 0,
+    10, 11, 12, 0
+};
+
+struct Importer: AbstractImporter {
+    ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+    bool doIsOpened() const override { return opened; }
+    void doClose() override { opened = false; }
+    void doOpenData(Containers::ArrayView<const char> data) override {
+        ++openCount;
+        opened = data.size() == 3 && data[0] == 'a';
+    }
+
+    UnsignedInt doMeshCount() const override { return 2; }
+    Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt) override {
+        ++meshCount;
+
+        Containers::Array<char> vertexData{sizeof(Vertices)};
+        Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(Vertices)), vertexData);
+        Containers::ArrayView<const Vertex> vertices = Containers::arrayCast<const Vertex>(vertexData);
+        Containers::StridedArrayView1D<const Vector3> positions{vertexData, &vertices[0].position, vertices.size(), sizeof(Vertex)};
+        Containers::StridedArrayView1D<const UnsignedInt> objectIds{vertexData, &vertices[0].objectId, vertices.size(), sizeof(Vertex)};
+
+        if(id == 1) return MeshData{MeshPrimitive::Points, std::move(vertexData), {
+            MeshAttributeData{MeshAttribute::Position, positions}
+        }};
+
+        /* Put the index data at an offset to verify it's preserved */
+        Containers::Array<char> indexData{Containers::ValueInit, 4 + sizeof(Indices)};
+        Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(Indices)), indexData.suffix(4));
+        Containers::ArrayView<const UnsignedShort> indices = Containers::arrayCast<const UnsignedShort>(indexData.suffix(4));
+
+        return MeshData{MeshPrimitive::Triangles,
+            std::move(indexData), MeshIndexData{indices},
+            std::move(vertexData), {
+                MeshAttributeData{MeshAttribute::Position, positions},
+                MeshAttributeData{MeshAttribute::ObjectId, objectIds}
+            }};
+    }
+
+    UnsignedInt doImage2DCount() const override { return 2; }
+    Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt) override {
+        ++imageCount;
+
+        Containers::Array<char> data{sizeof(Pixels)};
+        Utility::copy(Containers::arrayView(Pixels), data);
+        if(id == 1) return ImageData2D{CompressedPixelFormat::Bc1RGBAUnorm, {4, 4}, std::move(data)};
+        return ImageData2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {1, 3}, std::move(data)};
+    }
+
+    bool opened = false;
+    Int openCount = 0, meshCount = 0, imageCount = 0;
+};
+
+constexpr const char Data[]{'a', 'b', 'c'};
+
+ImporterCacheTest::ImporterCacheTest() {
+    addTests({&ImporterCacheTest::openFile,
+              &ImporterCacheTest::openFileNotFound,
+              &ImporterCacheTest::openData});
+
+    addTests({&ImporterCacheTest::key,
+
+              &ImporterCacheTest::mesh,
+              &ImporterCacheTest::meshNotIndexed,
+              &ImporterCacheTest::meshProcessor,
+              &ImporterCacheTest::meshCorrupted,
+              &ImporterCacheTest::meshCorruptedVertexFormat,
+              &ImporterCacheTest::meshCorruptedIndexCount,
+              &ImporterCacheTest::meshImportFailed,
+              &ImporterCacheTest::meshOutOfRange,
+
+              &ImporterCacheTest::image2D,
+              &ImporterCacheTest::image2DCompressed,
+              &ImporterCacheTest::image2DOutOfRange},
+        &ImporterCacheTest::setupCache,
+        &ImporterCacheTest::setupCache);
+
+    addTests({&ImporterCacheTest::setMeshProcessorFileOpened,
+              &ImporterCacheTest::meshNoFile});
+}
+
+const std::string CacheDirectory = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "ImporterCacheTestFiles");
+
+void ImporterCacheTest::setupCache() {
+    /* Remove everything from the previous runs, the cache directory is just
+       two levels deep */
+    if(!Utility::Directory::exists(CacheDirectory)) return;
+    for(const std::string& key: Utility::Directory::list(CacheDirectory, Utility::Directory::Flag::SkipDotAndDotDot)) {
+        const std::string keyDirectory = Utility::Directory::join(CacheDirectory, key);
+        for(const std::string& file: Utility::Directory::list(keyDirectory, Utility::Directory::Flag::SkipDotAndDotDot))
+            CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::rm(Utility::Directory::join(keyDirectory, file)));
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::rm(keyDirectory));
+    }
+}
+
+void ImporterCacheTest::openFile() {
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+    CORRADE_VERIFY(!cache.isOpened());
+    CORRADE_COMPARE(cache.key(), "");
+
+    CORRADE_VERIFY(cache.openFile(Utility::Directory::join(TRADE_TEST_DIR, "file.bin")));
+    CORRADE_VERIFY(cache.isOpened());
+    CORRADE_COMPARE(cache.key().size(), 40);
+
+    /* The importer is opened lazily */
+    CORRADE_VERIFY(!importer.isOpened());
+    CORRADE_COMPARE(importer.openCount, 0);
+
+    cache.close();
+    CORRADE_VERIFY(!cache.isOpened());
+    CORRADE_COMPARE(cache.key(), "");
+}
+
+void ImporterCacheTest::openFileNotFound() {
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!cache.openFile("nonexistent.bin"));
+    CORRADE_VERIFY(!cache.isOpened());
+    CORRADE_COMPARE(out.str(), "Trade::ImporterCache::openFile(): cannot open file nonexistent.bin\n");
+}
+
+void ImporterCacheTest::openData() {
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+    CORRADE_VERIFY(cache.openData(Data));
+    CORRADE_VERIFY(cache.isOpened());
+    CORRADE_VERIFY(!importer.isOpened());
+}
+
+void ImporterCacheTest::key() {
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+
+    CORRADE_VERIFY(cache.openData(Data));
+    const std::string key = cache.key();
+
+    /* Same input, same key */
+    CORRADE_VERIFY(cache.openData(Data));
+    CORRADE_COMPARE(cache.key(), key);
+
+    /* Different data */
+    CORRADE_VERIFY(cache.openData(Containers::arrayView(Data).prefix(2)));
+    CORRADE_VERIFY(cache.key() != key);
+
+    /* Different importer configuration */
+    importer.configuration().setValue("option", 3);
+    CORRADE_VERIFY(cache.openData(Data));
+    const std::string configuredKey = cache.key();
+    CORRADE_VERIFY(configuredKey != key);
+
+    /* Different processing */
+    cache.close();
+    cache.setMeshProcessor([](MeshData&& mesh, void*) {
+        return Containers::optional(std::move(mesh));
+    }, "identity");
+    CORRADE_VERIFY(cache.openData(Data));
+    CORRADE_VERIFY(cache.key() != configuredKey);
+}
+
+void ImporterCacheTest::mesh() {
+    {
+        Importer importer;
+        ImporterCache cache{importer, CacheDirectory};
+        CORRADE_VERIFY(cache.openData(Data));
+
+        Containers::Optional<MeshData> mesh = cache.mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(cache.hitCount(), 0);
+        CORRADE_COMPARE(cache.missCount(), 1);
+        CORRADE_COMPARE(importer.openCount, 1);
+        CORRADE_COMPARE(importer.meshCount, 1);
+        CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    }
+
+    /* Second time it's taken from the cache without opening the importer */
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+    CORRADE_VERIFY(cache.openData(Data));
+
+    Containers::Optional<MeshData> mesh = cache.mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 0);
+    CORRADE_COMPARE(importer.openCount, 0);
+    CORRADE_COMPARE(importer.meshCount, 0);
+
+    CORRADE_COMPARE(mesh->indexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(mesh->indexOffset(), 4);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView(Indices),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 2);
+    CORRADE_COMPARE(mesh->attributeName(0), MeshAttribute::Position);
+    CORRADE_COMPARE(mesh->attributeFormat(0), VertexFormat::Vector3);
+    CORRADE_COMPARE(mesh->attributeOffset(0), 0);
+    CORRADE_COMPARE(mesh->attributeStride(0), sizeof(Vertex));
+    CORRADE_COMPARE(mesh->attributeName(1), MeshAttribute::ObjectId);
+    CORRADE_COMPARE(mesh->attributeFormat(1), VertexFormat::UnsignedInt);
+    CORRADE_COMPARE(mesh->attributeOffset(1), sizeof(Vector3));
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        (Containers::StridedArrayView1D<const Vector3>{Vertices, &Vertices[0].position, 3, sizeof(Vertex)}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<UnsignedInt>(MeshAttribute::ObjectId),
+        (Containers::StridedArrayView1D<const UnsignedInt>{Vertices, &Vertices[0].objectId, 3, sizeof(Vertex)}),
+        TestSuite::Compare::Container);
+}
+
+void ImporterCacheTest::meshNotIndexed() {
+    {
+        Importer importer;
+        ImporterCache cache{importer, CacheDirectory};
+        CORRADE_VERIFY(cache.openData(Data));
+        CORRADE_VERIFY(cache.mesh(1));
+        CORRADE_COMPARE(cache.missCount(), 1);
+    }
+
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+    CORRADE_VERIFY(cache.openData(Data));
+
+    Containers::Optional<MeshData> mesh = cache.mesh(1);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(importer.openCount, 0);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!mesh->isIndexed());
+    CORRADE_COMPARE(mesh->attributeCount(), 1);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        (Containers::StridedArrayView1D<const Vector3>{Vertices, &Vertices[0].position, 3, sizeof(Vertex)}),
+        TestSuite::Compare::Container);
+}
+
+void ImporterCacheTest::meshProcessor() {
+    const auto processor = [](MeshData&& mesh, void* userData) {
+        ++*static_cast<Int*>(userData);
+        /* Drop the indices */
+        return Containers::optional(MeshData{mesh.primitive(), mesh.releaseVertexData(), mesh.releaseAttributeData()});
+    };
+
+    Int called = 0;
+    {
+        Importer importer;
+        ImporterCache cache{importer, CacheDirectory};
+        cache.setMeshProcessor(processor, "dropIndices", &called);
+        CORRADE_VERIFY(cache.openData(Data));
+        Containers::Optional<MeshData> mesh = cache.mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_VERIFY(!mesh->isIndexed());
+        CORRADE_COMPARE(called, 1);
+    }
+
+    /* Cached with the processing applied, not calling the processor again */
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+    cache.setMeshProcessor(processor, "dropIndices", &called);
+    CORRADE_VERIFY(cache.openData(Data));
+    Containers::Optional<MeshData> mesh = cache.mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(!mesh->isIndexed());
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(called, 1);
+
+    /* Without the processor it's a different entry */
+    cache.close();
+    cache.setMeshProcessor(nullptr, {});
+    CORRADE_VERIFY(cache.openData(Data));
+    mesh = cache.mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_COMPARE(cache.missCount(), 1);
+}
+
+void ImporterCacheTest::meshCorrupted() {
+    std::string key;
+    {
+        Importer importer;
+        ImporterCache cache{importer, CacheDirectory};
+        CORRADE_VERIFY(cache.openData(Data));
+        CORRADE_VERIFY(cache.mesh(0));
+        key = cache.key();
+    }
+
+    /* Truncate the file */
+    const std::string filename = Utility::Directory::join({CacheDirectory, key, "mesh-0-0.bin"});
+    Containers::Array<char> data = Utility::Directory::read(filename);
+    CORRADE_VERIFY(data.size() > 100);
+    CORRADE_VERIFY(Utility::Directory::write(filename, data.prefix(100)));
+
+    /* It should get reimported and fixed */
+    {
+        Importer importer;
+        ImporterCache cache{importer, CacheDirectory};
+        CORRADE_VERIFY(cache.openData(Data));
+        Containers::Optional<MeshData> mesh = cache.mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(cache.missCount(), 1);
+        CORRADE_COMPARE(importer.meshCount, 1);
+        CORRADE_COMPARE(mesh->vertexCount(), 3);
+    }
+
+    CORRADE_COMPARE(Utility::Directory::read(filename).size(), data.size());
+}
+
+void ImporterCacheTest::meshCorruptedVertexFormat() {
+    std::string key;
+    {
+        Importer importer;
+        ImporterCache cache{importer, CacheDirectory};
+        CORRADE_VERIFY(cache.openData(Data));
+        CORRADE_VERIFY(cache.mesh(0));
+        key = cache.key();
+    }
+
+    /* Replace the format of the first attribute with a value that's outside
+       of the enum range. The attribute records are right after the 64-byte
+       file header and the 64-byte mesh header, the format is after the
+       64-bit offset. */
+    const std::string filename = Utility::Directory::join({CacheDirectory, key, "mesh-0-0.bin"});
+    Containers::Array<char> data = Utility::Directory::read(filename);
+    CORRADE_VERIFY(data.size() > 64 + 64 + 8 + 4);
+    const UnsignedInt format = 0xdead;
+    std::memcpy(data + 64 + 64 + 8, &format, 4);
+    CORRADE_VERIFY(Utility::Directory::write(filename, data));
+
+    /* It should get reimported instead of asserting */
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+    CORRADE_VERIFY(cache.openData(Data));
+    Containers::Optional<MeshData> mesh = cache.mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(cache.missCount(), 1);
+    CORRADE_COMPARE(importer.meshCount, 1);
+    CORRADE_COMPARE(mesh->attributeFormat(0), VertexFormat::Vector3);
+}
+
+void ImporterCacheTest::meshCorruptedIndexCount() {
+    std::string key;
+    {
+        Importer importer;
+        ImporterCache cache{importer, CacheDirectory};
+        CORRADE_VERIFY(cache.openData(Data));
+        CORRADE_VERIFY(cache.mesh(0));
+        key = cache.key();
+    }
+
+    /* Zero the index count while keeping the index type and data. The index
+       count is after the primitive and vertex count in the mesh header. */
+    const std::string filename = Utility::Directory::join({CacheDirectory, key, "mesh-0-0.bin"});
+    Containers::Array<char> data = Utility::Directory::read(filename);
+    CORRADE_VERIFY(data.size() > 64 + 8 + 4);
+    const UnsignedInt indexCount = 0;
+    std::memcpy(data + 64 + 8, &indexCount, 4);
+    CORRADE_VERIFY(Utility::Directory::write(filename, data));
+
+    /* It should get reimported instead of asserting, and the rejected entry
+       replaced even though it was mapped during the validation */
+    {
+        Importer importer;
+        ImporterCache cache{importer, CacheDirectory};
+        CORRADE_VERIFY(cache.openData(Data));
+        Containers::Optional<MeshData> mesh = cache.mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(cache.missCount(), 1);
+        CORRADE_COMPARE(importer.meshCount, 1);
+        CORRADE_VERIFY(mesh->isIndexed());
+        CORRADE_COMPARE(mesh->indexCount(), 6);
+    }
+
+    /* The fixed entry is a hit next time */
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+    CORRADE_VERIFY(cache.openData(Data));
+    Containers::Optional<MeshData> mesh = cache.mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(importer.meshCount, 0);
+    CORRADE_COMPARE(mesh->indexCount(), 6);
+}
+
+void ImporterCacheTest::meshImportFailed() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+        void doOpenData(Containers::ArrayView<const char>) override {}
+
+        UnsignedInt doMeshCount() const override { return 1; }
+        Containers::Optional<MeshData> doMesh(UnsignedInt, UnsignedInt) override {
+            return {};
+        }
+    } importer;
+
+    ImporterCache cache{importer, CacheDirectory};
+    CORRADE_VERIFY(cache.openData(Data));
+    CORRADE_VERIFY(!cache.mesh(0));
+    CORRADE_VERIFY(!Utility::Directory::exists(Utility::Directory::join({CacheDirectory, cache.key(), "mesh-0-0.bin"})));
+}
+
+void ImporterCacheTest::meshOutOfRange() {
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+    CORRADE_VERIFY(cache.openData(Data));
+
+    /* The importer would assert, the cache checks the ID because it can't be
+       done before the importer is opened */
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!cache.mesh(2));
+    CORRADE_VERIFY(!cache.mesh(0, 1));
+    CORRADE_COMPARE(importer.meshCount, 0);
+    CORRADE_COMPARE(out.str(),
+        "Trade::ImporterCache::mesh(): index 2 out of range for 2 entries\n"
+        "Trade::ImporterCache::mesh(): level 1 out of range for 1 entries\n");
+}
+
+void ImporterCacheTest::image2D() {
+    {
+        Importer importer;
+        ImporterCache cache{importer, CacheDirectory};
+        CORRADE_VERIFY(cache.openData(Data));
+        CORRADE_VERIFY(cache.image2D(0));
+        CORRADE_COMPARE(importer.imageCount, 1);
+    }
+
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+    CORRADE_VERIFY(cache.openData(Data));
+
+    Containers::Optional<ImageData2D> image = cache.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(importer.openCount, 0);
+    CORRADE_COMPARE(importer.imageCount, 0);
+    CORRADE_VERIFY(!image->isCompressed());
+    CORRADE_COMPARE(image->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image->size(), (Vector2i{1, 3}));
+    CORRADE_COMPARE_AS(image->data(),
+        Containers::arrayView(Pixels),
+        TestSuite::Compare::Container);
+}
+
+void ImporterCacheTest::image2DCompressed() {
+    {
+        Importer importer;
+        ImporterCache cache{importer, CacheDirectory};
+        CORRADE_VERIFY(cache.openData(Data));
+        CORRADE_VERIFY(cache.image2D(1));
+    }
+
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+    CORRADE_VERIFY(cache.openData(Data));
+
+    Containers::Optional<ImageData2D> image = cache.image2D(1);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_VERIFY(image->isCompressed());
+    CORRADE_COMPARE(image->compressedFormat(), CompressedPixelFormat::Bc1RGBAUnorm);
+    CORRADE_COMPARE(image->size(), (Vector2i{4, 4}));
+    CORRADE_COMPARE_AS(image->data(),
+        Containers::arrayView(Pixels),
+        TestSuite::Compare::Container);
+}
+
+void ImporterCacheTest::image2DOutOfRange() {
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+    CORRADE_VERIFY(cache.openData(Data));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!cache.image2D(2));
+    CORRADE_VERIFY(!cache.image2D(0, 1));
+    CORRADE_COMPARE(importer.imageCount, 0);
+    CORRADE_COMPARE(out.str(),
+        "Trade::ImporterCache::image2D(): index 2 out of range for 2 entries\n"
+        "Trade::ImporterCache::image2D(): level 1 out of range for 1 entries\n");
+}
+
+void ImporterCacheTest::setMeshProcessorFileOpened() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+    CORRADE_VERIFY(cache.openData(Data));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.setMeshProcessor(nullptr, {});
+    CORRADE_COMPARE(out.str(), "Trade::ImporterCache::setMeshProcessor(): can't be set while a file is opened\n");
+}
+
+void ImporterCacheTest::meshNoFile() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Importer importer;
+    ImporterCache cache{importer, CacheDirectory};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.mesh(0);
+    cache.image2D(0);
+    CORRADE_COMPARE(out.str(),
+        "Trade::ImporterCache::mesh(): no file opened\n"
+        "Trade::ImporterCache::image2D(): no file opened\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ImporterCacheTest)
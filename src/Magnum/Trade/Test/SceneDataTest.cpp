@@ -23,9 +23,16 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/Trade/ObjectData3D.h"
 #include "Magnum/Trade/SceneData.h"
 
 namespace Magnum { namespace Trade { namespace Test { namespace {
@@ -36,12 +43,24 @@ struct SceneDataTest: TestSuite::Tester {
     void construct();
     void constructCopy();
     void constructMove();
+
+    void hierarchy3D();
+    void hierarchy3DEmpty();
+    void hierarchy3DOutOfBounds();
+    void hierarchy3DNull();
+    void hierarchy3DReferencedTwice();
 };
 
 SceneDataTest::SceneDataTest() {
     addTests({&SceneDataTest::construct,
               &SceneDataTest::constructCopy,
-              &SceneDataTest::constructMove});
+              &SceneDataTest::constructMove,
+
+              &SceneDataTest::hierarchy3D,
+              &SceneDataTest::hierarchy3DEmpty,
+              &SceneDataTest::hierarchy3DOutOfBounds,
+              &SceneDataTest::hierarchy3DNull,
+              &SceneDataTest::hierarchy3DReferencedTwice});
 }
 
 void SceneDataTest::construct() {
@@ -80,6 +99,86 @@ void SceneDataTest::constructMove() {
     CORRADE_VERIFY(std::is_nothrow_move_assignable<SceneData>::value);
 }
 
+void SceneDataTest::hierarchy3D() {
+    /*
+        4
+        |-- 1
+        |   |-- 0
+        |   \-- 3
+        \-- 5
+        2
+            \-- 6
+
+        Object 7 is not referenced from anywhere.
+    */
+    Containers::Pointer<ObjectData3D> objects[8];
+    objects[0].emplace(std::vector<UnsignedInt>{}, Matrix4{});
+    objects[1].emplace(std::vector<UnsignedInt>{0, 3}, Matrix4{});
+    objects[2].emplace(std::vector<UnsignedInt>{6}, Matrix4{});
+    objects[3].emplace(std::vector<UnsignedInt>{}, Matrix4{});
+    objects[4].emplace(std::vector<UnsignedInt>{1, 5}, Matrix4{});
+    objects[5].emplace(std::vector<UnsignedInt>{}, Matrix4{});
+    objects[6].emplace(std::vector<UnsignedInt>{}, Matrix4{});
+    objects[7].emplace(std::vector<UnsignedInt>{}, Matrix4{});
+
+    const SceneData data{{}, {4, 2}};
+    Containers::Optional<Containers::Array<std::pair<UnsignedInt, Int>>> hierarchy = data.hierarchy3D(objects);
+    CORRADE_VERIFY(hierarchy);
+    CORRADE_COMPARE_AS(*hierarchy, (Containers::Array<std::pair<UnsignedInt, Int>>{Containers::InPlaceInit, {
+        {4, -1},
+        {1, 0},
+        {0, 1},
+        {3, 1},
+        {5, 0},
+        {2, -1},
+        {6, 5}
+    }}), TestSuite::Compare::Container);
+}
+
+void SceneDataTest::hierarchy3DEmpty() {
+    const SceneData data{{0, 1}, {}};
+    Containers::Optional<Containers::Array<std::pair<UnsignedInt, Int>>> hierarchy = data.hierarchy3D(nullptr);
+    CORRADE_VERIFY(hierarchy);
+    CORRADE_VERIFY(hierarchy->empty());
+}
+
+void SceneDataTest::hierarchy3DOutOfBounds() {
+    Containers::Pointer<ObjectData3D> objects[2];
+    objects[0].emplace(std::vector<UnsignedInt>{1}, Matrix4{});
+    objects[1].emplace(std::vector<UnsignedInt>{2}, Matrix4{});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    const SceneData data{{}, {0}};
+    CORRADE_VERIFY(!data.hierarchy3D(objects));
+    CORRADE_COMPARE(out.str(), "Trade::SceneData::hierarchy3D(): object 2 out of bounds for 2 objects\n");
+}
+
+void SceneDataTest::hierarchy3DNull() {
+    Containers::Pointer<ObjectData3D> objects[2];
+    objects[0].emplace(std::vector<UnsignedInt>{1}, Matrix4{});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    const SceneData data{{}, {0}};
+    CORRADE_VERIFY(!data.hierarchy3D(objects));
+    CORRADE_COMPARE(out.str(), "Trade::SceneData::hierarchy3D(): object 1 is null\n");
+}
+
+void SceneDataTest::hierarchy3DReferencedTwice() {
+    /* A cycle would be caught the same way */
+    Containers::Pointer<ObjectData3D> objects[3];
+    objects[0].emplace(std::vector<UnsignedInt>{2}, Matrix4{});
+    objects[1].emplace(std::vector<UnsignedInt>{2}, Matrix4{});
+    objects[2].emplace(std::vector<UnsignedInt>{}, Matrix4{});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    const SceneData data{{}, {0, 1}};
+    CORRADE_VERIFY(!data.hierarchy3D(objects));
+    CORRADE_COMPARE(out.str(), "Trade::SceneData::hierarchy3D(): object 2 is referenced more than once\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::SceneDataTest)
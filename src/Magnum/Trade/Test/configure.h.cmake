@@ -25,3 +25,5 @@
 
 #define TRADE_TEST_DIR "${TRADE_TEST_DIR}"
 #define TRADE_TEST_OUTPUT_DIR "${TRADE_TEST_OUTPUT_DIR}"
+#cmakedefine OBJIMPORTER_PLUGIN_FILENAME "${OBJIMPORTER_PLUGIN_FILENAME}"
+#cmakedefine TGAIMPORTER_PLUGIN_FILENAME "${TGAIMPORTER_PLUGIN_FILENAME}"
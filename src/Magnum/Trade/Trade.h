@@ -57,6 +57,11 @@ enum class AnimationTrackType: UnsignedByte;
 class AnimationTrackData;
 class AnimationData;
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+class AsyncImporter;
+template<class> class AsyncResourceLoader;
+#endif
+
 enum class CameraType: UnsignedByte;
 class CameraData;
 
@@ -68,6 +73,8 @@ typedef ImageData<1> ImageData1D;
 typedef ImageData<2> ImageData2D;
 typedef ImageData<3> ImageData3D;
 
+class ImporterCache;
+
 class LightData;
 
 enum class MeshAttribute: UnsignedShort;
@@ -28,6 +28,7 @@
 #cmakedefine MAGNUM_BUILD_DEPRECATED
 #cmakedefine MAGNUM_BUILD_STATIC
 #cmakedefine MAGNUM_BUILD_STATIC_UNIQUE_GLOBALS
+#cmakedefine MAGNUM_BUILD_TRACING
 #cmakedefine MAGNUM_TARGET_GL
 #cmakedefine MAGNUM_TARGET_GLES
 #cmakedefine MAGNUM_TARGET_GLES2
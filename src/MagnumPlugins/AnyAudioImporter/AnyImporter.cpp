@@ -89,7 +89,14 @@ UnsignedInt AnyImporter::doFrequency() const { return _in->frequency(); }
 
 Containers::Array<char> AnyImporter::doData() { return _in->data(); }
 
+std::size_t AnyImporter::doFrameCount() { return _in->frameCount(); }
+
+std::size_t AnyImporter::doReadFrames(const std::size_t offset, const Containers::ArrayView<char> destination) {
+    _in->seek(offset);
+    return _in->readFrames(destination);
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyAudioImporter, Magnum::Audio::AnyImporter,
-    "cz.mosra.magnum.Audio.AbstractImporter/0.1")
+    "cz.mosra.magnum.Audio.AbstractImporter/0.2")
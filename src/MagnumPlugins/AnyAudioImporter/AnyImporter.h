@@ -119,6 +119,8 @@ class MAGNUM_ANYAUDIOIMPORTER_EXPORT AnyImporter: public AbstractImporter {
         MAGNUM_ANYAUDIOIMPORTER_LOCAL BufferFormat doFormat() const override;
         MAGNUM_ANYAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_ANYAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL std::size_t doFrameCount() override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL std::size_t doReadFrames(std::size_t offset, Containers::ArrayView<char> destination) override;
 
         Containers::Pointer<AbstractImporter> _in;
 };
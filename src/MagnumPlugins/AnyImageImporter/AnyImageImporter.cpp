@@ -236,7 +236,11 @@ UnsignedInt AnyImageImporter::doImage2DLevelCount(UnsignedInt id) { return _in->
 
 Containers::Optional<ImageData2D> AnyImageImporter::doImage2D(const UnsignedInt id, const UnsignedInt level) { return _in->image2D(id, level); }
 
+Containers::Optional<ImageView2D> AnyImageImporter::doImage2DProperties(const UnsignedInt id, const UnsignedInt level) { return _in->image2DProperties(id, level); }
+
+bool AnyImageImporter::doImage2DInto(const UnsignedInt id, const MutableImageView2D& destination, const UnsignedInt rowOffset, const UnsignedInt level) { return _in->image2DInto(id, destination, rowOffset, level); }
+
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyImageImporter, Magnum::Trade::AnyImageImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3.1")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.2")
@@ -165,6 +165,8 @@ class MAGNUM_ANYIMAGEIMPORTER_EXPORT AnyImageImporter: public AbstractImporter {
         MAGNUM_ANYIMAGEIMPORTER_LOCAL UnsignedInt doImage2DCount() const override;
         MAGNUM_ANYIMAGEIMPORTER_LOCAL UnsignedInt doImage2DLevelCount(UnsignedInt id) override;
         MAGNUM_ANYIMAGEIMPORTER_LOCAL Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level) override;
+        MAGNUM_ANYIMAGEIMPORTER_LOCAL Containers::Optional<ImageView2D> doImage2DProperties(UnsignedInt id, UnsignedInt level) override;
+        MAGNUM_ANYIMAGEIMPORTER_LOCAL bool doImage2DInto(UnsignedInt id, const MutableImageView2D& destination, UnsignedInt rowOffset, UnsignedInt level) override;
 
         Containers::Pointer<AbstractImporter> _in;
 };
@@ -235,6 +235,8 @@ UnsignedInt AnySceneImporter::doImage2DLevelCount(UnsignedInt id) { return _in->
 Int AnySceneImporter::doImage2DForName(const std::string& name) { return _in->image2DForName(name); }
 std::string AnySceneImporter::doImage2DName(const UnsignedInt id) { return _in->image2DName(id); }
 Containers::Optional<ImageData2D> AnySceneImporter::doImage2D(const UnsignedInt id, const UnsignedInt level) { return _in->image2D(id, level); }
+Containers::Optional<ImageView2D> AnySceneImporter::doImage2DProperties(const UnsignedInt id, const UnsignedInt level) { return _in->image2DProperties(id, level); }
+bool AnySceneImporter::doImage2DInto(const UnsignedInt id, const MutableImageView2D& destination, const UnsignedInt rowOffset, const UnsignedInt level) { return _in->image2DInto(id, destination, rowOffset, level); }
 
 UnsignedInt AnySceneImporter::doImage3DCount() const { return _in->image3DCount(); }
 UnsignedInt AnySceneImporter::doImage3DLevelCount(UnsignedInt id) { return _in->image3DLevelCount(id); }
@@ -245,4 +247,4 @@ Containers::Optional<ImageData3D> AnySceneImporter::doImage3D(const UnsignedInt
 }}
 
 CORRADE_PLUGIN_REGISTER(AnySceneImporter, Magnum::Trade::AnySceneImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3.1")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.2")
@@ -221,6 +221,8 @@ class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
         MAGNUM_ANYSCENEIMPORTER_LOCAL Int doImage2DForName(const std::string& name) override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL std::string doImage2DName(UnsignedInt id) override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level) override;
+        MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::Optional<ImageView2D> doImage2DProperties(UnsignedInt id, UnsignedInt level) override;
+        MAGNUM_ANYSCENEIMPORTER_LOCAL bool doImage2DInto(UnsignedInt id, const MutableImageView2D& destination, UnsignedInt rowOffset, UnsignedInt level) override;
 
         MAGNUM_ANYSCENEIMPORTER_LOCAL UnsignedInt doImage3DCount() const override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL UnsignedInt doImage3DLevelCount(UnsignedInt id) override;
@@ -26,6 +26,7 @@
 #include "MagnumFont.h"
 
 #include <sstream>
+#include <unordered_map>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Configuration.h>
@@ -40,32 +41,52 @@
 
 namespace Magnum { namespace Text {
 
+namespace {
+    class MagnumFontLayouter: public AbstractLayouter {
+        public:
+            explicit MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, Float fontSize, Float textSize, std::vector<UnsignedInt>&& glyphs);
+
+            /* Used by doLayoutInto() to reuse the instance for a new text,
+               the glyphs are expected to be filled already */
+            void reset(const AbstractGlyphCache& cache, Float textSize);
+
+            std::vector<UnsignedInt> glyphs;
+
+        private:
+            std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override;
+
+            const std::vector<Vector2>& glyphAdvance;
+            const AbstractGlyphCache* cache;
+            const Float fontSize;
+            Float textSize;
+    };
+}
+
 struct MagnumFont::Data {
     /* Otherwise Clang complains about Utility::Configuration having explicit
        constructor when emplace()ing the Pointer. Using = default works on
        newer Clang but not older versions. */
     explicit Data() {}
 
+    void glyphsInto(Containers::ArrayView<const char> text, std::vector<UnsignedInt>& glyphs) const;
+
     Utility::Configuration conf;
     Containers::Optional<Trade::ImageData2D> image;
     Containers::Optional<std::string> filePath;
     std::unordered_map<char32_t, UnsignedInt> glyphId;
     std::vector<Vector2> glyphAdvance;
+    /* Reused by doLayoutInto() */
+    Containers::Pointer<MagnumFontLayouter> layouter;
 };
 
-namespace {
-    class MagnumFontLayouter: public AbstractLayouter {
-        public:
-            explicit MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, Float fontSize, Float textSize, std::vector<UnsignedInt>&& glyphs);
-
-        private:
-            std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override;
-
-            const std::vector<Vector2>& glyphAdvance;
-            const AbstractGlyphCache& cache;
-            const Float fontSize, textSize;
-            const std::vector<UnsignedInt> glyphs;
-    };
+void MagnumFont::Data::glyphsInto(const Containers::ArrayView<const char> text, std::vector<UnsignedInt>& glyphs) const {
+    /* Get glyph codes from characters */
+    for(std::size_t i = 0; i != text.size(); ) {
+        UnsignedInt codepoint;
+        std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
+        const auto it = glyphId.find(codepoint);
+        glyphs.push_back(it == glyphId.end() ? 0 : it->second);
+    }
 }
 
 MagnumFont::MagnumFont(): _opened(nullptr) {}
@@ -168,31 +189,44 @@ Containers::Pointer<AbstractGlyphCache> MagnumFont::doCreateGlyphCache() {
 }
 
 Containers::Pointer<AbstractLayouter> MagnumFont::doLayout(const AbstractGlyphCache& cache, Float size, const std::string& text) {
-    /* Get glyph codes from characters */
     std::vector<UnsignedInt> glyphs;
     glyphs.reserve(text.size());
-    for(std::size_t i = 0; i != text.size(); ) {
-        UnsignedInt codepoint;
-        std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
-        const auto it = _opened->glyphId.find(codepoint);
-        glyphs.push_back(it == _opened->glyphId.end() ? 0 : it->second);
-    }
+    _opened->glyphsInto({text.data(), text.size()}, glyphs);
 
     return Containers::Pointer<MagnumFontLayouter>(new MagnumFontLayouter(_opened->glyphAdvance, cache, this->size(), size, std::move(glyphs)));
 }
 
+AbstractLayouter& MagnumFont::doLayoutInto(const AbstractGlyphCache& cache, const Float size, const Containers::ArrayView<const char> text) {
+    /* Create the layouter on first use, then only refill its glyph array,
+       which doesn't reallocate unless the text is longer than any before */
+    if(!_opened->layouter)
+        _opened->layouter.reset(new MagnumFontLayouter(_opened->glyphAdvance, cache, this->size(), size, {}));
+
+    MagnumFontLayouter& layouter = *_opened->layouter;
+    layouter.glyphs.clear();
+    _opened->glyphsInto(text, layouter.glyphs);
+    layouter.reset(cache, size);
+    return layouter;
+}
+
 namespace {
 
-MagnumFontLayouter::MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, const Float fontSize, const Float textSize, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), glyphAdvance(glyphAdvance), cache(cache), fontSize(fontSize), textSize(textSize), glyphs(std::move(glyphs)) {}
+MagnumFontLayouter::MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, const Float fontSize, const Float textSize, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), glyphs(std::move(glyphs)), glyphAdvance(glyphAdvance), cache(&cache), fontSize(fontSize), textSize(textSize) {}
+
+void MagnumFontLayouter::reset(const AbstractGlyphCache& cache, const Float textSize) {
+    this->cache = &cache;
+    this->textSize = textSize;
+    setGlyphCount(UnsignedInt(glyphs.size()));
+}
 
 std::tuple<Range2D, Range2D, Vector2> MagnumFontLayouter::doRenderGlyph(const UnsignedInt i) {
     /* Position of the texture in the resulting glyph, texture coordinates */
     Vector2i position;
     Range2Di rectangle;
-    std::tie(position, rectangle) = cache[glyphs[i]];
+    std::tie(position, rectangle) = (*cache)[glyphs[i]];
 
     /* Normalized texture coordinates */
-    const auto textureCoordinates = Range2D(rectangle).scaled(1.0f/Vector2(cache.textureSize()));
+    const auto textureCoordinates = Range2D(rectangle).scaled(1.0f/Vector2(cache->textureSize()));
 
     /* Quad rectangle, computed from texture rectangle, denormalized to
        requested text size */
@@ -209,4 +243,4 @@ std::tuple<Range2D, Range2D, Vector2> MagnumFontLayouter::doRenderGlyph(const Un
 }}
 
 CORRADE_PLUGIN_REGISTER(MagnumFont, Magnum::Text::MagnumFont,
-    "cz.mosra.magnum.Text.AbstractFont/0.3")
+    "cz.mosra.magnum.Text.AbstractFont/0.3.1")
@@ -23,9 +23,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
+#include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
@@ -45,6 +48,7 @@ struct MagnumFontTest: TestSuite::Tester {
     void nonexistent();
     void properties();
     void layout();
+    void layoutInto();
 
     void fileCallbackImage();
     void fileCallbackImageNotFound();
@@ -58,6 +62,7 @@ MagnumFontTest::MagnumFontTest() {
     addTests({&MagnumFontTest::nonexistent,
               &MagnumFontTest::properties,
               &MagnumFontTest::layout,
+              &MagnumFontTest::layoutInto,
 
               &MagnumFontTest::fileCallbackImage,
               &MagnumFontTest::fileCallbackImageNotFound});
@@ -140,6 +145,50 @@ void MagnumFontTest::layout() {
     CORRADE_COMPARE(cursorPosition, Vector2(0.375f, 0.0f));
 }
 
+void MagnumFontTest::layoutInto() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    CORRADE_VERIFY(font->openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
+
+    struct DummyGlyphCache: AbstractGlyphCache {
+        using AbstractGlyphCache::AbstractGlyphCache;
+
+        GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{Vector2i{256}};
+    cache.insert(font->glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(font->glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
+
+    /* Do the same twice to verify the internal layouter gets properly
+       reused, the second time with a shorter text */
+    for(const char* text: {"Wave", "eW"}) {
+        CORRADE_ITERATION(text);
+
+        Vector2 positions[16];
+        Vector2 textureCoordinates[16];
+        Vector2 cursorPosition{1.0f, 0.5f};
+        Range2D rectangle;
+        const UnsignedInt glyphCount = font->layoutInto(cache, 0.5f, {text, std::strlen(text)}, cursorPosition, rectangle, positions, textureCoordinates);
+
+        /* Should give the same result as the layouter */
+        Containers::Pointer<AbstractLayouter> layouter = font->layout(cache, 0.5f, text);
+        CORRADE_COMPARE(glyphCount, layouter->glyphCount());
+        Vector2 expectedCursorPosition{1.0f, 0.5f};
+        Range2D expectedRectangle;
+        for(UnsignedInt i = 0; i != glyphCount; ++i) {
+            CORRADE_ITERATION(i);
+            Range2D position, textureCoordinate;
+            std::tie(position, textureCoordinate) = layouter->renderGlyph(i, expectedCursorPosition, expectedRectangle);
+            CORRADE_COMPARE(positions[i*4 + 1], position.bottomLeft());
+            CORRADE_COMPARE(positions[i*4 + 2], position.topRight());
+            CORRADE_COMPARE(textureCoordinates[i*4 + 1], textureCoordinate.bottomLeft());
+            CORRADE_COMPARE(textureCoordinates[i*4 + 2], textureCoordinate.topRight());
+        }
+        CORRADE_COMPARE(cursorPosition, expectedCursorPosition);
+        CORRADE_COMPARE(rectangle, expectedRectangle);
+    }
+}
+
 void MagnumFontTest::fileCallbackImage() {
     Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
     CORRADE_VERIFY(font->features() & FontFeature::FileCallback);
@@ -0,0 +1,170 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct TgaImageConverterBenchmark: TestSuite::Tester {
+    explicit TgaImageConverterBenchmark();
+
+    void raw();
+    void rle();
+    void rleThreaded();
+
+    void sizeBegin();
+    std::uint64_t sizeEnd();
+    void sizeRaw();
+    void sizeRle();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImageConverter> _converterManager{"nonexistent"};
+
+    Containers::Array<char> _data;
+    ImageView2D _image{PixelFormat::RGBA8Unorm, {}};
+    std::size_t _size;
+};
+
+TgaImageConverterBenchmark::TgaImageConverterBenchmark() {
+    addBenchmarks({&TgaImageConverterBenchmark::raw,
+                   &TgaImageConverterBenchmark::rle,
+                   &TgaImageConverterBenchmark::rleThreaded}, 5);
+
+    /* Output size, reported in bytes */
+    addCustomBenchmarks({&TgaImageConverterBenchmark::sizeRaw,
+                         &TgaImageConverterBenchmark::sizeRle}, 1,
+        &TgaImageConverterBenchmark::sizeBegin,
+        &TgaImageConverterBenchmark::sizeEnd,
+        BenchmarkUnits::Bytes);
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef TGAIMAGECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_converterManager.load(TGAIMAGECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* A 1080p RGBA image resembling a screenshot --- a flat background, a
+       few flat-colored rectangles, a gradient and a noisy area */
+    const Vector2i size{1920, 1080};
+    _data = Containers::Array<char>{Containers::NoInit, std::size_t(size.product()*4)};
+    UnsignedInt seed = 17;
+    for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x) {
+        char* pixel = _data + (y*size.x() + x)*4;
+        if(x > 1400 && y > 600) {
+            seed = seed*1103515245 + 12345;
+            pixel[0] = char(seed >> 16);
+            pixel[1] = char(seed >> 20);
+            pixel[2] = char(seed >> 24);
+        } else if(y < 200) {
+            pixel[0] = char(x*255/size.x());
+            pixel[1] = char(64);
+            pixel[2] = char(255 - x*255/size.x());
+        } else {
+            const bool inside = (x/240 + y/180) % 3 == 0;
+            pixel[0] = char(inside ? 200 : 32);
+            pixel[1] = char(inside ? 100 : 32);
+            pixel[2] = char(inside ? 50 : 40);
+        }
+        pixel[3] = char(255);
+    }
+    _image = ImageView2D{PixelFormat::RGBA8Unorm, size, _data};
+}
+
+void TgaImageConverterBenchmark::raw() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(5) {
+        size += converter->exportToData(_image).size();
+    }
+
+    CORRADE_VERIFY(size);
+}
+
+void TgaImageConverterBenchmark::rle() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(5) {
+        size += converter->exportToData(_image).size();
+    }
+
+    CORRADE_VERIFY(size);
+}
+
+void TgaImageConverterBenchmark::rleThreaded() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+    converter->configuration().setValue("threads", 0);
+
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(5) {
+        size += converter->exportToData(_image).size();
+    }
+
+    CORRADE_VERIFY(size);
+}
+
+void TgaImageConverterBenchmark::sizeBegin() {
+    _size = 0;
+}
+
+std::uint64_t TgaImageConverterBenchmark::sizeEnd() {
+    return _size;
+}
+
+void TgaImageConverterBenchmark::sizeRaw() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+
+    CORRADE_BENCHMARK(1) {
+        _size = converter->exportToData(_image).size();
+    }
+
+    CORRADE_VERIFY(_size);
+}
+
+void TgaImageConverterBenchmark::sizeRle() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+
+    CORRADE_BENCHMARK(1) {
+        _size = converter->exportToData(_image).size();
+    }
+
+    CORRADE_VERIFY(_size);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImageConverterBenchmark)
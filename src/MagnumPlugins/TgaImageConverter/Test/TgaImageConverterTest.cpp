@@ -23,20 +23,26 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <sstream>
 #include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/AbstractImporter.h"
+#include "MagnumPlugins/TgaImporter/TgaHeader.h"
 
 #include "configure.h"
 
@@ -50,6 +56,11 @@ struct TgaImageConverterTest: TestSuite::Tester {
     void rgb();
     void rgba();
 
+    void rle();
+    void rleLongRun();
+    void rleRoundtrip();
+    void rleThreaded();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImageConverter> _converterManager{"nonexistent"};
     PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
@@ -92,6 +103,90 @@ constexpr char OriginalDataRGBA[] = {
 };
 const ImageView2D OriginalRGBA{PixelFormat::RGBA8Unorm, {2, 3}, OriginalDataRGBA};
 
+/* Runs, a raw packet and a run of two at the end. Padded to four byte
+   alignment. */
+constexpr char OriginalDataRle[] = {
+    1, 1, 1, 2, 3, 4, 4, 0,
+    5, 5, 5, 5, 5, 5, 5, 0
+};
+constexpr char ConvertedDataRle[] = {
+    /* 3x repeated 1, raw 2 and 3, 2x repeated 4 */
+    '\x82', 1, '\x01', 2, 3, '\x81', 4,
+    /* Packets don't cross rows, so it's a separate packet here */
+    '\x86', 5
+};
+
+constexpr char OriginalDataRleRGB[] = {
+    1, 2, 3, 1, 2, 3, 4, 5, 6, 0, 0, 0
+};
+constexpr char ConvertedDataRleRGB[] = {
+    '\x81', 3, 2, 1, '\x00', 6, 5, 4
+};
+
+constexpr char OriginalDataRleRGBA[] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 5, 6, 7, 8
+};
+constexpr char ConvertedDataRleRGBA[] = {
+    '\x00', 3, 2, 1, 4, '\x81', 7, 6, 5, 8
+};
+
+const struct {
+    const char* name;
+    PixelFormat format;
+    Vector2i size;
+    Containers::ArrayView<const char> data;
+    UnsignedByte imageType;
+    Containers::ArrayView<const char> expected;
+} RleData[] {
+    {"grayscale", PixelFormat::R8Unorm, {7, 2},
+        OriginalDataRle, 11, ConvertedDataRle},
+    {"RGB", PixelFormat::RGB8Unorm, {3, 1},
+        OriginalDataRleRGB, 10, ConvertedDataRleRGB},
+    {"RGBA", PixelFormat::RGBA8Unorm, {3, 1},
+        OriginalDataRleRGBA, 10, ConvertedDataRleRGBA},
+};
+
+const struct {
+    const char* name;
+    PixelFormat format;
+    UnsignedInt threads;
+} RleRoundtripData[] {
+    {"grayscale", PixelFormat::R8Unorm, 1},
+    {"RGB", PixelFormat::RGB8Unorm, 1},
+    {"RGBA", PixelFormat::RGBA8Unorm, 1},
+    {"RGBA, 3 threads", PixelFormat::RGBA8Unorm, 3}
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threads;
+} RleThreadedData[] {
+    {"2 threads", 2},
+    {"4 threads", 4},
+    {"7 threads, uneven blocks", 7},
+    {"more threads than rows", 64},
+    {"hardware thread count", 0}
+};
+
+/* Flat areas, gradients and noise, similar to what a screenshot has */
+Containers::Array<char> rleTestImage(const PixelFormat format, const Vector2i& size) {
+    const std::size_t formatSize = pixelSize(format);
+    Containers::Array<char> data{Containers::NoInit, formatSize*size.product()};
+    UnsignedInt seed = 17;
+    for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x) {
+        for(std::size_t i = 0; i != formatSize; ++i) {
+            char& c = data[(y*size.x() + x)*formatSize + i];
+            if(y < size.y()/3) c = char(i*50);
+            else if(y < 2*size.y()/3) c = char(x/3 + i);
+            else {
+                seed = seed*1103515245 + 12345;
+                c = char(seed >> 16);
+            }
+        }
+    }
+    return data;
+}
+
 TgaImageConverterTest::TgaImageConverterTest() {
     addTests({&TgaImageConverterTest::wrongFormat});
 
@@ -100,6 +195,17 @@ TgaImageConverterTest::TgaImageConverterTest() {
         &TgaImageConverterTest::rgba},
         Containers::arraySize(VerboseData));
 
+    addInstancedTests({&TgaImageConverterTest::rle},
+        Containers::arraySize(RleData));
+
+    addTests({&TgaImageConverterTest::rleLongRun});
+
+    addInstancedTests({&TgaImageConverterTest::rleRoundtrip},
+        Containers::arraySize(RleRoundtripData));
+
+    addInstancedTests({&TgaImageConverterTest::rleThreaded},
+        Containers::arraySize(RleThreadedData));
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef TGAIMAGECONVERTER_PLUGIN_FILENAME
@@ -185,6 +291,95 @@ void TgaImageConverterTest::rgba() {
     CORRADE_COMPARE(out.str(), data.message32);
 }
 
+void TgaImageConverterTest::rle() {
+    auto&& data = RleData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+
+    Containers::Array<char> array = converter->exportToData(ImageView2D{data.format, data.size, data.data});
+    CORRADE_COMPARE(array.size(), sizeof(Implementation::TgaHeader) + data.expected.size());
+    const auto& header = *reinterpret_cast<const Implementation::TgaHeader*>(array.data());
+    CORRADE_COMPARE(UnsignedInt(header.imageType), UnsignedInt(data.imageType));
+    CORRADE_COMPARE(UnsignedInt(header.bpp), pixelSize(data.format)*8);
+    CORRADE_COMPARE(Int(Utility::Endianness::littleEndian(header.width)), data.size.x());
+    CORRADE_COMPARE(Int(Utility::Endianness::littleEndian(header.height)), data.size.y());
+    CORRADE_COMPARE_AS(array.suffix(sizeof(Implementation::TgaHeader)),
+        data.expected, TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rleLongRun() {
+    /* A run longer than 128 pixels needs to be split, one different pixel at
+       the end */
+    char data[132];
+    std::fill_n(data, 131, '\x07');
+    data[131] = '\x03';
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+
+    Containers::Array<char> array = converter->exportToData(ImageView2D{PixelFormat::R8Unorm, {132, 1}, data});
+    CORRADE_COMPARE_AS(array.suffix(sizeof(Implementation::TgaHeader)),
+        Containers::arrayView<char>({'\xff', 7, '\x82', 7, '\x00', 3}),
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rleRoundtrip() {
+    auto&& data = RleRoundtripData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Odd width to test also row padding */
+    const Vector2i size{131, 37};
+    Containers::Array<char> original = rleTestImage(data.format, size);
+    const ImageView2D image{PixelStorage{}.setAlignment(1), data.format, size, original};
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+    converter->configuration().setValue("threads", data.threads);
+    Containers::Array<char> array = converter->exportToData(image);
+    CORRADE_VERIFY(array);
+
+    /* The flat areas should make it considerably smaller */
+    CORRADE_COMPARE_AS(array.size(), sizeof(Implementation::TgaHeader) + original.size(),
+        TestSuite::Compare::Less);
+
+    if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(array));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE(converted->size(), size);
+    CORRADE_COMPARE(converted->format(), data.format);
+
+    /* The importer may pad the rows, compare just the pixels */
+    Containers::Array<char> pixels{Containers::NoInit, original.size()};
+    Utility::copy(converted->pixels(), Containers::StridedArrayView3D<char>{pixels,
+        {std::size_t(size.y()), std::size_t(size.x()), pixelSize(data.format)}});
+    CORRADE_COMPARE_AS(pixels, original, TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rleThreaded() {
+    auto&& data = RleThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Vector2i size{64, 45};
+    Containers::Array<char> original = rleTestImage(PixelFormat::RGB8Unorm, size);
+    const ImageView2D image{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, size, original};
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+    Containers::Array<char> expected = converter->exportToData(image);
+    CORRADE_VERIFY(expected);
+
+    /* The output should be the same regardless of thread count */
+    converter->configuration().setValue("threads", data.threads);
+    Containers::Array<char> array = converter->exportToData(image);
+    CORRADE_COMPARE_AS(array, expected, TestSuite::Compare::Container);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImageConverterTest)
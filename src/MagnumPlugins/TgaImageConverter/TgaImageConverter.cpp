@@ -25,13 +25,19 @@
 
 #include "TgaImageConverter.h"
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <tuple>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/ImageView.h"
+#include "Magnum/Implementation/Parallel.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Swizzle.h"
 #include "Magnum/Math/Vector4.h"
@@ -39,6 +45,85 @@
 
 namespace Magnum { namespace Trade {
 
+namespace {
+
+/* Writes a pixel to the output, converting RGB(A) to BGR(A) on the way */
+template<std::size_t size> inline void writePixel(char* out, const char* pixel);
+template<> inline void writePixel<1>(char* out, const char* pixel) {
+    out[0] = pixel[0];
+}
+template<> inline void writePixel<3>(char* out, const char* pixel) {
+    out[0] = pixel[2];
+    out[1] = pixel[1];
+    out[2] = pixel[0];
+}
+template<> inline void writePixel<4>(char* out, const char* pixel) {
+    out[0] = pixel[2];
+    out[1] = pixel[1];
+    out[2] = pixel[0];
+    out[3] = pixel[3];
+}
+
+/* Encodes given row range into the output, returns count of bytes written.
+   The output is expected to have at least (size + 1) bytes for each pixel,
+   which is the worst case of a one-pixel packet for each pixel. Packets never
+   cross row boundaries, as recommended by the TGA specification, which makes
+   the rows independent of each other. */
+template<std::size_t size> std::size_t encodeRle(const Containers::StridedArrayView3D<const char>& pixels, const std::size_t rowBegin, const std::size_t rowEnd, char* const out) {
+    const std::size_t width = pixels.size()[1];
+    char* o = out;
+    for(std::size_t y = rowBegin; y != rowEnd; ++y) {
+        /* Pixels in a row are always contiguous */
+        const char* const row = static_cast<const char*>(pixels[y].data());
+        for(std::size_t x = 0; x < width; ) {
+            const char* const pixel = row + x*size;
+
+            /* Count how many times the current pixel repeats, at most 128 as
+               that's the maximum a packet can hold */
+            std::size_t run = 1;
+            const std::size_t max = std::min(width - x, std::size_t{128});
+            while(run < max && std::memcmp(pixel, pixel + run*size, size) == 0)
+                ++run;
+
+            /* Repetition packet */
+            if(run > 1) {
+                *o++ = char(0x80|(run - 1));
+                writePixel<size>(o, pixel);
+                o += size;
+                x += run;
+                continue;
+            }
+
+            /* Otherwise gather a raw packet until two successive pixels are
+               the same, which then start the next repetition packet */
+            std::size_t raw = 1;
+            while(raw < max && !(raw + 1 < width - x && std::memcmp(pixel + raw*size, pixel + (raw + 1)*size, size) == 0))
+                ++raw;
+
+            *o++ = char(raw - 1);
+            for(std::size_t i = 0; i != raw; ++i) {
+                writePixel<size>(o, pixel + i*size);
+                o += size;
+            }
+            x += raw;
+        }
+    }
+
+    return o - out;
+}
+
+std::size_t encodeRle(const Containers::StridedArrayView3D<const char>& pixels, const std::size_t rowBegin, const std::size_t rowEnd, char* const out) {
+    switch(pixels.size()[2]) {
+        case 1: return encodeRle<1>(pixels, rowBegin, rowEnd, out);
+        case 3: return encodeRle<3>(pixels, rowBegin, rowEnd, out);
+        case 4: return encodeRle<4>(pixels, rowBegin, rowEnd, out);
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
 TgaImageConverter::TgaImageConverter() = default;
 
 TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImageConverter{manager, plugin} {}
@@ -46,27 +131,76 @@ TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, co
 ImageConverterFeatures TgaImageConverter::doFeatures() const { return ImageConverterFeature::ConvertData; }
 
 Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& image) {
-    /* Initialize data buffer */
-    const auto pixelSize = UnsignedByte(image.pixelSize());
-    Containers::Array<char> data{Containers::ValueInit, sizeof(Implementation::TgaHeader) + pixelSize*image.size().product()};
-
     /* Fill header */
-    auto header = reinterpret_cast<Implementation::TgaHeader*>(data.begin());
+    Implementation::TgaHeader header{};
     switch(image.format()) {
         case PixelFormat::RGB8Unorm:
         case PixelFormat::RGBA8Unorm:
-            header->imageType = 2;
+            header.imageType = 2;
             break;
         case PixelFormat::R8Unorm:
-            header->imageType = 3;
+            header.imageType = 3;
             break;
         default:
             Error() << "Trade::TgaImageConverter::exportToData(): unsupported pixel format" << image.format();
             return nullptr;
     }
-    header->bpp = pixelSize*8;
-    header->width = UnsignedShort(Utility::Endianness::littleEndian(image.size().x()));
-    header->height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
+    const auto pixelSize = UnsignedByte(image.pixelSize());
+    header.bpp = pixelSize*8;
+    header.width = UnsignedShort(Utility::Endianness::littleEndian(image.size().x()));
+    header.height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
+
+    if(flags() & ImageConverterFlag::Verbose) {
+        if(image.format() == PixelFormat::RGB8Unorm)
+            Debug{} << "Trade::TgaImageConverter::exportToData(): converting from RGB to BGR";
+        else if(image.format() == PixelFormat::RGBA8Unorm)
+            Debug{} << "Trade::TgaImageConverter::exportToData(): converting from RGBA to BGRA";
+    }
+
+    /* Run-length encoded output */
+    if(configuration().value<bool>("rle")) {
+        header.imageType |= 8;
+
+        const Containers::StridedArrayView3D<const char> pixels = image.pixels();
+        const std::size_t height = image.size().y();
+
+        /* Split the rows into equally sized blocks, one for each thread */
+        const UnsignedInt threadCount = Magnum::Implementation::resolveThreadCount(configuration().value<UnsignedInt>("threads"));
+        const std::size_t blockCount = std::max(std::min(std::size_t(threadCount), height), std::size_t{1});
+        const std::size_t rowsPerBlock = (height + blockCount - 1)/blockCount;
+        const std::size_t maxBlockSize = rowsPerBlock*image.size().x()*(pixelSize + 1);
+
+        /* Each block is encoded into a scratch buffer large enough for the
+           worst case, the final size is known only after */
+        Containers::Array<char> scratch{Containers::NoInit, blockCount*maxBlockSize};
+        Containers::Array<std::size_t> blockSizes{Containers::ValueInit, blockCount};
+        auto encodeBlock = [&](const std::size_t i) {
+            const std::size_t rowBegin = std::min(i*rowsPerBlock, height);
+            const std::size_t rowEnd = std::min(rowBegin + rowsPerBlock, height);
+            blockSizes[i] = encodeRle(pixels, rowBegin, rowEnd, scratch + i*maxBlockSize);
+        };
+
+        Magnum::Implementation::parallelFor(blockCount, 1, threadCount, [&](const std::size_t begin, const std::size_t end) {
+            for(std::size_t i = begin; i != end; ++i) encodeBlock(i);
+        });
+
+        std::size_t dataSize = sizeof(Implementation::TgaHeader);
+        for(const std::size_t size: blockSizes) dataSize += size;
+
+        Containers::Array<char> data{Containers::NoInit, dataSize};
+        Utility::copy(Containers::arrayView(reinterpret_cast<const char*>(&header), sizeof(Implementation::TgaHeader)), data.prefix(sizeof(Implementation::TgaHeader)));
+        std::size_t offset = sizeof(Implementation::TgaHeader);
+        for(std::size_t i = 0; i != blockCount; ++i) {
+            Utility::copy(scratch.slice(i*maxBlockSize, i*maxBlockSize + blockSizes[i]), data.slice(offset, offset + blockSizes[i]));
+            offset += blockSizes[i];
+        }
+
+        return data;
+    }
+
+    /* Initialize data buffer */
+    Containers::Array<char> data{Containers::ValueInit, sizeof(Implementation::TgaHeader) + pixelSize*image.size().product()};
+    *reinterpret_cast<Implementation::TgaHeader*>(data.begin()) = header;
 
     /* Copy the pixels into output, dropping padding (if any) */
     const Containers::ArrayView<char> pixels = data.suffix(sizeof(Implementation::TgaHeader));
@@ -74,13 +208,9 @@ Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& ima
         {std::size_t(image.size().y()), std::size_t(image.size().x()), pixelSize}});
 
     if(image.format() == PixelFormat::RGB8Unorm) {
-        if(flags() & ImageConverterFlag::Verbose)
-            Debug{} << "Trade::TgaImageConverter::exportToData(): converting from RGB to BGR";
         for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(pixels))
             pixel = Math::gather<'b', 'g', 'r'>(pixel);
     } else if(image.format() == PixelFormat::RGBA8Unorm) {
-        if(flags() & ImageConverterFlag::Verbose)
-            Debug{} << "Trade::TgaImageConverter::exportToData(): converting from RGBA to BGRA";
         for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(pixels))
             pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
     }
@@ -87,6 +87,34 @@ target_link_libraries(your-app PRIVATE Magnum::TgaImageConverter)
 @endcode
 
 See @ref building, @ref cmake and @ref plugins for more information.
+
+@section Trade-TgaImageConverter-rle Run-length encoding
+
+By default, the pixel data are written uncompressed. Enabling the @cb{.ini} rle @ce
+@ref Trade-TgaImageConverter-configuration "configuration option" produces
+RLE-compressed files instead, which are usually several times smaller for
+images with large areas of a single color:
+
+@code{.cpp}
+Containers::Pointer<Trade::AbstractImageConverter> converter =
+    manager.instantiate("TgaImageConverter");
+converter->configuration().setValue("rle", true);
+@endcode
+
+Each RLE packet covers at most a single row, so the rows can be encoded in
+parallel. The @cb{.ini} threads @ce option controls how many threads are used
+for that, with @cpp 0 @ce meaning the number of hardware threads. The output
+is the same regardless of the thread count.
+
+@section Trade-TgaImageConverter-configuration Plugin-specific configuration
+
+It's possible to tune various output options through @ref configuration(). See
+below for all options and their default values.
+
+@snippet MagnumPlugins/TgaImageConverter/TgaImageConverter.conf config
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageConverter {
     public:
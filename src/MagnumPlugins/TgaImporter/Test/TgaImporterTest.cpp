@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
@@ -32,6 +33,7 @@
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/FormatStl.h>
 
+#include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
@@ -58,6 +60,16 @@ struct TgaImporterTest: TestSuite::Tester {
     void grayscale8Rle();
 
     void rleTooLarge();
+    void rleTrailingData();
+
+    void properties();
+    void propertiesInvalid();
+    void into();
+    void intoRows();
+    void intoRowsRle();
+    void intoWrongFormat();
+    void intoWrongWidth();
+    void intoRowsOutOfRange();
 
     void openTwice();
     void importTwice();
@@ -120,7 +132,9 @@ const struct {
     {"short RLE data", Containers::arrayView(Color24Rle).except(1),
         "RLE file too short at pixel 3"},
     {"short RLE raw data", Containers::arrayView(Color24Rle).except(5),
-        "RLE file too short at pixel 0"}
+        "RLE file too short at pixel 0"},
+    {"RLE data ending at a packet boundary", Containers::arrayView(Color24Rle).except(4),
+        "RLE file too short at pixel 3"}
 };
 
 TgaImporterTest::TgaImporterTest() {
@@ -146,7 +160,17 @@ TgaImporterTest::TgaImporterTest() {
     addTests({&TgaImporterTest::grayscale8,
               &TgaImporterTest::grayscale8Rle,
 
-              &TgaImporterTest::rleTooLarge});
+              &TgaImporterTest::rleTooLarge,
+              &TgaImporterTest::rleTrailingData,
+
+              &TgaImporterTest::properties,
+              &TgaImporterTest::propertiesInvalid,
+              &TgaImporterTest::into,
+              &TgaImporterTest::intoRows,
+              &TgaImporterTest::intoRowsRle,
+              &TgaImporterTest::intoWrongFormat,
+              &TgaImporterTest::intoWrongWidth,
+              &TgaImporterTest::intoRowsOutOfRange});
 
     addTests({&TgaImporterTest::openTwice,
               &TgaImporterTest::importTwice});
@@ -421,6 +445,151 @@ void TgaImporterTest::rleTooLarge() {
     CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2D(): RLE data larger than advertised Vector(2, 3) pixels at byte 28\n");
 }
 
+void TgaImporterTest::rleTrailingData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    const char data[] = {
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 24, 0,
+        /* 3 pixels as-is */
+        '\x02', 1, 2, 3,
+                2, 3, 4,
+                3, 4, 5,
+        /* 1 pixel 3x repeated */
+        '\x82', 4, 5, 6,
+        /* 1 pixel as-is, after the image is complete */
+        '\x00', 7, 8, 9
+    };
+    CORRADE_VERIFY(importer->openData(data));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2D(0));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2D(): RLE data larger than advertised Vector(2, 3) pixels at byte 32\n");
+}
+
+void TgaImporterTest::properties() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24));
+
+    Containers::Optional<ImageView2D> properties = importer->image2DProperties(0);
+    CORRADE_VERIFY(properties);
+    CORRADE_COMPARE(properties->storage().alignment(), 1);
+    CORRADE_COMPARE(properties->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(properties->size(), Vector2i(2, 3));
+    CORRADE_VERIFY(!properties->data().data());
+}
+
+void TgaImporterTest::propertiesInvalid() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    const char data[] = { 0, 0, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    CORRADE_VERIFY(importer->openData(data));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2DProperties(0));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2DProperties(): unsupported image type: 9\n");
+}
+
+void TgaImporterTest::into() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24));
+
+    /* Default four-byte alignment, so each row is padded with two bytes that
+       shouldn't get touched */
+    char out[24];
+    std::fill_n(out, 24, '\xff');
+    CORRADE_VERIFY(importer->image2DInto(0, MutableImageView2D{PixelFormat::RGB8Unorm, {2, 3}, out}));
+
+    const char expected[] = {
+        3, 2, 1, 4, 3, 2, '\xff', '\xff',
+        5, 4, 3, 6, 5, 4, '\xff', '\xff',
+        7, 6, 5, 8, 7, 6, '\xff', '\xff'
+    };
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::intoRows() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24));
+
+    char out[12];
+    MutableImageView2D view{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 2}, out};
+    CORRADE_VERIFY(importer->image2DInto(0, view, 1));
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<char>({
+        5, 4, 3, 6, 5, 4,
+        7, 6, 5, 8, 7, 6
+    }), TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::intoRowsRle() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24Rle));
+
+    char out[6];
+    MutableImageView2D view{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 1}, out};
+
+    /* The middle row is made of the end of the raw packet and the beginning
+       of the repeat packet */
+    CORRADE_VERIFY(importer->image2DInto(0, view, 1));
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<char>({
+        5, 4, 3, 6, 5, 4
+    }), TestSuite::Compare::Container);
+
+    /* The last row continues in the middle of the repeat packet */
+    CORRADE_VERIFY(importer->image2DInto(0, view, 2));
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<char>({
+        6, 5, 4, 6, 5, 4
+    }), TestSuite::Compare::Container);
+
+    /* Going back has to start from the beginning again */
+    CORRADE_VERIFY(importer->image2DInto(0, view, 0));
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<char>({
+        3, 2, 1, 4, 3, 2
+    }), TestSuite::Compare::Container);
+
+    /* And the full image should still work the same after */
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        3, 2, 1, 4, 3, 2,
+        5, 4, 3, 6, 5, 4,
+        6, 5, 4, 6, 5, 4
+    }), TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::intoWrongFormat() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24));
+
+    char data[6];
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2DInto(0, MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {2, 3}, data}));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2DInto(): expected destination format PixelFormat::RGB8Unorm but got PixelFormat::R8Unorm\n");
+}
+
+void TgaImporterTest::intoWrongWidth() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24));
+
+    char data[9];
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2DInto(0, MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {3, 1}, data}));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2DInto(): expected destination width 2 but got 3\n");
+}
+
+void TgaImporterTest::intoRowsOutOfRange() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24));
+
+    char data[12];
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2DInto(0, MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 2}, data}, 2));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2DInto(): rows 2 to 4 out of range for 3 rows\n");
+}
+
 void TgaImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
 
@@ -25,13 +25,16 @@
 
 #include "TgaImporter.h"
 
-#include <fstream>
-#include <sstream>
+#include <algorithm>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Endianness.h>
 
+#include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Swizzle.h"
 #include "Magnum/Math/Vector4.h"
@@ -40,71 +43,57 @@
 
 namespace Magnum { namespace Trade {
 
-TgaImporter::TgaImporter() = default;
-
-TgaImporter::TgaImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
-
-TgaImporter::~TgaImporter() = default;
-
-ImporterFeatures TgaImporter::doFeatures() const { return ImporterFeature::OpenData; }
-
-bool TgaImporter::doIsOpened() const { return _in; }
-
-void TgaImporter::doClose() { _in = nullptr; }
-
-void TgaImporter::doOpenData(const Containers::ArrayView<const char> data) {
-    /* Because here we're copying the data and using the _in to check if file
-       is opened, having them nullptr would mean openData() would fail without
-       any error message. It's not possible to do this check on the importer
-       side, because empty file is valid in some formats (OBJ or glTF). We also
-       can't do the full import here because then doImage2D() would need to
-       copy the imported data instead anyway. This way it'll also work nicely
-       with a future openMemory(). */
-    if(data.empty()) {
-        Error{} << "Trade::TgaImporter::openData(): the file is empty";
-        return;
-    }
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+struct TgaImporter::MappedFile {
+    Containers::Array<const char, Utility::Directory::MapDeleter> data;
+};
+#else
+struct TgaImporter::MappedFile {};
+#endif
 
-    _in = Containers::Array<char>{data.size()};
-    std::copy(data.begin(), data.end(), _in.begin());
-}
+namespace {
 
-UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
+struct Properties {
+    PixelStorage storage;
+    PixelFormat format;
+    Vector2i size;
+    bool rle;
+};
 
-Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedInt) {
+Containers::Optional<Properties> parseHeader(const char* const prefix, const Containers::ArrayView<const char> in) {
     /* Check if the file is long enough */
-    if(_in.size() < sizeof(Implementation::TgaHeader)) {
-        Error{} << "Trade::TgaImporter::image2D(): file too short, expected at least" << sizeof(Implementation::TgaHeader) << "bytes but got" << _in.size();
+    if(in.size() < sizeof(Implementation::TgaHeader)) {
+        Error{} << prefix << "file too short, expected at least" << sizeof(Implementation::TgaHeader) << "bytes but got" << in.size();
         return Containers::NullOpt;
     }
 
-    const Implementation::TgaHeader& header = *reinterpret_cast<const Implementation::TgaHeader*>(_in.data());
+    const Implementation::TgaHeader& header = *reinterpret_cast<const Implementation::TgaHeader*>(in.data());
+
+    Properties out;
 
     /* Size in machine endian */
-    const Vector2i size{Utility::Endianness::littleEndian(header.width),
+    out.size = Vector2i{Utility::Endianness::littleEndian(header.width),
                         Utility::Endianness::littleEndian(header.height)};
 
     /* Image format */
-    PixelFormat format;
     if(header.colorMapType != 0) {
-        Error() << "Trade::TgaImporter::image2D(): paletted files are not supported";
+        Error() << prefix << "paletted files are not supported";
         return Containers::NullOpt;
     }
 
     /* Color */
-    bool rle = false;
     if(header.imageType == 2 || header.imageType == 10) {
         /* Reference: http://www.paulbourke.net/dataformats/tga/ */
-        rle = header.imageType == 10;
+        out.rle = header.imageType == 10;
         switch(header.bpp) {
             case 24:
-                format = PixelFormat::RGB8Unorm;
+                out.format = PixelFormat::RGB8Unorm;
                 break;
             case 32:
-                format = PixelFormat::RGBA8Unorm;
+                out.format = PixelFormat::RGBA8Unorm;
                 break;
             default:
-                Error() << "Trade::TgaImporter::image2D(): unsupported color bits-per-pixel:" << header.bpp;
+                Error() << prefix << "unsupported color bits-per-pixel:" << header.bpp;
                 return Containers::NullOpt;
         }
 
@@ -113,43 +102,75 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
         /* I only discovered this by accident when using ImageMagick's
             mogrify -compression RunLengthEncoded file.tga
            as far as I could find, it's not documented in any TGA specs */
-        rle = header.imageType == 11;
-        format = PixelFormat::R8Unorm;
+        out.rle = header.imageType == 11;
+        out.format = PixelFormat::R8Unorm;
         if(header.bpp != 8) {
-            Error() << "Trade::TgaImporter::image2D(): unsupported grayscale bits-per-pixel:" << header.bpp;
+            Error() << prefix << "unsupported grayscale bits-per-pixel:" << header.bpp;
             return Containers::NullOpt;
         }
 
     /* Other? */
     } else {
-        Error() << "Trade::TgaImporter::image2D(): unsupported image type:" << header.imageType;
+        Error() << prefix << "unsupported image type:" << header.imageType;
         return Containers::NullOpt;
     }
 
-    const std::size_t pixelSize = header.bpp/8;
-    const std::size_t outputSize = std::size_t(size.product())*pixelSize;
+    /* Adjust pixel storage if row size is not four byte aligned */
+    if((out.size.x()*header.bpp/8)%4 != 0)
+        out.storage.setAlignment(1);
+
+    return out;
+}
+
+/* Decodes rows [rowOffset, rowOffset + destination.size().y()) into
+   destination, which is expected to have the same format and width as the
+   image. The rleOffset / rlePixel cursor is updated to point to the last RLE
+   packet that got touched. */
+bool decode(const char* const prefix, const Containers::ArrayView<const char> in, const Properties& properties, const MutableImageView2D& destination, const std::size_t rowOffset, std::size_t& rleOffset, std::size_t& rlePixel, const bool verbose) {
+    const std::size_t pixelSize = destination.pixelSize();
+    const std::size_t width = properties.size.x();
+    const std::size_t height = destination.size().y();
+    const Containers::ArrayView<const char> srcPixels = in.suffix(sizeof(Implementation::TgaHeader));
+    const Containers::StridedArrayView3D<char> dstPixels = destination.pixels();
 
     /* Copy data directly if not RLE */
-    Containers::Array<char> data{outputSize};
-    Containers::ArrayView<const char> srcPixels = _in.suffix(sizeof(Implementation::TgaHeader));
-    if(!rle) {
+    if(!properties.rle) {
         /* Files that are larger are allowed in this case (but not for RLE) */
-        if(srcPixels.size() < outputSize) {
-            Error{} << "Trade::TgaImporter::image2D(): file too short, expected" << outputSize + sizeof(Implementation::TgaHeader) << "bytes but got" << _in.size();
-            return Containers::NullOpt;
+        const std::size_t rowSize = width*pixelSize;
+        const std::size_t end = (rowOffset + height)*rowSize;
+        if(srcPixels.size() < end) {
+            Error{} << prefix << "file too short, expected" << end + sizeof(Implementation::TgaHeader) << "bytes but got" << in.size();
+            return false;
         }
 
-        Utility::copy(srcPixels.prefix(data.size()), data);
+        Utility::copy(Containers::StridedArrayView3D<const char>{
+            srcPixels.slice(rowOffset*rowSize, end),
+            {height, width, pixelSize}}, dstPixels);
 
     /* Otherwise decode */
     } else {
-        Containers::ArrayView<char> dstPixels = data;
-        while(!srcPixels.empty()) {
+        const std::size_t totalPixelCount = std::size_t(properties.size.product());
+        const std::size_t begin = rowOffset*width;
+        const std::size_t end = begin + height*width;
+
+        /* Start from the beginning if the requested range is before the
+           cursor */
+        std::size_t offset = rleOffset;
+        std::size_t packetPixel = rlePixel;
+        if(begin < packetPixel) offset = packetPixel = 0;
+
+        std::size_t pixel = begin;
+        while(pixel < end) {
             /* Reference: http://www.paulbourke.net/dataformats/tga/ */
 
+            if(offset >= srcPixels.size()) {
+                Error{} << prefix << "RLE file too short at pixel" << packetPixel;
+                return false;
+            }
+
             /* 8-bit RLE header. First bit denotes the operation, last 7 bits
                denotes operation count minus 1. */
-            const UnsignedByte rleHeader = srcPixels[0];
+            const UnsignedByte rleHeader = srcPixels[offset];
             const std::size_t count = (rleHeader & ~0x80) + 1;
 
             /* First bit set to 1 means copying the following pixel given
@@ -159,51 +180,166 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
             const std::ptrdiff_t stride = rleHeader & 0x80 ? 0 : pixelSize;
 
             /* Check bounds */
-            if(1 + dataSize > srcPixels.size()) {
-                Error{} << "Trade::TgaImporter::image2D(): RLE file too short at pixel" << (dstPixels.begin() - data.begin())/pixelSize;
-                return Containers::NullOpt;
+            if(offset + 1 + dataSize > srcPixels.size()) {
+                Error{} << prefix << "RLE file too short at pixel" << packetPixel;
+                return false;
             }
-            if(count*pixelSize > dstPixels.size()) {
-                Error{} << "Trade::TgaImporter::image2D(): RLE data larger than advertised" << size << "pixels at byte" << (srcPixels.data() - _in.data());
-                return Containers::NullOpt;
+            if(packetPixel + count > totalPixelCount) {
+                Error{} << prefix << "RLE data larger than advertised" << properties.size << "pixels at byte" << offset + sizeof(Implementation::TgaHeader);
+                return false;
+            }
+
+            /* Copy the part of the packet that overlaps the requested range,
+               split to rows of the destination */
+            const std::size_t packetEnd = packetPixel + count;
+            const std::size_t copyEnd = std::min(packetEnd, end);
+            while(pixel < copyEnd) {
+                const std::size_t y = (pixel - begin)/width;
+                const std::size_t x = (pixel - begin)%width;
+                const std::size_t pixelCount = std::min(copyEnd - pixel, width - x);
+                const std::size_t srcOffset = offset + 1 + (stride ? (pixel - packetPixel)*pixelSize : 0);
+
+                Containers::StridedArrayView2D<const char> src{
+                    srcPixels.slice(srcOffset, srcOffset + (stride ? pixelCount : 1)*pixelSize),
+                    {pixelCount, pixelSize}, {stride, 1}};
+                Utility::copy(src, dstPixels[y].slice(x, x + pixelCount));
+
+                pixel += pixelCount;
             }
 
-            /* Copy the data */
-            Containers::StridedArrayView2D<const char> src{
-                srcPixels.slice(1, 1 + dataSize),
-                {count, pixelSize}, {stride, 1}};
-            Containers::StridedArrayView2D<char> dst{
-                dstPixels.prefix(count*pixelSize),
-                {count, pixelSize}};
-            Utility::copy(src, dst);
-
-            /* Update views for the next round */
-            srcPixels = srcPixels.suffix(1 + dataSize);
-            dstPixels = dstPixels.suffix(count*pixelSize);
+            /* If the packet continues past the requested range, stay on it so
+               the next range can continue from there */
+            if(packetEnd > end) break;
+
+            offset += 1 + dataSize;
+            packetPixel = packetEnd;
+        }
+
+        /* If the range went up to the last pixel, there should be no data
+           left after the last packet */
+        if(end == totalPixelCount && offset != srcPixels.size()) {
+            Error{} << prefix << "RLE data larger than advertised" << properties.size << "pixels at byte" << offset + sizeof(Implementation::TgaHeader);
+            return false;
         }
+
+        rleOffset = offset;
+        rlePixel = packetPixel;
     }
 
-    /* Adjust pixel storage if row size is not four byte aligned */
-    PixelStorage storage;
-    if((size.x()*header.bpp/8)%4 != 0)
-        storage.setAlignment(1);
-
-    if(format == PixelFormat::RGB8Unorm) {
-        if(flags() & ImporterFlag::Verbose)
-            Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
-        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(data))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
-    } else if(format == PixelFormat::RGBA8Unorm) {
-        if(flags() & ImporterFlag::Verbose)
-            Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
-        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(data))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+    if(properties.format == PixelFormat::RGB8Unorm) {
+        if(verbose)
+            Debug{} << prefix << "converting from BGR to RGB";
+        for(Containers::StridedArrayView1D<Vector3ub> row: destination.pixels<Vector3ub>())
+            for(Vector3ub& pixel: row)
+                pixel = Math::gather<'b', 'g', 'r'>(pixel);
+    } else if(properties.format == PixelFormat::RGBA8Unorm) {
+        if(verbose)
+            Debug{} << prefix << "converting from BGRA to RGBA";
+        for(Containers::StridedArrayView1D<Vector4ub> row: destination.pixels<Vector4ub>())
+            for(Vector4ub& pixel: row)
+                pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+    }
+
+    return true;
+}
+
+}
+
+TgaImporter::TgaImporter() = default;
+
+TgaImporter::TgaImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+TgaImporter::~TgaImporter() = default;
+
+ImporterFeatures TgaImporter::doFeatures() const { return ImporterFeature::OpenData; }
+
+bool TgaImporter::doIsOpened() const { return !_data.empty(); }
+
+void TgaImporter::doClose() {
+    _data = nullptr;
+    _in = nullptr;
+    _mapped = nullptr;
+    _rleOffset = _rlePixel = 0;
+}
+
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+void TgaImporter::doOpenFile(const std::string& filename) {
+    /* Empty files can't be mapped and mapping may fail for other reasons as
+       well. Delegate to the default implementation in that case, which reads
+       the file and passes it to doOpenData(). */
+    if(!Utility::Directory::exists(filename))
+        return AbstractImporter::doOpenFile(filename);
+    Containers::Array<const char, Utility::Directory::MapDeleter> data = Utility::Directory::mapRead(filename);
+    if(!data)
+        return AbstractImporter::doOpenFile(filename);
+
+    _mapped = Containers::Pointer<MappedFile>{new MappedFile{std::move(data)}};
+    _data = _mapped->data;
+}
+#endif
+
+void TgaImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    /* Because here we're copying the data and using the _data to check if
+       file is opened, having them nullptr would mean openData() would fail
+       without any error message. It's not possible to do this check on the
+       importer side, because empty file is valid in some formats (OBJ or
+       glTF). We also can't do the full import here because then doImage2D()
+       would need to copy the imported data instead anyway. This way it'll
+       also work nicely with a future openMemory(). */
+    if(data.empty()) {
+        Error{} << "Trade::TgaImporter::openData(): the file is empty";
+        return;
+    }
+
+    _in = Containers::Array<char>{Containers::NoInit, data.size()};
+    Utility::copy(data, _in);
+    _data = _in;
+}
+
+UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
+
+Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedInt) {
+    const char* const prefix = "Trade::TgaImporter::image2D():";
+    Containers::Optional<Properties> properties = parseHeader(prefix, _data);
+    if(!properties) return Containers::NullOpt;
+
+    /* All pixels get written by decode(), so no need to zero-init */
+    Containers::Array<char> data{Containers::NoInit, std::size_t(properties->size.product())*pixelSize(properties->format)};
+    if(!decode(prefix, _data, *properties, MutableImageView2D{properties->storage, properties->format, properties->size, data}, 0, _rleOffset, _rlePixel, flags() & ImporterFlag::Verbose))
+        return Containers::NullOpt;
+
+    return ImageData2D{properties->storage, properties->format, properties->size, std::move(data)};
+}
+
+Containers::Optional<ImageView2D> TgaImporter::doImage2DProperties(UnsignedInt, UnsignedInt) {
+    Containers::Optional<Properties> properties = parseHeader("Trade::TgaImporter::image2DProperties():", _data);
+    if(!properties) return Containers::NullOpt;
+
+    return ImageView2D{properties->storage, properties->format, properties->size};
+}
+
+bool TgaImporter::doImage2DInto(UnsignedInt, const MutableImageView2D& destination, const UnsignedInt rowOffset, UnsignedInt) {
+    const char* const prefix = "Trade::TgaImporter::image2DInto():";
+    Containers::Optional<Properties> properties = parseHeader(prefix, _data);
+    if(!properties) return false;
+
+    if(destination.format() != properties->format || destination.formatExtra() || destination.pixelSize() != pixelSize(properties->format)) {
+        Error{} << prefix << "expected destination format" << properties->format << "but got" << destination.format();
+        return false;
+    }
+    if(destination.size().x() != properties->size.x()) {
+        Error{} << prefix << "expected destination width" << properties->size.x() << "but got" << destination.size().x();
+        return false;
+    }
+    if(rowOffset + destination.size().y() > UnsignedInt(properties->size.y())) {
+        Error{} << prefix << "rows" << rowOffset << "to" << rowOffset + destination.size().y() << "out of range for" << properties->size.y() << "rows";
+        return false;
     }
 
-    return ImageData2D{storage, format, size, std::move(data)};
+    return decode(prefix, _data, *properties, destination, rowOffset, _rleOffset, _rlePixel, flags() & ImporterFlag::Verbose);
 }
 
 }}
 
 CORRADE_PLUGIN_REGISTER(TgaImporter, Magnum::Trade::TgaImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3.1")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.2")
@@ -30,6 +30,7 @@
  */
 
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/Utility/VisibilityMacros.h>
 
 #include "Magnum/Trade/AbstractImporter.h"
@@ -98,6 +99,33 @@ are imported with default @ref PixelStorage parameters except for alignment,
 which may be changed to `1` if the data require it.
 
 RLE compression is supported, paletted images are not.
+
+@section Trade-TgaImporter-streaming Decoding into existing memory
+
+The plugin implements @ref image2DProperties() and @ref image2DInto(), which
+parse just the file header and decode the requested row range directly into
+the destination, without allocating a temporary copy of the whole image. For
+RLE-compressed files the position in the RLE stream is remembered, so
+decoding consecutive row ranges in ascending order doesn't need to go through
+the preceding data again:
+
+@code{.cpp}
+Containers::Optional<ImageView2D> properties = importer->image2DProperties(0);
+if(!properties) Fatal{} << "Can't import the image";
+
+// Decode the image in slices of 256 rows into a pre-allocated buffer
+for(Int y = 0; y < properties->size().y(); y += 256) {
+    MutableImageView2D slice{properties->format(),
+        {properties->size().x(), Math::min(256, properties->size().y() - y)},
+        buffer};
+    if(!importer->image2DInto(0, slice, y)) Fatal{} << "Can't import rows" << y;
+
+    // Process or upload the slice ...
+}
+@endcode
+
+On platforms that support it, files opened with @ref openFile() are
+memory-mapped instead of being copied to memory.
 */
 class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
     public:
@@ -110,14 +138,30 @@ class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
         ~TgaImporter();
 
     private:
+        struct MappedFile;
+
         ImporterFeatures MAGNUM_TGAIMPORTER_LOCAL doFeatures() const override;
         bool MAGNUM_TGAIMPORTER_LOCAL doIsOpened() const override;
+        #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+        void MAGNUM_TGAIMPORTER_LOCAL doOpenFile(const std::string& filename) override;
+        #endif
         void MAGNUM_TGAIMPORTER_LOCAL doOpenData(Containers::ArrayView<const char> data) override;
         void MAGNUM_TGAIMPORTER_LOCAL doClose() override;
         UnsignedInt MAGNUM_TGAIMPORTER_LOCAL doImage2DCount() const override;
         Containers::Optional<ImageData2D> MAGNUM_TGAIMPORTER_LOCAL doImage2D(UnsignedInt id, UnsignedInt level) override;
+        Containers::Optional<ImageView2D> MAGNUM_TGAIMPORTER_LOCAL doImage2DProperties(UnsignedInt id, UnsignedInt level) override;
+        bool MAGNUM_TGAIMPORTER_LOCAL doImage2DInto(UnsignedInt id, const MutableImageView2D& destination, UnsignedInt rowOffset, UnsignedInt level) override;
 
+        /* Either a copy of the data passed to openData() or a memory-mapped
+           file, _data points to one of them */
         Containers::Array<char> _in;
+        Containers::Pointer<MappedFile> _mapped;
+        Containers::ArrayView<const char> _data;
+
+        /* Position of the RLE packet where the last decoding ended, to avoid
+           going through the whole file again when decoding consecutive row
+           ranges */
+        std::size_t _rleOffset{}, _rlePixel{};
 };
 
 }}
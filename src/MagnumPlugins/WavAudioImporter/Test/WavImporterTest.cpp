@@ -24,6 +24,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
@@ -78,10 +79,22 @@ struct WavImporterTest: TestSuite::Tester {
     void surround51Channel16();
     void surround71Channel24();
 
+    void readFrames();
+    void readFramesBigEndian();
+    void seek();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
 
+const struct {
+    const char* name;
+    bool fromData;
+} OpenData[] {
+    {"file", false},
+    {"data", true}
+};
+
 WavImporterTest::WavImporterTest() {
     addTests({&WavImporterTest::empty,
               &WavImporterTest::wrongSignature,
@@ -121,6 +134,12 @@ WavImporterTest::WavImporterTest() {
               &WavImporterTest::surround51Channel16,
               &WavImporterTest::surround71Channel24});
 
+    addInstancedTests({&WavImporterTest::readFrames,
+                       &WavImporterTest::readFramesBigEndian},
+        Containers::arraySize(OpenData));
+
+    addTests({&WavImporterTest::seek});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef WAVAUDIOIMPORTER_PLUGIN_FILENAME
@@ -136,7 +155,7 @@ void WavImporterTest::empty() {
     char a{};
     /* Explicitly checking non-null but empty view */
     CORRADE_VERIFY(!importer->openData({&a, 0}));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file is too short: 0 bytes\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: the file is too short: 0 bytes\n");
 }
 
 void WavImporterTest::wrongSignature() {
@@ -145,7 +164,7 @@ void WavImporterTest::wrongSignature() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "wrongSignature.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file signature is invalid\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: the file signature is invalid\n");
 }
 
 void WavImporterTest::unsupportedFormat() {
@@ -154,7 +173,7 @@ void WavImporterTest::unsupportedFormat() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "unsupportedFormat.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::AdPcm\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: unsupported format Audio::WavAudioFormat::AdPcm\n");
 }
 
 void WavImporterTest::unsupportedChannelCount() {
@@ -163,7 +182,7 @@ void WavImporterTest::unsupportedChannelCount() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "unsupportedChannelCount.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): PCM with unsupported channel count 6 with 8 bits per sample\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: PCM with unsupported channel count 6 with 8 bits per sample\n");
 }
 
 void WavImporterTest::invalidPadding() {
@@ -172,7 +191,7 @@ void WavImporterTest::invalidPadding() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "invalidPadding.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file has improper size, expected 66 but got 73\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: the file has improper size, expected 66 but got 73\n");
 }
 
 void WavImporterTest::invalidLength() {
@@ -181,7 +200,7 @@ void WavImporterTest::invalidLength() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "invalidLength.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file has improper size, expected 160844 but got 80444\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: the file has improper size, expected 160844 but got 80444\n");
 }
 
 void WavImporterTest::invalidDataChunk() {
@@ -190,7 +209,7 @@ void WavImporterTest::invalidDataChunk() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "invalidDataChunk.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): the file contains no data chunk\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: the file contains no data chunk\n");
 }
 
 void WavImporterTest::invalidFactChunk() {
@@ -222,7 +241,7 @@ void WavImporterTest::mono4() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono4.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::AdPcm\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: unsupported format Audio::WavAudioFormat::AdPcm\n");
 }
 
 void WavImporterTest::mono8() {
@@ -306,7 +325,7 @@ void WavImporterTest::stereo4() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo4.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::AdPcm\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: unsupported format Audio::WavAudioFormat::AdPcm\n");
 }
 
 void WavImporterTest::stereo8() {
@@ -353,7 +372,7 @@ void WavImporterTest::stereo12() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo12.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): PCM with unsupported channel count 2 with 12 bits per sample\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: PCM with unsupported channel count 2 with 12 bits per sample\n");
 }
 
 void WavImporterTest::stereo16() {
@@ -374,7 +393,7 @@ void WavImporterTest::stereo24() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo24.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): PCM with unsupported channel count 2 with 24 bits per sample\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: PCM with unsupported channel count 2 with 24 bits per sample\n");
 }
 
 void WavImporterTest::stereo32() {
@@ -383,7 +402,7 @@ void WavImporterTest::stereo32() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo32.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): PCM with unsupported channel count 2 with 32 bits per sample\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: PCM with unsupported channel count 2 with 32 bits per sample\n");
 }
 
 void WavImporterTest::mono32f() {
@@ -457,7 +476,7 @@ void WavImporterTest::surround51Channel16() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "surround51Channel16.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::Extensible\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: unsupported format Audio::WavAudioFormat::Extensible\n");
 }
 
 void WavImporterTest::surround71Channel24() {
@@ -466,7 +485,76 @@ void WavImporterTest::surround71Channel24() {
 
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
     CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "surround71Channel24.wav")));
-    CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::Extensible\n");
+    CORRADE_COMPARE(out.str(), "Audio::WavImporter: unsupported format Audio::WavAudioFormat::Extensible\n");
+}
+
+void WavImporterTest::readFrames() {
+    auto&& data = OpenData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    const std::string filename = Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono8.wav");
+    if(data.fromData)
+        CORRADE_VERIFY(importer->openData(Utility::Directory::read(filename)));
+    else
+        CORRADE_VERIFY(importer->openFile(filename));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::Mono8);
+    CORRADE_COMPARE(importer->frameCount(), 2136);
+
+    /* Reading in chunks should give the same result as importing everything
+       at once */
+    Containers::Array<char> expected = importer->data();
+    Containers::Array<char> out{Containers::NoInit, expected.size()};
+    std::size_t offset = 0;
+    while(std::size_t frames = importer->readFrames(out.slice(offset, std::min(offset + 500, out.size())))) {
+        offset += frames;
+        CORRADE_COMPARE(importer->position(), offset);
+    }
+    CORRADE_COMPARE(offset, 2136);
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+}
+
+void WavImporterTest::readFramesBigEndian() {
+    auto&& data = OpenData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    const std::string filename = Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono16be.wav");
+    if(data.fromData)
+        CORRADE_VERIFY(importer->openData(Utility::Directory::read(filename)));
+    else
+        CORRADE_VERIFY(importer->openFile(filename));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::Mono16);
+    CORRADE_COMPARE(importer->frameCount(), 2);
+
+    /* The samples should get converted to machine endian also when read
+       incrementally */
+    UnsignedShort out[2];
+    CORRADE_COMPARE(importer->readFrames(Containers::arrayCast<char>(Containers::arrayView(out)).prefix(2)), 1);
+    CORRADE_COMPARE(importer->readFrames(Containers::arrayCast<char>(Containers::arrayView(out)).suffix(2)), 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(out),
+        Containers::arrayView<UnsignedShort>({0x101d, 0xc571}),
+        TestSuite::Compare::Container);
+}
+
+void WavImporterTest::seek() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo16.wav")));
+    CORRADE_COMPARE(importer->frameCount(), 1);
+
+    UnsignedShort out[4]{};
+    CORRADE_COMPARE(importer->readFrames(Containers::arrayCast<char>(Containers::arrayView(out))), 1);
+    CORRADE_COMPARE(importer->readFrames(Containers::arrayCast<char>(Containers::arrayView(out))), 0);
+
+    /* Seeking back reads the same frame again */
+    importer->seek(0);
+    CORRADE_COMPARE(importer->position(), 0);
+    CORRADE_COMPARE(importer->readFrames(Containers::arrayCast<char>(Containers::arrayView(out))), 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(out).prefix(2),
+        Containers::arrayView<UnsignedShort>({0x4f27, 0x4f27}),
+        TestSuite::Compare::Container);
 }
 
 }}}}
@@ -26,8 +26,10 @@
 
 #include "WavImporter.h"
 
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/EndiannessBatch.h>
 
 #include "MagnumPlugins/WavAudioImporter/WavHeader.h"
@@ -39,19 +41,61 @@ using Implementation::WavAudioFormat;
 using Implementation::WavFormatChunk;
 using Implementation::WavHeaderChunk;
 
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+struct WavImporter::MappedFile {
+    Containers::Array<const char, Utility::Directory::MapDeleter> data;
+};
+#else
+struct WavImporter::MappedFile {};
+#endif
+
 WavImporter::WavImporter() = default;
 
 WavImporter::WavImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
+WavImporter::~WavImporter() = default;
+
 ImporterFeatures WavImporter::doFeatures() const { return ImporterFeature::OpenData; }
 
-bool WavImporter::doIsOpened() const { return !!_data; }
+bool WavImporter::doIsOpened() const { return _opened; }
 
 void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
+    Containers::Optional<Containers::ArrayView<const char>> samples = parse(data);
+    if(!samples) return;
+
+    /* Copy just the data chunk, the rest is not needed anymore */
+    _in = Containers::Array<char>{Containers::NoInit, samples->size()};
+    Utility::copy(*samples, _in);
+    _samples = _in;
+    _opened = true;
+}
+
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+void WavImporter::doOpenFile(const std::string& filename) {
+    /* Empty files can't be mapped and mapping may fail for other reasons as
+       well. Delegate to the default implementation in that case, which reads
+       the file and passes it to doOpenData(). */
+    if(!Utility::Directory::exists(filename))
+        return AbstractImporter::doOpenFile(filename);
+    Containers::Array<const char, Utility::Directory::MapDeleter> data = Utility::Directory::mapRead(filename);
+    if(!data)
+        return AbstractImporter::doOpenFile(filename);
+
+    Containers::Optional<Containers::ArrayView<const char>> samples = parse(data);
+    if(!samples) return;
+
+    /* The samples are read directly from the mapped memory */
+    _mapped = Containers::Pointer<MappedFile>{new MappedFile{std::move(data)}};
+    _samples = *samples;
+    _opened = true;
+}
+#endif
+
+Containers::Optional<Containers::ArrayView<const char>> WavImporter::parse(const Containers::ArrayView<const char> data) {
     /* Check file size */
     if(data.size() < sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
-        Error() << "Audio::WavImporter::openData(): the file is too short:" << data.size() << "bytes";
-        return;
+        Error() << "Audio::WavImporter: the file is too short:" << data.size() << "bytes";
+        return {};
     }
 
     /* Get the RIFF/WAV header */
@@ -60,8 +104,8 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     /* Check RIFF/WAV file signature */
     if((std::strncmp(header.chunk.chunkId, "RIFF", 4) != 0 && std::strncmp(header.chunk.chunkId, "RIFX", 4) != 0) ||
        std::strncmp(header.format, "WAVE", 4) != 0) {
-        Error() << "Audio::WavImporter::openData(): the file signature is invalid";
-        return;
+        Error() << "Audio::WavImporter: the file signature is invalid";
+        return {};
     }
 
     /* Check if the file is Big-Endian. While RIFX files are extremely rare,
@@ -74,9 +118,9 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
 
     /* Check file size */
     if(header.chunk.chunkSize < 36 || header.chunk.chunkSize + 8 != data.size()) {
-        Error() << "Audio::WavImporter::openData(): the file has improper size, expected"
+        Error() << "Audio::WavImporter: the file has improper size, expected"
                 << header.chunk.chunkSize + 8 << "but got" << data.size();
-        return;
+        return {};
     }
 
     const RiffChunk* dataChunk = nullptr;
@@ -99,16 +143,16 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
 
         if(std::strncmp(currChunk->chunkId, "fmt ", 4) == 0) {
             if(formatChunk) {
-                Error() << "Audio::WavImporter::openData(): the file contains too many format chunks";
-                return;
+                Error() << "Audio::WavImporter: the file contains too many format chunks";
+                return {};
             }
 
             formatChunk = WavFormatChunk{*reinterpret_cast<const WavFormatChunk*>(currChunk)};
 
         } else if(std::strncmp(currChunk->chunkId, "data", 4) == 0) {
             if(dataChunk != nullptr) {
-                Error() << "Audio::WavImporter::openData(): the file contains too many data chunks";
-                return;
+                Error() << "Audio::WavImporter: the file contains too many data chunks";
+                return {};
             }
 
             dataChunk = currChunk;
@@ -119,14 +163,14 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
 
     /* Make sure we actually got a format chunk */
     if(!formatChunk) {
-        Error() << "Audio::WavImporter::openData(): the file contains no format chunk";
-        return;
+        Error() << "Audio::WavImporter: the file contains no format chunk";
+        return {};
     }
 
     /* Make sure we actually got a data chunk */
     if(dataChunk == nullptr) {
-        Error() << "Audio::WavImporter::openData(): the file contains no data chunk";
-        return;
+        Error() << "Audio::WavImporter: the file contains no data chunk";
+        return {};
     }
 
     /* Fix endianness on Format chunk */
@@ -149,10 +193,10 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 16)
              _format = BufferFormat::Stereo16;
         else {
-            Error() << "Audio::WavImporter::openData(): PCM with unsupported channel count"
+            Error() << "Audio::WavImporter: PCM with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Check IEEE Float format */
@@ -166,10 +210,10 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 64)
             _format = BufferFormat::StereoDouble;
         else {
-            Error() << "Audio::WavImporter::openData(): IEEE with unsupported channel count"
+            Error() << "Audio::WavImporter: IEEE with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Check A-Law format */
@@ -179,10 +223,10 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         else if(formatChunk->numChannels == 2)
             _format = BufferFormat::StereoALaw;
         else {
-            Error() << "Audio::WavImporter::openData(): ALaw with unsupported channel count"
+            Error() << "Audio::WavImporter: ALaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Check μ-Law format */
@@ -192,64 +236,79 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         else if(formatChunk->numChannels == 2)
             _format = BufferFormat::StereoMuLaw;
         else {
-            Error() << "Audio::WavImporter::openData(): MuLaw with unsupported channel count"
+            Error() << "Audio::WavImporter: MuLaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Unknown/unimplemented format */
     } else {
-        Error() << "Audio::WavImporter::openData(): unsupported format" << formatChunk->audioFormat;
-        return;
+        Error() << "Audio::WavImporter: unsupported format" << formatChunk->audioFormat;
+        return {};
     }
 
     /* Size sanity checks */
     if(headerSize + offset > data.size()) {
-        Error() << "Audio::WavImporter::openData(): file size doesn't match computed size";
-        return;
+        Error() << "Audio::WavImporter: file size doesn't match computed size";
+        return {};
     }
 
     /* Format sanity checks */
     if(formatChunk->blockAlign != formatChunk->numChannels * formatChunk->bitsPerSample / 8 ||
        formatChunk->byteRate != formatChunk->sampleRate * formatChunk->blockAlign) {
-        Error() << "Audio::WavImporter::openData(): the file is corrupted";
-        return;
+        Error() << "Audio::WavImporter: the file is corrupted";
+        return {};
     }
 
-    /* Save frequency */
+    /* Save frequency and sample properties */
     _frequency = formatChunk->sampleRate;
+    _frameSize = formatChunk->blockAlign;
+    if(hasBigEndianData != Utility::Endianness::isBigEndian() && formatChunk->bitsPerSample != 8) {
+        CORRADE_INTERNAL_ASSERT(formatChunk->bitsPerSample == 16 || formatChunk->bitsPerSample == 32 || formatChunk->bitsPerSample == 64);
+        _swapSize = formatChunk->bitsPerSample/8;
+    } else _swapSize = 0;
 
-    /* Copy the data */
-    const char* dataChunkPtr = reinterpret_cast<const char*>(dataChunk + 1);
-    _data = Containers::Array<char>(dataChunkSize);
-    std::copy(dataChunkPtr, dataChunkPtr+dataChunkSize, _data->begin());
-
-    /* Fix the data endianness */
-    if(hasBigEndianData != Utility::Endianness::isBigEndian()) {
-        if(formatChunk->bitsPerSample == 16)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint16_t>(*_data));
-        else if(formatChunk->bitsPerSample == 32)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint32_t>(*_data));
-        else if(formatChunk->bitsPerSample == 64)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint64_t>(*_data));
-        else CORRADE_INTERNAL_ASSERT(formatChunk->bitsPerSample == 8);
-    }
+    return data.slice(reinterpret_cast<const char*>(dataChunk + 1), reinterpret_cast<const char*>(dataChunk + 1) + dataChunkSize);
 }
 
-void WavImporter::doClose() { _data = Containers::NullOpt; }
+void WavImporter::fixEndianness(const Containers::ArrayView<char> data) const {
+    if(_swapSize == 2)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint16_t>(data));
+    else if(_swapSize == 4)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint32_t>(data));
+    else if(_swapSize == 8)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint64_t>(data));
+    else CORRADE_INTERNAL_ASSERT(_swapSize == 0);
+}
+
+void WavImporter::doClose() {
+    _in = nullptr;
+    _mapped = nullptr;
+    _samples = nullptr;
+    _opened = false;
+}
 
 BufferFormat WavImporter::doFormat() const { return _format; }
 
 UnsignedInt WavImporter::doFrequency() const { return _frequency; }
 
 Containers::Array<char> WavImporter::doData() {
-    Containers::Array<char> copy(_data->size());
-    std::copy(_data->begin(), _data->end(), copy.begin());
+    Containers::Array<char> copy{Containers::NoInit, _samples.size()};
+    Utility::copy(_samples, copy);
+    fixEndianness(copy);
     return copy;
 }
 
+std::size_t WavImporter::doFrameCount() { return _samples.size()/_frameSize; }
+
+std::size_t WavImporter::doReadFrames(const std::size_t offset, const Containers::ArrayView<char> destination) {
+    Utility::copy(_samples.slice(offset*_frameSize, offset*_frameSize + destination.size()), destination);
+    fixEndianness(destination);
+    return destination.size()/_frameSize;
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(WavAudioImporter, Magnum::Audio::WavImporter,
-    "cz.mosra.magnum.Audio.AbstractImporter/0.1")
+    "cz.mosra.magnum.Audio.AbstractImporter/0.2")
@@ -32,6 +32,7 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Audio/AbstractImporter.h"
 
@@ -105,6 +106,29 @@ target_link_libraries(your-app PRIVATE Magnum::WavAudioImporter)
 
 See @ref building, @ref cmake and @ref plugins for more information.
 
+@section Audio-WavImporter-streaming Streaming
+
+Files opened with @ref openFile() are memory-mapped on platforms that support
+it, and only the headers are parsed on opening. Reading the samples with
+@ref readFrames() then copies just the requested range directly from the
+mapped file, so the memory use stays constant regardless of the file size:
+
+@code{.cpp}
+Containers::Pointer<Audio::AbstractImporter> importer =
+    manager.instantiate("WavAudioImporter");
+importer->openFile("ambience.wav");
+
+Containers::Array<char> chunk{Containers::NoInit,
+    Audio::bufferFormatFrameSize(importer->format())*4096};
+while(std::size_t frames = importer->readFrames(chunk)) {
+    // process the frames
+}
+@endcode
+
+Data passed to @ref openData() are copied into the importer, as there's no
+guarantee about their lifetime. The sample data are converted to machine
+endian while reading, @ref data() returns a copy.
+
 @section Audio-WavImporter-limitations Behavior and limitations
 
 Multi-channel formats are not supported.
@@ -117,19 +141,44 @@ class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
         /** @brief Plugin manager constructor */
         explicit WavImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~WavImporter();
+
     private:
+        struct MappedFile;
+
         MAGNUM_WAVAUDIOIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
+        #endif
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_WAVAUDIOIMPORTER_LOCAL BufferFormat doFormat() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doFrameCount() override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doReadFrames(std::size_t offset, Containers::ArrayView<char> destination) override;
+
+        /* Parses the headers, fills in the format, frequency and sample
+           properties and returns a view on the data chunk */
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Optional<Containers::ArrayView<const char>> parse(Containers::ArrayView<const char> data);
+        /* Converts the samples to machine endian, if needed */
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void fixEndianness(Containers::ArrayView<char> data) const;
+
+        /* Either a copy of the data chunk or a mapped file, _samples point to
+           the sample data in either of them */
+        Containers::Array<char> _in;
+        Containers::Pointer<MappedFile> _mapped;
+        Containers::ArrayView<const char> _samples;
+        bool _opened{};
 
-        Containers::Optional<Containers::Array<char>> _data;
         BufferFormat _format;
         UnsignedInt _frequency;
+        UnsignedInt _frameSize;
+        /* Size of a sample that needs to be byte-swapped, 0 if the data are
+           already in machine endian */
+        UnsignedInt _swapSize;
 };
 
 }}